@@ -0,0 +1,383 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines Diligent::BoundingVolumeHierarchy class
+
+#include <vector>
+
+#include "../../Primitives/interface/BasicTypes.h"
+#include "AdvancedMath.hpp"
+#include "ThreadPool.hpp"
+
+namespace Diligent
+{
+
+/// Four-wide bounding volume hierarchy over primitives that are defined by their bounding boxes.
+
+/// The hierarchy is built top-down using the binned surface area heuristic (SAH). The binary tree
+/// produced by the build is then collapsed into a flat array of nodes with four children each, so that
+/// a single SIMD operation tests a ray or a box against all children of a node. Node bounding boxes
+/// are stored in structure-of-arrays layout, and every node is 128 bytes in size.
+///
+/// The hierarchy does not know what the primitives are. Ray queries call a user-provided intersector
+/// for every primitive whose leaf is hit by the ray, for example:
+///
+///     BVH.CastRay(Ray, [&](const BoundingVolumeHierarchy::Ray& R, Uint32 TriId) {
+///         return IntersectRayTriangle(V[I[TriId * 3 + 0]], V[I[TriId * 3 + 1]], V[I[TriId * 3 + 2]], R.Origin, R.Direction);
+///     });
+///
+/// \note   Queries are thread-safe and may run concurrently with each other, but not with Build() or Refit().
+class BoundingVolumeHierarchy
+{
+public:
+    static constexpr Uint32 InvalidPrimitive = ~0u;
+
+    /// Maximum number of primitives in a leaf
+    static constexpr Uint32 MaxLeafSize = 4;
+
+    struct Ray
+    {
+        float3 Origin;
+        float3 Direction;
+
+        /// Only the hits closer than this distance, measured in units of Direction length, are reported.
+        float MaxDist = FLT_MAX;
+    };
+
+    struct RayHit
+    {
+        /// Index of the primitive that was hit, or InvalidPrimitive if the ray missed.
+        Uint32 PrimitiveId = InvalidPrimitive;
+
+        /// Distance to the hit point along the ray, or FLT_MAX if the ray missed.
+        float Distance = FLT_MAX;
+
+        explicit operator bool() const { return PrimitiveId != InvalidPrimitive; }
+    };
+
+    /// Builds the hierarchy.
+
+    /// \param [in] pPrimBoxes  - Array of NumPrims primitive bounding boxes. The index of the box in the array
+    ///                           is the primitive id that is passed to intersectors and callbacks.
+    /// \param [in] NumPrims    - Number of primitives.
+    /// \param [in] pThreadPool - Optional thread pool that large subtrees are built in. The method waits
+    ///                           for all tasks of the pool, and must not be called from a worker thread.
+    ///
+    /// \remarks    The resulting hierarchy does not depend on whether a thread pool is used.
+    void Build(const BoundBox* pPrimBoxes, Uint32 NumPrims, ThreadPool* pThreadPool = nullptr);
+
+    /// Updates node bounding boxes after primitives have moved, keeping the tree topology.
+
+    /// \param [in] pPrimBoxes - New bounding boxes of the primitives, in the same order as in Build().
+    ///
+    /// \remarks    Refitting is much faster than rebuilding, but the quality of the tree degrades as primitives
+    ///             move away from their original positions. The tree should be rebuilt when the motion is large.
+    void Refit(const BoundBox* pPrimBoxes);
+
+    /// Finds the closest primitive hit by the ray.
+
+    /// \param [in] R           - Ray to cast.
+    /// \param [in] Intersector - Function object with the signature float(const Ray& R, Uint32 PrimitiveId) that
+    ///                           returns the distance from the ray origin to the primitive, in units of the direction
+    ///                           length. Negative values and FLT_MAX indicate no intersection.
+    template <typename IntersectorType>
+    RayHit CastRay(const Ray& R, IntersectorType&& Intersector) const
+    {
+        return TraceRay<false>(R, Intersector);
+    }
+
+    /// Returns true if the ray hits any primitive. The query terminates at the first hit found,
+    /// which makes it cheaper than CastRay() for visibility tests.
+    template <typename IntersectorType>
+    bool TestRay(const Ray& R, IntersectorType&& Intersector) const
+    {
+        return static_cast<bool>(TraceRay<true>(R, Intersector));
+    }
+
+    /// Casts an array of rays.
+
+    /// \param [in]  pRays       - Array of NumRays rays.
+    /// \param [in]  NumRays     - Number of rays.
+    /// \param [out] pHits       - Array of NumRays hits.
+    /// \param [in]  Intersector - Intersector, see CastRay(). If a thread pool is given, the intersector is called
+    ///                            from multiple threads simultaneously.
+    /// \param [in]  pThreadPool - Optional thread pool to distribute the rays between.
+    template <typename IntersectorType>
+    void CastRays(const Ray* pRays, Uint32 NumRays, RayHit* pHits, const IntersectorType& Intersector, ThreadPool* pThreadPool = nullptr) const
+    {
+        ForEachBatch(NumRays, pThreadPool, [&](Uint32 Begin, Uint32 End) //
+                     {
+                         for (Uint32 i = Begin; i < End; ++i)
+                             pHits[i] = TraceRay<false>(pRays[i], Intersector);
+                     });
+    }
+
+    /// Enumerates the primitives whose bounding boxes overlap the box.
+
+    /// \param [in] Box      - Query box.
+    /// \param [in] Callback - Function object with the signature bool(Uint32 PrimitiveId). The function
+    ///                        should return true to continue the query and false to stop it.
+    template <typename CallbackType>
+    void QueryBox(const BoundBox& Box, CallbackType&& Callback) const;
+
+    /// Runs box queries for an array of boxes.
+
+    /// \param [in] pBoxes      - Array of NumBoxes boxes.
+    /// \param [in] NumBoxes    - Number of boxes.
+    /// \param [in] Callback    - Function object with the signature bool(Uint32 BoxIndex, Uint32 PrimitiveId), see
+    ///                           QueryBox(). If a thread pool is given, the callback is called from multiple threads
+    ///                           simultaneously, but never concurrently for the same box.
+    /// \param [in] pThreadPool - Optional thread pool to distribute the boxes between.
+    template <typename CallbackType>
+    void QueryBoxes(const BoundBox* pBoxes, Uint32 NumBoxes, const CallbackType& Callback, ThreadPool* pThreadPool = nullptr) const
+    {
+        ForEachBatch(NumBoxes, pThreadPool, [&](Uint32 Begin, Uint32 End) //
+                     {
+                         for (Uint32 i = Begin; i < End; ++i)
+                             QueryBox(pBoxes[i], [&](Uint32 PrimId) { return Callback(i, PrimId); });
+                     });
+    }
+
+    /// Returns the bounding box of all primitives.
+    BoundBox GetBounds() const;
+
+    Uint32 GetNumNodes() const { return static_cast<Uint32>(m_Nodes.size()); }
+    Uint32 GetNumPrimitives() const { return static_cast<Uint32>(m_PrimIds.size()); }
+
+    /// Computes bounding boxes of indexed triangles, as required by Build() and Refit().
+    static void ComputeTriangleBounds(const float3* pVertices, const Uint32* pIndices, Uint32 NumTriangles, BoundBox* pBoxes);
+
+private:
+    static constexpr Uint32 InvalidNode  = ~0u;
+    static constexpr Uint32 MaxStackSize = 256;
+
+    struct alignas(16) Node
+    {
+        // Child bounding boxes. Unused children have inverted boxes that never pass the tests.
+        float MinX[4];
+        float MinY[4];
+        float MinZ[4];
+        float MaxX[4];
+        float MaxY[4];
+        float MaxZ[4];
+
+        // For internal children, the index of the child node.
+        // For leaves, the index of the first primitive in m_PrimIds.
+        Uint32 Child[4];
+
+        // Number of primitives in the leaf, or zero for internal children and unused slots
+        Uint32 NumPrims[4];
+    };
+    static_assert(sizeof(Node) == 128, "Node is expected to be the size of two cache lines");
+
+    struct RayData
+    {
+        float Origin[3];
+        float InvDir[3];
+        // Whether the direction along the axis is negative, which swaps near and far slab planes
+        bool IsNegative[3];
+    };
+
+    struct StackEntry
+    {
+        Uint32 NodeIdx;
+        float  EntryDist;
+    };
+
+    static RayData PrepareRay(const Ray& R);
+
+    static void SetChildBox(Node& N, Uint32 Slot, const BoundBox& Box);
+
+    // Returns the mask of children hit by the ray between 0 and MaxDist, and their entry distances
+    static Uint32 IntersectNode(const Node& N, const RayData& R, float MaxDist, float EntryDist[]);
+
+    // Returns the mask of children whose boxes overlap the box
+    static Uint32 OverlapNode(const Node& N, const BoundBox& Box);
+
+    static bool IsOverlapping(const BoundBox& Box0, const BoundBox& Box1)
+    {
+        // clang-format off
+        return Box0.Min.x <= Box1.Max.x && Box0.Max.x >= Box1.Min.x &&
+               Box0.Min.y <= Box1.Max.y && Box0.Max.y >= Box1.Min.y &&
+               Box0.Min.z <= Box1.Max.z && Box0.Max.z >= Box1.Min.z;
+        // clang-format on
+    }
+
+    template <bool AnyHit, typename IntersectorType>
+    RayHit TraceRay(const Ray& R, IntersectorType& Intersector) const;
+
+    template <typename BatchFuncType>
+    static void ForEachBatch(Uint32 NumItems, ThreadPool* pThreadPool, const BatchFuncType& BatchFunc);
+
+    std::vector<Node> m_Nodes;
+
+    // Primitive ids in leaf order
+    std::vector<Uint32> m_PrimIds;
+
+    // Copies of the primitive bounding boxes in leaf order
+    std::vector<BoundBox> m_PrimBoxes;
+};
+
+
+template <bool AnyHit, typename IntersectorType>
+BoundingVolumeHierarchy::RayHit BoundingVolumeHierarchy::TraceRay(const Ray& R, IntersectorType& Intersector) const
+{
+    RayHit Hit;
+    if (m_Nodes.empty())
+        return Hit;
+
+    const auto RD = PrepareRay(R);
+
+    // Closest distance found so far
+    float ClosestDist = R.MaxDist;
+
+    StackEntry Stack[MaxStackSize];
+    Uint32     StackSize = 0;
+    Stack[StackSize++]   = {0, 0.f};
+    while (StackSize > 0)
+    {
+        const auto Entry = Stack[--StackSize];
+        // The node may have been pushed before a closer hit was found
+        if (Entry.EntryDist > ClosestDist)
+            continue;
+
+        const auto& N = m_Nodes[Entry.NodeIdx];
+
+        float  EntryDist[4];
+        Uint32 HitMask = IntersectNode(N, RD, ClosestDist, EntryDist);
+        if (HitMask == 0)
+            continue;
+
+        // Sort the children that were hit by their entry distance
+        Uint32 Order[4];
+        Uint32 NumHits = 0;
+        for (Uint32 i = 0; i < 4; ++i)
+        {
+            if ((HitMask & (1u << i)) == 0)
+                continue;
+            Uint32 j = NumHits++;
+            for (; j > 0 && EntryDist[Order[j - 1]] > EntryDist[i]; --j)
+                Order[j] = Order[j - 1];
+            Order[j] = i;
+        }
+
+        // Test leaves right away from near to far, and push internal nodes from far to near
+        // so that the nearest one is popped first.
+        for (Uint32 h = 0; h < NumHits; ++h)
+        {
+            const auto i = Order[h];
+            if (N.NumPrims[i] == 0 || EntryDist[i] > ClosestDist)
+                continue;
+
+            for (Uint32 p = N.Child[i]; p < N.Child[i] + N.NumPrims[i]; ++p)
+            {
+                const auto  PrimId = m_PrimIds[p];
+                const float Dist   = Intersector(R, PrimId);
+                if (Dist >= 0 && Dist < ClosestDist)
+                {
+                    ClosestDist     = Dist;
+                    Hit.PrimitiveId = PrimId;
+                    Hit.Distance    = Dist;
+                    if (AnyHit)
+                        return Hit;
+                }
+            }
+        }
+        for (Uint32 h = NumHits; h > 0; --h)
+        {
+            const auto i = Order[h - 1];
+            if (N.NumPrims[i] != 0 || EntryDist[i] > ClosestDist)
+                continue;
+
+            VERIFY(StackSize < MaxStackSize, "BVH traversal stack overflow");
+            Stack[StackSize++] = {N.Child[i], EntryDist[i]};
+        }
+    }
+
+    return Hit;
+}
+
+template <typename CallbackType>
+void BoundingVolumeHierarchy::QueryBox(const BoundBox& Box, CallbackType&& Callback) const
+{
+    if (m_Nodes.empty())
+        return;
+
+    Uint32 Stack[MaxStackSize];
+    Uint32 StackSize   = 0;
+    Stack[StackSize++] = 0;
+    while (StackSize > 0)
+    {
+        const auto& N       = m_Nodes[Stack[--StackSize]];
+        const auto  HitMask = OverlapNode(N, Box);
+        for (Uint32 i = 0; i < 4; ++i)
+        {
+            if ((HitMask & (1u << i)) == 0)
+                continue;
+
+            if (N.NumPrims[i] == 0)
+            {
+                VERIFY(StackSize < MaxStackSize, "BVH traversal stack overflow");
+                Stack[StackSize++] = N.Child[i];
+                continue;
+            }
+
+            for (Uint32 p = N.Child[i]; p < N.Child[i] + N.NumPrims[i]; ++p)
+            {
+                if (IsOverlapping(m_PrimBoxes[p], Box))
+                {
+                    if (!Callback(m_PrimIds[p]))
+                        return;
+                }
+            }
+        }
+    }
+}
+
+template <typename BatchFuncType>
+void BoundingVolumeHierarchy::ForEachBatch(Uint32 NumItems, ThreadPool* pThreadPool, const BatchFuncType& BatchFunc)
+{
+    static constexpr Uint32 BatchSize = 256;
+    if (pThreadPool == nullptr || NumItems <= BatchSize)
+    {
+        BatchFunc(0u, NumItems);
+        return;
+    }
+
+    VERIFY(pThreadPool->GetCurrentThreadId() == ~0u, "Batched queries must not be called from a worker thread of the pool");
+    for (Uint32 Begin = 0; Begin < NumItems; Begin += BatchSize)
+    {
+        const auto End = std::min(Begin + BatchSize, NumItems);
+        pThreadPool->EnqueueTask([&BatchFunc, Begin, End](Uint32) { BatchFunc(Begin, End); });
+    }
+    pThreadPool->WaitForAllTasks();
+}
+
+} // namespace Diligent
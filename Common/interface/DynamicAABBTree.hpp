@@ -0,0 +1,292 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines Diligent::DynamicAABBTree class
+
+#include <vector>
+
+#include "../../Primitives/interface/BasicTypes.h"
+#include "AdvancedMath.hpp"
+
+namespace Diligent
+{
+
+/// Dynamic bounding volume tree for culling large sets of moving objects.
+
+/// The tree is a binary hierarchy of axis-aligned bounding boxes that is updated incrementally:
+/// objects are inserted next to the sibling that minimizes the surface area increase, and every
+/// update is followed by tree rotations that keep the tree balanced, so that insertion, removal
+/// and moving an object take O(log n) time.
+///
+/// Leaves store "fat" boxes that are enlarged by a margin, so that objects moving by small amounts
+/// do not change the tree at all: Move() only updates the exact bounds in this case.
+///
+/// Frustum queries traverse the tree once for up to MaxViews views (e.g. the main camera and
+/// the shadow cascades). Every view keeps track of the frustum planes that the current subtree
+/// is not yet known to be inside of: once a node is fully inside a plane, the plane is not tested
+/// for its descendants, and subtrees that are fully inside all views are enumerated without any tests.
+///
+/// \note   The tree is not thread-safe. Queries may run concurrently with each other,
+///         but not with Insert(), Remove() or Move().
+class DynamicAABBTree
+{
+public:
+    using ObjectId = Uint32;
+
+    static constexpr ObjectId InvalidObject = ~0u;
+
+    /// Maximum number of views that QueryFrustums() can process in one traversal
+    static constexpr Uint32 MaxViews = 8;
+
+    /// \param [in] FatMargin - Distance by which object bounding boxes are enlarged in the tree.
+    explicit DynamicAABBTree(float FatMargin = 0.1f);
+
+    /// Inserts an object and returns its id. The id remains valid until the object is removed.
+    ObjectId Insert(const BoundBox& Box, void* pUserData = nullptr);
+
+    /// Removes the object from the tree.
+    void Remove(ObjectId Id);
+
+    /// Updates the bounding box of the object.
+
+    /// \param [in] Id           - Object id.
+    /// \param [in] Box          - New bounding box.
+    /// \param [in] Displacement - Expected displacement of the object until the next update. The fat box
+    ///                            is extended in this direction to reduce the number of reinsertions.
+    /// \return     true if the object was reinserted into the tree, and false if its new box
+    ///             still fits into the fat box and only the exact bounds were updated.
+    bool Move(ObjectId Id, const BoundBox& Box, const float3& Displacement = float3{});
+
+    /// Returns the exact bounding box of the object.
+    const BoundBox& GetBox(ObjectId Id) const
+    {
+        VERIFY_EXPR(IsLeaf(Id));
+        return m_Nodes[Id].ObjectBox;
+    }
+
+    /// Returns the enlarged bounding box that is stored in the tree for the object.
+    const BoundBox& GetFatBox(ObjectId Id) const
+    {
+        VERIFY_EXPR(IsLeaf(Id));
+        return m_Nodes[Id].Box;
+    }
+
+    void* GetUserData(ObjectId Id) const
+    {
+        VERIFY_EXPR(IsLeaf(Id));
+        return m_Nodes[Id].pUserData;
+    }
+
+    /// Enumerates the objects that are visible in the view frustum.
+
+    /// \param [in] Frustum    - View frustum.
+    /// \param [in] Callback   - Function object with the signature void(ObjectId Id).
+    /// \param [in] PlaneFlags - Frustum planes to test against.
+    template <typename CallbackType>
+    void QueryFrustum(const ViewFrustum& Frustum, CallbackType&& Callback, FRUSTUM_PLANE_FLAGS PlaneFlags = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM) const
+    {
+        QueryFrustums(
+            &Frustum, 1, [&Callback](ObjectId Id, Uint32) { Callback(Id); }, &PlaneFlags);
+    }
+
+    /// Enumerates the objects that are visible in any of the view frustums in a single traversal of the tree.
+
+    /// \param [in] pFrustums   - Array of NumFrustums view frustums.
+    /// \param [in] NumFrustums - Number of frustums, at most MaxViews.
+    /// \param [in] Callback    - Function object with the signature void(ObjectId Id, Uint32 ViewMask), where
+    ///                           bit i of ViewMask is set if the object is visible in frustum i. The callback
+    ///                           is called once for every object that is visible in at least one view.
+    /// \param [in] pPlaneFlags - Optional array of NumFrustums plane flags, one for every frustum.
+    ///                           If null, all planes of all frustums are tested.
+    template <typename CallbackType>
+    void QueryFrustums(const ViewFrustum*         pFrustums,
+                       Uint32                     NumFrustums,
+                       CallbackType&&             Callback,
+                       const FRUSTUM_PLANE_FLAGS* pPlaneFlags = nullptr) const;
+
+    /// Enumerates the objects whose exact bounding boxes overlap the box.
+
+    /// \param [in] Box      - Query box.
+    /// \param [in] Callback - Function object with the signature bool(ObjectId Id). The function
+    ///                        should return true to continue the query and false to stop it.
+    template <typename CallbackType>
+    void QueryBox(const BoundBox& Box, CallbackType&& Callback) const;
+
+    Uint32 GetNumObjects() const { return m_NumObjects; }
+
+    /// Returns the height of the tree, which is 0 for an empty tree and 1 for a tree with a single object.
+    Uint32 GetHeight() const { return m_Root != InvalidNode ? static_cast<Uint32>(m_Nodes[m_Root].Height) + 1 : 0; }
+
+private:
+    static constexpr Uint32 InvalidNode  = ~0u;
+    static constexpr Uint32 MaxStackSize = 256;
+
+    struct Node
+    {
+        // Bounding box of the subtree. For leaves, the fat bounding box of the object.
+        BoundBox Box;
+
+        Uint32 Parent   = InvalidNode;
+        Uint32 Child[2] = {InvalidNode, InvalidNode};
+
+        // Height of the subtree: 0 for leaves, -1 for free nodes
+        Int32 Height = -1;
+
+        // Exact object bounds and user data, leaves only
+        BoundBox ObjectBox;
+        void*    pUserData = nullptr;
+
+        bool IsLeaf() const { return Child[0] == InvalidNode; }
+    };
+
+    bool IsLeaf(Uint32 NodeIdx) const
+    {
+        return NodeIdx < m_Nodes.size() && m_Nodes[NodeIdx].Height == 0;
+    }
+
+    Uint32 AllocateNode();
+    void   FreeNode(Uint32 NodeIdx);
+
+    void   InsertLeaf(Uint32 Leaf);
+    void   RemoveLeaf(Uint32 Leaf);
+    Uint32 Balance(Uint32 NodeIdx);
+
+    // Recomputes the boxes and heights of all ancestors of the node, rebalancing them along the way
+    void RefitAncestors(Uint32 NodeIdx);
+
+    // Tests the box against the planes of the views in ViewMask. Removes the views the box is outside of from ViewMask,
+    // and the planes the box is fully inside of from PlaneMasks, which holds 8 bits for every view.
+    static void TestViews(const BoundBox& Box, const ViewFrustum* pFrustums, Uint32& ViewMask, Uint64& PlaneMasks);
+
+    float m_FatMargin;
+
+    std::vector<Node> m_Nodes;
+
+    Uint32 m_Root       = InvalidNode;
+    Uint32 m_FreeList   = InvalidNode;
+    Uint32 m_NumObjects = 0;
+};
+
+
+template <typename CallbackType>
+void DynamicAABBTree::QueryFrustums(const ViewFrustum*         pFrustums,
+                                    Uint32                     NumFrustums,
+                                    CallbackType&&             Callback,
+                                    const FRUSTUM_PLANE_FLAGS* pPlaneFlags) const
+{
+    DEV_CHECK_ERR(NumFrustums <= MaxViews, "The number of frustums (", NumFrustums, ") exceeds the maximum supported number (", MaxViews, ")");
+    if (m_Root == InvalidNode || NumFrustums == 0)
+        return;
+
+    NumFrustums = std::min(NumFrustums, MaxViews);
+
+    struct StackEntry
+    {
+        Uint32 NodeIdx;
+        Uint32 ViewMask;
+        Uint64 PlaneMasks;
+    };
+
+    StackEntry Root{m_Root, 0, 0};
+    for (Uint32 v = 0; v < NumFrustums; ++v)
+    {
+        const auto Flags = pPlaneFlags != nullptr ? pPlaneFlags[v] : FRUSTUM_PLANE_FLAG_FULL_FRUSTUM;
+        Root.ViewMask |= 1u << v;
+        Root.PlaneMasks |= Uint64{static_cast<Uint8>(Flags & FRUSTUM_PLANE_FLAG_FULL_FRUSTUM)} << (v * 8);
+    }
+
+    StackEntry Stack[MaxStackSize];
+    Uint32     StackSize = 0;
+    Stack[StackSize++]   = Root;
+    while (StackSize > 0)
+    {
+        auto        Entry = Stack[--StackSize];
+        const auto& N     = m_Nodes[Entry.NodeIdx];
+
+        if (Entry.PlaneMasks != 0)
+        {
+            // Leaves are tested against the exact bounds of the object
+            TestViews(N.IsLeaf() ? N.ObjectBox : N.Box, pFrustums, Entry.ViewMask, Entry.PlaneMasks);
+            if (Entry.ViewMask == 0)
+                continue;
+        }
+
+        if (N.IsLeaf())
+        {
+            Callback(Entry.NodeIdx, Entry.ViewMask);
+        }
+        else
+        {
+            VERIFY(StackSize + 2 <= MaxStackSize, "Dynamic AABB tree traversal stack overflow");
+            Stack[StackSize++] = {N.Child[1], Entry.ViewMask, Entry.PlaneMasks};
+            Stack[StackSize++] = {N.Child[0], Entry.ViewMask, Entry.PlaneMasks};
+        }
+    }
+}
+
+template <typename CallbackType>
+void DynamicAABBTree::QueryBox(const BoundBox& Box, CallbackType&& Callback) const
+{
+    if (m_Root == InvalidNode)
+        return;
+
+    auto Overlaps = [&Box](const BoundBox& B) {
+        // clang-format off
+        return B.Min.x <= Box.Max.x && B.Max.x >= Box.Min.x &&
+               B.Min.y <= Box.Max.y && B.Max.y >= Box.Min.y &&
+               B.Min.z <= Box.Max.z && B.Max.z >= Box.Min.z;
+        // clang-format on
+    };
+
+    Uint32 Stack[MaxStackSize];
+    Uint32 StackSize   = 0;
+    Stack[StackSize++] = m_Root;
+    while (StackSize > 0)
+    {
+        const auto  NodeIdx = Stack[--StackSize];
+        const auto& N       = m_Nodes[NodeIdx];
+        if (!Overlaps(N.Box))
+            continue;
+
+        if (N.IsLeaf())
+        {
+            if (Overlaps(N.ObjectBox) && !Callback(NodeIdx))
+                return;
+        }
+        else
+        {
+            VERIFY(StackSize + 2 <= MaxStackSize, "Dynamic AABB tree traversal stack overflow");
+            Stack[StackSize++] = N.Child[1];
+            Stack[StackSize++] = N.Child[0];
+        }
+    }
+}
+
+} // namespace Diligent
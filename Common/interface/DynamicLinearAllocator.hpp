@@ -31,6 +31,7 @@
 /// Defines Diligent::DynamicLinearAllocator class
 
 #include <vector>
+#include <cstring>
 
 #include "../../Primitives/interface/BasicTypes.h"
 #include "../../Primitives/interface/MemoryAllocator.h"
@@ -53,8 +54,8 @@ public:
     // clang-format on
 
     explicit DynamicLinearAllocator(IMemoryAllocator& Allocator, Uint32 BlockSize = 4 << 10) :
-        m_pAllocator{&Allocator},
-        m_BlockSize{BlockSize}
+        m_BlockSize{BlockSize},
+        m_pAllocator{&Allocator}
     {
         VERIFY(IsPowerOfTwo(BlockSize), "Block size (", BlockSize, ") is not power of two");
     }
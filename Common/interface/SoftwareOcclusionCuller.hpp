@@ -0,0 +1,198 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines Diligent::SoftwareOcclusionCuller class
+
+#include <vector>
+
+#include "../../Primitives/interface/BasicTypes.h"
+#include "AdvancedMath.hpp"
+
+namespace Diligent
+{
+
+class ThreadPool;
+
+/// Tiled depth-only software rasterizer that culls objects hidden behind occluders on the CPU.
+
+/// The culler renders a small set of low-resolution occluder meshes into a low-resolution depth
+/// buffer and then tests axis-aligned bounding boxes against the hierarchical-Z pyramid built
+/// from that buffer. Typical usage in a frame is:
+///
+///     Culler.BeginFrame(ViewProj);
+///     for (each occluder)
+///         Culler.AddOccluder(Vertices, NumVertices, Indices, NumIndices, World);
+///     Culler.RasterizeOccluders(&Pool);
+///     Culler.TestBoxes(Boxes, NumBoxes, IsOccluded);
+///
+/// Occluder triangles are transformed, clipped against the near plane and binned into screen tiles
+/// when they are added. RasterizeOccluders() then rasterizes every tile independently, optionally
+/// distributing the tiles between the threads of a thread pool. The inner rasterization loop processes
+/// 8 (AVX) or 4 (SSE2) pixels at a time and falls back to scalar code on other architectures.
+///
+/// Depth is stored in [0, 1] range with 0 at the near plane, regardless of the projection convention.
+/// The test is conservative: a box is only reported as occluded when every pixel it may cover
+/// contains an occluder that is closer than the nearest point of the box. Boxes that intersect the
+/// near plane or lie outside of the viewport are never reported as occluded; frustum culling
+/// (see GetBoxVisibility()) is expected to be performed separately.
+///
+/// \note   BeginFrame(), AddOccluder() and RasterizeOccluders() must be called from one thread.
+///         IsBoxOccluded() and TestBoxes() do not modify the culler and can be called
+///         from multiple threads once RasterizeOccluders() has returned.
+class SoftwareOcclusionCuller
+{
+public:
+    /// Screen tile width, in pixels. Tiles are the unit of work of RasterizeOccluders().
+    static constexpr Uint32 TileWidth = 32;
+    /// Screen tile height, in pixels.
+    static constexpr Uint32 TileHeight = 32;
+
+    /// \param [in] Width    - Depth buffer width, in pixels.
+    /// \param [in] Height   - Depth buffer height, in pixels.
+    /// \param [in] bIsGL    - Whether the matrices use OpenGL clip-space depth convention ([-1, 1]).
+    SoftwareOcclusionCuller(Uint32 Width, Uint32 Height, bool bIsGL);
+
+    // clang-format off
+    SoftwareOcclusionCuller           (const SoftwareOcclusionCuller&)  = delete;
+    SoftwareOcclusionCuller           (      SoftwareOcclusionCuller&&) = delete;
+    SoftwareOcclusionCuller& operator=(const SoftwareOcclusionCuller&)  = delete;
+    SoftwareOcclusionCuller& operator=(      SoftwareOcclusionCuller&&) = delete;
+    // clang-format on
+
+    /// Discards the occluders of the previous frame and sets the view-projection matrix
+    /// that is used to transform occluders and bounding boxes.
+    void BeginFrame(const float4x4& ViewProj);
+
+    /// Transforms, clips and bins occluder triangles.
+
+    /// \param [in] pVertices   - Occluder vertex positions in object space.
+    /// \param [in] NumVertices - Number of vertices.
+    /// \param [in] pIndices    - Triangle list indices.
+    /// \param [in] NumIndices  - Number of indices, must be a multiple of 3.
+    /// \param [in] World       - Object-to-world transform.
+    ///
+    /// \note   Triangles are rasterized regardless of their winding.
+    void AddOccluder(const float3*   pVertices,
+                     Uint32          NumVertices,
+                     const Uint32*   pIndices,
+                     Uint32          NumIndices,
+                     const float4x4& World);
+
+    /// Rasterizes all occluders added since the last call to BeginFrame() and builds
+    /// the hierarchical-Z pyramid.
+
+    /// \param [in] pThreadPool - Optional thread pool to distribute the tiles between.
+    ///                           If null, all tiles are rasterized by the calling thread.
+    ///
+    /// \note   The method waits for all tasks of the thread pool to complete, and must
+    ///         not be called from a worker thread of that pool.
+    void RasterizeOccluders(ThreadPool* pThreadPool = nullptr);
+
+    /// Tests if a world-space bounding box is hidden behind the occluders.
+    bool IsBoxOccluded(const BoundBox& Box) const;
+
+    /// Tests an array of world-space bounding boxes.
+
+    /// \param [in]  pBoxes      - Array of NumBoxes bounding boxes.
+    /// \param [in]  NumBoxes    - Number of boxes.
+    /// \param [out] pIsOccluded - Array of NumBoxes values that receive the results.
+    void TestBoxes(const BoundBox* pBoxes, Uint32 NumBoxes, bool* pIsOccluded) const;
+
+    /// Returns the depth of the pixel at the given location.
+    float GetDepth(Uint32 x, Uint32 y) const
+    {
+        VERIFY_EXPR(x < m_Width && y < m_Height);
+        return m_Depth[size_t{y} * size_t{m_Stride} + x];
+    }
+
+    Uint32 GetWidth() const { return m_Width; }
+    Uint32 GetHeight() const { return m_Height; }
+
+    /// Returns the number of occluder triangles added since the last call to BeginFrame(),
+    /// after near-plane clipping and trivial rejection.
+    Uint32 GetNumOccluderTriangles() const { return static_cast<Uint32>(m_Triangles.size()); }
+
+private:
+    struct TriangleSetup
+    {
+        // Edge functions E(x, y) = A * x + B * y + C that are non-negative inside the triangle
+        float EdgeA[3];
+        float EdgeB[3];
+        float EdgeC[3];
+
+        // Depth plane Z(x, y) = ZA * x + ZB * y + ZC
+        float ZA;
+        float ZB;
+        float ZC;
+
+        // Pixel bounding box, inclusive
+        Int32 MinX;
+        Int32 MinY;
+        Int32 MaxX;
+        Int32 MaxY;
+    };
+
+    void AddClippedTriangle(const float4& V0, const float4& V1, const float4& V2);
+    void SetupTriangle(const float3& V0, const float3& V1, const float3& V2);
+    void RasterizeTile(Uint32 TileX, Uint32 TileY);
+    void BuildTileHiZ(Uint32 TileX, Uint32 TileY);
+    void BuildCoarseHiZ();
+
+    bool IsRectOccluded(Uint32 Level, Int32 MinX, Int32 MinY, Int32 MaxX, Int32 MaxY, float BoxMinDepth) const;
+
+    const Uint32 m_Width;
+    const Uint32 m_Height;
+    const bool   m_bIsGL;
+
+    // Dimensions of the depth buffer rounded up to the tile size
+    const Uint32 m_NumTilesX;
+    const Uint32 m_NumTilesY;
+    const Uint32 m_Stride;
+
+    float4x4 m_ViewProj;
+
+    // Full-resolution depth buffer, which is also level 0 of the hierarchical-Z pyramid
+    std::vector<float> m_Depth;
+
+    struct HiZLevel
+    {
+        Uint32             Width  = 0;
+        Uint32             Height = 0;
+        std::vector<float> MaxDepth;
+    };
+    // Levels 1 and above of the hierarchical-Z pyramid. Every texel contains
+    // the maximum (farthest) depth of the 2x2 texels of the previous level.
+    std::vector<HiZLevel> m_HiZ;
+
+    std::vector<TriangleSetup>       m_Triangles;
+    std::vector<std::vector<Uint32>> m_TileBins;
+};
+
+} // namespace Diligent
@@ -0,0 +1,121 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines Diligent::ThreadPool class
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+#include "../../Primitives/interface/BasicTypes.h"
+
+namespace Diligent
+{
+
+/// Work-stealing thread pool.
+
+/// Every worker thread owns a task queue. Tasks enqueued from outside of the pool are
+/// distributed between the queues in round-robin fashion; tasks enqueued by a worker thread
+/// go to its own queue. A worker takes tasks from the back of its own queue and, when the queue
+/// is empty, steals tasks from the front of the other queues, so that all threads are kept busy
+/// even when task durations vary widely.
+class ThreadPool
+{
+public:
+    /// Task function. The argument is the index of the worker thread that executes the task,
+    /// which is in the range [0, GetNumThreads()) and can be used to access per-thread data.
+    using TaskType = std::function<void(Uint32 ThreadId)>;
+
+    /// \param [in] NumThreads - Number of worker threads. If 0, the number of hardware threads is used.
+    explicit ThreadPool(Uint32 NumThreads = 0);
+
+    /// Waits for all tasks to complete and stops the worker threads.
+    ~ThreadPool();
+
+    // clang-format off
+    ThreadPool           (const ThreadPool&)  = delete;
+    ThreadPool           (      ThreadPool&&) = delete;
+    ThreadPool& operator=(const ThreadPool&)  = delete;
+    ThreadPool& operator=(      ThreadPool&&) = delete;
+    // clang-format on
+
+    /// Enqueues the task. The method is thread-safe and can be called from within a task.
+
+    /// \note Exceptions thrown by the task are caught and logged by the pool. Tasks that need to
+    ///       report errors to the caller should handle exceptions themselves.
+    void EnqueueTask(TaskType Task);
+
+    /// Waits until all enqueued tasks, including the tasks enqueued by other tasks, are complete.
+
+    /// \note This method must not be called from a worker thread.
+    void WaitForAllTasks();
+
+    /// Returns the number of worker threads.
+    Uint32 GetNumThreads() const { return static_cast<Uint32>(m_Threads.size()); }
+
+    /// Returns the number of tasks that have been enqueued, but not yet completed.
+    Uint32 GetNumPendingTasks() const { return m_NumPendingTasks.load(); }
+
+    /// If the calling thread is a worker thread of this pool, returns its index.
+    /// Otherwise returns ~0u.
+    Uint32 GetCurrentThreadId() const;
+
+private:
+    void WorkerThreadFunc(Uint32 ThreadId);
+    bool PopTask(Uint32 ThreadId, TaskType& Task);
+
+    struct TaskQueue
+    {
+        std::mutex           Mtx;
+        std::deque<TaskType> Tasks;
+    };
+    std::vector<std::unique_ptr<TaskQueue>> m_Queues;
+    std::vector<std::thread>                m_Threads;
+
+    std::atomic<Uint32> m_NextQueue{0};
+
+    // Number of tasks in the queues. Modified under m_SignalMtx when a task is enqueued,
+    // so that a worker checking the wait condition does not miss the notification.
+    std::atomic<Int32> m_NumQueuedTasks{0};
+    // Number of tasks that have been enqueued but have not completed yet.
+    std::atomic<Uint32> m_NumPendingTasks{0};
+
+    std::mutex              m_SignalMtx;
+    std::condition_variable m_WorkCV;
+    std::condition_variable m_IdleCV;
+    bool                    m_Stop = false;
+};
+
+} // namespace Diligent
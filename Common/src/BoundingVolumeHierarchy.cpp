@@ -0,0 +1,556 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#include "BoundingVolumeHierarchy.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define BVH_USE_SSE2 1
+#endif
+
+#include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+constexpr Uint32 BoundingVolumeHierarchy::InvalidPrimitive;
+constexpr Uint32 BoundingVolumeHierarchy::MaxLeafSize;
+constexpr Uint32 BoundingVolumeHierarchy::InvalidNode;
+constexpr Uint32 BoundingVolumeHierarchy::MaxStackSize;
+
+namespace
+{
+
+// Number of bins used to evaluate the surface area heuristic along each axis
+constexpr Uint32 NumSAHBins = 16;
+
+// Cost of traversing a node relative to the cost of intersecting a primitive
+constexpr float TraversalCost = 1.f;
+
+// Ranges larger than this are split between threads
+constexpr Uint32 MinParallelBuildSize = 4096;
+
+// Below this depth of the binary tree, splits fall back to the median so that
+// the depth of the tree, and hence the traversal stack size, is bounded.
+constexpr Uint32 MaxSAHDepth = 48;
+
+const BoundBox EmptyBox{float3{+FLT_MAX, +FLT_MAX, +FLT_MAX}, float3{-FLT_MAX, -FLT_MAX, -FLT_MAX}};
+
+void ExpandBox(BoundBox& Box, const BoundBox& Other)
+{
+    Box.Min = std::min(Box.Min, Other.Min);
+    Box.Max = std::max(Box.Max, Other.Max);
+}
+
+float GetHalfSurfaceArea(const BoundBox& Box)
+{
+    const auto Size = Box.Max - Box.Min;
+    return Size.x * Size.y + Size.y * Size.z + Size.z * Size.x;
+}
+
+// Node of the intermediate binary tree
+struct BuildNode
+{
+    BoundBox Box;
+
+    // Child nodes of an internal node
+    Uint32 Left  = 0;
+    Uint32 Right = 0;
+
+    // Primitive range of a leaf
+    Uint32 First    = 0;
+    Uint32 NumPrims = 0;
+};
+
+struct BuildContext
+{
+    const BoundBox*        pPrimBoxes = nullptr;
+    std::vector<float3>    Centroids;
+    std::vector<Uint32>    PrimIds;
+    std::vector<BuildNode> Nodes;
+    std::atomic<Uint32>    NumNodes{0};
+    ThreadPool*            pThreadPool = nullptr;
+
+    Uint32 AllocateNodes(Uint32 Count)
+    {
+        const auto Idx = NumNodes.fetch_add(Count);
+        VERIFY_EXPR(Idx + Count <= Nodes.size());
+        return Idx;
+    }
+
+    void BuildRecursive(Uint32 NodeIdx, Uint32 Begin, Uint32 End, Uint32 Depth);
+
+    // Returns the split position, or End if the range should become a leaf
+    Uint32 Split(const BoundBox& NodeBox, Uint32 Begin, Uint32 End, Uint32 Depth);
+};
+
+Uint32 BuildContext::Split(const BoundBox& NodeBox, Uint32 Begin, Uint32 End, Uint32 Depth)
+{
+    const auto NumPrims = End - Begin;
+    if (NumPrims <= 1)
+        return End;
+
+    BoundBox CentroidBox = EmptyBox;
+    for (Uint32 i = Begin; i < End; ++i)
+    {
+        const auto& C   = Centroids[PrimIds[i]];
+        CentroidBox.Min = std::min(CentroidBox.Min, C);
+        CentroidBox.Max = std::max(CentroidBox.Max, C);
+    }
+
+    const auto CentroidExtent = CentroidBox.Max - CentroidBox.Min;
+    const auto SplitAxis      = CentroidExtent.x >= CentroidExtent.y && CentroidExtent.x >= CentroidExtent.z ? 0 : (CentroidExtent.y >= CentroidExtent.z ? 1 : 2);
+    if (CentroidExtent[SplitAxis] <= 0)
+    {
+        // All centroids coincide, so no split is better than the other
+        return NumPrims <= BoundingVolumeHierarchy::MaxLeafSize ? End : Begin + NumPrims / 2;
+    }
+
+    auto MedianSplit = [&]() {
+        const auto Mid = Begin + NumPrims / 2;
+        std::nth_element(PrimIds.begin() + Begin, PrimIds.begin() + Mid, PrimIds.begin() + End,
+                         [&](Uint32 Id0, Uint32 Id1) { return Centroids[Id0][SplitAxis] < Centroids[Id1][SplitAxis]; });
+        return Mid;
+    };
+
+    if (Depth >= MaxSAHDepth)
+        return MedianSplit();
+
+    struct Bin
+    {
+        BoundBox Box      = EmptyBox;
+        Uint32   NumPrims = 0;
+    };
+
+    float  BestCost = FLT_MAX;
+    int    BestAxis = -1;
+    Uint32 BestBin  = 0;
+    for (int Axis = 0; Axis < 3; ++Axis)
+    {
+        if (CentroidExtent[Axis] <= 0)
+            continue;
+
+        Bin        Bins[NumSAHBins];
+        const auto Scale = static_cast<float>(NumSAHBins) / CentroidExtent[Axis];
+        for (Uint32 i = Begin; i < End; ++i)
+        {
+            const auto PrimId = PrimIds[i];
+            const auto BinIdx = std::min(static_cast<Uint32>((Centroids[PrimId][Axis] - CentroidBox.Min[Axis]) * Scale), NumSAHBins - 1);
+            ExpandBox(Bins[BinIdx].Box, pPrimBoxes[PrimId]);
+            ++Bins[BinIdx].NumPrims;
+        }
+
+        // Sweep from the right to compute the cost of the right side of every split
+        float    RightCost[NumSAHBins];
+        BoundBox RightBox      = EmptyBox;
+        Uint32   NumRightPrims = 0;
+        for (Uint32 b = NumSAHBins - 1; b > 0; --b)
+        {
+            ExpandBox(RightBox, Bins[b].Box);
+            NumRightPrims += Bins[b].NumPrims;
+            RightCost[b] = NumRightPrims > 0 ? GetHalfSurfaceArea(RightBox) * static_cast<float>(NumRightPrims) : 0;
+        }
+
+        // Sweep from the left; the split after bin b puts bins [0, b] to the left
+        BoundBox LeftBox      = EmptyBox;
+        Uint32   NumLeftPrims = 0;
+        for (Uint32 b = 0; b < NumSAHBins - 1; ++b)
+        {
+            ExpandBox(LeftBox, Bins[b].Box);
+            NumLeftPrims += Bins[b].NumPrims;
+            if (NumLeftPrims == 0 || NumLeftPrims == NumPrims)
+                continue;
+
+            const auto Cost = GetHalfSurfaceArea(LeftBox) * static_cast<float>(NumLeftPrims) + RightCost[b + 1];
+            if (Cost < BestCost)
+            {
+                BestCost = Cost;
+                BestAxis = Axis;
+                BestBin  = b;
+            }
+        }
+    }
+
+    if (BestAxis < 0)
+        return MedianSplit();
+
+    const auto NodeArea = GetHalfSurfaceArea(NodeBox);
+    const auto LeafCost = static_cast<float>(NumPrims);
+    const auto SplitCost =
+        TraversalCost + (NodeArea > 0 ? BestCost / NodeArea : static_cast<float>(NumPrims));
+    if (NumPrims <= BoundingVolumeHierarchy::MaxLeafSize && LeafCost <= SplitCost)
+        return End;
+
+    const auto Scale = static_cast<float>(NumSAHBins) / CentroidExtent[BestAxis];
+    const auto Mid   = std::partition(PrimIds.begin() + Begin, PrimIds.begin() + End,
+                                    [&](Uint32 PrimId) {
+                                        const auto BinIdx = std::min(static_cast<Uint32>((Centroids[PrimId][BestAxis] - CentroidBox.Min[BestAxis]) * Scale), NumSAHBins - 1);
+                                        return BinIdx <= BestBin;
+                                    });
+    return static_cast<Uint32>(Mid - PrimIds.begin());
+}
+
+void BuildContext::BuildRecursive(Uint32 NodeIdx, Uint32 Begin, Uint32 End, Uint32 Depth)
+{
+    // Ranges are processed by one thread at a time, and every thread writes to its own nodes.
+    while (true)
+    {
+        auto& Node = Nodes[NodeIdx];
+
+        Node.Box = EmptyBox;
+        for (Uint32 i = Begin; i < End; ++i)
+            ExpandBox(Node.Box, pPrimBoxes[PrimIds[i]]);
+
+        const auto Mid = Split(Node.Box, Begin, End, Depth);
+        if (Mid == End)
+        {
+            VERIFY_EXPR(End - Begin <= BoundingVolumeHierarchy::MaxLeafSize);
+            Node.First    = Begin;
+            Node.NumPrims = End - Begin;
+            return;
+        }
+        VERIFY_EXPR(Mid > Begin && Mid < End);
+
+        Node.Left  = AllocateNodes(2);
+        Node.Right = Node.Left + 1;
+        ++Depth;
+
+        const auto LeftIdx = Node.Left;
+        if (pThreadPool != nullptr && Mid - Begin >= MinParallelBuildSize)
+        {
+            pThreadPool->EnqueueTask([this, LeftIdx, Begin, Mid, Depth](Uint32) { BuildRecursive(LeftIdx, Begin, Mid, Depth); });
+        }
+        else
+        {
+            BuildRecursive(LeftIdx, Begin, Mid, Depth);
+        }
+
+        // Continue with the right child in this thread
+        NodeIdx = Node.Right;
+        Begin   = Mid;
+    }
+}
+
+} // namespace
+
+
+void BoundingVolumeHierarchy::Build(const BoundBox* pPrimBoxes, Uint32 NumPrims, ThreadPool* pThreadPool)
+{
+    m_Nodes.clear();
+    m_PrimIds.clear();
+    m_PrimBoxes.clear();
+    if (NumPrims == 0)
+        return;
+
+    if (pThreadPool != nullptr)
+        VERIFY(pThreadPool->GetCurrentThreadId() == ~0u, "BVH must not be built from a worker thread of the pool");
+
+    BuildContext Ctx;
+    Ctx.pPrimBoxes  = pPrimBoxes;
+    Ctx.pThreadPool = pThreadPool;
+    Ctx.Centroids.resize(NumPrims);
+    Ctx.PrimIds.resize(NumPrims);
+    for (Uint32 i = 0; i < NumPrims; ++i)
+    {
+        Ctx.Centroids[i] = (pPrimBoxes[i].Min + pPrimBoxes[i].Max) * 0.5f;
+        Ctx.PrimIds[i]   = i;
+    }
+    // A binary tree with N leaves has 2N-1 nodes
+    Ctx.Nodes.resize(size_t{NumPrims} * 2 - 1);
+
+    const auto RootIdx = Ctx.AllocateNodes(1);
+    Ctx.BuildRecursive(RootIdx, 0, NumPrims, 0);
+    if (pThreadPool != nullptr)
+        pThreadPool->WaitForAllTasks();
+
+    // Collapse the binary tree into the four-wide tree. Nodes are written in depth-first
+    // order, so every node precedes its children, which is relied upon by Refit().
+    m_Nodes.reserve(Ctx.NumNodes.load() / 2 + 1);
+    m_PrimIds = std::move(Ctx.PrimIds);
+
+    std::function<Uint32(Uint32)> CollapseNode = [&](Uint32 BinaryIdx) -> Uint32 {
+        const auto NodeIdx = static_cast<Uint32>(m_Nodes.size());
+        m_Nodes.emplace_back();
+
+        // Gather up to 4 children, opening the internal child with the largest surface area first
+        Uint32 Children[4];
+        Uint32 NumChildren = 0;
+        if (Ctx.Nodes[BinaryIdx].NumPrims != 0)
+        {
+            // Single leaf at the root
+            Children[NumChildren++] = BinaryIdx;
+        }
+        else
+        {
+            Children[NumChildren++] = Ctx.Nodes[BinaryIdx].Left;
+            Children[NumChildren++] = Ctx.Nodes[BinaryIdx].Right;
+        }
+        while (NumChildren < 4)
+        {
+            int   BestChild = -1;
+            float BestArea  = -1;
+            for (Uint32 c = 0; c < NumChildren; ++c)
+            {
+                const auto& Child = Ctx.Nodes[Children[c]];
+                if (Child.NumPrims == 0 && GetHalfSurfaceArea(Child.Box) > BestArea)
+                {
+                    BestChild = static_cast<int>(c);
+                    BestArea  = GetHalfSurfaceArea(Child.Box);
+                }
+            }
+            if (BestChild < 0)
+                break;
+
+            const auto& Opened      = Ctx.Nodes[Children[BestChild]];
+            Children[BestChild]     = Opened.Left;
+            Children[NumChildren++] = Opened.Right;
+        }
+
+        for (Uint32 Slot = 0; Slot < 4; ++Slot)
+        {
+            Uint32   ChildIdx     = InvalidNode;
+            Uint32   NumLeafPrims = 0;
+            BoundBox Box          = EmptyBox;
+            if (Slot < NumChildren)
+            {
+                const auto& Child = Ctx.Nodes[Children[Slot]];
+                Box               = Child.Box;
+                if (Child.NumPrims != 0)
+                {
+                    ChildIdx     = Child.First;
+                    NumLeafPrims = Child.NumPrims;
+                }
+                else
+                {
+                    ChildIdx = CollapseNode(Children[Slot]);
+                }
+            }
+
+            // m_Nodes may have been reallocated by the recursive call
+            auto& N          = m_Nodes[NodeIdx];
+            N.Child[Slot]    = ChildIdx;
+            N.NumPrims[Slot] = NumLeafPrims;
+            SetChildBox(N, Slot, Box);
+        }
+
+        return NodeIdx;
+    };
+    CollapseNode(RootIdx);
+
+    m_PrimBoxes.resize(NumPrims);
+    for (Uint32 i = 0; i < NumPrims; ++i)
+        m_PrimBoxes[i] = pPrimBoxes[m_PrimIds[i]];
+}
+
+void BoundingVolumeHierarchy::SetChildBox(Node& N, Uint32 Slot, const BoundBox& Box)
+{
+    N.MinX[Slot] = Box.Min.x;
+    N.MinY[Slot] = Box.Min.y;
+    N.MinZ[Slot] = Box.Min.z;
+    N.MaxX[Slot] = Box.Max.x;
+    N.MaxY[Slot] = Box.Max.y;
+    N.MaxZ[Slot] = Box.Max.z;
+}
+
+void BoundingVolumeHierarchy::Refit(const BoundBox* pPrimBoxes)
+{
+    for (size_t i = 0; i < m_PrimIds.size(); ++i)
+        m_PrimBoxes[i] = pPrimBoxes[m_PrimIds[i]];
+
+    // Children always follow their parents, so processing the nodes in reverse order
+    // updates every child before its parent.
+    for (size_t NodeIdx = m_Nodes.size(); NodeIdx > 0; --NodeIdx)
+    {
+        auto& N = m_Nodes[NodeIdx - 1];
+        for (Uint32 Slot = 0; Slot < 4; ++Slot)
+        {
+            if (N.Child[Slot] == InvalidNode)
+                continue;
+
+            BoundBox Box = EmptyBox;
+            if (N.NumPrims[Slot] != 0)
+            {
+                for (Uint32 p = N.Child[Slot]; p < N.Child[Slot] + N.NumPrims[Slot]; ++p)
+                    ExpandBox(Box, m_PrimBoxes[p]);
+            }
+            else
+            {
+                const auto& Child = m_Nodes[N.Child[Slot]];
+                for (Uint32 c = 0; c < 4; ++c)
+                {
+                    if (Child.Child[c] != InvalidNode)
+                    {
+                        ExpandBox(Box, BoundBox{float3{Child.MinX[c], Child.MinY[c], Child.MinZ[c]}, float3{Child.MaxX[c], Child.MaxY[c], Child.MaxZ[c]}});
+                    }
+                }
+            }
+            SetChildBox(N, Slot, Box);
+        }
+    }
+}
+
+BoundBox BoundingVolumeHierarchy::GetBounds() const
+{
+    BoundBox Bounds = EmptyBox;
+    if (m_Nodes.empty())
+        return BoundBox{};
+
+    const auto& Root = m_Nodes[0];
+    for (Uint32 c = 0; c < 4; ++c)
+    {
+        if (Root.Child[c] != InvalidNode)
+        {
+            ExpandBox(Bounds, BoundBox{float3{Root.MinX[c], Root.MinY[c], Root.MinZ[c]}, float3{Root.MaxX[c], Root.MaxY[c], Root.MaxZ[c]}});
+        }
+    }
+    return Bounds;
+}
+
+void BoundingVolumeHierarchy::ComputeTriangleBounds(const float3* pVertices, const Uint32* pIndices, Uint32 NumTriangles, BoundBox* pBoxes)
+{
+    for (Uint32 t = 0; t < NumTriangles; ++t)
+    {
+        const auto& V0 = pVertices[pIndices[t * 3 + 0]];
+        const auto& V1 = pVertices[pIndices[t * 3 + 1]];
+        const auto& V2 = pVertices[pIndices[t * 3 + 2]];
+
+        pBoxes[t].Min = std::min(std::min(V0, V1), V2);
+        pBoxes[t].Max = std::max(std::max(V0, V1), V2);
+    }
+}
+
+BoundingVolumeHierarchy::RayData BoundingVolumeHierarchy::PrepareRay(const Ray& R)
+{
+    VERIFY_EXPR(R.Direction != float3(0, 0, 0));
+
+    RayData RD;
+    for (int i = 0; i < 3; ++i)
+    {
+        RD.Origin[i]     = R.Origin[i];
+        RD.InvDir[i]     = 1.f / R.Direction[i];
+        RD.IsNegative[i] = R.Direction[i] < 0;
+    }
+    return RD;
+}
+
+#if BVH_USE_SSE2
+
+Uint32 BoundingVolumeHierarchy::IntersectNode(const Node& N, const RayData& R, float MaxDist, float EntryDist[])
+{
+    // Selecting the near and far slab planes by the direction sign makes inverted
+    // boxes of unused children fail the test, as their near distance exceeds the far one.
+    // clang-format off
+    const __m128 NearX = _mm_loadu_ps(R.IsNegative[0] ? N.MaxX : N.MinX);
+    const __m128 NearY = _mm_loadu_ps(R.IsNegative[1] ? N.MaxY : N.MinY);
+    const __m128 NearZ = _mm_loadu_ps(R.IsNegative[2] ? N.MaxZ : N.MinZ);
+    const __m128 FarX  = _mm_loadu_ps(R.IsNegative[0] ? N.MinX : N.MaxX);
+    const __m128 FarY  = _mm_loadu_ps(R.IsNegative[1] ? N.MinY : N.MaxY);
+    const __m128 FarZ  = _mm_loadu_ps(R.IsNegative[2] ? N.MinZ : N.MaxZ);
+
+    const __m128 OrigX = _mm_set1_ps(R.Origin[0]);
+    const __m128 OrigY = _mm_set1_ps(R.Origin[1]);
+    const __m128 OrigZ = _mm_set1_ps(R.Origin[2]);
+    const __m128 InvDirX = _mm_set1_ps(R.InvDir[0]);
+    const __m128 InvDirY = _mm_set1_ps(R.InvDir[1]);
+    const __m128 InvDirZ = _mm_set1_ps(R.InvDir[2]);
+
+    const __m128 Enter = _mm_max_ps(_mm_max_ps(_mm_mul_ps(_mm_sub_ps(NearX, OrigX), InvDirX),
+                                               _mm_mul_ps(_mm_sub_ps(NearY, OrigY), InvDirY)),
+                                    _mm_max_ps(_mm_mul_ps(_mm_sub_ps(NearZ, OrigZ), InvDirZ),
+                                               _mm_setzero_ps()));
+    const __m128 Exit  = _mm_min_ps(_mm_min_ps(_mm_mul_ps(_mm_sub_ps(FarX, OrigX), InvDirX),
+                                               _mm_mul_ps(_mm_sub_ps(FarY, OrigY), InvDirY)),
+                                    _mm_min_ps(_mm_mul_ps(_mm_sub_ps(FarZ, OrigZ), InvDirZ),
+                                               _mm_set1_ps(MaxDist)));
+    // clang-format on
+
+    _mm_storeu_ps(EntryDist, Enter);
+    return static_cast<Uint32>(_mm_movemask_ps(_mm_cmple_ps(Enter, Exit)));
+}
+
+Uint32 BoundingVolumeHierarchy::OverlapNode(const Node& N, const BoundBox& Box)
+{
+    // clang-format off
+    const __m128 Overlap =
+        _mm_and_ps(_mm_and_ps(_mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(N.MinX), _mm_set1_ps(Box.Max.x)),
+                                         _mm_cmpge_ps(_mm_loadu_ps(N.MaxX), _mm_set1_ps(Box.Min.x))),
+                              _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(N.MinY), _mm_set1_ps(Box.Max.y)),
+                                         _mm_cmpge_ps(_mm_loadu_ps(N.MaxY), _mm_set1_ps(Box.Min.y)))),
+                   _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(N.MinZ), _mm_set1_ps(Box.Max.z)),
+                              _mm_cmpge_ps(_mm_loadu_ps(N.MaxZ), _mm_set1_ps(Box.Min.z))));
+    // clang-format on
+    return static_cast<Uint32>(_mm_movemask_ps(Overlap));
+}
+
+#else
+
+Uint32 BoundingVolumeHierarchy::IntersectNode(const Node& N, const RayData& R, float MaxDist, float EntryDist[])
+{
+    // clang-format off
+    const float* Near[] = {R.IsNegative[0] ? N.MaxX : N.MinX, R.IsNegative[1] ? N.MaxY : N.MinY, R.IsNegative[2] ? N.MaxZ : N.MinZ};
+    const float* Far[]  = {R.IsNegative[0] ? N.MinX : N.MaxX, R.IsNegative[1] ? N.MinY : N.MaxY, R.IsNegative[2] ? N.MinZ : N.MaxZ};
+    // clang-format on
+
+    Uint32 HitMask = 0;
+    for (Uint32 c = 0; c < 4; ++c)
+    {
+        float Enter = 0;
+        float Exit  = MaxDist;
+        for (int i = 0; i < 3; ++i)
+        {
+            Enter = std::max((Near[i][c] - R.Origin[i]) * R.InvDir[i], Enter);
+            Exit  = std::min((Far[i][c] - R.Origin[i]) * R.InvDir[i], Exit);
+        }
+        EntryDist[c] = Enter;
+        if (Enter <= Exit)
+            HitMask |= 1u << c;
+    }
+    return HitMask;
+}
+
+Uint32 BoundingVolumeHierarchy::OverlapNode(const Node& N, const BoundBox& Box)
+{
+    Uint32 HitMask = 0;
+    for (Uint32 c = 0; c < 4; ++c)
+    {
+        // clang-format off
+        if (N.MinX[c] <= Box.Max.x && N.MaxX[c] >= Box.Min.x &&
+            N.MinY[c] <= Box.Max.y && N.MaxY[c] >= Box.Min.y &&
+            N.MinZ[c] <= Box.Max.z && N.MaxZ[c] >= Box.Min.z)
+            HitMask |= 1u << c;
+        // clang-format on
+    }
+    return HitMask;
+}
+
+#endif
+
+} // namespace Diligent
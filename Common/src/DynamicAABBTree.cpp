@@ -0,0 +1,359 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#include "DynamicAABBTree.hpp"
+
+#include <algorithm>
+
+#include "../../Platforms/interface/PlatformMisc.hpp"
+#include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+constexpr DynamicAABBTree::ObjectId DynamicAABBTree::InvalidObject;
+constexpr Uint32                    DynamicAABBTree::MaxViews;
+constexpr Uint32                    DynamicAABBTree::InvalidNode;
+constexpr Uint32                    DynamicAABBTree::MaxStackSize;
+
+namespace
+{
+
+BoundBox CombineBoxes(const BoundBox& Box0, const BoundBox& Box1)
+{
+    return BoundBox{std::min(Box0.Min, Box1.Min), std::max(Box0.Max, Box1.Max)};
+}
+
+bool ContainsBox(const BoundBox& Outer, const BoundBox& Inner)
+{
+    // clang-format off
+    return Outer.Min.x <= Inner.Min.x && Outer.Min.y <= Inner.Min.y && Outer.Min.z <= Inner.Min.z &&
+           Outer.Max.x >= Inner.Max.x && Outer.Max.y >= Inner.Max.y && Outer.Max.z >= Inner.Max.z;
+    // clang-format on
+}
+
+float GetHalfSurfaceArea(const BoundBox& Box)
+{
+    const auto Size = Box.Max - Box.Min;
+    return Size.x * Size.y + Size.y * Size.z + Size.z * Size.x;
+}
+
+} // namespace
+
+DynamicAABBTree::DynamicAABBTree(float FatMargin) :
+    m_FatMargin{FatMargin}
+{
+    DEV_CHECK_ERR(FatMargin >= 0, "Fat margin must not be negative");
+}
+
+Uint32 DynamicAABBTree::AllocateNode()
+{
+    Uint32 NodeIdx = m_FreeList;
+    if (NodeIdx != InvalidNode)
+    {
+        m_FreeList       = m_Nodes[NodeIdx].Parent;
+        m_Nodes[NodeIdx] = Node{};
+    }
+    else
+    {
+        NodeIdx = static_cast<Uint32>(m_Nodes.size());
+        m_Nodes.emplace_back();
+    }
+    m_Nodes[NodeIdx].Height = 0;
+    return NodeIdx;
+}
+
+void DynamicAABBTree::FreeNode(Uint32 NodeIdx)
+{
+    auto& N = m_Nodes[NodeIdx];
+
+    // Free nodes are linked through the parent index
+    N.Parent    = m_FreeList;
+    N.Child[0]  = InvalidNode;
+    N.Child[1]  = InvalidNode;
+    N.Height    = -1;
+    N.pUserData = nullptr;
+    m_FreeList  = NodeIdx;
+}
+
+DynamicAABBTree::ObjectId DynamicAABBTree::Insert(const BoundBox& Box, void* pUserData)
+{
+    const auto Leaf = AllocateNode();
+
+    auto& N     = m_Nodes[Leaf];
+    N.ObjectBox = Box;
+    N.Box       = BoundBox{Box.Min - float3{m_FatMargin, m_FatMargin, m_FatMargin}, Box.Max + float3{m_FatMargin, m_FatMargin, m_FatMargin}};
+    N.pUserData = pUserData;
+
+    InsertLeaf(Leaf);
+    ++m_NumObjects;
+
+    return Leaf;
+}
+
+void DynamicAABBTree::Remove(ObjectId Id)
+{
+    if (!IsLeaf(Id))
+    {
+        UNEXPECTED("Object ", Id, " is not in the tree");
+        return;
+    }
+
+    RemoveLeaf(Id);
+    FreeNode(Id);
+    VERIFY_EXPR(m_NumObjects > 0);
+    --m_NumObjects;
+}
+
+bool DynamicAABBTree::Move(ObjectId Id, const BoundBox& Box, const float3& Displacement)
+{
+    if (!IsLeaf(Id))
+    {
+        UNEXPECTED("Object ", Id, " is not in the tree");
+        return false;
+    }
+
+    auto& N     = m_Nodes[Id];
+    N.ObjectBox = Box;
+    if (ContainsBox(N.Box, Box))
+        return false;
+
+    RemoveLeaf(Id);
+
+    // Enlarge the box by the margin and extend it in the direction of motion
+    auto& Leaf   = m_Nodes[Id];
+    Leaf.Box.Min = Box.Min - float3{m_FatMargin, m_FatMargin, m_FatMargin} + std::min(Displacement, float3{});
+    Leaf.Box.Max = Box.Max + float3{m_FatMargin, m_FatMargin, m_FatMargin} + std::max(Displacement, float3{});
+
+    InsertLeaf(Id);
+    return true;
+}
+
+void DynamicAABBTree::InsertLeaf(Uint32 Leaf)
+{
+    if (m_Root == InvalidNode)
+    {
+        m_Root               = Leaf;
+        m_Nodes[Leaf].Parent = InvalidNode;
+        return;
+    }
+
+    // Find the best sibling for the new leaf by descending the tree and choosing the child
+    // that minimizes the total surface area increase of the tree.
+    const auto LeafBox = m_Nodes[Leaf].Box;
+    Uint32     Sibling = m_Root;
+    while (!m_Nodes[Sibling].IsLeaf())
+    {
+        const auto& N        = m_Nodes[Sibling];
+        const float Area     = GetHalfSurfaceArea(N.Box);
+        const float Combined = GetHalfSurfaceArea(CombineBoxes(N.Box, LeafBox));
+
+        // Cost of creating a new parent for this node and the new leaf
+        const float Cost = 2 * Combined;
+        // Minimum cost of pushing the leaf further down the tree
+        const float InheritanceCost = 2 * (Combined - Area);
+
+        float ChildCost[2];
+        for (int c = 0; c < 2; ++c)
+        {
+            const auto& Child        = m_Nodes[N.Child[c]];
+            const float ChildNewArea = GetHalfSurfaceArea(CombineBoxes(Child.Box, LeafBox));
+            ChildCost[c]             = Child.IsLeaf() ?
+                ChildNewArea + InheritanceCost :
+                ChildNewArea - GetHalfSurfaceArea(Child.Box) + InheritanceCost;
+        }
+
+        if (Cost < ChildCost[0] && Cost < ChildCost[1])
+            break;
+
+        Sibling = ChildCost[0] < ChildCost[1] ? N.Child[0] : N.Child[1];
+    }
+
+    // Create a new parent for the sibling and the leaf
+    const auto OldParent = m_Nodes[Sibling].Parent;
+    const auto NewParent = AllocateNode();
+    {
+        auto& P    = m_Nodes[NewParent];
+        P.Parent   = OldParent;
+        P.Box      = CombineBoxes(LeafBox, m_Nodes[Sibling].Box);
+        P.Height   = m_Nodes[Sibling].Height + 1;
+        P.Child[0] = Sibling;
+        P.Child[1] = Leaf;
+    }
+
+    if (OldParent != InvalidNode)
+    {
+        auto& OP                                 = m_Nodes[OldParent];
+        OP.Child[OP.Child[0] == Sibling ? 0 : 1] = NewParent;
+    }
+    else
+    {
+        m_Root = NewParent;
+    }
+    m_Nodes[Sibling].Parent = NewParent;
+    m_Nodes[Leaf].Parent    = NewParent;
+
+    RefitAncestors(NewParent);
+}
+
+void DynamicAABBTree::RemoveLeaf(Uint32 Leaf)
+{
+    if (Leaf == m_Root)
+    {
+        m_Root = InvalidNode;
+        return;
+    }
+
+    // Replace the parent with the sibling
+    const auto Parent      = m_Nodes[Leaf].Parent;
+    const auto GrandParent = m_Nodes[Parent].Parent;
+    const auto Sibling     = m_Nodes[Parent].Child[m_Nodes[Parent].Child[0] == Leaf ? 1 : 0];
+
+    m_Nodes[Sibling].Parent = GrandParent;
+    FreeNode(Parent);
+    m_Nodes[Leaf].Parent = InvalidNode;
+
+    if (GrandParent != InvalidNode)
+    {
+        auto& GP                                = m_Nodes[GrandParent];
+        GP.Child[GP.Child[0] == Parent ? 0 : 1] = Sibling;
+        RefitAncestors(GrandParent);
+    }
+    else
+    {
+        m_Root = Sibling;
+    }
+}
+
+void DynamicAABBTree::RefitAncestors(Uint32 NodeIdx)
+{
+    while (NodeIdx != InvalidNode)
+    {
+        NodeIdx = Balance(NodeIdx);
+
+        auto&       N      = m_Nodes[NodeIdx];
+        const auto& Child0 = m_Nodes[N.Child[0]];
+        const auto& Child1 = m_Nodes[N.Child[1]];
+
+        N.Height = 1 + std::max(Child0.Height, Child1.Height);
+        N.Box    = CombineBoxes(Child0.Box, Child1.Box);
+
+        NodeIdx = N.Parent;
+    }
+}
+
+// Performs a tree rotation if the heights of the children of the node differ by more than one,
+// and returns the index of the node that takes its place.
+/*
+          A                       C
+        /   \                   /   \
+       B     C       =>        A     T
+            / \               / \
+           T   S             B   S
+*/
+// where T is the taller and S is the shorter child of C.
+Uint32 DynamicAABBTree::Balance(Uint32 iA)
+{
+    auto& A = m_Nodes[iA];
+    if (A.IsLeaf() || A.Height < 2)
+        return iA;
+
+    const auto Imbalance = m_Nodes[A.Child[1]].Height - m_Nodes[A.Child[0]].Height;
+    if (Imbalance >= -1 && Imbalance <= 1)
+        return iA;
+
+    // Rotate the taller child up
+    const int  TallSide = Imbalance > 0 ? 1 : 0;
+    const auto iB       = A.Child[1 - TallSide];
+    const auto iC       = A.Child[TallSide];
+    auto&      C        = m_Nodes[iC];
+
+    const auto iT = m_Nodes[C.Child[0]].Height > m_Nodes[C.Child[1]].Height ? C.Child[0] : C.Child[1];
+    const auto iS = iT == C.Child[0] ? C.Child[1] : C.Child[0];
+
+    // C takes the place of A
+    C.Parent = A.Parent;
+    if (C.Parent != InvalidNode)
+    {
+        auto& P                           = m_Nodes[C.Parent];
+        P.Child[P.Child[0] == iA ? 0 : 1] = iC;
+    }
+    else
+    {
+        m_Root = iC;
+    }
+
+    C.Child[0] = iA;
+    C.Child[1] = iT;
+    A.Parent   = iC;
+
+    A.Child[TallSide]  = iS;
+    m_Nodes[iS].Parent = iA;
+
+    const auto& B = m_Nodes[iB];
+    const auto& S = m_Nodes[iS];
+    const auto& T = m_Nodes[iT];
+
+    A.Box    = CombineBoxes(B.Box, S.Box);
+    A.Height = 1 + std::max(B.Height, S.Height);
+    C.Box    = CombineBoxes(A.Box, T.Box);
+    C.Height = 1 + std::max(A.Height, T.Height);
+
+    return iC;
+}
+
+void DynamicAABBTree::TestViews(const BoundBox& Box, const ViewFrustum* pFrustums, Uint32& ViewMask, Uint64& PlaneMasks)
+{
+    for (Uint32 Views = ViewMask; Views != 0; Views &= Views - 1)
+    {
+        const Uint32 v = PlatformMisc::GetLSB(Views);
+
+        Uint32 Planes = static_cast<Uint32>(PlaneMasks >> (v * 8)) & 0xFFu;
+        for (Uint32 RemainingPlanes = Planes; RemainingPlanes != 0; RemainingPlanes &= RemainingPlanes - 1)
+        {
+            const Uint32 p = PlatformMisc::GetLSB(RemainingPlanes);
+
+            const auto Visibility = GetBoxVisibilityAgainstPlane(pFrustums[v].GetPlane(static_cast<ViewFrustum::PLANE_IDX>(p)), Box);
+            if (Visibility == BoxVisibility::Invisible)
+            {
+                ViewMask &= ~(1u << v);
+                Planes = 0;
+                break;
+            }
+            else if (Visibility == BoxVisibility::FullyVisible)
+            {
+                // The box and all its descendants are inside this plane
+                Planes &= ~(1u << p);
+            }
+        }
+
+        PlaneMasks &= ~(Uint64{0xFF} << (v * 8));
+        PlaneMasks |= Uint64{Planes} << (v * 8);
+    }
+}
+
+} // namespace Diligent
@@ -0,0 +1,599 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#include "SoftwareOcclusionCuller.hpp"
+
+#include <algorithm>
+#include <cfloat>
+
+#if defined(__AVX__)
+#    include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define SOC_USE_SSE2 1
+#endif
+
+#include "ThreadPool.hpp"
+#include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+constexpr Uint32 SoftwareOcclusionCuller::TileWidth;
+constexpr Uint32 SoftwareOcclusionCuller::TileHeight;
+
+namespace
+{
+
+// Depth value the buffer is cleared to
+constexpr float FarDepth = 1.f;
+
+// Number of hierarchical-Z levels that are built independently for every tile
+constexpr Uint32 NumTileHiZLevels = 5;
+static_assert(SoftwareOcclusionCuller::TileWidth == (1u << NumTileHiZLevels) &&
+                  SoftwareOcclusionCuller::TileHeight == (1u << NumTileHiZLevels),
+              "Tile-local hierarchical-Z levels must reduce a tile to a single texel");
+
+// Minimal wrapper over the SIMD instruction set that is available at compile time.
+// The rasterization loop is written once in terms of this type.
+#if defined(__AVX__)
+
+struct SIMDFloat
+{
+    static constexpr Int32 Width = 8;
+
+    __m256 v;
+
+    static SIMDFloat Set(float f) { return {_mm256_set1_ps(f)}; }
+    static SIMDFloat Ramp() { return {_mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7)}; }
+    static SIMDFloat Load(const float* p) { return {_mm256_loadu_ps(p)}; }
+
+    void Store(float* p) const { _mm256_storeu_ps(p, v); }
+};
+
+inline SIMDFloat operator+(SIMDFloat a, SIMDFloat b) { return {_mm256_add_ps(a.v, b.v)}; }
+inline SIMDFloat operator*(SIMDFloat a, SIMDFloat b) { return {_mm256_mul_ps(a.v, b.v)}; }
+
+// Returns true if none of the lanes is inside all three edges
+inline bool AllOutside(SIMDFloat E0, SIMDFloat E1, SIMDFloat E2)
+{
+    // The sign bit of the OR of the edge values is set if any of them is negative
+    return _mm256_movemask_ps(_mm256_or_ps(_mm256_or_ps(E0.v, E1.v), E2.v)) == 0xFF;
+}
+
+// Returns min(Depth, Z) in lanes inside all three edges, and Depth in all other lanes
+inline SIMDFloat DepthTest(SIMDFloat E0, SIMDFloat E1, SIMDFloat E2, SIMDFloat Z, SIMDFloat Depth)
+{
+    const __m256 Outside = _mm256_or_ps(_mm256_or_ps(E0.v, E1.v), E2.v);
+    return {_mm256_blendv_ps(_mm256_min_ps(Depth.v, Z.v), Depth.v, Outside)};
+}
+
+#elif SOC_USE_SSE2
+
+struct SIMDFloat
+{
+    static constexpr Int32 Width = 4;
+
+    __m128 v;
+
+    static SIMDFloat Set(float f) { return {_mm_set1_ps(f)}; }
+    static SIMDFloat Ramp() { return {_mm_setr_ps(0, 1, 2, 3)}; }
+    static SIMDFloat Load(const float* p) { return {_mm_loadu_ps(p)}; }
+
+    void Store(float* p) const { _mm_storeu_ps(p, v); }
+};
+
+inline SIMDFloat operator+(SIMDFloat a, SIMDFloat b) { return {_mm_add_ps(a.v, b.v)}; }
+inline SIMDFloat operator*(SIMDFloat a, SIMDFloat b) { return {_mm_mul_ps(a.v, b.v)}; }
+
+inline bool AllOutside(SIMDFloat E0, SIMDFloat E1, SIMDFloat E2)
+{
+    return _mm_movemask_ps(_mm_or_ps(_mm_or_ps(E0.v, E1.v), E2.v)) == 0xF;
+}
+
+inline SIMDFloat DepthTest(SIMDFloat E0, SIMDFloat E1, SIMDFloat E2, SIMDFloat Z, SIMDFloat Depth)
+{
+    // Broadcast the sign bit to get the lane mask (blendv requires SSE4.1)
+    const __m128 Outside = _mm_castsi128_ps(_mm_srai_epi32(_mm_castps_si128(_mm_or_ps(_mm_or_ps(E0.v, E1.v), E2.v)), 31));
+    return {_mm_or_ps(_mm_and_ps(Outside, Depth.v), _mm_andnot_ps(Outside, _mm_min_ps(Depth.v, Z.v)))};
+}
+
+#else
+
+struct SIMDFloat
+{
+    static constexpr Int32 Width = 1;
+
+    float v;
+
+    static SIMDFloat Set(float f) { return {f}; }
+    static SIMDFloat Ramp() { return {0}; }
+    static SIMDFloat Load(const float* p) { return {*p}; }
+
+    void Store(float* p) const { *p = v; }
+};
+
+inline SIMDFloat operator+(SIMDFloat a, SIMDFloat b) { return {a.v + b.v}; }
+inline SIMDFloat operator*(SIMDFloat a, SIMDFloat b) { return {a.v * b.v}; }
+
+inline bool AllOutside(SIMDFloat E0, SIMDFloat E1, SIMDFloat E2)
+{
+    return E0.v < 0 || E1.v < 0 || E2.v < 0;
+}
+
+inline SIMDFloat DepthTest(SIMDFloat E0, SIMDFloat E1, SIMDFloat E2, SIMDFloat Z, SIMDFloat Depth)
+{
+    return {AllOutside(E0, E1, E2) ? Depth.v : std::min(Depth.v, Z.v)};
+}
+
+#endif
+
+static_assert(SoftwareOcclusionCuller::TileWidth % SIMDFloat::Width == 0, "Tile width must be a multiple of the SIMD width");
+
+} // namespace
+
+
+SoftwareOcclusionCuller::SoftwareOcclusionCuller(Uint32 Width, Uint32 Height, bool bIsGL) :
+    // clang-format off
+    m_Width     {Width},
+    m_Height    {Height},
+    m_bIsGL     {bIsGL},
+    m_NumTilesX {(Width  + TileWidth  - 1) / TileWidth},
+    m_NumTilesY {(Height + TileHeight - 1) / TileHeight},
+    m_Stride    {m_NumTilesX * TileWidth}
+// clang-format on
+{
+    if (Width == 0 || Height == 0)
+        LOG_ERROR_AND_THROW("Occlusion culler depth buffer dimensions must not be zero");
+
+    m_Depth.resize(size_t{m_Stride} * size_t{m_NumTilesY * TileHeight}, FarDepth);
+    m_TileBins.resize(size_t{m_NumTilesX} * size_t{m_NumTilesY});
+
+    Uint32 LevelWidth  = m_Stride;
+    Uint32 LevelHeight = m_NumTilesY * TileHeight;
+    while (LevelWidth > 1 || LevelHeight > 1)
+    {
+        LevelWidth  = std::max((LevelWidth + 1) / 2, 1u);
+        LevelHeight = std::max((LevelHeight + 1) / 2, 1u);
+
+        HiZLevel Level;
+        Level.Width  = LevelWidth;
+        Level.Height = LevelHeight;
+        Level.MaxDepth.resize(size_t{LevelWidth} * size_t{LevelHeight}, FarDepth);
+        m_HiZ.emplace_back(std::move(Level));
+    }
+}
+
+void SoftwareOcclusionCuller::BeginFrame(const float4x4& ViewProj)
+{
+    m_ViewProj = ViewProj;
+    m_Triangles.clear();
+    for (auto& Bin : m_TileBins)
+        Bin.clear();
+}
+
+void SoftwareOcclusionCuller::AddOccluder(const float3*   pVertices,
+                                          Uint32          NumVertices,
+                                          const Uint32*   pIndices,
+                                          Uint32          NumIndices,
+                                          const float4x4& World)
+{
+    DEV_CHECK_ERR(NumIndices % 3 == 0, "Number of occluder indices (", NumIndices, ") must be a multiple of 3");
+
+    const auto WorldViewProj = World * m_ViewProj;
+
+    for (Uint32 tri = 0; tri + 2 < NumIndices; tri += 3)
+    {
+        float4 ClipPos[3];
+        bool   IsValid = true;
+        for (Uint32 v = 0; v < 3; ++v)
+        {
+            const auto Idx = pIndices[tri + v];
+            if (Idx >= NumVertices)
+            {
+                UNEXPECTED("Occluder index ", Idx, " is out of range [0, ", NumVertices, ")");
+                IsValid = false;
+                break;
+            }
+            ClipPos[v] = float4{pVertices[Idx], 1} * WorldViewProj;
+        }
+        if (!IsValid)
+            continue;
+
+        // Trivially reject triangles that are entirely outside of one of the frustum planes
+        // (except for the near plane, which is handled by clipping).
+        const auto& V0 = ClipPos[0];
+        const auto& V1 = ClipPos[1];
+        const auto& V2 = ClipPos[2];
+        // clang-format off
+        if ((V0.x >  V0.w && V1.x >  V1.w && V2.x >  V2.w) ||
+            (V0.x < -V0.w && V1.x < -V1.w && V2.x < -V2.w) ||
+            (V0.y >  V0.w && V1.y >  V1.w && V2.y >  V2.w) ||
+            (V0.y < -V0.w && V1.y < -V1.w && V2.y < -V2.w) ||
+            (V0.z >  V0.w && V1.z >  V1.w && V2.z >  V2.w))
+            continue;
+        // clang-format on
+
+        AddClippedTriangle(V0, V1, V2);
+    }
+}
+
+// Clips the triangle against the near plane and sets up the resulting triangles
+void SoftwareOcclusionCuller::AddClippedTriangle(const float4& V0, const float4& V1, const float4& V2)
+{
+    const float4* InVerts[3] = {&V0, &V1, &V2};
+
+    float NearDist[3];
+    for (int v = 0; v < 3; ++v)
+        NearDist[v] = m_bIsGL ? InVerts[v]->z + InVerts[v]->w : InVerts[v]->z;
+
+    // Sutherland-Hodgman clipping of a triangle against a single plane produces at most 4 vertices
+    float4 Poly[4];
+    int    NumPolyVerts = 0;
+    for (int v = 0; v < 3; ++v)
+    {
+        const int  next         = (v + 1) % 3;
+        const bool IsInside     = NearDist[v] >= 0;
+        const bool IsNextInside = NearDist[next] >= 0;
+        if (IsInside)
+            Poly[NumPolyVerts++] = *InVerts[v];
+        if (IsInside != IsNextInside)
+        {
+            const float t        = NearDist[v] / (NearDist[v] - NearDist[next]);
+            Poly[NumPolyVerts++] = *InVerts[v] + (*InVerts[next] - *InVerts[v]) * t;
+        }
+    }
+    if (NumPolyVerts < 3)
+        return;
+
+    float3 ScreenPos[4];
+    for (int v = 0; v < NumPolyVerts; ++v)
+    {
+        const auto& P = Poly[v];
+        if (P.w <= 0)
+        {
+            // Can only happen with degenerate projection matrices
+            return;
+        }
+        const float InvW = 1.f / P.w;
+        // clang-format off
+        ScreenPos[v].x = (P.x * InvW * +0.5f + 0.5f) * static_cast<float>(m_Width);
+        ScreenPos[v].y = (P.y * InvW * -0.5f + 0.5f) * static_cast<float>(m_Height);
+        ScreenPos[v].z = m_bIsGL ? P.z * InvW * 0.5f + 0.5f : P.z * InvW;
+        // clang-format on
+    }
+
+    SetupTriangle(ScreenPos[0], ScreenPos[1], ScreenPos[2]);
+    if (NumPolyVerts == 4)
+        SetupTriangle(ScreenPos[0], ScreenPos[2], ScreenPos[3]);
+}
+
+void SoftwareOcclusionCuller::SetupTriangle(const float3& V0, const float3& V1, const float3& V2)
+{
+    // Pixel (x, y) is covered if its center (x + 0.5, y + 0.5) is inside the triangle
+    const auto MinX = std::max(static_cast<Int32>(FastCeil(min3(V0.x, V1.x, V2.x) - 0.5f)), 0);
+    const auto MinY = std::max(static_cast<Int32>(FastCeil(min3(V0.y, V1.y, V2.y) - 0.5f)), 0);
+    const auto MaxX = std::min(static_cast<Int32>(FastFloor(max3(V0.x, V1.x, V2.x) - 0.5f)), static_cast<Int32>(m_Width) - 1);
+    const auto MaxY = std::min(static_cast<Int32>(FastFloor(max3(V0.y, V1.y, V2.y) - 0.5f)), static_cast<Int32>(m_Height) - 1);
+    if (MinX > MaxX || MinY > MaxY)
+        return;
+
+    const float3* Verts[3] = {&V0, &V1, &V2};
+
+    TriangleSetup Tri;
+    for (int e = 0; e < 3; ++e)
+    {
+        // Edge opposite to vertex e goes from Va to Vb
+        const auto& Va = *Verts[(e + 1) % 3];
+        const auto& Vb = *Verts[(e + 2) % 3];
+
+        Tri.EdgeA[e] = Va.y - Vb.y;
+        Tri.EdgeB[e] = Vb.x - Va.x;
+        Tri.EdgeC[e] = -(Tri.EdgeA[e] * Va.x + Tri.EdgeB[e] * Va.y);
+    }
+
+    // Twice the signed area of the triangle
+    const float Area = Tri.EdgeA[0] * V0.x + Tri.EdgeB[0] * V0.y + Tri.EdgeC[0];
+    if (Area == 0)
+        return;
+
+    // Normalize the edge functions so that they are non-negative inside the triangle
+    // regardless of the winding, and move the origin to the center of pixel (0, 0).
+    const float Sign = Area > 0 ? 1.f : -1.f;
+    for (int e = 0; e < 3; ++e)
+    {
+        Tri.EdgeA[e] *= Sign;
+        Tri.EdgeB[e] *= Sign;
+        Tri.EdgeC[e] *= Sign;
+        Tri.EdgeC[e] += 0.5f * (Tri.EdgeA[e] + Tri.EdgeB[e]);
+    }
+
+    // Normalized edge functions are the barycentric coordinates scaled by the absolute area.
+    // Depth is affine in screen space, so it is interpolated as a plane.
+    const float InvArea = 1.f / std::abs(Area);
+    // clang-format off
+    Tri.ZA = (Tri.EdgeA[0] * V0.z + Tri.EdgeA[1] * V1.z + Tri.EdgeA[2] * V2.z) * InvArea;
+    Tri.ZB = (Tri.EdgeB[0] * V0.z + Tri.EdgeB[1] * V1.z + Tri.EdgeB[2] * V2.z) * InvArea;
+    Tri.ZC = (Tri.EdgeC[0] * V0.z + Tri.EdgeC[1] * V1.z + Tri.EdgeC[2] * V2.z) * InvArea;
+    // clang-format on
+
+    Tri.MinX = MinX;
+    Tri.MinY = MinY;
+    Tri.MaxX = MaxX;
+    Tri.MaxY = MaxY;
+
+    const auto TriIdx = static_cast<Uint32>(m_Triangles.size());
+    m_Triangles.emplace_back(Tri);
+
+    for (Uint32 TileY = static_cast<Uint32>(MinY) / TileHeight; TileY <= static_cast<Uint32>(MaxY) / TileHeight; ++TileY)
+    {
+        for (Uint32 TileX = static_cast<Uint32>(MinX) / TileWidth; TileX <= static_cast<Uint32>(MaxX) / TileWidth; ++TileX)
+        {
+            m_TileBins[TileY * m_NumTilesX + TileX].push_back(TriIdx);
+        }
+    }
+}
+
+void SoftwareOcclusionCuller::RasterizeTile(Uint32 TileX, Uint32 TileY)
+{
+    const Int32 TileMinX = static_cast<Int32>(TileX * TileWidth);
+    const Int32 TileMinY = static_cast<Int32>(TileY * TileHeight);
+    const Int32 TileMaxX = TileMinX + static_cast<Int32>(TileWidth) - 1;
+    const Int32 TileMaxY = TileMinY + static_cast<Int32>(TileHeight) - 1;
+
+    for (Int32 y = TileMinY; y <= TileMaxY; ++y)
+    {
+        auto* pRow = &m_Depth[size_t{static_cast<Uint32>(y)} * m_Stride + static_cast<Uint32>(TileMinX)];
+        std::fill(pRow, pRow + TileWidth, FarDepth);
+    }
+
+    const auto Ramp = SIMDFloat::Ramp();
+    for (auto TriIdx : m_TileBins[TileY * m_NumTilesX + TileX])
+    {
+        const auto& Tri = m_Triangles[TriIdx];
+
+        // Start at a SIMD-aligned column. Tiles are aligned to the SIMD width, so the
+        // extra pixels are always within the tile and are rejected by the edge functions.
+        const Int32 MinX = std::max(Tri.MinX, TileMinX) & ~(SIMDFloat::Width - 1);
+        const Int32 MinY = std::max(Tri.MinY, TileMinY);
+        const Int32 MaxX = std::min(Tri.MaxX, TileMaxX);
+        const Int32 MaxY = std::min(Tri.MaxY, TileMaxY);
+
+        // clang-format off
+        const SIMDFloat A0 = SIMDFloat::Set(Tri.EdgeA[0] * SIMDFloat::Width);
+        const SIMDFloat A1 = SIMDFloat::Set(Tri.EdgeA[1] * SIMDFloat::Width);
+        const SIMDFloat A2 = SIMDFloat::Set(Tri.EdgeA[2] * SIMDFloat::Width);
+        const SIMDFloat ZA = SIMDFloat::Set(Tri.ZA       * SIMDFloat::Width);
+        // clang-format on
+
+        for (Int32 y = MinY; y <= MaxY; ++y)
+        {
+            const float fx = static_cast<float>(MinX);
+            const float fy = static_cast<float>(y);
+
+            // Values at the first pixel of the row for every lane
+            auto E0 = SIMDFloat::Set(Tri.EdgeA[0]) * Ramp + SIMDFloat::Set(Tri.EdgeA[0] * fx + Tri.EdgeB[0] * fy + Tri.EdgeC[0]);
+            auto E1 = SIMDFloat::Set(Tri.EdgeA[1]) * Ramp + SIMDFloat::Set(Tri.EdgeA[1] * fx + Tri.EdgeB[1] * fy + Tri.EdgeC[1]);
+            auto E2 = SIMDFloat::Set(Tri.EdgeA[2]) * Ramp + SIMDFloat::Set(Tri.EdgeA[2] * fx + Tri.EdgeB[2] * fy + Tri.EdgeC[2]);
+            auto Z  = SIMDFloat::Set(Tri.ZA) * Ramp + SIMDFloat::Set(Tri.ZA * fx + Tri.ZB * fy + Tri.ZC);
+
+            auto* pRow = &m_Depth[size_t{static_cast<Uint32>(y)} * m_Stride];
+            for (Int32 x = MinX; x <= MaxX; x += SIMDFloat::Width)
+            {
+                if (!AllOutside(E0, E1, E2))
+                {
+                    const auto Depth = SIMDFloat::Load(pRow + x);
+                    DepthTest(E0, E1, E2, Z, Depth).Store(pRow + x);
+                }
+
+                E0 = E0 + A0;
+                E1 = E1 + A1;
+                E2 = E2 + A2;
+                Z  = Z + ZA;
+            }
+        }
+    }
+}
+
+void SoftwareOcclusionCuller::BuildTileHiZ(Uint32 TileX, Uint32 TileY)
+{
+    const float* pSrc      = m_Depth.data();
+    Uint32       SrcStride = m_Stride;
+    for (Uint32 Level = 0; Level < NumTileHiZLevels; ++Level)
+    {
+        auto&        Dst       = m_HiZ[Level];
+        const Uint32 DstWidth  = TileWidth >> (Level + 1);
+        const Uint32 DstHeight = TileHeight >> (Level + 1);
+        const Uint32 DstX0     = TileX * DstWidth;
+        const Uint32 DstY0     = TileY * DstHeight;
+        for (Uint32 y = DstY0; y < DstY0 + DstHeight; ++y)
+        {
+            const float* pSrcRow0 = pSrc + size_t{y * 2 + 0} * SrcStride;
+            const float* pSrcRow1 = pSrc + size_t{y * 2 + 1} * SrcStride;
+            float*       pDstRow  = &Dst.MaxDepth[size_t{y} * Dst.Width];
+            for (Uint32 x = DstX0; x < DstX0 + DstWidth; ++x)
+            {
+                pDstRow[x] = std::max(std::max(pSrcRow0[x * 2], pSrcRow0[x * 2 + 1]),
+                                      std::max(pSrcRow1[x * 2], pSrcRow1[x * 2 + 1]));
+            }
+        }
+        pSrc      = Dst.MaxDepth.data();
+        SrcStride = Dst.Width;
+    }
+}
+
+void SoftwareOcclusionCuller::BuildCoarseHiZ()
+{
+    for (size_t Level = NumTileHiZLevels; Level < m_HiZ.size(); ++Level)
+    {
+        const auto& Src = m_HiZ[Level - 1];
+        auto&       Dst = m_HiZ[Level];
+        for (Uint32 y = 0; y < Dst.Height; ++y)
+        {
+            // Levels are rounded up, so the last row and column may only have one source texel
+            const Uint32 y0 = y * 2;
+            const Uint32 y1 = std::min(y0 + 1, Src.Height - 1);
+            for (Uint32 x = 0; x < Dst.Width; ++x)
+            {
+                const Uint32 x0 = x * 2;
+                const Uint32 x1 = std::min(x0 + 1, Src.Width - 1);
+
+                Dst.MaxDepth[size_t{y} * Dst.Width + x] =
+                    std::max(std::max(Src.MaxDepth[size_t{y0} * Src.Width + x0], Src.MaxDepth[size_t{y0} * Src.Width + x1]),
+                             std::max(Src.MaxDepth[size_t{y1} * Src.Width + x0], Src.MaxDepth[size_t{y1} * Src.Width + x1]));
+            }
+        }
+    }
+}
+
+void SoftwareOcclusionCuller::RasterizeOccluders(ThreadPool* pThreadPool)
+{
+    if (pThreadPool != nullptr)
+    {
+        VERIFY(pThreadPool->GetCurrentThreadId() == ~0u, "RasterizeOccluders must not be called from a worker thread of the pool");
+        for (Uint32 TileY = 0; TileY < m_NumTilesY; ++TileY)
+        {
+            for (Uint32 TileX = 0; TileX < m_NumTilesX; ++TileX)
+            {
+                pThreadPool->EnqueueTask(
+                    [this, TileX, TileY](Uint32) //
+                    {
+                        RasterizeTile(TileX, TileY);
+                        BuildTileHiZ(TileX, TileY);
+                    });
+            }
+        }
+        pThreadPool->WaitForAllTasks();
+    }
+    else
+    {
+        for (Uint32 TileY = 0; TileY < m_NumTilesY; ++TileY)
+        {
+            for (Uint32 TileX = 0; TileX < m_NumTilesX; ++TileX)
+            {
+                RasterizeTile(TileX, TileY);
+                BuildTileHiZ(TileX, TileY);
+            }
+        }
+    }
+
+    BuildCoarseHiZ();
+}
+
+// Tests the pixel rectangle [MinX, MaxX] x [MinY, MaxY] against the given level of the pyramid,
+// descending to finer levels only for texels that do not occlude the box.
+bool SoftwareOcclusionCuller::IsRectOccluded(Uint32 Level, Int32 MinX, Int32 MinY, Int32 MaxX, Int32 MaxY, float BoxMinDepth) const
+{
+    const float* pData  = Level == 0 ? m_Depth.data() : m_HiZ[Level - 1].MaxDepth.data();
+    const size_t Stride = Level == 0 ? m_Stride : m_HiZ[Level - 1].Width;
+
+    for (Int32 y = MinY >> Level; y <= (MaxY >> Level); ++y)
+    {
+        for (Int32 x = MinX >> Level; x <= (MaxX >> Level); ++x)
+        {
+            // The farthest occluder in this texel is closer than the nearest point of the box
+            if (pData[static_cast<size_t>(y) * Stride + static_cast<size_t>(x)] < BoxMinDepth)
+                continue;
+
+            if (Level == 0)
+                return false;
+
+            // Refine the part of the rectangle covered by this texel
+            // clang-format off
+            if (!IsRectOccluded(Level - 1,
+                                std::max(MinX,  x      << Level),
+                                std::max(MinY,  y      << Level),
+                                std::min(MaxX, ((x + 1) << Level) - 1),
+                                std::min(MaxY, ((y + 1) << Level) - 1),
+                                BoxMinDepth))
+                return false;
+            // clang-format on
+        }
+    }
+
+    return true;
+}
+
+bool SoftwareOcclusionCuller::IsBoxOccluded(const BoundBox& Box) const
+{
+    const auto& M = m_ViewProj;
+
+    // Clip-space box corners are sums of the matrix rows scaled by the min/max coordinates
+    // clang-format off
+    const float4 X[] = {float4{M._11, M._12, M._13, M._14} * Box.Min.x, float4{M._11, M._12, M._13, M._14} * Box.Max.x};
+    const float4 Y[] = {float4{M._21, M._22, M._23, M._24} * Box.Min.y, float4{M._21, M._22, M._23, M._24} * Box.Max.y};
+    const float4 Z[] = {float4{M._31, M._32, M._33, M._34} * Box.Min.z, float4{M._31, M._32, M._33, M._34} * Box.Max.z};
+    const float4 T   =  float4{M._41, M._42, M._43, M._44};
+    // clang-format on
+
+    float2 ScreenMin{+FLT_MAX, +FLT_MAX};
+    float2 ScreenMax{-FLT_MAX, -FLT_MAX};
+    float  MinDepth = +FLT_MAX;
+    for (Uint32 i = 0; i < 8; ++i)
+    {
+        const auto Corner = X[i & 0x01] + Y[(i >> 1) & 0x01] + Z[(i >> 2) & 0x01] + T;
+
+        // A box that intersects the near plane covers an unbounded screen area
+        const float NearDist = m_bIsGL ? Corner.z + Corner.w : Corner.z;
+        if (NearDist < 0 || Corner.w <= 0)
+            return false;
+
+        const float InvW = 1.f / Corner.w;
+        const float x    = (Corner.x * InvW * +0.5f + 0.5f) * static_cast<float>(m_Width);
+        const float y    = (Corner.y * InvW * -0.5f + 0.5f) * static_cast<float>(m_Height);
+        const float z    = m_bIsGL ? Corner.z * InvW * 0.5f + 0.5f : Corner.z * InvW;
+
+        ScreenMin = std::min(ScreenMin, float2{x, y});
+        ScreenMax = std::max(ScreenMax, float2{x, y});
+        MinDepth  = std::min(MinDepth, z);
+    }
+
+    // Test every pixel the box touches
+    if (ScreenMax.x < 0 || ScreenMax.y < 0 || ScreenMin.x >= static_cast<float>(m_Width) || ScreenMin.y >= static_cast<float>(m_Height))
+        return false;
+
+    const auto MinX = std::max(static_cast<Int32>(ScreenMin.x), 0);
+    const auto MinY = std::max(static_cast<Int32>(ScreenMin.y), 0);
+    const auto MaxX = std::min(static_cast<Int32>(ScreenMax.x), static_cast<Int32>(m_Width) - 1);
+    const auto MaxY = std::min(static_cast<Int32>(ScreenMax.y), static_cast<Int32>(m_Height) - 1);
+
+    // Start at the finest level where the rectangle spans at most 4x4 texels
+    Uint32 Level = 0;
+    while (Level < m_HiZ.size() &&
+           ((MaxX >> Level) - (MinX >> Level) >= 4 || (MaxY >> Level) - (MinY >> Level) >= 4))
+        ++Level;
+
+    return IsRectOccluded(Level, MinX, MinY, MaxX, MaxY, MinDepth);
+}
+
+void SoftwareOcclusionCuller::TestBoxes(const BoundBox* pBoxes, Uint32 NumBoxes, bool* pIsOccluded) const
+{
+    for (Uint32 i = 0; i < NumBoxes; ++i)
+        pIsOccluded[i] = IsBoxOccluded(pBoxes[i]);
+}
+
+} // namespace Diligent
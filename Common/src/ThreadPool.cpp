@@ -0,0 +1,194 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <exception>
+
+#include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+struct WorkerThreadInfo
+{
+    const ThreadPool* pPool    = nullptr;
+    Uint32            ThreadId = ~0u;
+};
+
+thread_local WorkerThreadInfo CurrentWorkerThread;
+
+} // namespace
+
+ThreadPool::ThreadPool(Uint32 NumThreads)
+{
+    if (NumThreads == 0)
+        NumThreads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    m_Queues.reserve(NumThreads);
+    for (Uint32 i = 0; i < NumThreads; ++i)
+        m_Queues.emplace_back(new TaskQueue);
+
+    m_Threads.reserve(NumThreads);
+    for (Uint32 i = 0; i < NumThreads; ++i)
+        m_Threads.emplace_back(&ThreadPool::WorkerThreadFunc, this, i);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> Lock{m_SignalMtx};
+        m_Stop = true;
+    }
+    m_WorkCV.notify_all();
+
+    // Worker threads exit once all queues are empty
+    for (auto& Thread : m_Threads)
+        Thread.join();
+
+    VERIFY_EXPR(m_NumPendingTasks == 0);
+}
+
+Uint32 ThreadPool::GetCurrentThreadId() const
+{
+    return CurrentWorkerThread.pPool == this ? CurrentWorkerThread.ThreadId : ~0u;
+}
+
+void ThreadPool::EnqueueTask(TaskType Task)
+{
+    VERIFY(Task, "Task must not be empty");
+
+    m_NumPendingTasks.fetch_add(1);
+
+    auto QueueIdx = GetCurrentThreadId();
+    if (QueueIdx == ~0u)
+        QueueIdx = m_NextQueue.fetch_add(1) % static_cast<Uint32>(m_Queues.size());
+
+    {
+        auto&                       Queue = *m_Queues[QueueIdx];
+        std::lock_guard<std::mutex> Lock{Queue.Mtx};
+        Queue.Tasks.emplace_back(std::move(Task));
+    }
+
+    {
+        std::lock_guard<std::mutex> Lock{m_SignalMtx};
+        m_NumQueuedTasks.fetch_add(1);
+    }
+    m_WorkCV.notify_one();
+}
+
+bool ThreadPool::PopTask(Uint32 ThreadId, TaskType& Task)
+{
+    // Take the most recently added task from the own queue: its data is likely still in the cache
+    {
+        auto&                       Queue = *m_Queues[ThreadId];
+        std::lock_guard<std::mutex> Lock{Queue.Mtx};
+        if (!Queue.Tasks.empty())
+        {
+            Task = std::move(Queue.Tasks.back());
+            Queue.Tasks.pop_back();
+            return true;
+        }
+    }
+
+    // Steal the oldest task from other queues
+    const auto NumQueues = static_cast<Uint32>(m_Queues.size());
+    for (Uint32 i = 1; i < NumQueues; ++i)
+    {
+        auto&                       Queue = *m_Queues[(ThreadId + i) % NumQueues];
+        std::lock_guard<std::mutex> Lock{Queue.Mtx};
+        if (!Queue.Tasks.empty())
+        {
+            Task = std::move(Queue.Tasks.front());
+            Queue.Tasks.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ThreadPool::WorkerThreadFunc(Uint32 ThreadId)
+{
+    CurrentWorkerThread.pPool    = this;
+    CurrentWorkerThread.ThreadId = ThreadId;
+
+    while (true)
+    {
+        TaskType Task;
+        if (PopTask(ThreadId, Task))
+        {
+            m_NumQueuedTasks.fetch_sub(1);
+
+            // An exception must not terminate the worker thread, as the task would then never
+            // be counted as complete and WaitForAllTasks() would never return.
+            try
+            {
+                Task(ThreadId);
+            }
+            catch (const std::exception& e)
+            {
+                LOG_ERROR_MESSAGE("Unhandled exception in thread pool task: ", e.what());
+            }
+            catch (...)
+            {
+                LOG_ERROR_MESSAGE("Unhandled exception in thread pool task");
+            }
+            Task = nullptr;
+
+            if (m_NumPendingTasks.fetch_sub(1) == 1)
+            {
+                // Notify under the mutex so that the notification can't be missed by a thread
+                // that has checked the condition, but has not started waiting yet.
+                std::lock_guard<std::mutex> Lock{m_SignalMtx};
+                m_IdleCV.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> Lock{m_SignalMtx};
+        m_WorkCV.wait(Lock, [this] { return m_Stop || m_NumQueuedTasks.load() > 0; });
+        if (m_Stop && m_NumQueuedTasks.load() <= 0)
+            break;
+    }
+
+    CurrentWorkerThread = WorkerThreadInfo{};
+}
+
+void ThreadPool::WaitForAllTasks()
+{
+    DEV_CHECK_ERR(GetCurrentThreadId() == ~0u, "WaitForAllTasks() must not be called from a worker thread as this will cause a deadlock");
+
+    std::unique_lock<std::mutex> Lock{m_SignalMtx};
+    m_IdleCV.wait(Lock, [this] { return m_NumPendingTasks.load() == 0; });
+}
+
+} // namespace Diligent
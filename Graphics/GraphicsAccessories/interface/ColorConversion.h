@@ -28,6 +28,7 @@
 #pragma once
 
 #include <cmath>
+#include <cstddef>
 #include "../../../Primitives/interface/BasicTypes.h"
 
 DILIGENT_BEGIN_NAMESPACE(Diligent)
@@ -57,4 +58,29 @@ inline float FastSRGBToLinear(float x)
     return x * (x * (x * 0.305306011f + 0.682171111f) + 0.012522878f);
 }
 
+
+// Bulk conversions. The functions process spans of values using SSE2, AVX2 or NEON when
+// available and fall back to the scalar functions above otherwise.
+// Source and destination spans may be the same, but must not partially overlap.
+
+/// Converts Count linear values to sRGB space.
+
+/// The SIMD versions evaluate the power function using polynomial approximations of log2 and exp2.
+/// For inputs in [0, 1], the absolute error relative to the exact sRGB curve is below 5e-7.
+/// For HDR inputs up to 10^4, the relative error is below 5e-6.
+void LinearToSRGB(const float* pLinear, float* pSRGB, size_t Count);
+
+/// Converts Count sRGB values to linear space. The error bound is the same as for LinearToSRGB().
+void SRGBToLinear(const float* pSRGB, float* pLinear, size_t Count);
+
+/// Converts Count linear values to 8-bit sRGB values. The input values are clamped to [0, 1].
+
+/// The result differs from the correctly rounded value by at most one, which only happens for
+/// values that are within the approximation error from the middle between two 8-bit values.
+void LinearToSRGB(const float* pLinear, Uint8* pSRGB, size_t Count);
+
+/// Converts Count 8-bit sRGB values to linear space using a look-up table.
+/// The results are identical to SRGBToLinear(Uint8).
+void SRGBToLinear(const Uint8* pSRGB, float* pLinear, size_t Count);
+
 DILIGENT_END_NAMESPACE // namespace Diligent
@@ -33,6 +33,7 @@
 
 #include <map>
 #include <unordered_map>
+#include <vector>
 
 #include "../../../Primitives/interface/BasicTypes.h"
 #include "../../../Common/interface/HashUtils.hpp"
@@ -98,7 +99,48 @@ public:
         };
     };
 
-    DynamicAtlasManager(Uint32 Width, Uint32 Height);
+    /// Packing algorithm used by the atlas manager
+    enum class PackingAlgorithm : Uint8
+    {
+        /// Free regions are recursively split into a tree of nodes that are kept
+        /// in sorted maps. Sibling nodes are merged back when all of them are released.
+        Tree,
+
+        /// Free space is described by a flat list of maximal (possibly overlapping) free
+        /// rectangles; new regions are placed using the best short side fit heuristic.
+        /// Packs tighter and allocates small regions faster than the tree, which makes it
+        /// a better fit for atlases holding many small regions such as glyphs.
+        MaxRects
+    };
+
+    /// Atlas occupancy statistics
+    struct Statistics
+    {
+        /// The number of allocated regions
+        Uint32 NumAllocations = 0;
+
+        /// The number of free regions. For the MaxRects algorithm, free regions may overlap.
+        Uint32 NumFreeRegions = 0;
+
+        /// Total area of all allocated regions
+        Uint64 AllocatedArea = 0;
+
+        /// Total free area
+        Uint64 FreeArea = 0;
+
+        /// The area of the largest free region
+        Uint64 LargestFreeRegionArea = 0;
+
+        /// Allocated area divided by the total atlas area
+        float Occupancy = 0;
+
+        /// 1 - LargestFreeRegionArea / FreeArea. Zero indicates that all free space
+        /// is available as a single region, values close to one indicate that free
+        /// space is scattered across many small regions.
+        float Fragmentation = 0;
+    };
+
+    DynamicAtlasManager(Uint32 Width, Uint32 Height, PackingAlgorithm Algorithm = PackingAlgorithm::Tree);
     ~DynamicAtlasManager();
 
     // clang-format off
@@ -111,12 +153,35 @@ public:
     Region Allocate(Uint32 Width, Uint32 Height);
     void   Free(Region&& R);
 
+    /// Allocates multiple regions at once.
+
+    /// \param [in]     NumRegions - The number of regions to allocate.
+    /// \param [in,out] pRegions   - Array of NumRegions regions. On input, width and height
+    ///                              of every region specify the requested size. On output,
+    ///                              contains the allocated regions. Regions that could not be
+    ///                              allocated are set to empty regions.
+    /// \return The number of regions that were successfully allocated.
+    ///
+    /// \remarks Requests are processed in the order of decreasing size, which results in
+    ///          denser packing than allocating the same regions in arbitrary order.
+    Uint32 Allocate(Uint32 NumRegions, Region* pRegions);
+
     Uint32 GetFreeRegionCount() const
     {
+        if (m_Algorithm == PackingAlgorithm::MaxRects)
+            return static_cast<Uint32>(m_FreeRects.size());
+
         VERIFY_EXPR(m_FreeRegionsByWidth.size() == m_FreeRegionsByHeight.size());
         return static_cast<Uint32>(m_FreeRegionsByWidth.size());
     }
 
+    Statistics GetStatistics() const;
+
+    PackingAlgorithm GetAlgorithm() const
+    {
+        return m_Algorithm;
+    }
+
 
 #define CMP(Member)                 \
     if (R0.Member < R1.Member)      \
@@ -156,8 +221,11 @@ private:
     void DbgRecursiveVerifyConsistency(const Node& N, Uint32& Area) const;
 #endif
 
-    const Uint32 m_Width;
-    const Uint32 m_Height;
+    const Uint32           m_Width;
+    const Uint32           m_Height;
+    const PackingAlgorithm m_Algorithm;
+
+    Uint64 m_AllocatedArea = 0;
 
     struct Node
     {
@@ -206,17 +274,33 @@ private:
         Uint32                  NumChildren = 0;
         std::unique_ptr<Node[]> Children;
     };
-    std::unique_ptr<Node> m_Root{new Node};
+    // Not used by the MaxRects algorithm
+    std::unique_ptr<Node> m_Root;
 
     void RegisterNode(Node& N);
     void UnregisterNode(const Node& N);
 
+    Region AllocateTree(Uint32 Width, Uint32 Height);
+    void   FreeTree(Node* N);
+
+    Region AllocateMaxRects(Uint32 Width, Uint32 Height);
+    void   FreeMaxRects(const Region& R);
+
     // Free regions ordered by width->height->x->y
     std::map<Region, Node*, WidthFirstCompare> m_FreeRegionsByWidth;
     // Free regions ordered by height->width->y->x
     std::map<Region, Node*, HeightFirstCompare> m_FreeRegionsByHeight;
-    // Allocated regions
+    // Allocated regions. Node pointers are null for the MaxRects algorithm.
     std::unordered_map<Region, Node*, Region::Hasher> m_AllocatedRegions;
+
+    // Maximal free rectangles used by the MaxRects algorithm
+    std::vector<Region> m_FreeRects;
+    // Scratch space for the rectangles produced when splitting free rectangles
+    std::vector<Region> m_SplitRects;
+    // Scratch space for the free rectangles rebuilt when a region is released
+    std::vector<Region> m_ReleasedRects;
+    // Scratch space for the allocated space around the released region
+    std::vector<Region> m_OccupiedRects;
 };
 
 } // namespace Diligent
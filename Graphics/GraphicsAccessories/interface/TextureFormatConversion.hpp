@@ -0,0 +1,136 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines CPU texel format conversion and block decompression functions
+
+#include <cstddef>
+
+#include "../../GraphicsEngine/interface/GraphicsTypes.h"
+
+namespace Diligent
+{
+
+class ThreadPool;
+
+/// Converts a 16-bit half-precision float to a 32-bit float.
+float HalfToFloat(Uint16 Half);
+
+/// Converts a 32-bit float to a 16-bit half-precision float.
+
+/// Values are rounded to the nearest representable half, ties to even.
+/// Values that are too large to be represented are converted to infinity, NaNs are preserved.
+Uint16 FloatToHalf(float Value);
+
+/// Converts an array of half-precision floats to 32-bit floats.
+void HalfToFloat(const Uint16* pSrc, float* pDst, size_t Count);
+
+/// Converts an array of 32-bit floats to half-precision floats.
+void FloatToHalf(const float* pSrc, Uint16* pDst, size_t Count);
+
+
+/// Returns true if texels of the given format can be unpacked with UnpackTexelRow.
+
+/// All uncompressed color and depth formats are supported except for the 1-bit,
+/// packed 4:2:2 and R10G10B10_XR_BIAS_A2 formats.
+/// All BC formats are supported by DecompressBlock.
+bool IsTexelUnpackSupported(TEXTURE_FORMAT Format);
+
+/// Returns true if texels of the given format can be written with PackTexelRow.
+
+/// Same as IsTexelUnpackSupported for uncompressed formats. Block-compressed formats
+/// can't be packed; use CompressTextureData from GraphicsTools instead.
+bool IsTexelPackSupported(TEXTURE_FORMAT Format);
+
+/// Unpacks a row of texels to 32-bit float RGBA values.
+
+/// \param [in]  Format    - Texel format. Must not be a block-compressed format.
+/// \param [in]  pSrc      - Source texels.
+/// \param [in]  NumTexels - The number of texels to unpack.
+/// \param [out] pRGBA     - Destination array of 4 * NumTexels floats.
+///
+/// \remarks    Normalized values are converted to [0, 1] or [-1, 1] range, integer values are
+///             converted to float without normalization. sRGB-encoded values are converted to
+///             linear space. Missing color components are set to 0, missing alpha is set to 1.
+///             Depth is returned in the red channel, stencil - in the green channel.
+void UnpackTexelRow(TEXTURE_FORMAT Format, const void* pSrc, size_t NumTexels, float* pRGBA);
+
+/// Packs a row of 32-bit float RGBA values into texels of the given format.
+
+/// \param [in]  Format    - Texel format. Must not be a block-compressed format.
+/// \param [in]  pRGBA     - Source array of 4 * NumTexels floats.
+/// \param [in]  NumTexels - The number of texels to pack.
+/// \param [out] pDst      - Destination texels.
+///
+/// \remarks    This is the inverse of UnpackTexelRow: linear values are encoded to sRGB for
+///             sRGB formats, normalized values are clamped to the representable range and rounded
+///             to the nearest integer, integer values are clamped and rounded.
+void PackTexelRow(TEXTURE_FORMAT Format, const float* pRGBA, size_t NumTexels, void* pDst);
+
+/// Decompresses a single 4x4 block of a block-compressed format.
+
+/// \param [in]  Format - BC format of the block (BC1 - BC7, including SNORM, SRGB and SF16 variants).
+/// \param [in]  pBlock - Compressed block data.
+/// \param [out] pRGBA  - Destination array of 16 * 4 floats. Texels are written in row-major order.
+///
+/// \remarks    Values are returned in the same way as by UnpackTexelRow: sRGB formats are converted
+///             to linear space, BC4 and BC5 write missing components as 0 and alpha as 1.
+///             Reserved BC6H and BC7 modes decode to zero.
+void DecompressBlock(TEXTURE_FORMAT Format, const void* pBlock, float* pRGBA);
+
+/// Converts 2D texture data between formats.
+
+/// \param [in]  Width       - Image width, in texels.
+/// \param [in]  Height      - Image height, in texels.
+/// \param [in]  SrcFormat   - Source format. Can be any format supported by UnpackTexelRow or a BC format.
+/// \param [in]  pSrcData    - Source data.
+/// \param [in]  SrcStride   - Source row stride, in bytes. For block-compressed formats,
+///                            this is the stride between rows of blocks.
+/// \param [in]  DstFormat   - Destination format. Must be an uncompressed format supported by PackTexelRow.
+/// \param [out] pDstData    - Destination memory.
+/// \param [in]  DstStride   - Destination row stride, in bytes.
+/// \param [in]  pThreadPool - Optional thread pool. If not null, rows are converted by the worker
+///                            threads of the pool. The function must not be called from a worker
+///                            thread of the same pool.
+///
+/// \return     true if the conversion was performed, and false if either format is not supported.
+///
+/// \remarks    Copying between identical formats and swizzling between RGBA8 and BGRA8 formats
+///             of the same color space do not go through the float representation.
+bool ConvertTextureData(Uint32         Width,
+                        Uint32         Height,
+                        TEXTURE_FORMAT SrcFormat,
+                        const void*    pSrcData,
+                        Uint32         SrcStride,
+                        TEXTURE_FORMAT DstFormat,
+                        void*          pDstData,
+                        Uint32         DstStride,
+                        ThreadPool*    pThreadPool = nullptr);
+
+} // namespace Diligent
@@ -0,0 +1,794 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#include "TextureFormatConversion.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "ColorConversion.h"
+#include "GraphicsAccessories.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// Reads bits of a 128-bit block starting from the least significant bit of the first byte
+class BlockBitReader
+{
+public:
+    explicit BlockBitReader(const void* pBlock)
+    {
+        memcpy(m_Bits, pBlock, sizeof(m_Bits));
+    }
+
+    Uint32 Read(Uint32 NumBits)
+    {
+        VERIFY_EXPR(NumBits <= 32);
+        if (NumBits == 0)
+            return 0;
+
+        const auto Value = static_cast<Uint32>(m_Bits[0] & ((Uint64{1} << NumBits) - 1));
+        m_Bits[0]        = (m_Bits[0] >> NumBits) | (m_Bits[1] << (64 - NumBits));
+        m_Bits[1] >>= NumBits;
+        return Value;
+    }
+
+    // Reads the bits in reverse order: the first bit read becomes the most significant bit
+    Uint32 ReadReversed(Uint32 NumBits)
+    {
+        Uint32 Value = 0;
+        for (Uint32 i = 0; i < NumBits; ++i)
+            Value = (Value << 1) | Read(1);
+        return Value;
+    }
+
+private:
+    Uint64 m_Bits[2];
+};
+
+inline float UnormToFloat(Uint32 Value, Uint32 MaxValue)
+{
+    return static_cast<float>(Value) / static_cast<float>(MaxValue);
+}
+
+inline void WriteTexel(float* pRGBA, Uint32 Texel, float R, float G, float B, float A)
+{
+    pRGBA[Texel * 4 + 0] = R;
+    pRGBA[Texel * 4 + 1] = G;
+    pRGBA[Texel * 4 + 2] = B;
+    pRGBA[Texel * 4 + 3] = A;
+}
+
+// Decodes the color part of BC1, BC2 and BC3 blocks. BC2 and BC3 always use the four-color mode.
+void DecodeBC1Colors(const Uint8* pBlock, bool AllowThreeColorMode, bool IsSRGB, float* pRGBA)
+{
+    Uint16 C[2];
+    memcpy(C, pBlock, sizeof(C));
+    Uint32 Indices;
+    memcpy(&Indices, pBlock + 4, sizeof(Indices));
+
+    float Palette[4][4];
+    for (Uint32 i = 0; i < 2; ++i)
+    {
+        const Uint32 R = (C[i] >> 11) & 0x1F;
+        const Uint32 G = (C[i] >> 5) & 0x3F;
+        const Uint32 B = C[i] & 0x1F;
+
+        Palette[i][0] = static_cast<float>((R << 3) | (R >> 2));
+        Palette[i][1] = static_cast<float>((G << 2) | (G >> 4));
+        Palette[i][2] = static_cast<float>((B << 3) | (B >> 2));
+        Palette[i][3] = 255.f;
+    }
+
+    const bool ThreeColorMode = AllowThreeColorMode && C[0] <= C[1];
+    for (Uint32 c = 0; c < 4; ++c)
+    {
+        if (ThreeColorMode)
+        {
+            Palette[2][c] = (Palette[0][c] + Palette[1][c]) * 0.5f;
+            Palette[3][c] = 0;
+        }
+        else
+        {
+            Palette[2][c] = (Palette[0][c] * 2.f + Palette[1][c]) / 3.f;
+            Palette[3][c] = (Palette[0][c] + Palette[1][c] * 2.f) / 3.f;
+        }
+    }
+
+    for (auto& Color : Palette)
+    {
+        for (Uint32 c = 0; c < 4; ++c)
+        {
+            Color[c] /= 255.f;
+            if (IsSRGB && c < 3)
+                Color[c] = SRGBToLinear(Color[c]);
+        }
+    }
+
+    for (Uint32 i = 0; i < 16; ++i)
+    {
+        const auto& Color = Palette[(Indices >> (i * 2)) & 0x03];
+        WriteTexel(pRGBA, i, Color[0], Color[1], Color[2], Color[3]);
+    }
+}
+
+// Decodes a BC4 block into the given channel of the RGBA block
+void DecodeBC4Channel(const Uint8* pBlock, bool IsSigned, float* pRGBA, Uint32 Channel)
+{
+    float Palette[8];
+    if (IsSigned)
+    {
+        // -128 and -127 both map to -1.0
+        const auto A0 = std::max(static_cast<Int32>(static_cast<Int8>(pBlock[0])), -127);
+        const auto A1 = std::max(static_cast<Int32>(static_cast<Int8>(pBlock[1])), -127);
+
+        Palette[0] = static_cast<float>(A0);
+        Palette[1] = static_cast<float>(A1);
+        if (static_cast<Int8>(pBlock[0]) > static_cast<Int8>(pBlock[1]))
+        {
+            for (Uint32 i = 2; i < 8; ++i)
+                Palette[i] = (Palette[0] * static_cast<float>(8 - i) + Palette[1] * static_cast<float>(i - 1)) / 7.f;
+        }
+        else
+        {
+            for (Uint32 i = 2; i < 6; ++i)
+                Palette[i] = (Palette[0] * static_cast<float>(6 - i) + Palette[1] * static_cast<float>(i - 1)) / 5.f;
+            Palette[6] = -127.f;
+            Palette[7] = 127.f;
+        }
+        for (auto& Val : Palette)
+            Val /= 127.f;
+    }
+    else
+    {
+        Palette[0] = static_cast<float>(pBlock[0]);
+        Palette[1] = static_cast<float>(pBlock[1]);
+        if (pBlock[0] > pBlock[1])
+        {
+            for (Uint32 i = 2; i < 8; ++i)
+                Palette[i] = (Palette[0] * static_cast<float>(8 - i) + Palette[1] * static_cast<float>(i - 1)) / 7.f;
+        }
+        else
+        {
+            for (Uint32 i = 2; i < 6; ++i)
+                Palette[i] = (Palette[0] * static_cast<float>(6 - i) + Palette[1] * static_cast<float>(i - 1)) / 5.f;
+            Palette[6] = 0.f;
+            Palette[7] = 255.f;
+        }
+        for (auto& Val : Palette)
+            Val /= 255.f;
+    }
+
+    Uint64 Indices = 0;
+    memcpy(&Indices, pBlock + 2, 6);
+    for (Uint32 i = 0; i < 16; ++i)
+        pRGBA[i * 4 + Channel] = Palette[(Indices >> (i * 3)) & 0x07];
+}
+
+void DecodeBC2Alpha(const Uint8* pBlock, float* pRGBA)
+{
+    for (Uint32 i = 0; i < 16; ++i)
+    {
+        const Uint32 Alpha = (pBlock[i / 2] >> ((i & 0x01) * 4)) & 0x0F;
+        pRGBA[i * 4 + 3]   = UnormToFloat(Alpha, 15);
+    }
+}
+
+
+// Partition tables shared by BC6H and BC7. Two-subset partitions are stored as 16-bit masks
+// where bit i is the subset of texel i. Three-subset partitions use two bits per texel.
+// clang-format off
+static constexpr Uint16 Partitions2[64] =
+{
+    0xCCCC, 0x8888, 0xEEEE, 0xECC8, 0xC880, 0xFEEC, 0xFEC8, 0xEC80,
+    0xC800, 0xFFEC, 0xFE80, 0xE800, 0xFFE8, 0xFF00, 0xFFF0, 0xF000,
+    0xF710, 0x008E, 0x7100, 0x08CE, 0x008C, 0x7310, 0x3100, 0x8CCE,
+    0x088C, 0x3110, 0x6666, 0x366C, 0x17E8, 0x0FF0, 0x718E, 0x399C,
+    0xAAAA, 0xF0F0, 0x5A5A, 0x33CC, 0x3C3C, 0x55AA, 0x9696, 0xA55A,
+    0x73CE, 0x13C8, 0x324C, 0x3BDC, 0x6996, 0xC33C, 0x9966, 0x0660,
+    0x0272, 0x04E4, 0x4E40, 0x2720, 0xC936, 0x936C, 0x39C6, 0x639C,
+    0x9336, 0x9CC6, 0x817E, 0xE718, 0xCCF0, 0x0FCC, 0x7744, 0xEE22
+};
+
+static constexpr Uint32 Partitions3[64] =
+{
+    0xAA685050, 0x6A5A5040, 0x5A5A4200, 0x5450A0A8, 0xA5A50000, 0xA0A05050, 0x5555A0A0, 0x5A5A5050,
+    0xAA550000, 0xAA555500, 0xAAAA5500, 0x90909090, 0x94949494, 0xA4A4A4A4, 0xA9A59450, 0x2A0A4250,
+    0xA5945040, 0x0A425054, 0xA5A5A500, 0x55A0A0A0, 0xA8A85454, 0x6A6A4040, 0xA4A45000, 0x1A1A0500,
+    0x0050A4A4, 0xAAA59090, 0x14696914, 0x69691400, 0xA08585A0, 0xAA821414, 0x50A4A450, 0x6A5A0200,
+    0xA9A58000, 0x5090A0A8, 0xA8A09050, 0x24242424, 0x00AA5500, 0x24924924, 0x24499224, 0x50A50A50,
+    0x500AA550, 0xAAAA4444, 0x66660000, 0xA5A0A5A0, 0x50A050A0, 0x69286928, 0x44AAAA44, 0x66666600,
+    0xAA444444, 0x54A854A8, 0x95809580, 0x96969600, 0xA85454A8, 0x80959580, 0xAA141414, 0x96960000,
+    0xAAAA1414, 0xA05050A0, 0xA0A5A5A0, 0x96000000, 0x40804080, 0xA9A8A9A8, 0xAAAAAA44, 0x2A4A5254
+};
+
+// Anchor texel of the second subset of two-subset partitions
+static constexpr Uint8 Anchors2[64] =
+{
+    15,15,15,15,15,15,15,15,
+    15,15,15,15,15,15,15,15,
+    15, 2, 8, 2, 2, 8, 8,15,
+     2, 8, 2, 2, 8, 8, 2, 2,
+    15,15, 6, 8, 2, 8,15,15,
+     2, 8, 2, 2, 2,15,15, 6,
+     6, 2, 6, 8,15,15, 2, 2,
+    15,15,15,15,15, 2, 2,15
+};
+
+// Anchor texels of the second and the third subsets of three-subset partitions
+static constexpr Uint8 Anchors3[2][64] =
+{
+    {
+         3, 3,15,15, 8, 3,15,15,
+         8, 8, 6, 6, 6, 5, 3, 3,
+         3, 3, 8,15, 3, 3, 6,10,
+         5, 8, 8, 6, 8, 5,15,15,
+         8,15, 3, 5, 6,10, 8,15,
+        15, 3,15, 5,15,15,15,15,
+         3,15, 5, 5, 5, 8, 5,10,
+         5,10, 8,13,15,12, 3, 3
+    },
+    {
+        15, 8, 8, 3,15,15, 3, 8,
+        15,15,15,15,15,15,15, 8,
+        15, 8,15, 3,15, 8,15, 8,
+         3,15, 6,10,15,15,10, 8,
+        15, 3,15,10,10, 8, 9,10,
+         6,15, 8,15, 3, 6, 6, 8,
+        15, 3,15,15,15,15,15,15,
+        15,15,15,15, 3,15,15, 8
+    }
+};
+
+static constexpr Uint32 Weights2[4]  = {0, 21, 43, 64};
+static constexpr Uint32 Weights3[8]  = {0, 9, 18, 27, 37, 46, 55, 64};
+static constexpr Uint32 Weights4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+// clang-format on
+
+const Uint32* GetWeights(Uint32 IndexBits)
+{
+    switch (IndexBits)
+    {
+        case 2: return Weights2;
+        case 3: return Weights3;
+        case 4: return Weights4;
+        default:
+            UNEXPECTED("Unexpected number of index bits");
+            return Weights2;
+    }
+}
+
+inline Uint32 GetPartitionSubset(Uint32 NumSubsets, Uint32 Partition, Uint32 Texel)
+{
+    switch (NumSubsets)
+    {
+        case 2: return (Partitions2[Partition] >> Texel) & 0x01;
+        case 3: return (Partitions3[Partition] >> (Texel * 2)) & 0x03;
+        default: return 0;
+    }
+}
+
+inline bool IsAnchorTexel(Uint32 NumSubsets, Uint32 Partition, Uint32 Texel)
+{
+    if (Texel == 0)
+        return true;
+
+    switch (NumSubsets)
+    {
+        case 2: return Texel == Anchors2[Partition];
+        case 3: return Texel == Anchors3[0][Partition] || Texel == Anchors3[1][Partition];
+        default: return false;
+    }
+}
+
+inline Uint32 InterpolateBC7(Uint32 E0, Uint32 E1, Uint32 Weight)
+{
+    return ((64 - Weight) * E0 + Weight * E1 + 32) >> 6;
+}
+
+void DecodeBC7(const Uint8* pBlock, bool IsSRGB, float* pRGBA)
+{
+    struct ModeInfo
+    {
+        Uint8 NumSubsets;
+        Uint8 PartitionBits;
+        Uint8 RotationBits;
+        Uint8 IndexSelectionBits;
+        Uint8 ColorBits;
+        Uint8 AlphaBits;
+        Uint8 EndpointPBits;
+        Uint8 SharedPBits;
+        Uint8 IndexBits;
+        Uint8 IndexBits2;
+    };
+    // clang-format off
+    static constexpr ModeInfo Modes[8] =
+    {
+        // NS PB RB ISB CB AB EPB SPB IB IB2
+        {  3, 4, 0, 0,  4, 0, 1,  0,  3, 0},
+        {  2, 6, 0, 0,  6, 0, 0,  1,  3, 0},
+        {  3, 6, 0, 0,  5, 0, 0,  0,  2, 0},
+        {  2, 6, 0, 0,  7, 0, 1,  0,  2, 0},
+        {  1, 0, 2, 1,  5, 6, 0,  0,  2, 3},
+        {  1, 0, 2, 0,  7, 8, 0,  0,  2, 2},
+        {  1, 0, 0, 0,  7, 7, 1,  0,  4, 0},
+        {  2, 6, 0, 0,  5, 5, 1,  0,  2, 0}
+    };
+    // clang-format on
+
+    if (pBlock[0] == 0)
+    {
+        // Reserved mode
+        memset(pRGBA, 0, sizeof(float) * 16 * 4);
+        return;
+    }
+
+    Uint32 ModeIdx = 0;
+    while ((pBlock[0] & (1u << ModeIdx)) == 0)
+        ++ModeIdx;
+
+    const auto&    Mode = Modes[ModeIdx];
+    BlockBitReader Reader{pBlock};
+    Reader.Read(ModeIdx + 1);
+
+    const Uint32 Partition      = Reader.Read(Mode.PartitionBits);
+    const Uint32 Rotation       = Reader.Read(Mode.RotationBits);
+    const Uint32 IndexSelection = Reader.Read(Mode.IndexSelectionBits);
+    const Uint32 NumEndpoints   = Mode.NumSubsets * 2u;
+
+    Uint32 Endpoints[6][4] = {};
+    for (Uint32 c = 0; c < 3; ++c)
+    {
+        for (Uint32 e = 0; e < NumEndpoints; ++e)
+            Endpoints[e][c] = Reader.Read(Mode.ColorBits);
+    }
+    for (Uint32 e = 0; e < NumEndpoints; ++e)
+        Endpoints[e][3] = Reader.Read(Mode.AlphaBits);
+
+    Uint32 PBits[6] = {};
+    if (Mode.EndpointPBits != 0)
+    {
+        for (Uint32 e = 0; e < NumEndpoints; ++e)
+            PBits[e] = Reader.Read(1);
+    }
+    else if (Mode.SharedPBits != 0)
+    {
+        for (Uint32 s = 0; s < Mode.NumSubsets; ++s)
+            PBits[s * 2] = PBits[s * 2 + 1] = Reader.Read(1);
+    }
+    const bool HasPBits = Mode.EndpointPBits != 0 || Mode.SharedPBits != 0;
+
+    // Expand endpoints to 8 bits by replicating the most significant bits
+    for (Uint32 e = 0; e < NumEndpoints; ++e)
+    {
+        for (Uint32 c = 0; c < 4; ++c)
+        {
+            Uint32 NumBits = c < 3 ? Mode.ColorBits : Mode.AlphaBits;
+            if (NumBits == 0)
+            {
+                Endpoints[e][c] = 255;
+                continue;
+            }
+
+            auto& Val = Endpoints[e][c];
+            if (HasPBits)
+            {
+                Val = (Val << 1) | PBits[e];
+                ++NumBits;
+            }
+            Val <<= 8 - NumBits;
+            Val |= Val >> NumBits;
+        }
+    }
+
+    Uint32 Indices[16];
+    for (Uint32 i = 0; i < 16; ++i)
+        Indices[i] = Reader.Read(Mode.IndexBits - (IsAnchorTexel(Mode.NumSubsets, Partition, i) ? 1 : 0));
+
+    Uint32 Indices2[16] = {};
+    if (Mode.IndexBits2 != 0)
+    {
+        for (Uint32 i = 0; i < 16; ++i)
+            Indices2[i] = Reader.Read(Mode.IndexBits2 - (i == 0 ? 1 : 0));
+    }
+
+    const Uint32* ColorIndices = Indices;
+    const Uint32* AlphaIndices = Mode.IndexBits2 != 0 ? Indices2 : Indices;
+    const Uint32* ColorWeights = GetWeights(Mode.IndexBits);
+    const Uint32* AlphaWeights = GetWeights(Mode.IndexBits2 != 0 ? Mode.IndexBits2 : Mode.IndexBits);
+    if (IndexSelection != 0)
+    {
+        std::swap(ColorIndices, AlphaIndices);
+        std::swap(ColorWeights, AlphaWeights);
+    }
+
+    for (Uint32 i = 0; i < 16; ++i)
+    {
+        const Uint32 Subset = GetPartitionSubset(Mode.NumSubsets, Partition, i);
+        const auto&  E0     = Endpoints[Subset * 2];
+        const auto&  E1     = Endpoints[Subset * 2 + 1];
+
+        Uint32 Color[4];
+        for (Uint32 c = 0; c < 3; ++c)
+            Color[c] = InterpolateBC7(E0[c], E1[c], ColorWeights[ColorIndices[i]]);
+        Color[3] = InterpolateBC7(E0[3], E1[3], AlphaWeights[AlphaIndices[i]]);
+
+        if (Rotation != 0)
+            std::swap(Color[3], Color[Rotation - 1]);
+
+        if (IsSRGB)
+        {
+            WriteTexel(pRGBA, i,
+                       SRGBToLinear(static_cast<Uint8>(Color[0])),
+                       SRGBToLinear(static_cast<Uint8>(Color[1])),
+                       SRGBToLinear(static_cast<Uint8>(Color[2])),
+                       UnormToFloat(Color[3], 255));
+        }
+        else
+        {
+            WriteTexel(pRGBA, i, UnormToFloat(Color[0], 255), UnormToFloat(Color[1], 255), UnormToFloat(Color[2], 255), UnormToFloat(Color[3], 255));
+        }
+    }
+}
+
+
+inline Int32 SignExtend(Uint32 Value, Uint32 NumBits)
+{
+    const Uint32 SignBit = 1u << (NumBits - 1);
+    Value &= (1u << NumBits) - 1;
+    return static_cast<Int32>(Value ^ SignBit) - static_cast<Int32>(SignBit);
+}
+
+Int32 UnquantizeBC6H(Int32 Value, Uint32 NumBits, bool IsSigned)
+{
+    if (!IsSigned)
+    {
+        if (NumBits >= 15 || Value == 0)
+            return Value;
+        if (Value == (1 << NumBits) - 1)
+            return 0xFFFF;
+        return ((Value << 16) + 0x8000) >> NumBits;
+    }
+    else
+    {
+        if (NumBits >= 16 || Value == 0)
+            return Value;
+
+        const bool Negative = Value < 0;
+        if (Negative)
+            Value = -Value;
+
+        Int32 Unquantized = Value >= (1 << (NumBits - 1)) - 1 ?
+            0x7FFF :
+            ((Value << 15) + 0x4000) >> (NumBits - 1);
+        return Negative ? -Unquantized : Unquantized;
+    }
+}
+
+// Scales the interpolated value to the half-float range and returns the half-float bits
+Uint16 FinishUnquantizeBC6H(Int32 Value, bool IsSigned)
+{
+    if (!IsSigned)
+        return static_cast<Uint16>((Value * 31) >> 6);
+
+    Value = Value < 0 ? -(((-Value) * 31) >> 5) : (Value * 31) >> 5;
+    return static_cast<Uint16>(Value < 0 ? (0x8000 | -Value) : Value);
+}
+
+void DecodeBC6H(const Uint8* pBlock, bool IsSigned, float* pRGBA)
+{
+    // Endpoint precision and delta bits for each mode
+    // clang-format off
+    static constexpr Uint8 EndpointBits[14]  = {10, 7, 11, 11, 11, 9, 8, 8, 8, 6, 10, 11, 12, 16};
+    static constexpr Uint8 DeltaBits[3][14] =
+    {
+        {5, 6, 5, 4, 4, 5, 6, 5, 5, 6, 10, 9, 8, 4},
+        {5, 6, 4, 5, 4, 5, 5, 6, 5, 6, 10, 9, 8, 4},
+        {5, 6, 4, 4, 5, 5, 5, 5, 6, 6, 10, 9, 8, 4}
+    };
+    // clang-format on
+
+    BlockBitReader Reader{pBlock};
+
+    // Endpoints are labeled w, x (first subset) and y, z (second subset)
+    Int32 R[4] = {};
+    Int32 G[4] = {};
+    Int32 B[4] = {};
+
+    auto Bits = [&Reader](Int32& Dst, Uint32 NumBits, Uint32 Shift = 0) {
+        Dst |= static_cast<Int32>(Reader.Read(NumBits) << Shift);
+    };
+    auto Bit = [&Reader](Int32& Dst, Uint32 BitIdx) {
+        Dst |= static_cast<Int32>(Reader.Read(1) << BitIdx);
+    };
+    auto ReversedBits = [&Reader](Int32& Dst, Uint32 NumBits, Uint32 Shift) {
+        Dst |= static_cast<Int32>(Reader.ReadReversed(NumBits) << Shift);
+    };
+
+    Uint32 Mode = Reader.Read(2);
+    if (Mode > 1)
+        Mode |= Reader.Read(3) << 2;
+
+    Uint32 ModeIdx   = 0;
+    Uint32 Partition = 0;
+    switch (Mode)
+    {
+        case 0x00:
+            ModeIdx = 0;
+            Bit(G[2], 4), Bit(B[2], 4), Bit(B[3], 4);
+            Bits(R[0], 10), Bits(G[0], 10), Bits(B[0], 10);
+            Bits(R[1], 5), Bit(G[3], 4), Bits(G[2], 4);
+            Bits(G[1], 5), Bit(B[3], 0), Bits(G[3], 4);
+            Bits(B[1], 5), Bit(B[3], 1), Bits(B[2], 4);
+            Bits(R[2], 5), Bit(B[3], 2), Bits(R[3], 5), Bit(B[3], 3);
+            break;
+
+        case 0x01:
+            ModeIdx = 1;
+            Bit(G[2], 5), Bit(G[3], 4), Bit(G[3], 5);
+            Bits(R[0], 7), Bit(B[3], 0), Bit(B[3], 1), Bit(B[2], 4);
+            Bits(G[0], 7), Bit(B[2], 5), Bit(B[3], 2), Bit(G[2], 4);
+            Bits(B[0], 7), Bit(B[3], 3), Bit(B[3], 5), Bit(B[3], 4);
+            Bits(R[1], 6), Bits(G[2], 4);
+            Bits(G[1], 6), Bits(G[3], 4);
+            Bits(B[1], 6), Bits(B[2], 4);
+            Bits(R[2], 6), Bits(R[3], 6);
+            break;
+
+        case 0x02:
+            ModeIdx = 2;
+            Bits(R[0], 10), Bits(G[0], 10), Bits(B[0], 10);
+            Bits(R[1], 5), Bit(R[0], 10), Bits(G[2], 4);
+            Bits(G[1], 4), Bit(G[0], 10), Bit(B[3], 0), Bits(G[3], 4);
+            Bits(B[1], 4), Bit(B[0], 10), Bit(B[3], 1), Bits(B[2], 4);
+            Bits(R[2], 5), Bit(B[3], 2), Bits(R[3], 5), Bit(B[3], 3);
+            break;
+
+        case 0x06:
+            ModeIdx = 3;
+            Bits(R[0], 10), Bits(G[0], 10), Bits(B[0], 10);
+            Bits(R[1], 4), Bit(R[0], 10), Bit(G[3], 4), Bits(G[2], 4);
+            Bits(G[1], 5), Bit(G[0], 10), Bits(G[3], 4);
+            Bits(B[1], 4), Bit(B[0], 10), Bit(B[3], 1), Bits(B[2], 4);
+            Bits(R[2], 4), Bit(B[3], 0), Bit(B[3], 2), Bits(R[3], 4), Bit(G[2], 4), Bit(B[3], 3);
+            break;
+
+        case 0x0A:
+            ModeIdx = 4;
+            Bits(R[0], 10), Bits(G[0], 10), Bits(B[0], 10);
+            Bits(R[1], 4), Bit(R[0], 10), Bit(B[2], 4), Bits(G[2], 4);
+            Bits(G[1], 4), Bit(G[0], 10), Bit(B[3], 0), Bits(G[3], 4);
+            Bits(B[1], 5), Bit(B[0], 10), Bits(B[2], 4);
+            Bits(R[2], 4), Bit(B[3], 1), Bit(B[3], 2), Bits(R[3], 4), Bit(B[3], 4), Bit(B[3], 3);
+            break;
+
+        case 0x0E:
+            ModeIdx = 5;
+            Bits(R[0], 9), Bit(B[2], 4), Bits(G[0], 9), Bit(G[2], 4), Bits(B[0], 9), Bit(B[3], 4);
+            Bits(R[1], 5), Bit(G[3], 4), Bits(G[2], 4);
+            Bits(G[1], 5), Bit(B[3], 0), Bits(G[3], 4);
+            Bits(B[1], 5), Bit(B[3], 1), Bits(B[2], 4);
+            Bits(R[2], 5), Bit(B[3], 2), Bits(R[3], 5), Bit(B[3], 3);
+            break;
+
+        case 0x12:
+            ModeIdx = 6;
+            Bits(R[0], 8), Bit(G[3], 4), Bit(B[2], 4), Bits(G[0], 8), Bit(B[3], 2), Bit(G[2], 4);
+            Bits(B[0], 8), Bit(B[3], 3), Bit(B[3], 4);
+            Bits(R[1], 6), Bits(G[2], 4);
+            Bits(G[1], 5), Bit(B[3], 0), Bits(G[3], 4);
+            Bits(B[1], 5), Bit(B[3], 1), Bits(B[2], 4);
+            Bits(R[2], 6), Bits(R[3], 6);
+            break;
+
+        case 0x16:
+            ModeIdx = 7;
+            Bits(R[0], 8), Bit(B[3], 0), Bit(B[2], 4), Bits(G[0], 8), Bit(G[2], 5), Bit(G[2], 4);
+            Bits(B[0], 8), Bit(G[3], 5), Bit(B[3], 4);
+            Bits(R[1], 5), Bit(G[3], 4), Bits(G[2], 4);
+            Bits(G[1], 6), Bits(G[3], 4);
+            Bits(B[1], 5), Bit(B[3], 1), Bits(B[2], 4);
+            Bits(R[2], 5), Bit(B[3], 2), Bits(R[3], 5), Bit(B[3], 3);
+            break;
+
+        case 0x1A:
+            ModeIdx = 8;
+            Bits(R[0], 8), Bit(B[3], 1), Bit(B[2], 4), Bits(G[0], 8), Bit(B[2], 5), Bit(G[2], 4);
+            Bits(B[0], 8), Bit(B[3], 5), Bit(B[3], 4);
+            Bits(R[1], 5), Bit(G[3], 4), Bits(G[2], 4);
+            Bits(G[1], 5), Bit(B[3], 0), Bits(G[3], 4);
+            Bits(B[1], 6), Bits(B[2], 4);
+            Bits(R[2], 5), Bit(B[3], 2), Bits(R[3], 5), Bit(B[3], 3);
+            break;
+
+        case 0x1E:
+            ModeIdx = 9;
+            Bits(R[0], 6), Bit(G[3], 4), Bit(B[3], 0), Bit(B[3], 1), Bit(B[2], 4);
+            Bits(G[0], 6), Bit(G[2], 5), Bit(B[2], 5), Bit(B[3], 2), Bit(G[2], 4);
+            Bits(B[0], 6), Bit(G[3], 5), Bit(B[3], 3), Bit(B[3], 5), Bit(B[3], 4);
+            Bits(R[1], 6), Bits(G[2], 4);
+            Bits(G[1], 6), Bits(G[3], 4);
+            Bits(B[1], 6), Bits(B[2], 4);
+            Bits(R[2], 6), Bits(R[3], 6);
+            break;
+
+        case 0x03:
+            ModeIdx = 10;
+            Bits(R[0], 10), Bits(G[0], 10), Bits(B[0], 10);
+            Bits(R[1], 10), Bits(G[1], 10), Bits(B[1], 10);
+            break;
+
+        case 0x07:
+            ModeIdx = 11;
+            Bits(R[0], 10), Bits(G[0], 10), Bits(B[0], 10);
+            Bits(R[1], 9), Bit(R[0], 10);
+            Bits(G[1], 9), Bit(G[0], 10);
+            Bits(B[1], 9), Bit(B[0], 10);
+            break;
+
+        case 0x0B:
+            ModeIdx = 12;
+            Bits(R[0], 10), Bits(G[0], 10), Bits(B[0], 10);
+            Bits(R[1], 8), ReversedBits(R[0], 2, 10);
+            Bits(G[1], 8), ReversedBits(G[0], 2, 10);
+            Bits(B[1], 8), ReversedBits(B[0], 2, 10);
+            break;
+
+        case 0x0F:
+            ModeIdx = 13;
+            Bits(R[0], 10), Bits(G[0], 10), Bits(B[0], 10);
+            Bits(R[1], 4), ReversedBits(R[0], 6, 10);
+            Bits(G[1], 4), ReversedBits(G[0], 6, 10);
+            Bits(B[1], 4), ReversedBits(B[0], 6, 10);
+            break;
+
+        default:
+            // Reserved mode
+            memset(pRGBA, 0, sizeof(float) * 16 * 4);
+            return;
+    }
+
+    const Uint32 NumSubsets = ModeIdx < 10 ? 2 : 1;
+    if (NumSubsets == 2)
+        Partition = Reader.Read(5);
+
+    const Uint32 NumEndpoints = NumSubsets * 2;
+    const Uint32 BaseBits     = EndpointBits[ModeIdx];
+    const bool   Transformed  = ModeIdx != 9 && ModeIdx != 10;
+
+    Int32* Channels[3] = {R, G, B};
+    for (Uint32 c = 0; c < 3; ++c)
+    {
+        Int32* E = Channels[c];
+        if (IsSigned)
+            E[0] = SignExtend(static_cast<Uint32>(E[0]), BaseBits);
+
+        for (Uint32 e = 1; e < NumEndpoints; ++e)
+        {
+            if (Transformed)
+            {
+                // Deltas are always signed
+                E[e] = SignExtend(static_cast<Uint32>(E[e]), DeltaBits[c][ModeIdx]);
+                E[e] = (E[0] + E[e]) & ((1 << BaseBits) - 1);
+            }
+            if (IsSigned)
+                E[e] = SignExtend(static_cast<Uint32>(E[e]), BaseBits);
+        }
+
+        for (Uint32 e = 0; e < NumEndpoints; ++e)
+            E[e] = UnquantizeBC6H(E[e], BaseBits, IsSigned);
+    }
+
+    const Uint32  IndexBits = NumSubsets == 2 ? 3 : 4;
+    const Uint32* Weights   = GetWeights(IndexBits);
+    for (Uint32 i = 0; i < 16; ++i)
+    {
+        const bool   IsAnchor = i == 0 || (NumSubsets == 2 && i == Anchors2[Partition]);
+        const Uint32 Index    = Reader.Read(IndexBits - (IsAnchor ? 1 : 0));
+        const Uint32 Subset   = GetPartitionSubset(NumSubsets, Partition, i);
+        const Int32  Weight   = static_cast<Int32>(Weights[Index]);
+
+        float Color[3];
+        for (Uint32 c = 0; c < 3; ++c)
+        {
+            const Int32* E     = Channels[c];
+            const Int32  Value = (E[Subset * 2] * (64 - Weight) + E[Subset * 2 + 1] * Weight + 32) >> 6;
+            Color[c]           = HalfToFloat(FinishUnquantizeBC6H(Value, IsSigned));
+        }
+        WriteTexel(pRGBA, i, Color[0], Color[1], Color[2], 1.f);
+    }
+}
+
+} // namespace
+
+
+void DecompressBlock(TEXTURE_FORMAT Format, const void* pBlock, float* pRGBA)
+{
+    VERIFY_EXPR(pBlock != nullptr && pRGBA != nullptr);
+    const auto* pBytes = static_cast<const Uint8*>(pBlock);
+    switch (Format)
+    {
+        case TEX_FORMAT_BC1_TYPELESS:
+        case TEX_FORMAT_BC1_UNORM:
+        case TEX_FORMAT_BC1_UNORM_SRGB:
+            DecodeBC1Colors(pBytes, true, Format == TEX_FORMAT_BC1_UNORM_SRGB, pRGBA);
+            break;
+
+        case TEX_FORMAT_BC2_TYPELESS:
+        case TEX_FORMAT_BC2_UNORM:
+        case TEX_FORMAT_BC2_UNORM_SRGB:
+            DecodeBC1Colors(pBytes + 8, false, Format == TEX_FORMAT_BC2_UNORM_SRGB, pRGBA);
+            DecodeBC2Alpha(pBytes, pRGBA);
+            break;
+
+        case TEX_FORMAT_BC3_TYPELESS:
+        case TEX_FORMAT_BC3_UNORM:
+        case TEX_FORMAT_BC3_UNORM_SRGB:
+            DecodeBC1Colors(pBytes + 8, false, Format == TEX_FORMAT_BC3_UNORM_SRGB, pRGBA);
+            DecodeBC4Channel(pBytes, false, pRGBA, 3);
+            break;
+
+        case TEX_FORMAT_BC4_TYPELESS:
+        case TEX_FORMAT_BC4_UNORM:
+        case TEX_FORMAT_BC4_SNORM:
+            for (Uint32 i = 0; i < 16; ++i)
+                WriteTexel(pRGBA, i, 0, 0, 0, 1);
+            DecodeBC4Channel(pBytes, Format == TEX_FORMAT_BC4_SNORM, pRGBA, 0);
+            break;
+
+        case TEX_FORMAT_BC5_TYPELESS:
+        case TEX_FORMAT_BC5_UNORM:
+        case TEX_FORMAT_BC5_SNORM:
+            for (Uint32 i = 0; i < 16; ++i)
+                WriteTexel(pRGBA, i, 0, 0, 0, 1);
+            DecodeBC4Channel(pBytes, Format == TEX_FORMAT_BC5_SNORM, pRGBA, 0);
+            DecodeBC4Channel(pBytes + 8, Format == TEX_FORMAT_BC5_SNORM, pRGBA, 1);
+            break;
+
+        case TEX_FORMAT_BC6H_TYPELESS:
+        case TEX_FORMAT_BC6H_UF16:
+        case TEX_FORMAT_BC6H_SF16:
+            DecodeBC6H(pBytes, Format == TEX_FORMAT_BC6H_SF16, pRGBA);
+            break;
+
+        case TEX_FORMAT_BC7_TYPELESS:
+        case TEX_FORMAT_BC7_UNORM:
+        case TEX_FORMAT_BC7_UNORM_SRGB:
+            DecodeBC7(pBytes, Format == TEX_FORMAT_BC7_UNORM_SRGB, pRGBA);
+            break;
+
+        default:
+            UNEXPECTED("Format ", GetTextureFormatAttribs(Format).Name, " is not a block-compressed format");
+            memset(pRGBA, 0, sizeof(float) * 16 * 4);
+    }
+}
+
+} // namespace Diligent
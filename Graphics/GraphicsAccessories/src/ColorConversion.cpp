@@ -27,8 +27,23 @@
 
 #include <array>
 #include <algorithm>
+#include <cstring>
 #include "ColorConversion.h"
 
+#if defined(__AVX2__)
+#    include <immintrin.h>
+#    define CC_USE_AVX2 1
+#    define CC_USE_SIMD 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define CC_USE_SSE2 1
+#    define CC_USE_SIMD 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#    include <arm_neon.h>
+#    define CC_USE_NEON 1
+#    define CC_USE_SIMD 1
+#endif
+
 namespace Diligent
 {
 
@@ -71,10 +86,263 @@ public:
         return m_ToLinear[x];
     }
 
+    const float* data() const
+    {
+        return m_ToLinear.data();
+    }
+
 private:
     std::array<float, 256> m_ToLinear;
 };
 
+const SRGBToLinearMap& GetSRGBToLinearMap()
+{
+    static const SRGBToLinearMap map;
+    return map;
+}
+
+#if CC_USE_SIMD
+
+// Thin wrappers over the instruction set used for bulk conversions. All variants
+// implement exactly the same operations, so every code path produces the same results.
+#    if CC_USE_AVX2
+
+struct SIMDOps
+{
+    static constexpr size_t Width = 8;
+
+    using Float = __m256;
+    using Int   = __m256i;
+    using Mask  = __m256;
+
+    static Float Load(const float* p) { return _mm256_loadu_ps(p); }
+    static void  Store(float* p, Float v) { _mm256_storeu_ps(p, v); }
+    static void  StoreU8(Uint8* p, Int v)
+    {
+        const auto Words = _mm_packs_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(p), _mm_packus_epi16(Words, Words));
+    }
+
+    static Float Set(float f) { return _mm256_set1_ps(f); }
+    static Int   SetI(Int32 i) { return _mm256_set1_epi32(i); }
+
+    static Float Add(Float a, Float b) { return _mm256_add_ps(a, b); }
+    static Float Sub(Float a, Float b) { return _mm256_sub_ps(a, b); }
+    static Float Mul(Float a, Float b) { return _mm256_mul_ps(a, b); }
+    static Float Min(Float a, Float b) { return _mm256_min_ps(a, b); }
+    static Float Max(Float a, Float b) { return _mm256_max_ps(a, b); }
+
+    static Mask  LessEqual(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+    static Float Select(Mask m, Float a, Float b) { return _mm256_blendv_ps(b, a, m); }
+
+    static Int   AsInt(Float f) { return _mm256_castps_si256(f); }
+    static Float AsFloat(Int i) { return _mm256_castsi256_ps(i); }
+
+    static Int IAdd(Int a, Int b) { return _mm256_add_epi32(a, b); }
+    static Int ISub(Int a, Int b) { return _mm256_sub_epi32(a, b); }
+    static Int IAnd(Int a, Int b) { return _mm256_and_si256(a, b); }
+
+    template <int N> static Int ShiftRight(Int a) { return _mm256_srai_epi32(a, N); }
+    template <int N> static Int ShiftLeft(Int a) { return _mm256_slli_epi32(a, N); }
+
+    static Float ToFloat(Int i) { return _mm256_cvtepi32_ps(i); }
+    static Int   Truncate(Float f) { return _mm256_cvttps_epi32(f); }
+};
+
+#    elif CC_USE_SSE2
+
+struct SIMDOps
+{
+    static constexpr size_t Width = 4;
+
+    using Float = __m128;
+    using Int   = __m128i;
+    using Mask  = __m128;
+
+    static Float Load(const float* p) { return _mm_loadu_ps(p); }
+    static void  Store(float* p, Float v) { _mm_storeu_ps(p, v); }
+    static void  StoreU8(Uint8* p, Int v)
+    {
+        const auto Words = _mm_packs_epi32(v, v);
+        const auto Bytes = _mm_cvtsi128_si32(_mm_packus_epi16(Words, Words));
+        memcpy(p, &Bytes, 4);
+    }
+
+    static Float Set(float f) { return _mm_set1_ps(f); }
+    static Int   SetI(Int32 i) { return _mm_set1_epi32(i); }
+
+    static Float Add(Float a, Float b) { return _mm_add_ps(a, b); }
+    static Float Sub(Float a, Float b) { return _mm_sub_ps(a, b); }
+    static Float Mul(Float a, Float b) { return _mm_mul_ps(a, b); }
+    static Float Min(Float a, Float b) { return _mm_min_ps(a, b); }
+    static Float Max(Float a, Float b) { return _mm_max_ps(a, b); }
+
+    static Mask  LessEqual(Float a, Float b) { return _mm_cmple_ps(a, b); }
+    static Float Select(Mask m, Float a, Float b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+
+    static Int   AsInt(Float f) { return _mm_castps_si128(f); }
+    static Float AsFloat(Int i) { return _mm_castsi128_ps(i); }
+
+    static Int IAdd(Int a, Int b) { return _mm_add_epi32(a, b); }
+    static Int ISub(Int a, Int b) { return _mm_sub_epi32(a, b); }
+    static Int IAnd(Int a, Int b) { return _mm_and_si128(a, b); }
+
+    template <int N> static Int ShiftRight(Int a) { return _mm_srai_epi32(a, N); }
+    template <int N> static Int ShiftLeft(Int a) { return _mm_slli_epi32(a, N); }
+
+    static Float ToFloat(Int i) { return _mm_cvtepi32_ps(i); }
+    static Int   Truncate(Float f) { return _mm_cvttps_epi32(f); }
+};
+
+#    elif CC_USE_NEON
+
+struct SIMDOps
+{
+    static constexpr size_t Width = 4;
+
+    using Float = float32x4_t;
+    using Int   = int32x4_t;
+    using Mask  = uint32x4_t;
+
+    static Float Load(const float* p) { return vld1q_f32(p); }
+    static void  Store(float* p, Float v) { vst1q_f32(p, v); }
+    static void  StoreU8(Uint8* p, Int v)
+    {
+        const auto Words = vmovn_s32(v);
+        const auto Bytes = vqmovun_s16(vcombine_s16(Words, Words));
+        Uint8      Tmp[8];
+        vst1_u8(Tmp, Bytes);
+        memcpy(p, Tmp, 4);
+    }
+
+    static Float Set(float f) { return vdupq_n_f32(f); }
+    static Int   SetI(Int32 i) { return vdupq_n_s32(i); }
+
+    static Float Add(Float a, Float b) { return vaddq_f32(a, b); }
+    static Float Sub(Float a, Float b) { return vsubq_f32(a, b); }
+    static Float Mul(Float a, Float b) { return vmulq_f32(a, b); }
+    // vminq_f32/vmaxq_f32 propagate NaNs; use SSE semantics instead
+    static Float Min(Float a, Float b) { return vbslq_f32(vcltq_f32(a, b), a, b); }
+    static Float Max(Float a, Float b) { return vbslq_f32(vcgtq_f32(a, b), a, b); }
+
+    static Mask  LessEqual(Float a, Float b) { return vcleq_f32(a, b); }
+    static Float Select(Mask m, Float a, Float b) { return vbslq_f32(m, a, b); }
+
+    static Int   AsInt(Float f) { return vreinterpretq_s32_f32(f); }
+    static Float AsFloat(Int i) { return vreinterpretq_f32_s32(i); }
+
+    static Int IAdd(Int a, Int b) { return vaddq_s32(a, b); }
+    static Int ISub(Int a, Int b) { return vsubq_s32(a, b); }
+    static Int IAnd(Int a, Int b) { return vandq_s32(a, b); }
+
+    template <int N> static Int ShiftRight(Int a) { return vshrq_n_s32(a, N); }
+    template <int N> static Int ShiftLeft(Int a) { return vshlq_n_s32(a, N); }
+
+    static Float ToFloat(Int i) { return vcvtq_f32_s32(i); }
+    static Int   Truncate(Float f) { return vcvtq_s32_f32(f); }
+};
+
+#    endif
+
+// log2(x) for positive normal x.
+// The exponent is offset so that the mantissa falls into [sqrt(0.5), sqrt(2)), where log2(1 + u)
+// is approximated by u * P(u). P is a degree 7 polynomial with the absolute error below 1e-7.
+template <typename Ops>
+typename Ops::Float Log2(typename Ops::Float x)
+{
+    const auto Bits = Ops::ISub(Ops::AsInt(x), Ops::SetI(0x3F3504F3)); // 0x3F3504F3 = sqrt(0.5)
+    const auto Exp  = Ops::template ShiftRight<23>(Bits);
+    const auto M    = Ops::AsFloat(Ops::IAdd(Ops::IAnd(Bits, Ops::SetI(0x007FFFFF)), Ops::SetI(0x3F3504F3)));
+    const auto u    = Ops::Sub(M, Ops::Set(1.f));
+
+    auto P = Ops::Set(-0.14275974f);
+    P      = Ops::Add(Ops::Mul(P, u), Ops::Set(0.23265257f));
+    P      = Ops::Add(Ops::Mul(P, u), Ops::Set(-0.24927182f));
+    P      = Ops::Add(Ops::Mul(P, u), Ops::Set(0.28728887f));
+    P      = Ops::Add(Ops::Mul(P, u), Ops::Set(-0.36022517f));
+    P      = Ops::Add(Ops::Mul(P, u), Ops::Set(0.48091671f));
+    P      = Ops::Add(Ops::Mul(P, u), Ops::Set(-0.72135293f));
+    P      = Ops::Add(Ops::Mul(P, u), Ops::Set(1.44269502f));
+    return Ops::Add(Ops::ToFloat(Exp), Ops::Mul(u, P));
+}
+
+// 2^y. The argument is split into an integer n and a fraction f in [-0.5, 0.5],
+// and 2^f is approximated by a degree 5 polynomial with the relative error below 2e-7.
+template <typename Ops>
+typename Ops::Float Exp2(typename Ops::Float y)
+{
+    // Keep the result in the range of normal numbers. Also maps NaN to -126.
+    y = Ops::Min(Ops::Max(y, Ops::Set(-126.f)), Ops::Set(127.f));
+
+    // floor(y + 0.5)
+    const auto t = Ops::Add(y, Ops::Set(0.5f));
+    auto       n = Ops::ToFloat(Ops::Truncate(t));
+    n            = Ops::Select(Ops::LessEqual(n, t), n, Ops::Sub(n, Ops::Set(1.f)));
+
+    const auto f = Ops::Sub(y, n);
+
+    auto P = Ops::Set(0.0013390863f);
+    P      = Ops::Add(Ops::Mul(P, f), Ops::Set(0.0096760318f));
+    P      = Ops::Add(Ops::Mul(P, f), Ops::Set(0.055503570f));
+    P      = Ops::Add(Ops::Mul(P, f), Ops::Set(0.24022107f));
+    P      = Ops::Add(Ops::Mul(P, f), Ops::Set(0.69314718f));
+    P      = Ops::Add(Ops::Mul(P, f), Ops::Set(1.0000001f));
+
+    const auto Scale = Ops::AsFloat(Ops::template ShiftLeft<23>(Ops::IAdd(Ops::Truncate(n), Ops::SetI(127))));
+    return Ops::Mul(P, Scale);
+}
+
+struct LinearToSRGBKernel
+{
+    template <typename Ops>
+    static typename Ops::Float Run(typename Ops::Float x)
+    {
+        const auto Pow   = Exp2<Ops>(Ops::Mul(Log2<Ops>(x), Ops::Set(1.f / 2.4f)));
+        const auto Curve = Ops::Sub(Ops::Mul(Pow, Ops::Set(1.055f)), Ops::Set(0.055f));
+        return Ops::Select(Ops::LessEqual(x, Ops::Set(0.0031308f)), Ops::Mul(x, Ops::Set(12.92f)), Curve);
+    }
+};
+
+struct SRGBToLinearKernel
+{
+    template <typename Ops>
+    static typename Ops::Float Run(typename Ops::Float x)
+    {
+        const auto Base  = Ops::Mul(Ops::Add(x, Ops::Set(0.055f)), Ops::Set(1.f / 1.055f));
+        const auto Curve = Exp2<Ops>(Ops::Mul(Log2<Ops>(Base), Ops::Set(2.4f)));
+        return Ops::Select(Ops::LessEqual(x, Ops::Set(0.04045f)), Ops::Mul(x, Ops::Set(1.f / 12.92f)), Curve);
+    }
+};
+
+template <typename KernelType>
+void ConvertFloatSpan(const float* pSrc, float* pDst, size_t Count)
+{
+    constexpr size_t Width = SIMDOps::Width;
+
+    size_t i = 0;
+    for (; i + Width <= Count; i += Width)
+        SIMDOps::Store(pDst + i, KernelType::template Run<SIMDOps>(SIMDOps::Load(pSrc + i)));
+
+    if (i < Count)
+    {
+        // Process the tail through a padded copy so that it takes the same code path
+        float Tmp[Width] = {};
+        memcpy(Tmp, pSrc + i, (Count - i) * sizeof(float));
+        SIMDOps::Store(Tmp, KernelType::template Run<SIMDOps>(SIMDOps::Load(Tmp)));
+        memcpy(pDst + i, Tmp, (Count - i) * sizeof(float));
+    }
+}
+
+template <typename Ops>
+typename Ops::Int LinearToSRGB8(typename Ops::Float x)
+{
+    x            = Ops::Min(Ops::Max(x, Ops::Set(0.f)), Ops::Set(1.f));
+    const auto s = LinearToSRGBKernel::Run<Ops>(x);
+    return Ops::Truncate(Ops::Add(Ops::Mul(s, Ops::Set(255.f)), Ops::Set(0.5f)));
+}
+
+#endif // CC_USE_SIMD
+
 } // namespace
 
 float LinearToSRGB(Uint8 x)
@@ -85,8 +353,70 @@ float LinearToSRGB(Uint8 x)
 
 float SRGBToLinear(Uint8 x)
 {
-    static const SRGBToLinearMap map;
-    return map[x];
+    return GetSRGBToLinearMap()[x];
+}
+
+void LinearToSRGB(const float* pLinear, float* pSRGB, size_t Count)
+{
+#if CC_USE_SIMD
+    ConvertFloatSpan<LinearToSRGBKernel>(pLinear, pSRGB, Count);
+#else
+    for (size_t i = 0; i < Count; ++i)
+        pSRGB[i] = LinearToSRGB(pLinear[i]);
+#endif
+}
+
+void SRGBToLinear(const float* pSRGB, float* pLinear, size_t Count)
+{
+#if CC_USE_SIMD
+    ConvertFloatSpan<SRGBToLinearKernel>(pSRGB, pLinear, Count);
+#else
+    for (size_t i = 0; i < Count; ++i)
+        pLinear[i] = SRGBToLinear(pSRGB[i]);
+#endif
+}
+
+void LinearToSRGB(const float* pLinear, Uint8* pSRGB, size_t Count)
+{
+    size_t i = 0;
+#if CC_USE_SIMD
+    constexpr size_t Width = SIMDOps::Width;
+    for (; i + Width <= Count; i += Width)
+        SIMDOps::StoreU8(pSRGB + i, LinearToSRGB8<SIMDOps>(SIMDOps::Load(pLinear + i)));
+
+    if (i < Count)
+    {
+        float Tmp[Width] = {};
+        memcpy(Tmp, pLinear + i, (Count - i) * sizeof(float));
+        Uint8 Bytes[Width];
+        SIMDOps::StoreU8(Bytes, LinearToSRGB8<SIMDOps>(SIMDOps::Load(Tmp)));
+        memcpy(pSRGB + i, Bytes, Count - i);
+    }
+#else
+    for (; i < Count; ++i)
+    {
+        // Comparisons map NaN to zero
+        auto x   = pLinear[i] > 0.f ? pLinear[i] : 0.f;
+        x        = x < 1.f ? x : 1.f;
+        pSRGB[i] = static_cast<Uint8>(LinearToSRGB(x) * 255.f + 0.5f);
+    }
+#endif
+}
+
+void SRGBToLinear(const Uint8* pSRGB, float* pLinear, size_t Count)
+{
+    const auto* const pLUT = GetSRGBToLinearMap().data();
+
+    size_t i = 0;
+#if CC_USE_AVX2
+    for (; i + 8 <= Count; i += 8)
+    {
+        const auto Idx = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(pSRGB + i)));
+        _mm256_storeu_ps(pLinear + i, _mm256_i32gather_ps(pLUT, Idx, 4));
+    }
+#endif
+    for (; i < Count; ++i)
+        pLinear[i] = pLUT[pSRGB[i]];
 }
 
 } // namespace Diligent
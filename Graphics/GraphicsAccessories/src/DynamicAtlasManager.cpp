@@ -28,6 +28,8 @@
 #include "DynamicAtlasManager.hpp"
 
 #include <climits>
+#include <algorithm>
+#include <numeric>
 
 #include "AdvancedMath.hpp"
 
@@ -36,6 +38,134 @@ namespace Diligent
 
 static const DynamicAtlasManager::Region InvalidRegion{UINT_MAX, UINT_MAX, 0, 0};
 
+namespace
+{
+
+using Region = DynamicAtlasManager::Region;
+
+bool RegionsOverlap(const Region& R0, const Region& R1)
+{
+    // clang-format off
+    return R0.x < R1.x + R1.width  && R1.x < R0.x + R0.width &&
+           R0.y < R1.y + R1.height && R1.y < R0.y + R0.height;
+    // clang-format on
+}
+
+// Returns true if the regions overlap or share a part of their boundary
+bool RegionsTouch(const Region& R0, const Region& R1)
+{
+    // clang-format off
+    return R0.x <= R1.x + R1.width  && R1.x <= R0.x + R0.width &&
+           R0.y <= R1.y + R1.height && R1.y <= R0.y + R0.height;
+    // clang-format on
+}
+
+bool RegionContains(const Region& Outer, const Region& Inner)
+{
+    // clang-format off
+    return Inner.x >= Outer.x && Inner.x + Inner.width  <= Outer.x + Outer.width &&
+           Inner.y >= Outer.y && Inner.y + Inner.height <= Outer.y + Outer.height;
+    // clang-format on
+}
+
+// Splits the free rectangle FreeR that overlaps the region R into up to four
+// maximal rectangles that surround the region:
+//    ___________________
+//   |      |  T  |      |
+//   |      |_____|      |
+//   |  L   |  R  |  Rt  |
+//   |      |_____|      |
+//   |      |  B  |      |
+//   |______|_____|______|
+//
+// L and Rt span the entire height of the free rectangle, T and B span its entire width.
+void SplitFreeRect(const Region& FreeR, const Region& R, std::vector<Region>& SplitRects)
+{
+    VERIFY_EXPR(RegionsOverlap(FreeR, R));
+
+    // clang-format off
+    if (R.x > FreeR.x)
+        SplitRects.emplace_back(FreeR.x, FreeR.y, R.x - FreeR.x, FreeR.height); // L
+    if (R.x + R.width < FreeR.x + FreeR.width)
+        SplitRects.emplace_back(R.x + R.width, FreeR.y, FreeR.x + FreeR.width - (R.x + R.width), FreeR.height); // Rt
+    if (R.y > FreeR.y)
+        SplitRects.emplace_back(FreeR.x, FreeR.y, FreeR.width, R.y - FreeR.y); // B
+    if (R.y + R.height < FreeR.y + FreeR.height)
+        SplitRects.emplace_back(FreeR.x, R.y + R.height, FreeR.width, FreeR.y + FreeR.height - (R.y + R.height)); // T
+    // clang-format on
+}
+
+// Adds the rectangles produced by SplitFreeRect() to the free rectangle list, skipping the ones
+// that are contained in any other rectangle.
+// No free rectangle is contained in another one, so only the new rectangles need to be tested:
+// none of the existing rectangles can be contained in a new one as every new rectangle is a part
+// of a rectangle that has just been removed.
+void AddSplitRects(std::vector<Region>& FreeRects, const std::vector<Region>& SplitRects)
+{
+    const auto NumOldRects = FreeRects.size();
+    for (size_t i = 0; i < SplitRects.size(); ++i)
+    {
+        const auto& NewR = SplitRects[i];
+
+        bool IsRedundant = false;
+        for (size_t j = 0; j < NumOldRects && !IsRedundant; ++j)
+            IsRedundant = RegionContains(FreeRects[j], NewR);
+
+        for (size_t j = 0; j < SplitRects.size() && !IsRedundant; ++j)
+        {
+            // Of two identical rectangles, only keep the first one
+            if (j != i && RegionContains(SplitRects[j], NewR))
+                IsRedundant = SplitRects[j] != NewR || j < i;
+        }
+
+        if (!IsRedundant)
+            FreeRects.push_back(NewR);
+    }
+}
+
+// Subtracts the region R from every rectangle in the list. Unlike SplitFreeRect(),
+// the pieces the rectangle is split into do not overlap:
+//    ___________________
+//   |      |  T  |      |
+//   |      |_____|      |
+//   |  L   |  R  |  Rt  |
+//   |      |_____|      |
+//   |      |  B  |      |
+//   |______|_____|______|
+//
+// L and Rt span the entire height of the rectangle, T and B only span the width of R.
+void SubtractRegion(std::vector<Region>& Rects, const Region& R)
+{
+    for (size_t i = 0; i < Rects.size();)
+    {
+        const auto Rect = Rects[i];
+        if (!RegionsOverlap(Rect, R))
+        {
+            ++i;
+            continue;
+        }
+
+        // The pieces added at the end of the list do not overlap R
+        Rects[i] = Rects.back();
+        Rects.pop_back();
+
+        const auto x0 = std::max(Rect.x, R.x);
+        const auto x1 = std::min(Rect.x + Rect.width, R.x + R.width);
+        // clang-format off
+        if (R.x > Rect.x)
+            Rects.emplace_back(Rect.x, Rect.y, R.x - Rect.x, Rect.height); // L
+        if (R.x + R.width < Rect.x + Rect.width)
+            Rects.emplace_back(R.x + R.width, Rect.y, Rect.x + Rect.width - (R.x + R.width), Rect.height); // Rt
+        if (R.y > Rect.y)
+            Rects.emplace_back(x0, Rect.y, x1 - x0, R.y - Rect.y); // B
+        if (R.y + R.height < Rect.y + Rect.height)
+            Rects.emplace_back(x0, R.y + R.height, x1 - x0, Rect.y + Rect.height - (R.y + R.height)); // T
+        // clang-format on
+    }
+}
+
+} // namespace
+
 #if DILIGENT_DEBUG
 void DynamicAtlasManager::Node::Validate() const
 {
@@ -110,18 +240,34 @@ void DynamicAtlasManager::Node::MergeChildren()
 }
 
 
-DynamicAtlasManager::DynamicAtlasManager(Uint32 Width, Uint32 Height) :
+DynamicAtlasManager::DynamicAtlasManager(Uint32 Width, Uint32 Height, PackingAlgorithm Algorithm) :
     m_Width{Width},
-    m_Height{Height}
+    m_Height{Height},
+    m_Algorithm{Algorithm}
 {
-    m_Root->R = Region{0, 0, Width, Height};
-    RegisterNode(*m_Root);
+    if (m_Algorithm == PackingAlgorithm::MaxRects)
+    {
+        m_FreeRects.emplace_back(0, 0, Width, Height);
+    }
+    else
+    {
+        VERIFY(m_Algorithm == PackingAlgorithm::Tree, "Unexpected packing algorithm");
+        m_Root.reset(new Node);
+        m_Root->R = Region{0, 0, Width, Height};
+        RegisterNode(*m_Root);
+    }
 }
 
 
 DynamicAtlasManager::~DynamicAtlasManager()
 {
-    if (m_Root)
+    if (m_Algorithm == PackingAlgorithm::MaxRects)
+    {
+        DEV_CHECK_ERR(m_AllocatedRegions.empty(), "There must be no allocated regions");
+        // The list is empty if the object has been moved from
+        VERIFY(m_FreeRects.size() <= 1, "There expected to be a single free region");
+    }
+    else if (m_Root)
     {
 #if DILIGENT_DEBUG
         DbgVerifyConsistency();
@@ -182,6 +328,62 @@ void DynamicAtlasManager::UnregisterNode(const Node& N)
 
 
 DynamicAtlasManager::Region DynamicAtlasManager::Allocate(Uint32 Width, Uint32 Height)
+{
+    auto R = m_Algorithm == PackingAlgorithm::MaxRects ?
+        AllocateMaxRects(Width, Height) :
+        AllocateTree(Width, Height);
+
+    if (!R.IsEmpty())
+        m_AllocatedArea += Uint64{R.width} * Uint64{R.height};
+
+    return R;
+}
+
+
+Uint32 DynamicAtlasManager::Allocate(Uint32 NumRegions, Region* pRegions)
+{
+    if (NumRegions == 0)
+        return 0;
+
+    DEV_CHECK_ERR(pRegions != nullptr, "pRegions must not be null");
+
+    // Place large regions first: small regions will then fill the gaps left between them.
+    std::vector<Uint32> Order(NumRegions);
+    std::iota(Order.begin(), Order.end(), 0u);
+    std::sort(Order.begin(), Order.end(),
+              [pRegions](Uint32 i0, Uint32 i1) //
+              {
+                  const auto& R0 = pRegions[i0];
+                  const auto& R1 = pRegions[i1];
+
+                  const auto MaxSide0 = std::max(R0.width, R0.height);
+                  const auto MaxSide1 = std::max(R1.width, R1.height);
+                  if (MaxSide0 != MaxSide1)
+                      return MaxSide0 > MaxSide1;
+
+                  const auto MinSide0 = std::min(R0.width, R0.height);
+                  const auto MinSide1 = std::min(R1.width, R1.height);
+                  if (MinSide0 != MinSide1)
+                      return MinSide0 > MinSide1;
+
+                  // Keep the sort deterministic
+                  return i0 < i1;
+              });
+
+    Uint32 NumAllocated = 0;
+    for (auto i : Order)
+    {
+        auto& R = pRegions[i];
+        R       = !R.IsEmpty() ? Allocate(R.width, R.height) : Region{};
+        if (!R.IsEmpty())
+            ++NumAllocated;
+    }
+
+    return NumAllocated;
+}
+
+
+DynamicAtlasManager::Region DynamicAtlasManager::AllocateTree(Uint32 Width, Uint32 Height)
 {
     auto it_w = m_FreeRegionsByWidth.lower_bound(Region{0, 0, Width, 0});
     while (it_w != m_FreeRegionsByWidth.end() && it_w->first.height < Height)
@@ -336,8 +538,27 @@ void DynamicAtlasManager::Free(Region&& R)
         return;
     }
 
-    VERIFY_EXPR(node_it->first == R && node_it->second->R == R);
-    auto* N = node_it->second;
+    VERIFY_EXPR(m_AllocatedArea >= Uint64{R.width} * Uint64{R.height});
+    m_AllocatedArea -= Uint64{R.width} * Uint64{R.height};
+
+    if (m_Algorithm == PackingAlgorithm::MaxRects)
+    {
+        VERIFY_EXPR(node_it->second == nullptr);
+        m_AllocatedRegions.erase(node_it);
+        FreeMaxRects(R);
+    }
+    else
+    {
+        VERIFY_EXPR(node_it->first == R && node_it->second->R == R);
+        FreeTree(node_it->second);
+    }
+
+    R = InvalidRegion;
+}
+
+
+void DynamicAtlasManager::FreeTree(Node* N)
+{
     VERIFY_EXPR(N->IsAllocated && !N->HasChildren());
     UnregisterNode(*N);
     N->IsAllocated = false;
@@ -359,8 +580,205 @@ void DynamicAtlasManager::Free(Region&& R)
 #if DILIGENT_DEBUG
     DbgVerifyConsistency();
 #endif
+}
 
-    R = InvalidRegion;
+
+DynamicAtlasManager::Region DynamicAtlasManager::AllocateMaxRects(Uint32 Width, Uint32 Height)
+{
+    VERIFY_EXPR(Width > 0 && Height > 0);
+
+    // Find the free rectangle that leaves the shortest leftover side (best short side fit)
+    const Region* pBestRect = nullptr;
+
+    Uint32 BestShortSide = UINT_MAX;
+    Uint32 BestLongSide  = UINT_MAX;
+    for (const auto& FreeR : m_FreeRects)
+    {
+        if (FreeR.width < Width || FreeR.height < Height)
+            continue;
+
+        const auto LeftoverX = FreeR.width - Width;
+        const auto LeftoverY = FreeR.height - Height;
+        const auto ShortSide = std::min(LeftoverX, LeftoverY);
+        const auto LongSide  = std::max(LeftoverX, LeftoverY);
+        if (ShortSide < BestShortSide || (ShortSide == BestShortSide && LongSide < BestLongSide))
+        {
+            pBestRect     = &FreeR;
+            BestShortSide = ShortSide;
+            BestLongSide  = LongSide;
+        }
+    }
+
+    if (pBestRect == nullptr)
+        return Region{};
+
+    const Region R{pBestRect->x, pBestRect->y, Width, Height};
+
+    // Split every free rectangle that overlaps the new region into up to four
+    // maximal rectangles that surround the region
+    m_SplitRects.clear();
+    for (size_t i = 0; i < m_FreeRects.size();)
+    {
+        const auto FreeR = m_FreeRects[i];
+        if (!RegionsOverlap(FreeR, R))
+        {
+            ++i;
+            continue;
+        }
+
+        m_FreeRects[i] = m_FreeRects.back();
+        m_FreeRects.pop_back();
+
+        SplitFreeRect(FreeR, R, m_SplitRects);
+    }
+    AddSplitRects(m_FreeRects, m_SplitRects);
+
+    m_AllocatedRegions.emplace(R, nullptr);
+
+#if DILIGENT_DEBUG
+    DbgVerifyRegion(R);
+    for (const auto& FreeR : m_FreeRects)
+    {
+        DbgVerifyRegion(FreeR);
+        VERIFY(!RegionsOverlap(FreeR, R), "Free region overlaps the allocated region");
+    }
+#endif
+
+    return R;
+}
+
+
+void DynamicAtlasManager::FreeMaxRects(const Region& R)
+{
+    if (m_AllocatedRegions.empty())
+    {
+        // The entire atlas is free again: drop all fragmented free space at once
+        m_FreeRects.clear();
+        m_FreeRects.emplace_back(0, 0, m_Width, m_Height);
+        return;
+    }
+
+    // Maximal free rectangles that do not intersect the released region remain maximal, unless they
+    // are contained in a new one. Every new maximal rectangle intersects the released region, and
+    // the parts of it that lie outside of the region belong to free rectangles adjacent to the region.
+    // Thus the new rectangles are contained in the bounding box of the region and these free
+    // rectangles, and only the space in this window needs to be considered.
+    auto x0 = R.x;
+    auto y0 = R.y;
+    auto x1 = R.x + R.width;
+    auto y1 = R.y + R.height;
+    for (const auto& FreeR : m_FreeRects)
+    {
+        if (!RegionsTouch(FreeR, R))
+            continue;
+        x0 = std::min(x0, FreeR.x);
+        y0 = std::min(y0, FreeR.y);
+        x1 = std::max(x1, FreeR.x + FreeR.width);
+        y1 = std::max(y1, FreeR.y + FreeR.height);
+    }
+    const Region Window{x0, y0, x1 - x0, y1 - y0};
+
+    // Find the allocated space in the window by subtracting the free space from it
+    m_OccupiedRects.clear();
+    m_OccupiedRects.emplace_back(Window);
+    SubtractRegion(m_OccupiedRects, R);
+    for (const auto& FreeR : m_FreeRects)
+    {
+        if (RegionsOverlap(FreeR, Window))
+            SubtractRegion(m_OccupiedRects, FreeR);
+    }
+
+    // Split the window against the allocated space the same way allocation does, and only keep
+    // the rectangles that intersect the released region.
+    m_ReleasedRects.clear();
+    m_ReleasedRects.emplace_back(Window);
+    for (const auto& OccupiedR : m_OccupiedRects)
+    {
+        m_SplitRects.clear();
+        for (size_t i = 0; i < m_ReleasedRects.size();)
+        {
+            const auto FreeR = m_ReleasedRects[i];
+            if (!RegionsOverlap(FreeR, OccupiedR))
+            {
+                ++i;
+                continue;
+            }
+
+            m_ReleasedRects[i] = m_ReleasedRects.back();
+            m_ReleasedRects.pop_back();
+
+            SplitFreeRect(FreeR, OccupiedR, m_SplitRects);
+        }
+        m_SplitRects.erase(std::remove_if(m_SplitRects.begin(), m_SplitRects.end(),
+                                          [&R](const Region& SplitR) { return !RegionsOverlap(SplitR, R); }),
+                           m_SplitRects.end());
+        AddSplitRects(m_ReleasedRects, m_SplitRects);
+    }
+    VERIFY(!m_ReleasedRects.empty(), "The released region must be covered by at least one free rectangle");
+
+    // Remove the free rectangles that are now contained in the new ones. None of the new
+    // rectangles can be contained in an existing one as existing rectangles do not intersect
+    // the released region.
+    for (size_t i = 0; i < m_FreeRects.size();)
+    {
+        const auto& FreeR = m_FreeRects[i];
+
+        bool IsContained = false;
+        for (size_t j = 0; j < m_ReleasedRects.size() && !IsContained; ++j)
+            IsContained = RegionContains(m_ReleasedRects[j], FreeR);
+
+        if (IsContained)
+        {
+            m_FreeRects[i] = m_FreeRects.back();
+            m_FreeRects.pop_back();
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+#if DILIGENT_DEBUG
+    for (const auto& NewR : m_ReleasedRects)
+    {
+        DbgVerifyRegion(NewR);
+        VERIFY(RegionsOverlap(NewR, R), "New free rectangle does not intersect the released region");
+    }
+#endif
+
+    m_FreeRects.insert(m_FreeRects.end(), m_ReleasedRects.begin(), m_ReleasedRects.end());
+}
+
+
+DynamicAtlasManager::Statistics DynamicAtlasManager::GetStatistics() const
+{
+    Statistics Stats;
+
+    Stats.NumAllocations = static_cast<Uint32>(m_AllocatedRegions.size());
+    Stats.NumFreeRegions = GetFreeRegionCount();
+    Stats.AllocatedArea  = m_AllocatedArea;
+
+    const auto TotalArea = Uint64{m_Width} * Uint64{m_Height};
+    VERIFY_EXPR(TotalArea >= m_AllocatedArea);
+    Stats.FreeArea = TotalArea - m_AllocatedArea;
+
+    if (m_Algorithm == PackingAlgorithm::MaxRects)
+    {
+        for (const auto& FreeR : m_FreeRects)
+            Stats.LargestFreeRegionArea = std::max(Stats.LargestFreeRegionArea, Uint64{FreeR.width} * Uint64{FreeR.height});
+    }
+    else
+    {
+        for (const auto& it : m_FreeRegionsByWidth)
+            Stats.LargestFreeRegionArea = std::max(Stats.LargestFreeRegionArea, Uint64{it.first.width} * Uint64{it.first.height});
+    }
+
+    if (TotalArea > 0)
+        Stats.Occupancy = static_cast<float>(static_cast<double>(Stats.AllocatedArea) / static_cast<double>(TotalArea));
+    if (Stats.FreeArea > 0)
+        Stats.Fragmentation = 1.f - static_cast<float>(static_cast<double>(Stats.LargestFreeRegionArea) / static_cast<double>(Stats.FreeArea));
+
+    return Stats;
 }
 
 
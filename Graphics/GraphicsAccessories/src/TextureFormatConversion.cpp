@@ -0,0 +1,1105 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#include "TextureFormatConversion.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define TFC_USE_SSE2 1
+#endif
+
+#include "ColorConversion.h"
+#include "GraphicsAccessories.hpp"
+#include "ThreadPool.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+inline Uint32 FloatAsUint(float f)
+{
+    Uint32 u;
+    memcpy(&u, &f, sizeof(u));
+    return u;
+}
+
+inline float UintAsFloat(Uint32 u)
+{
+    float f;
+    memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+} // namespace
+
+// The conversions below follow the branchless algorithms described by F. Giesen in
+// "Half to float done quic" and "float->half variants" and are exact for all inputs.
+float HalfToFloat(Uint16 Half)
+{
+    static constexpr Uint32 ShiftedExp = 0x7C00u << 13; // exponent mask after shift
+
+    Uint32       Bits = (Half & 0x7FFFu) << 13; // exponent/mantissa bits
+    const Uint32 Exp  = ShiftedExp & Bits;      // just the exponent
+    Bits += (127 - 15) << 23;                   // exponent adjust
+
+    if (Exp == ShiftedExp)
+    {
+        // Inf/NaN: extra exponent adjust
+        Bits += (128 - 16) << 23;
+    }
+    else if (Exp == 0)
+    {
+        // Zero/denormal: extra exponent adjust and renormalize
+        Bits += 1 << 23;
+        Bits = FloatAsUint(UintAsFloat(Bits) - UintAsFloat(113u << 23));
+    }
+
+    Bits |= (Half & 0x8000u) << 16; // sign bit
+    return UintAsFloat(Bits);
+}
+
+Uint16 FloatToHalf(float Value)
+{
+    static constexpr Uint32 F32Infinity = 255u << 23;
+    static constexpr Uint32 F16Max      = (127u + 16u) << 23;
+    static constexpr Uint32 DenormMagic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+    Uint32       Bits = FloatAsUint(Value);
+    const Uint32 Sign = Bits & 0x80000000u;
+    Bits ^= Sign;
+
+    Uint32 Half;
+    if (Bits >= F16Max)
+    {
+        // Inf or NaN (all exponent bits set): NaN -> qNaN and Inf -> Inf
+        Half = Bits > F32Infinity ? 0x7E00u : 0x7C00u;
+    }
+    else if (Bits < (113u << 23))
+    {
+        // The result is a denormal or zero: use a magic value to align the mantissa
+        // and let the FPU do round-to-nearest-even.
+        Half = FloatAsUint(UintAsFloat(Bits) + UintAsFloat(DenormMagic)) - DenormMagic;
+    }
+    else
+    {
+        const Uint32 MantOdd = (Bits >> 13) & 1u; // resulting mantissa is odd
+        // Update exponent, rounding bias part 1
+        Bits += (static_cast<Uint32>(15 - 127) << 23) + 0xFFFu;
+        // Rounding bias part 2
+        Bits += MantOdd;
+        Half = Bits >> 13;
+    }
+
+    return static_cast<Uint16>(Half | (Sign >> 16));
+}
+
+void HalfToFloat(const Uint16* pSrc, float* pDst, size_t Count)
+{
+    size_t i = 0;
+#if TFC_USE_SSE2
+    const __m128i MaskNoSign = _mm_set1_epi32(0x7FFF);
+    const __m128  Magic      = _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23));
+    const __m128i WasInfNan  = _mm_set1_epi32(0x7BFF);
+    const __m128  ExpInfNan  = _mm_castsi128_ps(_mm_set1_epi32(255 << 23));
+    const __m128i Zero       = _mm_setzero_si128();
+    for (; i + 4 <= Count; i += 4)
+    {
+        const __m128i Half     = _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(pSrc + i)), Zero);
+        const __m128i ExpMant  = _mm_and_si128(MaskNoSign, Half);
+        const __m128i JustSign = _mm_xor_si128(Half, ExpMant);
+        // Denormals are scaled by the FPU; Inf and NaN get their exponent fixed up below
+        const __m128  Scaled   = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(ExpMant, 13)), Magic);
+        const __m128i IsInfNan = _mm_cmpgt_epi32(ExpMant, WasInfNan);
+        const __m128  Sign     = _mm_castsi128_ps(_mm_slli_epi32(JustSign, 16));
+        const __m128  InfNanEx = _mm_and_ps(_mm_castsi128_ps(IsInfNan), ExpInfNan);
+        _mm_storeu_ps(pDst + i, _mm_or_ps(Scaled, _mm_or_ps(Sign, InfNanEx)));
+    }
+#endif
+    for (; i < Count; ++i)
+        pDst[i] = HalfToFloat(pSrc[i]);
+}
+
+void FloatToHalf(const float* pSrc, Uint16* pDst, size_t Count)
+{
+    size_t i = 0;
+#if TFC_USE_SSE2
+    const __m128i MaskSign      = _mm_set1_epi32(static_cast<int>(0x80000000u));
+    const __m128i F16Max        = _mm_set1_epi32((127 + 16) << 23);
+    const __m128i NanBit        = _mm_set1_epi32(0x200);
+    const __m128i InfinityAsF16 = _mm_set1_epi32(0x7C00);
+    const __m128i MinNormal     = _mm_set1_epi32((127 - 14) << 23);
+    const __m128i SubnormMagic  = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+    const __m128i NormalBias    = _mm_set1_epi32(0xFFF - ((127 - 15) << 23));
+    for (; i + 4 <= Count; i += 4)
+    {
+        const __m128  Value     = _mm_loadu_ps(pSrc + i);
+        const __m128  JustSign  = _mm_and_ps(_mm_castsi128_ps(MaskSign), Value);
+        const __m128  AbsValue  = _mm_xor_ps(Value, JustSign);
+        const __m128i AbsInt    = _mm_castps_si128(AbsValue);
+        const __m128  IsNan     = _mm_cmpunord_ps(AbsValue, AbsValue);
+        const __m128i IsRegular = _mm_cmpgt_epi32(F16Max, AbsInt);
+        const __m128i InfOrNan  = _mm_or_si128(_mm_and_si128(_mm_castps_si128(IsNan), NanBit), InfinityAsF16);
+        const __m128i IsSubnorm = _mm_cmpgt_epi32(MinNormal, AbsInt);
+
+        // Subnormal results: let the FPU round the mantissa
+        const __m128  Subnorm1 = _mm_add_ps(AbsValue, _mm_castsi128_ps(SubnormMagic));
+        const __m128i Subnorm2 = _mm_sub_epi32(_mm_castps_si128(Subnorm1), SubnormMagic);
+
+        // Normal results: round to nearest even by biasing towards rounding up when the mantissa is odd
+        const __m128i MantOdd = _mm_srai_epi32(_mm_slli_epi32(AbsInt, 31 - 13), 31);
+        const __m128i Normal  = _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(AbsInt, NormalBias), MantOdd), 13);
+
+        const __m128i NonSpecial = _mm_or_si128(_mm_and_si128(Subnorm2, IsSubnorm), _mm_andnot_si128(IsSubnorm, Normal));
+        const __m128i Joined     = _mm_or_si128(_mm_and_si128(NonSpecial, IsRegular), _mm_andnot_si128(IsRegular, InfOrNan));
+        // Arithmetic shift sign-extends the results, so that signed saturation keeps the bits intact
+        const __m128i Half = _mm_or_si128(Joined, _mm_srai_epi32(_mm_castps_si128(JustSign), 16));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(pDst + i), _mm_packs_epi32(Half, Half));
+    }
+#endif
+    for (; i < Count; ++i)
+        pDst[i] = FloatToHalf(pSrc[i]);
+}
+
+
+namespace
+{
+
+enum class TexelLayout
+{
+    Unsupported,
+    Generic,
+    BGRA8,
+    BGRX8,
+    A8,
+    RGB10A2,
+    R11G11B10,
+    RGB9E5,
+    B5G6R5,
+    B5G5R5A1,
+    D32,
+    D16,
+    D24S8,
+    D32S8
+};
+
+TexelLayout GetTexelLayout(TEXTURE_FORMAT Format)
+{
+    switch (Format)
+    {
+        // clang-format off
+        case TEX_FORMAT_BGRA8_UNORM:
+        case TEX_FORMAT_BGRA8_UNORM_SRGB:        return TexelLayout::BGRA8;
+        case TEX_FORMAT_BGRX8_UNORM:
+        case TEX_FORMAT_BGRX8_UNORM_SRGB:        return TexelLayout::BGRX8;
+        case TEX_FORMAT_A8_UNORM:                return TexelLayout::A8;
+        case TEX_FORMAT_RGB10A2_UNORM:
+        case TEX_FORMAT_RGB10A2_UINT:            return TexelLayout::RGB10A2;
+        case TEX_FORMAT_R11G11B10_FLOAT:         return TexelLayout::R11G11B10;
+        case TEX_FORMAT_RGB9E5_SHAREDEXP:        return TexelLayout::RGB9E5;
+        case TEX_FORMAT_B5G6R5_UNORM:            return TexelLayout::B5G6R5;
+        case TEX_FORMAT_B5G5R5A1_UNORM:          return TexelLayout::B5G5R5A1;
+        case TEX_FORMAT_D32_FLOAT:               return TexelLayout::D32;
+        case TEX_FORMAT_D16_UNORM:               return TexelLayout::D16;
+        case TEX_FORMAT_D24_UNORM_S8_UINT:
+        case TEX_FORMAT_R24_UNORM_X8_TYPELESS:
+        case TEX_FORMAT_X24_TYPELESS_G8_UINT:    return TexelLayout::D24S8;
+        case TEX_FORMAT_D32_FLOAT_S8X24_UINT:
+        case TEX_FORMAT_R32_FLOAT_X8X24_TYPELESS:
+        case TEX_FORMAT_X32_TYPELESS_G8X24_UINT: return TexelLayout::D32S8;
+
+        case TEX_FORMAT_R1_UNORM:
+        case TEX_FORMAT_RG8_B8G8_UNORM:
+        case TEX_FORMAT_G8R8_G8B8_UNORM:         return TexelLayout::Unsupported;
+            // clang-format on
+
+        default:
+            break;
+    }
+
+    switch (GetTextureFormatAttribs(Format).ComponentType)
+    {
+        case COMPONENT_TYPE_UNORM:
+        case COMPONENT_TYPE_UNORM_SRGB:
+        case COMPONENT_TYPE_SNORM:
+        case COMPONENT_TYPE_UINT:
+        case COMPONENT_TYPE_SINT:
+        case COMPONENT_TYPE_FLOAT:
+            return TexelLayout::Generic;
+
+        default:
+            return TexelLayout::Unsupported;
+    }
+}
+
+inline bool IsBlockCompressed(TEXTURE_FORMAT Format)
+{
+    return GetTextureFormatAttribs(Format).ComponentType == COMPONENT_TYPE_COMPRESSED;
+}
+
+inline Uint32 GetTexelSize(TEXTURE_FORMAT Format)
+{
+    const auto& FmtAttribs = GetTextureFormatAttribs(Format);
+    return Uint32{FmtAttribs.ComponentSize} * (FmtAttribs.ComponentType != COMPONENT_TYPE_COMPOUND ? Uint32{FmtAttribs.NumComponents} : 1u);
+}
+
+// Clamps the value to [0, 1]. NaN is converted to 0.
+inline float Saturate(float x)
+{
+    return x > 0.f ? (x < 1.f ? x : 1.f) : 0.f;
+}
+
+inline Uint32 PackUNorm(float x, Uint32 MaxValue)
+{
+    return static_cast<Uint32>(Saturate(x) * static_cast<float>(MaxValue) + 0.5f);
+}
+
+inline Int32 PackSNorm(float x, Int32 MaxValue)
+{
+    x = x > -1.f ? (x < 1.f ? x : 1.f) : (x <= -1.f ? -1.f : 0.f);
+    x *= static_cast<float>(MaxValue);
+    return static_cast<Int32>(x >= 0.f ? x + 0.5f : x - 0.5f);
+}
+
+template <typename T>
+T PackInteger(float x)
+{
+    if (x != x)
+        return 0;
+
+    const double MinValue = static_cast<double>(std::numeric_limits<T>::min());
+    const double MaxValue = static_cast<double>(std::numeric_limits<T>::max());
+
+    double d = std::floor(static_cast<double>(x) + 0.5);
+    d        = std::max(std::min(d, MaxValue), MinValue);
+    return static_cast<T>(d);
+}
+
+// Unsigned float with a 5-bit exponent and no sign used by R11G11B10_FLOAT
+inline float UnpackUFloat(Uint32 Bits, Uint32 MantissaBits)
+{
+    // Same exponent bias as half-float, so the value maps directly to half-float bits
+    return HalfToFloat(static_cast<Uint16>(Bits << (10 - MantissaBits)));
+}
+
+Uint32 PackUFloat(float x, Uint32 MantissaBits)
+{
+    const Uint32 ExpMask  = 0x1Fu << MantissaBits;
+    const Uint32 MantMask = (1u << MantissaBits) - 1u;
+
+    if (x != x)
+        return ExpMask | MantMask;
+    if (x <= 0.f)
+        return 0;
+
+    const Uint32 Bits = FloatAsUint(x);
+    if (Bits >= 0x7F800000u)
+        return ExpMask; // +Inf
+
+    Uint32 Result;
+    if (Bits < (113u << 23))
+    {
+        // Denormal: the value is m / 2^MantissaBits * 2^-14. Rounding up to 2^MantissaBits
+        // produces the smallest normal value, which is also the correct encoding.
+        const float Scaled = x * static_cast<float>(1u << MantissaBits) * 16384.f;
+        Result             = static_cast<Uint32>(std::nearbyint(Scaled));
+    }
+    else
+    {
+        const Uint32 Shift = 23 - MantissaBits;
+        const Uint32 Exp   = ((Bits >> 23) & 0xFF) - 127 + 15;
+        const Uint32 Mant  = Bits & 0x7FFFFF;
+        Result             = (Exp << MantissaBits) | (Mant >> Shift);
+
+        // Round to nearest even
+        const Uint32 Rem  = Mant & ((1u << Shift) - 1u);
+        const Uint32 Half = 1u << (Shift - 1);
+        if (Rem > Half || (Rem == Half && (Result & 1u) != 0))
+            ++Result;
+    }
+
+    // Clamp to the largest finite value
+    return std::min(Result, (ExpMask - (1u << MantissaBits)) | MantMask);
+}
+
+void UnpackRGB9E5(Uint32 Bits, float* pRGBA)
+{
+    const float Scale = std::ldexp(1.f, static_cast<int>(Bits >> 27) - 15 - 9);
+
+    pRGBA[0] = static_cast<float>(Bits & 0x1FF) * Scale;
+    pRGBA[1] = static_cast<float>((Bits >> 9) & 0x1FF) * Scale;
+    pRGBA[2] = static_cast<float>((Bits >> 18) & 0x1FF) * Scale;
+    pRGBA[3] = 1.f;
+}
+
+// See GL_EXT_texture_shared_exponent
+Uint32 PackRGB9E5(const float* pRGBA)
+{
+    static constexpr float MaxValue = 65408.f; // (2^9 - 1) / 2^9 * 2^16
+
+    float RGB[3];
+    for (Uint32 c = 0; c < 3; ++c)
+    {
+        const float x = pRGBA[c];
+        RGB[c]        = x > 0.f ? (x < MaxValue ? x : MaxValue) : 0.f;
+    }
+
+    const float MaxRGB = std::max(std::max(RGB[0], RGB[1]), RGB[2]);
+    if (MaxRGB <= 0.f)
+        return 0;
+
+    int Exp = 0;
+    std::frexp(MaxRGB, &Exp); // MaxRGB = f * 2^Exp, f in [0.5, 1)
+    // floor(log2(MaxRGB)) = Exp - 1
+    int SharedExp = std::max(-16, Exp - 1) + 1 + 15;
+
+    float      Scale   = std::ldexp(1.f, 15 + 9 - SharedExp);
+    const auto MaxMant = static_cast<Uint32>(std::floor(MaxRGB * Scale + 0.5f));
+    if (MaxMant == 512)
+    {
+        ++SharedExp;
+        Scale *= 0.5f;
+    }
+
+    Uint32 Bits = static_cast<Uint32>(SharedExp) << 27;
+    for (Uint32 c = 0; c < 3; ++c)
+        Bits |= std::min(static_cast<Uint32>(std::floor(RGB[c] * Scale + 0.5f)), 511u) << (c * 9);
+    return Bits;
+}
+
+
+// Unpacks 8-bit UNORM RGBA or BGRA texels
+void UnpackRGBA8(const Uint8* pSrc, size_t NumTexels, bool SwapRB, float* pRGBA)
+{
+    static constexpr float Scale = 1.f / 255.f;
+
+    size_t t = 0;
+#if TFC_USE_SSE2
+    const __m128i Zero    = _mm_setzero_si128();
+    const __m128  Scale4  = _mm_set1_ps(Scale);
+    auto          Convert = [&](__m128i Dwords, float* pDst) {
+        __m128 Val = _mm_mul_ps(_mm_cvtepi32_ps(Dwords), Scale4);
+        if (SwapRB)
+            Val = _mm_shuffle_ps(Val, Val, _MM_SHUFFLE(3, 0, 1, 2));
+        _mm_storeu_ps(pDst, Val);
+    };
+    for (; t + 4 <= NumTexels; t += 4)
+    {
+        const __m128i Bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + t * 4));
+        const __m128i Lo    = _mm_unpacklo_epi8(Bytes, Zero);
+        const __m128i Hi    = _mm_unpackhi_epi8(Bytes, Zero);
+        Convert(_mm_unpacklo_epi16(Lo, Zero), pRGBA + t * 4 + 0);
+        Convert(_mm_unpackhi_epi16(Lo, Zero), pRGBA + t * 4 + 4);
+        Convert(_mm_unpacklo_epi16(Hi, Zero), pRGBA + t * 4 + 8);
+        Convert(_mm_unpackhi_epi16(Hi, Zero), pRGBA + t * 4 + 12);
+    }
+#endif
+    for (; t < NumTexels; ++t)
+    {
+        const Uint8* pTexel = pSrc + t * 4;
+        float*       pDst   = pRGBA + t * 4;
+
+        pDst[0] = static_cast<float>(pTexel[SwapRB ? 2 : 0]) * Scale;
+        pDst[1] = static_cast<float>(pTexel[1]) * Scale;
+        pDst[2] = static_cast<float>(pTexel[SwapRB ? 0 : 2]) * Scale;
+        pDst[3] = static_cast<float>(pTexel[3]) * Scale;
+    }
+}
+
+// Packs 8-bit UNORM RGBA or BGRA texels
+void PackRGBA8(const float* pRGBA, size_t NumTexels, bool SwapRB, Uint8* pDst)
+{
+    size_t t = 0;
+#if TFC_USE_SSE2
+    const __m128 Zero    = _mm_setzero_ps();
+    const __m128 One     = _mm_set1_ps(1.f);
+    const __m128 Scale   = _mm_set1_ps(255.f);
+    const __m128 Half    = _mm_set1_ps(0.5f);
+    auto         Convert = [&](const float* pSrc) {
+        __m128 Val = _mm_loadu_ps(pSrc);
+        if (SwapRB)
+            Val = _mm_shuffle_ps(Val, Val, _MM_SHUFFLE(3, 0, 1, 2));
+        // max(NaN, 0) returns 0, which matches Saturate()
+        Val = _mm_min_ps(_mm_max_ps(Val, Zero), One);
+        return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(Val, Scale), Half));
+    };
+    for (; t + 4 <= NumTexels; t += 4)
+    {
+        const float*  pSrc  = pRGBA + t * 4;
+        const __m128i Lo    = _mm_packs_epi32(Convert(pSrc + 0), Convert(pSrc + 4));
+        const __m128i Hi    = _mm_packs_epi32(Convert(pSrc + 8), Convert(pSrc + 12));
+        const __m128i Bytes = _mm_packus_epi16(Lo, Hi);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + t * 4), Bytes);
+    }
+#endif
+    for (; t < NumTexels; ++t)
+    {
+        const float* pSrc   = pRGBA + t * 4;
+        Uint8*       pTexel = pDst + t * 4;
+
+        pTexel[SwapRB ? 2 : 0] = static_cast<Uint8>(Saturate(pSrc[0]) * 255.f + 0.5f);
+        pTexel[1]              = static_cast<Uint8>(Saturate(pSrc[1]) * 255.f + 0.5f);
+        pTexel[SwapRB ? 0 : 2] = static_cast<Uint8>(Saturate(pSrc[2]) * 255.f + 0.5f);
+        pTexel[3]              = static_cast<Uint8>(Saturate(pSrc[3]) * 255.f + 0.5f);
+    }
+}
+
+template <typename T, typename ConvType>
+void UnpackComponents(const void* pSrc, Uint32 NumComponents, size_t NumTexels, float* pRGBA, ConvType Conv)
+{
+    const auto* pComp = static_cast<const T*>(pSrc);
+    for (size_t t = 0; t < NumTexels; ++t, pComp += NumComponents, pRGBA += 4)
+    {
+        for (Uint32 c = 0; c < 4; ++c)
+            pRGBA[c] = c < NumComponents ? Conv(pComp[c], c) : (c == 3 ? 1.f : 0.f);
+    }
+}
+
+template <typename T, typename ConvType>
+void PackComponents(const float* pRGBA, Uint32 NumComponents, size_t NumTexels, void* pDst, ConvType Conv)
+{
+    auto* pComp = static_cast<T*>(pDst);
+    for (size_t t = 0; t < NumTexels; ++t, pComp += NumComponents, pRGBA += 4)
+    {
+        for (Uint32 c = 0; c < NumComponents; ++c)
+            pComp[c] = Conv(pRGBA[c], c);
+    }
+}
+
+void UnpackGeneric(TEXTURE_FORMAT Format, const void* pSrc, size_t NumTexels, float* pRGBA)
+{
+    const auto&  FmtAttribs = GetTextureFormatAttribs(Format);
+    const Uint32 NumComps   = FmtAttribs.NumComponents;
+    switch (FmtAttribs.ComponentType)
+    {
+        case COMPONENT_TYPE_UNORM:
+            if (FmtAttribs.ComponentSize == 1)
+            {
+                if (NumComps == 4)
+                    UnpackRGBA8(static_cast<const Uint8*>(pSrc), NumTexels, false, pRGBA);
+                else
+                    UnpackComponents<Uint8>(pSrc, NumComps, NumTexels, pRGBA, [](Uint8 v, Uint32) { return static_cast<float>(v) * (1.f / 255.f); });
+            }
+            else
+            {
+                VERIFY_EXPR(FmtAttribs.ComponentSize == 2);
+                UnpackComponents<Uint16>(pSrc, NumComps, NumTexels, pRGBA, [](Uint16 v, Uint32) { return static_cast<float>(v) / 65535.f; });
+            }
+            break;
+
+        case COMPONENT_TYPE_UNORM_SRGB:
+            VERIFY_EXPR(FmtAttribs.ComponentSize == 1);
+            UnpackComponents<Uint8>(pSrc, NumComps, NumTexels, pRGBA, [](Uint8 v, Uint32 c) { return c < 3 ? SRGBToLinear(v) : static_cast<float>(v) * (1.f / 255.f); });
+            break;
+
+        case COMPONENT_TYPE_SNORM:
+            if (FmtAttribs.ComponentSize == 1)
+                UnpackComponents<Int8>(pSrc, NumComps, NumTexels, pRGBA, [](Int8 v, Uint32) { return std::max(static_cast<float>(v) / 127.f, -1.f); });
+            else
+                UnpackComponents<Int16>(pSrc, NumComps, NumTexels, pRGBA, [](Int16 v, Uint32) { return std::max(static_cast<float>(v) / 32767.f, -1.f); });
+            break;
+
+        case COMPONENT_TYPE_UINT:
+            // clang-format off
+            switch (FmtAttribs.ComponentSize)
+            {
+                case 1: UnpackComponents<Uint8> (pSrc, NumComps, NumTexels, pRGBA, [](Uint8  v, Uint32) { return static_cast<float>(v); }); break;
+                case 2: UnpackComponents<Uint16>(pSrc, NumComps, NumTexels, pRGBA, [](Uint16 v, Uint32) { return static_cast<float>(v); }); break;
+                case 4: UnpackComponents<Uint32>(pSrc, NumComps, NumTexels, pRGBA, [](Uint32 v, Uint32) { return static_cast<float>(v); }); break;
+            }
+            break;
+
+        case COMPONENT_TYPE_SINT:
+            switch (FmtAttribs.ComponentSize)
+            {
+                case 1: UnpackComponents<Int8> (pSrc, NumComps, NumTexels, pRGBA, [](Int8  v, Uint32) { return static_cast<float>(v); }); break;
+                case 2: UnpackComponents<Int16>(pSrc, NumComps, NumTexels, pRGBA, [](Int16 v, Uint32) { return static_cast<float>(v); }); break;
+                case 4: UnpackComponents<Int32>(pSrc, NumComps, NumTexels, pRGBA, [](Int32 v, Uint32) { return static_cast<float>(v); }); break;
+            }
+            break;
+            // clang-format on
+
+        case COMPONENT_TYPE_FLOAT:
+            if (FmtAttribs.ComponentSize == 2)
+            {
+                if (NumComps == 4)
+                    HalfToFloat(static_cast<const Uint16*>(pSrc), pRGBA, NumTexels * 4);
+                else
+                    UnpackComponents<Uint16>(pSrc, NumComps, NumTexels, pRGBA, [](Uint16 v, Uint32) { return HalfToFloat(v); });
+            }
+            else
+            {
+                VERIFY_EXPR(FmtAttribs.ComponentSize == 4);
+                if (NumComps == 4)
+                    memcpy(pRGBA, pSrc, NumTexels * 4 * sizeof(float));
+                else
+                    UnpackComponents<float>(pSrc, NumComps, NumTexels, pRGBA, [](float v, Uint32) { return v; });
+            }
+            break;
+
+        default:
+            UNEXPECTED("Unexpected component type");
+    }
+}
+
+void PackGeneric(TEXTURE_FORMAT Format, const float* pRGBA, size_t NumTexels, void* pDst)
+{
+    const auto&  FmtAttribs = GetTextureFormatAttribs(Format);
+    const Uint32 NumComps   = FmtAttribs.NumComponents;
+    switch (FmtAttribs.ComponentType)
+    {
+        case COMPONENT_TYPE_UNORM:
+            if (FmtAttribs.ComponentSize == 1)
+            {
+                if (NumComps == 4)
+                    PackRGBA8(pRGBA, NumTexels, false, static_cast<Uint8*>(pDst));
+                else
+                    PackComponents<Uint8>(pRGBA, NumComps, NumTexels, pDst, [](float v, Uint32) { return static_cast<Uint8>(PackUNorm(v, 255)); });
+            }
+            else
+            {
+                VERIFY_EXPR(FmtAttribs.ComponentSize == 2);
+                PackComponents<Uint16>(pRGBA, NumComps, NumTexels, pDst, [](float v, Uint32) { return static_cast<Uint16>(PackUNorm(v, 65535)); });
+            }
+            break;
+
+        case COMPONENT_TYPE_UNORM_SRGB:
+            VERIFY_EXPR(FmtAttribs.ComponentSize == 1);
+            PackComponents<Uint8>(pRGBA, NumComps, NumTexels, pDst, [](float v, Uint32 c) { return static_cast<Uint8>(PackUNorm(c < 3 ? LinearToSRGB(Saturate(v)) : v, 255)); });
+            break;
+
+        case COMPONENT_TYPE_SNORM:
+            if (FmtAttribs.ComponentSize == 1)
+                PackComponents<Int8>(pRGBA, NumComps, NumTexels, pDst, [](float v, Uint32) { return static_cast<Int8>(PackSNorm(v, 127)); });
+            else
+                PackComponents<Int16>(pRGBA, NumComps, NumTexels, pDst, [](float v, Uint32) { return static_cast<Int16>(PackSNorm(v, 32767)); });
+            break;
+
+        case COMPONENT_TYPE_UINT:
+            // clang-format off
+            switch (FmtAttribs.ComponentSize)
+            {
+                case 1: PackComponents<Uint8> (pRGBA, NumComps, NumTexels, pDst, [](float v, Uint32) { return PackInteger<Uint8> (v); }); break;
+                case 2: PackComponents<Uint16>(pRGBA, NumComps, NumTexels, pDst, [](float v, Uint32) { return PackInteger<Uint16>(v); }); break;
+                case 4: PackComponents<Uint32>(pRGBA, NumComps, NumTexels, pDst, [](float v, Uint32) { return PackInteger<Uint32>(v); }); break;
+            }
+            break;
+
+        case COMPONENT_TYPE_SINT:
+            switch (FmtAttribs.ComponentSize)
+            {
+                case 1: PackComponents<Int8> (pRGBA, NumComps, NumTexels, pDst, [](float v, Uint32) { return PackInteger<Int8> (v); }); break;
+                case 2: PackComponents<Int16>(pRGBA, NumComps, NumTexels, pDst, [](float v, Uint32) { return PackInteger<Int16>(v); }); break;
+                case 4: PackComponents<Int32>(pRGBA, NumComps, NumTexels, pDst, [](float v, Uint32) { return PackInteger<Int32>(v); }); break;
+            }
+            break;
+            // clang-format on
+
+        case COMPONENT_TYPE_FLOAT:
+            if (FmtAttribs.ComponentSize == 2)
+            {
+                if (NumComps == 4)
+                    FloatToHalf(pRGBA, static_cast<Uint16*>(pDst), NumTexels * 4);
+                else
+                    PackComponents<Uint16>(pRGBA, NumComps, NumTexels, pDst, [](float v, Uint32) { return FloatToHalf(v); });
+            }
+            else
+            {
+                VERIFY_EXPR(FmtAttribs.ComponentSize == 4);
+                if (NumComps == 4)
+                    memcpy(pDst, pRGBA, NumTexels * 4 * sizeof(float));
+                else
+                    PackComponents<float>(pRGBA, NumComps, NumTexels, pDst, [](float v, Uint32) { return v; });
+            }
+            break;
+
+        default:
+            UNEXPECTED("Unexpected component type");
+    }
+}
+
+} // namespace
+
+
+bool IsTexelUnpackSupported(TEXTURE_FORMAT Format)
+{
+    return GetTexelLayout(Format) != TexelLayout::Unsupported;
+}
+
+bool IsTexelPackSupported(TEXTURE_FORMAT Format)
+{
+    return GetTexelLayout(Format) != TexelLayout::Unsupported;
+}
+
+void UnpackTexelRow(TEXTURE_FORMAT Format, const void* pSrc, size_t NumTexels, float* pRGBA)
+{
+    const auto* pBytes = static_cast<const Uint8*>(pSrc);
+    switch (GetTexelLayout(Format))
+    {
+        case TexelLayout::Generic:
+            UnpackGeneric(Format, pSrc, NumTexels, pRGBA);
+            break;
+
+        case TexelLayout::BGRA8:
+        case TexelLayout::BGRX8:
+            if (Format == TEX_FORMAT_BGRA8_UNORM_SRGB || Format == TEX_FORMAT_BGRX8_UNORM_SRGB)
+            {
+                for (size_t t = 0; t < NumTexels; ++t)
+                {
+                    pRGBA[t * 4 + 0] = SRGBToLinear(pBytes[t * 4 + 2]);
+                    pRGBA[t * 4 + 1] = SRGBToLinear(pBytes[t * 4 + 1]);
+                    pRGBA[t * 4 + 2] = SRGBToLinear(pBytes[t * 4 + 0]);
+                    pRGBA[t * 4 + 3] = static_cast<float>(pBytes[t * 4 + 3]) * (1.f / 255.f);
+                }
+            }
+            else
+            {
+                UnpackRGBA8(pBytes, NumTexels, true, pRGBA);
+            }
+            if (GetTexelLayout(Format) == TexelLayout::BGRX8)
+            {
+                for (size_t t = 0; t < NumTexels; ++t)
+                    pRGBA[t * 4 + 3] = 1.f;
+            }
+            break;
+
+        case TexelLayout::A8:
+            for (size_t t = 0; t < NumTexels; ++t, pRGBA += 4)
+            {
+                pRGBA[0] = pRGBA[1] = pRGBA[2] = 0.f;
+                pRGBA[3]                       = static_cast<float>(pBytes[t]) * (1.f / 255.f);
+            }
+            break;
+
+        case TexelLayout::RGB10A2:
+        {
+            const bool  IsUNorm = Format == TEX_FORMAT_RGB10A2_UNORM;
+            const auto* pTexels = static_cast<const Uint32*>(pSrc);
+            const float RGBMax  = IsUNorm ? 1023.f : 1.f;
+            const float AMax    = IsUNorm ? 3.f : 1.f;
+            for (size_t t = 0; t < NumTexels; ++t, pRGBA += 4)
+            {
+                const Uint32 Bits = pTexels[t];
+                pRGBA[0]          = static_cast<float>(Bits & 0x3FF) / RGBMax;
+                pRGBA[1]          = static_cast<float>((Bits >> 10) & 0x3FF) / RGBMax;
+                pRGBA[2]          = static_cast<float>((Bits >> 20) & 0x3FF) / RGBMax;
+                pRGBA[3]          = static_cast<float>(Bits >> 30) / AMax;
+            }
+            break;
+        }
+
+        case TexelLayout::R11G11B10:
+        {
+            const auto* pTexels = static_cast<const Uint32*>(pSrc);
+            for (size_t t = 0; t < NumTexels; ++t, pRGBA += 4)
+            {
+                const Uint32 Bits = pTexels[t];
+                pRGBA[0]          = UnpackUFloat(Bits & 0x7FF, 6);
+                pRGBA[1]          = UnpackUFloat((Bits >> 11) & 0x7FF, 6);
+                pRGBA[2]          = UnpackUFloat(Bits >> 22, 5);
+                pRGBA[3]          = 1.f;
+            }
+            break;
+        }
+
+        case TexelLayout::RGB9E5:
+        {
+            const auto* pTexels = static_cast<const Uint32*>(pSrc);
+            for (size_t t = 0; t < NumTexels; ++t)
+                UnpackRGB9E5(pTexels[t], pRGBA + t * 4);
+            break;
+        }
+
+        case TexelLayout::B5G6R5:
+        {
+            const auto* pTexels = static_cast<const Uint16*>(pSrc);
+            for (size_t t = 0; t < NumTexels; ++t, pRGBA += 4)
+            {
+                const Uint32 Bits = pTexels[t];
+                pRGBA[0]          = static_cast<float>(Bits >> 11) / 31.f;
+                pRGBA[1]          = static_cast<float>((Bits >> 5) & 0x3F) / 63.f;
+                pRGBA[2]          = static_cast<float>(Bits & 0x1F) / 31.f;
+                pRGBA[3]          = 1.f;
+            }
+            break;
+        }
+
+        case TexelLayout::B5G5R5A1:
+        {
+            const auto* pTexels = static_cast<const Uint16*>(pSrc);
+            for (size_t t = 0; t < NumTexels; ++t, pRGBA += 4)
+            {
+                const Uint32 Bits = pTexels[t];
+                pRGBA[0]          = static_cast<float>((Bits >> 10) & 0x1F) / 31.f;
+                pRGBA[1]          = static_cast<float>((Bits >> 5) & 0x1F) / 31.f;
+                pRGBA[2]          = static_cast<float>(Bits & 0x1F) / 31.f;
+                pRGBA[3]          = static_cast<float>(Bits >> 15);
+            }
+            break;
+        }
+
+        case TexelLayout::D32:
+        {
+            const auto* pTexels = static_cast<const float*>(pSrc);
+            for (size_t t = 0; t < NumTexels; ++t, pRGBA += 4)
+            {
+                pRGBA[0] = pTexels[t];
+                pRGBA[1] = pRGBA[2] = 0.f;
+                pRGBA[3]            = 1.f;
+            }
+            break;
+        }
+
+        case TexelLayout::D16:
+        {
+            const auto* pTexels = static_cast<const Uint16*>(pSrc);
+            for (size_t t = 0; t < NumTexels; ++t, pRGBA += 4)
+            {
+                pRGBA[0] = static_cast<float>(pTexels[t]) / 65535.f;
+                pRGBA[1] = pRGBA[2] = 0.f;
+                pRGBA[3]            = 1.f;
+            }
+            break;
+        }
+
+        case TexelLayout::D24S8:
+        {
+            const auto* pTexels = static_cast<const Uint32*>(pSrc);
+            for (size_t t = 0; t < NumTexels; ++t, pRGBA += 4)
+            {
+                const Uint32 Bits = pTexels[t];
+                pRGBA[0]          = static_cast<float>(Bits & 0xFFFFFF) / 16777215.f;
+                pRGBA[1]          = static_cast<float>(Bits >> 24);
+                pRGBA[2]          = 0.f;
+                pRGBA[3]          = 1.f;
+            }
+            break;
+        }
+
+        case TexelLayout::D32S8:
+        {
+            for (size_t t = 0; t < NumTexels; ++t, pRGBA += 4)
+            {
+                float  Depth;
+                Uint32 Stencil;
+                memcpy(&Depth, pBytes + t * 8, sizeof(Depth));
+                memcpy(&Stencil, pBytes + t * 8 + 4, sizeof(Stencil));
+                pRGBA[0] = Depth;
+                pRGBA[1] = static_cast<float>(Stencil & 0xFF);
+                pRGBA[2] = 0.f;
+                pRGBA[3] = 1.f;
+            }
+            break;
+        }
+
+        default:
+            UNEXPECTED("Unpacking texels of format ", GetTextureFormatAttribs(Format).Name, " is not supported");
+    }
+}
+
+void PackTexelRow(TEXTURE_FORMAT Format, const float* pRGBA, size_t NumTexels, void* pDst)
+{
+    auto* pBytes = static_cast<Uint8*>(pDst);
+    switch (GetTexelLayout(Format))
+    {
+        case TexelLayout::Generic:
+            PackGeneric(Format, pRGBA, NumTexels, pDst);
+            break;
+
+        case TexelLayout::BGRA8:
+        case TexelLayout::BGRX8:
+            if (Format == TEX_FORMAT_BGRA8_UNORM_SRGB || Format == TEX_FORMAT_BGRX8_UNORM_SRGB)
+            {
+                for (size_t t = 0; t < NumTexels; ++t)
+                {
+                    pBytes[t * 4 + 0] = static_cast<Uint8>(PackUNorm(LinearToSRGB(Saturate(pRGBA[t * 4 + 2])), 255));
+                    pBytes[t * 4 + 1] = static_cast<Uint8>(PackUNorm(LinearToSRGB(Saturate(pRGBA[t * 4 + 1])), 255));
+                    pBytes[t * 4 + 2] = static_cast<Uint8>(PackUNorm(LinearToSRGB(Saturate(pRGBA[t * 4 + 0])), 255));
+                    pBytes[t * 4 + 3] = static_cast<Uint8>(PackUNorm(pRGBA[t * 4 + 3], 255));
+                }
+            }
+            else
+            {
+                PackRGBA8(pRGBA, NumTexels, true, pBytes);
+            }
+            if (GetTexelLayout(Format) == TexelLayout::BGRX8)
+            {
+                for (size_t t = 0; t < NumTexels; ++t)
+                    pBytes[t * 4 + 3] = 255;
+            }
+            break;
+
+        case TexelLayout::A8:
+            for (size_t t = 0; t < NumTexels; ++t)
+                pBytes[t] = static_cast<Uint8>(PackUNorm(pRGBA[t * 4 + 3], 255));
+            break;
+
+        case TexelLayout::RGB10A2:
+        {
+            auto* pTexels = static_cast<Uint32*>(pDst);
+            for (size_t t = 0; t < NumTexels; ++t, pRGBA += 4)
+            {
+                Uint32 R, G, B, A;
+                if (Format == TEX_FORMAT_RGB10A2_UNORM)
+                {
+                    R = PackUNorm(pRGBA[0], 1023);
+                    G = PackUNorm(pRGBA[1], 1023);
+                    B = PackUNorm(pRGBA[2], 1023);
+                    A = PackUNorm(pRGBA[3], 3);
+                }
+                else
+                {
+                    R = std::min(Uint32{PackInteger<Uint16>(pRGBA[0])}, 1023u);
+                    G = std::min(Uint32{PackInteger<Uint16>(pRGBA[1])}, 1023u);
+                    B = std::min(Uint32{PackInteger<Uint16>(pRGBA[2])}, 1023u);
+                    A = std::min(Uint32{PackInteger<Uint8>(pRGBA[3])}, 3u);
+                }
+                pTexels[t] = R | (G << 10) | (B << 20) | (A << 30);
+            }
+            break;
+        }
+
+        case TexelLayout::R11G11B10:
+        {
+            auto* pTexels = static_cast<Uint32*>(pDst);
+            for (size_t t = 0; t < NumTexels; ++t, pRGBA += 4)
+                pTexels[t] = PackUFloat(pRGBA[0], 6) | (PackUFloat(pRGBA[1], 6) << 11) | (PackUFloat(pRGBA[2], 5) << 22);
+            break;
+        }
+
+        case TexelLayout::RGB9E5:
+        {
+            auto* pTexels = static_cast<Uint32*>(pDst);
+            for (size_t t = 0; t < NumTexels; ++t)
+                pTexels[t] = PackRGB9E5(pRGBA + t * 4);
+            break;
+        }
+
+        case TexelLayout::B5G6R5:
+        {
+            auto* pTexels = static_cast<Uint16*>(pDst);
+            for (size_t t = 0; t < NumTexels; ++t, pRGBA += 4)
+                pTexels[t] = static_cast<Uint16>((PackUNorm(pRGBA[0], 31) << 11) | (PackUNorm(pRGBA[1], 63) << 5) | PackUNorm(pRGBA[2], 31));
+            break;
+        }
+
+        case TexelLayout::B5G5R5A1:
+        {
+            auto* pTexels = static_cast<Uint16*>(pDst);
+            for (size_t t = 0; t < NumTexels; ++t, pRGBA += 4)
+            {
+                pTexels[t] = static_cast<Uint16>((PackUNorm(pRGBA[3], 1) << 15) | (PackUNorm(pRGBA[0], 31) << 10) |
+                                                 (PackUNorm(pRGBA[1], 31) << 5) | PackUNorm(pRGBA[2], 31));
+            }
+            break;
+        }
+
+        case TexelLayout::D32:
+        {
+            auto* pTexels = static_cast<float*>(pDst);
+            for (size_t t = 0; t < NumTexels; ++t)
+                pTexels[t] = pRGBA[t * 4];
+            break;
+        }
+
+        case TexelLayout::D16:
+        {
+            auto* pTexels = static_cast<Uint16*>(pDst);
+            for (size_t t = 0; t < NumTexels; ++t)
+                pTexels[t] = static_cast<Uint16>(PackUNorm(pRGBA[t * 4], 65535));
+            break;
+        }
+
+        case TexelLayout::D24S8:
+        {
+            auto* pTexels = static_cast<Uint32*>(pDst);
+            for (size_t t = 0; t < NumTexels; ++t, pRGBA += 4)
+            {
+                // 24-bit values can't be rounded in single precision
+                const auto Depth = static_cast<Uint32>(static_cast<double>(Saturate(pRGBA[0])) * 16777215.0 + 0.5);
+                pTexels[t]       = Depth | (Uint32{PackInteger<Uint8>(pRGBA[1])} << 24);
+            }
+            break;
+        }
+
+        case TexelLayout::D32S8:
+        {
+            for (size_t t = 0; t < NumTexels; ++t, pRGBA += 4)
+            {
+                const Uint32 Stencil = PackInteger<Uint8>(pRGBA[1]);
+                memcpy(pBytes + t * 8, pRGBA, sizeof(float));
+                memcpy(pBytes + t * 8 + 4, &Stencil, sizeof(Stencil));
+            }
+            break;
+        }
+
+        default:
+            UNEXPECTED("Packing texels of format ", GetTextureFormatAttribs(Format).Name, " is not supported");
+    }
+}
+
+
+bool ConvertTextureData(Uint32         Width,
+                        Uint32         Height,
+                        TEXTURE_FORMAT SrcFormat,
+                        const void*    pSrcData,
+                        Uint32         SrcStride,
+                        TEXTURE_FORMAT DstFormat,
+                        void*          pDstData,
+                        Uint32         DstStride,
+                        ThreadPool*    pThreadPool)
+{
+    const bool IsSrcCompressed = IsBlockCompressed(SrcFormat);
+    if (!IsSrcCompressed && !IsTexelUnpackSupported(SrcFormat))
+    {
+        LOG_ERROR_MESSAGE("Conversion from format ", GetTextureFormatAttribs(SrcFormat).Name, " is not supported");
+        return false;
+    }
+    if (!IsTexelPackSupported(DstFormat))
+    {
+        LOG_ERROR_MESSAGE("Conversion to format ", GetTextureFormatAttribs(DstFormat).Name, " is not supported",
+                          IsBlockCompressed(DstFormat) ? ". Use CompressTextureData to produce block-compressed data." : "");
+        return false;
+    }
+    if (Width == 0 || Height == 0)
+        return true;
+
+    DEV_CHECK_ERR(pSrcData != nullptr && pDstData != nullptr, "Source and destination data must not be null");
+
+    const auto* pSrc = static_cast<const Uint8*>(pSrcData);
+    auto*       pDst = static_cast<Uint8*>(pDstData);
+
+    // Every task processes a group of rows that corresponds to one row of blocks
+    static constexpr Uint32 RowsPerGroup = 4;
+
+    const Uint32 NumGroups = (Height + RowsPerGroup - 1) / RowsPerGroup;
+
+    std::function<void(Uint32)> ConvertGroup;
+    if (IsSrcCompressed)
+    {
+        const auto&  SrcAttribs = GetTextureFormatAttribs(SrcFormat);
+        const Uint32 BlockSize  = SrcAttribs.ComponentSize;
+        const Uint32 NumBlocksX = (Width + 3) / 4;
+        ConvertGroup            = [=](Uint32 BlockY) {
+            std::vector<float> Rows(size_t{NumBlocksX} * 4 * 4 * 4);
+            float              Block[16 * 4];
+            const Uint8*       pSrcRow = pSrc + size_t{BlockY} * SrcStride;
+            for (Uint32 BlockX = 0; BlockX < NumBlocksX; ++BlockX)
+            {
+                DecompressBlock(SrcFormat, pSrcRow + size_t{BlockX} * BlockSize, Block);
+                for (Uint32 y = 0; y < 4; ++y)
+                    memcpy(&Rows[(size_t{y} * NumBlocksX * 4 + BlockX * 4) * 4], Block + y * 4 * 4, sizeof(float) * 4 * 4);
+            }
+
+            const Uint32 NumRows = std::min(4u, Height - BlockY * 4);
+            for (Uint32 y = 0; y < NumRows; ++y)
+                PackTexelRow(DstFormat, &Rows[size_t{y} * NumBlocksX * 4 * 4], Width, pDst + (size_t{BlockY} * 4 + y) * DstStride);
+        };
+    }
+    else
+    {
+        const Uint32 SrcTexelSize = GetTexelSize(SrcFormat);
+
+        const auto IsRGBA8 = [](TEXTURE_FORMAT Fmt) {
+            return Fmt == TEX_FORMAT_RGBA8_UNORM || Fmt == TEX_FORMAT_RGBA8_UNORM_SRGB;
+        };
+        const auto IsBGRA8 = [](TEXTURE_FORMAT Fmt) {
+            return Fmt == TEX_FORMAT_BGRA8_UNORM || Fmt == TEX_FORMAT_BGRA8_UNORM_SRGB;
+        };
+
+        const bool IsSameColorSpace = GetTextureFormatAttribs(SrcFormat).ComponentType == GetTextureFormatAttribs(DstFormat).ComponentType;
+        if (SrcFormat == DstFormat)
+        {
+            ConvertGroup = [=](Uint32 Group) {
+                const Uint32 EndRow = std::min(Height, (Group + 1) * RowsPerGroup);
+                for (Uint32 y = Group * RowsPerGroup; y < EndRow; ++y)
+                    memcpy(pDst + size_t{y} * DstStride, pSrc + size_t{y} * SrcStride, size_t{Width} * SrcTexelSize);
+            };
+        }
+        else if (IsSameColorSpace && ((IsRGBA8(SrcFormat) && IsBGRA8(DstFormat)) || (IsBGRA8(SrcFormat) && IsRGBA8(DstFormat))))
+        {
+            ConvertGroup = [=](Uint32 Group) {
+                const Uint32 EndRow = std::min(Height, (Group + 1) * RowsPerGroup);
+                for (Uint32 y = Group * RowsPerGroup; y < EndRow; ++y)
+                {
+                    const Uint8* pSrcRow = pSrc + size_t{y} * SrcStride;
+                    Uint8*       pDstRow = pDst + size_t{y} * DstStride;
+                    for (Uint32 x = 0; x < Width; ++x)
+                    {
+                        pDstRow[x * 4 + 0] = pSrcRow[x * 4 + 2];
+                        pDstRow[x * 4 + 1] = pSrcRow[x * 4 + 1];
+                        pDstRow[x * 4 + 2] = pSrcRow[x * 4 + 0];
+                        pDstRow[x * 4 + 3] = pSrcRow[x * 4 + 3];
+                    }
+                }
+            };
+        }
+        else
+        {
+            ConvertGroup = [=](Uint32 Group) {
+                std::vector<float> Row(size_t{Width} * 4);
+                const Uint32       EndRow = std::min(Height, (Group + 1) * RowsPerGroup);
+                for (Uint32 y = Group * RowsPerGroup; y < EndRow; ++y)
+                {
+                    UnpackTexelRow(SrcFormat, pSrc + size_t{y} * SrcStride, Width, Row.data());
+                    PackTexelRow(DstFormat, Row.data(), Width, pDst + size_t{y} * DstStride);
+                }
+            };
+        }
+    }
+
+    if (pThreadPool != nullptr && NumGroups > 1)
+    {
+        VERIFY(pThreadPool->GetCurrentThreadId() == ~0u, "Texture data must not be converted from a worker thread of the pool");
+        for (Uint32 Group = 0; Group < NumGroups; ++Group)
+        {
+            pThreadPool->EnqueueTask([&ConvertGroup, Group](Uint32) //
+                                     {
+                                         ConvertGroup(Group);
+                                     });
+        }
+        pThreadPool->WaitForAllTasks();
+    }
+    else
+    {
+        for (Uint32 Group = 0; Group < NumGroups; ++Group)
+            ConvertGroup(Group);
+    }
+
+    return true;
+}
+
+} // namespace Diligent
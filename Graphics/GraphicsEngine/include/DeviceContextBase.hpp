@@ -1778,7 +1778,15 @@ inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::DvpVerifyDra
         return false;
     }
 
-    if (m_pActiveRenderPass != nullptr && Attribs.IndirectAttribsBufferStateTransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION)
+    if (Attribs.pCounterBuffer != nullptr && m_pDevice->GetDeviceCaps().Features.DrawIndirectCounterBuffer != DEVICE_FEATURE_STATE_ENABLED)
+    {
+        LOG_ERROR_MESSAGE("DrawIndirect command arguments are invalid: counter buffer is not null, but DrawIndirectCounterBuffer feature is not enabled.");
+        return false;
+    }
+
+    if (m_pActiveRenderPass != nullptr &&
+        (Attribs.IndirectAttribsBufferStateTransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION ||
+         (Attribs.pCounterBuffer != nullptr && Attribs.CounterBufferStateTransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION)))
     {
         LOG_ERROR_MESSAGE("Resource state transitons are not allowed inside a render pass and may result in an undefined behavior. "
                           "Do not use RESOURCE_STATE_TRANSITION_MODE_TRANSITION or end the render pass first.");
@@ -1815,7 +1823,15 @@ inline bool DeviceContextBase<BaseInterface, ImplementationTraits>::DvpVerifyDra
         return false;
     }
 
-    if (m_pActiveRenderPass != nullptr && Attribs.IndirectAttribsBufferStateTransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION)
+    if (Attribs.pCounterBuffer != nullptr && m_pDevice->GetDeviceCaps().Features.DrawIndirectCounterBuffer != DEVICE_FEATURE_STATE_ENABLED)
+    {
+        LOG_ERROR_MESSAGE("DrawIndexedIndirect command arguments are invalid: counter buffer is not null, but DrawIndirectCounterBuffer feature is not enabled.");
+        return false;
+    }
+
+    if (m_pActiveRenderPass != nullptr &&
+        (Attribs.IndirectAttribsBufferStateTransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION ||
+         (Attribs.pCounterBuffer != nullptr && Attribs.CounterBufferStateTransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION)))
     {
         LOG_ERROR_MESSAGE("Resource state transitons are not allowed inside a render pass and may result in an undefined behavior. "
                           "Do not use RESOURCE_STATE_TRANSITION_MODE_TRANSITION or end the render pass first.");
@@ -72,6 +72,58 @@ struct hash<Diligent::SamplerDesc>
     }
 };
 
+/// Hash function specialization for Diligent::RenderPassDesc structure.
+template <>
+struct hash<Diligent::RenderPassDesc>
+{
+    size_t operator()(const Diligent::RenderPassDesc& RPDesc) const
+    {
+        // Render pass name is ignored in comparison operator
+        // and should not be hashed
+        std::size_t Seed = 0;
+        Diligent::HashCombine(Seed, RPDesc.AttachmentCount, RPDesc.SubpassCount, RPDesc.DependencyCount);
+        for (Diligent::Uint32 i = 0; i < RPDesc.AttachmentCount; ++i)
+        {
+            const auto& Attachment = RPDesc.pAttachments[i];
+            Diligent::HashCombine(Seed,
+                                  static_cast<int>(Attachment.Format),
+                                  Attachment.SampleCount,
+                                  static_cast<int>(Attachment.LoadOp),
+                                  static_cast<int>(Attachment.StoreOp),
+                                  static_cast<int>(Attachment.StencilLoadOp),
+                                  static_cast<int>(Attachment.StencilStoreOp),
+                                  static_cast<int>(Attachment.InitialState),
+                                  static_cast<int>(Attachment.FinalState));
+        }
+        for (Diligent::Uint32 i = 0; i < RPDesc.SubpassCount; ++i)
+        {
+            const auto& Subpass = RPDesc.pSubpasses[i];
+            Diligent::HashCombine(Seed,
+                                  Subpass.InputAttachmentCount,
+                                  Subpass.RenderTargetAttachmentCount,
+                                  Subpass.PreserveAttachmentCount,
+                                  Subpass.pResolveAttachments != nullptr,
+                                  Subpass.pDepthStencilAttachment != nullptr);
+            for (Diligent::Uint32 rt = 0; rt < Subpass.RenderTargetAttachmentCount; ++rt)
+                Diligent::HashCombine(Seed, Subpass.pRenderTargetAttachments[rt].AttachmentIndex, static_cast<int>(Subpass.pRenderTargetAttachments[rt].State));
+            if (Subpass.pDepthStencilAttachment != nullptr)
+                Diligent::HashCombine(Seed, Subpass.pDepthStencilAttachment->AttachmentIndex, static_cast<int>(Subpass.pDepthStencilAttachment->State));
+        }
+        for (Diligent::Uint32 i = 0; i < RPDesc.DependencyCount; ++i)
+        {
+            const auto& Dependency = RPDesc.pDependencies[i];
+            Diligent::HashCombine(Seed,
+                                  Dependency.SrcSubpass,
+                                  Dependency.DstSubpass,
+                                  static_cast<int>(Dependency.SrcStageMask),
+                                  static_cast<int>(Dependency.DstStageMask),
+                                  static_cast<int>(Dependency.SrcAccessMask),
+                                  static_cast<int>(Dependency.DstAccessMask));
+        }
+        return Seed;
+    }
+};
+
 /// Hash function specialization for Diligent::StencilOpDesc structure.
 template <>
 struct hash<Diligent::StencilOpDesc>
@@ -254,6 +306,7 @@ public:
         TObjectBase             {pRefCounters},
         m_pEngineFactory        {pEngineFactory},
         m_SamplersRegistry      {RawMemAllocator, "sampler"},
+        m_RenderPassRegistry    {RawMemAllocator, "render pass"},
         m_TextureFormatsInfo    (TEX_FORMAT_NUM_FORMATS, TextureFormatInfoExt(), STD_ALLOCATOR_RAW_MEM(TextureFormatInfoExt, RawMemAllocator, "Allocator for vector<TextureFormatInfoExt>")),
         m_TexFmtInfoInitFlags   (TEX_FORMAT_NUM_FORMATS, false, STD_ALLOCATOR_RAW_MEM(bool, RawMemAllocator, "Allocator for vector<bool>")),
         m_wpDeferredContexts    (NumDeferredContexts, RefCntWeakPtr<IDeviceContext>(), STD_ALLOCATOR_RAW_MEM(RefCntWeakPtr<IDeviceContext>, RawMemAllocator, "Allocator for vector< RefCntWeakPtr<IDeviceContext> >")),
@@ -387,7 +440,8 @@ public:
     {
     }
 
-    StateObjectsRegistry<SamplerDesc>& GetSamplerRegistry() { return m_SamplersRegistry; }
+    StateObjectsRegistry<SamplerDesc>&    GetSamplerRegistry() { return m_SamplersRegistry; }
+    StateObjectsRegistry<RenderPassDesc>& GetRenderPassRegistry() { return m_RenderPassRegistry; }
 
     /// Set weak reference to the immediate context
     void SetImmediateContext(IDeviceContext* pImmediateContext)
@@ -428,10 +482,11 @@ protected:
     DeviceCaps       m_DeviceCaps;
     DeviceProperties m_DeviceProperties;
 
-    // All state object registries hold raw pointers.
-    // This is safe because every object unregisters itself
-    // when it is deleted.
-    StateObjectsRegistry<SamplerDesc>                                           m_SamplersRegistry; ///< Sampler state registry
+    // All state object registries hold weak pointers.
+    // Objects only report their deletion to the registry,
+    // which then reclaims expired entries incrementally.
+    StateObjectsRegistry<SamplerDesc>                                           m_SamplersRegistry;   ///< Sampler state registry
+    StateObjectsRegistry<RenderPassDesc>                                        m_RenderPassRegistry; ///< Render pass registry
     std::vector<TextureFormatInfoExt, STDAllocatorRawMem<TextureFormatInfoExt>> m_TextureFormatsInfo;
     std::vector<bool, STDAllocatorRawMem<bool>>                                 m_TexFmtInfoInitFlags;
 
@@ -75,14 +75,15 @@ public:
     /// \param Desc              - Render pass description.
     /// \param bIsDeviceInternal - Flag indicating if the RenderPass is an internal device object and
     ///							   must not keep a strong reference to the device.
+    ///
+    /// \note The description must be validated by the caller with ValidateRenderPassDesc()
+    ///       as it needs to be valid before it is looked up in the render pass registry.
     RenderPassBase(IReferenceCounters*   pRefCounters,
                    RenderDeviceImplType* pDevice,
                    const RenderPassDesc& Desc,
                    bool                  bIsDeviceInternal = false) :
         TDeviceObjectBase{pRefCounters, pDevice, Desc, bIsDeviceInternal}
     {
-        ValidateRenderPassDesc(this->m_Desc);
-
         if (Desc.AttachmentCount != 0)
         {
             auto* pAttachments =
@@ -210,6 +211,16 @@ public:
 
     ~RenderPassBase()
     {
+        // The description must be reported before its arrays are released.
+        // Device-internal render passes are never added to the registry.
+        /// \note Destructor cannot directly remove the object from the registry as this may cause a
+        ///       deadlock.
+        if (!this->m_bIsDeviceInternal)
+        {
+            auto& RenderPassRegistry = this->GetDevice()->GetRenderPassRegistry();
+            RenderPassRegistry.ReportDeletedObject(this->m_Desc);
+        }
+
         auto& RawAllocator = GetRawAllocator();
         if (this->m_Desc.pAttachments != nullptr)
             RawAllocator.Free(const_cast<RenderPassAttachmentDesc*>(this->m_Desc.pAttachments));
@@ -65,7 +65,7 @@ public:
         /// \note Destructor cannot directly remove the object from the registry as this may cause a
         ///       deadlock.
         auto& SamplerRegistry = this->GetDevice()->GetSamplerRegistry();
-        SamplerRegistry.ReportDeletedObject();
+        SamplerRegistry.ReportDeletedObject(this->m_Desc);
     }
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_Sampler, TDeviceObjectBase)
@@ -30,16 +30,20 @@
 /// \file
 /// Implementation of the Diligent::StateObjectsRegistry template class
 
-#include "DeviceObject.h"
 #include <unordered_map>
+#include <vector>
+#include <memory>
+#include "DeviceObject.h"
 #include "STDAllocator.hpp"
+#include "RefCntAutoPtr.hpp"
+#include "LockHelper.hpp"
 
 namespace Diligent
 {
 /// Template class implementing state object registry
 
-/// \tparam ResourceDescType - type of the resource description. The type must have
-///                            operator== and a hash function defined.
+/// \tparam ResourceDescType - type of the resource description. The type must be derived from
+///                            DeviceObjectAttribs and must have operator== and a hash function defined.
 ///
 /// \remarks
 /// The following strategies do not work:
@@ -58,17 +62,36 @@ namespace Diligent
 /// if other thread has started dtor, the object will be locked by Diligent::RefCountedObject::Release().
 /// If after that this thread locks the registry first, it will be waiting for the object to unlock in
 /// Diligent::RefCntWeakPtr::Lock(), while the dtor thread will be waiting for the registry to unlock.
+/// \remarks
+/// The registry is split into NumShards independently locked shards selected by the description hash,
+/// so that threads creating different objects rarely contend for the same lock. The registry does not
+/// keep copies of the descriptions: entries are keyed by the precomputed hash, and the description of
+/// a live object is compared through IDeviceObject::GetDesc() after its weak pointer has been locked.
+/// This also allows descriptions that reference external memory (such as RenderPassDesc) to be registered.
 template <typename ResourceDescType>
 class StateObjectsRegistry
 {
 public:
-    /// Number of outstanding deleted objects to purge the registry.
-    static constexpr int DeletedObjectsToPurge = 32;
+    /// Number of independently locked shards.
+    static constexpr Uint32 NumShards = 16;
+
+    /// Number of outstanding deleted objects in a shard to purge that shard.
+    static constexpr int DeletedObjectsToPurge = 8;
 
     StateObjectsRegistry(IMemoryAllocator& RawAllocator, const Char* RegistryName) :
-        m_DescToObjHashMap(STD_ALLOCATOR_RAW_MEM(HashMapElem, RawAllocator, "Allocator for unordered_map<ResourceDescType, RefCntWeakPtr<IDeviceObject> >")),
         m_RegistryName{RegistryName}
-    {}
+    {
+        m_Shards.reserve(NumShards);
+        for (Uint32 i = 0; i < NumShards; ++i)
+            m_Shards.emplace_back(new Shard{RawAllocator});
+    }
+
+    // clang-format off
+    StateObjectsRegistry             (const StateObjectsRegistry&)  = delete;
+    StateObjectsRegistry             (      StateObjectsRegistry&&) = delete;
+    StateObjectsRegistry& operator = (const StateObjectsRegistry&)  = delete;
+    StateObjectsRegistry& operator = (      StateObjectsRegistry&&) = delete;
+    // clang-format on
 
     ~StateObjectsRegistry()
     {
@@ -78,35 +101,39 @@ public:
         // may only be expired references in the registry. After we
         // purge it, the registry must be empty.
         Purge();
-        VERIFY(m_DescToObjHashMap.empty(), "DescToObjHashMap is not empty");
+        VERIFY(GetNumEntries() == 0, "The registry is not empty");
+    }
+
+    /// Computes the hash of the object description that can be passed to Find() and Add().
+    static size_t ComputeHash(const ResourceDescType& Desc)
+    {
+        return std::hash<ResourceDescType>{}(Desc);
     }
 
     /// Adds a new object to the registry
 
     /// \param [in] ObjectDesc - object description.
-    /// \param [in] pObject - pointer to the object.
+    /// \param [in] Hash       - hash of the object description, see ComputeHash().
+    /// \param [in] pObject    - pointer to the object.
     ///
     /// Besides adding a new object, the function also checks the number of
-    /// outstanding deleted objects and calls Purge() if the number has reached
-    /// the threshold value DeletedObjectsToPurge. Creating a state object is
-    /// assumed to be an expensive operation and should be performed during
-    /// the initialization. Occasional purge operations should not add significant
-    /// cost to it.
-    void Add(const ResourceDescType& ObjectDesc, IDeviceObject* pObject)
+    /// outstanding deleted objects in the target shard and purges the shard if the
+    /// number has reached the threshold value DeletedObjectsToPurge. Only one shard
+    /// is purged at a time, so the cost of reclaiming expired entries is spread
+    /// across many calls.
+    void Add(const ResourceDescType& ObjectDesc, size_t Hash, IDeviceObject* pObject)
     {
-        ThreadingTools::LockHelper Lock(m_LockFlag);
+        VERIFY(Hash == ComputeHash(ObjectDesc), "Incorrect description hash");
+
+        auto& Shard = GetShard(Hash);
+
+        ThreadingTools::LockHelper Lock{Shard.LockFlag};
 
         // If the number of outstanding deleted objects reached the threshold value,
-        // purge the registry. Since we have exclusive access now, it is safe
-        // to do.
-        if (m_NumDeletedObjects >= DeletedObjectsToPurge)
-        {
-            Purge();
-            m_NumDeletedObjects = 0;
-        }
+        // purge the shard. Since we have exclusive access now, it is safe to do.
+        if (Shard.NumDeletedObjects >= DeletedObjectsToPurge)
+            PurgeShard(Shard);
 
-        // Try to construct the new element in place
-        auto Elems = m_DescToObjHashMap.emplace(std::make_pair(ObjectDesc, Diligent::RefCntWeakPtr<IDeviceObject>(pObject)));
         // It is theorertically possible that the same object can be found
         // in the registry. This might happen if two threads try to create
         // the same object at the same time. They both will not find the
@@ -114,61 +141,163 @@ public:
         //
         // If the object already exists, we replace the existing reference.
         // This is safer as there might be scenarios where existing reference
-        // might be expired. For instance, two threads try to create the same
-        // object which is not in the registry. The first thread creates
-        // the object, adds it to the registry and then releases it. After that
-        // the second thread creates the same object and tries to add it to
-        // the registry. It will find an existing expired reference to the
-        // object.
-        if (!Elems.second)
+        // might be expired.
+        auto Range = Shard.Objects.equal_range(Hash);
+        for (auto It = Range.first; It != Range.second;)
         {
-            VERIFY(Elems.first->first == ObjectDesc, "Incorrect object description");
-            LOG_WARNING_MESSAGE("Object named '", Elems.first->first.Name,
-                                "' with the same description already exists in the registry."
-                                "Replacing with the new object named '",
-                                ObjectDesc.Name ? ObjectDesc.Name : "", "'.");
-            Elems.first->second = pObject;
+            auto pExistingObject = It->second.Lock();
+            if (!pExistingObject)
+            {
+                It = Shard.Objects.erase(It);
+                continue;
+            }
+
+            const auto& ExistingDesc = static_cast<const ResourceDescType&>(pExistingObject->GetDesc());
+            if (ExistingDesc == ObjectDesc)
+            {
+                LOG_WARNING_MESSAGE("Object named '", ExistingDesc.Name ? ExistingDesc.Name : "",
+                                    "' with the same description already exists in the ", m_RegistryName,
+                                    " registry. Replacing with the new object named '",
+                                    ObjectDesc.Name ? ObjectDesc.Name : "", "'.");
+                It->second = pObject;
+                return;
+            }
+            ++It;
         }
+
+        Shard.Objects.emplace(Hash, RefCntWeakPtr<IDeviceObject>{pObject});
+    }
+
+    void Add(const ResourceDescType& ObjectDesc, IDeviceObject* pObject)
+    {
+        Add(ObjectDesc, ComputeHash(ObjectDesc), pObject);
     }
 
     /// Finds the object in the registry
-    void Find(const ResourceDescType& Desc, IDeviceObject** ppObject)
+
+    /// \param [in]  Desc     - object description.
+    /// \param [in]  Hash     - hash of the object description, see ComputeHash().
+    /// \param [out] ppObject - address of the memory location where the pointer to the object
+    ///                         will be written. If the object is not found, nullptr is written.
+    void Find(const ResourceDescType& Desc, size_t Hash, IDeviceObject** ppObject)
     {
         VERIFY(*ppObject == nullptr, "Overwriting reference to existing object may cause memory leaks");
+        VERIFY(Hash == ComputeHash(Desc), "Incorrect description hash");
         *ppObject = nullptr;
-        ThreadingTools::LockHelper Lock(m_LockFlag);
 
-        auto It = m_DescToObjHashMap.find(Desc);
-        if (It != m_DescToObjHashMap.end())
+        auto& Shard = GetShard(Hash);
+
+        ThreadingTools::LockHelper Lock{Shard.LockFlag};
+
+        auto Range = Shard.Objects.equal_range(Hash);
+        for (auto It = Range.first; It != Range.second;)
         {
             // Try to obtain strong reference to the object.
             // This is an atomic operation and we either get
             // a new strong reference or object has been destroyed
             // and we get null.
             auto pObject = It->second.Lock();
-            if (pObject)
+            if (!pObject)
             {
-                *ppObject = pObject.Detach();
-                //LOG_INFO_MESSAGE( "Equivalent of the requested state object named \"", Desc.Name ? Desc.Name : "", "\" found in the ", m_RegistryName, " registry. Reusing existing object.");
+                // Expired object found: remove it from the map
+                It = Shard.Objects.erase(It);
+                continue;
             }
-            else
+
+            // The object is alive, so its description can be safely accessed
+            if (static_cast<const ResourceDescType&>(pObject->GetDesc()) == Desc)
             {
-                // Expired object found: remove it from the map
-                m_DescToObjHashMap.erase(It);
-                Atomics::AtomicDecrement(m_NumDeletedObjects);
+                *ppObject = pObject.Detach();
+                return;
             }
+            ++It;
         }
     }
 
-    /// Purges outstanding deleted objects from the registry
+    void Find(const ResourceDescType& Desc, IDeviceObject** ppObject)
+    {
+        Find(Desc, ComputeHash(Desc), ppObject);
+    }
+
+    /// Purges outstanding deleted objects from all shards of the registry
     void Purge()
     {
         Uint32 NumPurgedObjects = 0;
-        auto   It               = m_DescToObjHashMap.begin();
-        while (It != m_DescToObjHashMap.end())
+        for (auto& pShard : m_Shards)
+        {
+            ThreadingTools::LockHelper Lock{pShard->LockFlag};
+            NumPurgedObjects += PurgeShard(*pShard);
+        }
+        LOG_INFO_MESSAGE("Purged ", NumPurgedObjects, " deleted objects from the ", m_RegistryName, " registry");
+    }
+
+    /// Increments the number of outstanding deleted objects in the shard the
+    /// object description belongs to. When this number reaches DeletedObjectsToPurge,
+    /// the shard will be purged by the next Add() call.
+    ///
+    /// \note The method does not lock the registry and can be safely called from
+    ///       the object's destructor.
+    void ReportDeletedObject(const ResourceDescType& Desc)
+    {
+        GetShard(ComputeHash(Desc)).NumDeletedObjects.fetch_add(1);
+    }
+
+    /// Returns the total number of entries, including the expired ones, in the registry.
+    size_t GetNumEntries()
+    {
+        size_t NumEntries = 0;
+        for (auto& pShard : m_Shards)
+        {
+            ThreadingTools::LockHelper Lock{pShard->LockFlag};
+            NumEntries += pShard->Objects.size();
+        }
+        return NumEntries;
+    }
+
+private:
+    // The hash is precomputed, so the map uses it as is
+    struct IdentityHasher
+    {
+        size_t operator()(size_t Hash) const noexcept
+        {
+            return Hash;
+        }
+    };
+
+    using HashMapElem = std::pair<const size_t, RefCntWeakPtr<IDeviceObject>>;
+    using HashMapType = std::unordered_multimap<size_t, RefCntWeakPtr<IDeviceObject>, IdentityHasher, std::equal_to<size_t>, STDAllocatorRawMem<HashMapElem>>;
+
+    struct Shard
+    {
+        explicit Shard(IMemoryAllocator& RawAllocator) :
+            Objects(STD_ALLOCATOR_RAW_MEM(HashMapElem, RawAllocator, "Allocator for unordered_multimap<size_t, RefCntWeakPtr<IDeviceObject>>"))
+        {}
+
+        /// Lock flag to protect the Objects map
+        ThreadingTools::LockFlag LockFlag;
+
+        /// Number of outstanding deleted objects that have not been purged.
+        /// This is only a hint, the value is reset to zero when the shard is purged.
+        Atomics::AtomicLong NumDeletedObjects{0};
+
+        /// Weak pointers to the registered objects keyed by the description hash
+        HashMapType Objects;
+    };
+
+    Shard& GetShard(size_t Hash)
+    {
+        // Mix the upper bits in as std::hash may produce poorly distributed low bits
+        Hash ^= Hash >> 16;
+        Hash ^= Hash >> 8;
+        return *m_Shards[Hash % NumShards];
+    }
+
+    // The shard must be locked by the caller
+    static Uint32 PurgeShard(Shard& Shard)
+    {
+        Uint32 NumPurgedObjects = 0;
+        for (auto It = Shard.Objects.begin(); It != Shard.Objects.end();)
         {
-            auto NextIt = It;
-            ++NextIt;
             // Note that IsValid() is not a thread-safe function in the sense that it
             // can give false positive results. The only thread-safe way to check if the
             // object is alive is to lock the weak pointer, but that requires thread
@@ -179,33 +308,19 @@ public:
             // pointer as it will definitiely be removed next time.
             if (!It->second.IsValid())
             {
-                m_DescToObjHashMap.erase(It);
+                It = Shard.Objects.erase(It);
                 ++NumPurgedObjects;
             }
-
-            It = NextIt;
+            else
+            {
+                ++It;
+            }
         }
-        LOG_INFO_MESSAGE("Purged ", NumPurgedObjects, " deleted objects from the ", m_RegistryName, " registry");
-    }
-
-    /// Increments the number of outstanding deleted objects.
-    /// When this number reaches DeletedObjectsToPurge, Purge() will
-    /// be called.
-    void ReportDeletedObject()
-    {
-        Atomics::AtomicIncrement(m_NumDeletedObjects);
+        Shard.NumDeletedObjects.store(0);
+        return NumPurgedObjects;
     }
 
-private:
-    /// Lock flag to protect the m_DescToObjHashMap
-    ThreadingTools::LockFlag m_LockFlag;
-
-    /// Nmber of outstanding deleted objects that have not been purged
-    Atomics::AtomicLong m_NumDeletedObjects;
-
-    /// Hash map that stores weak pointers to the referenced objects
-    typedef std::pair<const ResourceDescType, RefCntWeakPtr<IDeviceObject>>                                                                                           HashMapElem;
-    std::unordered_map<ResourceDescType, RefCntWeakPtr<IDeviceObject>, std::hash<ResourceDescType>, std::equal_to<ResourceDescType>, STDAllocatorRawMem<HashMapElem>> m_DescToObjHashMap;
+    std::vector<std::unique_ptr<Shard>> m_Shards;
 
     /// Registry name used for debug output
     const String m_RegistryName;
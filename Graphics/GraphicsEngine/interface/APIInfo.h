@@ -30,7 +30,7 @@
 /// \file
 /// Diligent API information
 
-#define DILIGENT_API_VERSION 240081
+#define DILIGENT_API_VERSION 240082
 
 #include "../../../Primitives/interface/BasicTypes.h"
 
@@ -298,7 +298,27 @@ struct DrawIndirectAttribs
 
     /// Offset from the beginning of the buffer to the location of draw command attributes.
     Uint32 IndirectDrawArgsOffset   DEFAULT_INITIALIZER(0);
-    
+
+    /// The number of draw commands to execute. When pCounterBuffer is not null, this is
+    /// the maximum number of draws; the actual number is read from the counter buffer.
+    Uint32 DrawCount                DEFAULT_INITIALIZER(1);
+
+    /// The distance, in bytes, between consecutive draw command attributes in the buffer.
+    /// Must be a multiple of 4 and not less than the size of the attributes (16 bytes).
+    /// Zero means the attributes are tightly packed.
+    Uint32 DrawArgsStride           DEFAULT_INITIALIZER(0);
+
+    /// Optional buffer that contains the number of draws to execute as a 32-bit unsigned integer.
+    /// The buffer must have been created with BIND_INDIRECT_DRAW_ARGS flag.
+    /// Requires DeviceFeatures::DrawIndirectCounterBuffer feature.
+    IBuffer* pCounterBuffer         DEFAULT_INITIALIZER(nullptr);
+
+    /// Offset from the beginning of the counter buffer to the location of the draw count.
+    Uint32 CounterOffset            DEFAULT_INITIALIZER(0);
+
+    /// State transition mode for the counter buffer.
+    RESOURCE_STATE_TRANSITION_MODE CounterBufferStateTransitionMode DEFAULT_INITIALIZER(RESOURCE_STATE_TRANSITION_MODE_NONE);
+
 
 #if DILIGENT_CPP_INTERFACE
     /// Initializes the structure members with default values
@@ -309,6 +329,11 @@ struct DrawIndirectAttribs
     /// Flags                                    | DRAW_FLAG_NONE
     /// IndirectAttribsBufferStateTransitionMode | RESOURCE_STATE_TRANSITION_MODE_NONE
     /// IndirectDrawArgsOffset                   | 0
+    /// DrawCount                                | 1
+    /// DrawArgsStride                           | 0
+    /// pCounterBuffer                           | nullptr
+    /// CounterOffset                            | 0
+    /// CounterBufferStateTransitionMode         | RESOURCE_STATE_TRANSITION_MODE_NONE
     DrawIndirectAttribs()noexcept{}
 
     /// Initializes the structure members with user-specified values.
@@ -342,6 +367,26 @@ struct DrawIndexedIndirectAttribs
     /// Offset from the beginning of the buffer to the location of draw command attributes.
     Uint32 IndirectDrawArgsOffset        DEFAULT_INITIALIZER(0);
 
+    /// The number of draw commands to execute. When pCounterBuffer is not null, this is
+    /// the maximum number of draws; the actual number is read from the counter buffer.
+    Uint32 DrawCount                     DEFAULT_INITIALIZER(1);
+
+    /// The distance, in bytes, between consecutive draw command attributes in the buffer.
+    /// Must be a multiple of 4 and not less than the size of the attributes (20 bytes).
+    /// Zero means the attributes are tightly packed.
+    Uint32 DrawArgsStride                DEFAULT_INITIALIZER(0);
+
+    /// Optional buffer that contains the number of draws to execute as a 32-bit unsigned integer.
+    /// The buffer must have been created with BIND_INDIRECT_DRAW_ARGS flag.
+    /// Requires DeviceFeatures::DrawIndirectCounterBuffer feature.
+    IBuffer* pCounterBuffer              DEFAULT_INITIALIZER(nullptr);
+
+    /// Offset from the beginning of the counter buffer to the location of the draw count.
+    Uint32 CounterOffset                 DEFAULT_INITIALIZER(0);
+
+    /// State transition mode for the counter buffer.
+    RESOURCE_STATE_TRANSITION_MODE CounterBufferStateTransitionMode DEFAULT_INITIALIZER(RESOURCE_STATE_TRANSITION_MODE_NONE);
+
 
 #if DILIGENT_CPP_INTERFACE
     /// Initializes the structure members with default values
@@ -353,6 +398,11 @@ struct DrawIndexedIndirectAttribs
     /// Flags                                    | DRAW_FLAG_NONE
     /// IndirectAttribsBufferStateTransitionMode | RESOURCE_STATE_TRANSITION_MODE_NONE
     /// IndirectDrawArgsOffset                   | 0
+    /// DrawCount                                | 1
+    /// DrawArgsStride                           | 0
+    /// pCounterBuffer                           | nullptr
+    /// CounterOffset                            | 0
+    /// CounterBufferStateTransitionMode         | RESOURCE_STATE_TRANSITION_MODE_NONE
     DrawIndexedIndirectAttribs()noexcept{}
 
     /// Initializes the structure members with user-specified values.
@@ -1662,11 +1712,17 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContext, IObject)
     ///                                  Uint32 NumInstances;
     ///                                  Uint32 StartVertexLocation;
     ///                                  Uint32 FirstInstanceLocation;
+    ///                              When Attribs.DrawCount is greater than 1, the buffer contains an array of
+    ///                              such structures separated by Attribs.DrawArgsStride bytes.
     ///
-    /// \remarks  If IndirectAttribsBufferStateTransitionMode member is Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
-    ///           the method may transition the state of the indirect draw arguments buffer. This is not a thread safe operation, 
+    /// \remarks  If IndirectAttribsBufferStateTransitionMode or CounterBufferStateTransitionMode member is
+    ///           Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION, the method may transition the state of the indirect
+    ///           draw arguments buffer or the counter buffer. This is not a thread safe operation,
     ///           so no other thread is allowed to read or write the state of the buffer.
     ///
+    ///           Backends that do not natively support multi-draw indirect commands
+    ///           execute DrawCount individual indirect draws.
+    ///
     ///           If Diligent::DRAW_FLAG_VERIFY_STATES flag is set, the method reads the state of vertex/index
     ///           buffers, so no other threads are allowed to alter the states of the same resources.
     ///           It is OK to read these states.
@@ -1688,11 +1744,17 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContext, IObject)
     ///                                  Uint32 FirstIndexLocation;
     ///                                  Uint32 BaseVertex;
     ///                                  Uint32 FirstInstanceLocation
+    ///                              When Attribs.DrawCount is greater than 1, the buffer contains an array of
+    ///                              such structures separated by Attribs.DrawArgsStride bytes.
     ///
-    /// \remarks  If IndirectAttribsBufferStateTransitionMode member is Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
-    ///           the method may transition the state of the indirect draw arguments buffer. This is not a thread safe operation, 
+    /// \remarks  If IndirectAttribsBufferStateTransitionMode or CounterBufferStateTransitionMode member is
+    ///           Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION, the method may transition the state of the indirect
+    ///           draw arguments buffer or the counter buffer. This is not a thread safe operation,
     ///           so no other thread is allowed to read or write the state of the buffer.
     ///
+    ///           Backends that do not natively support multi-draw indirect commands
+    ///           execute DrawCount individual indirect draws.
+    ///
     ///           If Diligent::DRAW_FLAG_VERIFY_STATES flag is set, the method reads the state of vertex/index
     ///           buffers, so no other threads are allowed to alter the states of the same resources.
     ///           It is OK to read these states.
@@ -1884,6 +1946,27 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContext, IObject)
                                       bool      FlushContext) PURE;
 
 
+    /// Waits until the specified fence reaches or exceeds the specified value, on the device.
+
+    /// \note The method does not block the execution of the calling thread. It instructs the GPU to
+    ///       wait for the fence before executing the commands that are recorded after the call.
+    ///
+    /// \param [in] pFence - The fence to wait. The fence may be signaled by another immediate context.
+    /// \param [in] Value  - The value that the context is waiting for the fence to reach.
+    ///
+    /// \remarks    Wait is only allowed for immediate contexts.\n
+    ///             The method submits the commands recorded before the call (see IDeviceContext::Flush()),
+    ///             so an application must explicitly reset the PSO and bind all required shader resources
+    ///             after the call.\n
+    ///             The context that signals the fence must have been flushed after IDeviceContext::SignalFence()
+    ///             was called and before this method is called, otherwise the GPU may never continue.\n
+    ///             Backends that execute all commands on a single queue (Direct3D11, OpenGL) process the commands
+    ///             in submission order, and the method only flushes the context.
+    VIRTUAL void METHOD(DeviceWaitForFence)(THIS_
+                                            IFence*   pFence,
+                                            Uint64    Value) PURE;
+
+
     /// Submits all outstanding commands for execution to the GPU and waits until they are complete.
 
     /// \note The method blocks the execution of the calling thread until the wait is complete.
@@ -2234,6 +2317,7 @@ DILIGENT_END_INTERFACE
 #    define IDeviceContext_ExecuteCommandList(This, ...)        CALL_IFACE_METHOD(DeviceContext, ExecuteCommandList,        This, __VA_ARGS__)
 #    define IDeviceContext_SignalFence(This, ...)               CALL_IFACE_METHOD(DeviceContext, SignalFence,               This, __VA_ARGS__)
 #    define IDeviceContext_WaitForFence(This, ...)              CALL_IFACE_METHOD(DeviceContext, WaitForFence,              This, __VA_ARGS__)
+#    define IDeviceContext_DeviceWaitForFence(This, ...)        CALL_IFACE_METHOD(DeviceContext, DeviceWaitForFence,        This, __VA_ARGS__)
 #    define IDeviceContext_WaitForIdle(This, ...)               CALL_IFACE_METHOD(DeviceContext, WaitForIdle,               This, __VA_ARGS__)
 #    define IDeviceContext_BeginQuery(This, ...)                CALL_IFACE_METHOD(DeviceContext, BeginQuery,                This, __VA_ARGS__)
 #    define IDeviceContext_EndQuery(This, ...)                  CALL_IFACE_METHOD(DeviceContext, EndQuery,                  This, __VA_ARGS__)
@@ -935,7 +935,18 @@ DILIGENT_TYPED_ENUM(MISC_TEXTURE_FLAGS, Uint8)
     /// Allow automatic mipmap generation with ITextureView::GenerateMips()
 
     /// \note A texture must be created with BIND_RENDER_TARGET bind flag
-    MISC_TEXTURE_FLAG_GENERATE_MIPS = 0x01
+    MISC_TEXTURE_FLAG_GENERATE_MIPS = 0x01,
+
+    /// The texture is a transient resource whose contents do not need to be preserved
+    /// between the uses within a frame.
+
+    /// \remarks In Vulkan backend, memory of transient textures whose usage intervals
+    ///          do not overlap may be aliased (see IRenderDeviceVk::CreateTransientTexture()),
+    ///          and lazily allocated memory is used for attachments when available.
+    ///          Contents of a transient texture are undefined every time it is first used in
+    ///          its interval. Only USAGE_DEFAULT textures without initial data may be transient.
+    ///          Other backends ignore this flag.
+    MISC_TEXTURE_FLAG_TRANSIENT = 0x02
 };
 DEFINE_FLAG_ENUM_OPERATORS(MISC_TEXTURE_FLAGS)
 
@@ -1633,6 +1644,10 @@ struct DeviceFeatures
     /// Indicates if device supports reading 8-bit types from uniform buffers.
     DEVICE_FEATURE_STATE UniformBuffer8BitAccess          DEFAULT_INITIALIZER(DEVICE_FEATURE_STATE_DISABLED);
 
+    /// Indicates if device supports fetching the number of draws executed by indirect draw commands
+    /// from a GPU buffer (see DrawIndirectAttribs::pCounterBuffer).
+    DEVICE_FEATURE_STATE DrawIndirectCounterBuffer        DEFAULT_INITIALIZER(DEVICE_FEATURE_STATE_DISABLED);
+
 
 #if DILIGENT_CPP_INTERFACE
     DeviceFeatures() noexcept {}
@@ -1669,10 +1684,11 @@ struct DeviceFeatures
         ShaderInputOutput16               {State},
         ShaderInt8                        {State},
         ResourceBuffer8BitAccess          {State},
-        UniformBuffer8BitAccess           {State}
+        UniformBuffer8BitAccess           {State},
+        DrawIndirectCounterBuffer         {State}
     {
 #   if defined(_MSC_VER) && defined(_WIN64)
-        static_assert(sizeof(*this) == 32, "Did you add a new feature to DeviceFeatures? Please handle its status above.");
+        static_assert(sizeof(*this) == 33, "Did you add a new feature to DeviceFeatures? Please handle its status above.");
 #   endif
     }
 #endif
@@ -2214,6 +2230,16 @@ struct EngineVkCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
 #endif
     ;
 
+    /// Size of the descriptor pool that is used to allocate descriptor sets for runtime-sized
+    /// shader resource arrays when descriptor indexing is enabled (see EnableDescriptorIndexing).
+    /// Every shader resource binding that has such arrays allocates one set from this pool.
+    VulkanDescriptorPoolSize UpdateAfterBindDescriptorPoolSize
+#if DILIGENT_CPP_INTERFACE
+        //Max  SepSm  CmbSm  SmpImg StrImg   UB     SB    UTxB   StTxB  InptAtt  AccelSt
+        {  64,  4096, 16384, 16384,  4096,     0,     0,  4096,  4096,     0,       0}
+#endif
+    ;
+
     /// Allocation granularity for device-local memory
     Uint32 DeviceLocalMemoryPageSize        DEFAULT_INITIALIZER(16 << 20);
 
@@ -2245,6 +2271,64 @@ struct EngineVkCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
     /// the global dynamic heap to perform lock-free dynamic suballocations
     Uint32 DynamicHeapPageSize              DEFAULT_INITIALIZER(256 << 10);
 
+    /// Whether to use VK_KHR_dynamic_rendering for render targets bound by IDeviceContext::SetRenderTargets(),
+    /// if the extension is supported by the device.
+
+    /// When dynamic rendering is used, device contexts begin rendering directly from the bound texture views,
+    /// and pipeline states that are not created with an explicit render pass are created against the
+    /// render target formats. This avoids render pass and framebuffer cache lookups when render targets change.
+    /// Explicit render passes (IDeviceContext::BeginRenderPass()) are not affected.
+    bool EnableDynamicRendering             DEFAULT_INITIALIZER(true);
+
+    /// Whether to use VK_KHR_push_descriptor for dynamic shader variables, if the extension is supported by the device.
+
+    /// When push descriptors are used, descriptors of dynamic variables are written directly into the command
+    /// buffer by IDeviceContext::CommitShaderResources() instead of being written to a descriptor set allocated
+    /// from the per-context dynamic descriptor pools. Pipelines whose dynamic variables include uniform or storage
+    /// buffers, or whose dynamic descriptor count exceeds the device limit, keep using dynamic descriptor sets.
+    bool EnablePushDescriptors              DEFAULT_INITIALIZER(true);
+
+    /// Whether to use VK_EXT_descriptor_indexing for runtime-sized shader resource arrays, if the device supports
+    /// runtime descriptor arrays, partially bound descriptors and update-after-bind descriptors.
+
+    /// Runtime-sized arrays of textures, texel buffers and samplers (e.g. `Texture2D g_Textures[]`) are placed into
+    /// a separate descriptor set whose bindings are created with the update-after-bind and partially-bound flags.
+    /// Such arrays must be mutable shader variables. Their elements may be set at any time, also after the shader
+    /// resource binding has been committed, and every element that is set writes only its own descriptor.
+    /// Elements that the shaders do not access may be left unbound.
+    bool EnableDescriptorIndexing           DEFAULT_INITIALIZER(true);
+
+    /// The number of descriptors in every runtime-sized shader resource array.
+
+    /// The value is clamped to the per-stage update-after-bind limits of the device.
+    Uint32 RuntimeDescriptorArraySize       DEFAULT_INITIALIZER(4096);
+
+    /// Whether to create a queue from a dedicated transfer queue family, if the device exposes one.
+
+    /// When the transfer queue is created, initial data of buffers and textures is uploaded
+    /// on that queue, and the ownership of the resources is then transferred to the graphics queue.
+    /// The graphics queue waits for the uploads before executing the next command buffer submitted
+    /// by the immediate context.
+    bool EnableTransferQueue                DEFAULT_INITIALIZER(true);
+
+    /// Number of compute-only immediate contexts to create.
+
+    /// Every compute context submits commands to its own queue from a compute-only queue family, so
+    /// its work runs concurrently with the work of the main immediate context. Pointers to the contexts
+    /// are written to the ppContexts array after the deferred contexts, starting at position
+    /// 1 + NumDeferredContexts. If the device has no compute-only queue family, or the family has fewer
+    /// queues than requested, the remaining pointers are null.
+    ///
+    /// \remarks   Compute contexts only support dispatch, copy, ray tracing and acceleration structure commands.
+    ///            Use IDeviceContext::SignalFence() and IDeviceContext::DeviceWaitForFence() to synchronize
+    ///            the contexts on the GPU. Resources must not be in graphics-only states (e.g. render target
+    ///            or depth write) when they are used by a compute context.\n
+    ///            When compute contexts are created, buffers and textures are shared between queue families
+    ///            (VK_SHARING_MODE_CONCURRENT), and the transfer queue is not used.\n
+    ///            Released resources are not destroyed until every compute context has been flushed,
+    ///            so compute contexts must be flushed and finish their frames regularly.
+    Uint32 NumComputeContexts               DEFAULT_INITIALIZER(0);
+
     /// Query pool size for each query type.
     Uint32 QueryPoolSizes[QUERY_TYPE_NUM_TYPES]
 #if DILIGENT_CPP_INTERFACE
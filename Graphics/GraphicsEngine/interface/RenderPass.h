@@ -357,6 +357,45 @@ struct RenderPassDesc DILIGENT_DERIVE(DeviceObjectAttribs)
 
     /// Pointer to the array of subpass dependencies, see Diligent::SubpassDependencyDesc.
     const SubpassDependencyDesc*     pDependencies      DEFAULT_INITIALIZER(nullptr);
+
+#if DILIGENT_CPP_INTERFACE
+    /// Tests if two render pass descriptions are equal.
+
+    /// \param [in] RHS - reference to the structure to compare with.
+    ///
+    /// \return     true if all members of the two structures *except for the Name* are equal,
+    ///             and false otherwise.
+    ///
+    /// \note   The operator ignores the Name field as it is used for debug purposes and
+    ///         doesn't affect the render pass properties.
+    bool operator == (const RenderPassDesc& RHS)const
+    {
+        if (AttachmentCount != RHS.AttachmentCount ||
+            SubpassCount    != RHS.SubpassCount    ||
+            DependencyCount != RHS.DependencyCount)
+            return false;
+
+        for(Uint32 i=0; i < AttachmentCount; ++i)
+        {
+            if (!(pAttachments[i] == RHS.pAttachments[i]))
+                return false;
+        }
+
+        for(Uint32 i=0; i < SubpassCount; ++i)
+        {
+            if (!(pSubpasses[i] == RHS.pSubpasses[i]))
+                return false;
+        }
+
+        for(Uint32 i=0; i < DependencyCount; ++i)
+        {
+            if (!(pDependencies[i] == RHS.pDependencies[i]))
+                return false;
+        }
+
+        return true;
+    }
+#endif
 };
 typedef struct RenderPassDesc RenderPassDesc;
 
@@ -27,14 +27,73 @@
 
 #include "DefaultShaderSourceStreamFactory.h"
 
+#include <mutex>
+#include <unordered_map>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
 #include "ObjectBase.hpp"
 #include "RefCntAutoPtr.hpp"
 #include "EngineMemory.h"
 #include "BasicFileStream.hpp"
+#include "MemoryFileStream.hpp"
+#include "DataBlobImpl.hpp"
 
 namespace Diligent
 {
 
+namespace
+{
+
+struct FileTimeStamp
+{
+    Int64  ModificationTime = 0;
+    Uint64 Size             = 0;
+
+    bool operator==(const FileTimeStamp& rhs) const
+    {
+        return ModificationTime == rhs.ModificationTime && Size == rhs.Size;
+    }
+};
+
+// Returns false if the file time stamp can't be queried (e.g. the file has been deleted).
+bool GetFileTimeStamp(const String& FullPath, FileTimeStamp& TimeStamp)
+{
+#if PLATFORM_ANDROID
+    // Shader sources are read from the application package and can't change
+    (void)FullPath;
+    TimeStamp = FileTimeStamp{};
+    return true;
+#else
+    // Query the same path the file stream opens
+    auto Path = FileSystem::GetFullPath(FullPath.c_str());
+    FileSystem::CorrectSlashes(Path, FileSystem::GetSlashSymbol());
+#    if PLATFORM_WIN32 || PLATFORM_UNIVERSAL_WINDOWS
+    struct _stat64 FileStat;
+    if (_stat64(Path.c_str(), &FileStat) != 0)
+        return false;
+    TimeStamp.ModificationTime = static_cast<Int64>(FileStat.st_mtime);
+    TimeStamp.Size             = static_cast<Uint64>(FileStat.st_size);
+    return true;
+#    else
+    struct stat FileStat;
+    if (stat(Path.c_str(), &FileStat) != 0)
+        return false;
+#        if PLATFORM_MACOS || PLATFORM_IOS || PLATFORM_TVOS
+    const auto& MTime = FileStat.st_mtimespec;
+#        else
+    const auto& MTime = FileStat.st_mtim;
+#        endif
+    TimeStamp.ModificationTime = static_cast<Int64>(MTime.tv_sec) * 1000000000 + static_cast<Int64>(MTime.tv_nsec);
+    TimeStamp.Size             = static_cast<Uint64>(FileStat.st_size);
+    return true;
+#    endif
+#endif
+}
+
+} // namespace
+
 class DefaultShaderSourceStreamFactory final : public ObjectBase<IShaderSourceInputStreamFactory>
 {
 public:
@@ -49,7 +108,27 @@ public:
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_IShaderSourceInputStreamFactory, ObjectBase<IShaderSourceInputStreamFactory>);
 
 private:
+    // Finds the first search directory that contains the file.
+    // Returns false if the file is not found in any of them.
+    bool ResolveFile(const Char* Name, String& FullPath) const;
+
+    // Reads the contents of the resolved file
+    static RefCntAutoPtr<IDataBlob> LoadFile(const String& FullPath);
+
     std::vector<String> m_SearchDirectories;
+
+    // Shader source files are typically included many times (by every shader and every permutation
+    // of a shader), so the factory keeps the contents of all files it has opened in memory.
+    // The file name is resolved against the search directories on every request, so that a file
+    // added to an earlier directory takes precedence. The cache is keyed by the resolved path and
+    // every cached entry is validated against the file modification time and size before it is used.
+    struct CachedFile
+    {
+        FileTimeStamp            TimeStamp;
+        RefCntAutoPtr<IDataBlob> pData;
+    };
+    std::mutex                             m_CacheMtx;
+    std::unordered_map<String, CachedFile> m_Cache;
 };
 
 DefaultShaderSourceStreamFactory::DefaultShaderSourceStreamFactory(IReferenceCounters* pRefCounters, const Char* SearchDirectories) :
@@ -86,35 +165,89 @@ void DefaultShaderSourceStreamFactory::CreateInputStream(const Char*   Name,
     CreateInputStream2(Name, CREATE_SHADER_SOURCE_INPUT_STREAM_FLAG_NONE, ppStream);
 }
 
+bool DefaultShaderSourceStreamFactory::ResolveFile(const Char* Name, String& FullPath) const
+{
+    for (const auto& SearchDir : m_SearchDirectories)
+    {
+        FullPath = SearchDir + ((Name[0] == '\\' || Name[0] == '/') ? Name + 1 : Name);
+        if (FileSystem::FileExists(FullPath.c_str()))
+            return true;
+    }
+    FullPath.clear();
+    return false;
+}
+
+RefCntAutoPtr<IDataBlob> DefaultShaderSourceStreamFactory::LoadFile(const String& FullPath)
+{
+    auto pBasicFileStream = MakeNewRCObj<BasicFileStream>()(FullPath.c_str(), EFileAccessMode::Read);
+    if (!pBasicFileStream->IsValid())
+        return {};
+
+    RefCntAutoPtr<IDataBlob> pData{MakeNewRCObj<DataBlobImpl>()(0)};
+    pBasicFileStream->ReadBlob(pData);
+    return pData;
+}
+
 void DefaultShaderSourceStreamFactory::CreateInputStream2(const Char*                             Name,
                                                           CREATE_SHADER_SOURCE_INPUT_STREAM_FLAGS Flags,
                                                           IFileStream**                           ppStream)
 {
-    bool                                     bFileCreated = false;
-    Diligent::RefCntAutoPtr<BasicFileStream> pBasicFileStream;
-    for (const auto& SearchDir : m_SearchDirectories)
+    DEV_CHECK_ERR(Name != nullptr && Name[0] != '\0', "File name must not be null or empty");
+    DEV_CHECK_ERR(ppStream != nullptr, "ppStream must not be null");
+    *ppStream = nullptr;
+
+    RefCntAutoPtr<IDataBlob> pData;
+
+    String FullPath;
+    if (ResolveFile(Name, FullPath))
     {
-        String FullPath = SearchDir + ((Name[0] == '\\' || Name[0] == '/') ? Name + 1 : Name);
-        if (!FileSystem::FileExists(FullPath.c_str()))
-            continue;
-        pBasicFileStream = MakeNewRCObj<BasicFileStream>()(FullPath.c_str(), EFileAccessMode::Read);
-        if (pBasicFileStream->IsValid())
+        // Stat the file outside of the lock
+        FileTimeStamp TimeStamp;
+        bool          TimeStampValid = GetFileTimeStamp(FullPath, TimeStamp);
+
+        if (TimeStampValid)
         {
-            bFileCreated = true;
-            break;
+            std::lock_guard<std::mutex> Lock{m_CacheMtx};
+
+            auto it = m_Cache.find(FullPath);
+            if (it != m_Cache.end() && it->second.TimeStamp == TimeStamp)
+                pData = it->second.pData;
         }
-        else
+
+        if (!pData)
         {
-            pBasicFileStream.Release();
+            pData = LoadFile(FullPath);
+            if (pData && TimeStampValid && TimeStamp.Size != pData->GetSize())
+            {
+                // The file has been modified while it was being read
+                TimeStampValid = GetFileTimeStamp(FullPath, TimeStamp);
+                pData          = LoadFile(FullPath);
+                TimeStampValid = TimeStampValid && pData && TimeStamp.Size == pData->GetSize();
+            }
+
+            std::lock_guard<std::mutex> Lock{m_CacheMtx};
+            if (pData && TimeStampValid)
+            {
+                auto& NewEntry = m_Cache[FullPath];
+
+                NewEntry.TimeStamp = TimeStamp;
+                NewEntry.pData     = pData;
+            }
+            else
+            {
+                m_Cache.erase(FullPath);
+            }
         }
     }
-    if (bFileCreated)
+
+    if (pData)
     {
-        pBasicFileStream->QueryInterface(IID_FileStream, reinterpret_cast<IObject**>(ppStream));
+        // Cached blobs are shared between all streams, and memory file streams are never written to
+        RefCntAutoPtr<MemoryFileStream> pMemStream{MakeNewRCObj<MemoryFileStream>()(pData)};
+        pMemStream->QueryInterface(IID_FileStream, reinterpret_cast<IObject**>(ppStream));
     }
     else
     {
-        *ppStream = nullptr;
         if ((Flags & CREATE_SHADER_SOURCE_INPUT_STREAM_FLAG_SILENT) == 0)
         {
             LOG_ERROR("Failed to create input stream for source file ", Name);
@@ -101,6 +101,26 @@ bool VerifyDrawIndirectAttribs(const DrawIndirectAttribs& Attribs, const IBuffer
     CHECK_DRAW_INDIRECT_ATTRIBS((pAttribsBuffer->GetDesc().BindFlags & BIND_INDIRECT_DRAW_ARGS) != 0,
                                 "indirect draw arguments buffer '", pAttribsBuffer->GetDesc().Name, "' was not created with BIND_INDIRECT_DRAW_ARGS flag.");
 
+    CHECK_DRAW_INDIRECT_ATTRIBS(Attribs.DrawCount != 0, "DrawCount must not be zero.");
+    CHECK_DRAW_INDIRECT_ATTRIBS(Attribs.DrawArgsStride == 0 || (Attribs.DrawArgsStride % 4 == 0 && Attribs.DrawArgsStride >= 16),
+                                "DrawArgsStride (", Attribs.DrawArgsStride, ") must be a multiple of 4 and not less than 16.");
+    {
+        const Uint32 Stride       = Attribs.DrawArgsStride != 0 ? Attribs.DrawArgsStride : 16;
+        const Uint64 RequiredSize = Uint64{Attribs.IndirectDrawArgsOffset} + Uint64{Stride} * (Attribs.DrawCount - 1) + 16;
+        CHECK_DRAW_INDIRECT_ATTRIBS(RequiredSize <= pAttribsBuffer->GetDesc().uiSizeInBytes,
+                                    "indirect draw arguments buffer '", pAttribsBuffer->GetDesc().Name, "' is too small: ", RequiredSize,
+                                    " bytes are required to hold ", Attribs.DrawCount, " draw command(s) at offset ", Attribs.IndirectDrawArgsOffset, ".");
+    }
+    if (Attribs.pCounterBuffer != nullptr)
+    {
+        const auto& CounterBuffDesc = Attribs.pCounterBuffer->GetDesc();
+        CHECK_DRAW_INDIRECT_ATTRIBS((CounterBuffDesc.BindFlags & BIND_INDIRECT_DRAW_ARGS) != 0,
+                                    "counter buffer '", CounterBuffDesc.Name, "' was not created with BIND_INDIRECT_DRAW_ARGS flag.");
+        CHECK_DRAW_INDIRECT_ATTRIBS(Attribs.CounterOffset % 4 == 0, "CounterOffset (", Attribs.CounterOffset, ") must be a multiple of 4.");
+        CHECK_DRAW_INDIRECT_ATTRIBS(Uint64{Attribs.CounterOffset} + sizeof(Uint32) <= CounterBuffDesc.uiSizeInBytes,
+                                    "CounterOffset (", Attribs.CounterOffset, ") is out of bounds of counter buffer '", CounterBuffDesc.Name, "'.");
+    }
+
 #undef CHECK_DRAW_INDIRECT_ATTRIBS
 
     return true;
@@ -117,6 +137,26 @@ bool VerifyDrawIndexedIndirectAttribs(const DrawIndexedIndirectAttribs& Attribs,
                                         "indirect draw arguments buffer '",
                                         pAttribsBuffer->GetDesc().Name, "' was not created with BIND_INDIRECT_DRAW_ARGS flag.");
 
+    CHECK_DRAW_INDEXED_INDIRECT_ATTRIBS(Attribs.DrawCount != 0, "DrawCount must not be zero.");
+    CHECK_DRAW_INDEXED_INDIRECT_ATTRIBS(Attribs.DrawArgsStride == 0 || (Attribs.DrawArgsStride % 4 == 0 && Attribs.DrawArgsStride >= 20),
+                                        "DrawArgsStride (", Attribs.DrawArgsStride, ") must be a multiple of 4 and not less than 20.");
+    {
+        const Uint32 Stride       = Attribs.DrawArgsStride != 0 ? Attribs.DrawArgsStride : 20;
+        const Uint64 RequiredSize = Uint64{Attribs.IndirectDrawArgsOffset} + Uint64{Stride} * (Attribs.DrawCount - 1) + 20;
+        CHECK_DRAW_INDEXED_INDIRECT_ATTRIBS(RequiredSize <= pAttribsBuffer->GetDesc().uiSizeInBytes,
+                                            "indirect draw arguments buffer '", pAttribsBuffer->GetDesc().Name, "' is too small: ", RequiredSize,
+                                            " bytes are required to hold ", Attribs.DrawCount, " draw command(s) at offset ", Attribs.IndirectDrawArgsOffset, ".");
+    }
+    if (Attribs.pCounterBuffer != nullptr)
+    {
+        const auto& CounterBuffDesc = Attribs.pCounterBuffer->GetDesc();
+        CHECK_DRAW_INDEXED_INDIRECT_ATTRIBS((CounterBuffDesc.BindFlags & BIND_INDIRECT_DRAW_ARGS) != 0,
+                                            "counter buffer '", CounterBuffDesc.Name, "' was not created with BIND_INDIRECT_DRAW_ARGS flag.");
+        CHECK_DRAW_INDEXED_INDIRECT_ATTRIBS(Attribs.CounterOffset % 4 == 0, "CounterOffset (", Attribs.CounterOffset, ") must be a multiple of 4.");
+        CHECK_DRAW_INDEXED_INDIRECT_ATTRIBS(Uint64{Attribs.CounterOffset} + sizeof(Uint32) <= CounterBuffDesc.uiSizeInBytes,
+                                            "CounterOffset (", Attribs.CounterOffset, ") is out of bounds of counter buffer '", CounterBuffDesc.Name, "'.");
+    }
+
 #undef CHECK_DRAW_INDEXED_INDIRECT_ATTRIBS
 
     return true;
@@ -148,6 +148,9 @@ void ValidateTextureDesc(const TextureDesc& Desc) noexcept(false)
     {
         LOG_TEXTURE_ERROR_AND_THROW("USAGE_UNIFIED textures are currently not supported.");
     }
+
+    if ((Desc.MiscFlags & MISC_TEXTURE_FLAG_TRANSIENT) != 0 && Desc.Usage != USAGE_DEFAULT)
+        LOG_TEXTURE_ERROR_AND_THROW("Transient textures must use USAGE_DEFAULT.");
 }
 
 
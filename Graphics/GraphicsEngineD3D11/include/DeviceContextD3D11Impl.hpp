@@ -238,6 +238,9 @@ public:
     /// Implementation of IDeviceContext::WaitForFence() in Direct3D11 backend.
     virtual void DILIGENT_CALL_TYPE WaitForFence(IFence* pFence, Uint64 Value, bool FlushContext) override final;
 
+    /// Implementation of IDeviceContext::DeviceWaitForFence() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE DeviceWaitForFence(IFence* pFence, Uint64 Value) override final;
+
     /// Implementation of IDeviceContext::WaitForIdle() in Direct3D11 backend.
     virtual void DILIGENT_CALL_TYPE WaitForIdle() override final;
 
@@ -867,9 +867,14 @@ void DeviceContextD3D11Impl::DrawIndirect(const DrawIndirectAttribs& Attribs, IB
 
     PrepareForDraw(Attribs.Flags);
 
+    DEV_CHECK_ERR(Attribs.pCounterBuffer == nullptr, "Indirect draw counter buffer is not supported in Direct3D11");
+
     auto*         pIndirectDrawAttribsD3D11 = ValidatedCast<BufferD3D11Impl>(pAttribsBuffer);
     ID3D11Buffer* pd3d11ArgsBuff            = pIndirectDrawAttribsD3D11->m_pd3d11Buffer;
-    m_pd3d11DeviceContext->DrawInstancedIndirect(pd3d11ArgsBuff, Attribs.IndirectDrawArgsOffset);
+    // Direct3D11 has no multi-draw indirect command, so issue the draws one by one
+    const Uint32 ArgsStride = Attribs.DrawArgsStride != 0 ? Attribs.DrawArgsStride : Uint32{sizeof(UINT) * 4};
+    for (Uint32 i = 0; i < Attribs.DrawCount; ++i)
+        m_pd3d11DeviceContext->DrawInstancedIndirect(pd3d11ArgsBuff, Attribs.IndirectDrawArgsOffset + ArgsStride * i);
 }
 
 
@@ -880,9 +885,14 @@ void DeviceContextD3D11Impl::DrawIndexedIndirect(const DrawIndexedIndirectAttrib
 
     PrepareForIndexedDraw(Attribs.Flags, Attribs.IndexType);
 
+    DEV_CHECK_ERR(Attribs.pCounterBuffer == nullptr, "Indirect draw counter buffer is not supported in Direct3D11");
+
     auto*         pIndirectDrawAttribsD3D11 = ValidatedCast<BufferD3D11Impl>(pAttribsBuffer);
     ID3D11Buffer* pd3d11ArgsBuff            = pIndirectDrawAttribsD3D11->m_pd3d11Buffer;
-    m_pd3d11DeviceContext->DrawIndexedInstancedIndirect(pd3d11ArgsBuff, Attribs.IndirectDrawArgsOffset);
+    // Direct3D11 has no multi-draw indirect command, so issue the draws one by one
+    const Uint32 ArgsStride = Attribs.DrawArgsStride != 0 ? Attribs.DrawArgsStride : Uint32{sizeof(UINT) * 5};
+    for (Uint32 i = 0; i < Attribs.DrawCount; ++i)
+        m_pd3d11DeviceContext->DrawIndexedInstancedIndirect(pd3d11ArgsBuff, Attribs.IndirectDrawArgsOffset + ArgsStride * i);
 }
 
 void DeviceContextD3D11Impl::DrawMesh(const DrawMeshAttribs& Attribs)
@@ -1998,6 +2008,15 @@ void DeviceContextD3D11Impl::WaitForFence(IFence* pFence, Uint64 Value, bool Flu
     pFenceD3D11Impl->Wait(Value, FlushContext);
 }
 
+void DeviceContextD3D11Impl::DeviceWaitForFence(IFence* pFence, Uint64 Value)
+{
+    VERIFY(!m_bIsDeferred, "Fence can only be waited from immediate context");
+    DEV_CHECK_ERR(pFence != nullptr, "Fence must not be null");
+    // Direct3D11 executes all commands of the immediate context in submission order, so the fence
+    // has either been signaled by the preceding commands or will never be signaled by the context.
+    Flush();
+}
+
 void DeviceContextD3D11Impl::WaitForIdle()
 {
     VERIFY(!m_bIsDeferred, "Only immediate contexts can be idled");
@@ -178,11 +178,14 @@ RenderDeviceD3D11Impl::RenderDeviceD3D11Impl(IReferenceCounters*          pRefCo
     UNSUPPORTED_FEATURE(ShaderInt8,               "Native 8-bit shader operations are");
     UNSUPPORTED_FEATURE(ResourceBuffer8BitAccess, "8-bit native access to resource buffers is");
     UNSUPPORTED_FEATURE(UniformBuffer8BitAccess,  "8-bit native access to uniform buffers is");
+
+    // Direct3D11 has no equivalent of ExecuteIndirect's count buffer.
+    UNSUPPORTED_FEATURE(DrawIndirectCounterBuffer, "Indirect draw counter buffer is");
     // clang-format on
 #undef UNSUPPORTED_FEATURE
 
 #if defined(_MSC_VER) && defined(_WIN64)
-    static_assert(sizeof(DeviceFeatures) == 32, "Did you add a new feature to DeviceFeatures? Please handle its satus here.");
+    static_assert(sizeof(DeviceFeatures) == 33, "Did you add a new feature to DeviceFeatures? Please handle its satus here.");
 #endif
 
     auto& TexCaps = m_DeviceCaps.TexCaps;
@@ -380,13 +383,14 @@ void RenderDeviceD3D11Impl::CreateSampler(const SamplerDesc& SamplerDesc, ISampl
     CreateDeviceObject("sampler", SamplerDesc, ppSampler,
                        [&]() //
                        {
-                           m_SamplersRegistry.Find(SamplerDesc, reinterpret_cast<IDeviceObject**>(ppSampler));
+                           const auto SamplerHash = m_SamplersRegistry.ComputeHash(SamplerDesc);
+                           m_SamplersRegistry.Find(SamplerDesc, SamplerHash, reinterpret_cast<IDeviceObject**>(ppSampler));
                            if (*ppSampler == nullptr)
                            {
                                SamplerD3D11Impl* pSamplerD3D11{NEW_RC_OBJ(m_SamplerObjAllocator, "SamplerD3D11Impl instance", SamplerD3D11Impl)(this, SamplerDesc)};
                                pSamplerD3D11->QueryInterface(IID_Sampler, reinterpret_cast<IObject**>(ppSampler));
                                OnCreateDeviceObject(pSamplerD3D11);
-                               m_SamplersRegistry.Add(SamplerDesc, *ppSampler);
+                               m_SamplersRegistry.Add(SamplerDesc, SamplerHash, *ppSampler);
                            }
                        });
 }
@@ -447,9 +451,16 @@ void RenderDeviceD3D11Impl::CreateRenderPass(const RenderPassDesc& Desc, IRender
     CreateDeviceObject("RenderPass", Desc, ppRenderPass,
                        [&]() //
                        {
-                           RenderPassD3D11Impl* pRenderPassD3D11{NEW_RC_OBJ(m_RenderPassAllocator, "RenderPassD3D11Impl instance", RenderPassD3D11Impl)(this, Desc)};
-                           pRenderPassD3D11->QueryInterface(IID_RenderPass, reinterpret_cast<IObject**>(ppRenderPass));
-                           OnCreateDeviceObject(pRenderPassD3D11);
+                           ValidateRenderPassDesc(Desc);
+                           const auto RenderPassHash = m_RenderPassRegistry.ComputeHash(Desc);
+                           m_RenderPassRegistry.Find(Desc, RenderPassHash, reinterpret_cast<IDeviceObject**>(ppRenderPass));
+                           if (*ppRenderPass == nullptr)
+                           {
+                               RenderPassD3D11Impl* pRenderPassD3D11{NEW_RC_OBJ(m_RenderPassAllocator, "RenderPassD3D11Impl instance", RenderPassD3D11Impl)(this, Desc)};
+                               pRenderPassD3D11->QueryInterface(IID_RenderPass, reinterpret_cast<IObject**>(ppRenderPass));
+                               OnCreateDeviceObject(pRenderPassD3D11);
+                               m_RenderPassRegistry.Add(Desc, RenderPassHash, *ppRenderPass);
+                           }
                        });
 }
 
@@ -169,6 +169,17 @@ public:
         m_pCommandList->ExecuteIndirect(pCmdSignature, 1, pBuff, ArgsOffset, nullptr, 0);
     }
 
+    void ExecuteIndirect(ID3D12CommandSignature* pCmdSignature,
+                         Uint32                  MaxCommandCount,
+                         ID3D12Resource*         pArgsBuff,
+                         Uint64                  ArgsOffset,
+                         ID3D12Resource*         pCountBuff,
+                         Uint64                  CountBuffOffset)
+    {
+        FlushResourceBarriers();
+        m_pCommandList->ExecuteIndirect(pCmdSignature, MaxCommandCount, pArgsBuff, ArgsOffset, pCountBuff, CountBuffOffset);
+    }
+
     void                       SetID(const Char* ID) { m_ID = ID; }
     ID3D12GraphicsCommandList* GetCommandList() { return m_pCommandList; }
 
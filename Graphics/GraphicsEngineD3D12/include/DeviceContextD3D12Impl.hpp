@@ -243,6 +243,9 @@ public:
     /// Implementation of IDeviceContext::WaitForFence() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE WaitForFence(IFence* pFence, Uint64 Value, bool FlushContext) override final;
 
+    /// Implementation of IDeviceContext::DeviceWaitForFence() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE DeviceWaitForFence(IFence* pFence, Uint64 Value) override final;
+
     /// Implementation of IDeviceContext::WaitForIdle() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE WaitForIdle() override final;
 
@@ -383,6 +386,16 @@ private:
                                                  ID3D12Resource*&               pd3d12ArgsBuff,
                                                  Uint64&                        BuffDataStartByteOffset);
 
+    template <typename AttribsType>
+    __forceinline void ExecuteIndirectDraw(GraphicsContext&             GraphCtx,
+                                           const AttribsType&           Attribs,
+                                           IBuffer*                     pAttribsBuffer,
+                                           D3D12_INDIRECT_ARGUMENT_TYPE ArgType);
+
+    // Returns the command signature for the draw argument type with the given byte stride.
+    // Signatures for non-default strides are created on first use.
+    ID3D12CommandSignature* GetDrawIndirectSignature(D3D12_INDIRECT_ARGUMENT_TYPE ArgType, Uint32 ByteStride);
+
     struct TextureUploadSpace
     {
         D3D12DynamicAllocation Allocation;
@@ -433,6 +446,9 @@ private:
     CComPtr<ID3D12CommandSignature> m_pDispatchIndirectSignature;
     CComPtr<ID3D12CommandSignature> m_pDrawMeshIndirectSignature;
 
+    // Draw and draw indexed command signatures for custom argument strides, keyed by (argument type, stride)
+    std::unordered_map<Uint64, CComPtr<ID3D12CommandSignature>> m_CustomStrideDrawSignatures;
+
     D3D12DynamicHeap m_DynamicHeap;
 
     // Every context must use its own allocator that maintains individual list of retired descriptor heaps to
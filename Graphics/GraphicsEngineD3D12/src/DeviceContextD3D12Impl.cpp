@@ -547,6 +547,71 @@ void DeviceContextD3D12Impl::PrepareDrawIndirectBuffer(GraphicsContext&
     pd3d12ArgsBuff = pIndirectDrawAttribsD3D12->GetD3D12Buffer(BuffDataStartByteOffset, this);
 }
 
+ID3D12CommandSignature* DeviceContextD3D12Impl::GetDrawIndirectSignature(D3D12_INDIRECT_ARGUMENT_TYPE ArgType, Uint32 ByteStride)
+{
+    VERIFY_EXPR(ArgType == D3D12_INDIRECT_ARGUMENT_TYPE_DRAW || ArgType == D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED);
+    const Uint32 DefaultStride = ArgType == D3D12_INDIRECT_ARGUMENT_TYPE_DRAW ?
+        Uint32{sizeof(D3D12_DRAW_ARGUMENTS)} :
+        Uint32{sizeof(D3D12_DRAW_INDEXED_ARGUMENTS)};
+    if (ByteStride == 0 || ByteStride == DefaultStride)
+        return ArgType == D3D12_INDIRECT_ARGUMENT_TYPE_DRAW ? m_pDrawIndirectSignature : m_pDrawIndexedIndirectSignature;
+
+    const Uint64 Key        = (static_cast<Uint64>(ArgType) << 32u) | Uint64{ByteStride};
+    auto&        pSignature = m_CustomStrideDrawSignatures[Key];
+    if (!pSignature)
+    {
+        D3D12_INDIRECT_ARGUMENT_DESC IndirectArg = {};
+        IndirectArg.Type                         = ArgType;
+
+        D3D12_COMMAND_SIGNATURE_DESC CmdSignatureDesc = {};
+        CmdSignatureDesc.ByteStride                   = ByteStride;
+        CmdSignatureDesc.NumArgumentDescs             = 1;
+        CmdSignatureDesc.pArgumentDescs               = &IndirectArg;
+        CmdSignatureDesc.NodeMask                     = 0;
+
+        auto hr = m_pDevice->GetD3D12Device()->CreateCommandSignature(&CmdSignatureDesc, nullptr, __uuidof(pSignature), reinterpret_cast<void**>(static_cast<ID3D12CommandSignature**>(&pSignature)));
+        if (FAILED(hr))
+        {
+            LOG_ERROR_MESSAGE("Failed to create indirect draw command signature with byte stride ", ByteStride);
+            m_CustomStrideDrawSignatures.erase(Key);
+            return nullptr;
+        }
+    }
+    return pSignature;
+}
+
+template <typename AttribsType>
+void DeviceContextD3D12Impl::ExecuteIndirectDraw(GraphicsContext&             GraphCtx,
+                                                 const AttribsType&           Attribs,
+                                                 IBuffer*                     pAttribsBuffer,
+                                                 D3D12_INDIRECT_ARGUMENT_TYPE ArgType)
+{
+    ID3D12Resource* pd3d12ArgsBuff;
+    Uint64          BuffDataStartByteOffset;
+    PrepareDrawIndirectBuffer(GraphCtx, pAttribsBuffer, Attribs.IndirectAttribsBufferStateTransitionMode, pd3d12ArgsBuff, BuffDataStartByteOffset);
+
+    ID3D12Resource* pd3d12CountBuff          = nullptr;
+    Uint64          CountBuffDataStartOffset = 0;
+    if (Attribs.pCounterBuffer != nullptr)
+        PrepareDrawIndirectBuffer(GraphCtx, Attribs.pCounterBuffer, Attribs.CounterBufferStateTransitionMode, pd3d12CountBuff, CountBuffDataStartOffset);
+
+    auto* pSignature = GetDrawIndirectSignature(ArgType, Attribs.DrawArgsStride);
+    if (pSignature == nullptr)
+        return;
+
+    if (Attribs.DrawCount == 1 && pd3d12CountBuff == nullptr)
+    {
+        GraphCtx.ExecuteIndirect(pSignature, pd3d12ArgsBuff, Attribs.IndirectDrawArgsOffset + BuffDataStartByteOffset);
+    }
+    else
+    {
+        GraphCtx.ExecuteIndirect(pSignature, Attribs.DrawCount,
+                                 pd3d12ArgsBuff, Attribs.IndirectDrawArgsOffset + BuffDataStartByteOffset,
+                                 pd3d12CountBuff, pd3d12CountBuff != nullptr ? Attribs.CounterOffset + CountBuffDataStartOffset : 0);
+    }
+    ++m_State.NumCommands;
+}
+
 void DeviceContextD3D12Impl::DrawIndirect(const DrawIndirectAttribs& Attribs, IBuffer* pAttribsBuffer)
 {
     if (!DvpVerifyDrawIndirectArguments(Attribs, pAttribsBuffer))
@@ -554,13 +619,7 @@ void DeviceContextD3D12Impl::DrawIndirect(const DrawIndirectAttribs& Attribs, IB
 
     auto& GraphCtx = GetCmdContext().AsGraphicsContext();
     PrepareForDraw(GraphCtx, Attribs.Flags);
-
-    ID3D12Resource* pd3d12ArgsBuff;
-    Uint64          BuffDataStartByteOffset;
-    PrepareDrawIndirectBuffer(GraphCtx, pAttribsBuffer, Attribs.IndirectAttribsBufferStateTransitionMode, pd3d12ArgsBuff, BuffDataStartByteOffset);
-
-    GraphCtx.ExecuteIndirect(m_pDrawIndirectSignature, pd3d12ArgsBuff, Attribs.IndirectDrawArgsOffset + BuffDataStartByteOffset);
-    ++m_State.NumCommands;
+    ExecuteIndirectDraw(GraphCtx, Attribs, pAttribsBuffer, D3D12_INDIRECT_ARGUMENT_TYPE_DRAW);
 }
 
 void DeviceContextD3D12Impl::DrawIndexedIndirect(const DrawIndexedIndirectAttribs& Attribs, IBuffer* pAttribsBuffer)
@@ -570,13 +629,7 @@ void DeviceContextD3D12Impl::DrawIndexedIndirect(const DrawIndexedIndirectAttrib
 
     auto& GraphCtx = GetCmdContext().AsGraphicsContext();
     PrepareForIndexedDraw(GraphCtx, Attribs.Flags, Attribs.IndexType);
-
-    ID3D12Resource* pd3d12ArgsBuff;
-    Uint64          BuffDataStartByteOffset;
-    PrepareDrawIndirectBuffer(GraphCtx, pAttribsBuffer, Attribs.IndirectAttribsBufferStateTransitionMode, pd3d12ArgsBuff, BuffDataStartByteOffset);
-
-    GraphCtx.ExecuteIndirect(m_pDrawIndexedIndirectSignature, pd3d12ArgsBuff, Attribs.IndirectDrawArgsOffset + BuffDataStartByteOffset);
-    ++m_State.NumCommands;
+    ExecuteIndirectDraw(GraphCtx, Attribs, pAttribsBuffer, D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED);
 }
 
 void DeviceContextD3D12Impl::DrawMesh(const DrawMeshAttribs& Attribs)
@@ -2077,6 +2130,25 @@ void DeviceContextD3D12Impl::WaitForFence(IFence* pFence, Uint64 Value, bool Flu
     pFenceD3D12->WaitForCompletion(Value);
 }
 
+void DeviceContextD3D12Impl::DeviceWaitForFence(IFence* pFence, Uint64 Value)
+{
+    VERIFY(!m_bIsDeferred, "Fence can only be waited from immediate context");
+    DEV_CHECK_ERR(pFence != nullptr, "Fence must not be null");
+
+    // The wait only affects the command lists submitted after it
+    Flush();
+
+    auto* pd3d12Fence = ValidatedCast<FenceD3D12Impl>(pFence)->GetD3D12Fence();
+    m_pDevice->LockCmdQueueAndRun(m_CommandQueueId,
+                                  [&](ICommandQueueD3D12* pCmdQueue) //
+                                  {
+                                      auto hr = pCmdQueue->GetD3D12CommandQueue()->Wait(pd3d12Fence, Value);
+                                      DEV_CHECK_ERR(SUCCEEDED(hr), "Failed to wait for the fence on the command queue");
+                                      (void)hr;
+                                  } //
+    );
+}
+
 void DeviceContextD3D12Impl::WaitForIdle()
 {
     VERIFY(!m_bIsDeferred, "Only immediate contexts can be idled");
@@ -307,6 +307,9 @@ RenderDeviceD3D12Impl::RenderDeviceD3D12Impl(IReferenceCounters*          pRefCo
             }
         }
 
+        // ExecuteIndirect always accepts an optional count buffer
+        m_DeviceCaps.Features.DrawIndirectCounterBuffer = DEVICE_FEATURE_STATE_ENABLED;
+
 #define CHECK_REQUIRED_FEATURE(Feature, FeatureName)                          \
     do                                                                        \
     {                                                                         \
@@ -330,7 +333,7 @@ RenderDeviceD3D12Impl::RenderDeviceD3D12Impl(IReferenceCounters*          pRefCo
 #undef CHECK_REQUIRED_FEATURE
 
 #if defined(_MSC_VER) && defined(_WIN64)
-        static_assert(sizeof(DeviceFeatures) == 32, "Did you add a new feature to DeviceFeatures? Please handle its satus here.");
+        static_assert(sizeof(DeviceFeatures) == 33, "Did you add a new feature to DeviceFeatures? Please handle its satus here.");
 #endif
 
         auto& TexCaps = m_DeviceCaps.TexCaps;
@@ -672,13 +675,14 @@ void RenderDeviceD3D12Impl::CreateSampler(const SamplerDesc& SamplerDesc, ISampl
     CreateDeviceObject("sampler", SamplerDesc, ppSampler,
                        [&]() //
                        {
-                           m_SamplersRegistry.Find(SamplerDesc, reinterpret_cast<IDeviceObject**>(ppSampler));
+                           const auto SamplerHash = m_SamplersRegistry.ComputeHash(SamplerDesc);
+                           m_SamplersRegistry.Find(SamplerDesc, SamplerHash, reinterpret_cast<IDeviceObject**>(ppSampler));
                            if (*ppSampler == nullptr)
                            {
                                SamplerD3D12Impl* pSamplerD3D12{NEW_RC_OBJ(m_SamplerObjAllocator, "SamplerD3D12Impl instance", SamplerD3D12Impl)(this, SamplerDesc)};
                                pSamplerD3D12->QueryInterface(IID_Sampler, reinterpret_cast<IObject**>(ppSampler));
                                OnCreateDeviceObject(pSamplerD3D12);
-                               m_SamplersRegistry.Add(SamplerDesc, *ppSampler);
+                               m_SamplersRegistry.Add(SamplerDesc, SamplerHash, *ppSampler);
                            }
                        });
 }
@@ -710,9 +714,16 @@ void RenderDeviceD3D12Impl::CreateRenderPass(const RenderPassDesc& Desc, IRender
     CreateDeviceObject("RenderPass", Desc, ppRenderPass,
                        [&]() //
                        {
-                           RenderPassD3D12Impl* pRenderPassD3D12{NEW_RC_OBJ(m_RenderPassAllocator, "RenderPassD3D12Impl instance", RenderPassD3D12Impl)(this, Desc)};
-                           pRenderPassD3D12->QueryInterface(IID_RenderPass, reinterpret_cast<IObject**>(ppRenderPass));
-                           OnCreateDeviceObject(pRenderPassD3D12);
+                           ValidateRenderPassDesc(Desc);
+                           const auto RenderPassHash = m_RenderPassRegistry.ComputeHash(Desc);
+                           m_RenderPassRegistry.Find(Desc, RenderPassHash, reinterpret_cast<IDeviceObject**>(ppRenderPass));
+                           if (*ppRenderPass == nullptr)
+                           {
+                               RenderPassD3D12Impl* pRenderPassD3D12{NEW_RC_OBJ(m_RenderPassAllocator, "RenderPassD3D12Impl instance", RenderPassD3D12Impl)(this, Desc)};
+                               pRenderPassD3D12->QueryInterface(IID_RenderPass, reinterpret_cast<IObject**>(ppRenderPass));
+                               OnCreateDeviceObject(pRenderPassD3D12);
+                               m_RenderPassRegistry.Add(Desc, RenderPassHash, *ppRenderPass);
+                           }
                        });
 }
 
@@ -235,6 +235,9 @@ public:
     /// Implementation of IDeviceContext::WaitForFence() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE WaitForFence(IFence* pFence, Uint64 Value, bool FlushContext) override final;
 
+    /// Implementation of IDeviceContext::DeviceWaitForFence() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE DeviceWaitForFence(IFence* pFence, Uint64 Value) override final;
+
     /// Implementation of IDeviceContext::WaitForIdle() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE WaitForIdle() override final;
 
@@ -292,7 +295,8 @@ protected:
 private:
     __forceinline void PrepareForDraw(DRAW_FLAGS Flags, bool IsIndexed, GLenum& GlTopology);
     __forceinline void PrepareForIndexedDraw(VALUE_TYPE IndexType, Uint32 FirstIndexLocation, GLenum& GLIndexType, Uint32& FirstIndexByteOffset);
-    __forceinline void PrepareForIndirectDraw(IBuffer* pAttribsBuffer);
+    __forceinline void PrepareForIndirectDraw(IBuffer* pAttribsBuffer, IBuffer* pCounterBuffer);
+    __forceinline void PostIndirectDraw(IBuffer* pCounterBuffer);
     __forceinline void PostDraw();
 
     void BeginSubpass();
@@ -1021,7 +1021,99 @@ void DeviceContextGLImpl::DrawIndexed(const DrawIndexedAttribs& Attribs)
     PostDraw();
 }
 
-void DeviceContextGLImpl::PrepareForIndirectDraw(IBuffer* pAttribsBuffer)
+namespace
+{
+
+#if GL_ARB_draw_indirect
+const void* GetIndirectArgsPtr(Uint64 Offset)
+{
+    return reinterpret_cast<const void*>(static_cast<size_t>(Offset));
+}
+
+void MultiDrawArraysIndirect(GLenum GlTopology, Uint32 ArgsOffset, Uint32 DrawCount, Uint32 ArgsStride)
+{
+#    if GL_ARB_multi_draw_indirect
+    if (DrawCount > 1 && glMultiDrawArraysIndirect != nullptr)
+    {
+        glMultiDrawArraysIndirect(GlTopology, GetIndirectArgsPtr(ArgsOffset), DrawCount, ArgsStride);
+        DEV_CHECK_GL_ERROR("glMultiDrawArraysIndirect() failed");
+        return;
+    }
+#    endif
+
+    for (Uint32 i = 0; i < DrawCount; ++i)
+    {
+        glDrawArraysIndirect(GlTopology, GetIndirectArgsPtr(Uint64{ArgsOffset} + Uint64{ArgsStride} * i));
+        // Note that on GLES 3.1, baseInstance is present but reserved and must be zero
+        DEV_CHECK_GL_ERROR("glDrawArraysIndirect() failed");
+    }
+}
+
+void MultiDrawElementsIndirect(GLenum GlTopology, GLenum GLIndexType, Uint32 ArgsOffset, Uint32 DrawCount, Uint32 ArgsStride)
+{
+#    if GL_ARB_multi_draw_indirect
+    if (DrawCount > 1 && glMultiDrawElementsIndirect != nullptr)
+    {
+        glMultiDrawElementsIndirect(GlTopology, GLIndexType, GetIndirectArgsPtr(ArgsOffset), DrawCount, ArgsStride);
+        DEV_CHECK_GL_ERROR("glMultiDrawElementsIndirect() failed");
+        return;
+    }
+#    endif
+
+    for (Uint32 i = 0; i < DrawCount; ++i)
+    {
+        glDrawElementsIndirect(GlTopology, GLIndexType, GetIndirectArgsPtr(Uint64{ArgsOffset} + Uint64{ArgsStride} * i));
+        // Note that on GLES 3.1, baseInstance is present but reserved and must be zero
+        DEV_CHECK_GL_ERROR("glDrawElementsIndirect() failed");
+    }
+}
+
+void MultiDrawArraysIndirectCount(GLenum GlTopology, Uint32 ArgsOffset, Uint32 CounterOffset, Uint32 MaxDrawCount, Uint32 ArgsStride)
+{
+#    if GL_VERSION_4_6
+    if (glMultiDrawArraysIndirectCount != nullptr)
+    {
+        glMultiDrawArraysIndirectCount(GlTopology, GetIndirectArgsPtr(ArgsOffset), CounterOffset, MaxDrawCount, ArgsStride);
+        DEV_CHECK_GL_ERROR("glMultiDrawArraysIndirectCount() failed");
+        return;
+    }
+#    endif
+#    if GL_ARB_indirect_parameters
+    if (glMultiDrawArraysIndirectCountARB != nullptr)
+    {
+        glMultiDrawArraysIndirectCountARB(GlTopology, GetIndirectArgsPtr(ArgsOffset), CounterOffset, MaxDrawCount, ArgsStride);
+        DEV_CHECK_GL_ERROR("glMultiDrawArraysIndirectCountARB() failed");
+        return;
+    }
+#    endif
+    UNSUPPORTED("Indirect draw counter buffer is not supported by this device");
+}
+
+void MultiDrawElementsIndirectCount(GLenum GlTopology, GLenum GLIndexType, Uint32 ArgsOffset, Uint32 CounterOffset, Uint32 MaxDrawCount, Uint32 ArgsStride)
+{
+#    if GL_VERSION_4_6
+    if (glMultiDrawElementsIndirectCount != nullptr)
+    {
+        glMultiDrawElementsIndirectCount(GlTopology, GLIndexType, GetIndirectArgsPtr(ArgsOffset), CounterOffset, MaxDrawCount, ArgsStride);
+        DEV_CHECK_GL_ERROR("glMultiDrawElementsIndirectCount() failed");
+        return;
+    }
+#    endif
+#    if GL_ARB_indirect_parameters
+    if (glMultiDrawElementsIndirectCountARB != nullptr)
+    {
+        glMultiDrawElementsIndirectCountARB(GlTopology, GLIndexType, GetIndirectArgsPtr(ArgsOffset), CounterOffset, MaxDrawCount, ArgsStride);
+        DEV_CHECK_GL_ERROR("glMultiDrawElementsIndirectCountARB() failed");
+        return;
+    }
+#    endif
+    UNSUPPORTED("Indirect draw counter buffer is not supported by this device");
+}
+#endif
+
+} // namespace
+
+void DeviceContextGLImpl::PrepareForIndirectDraw(IBuffer* pAttribsBuffer, IBuffer* pCounterBuffer)
 {
 #if GL_ARB_draw_indirect
     auto* pIndirectDrawAttribsGL = ValidatedCast<BufferGLImpl>(pAttribsBuffer);
@@ -1037,6 +1129,30 @@ void DeviceContextGLImpl::PrepareForIndirectDraw(IBuffer* pAttribsBuffer)
         m_ContextState);
     constexpr bool ResetVAO = false; // GL_DRAW_INDIRECT_BUFFER does not affect VAO
     m_ContextState.BindBuffer(GL_DRAW_INDIRECT_BUFFER, pIndirectDrawAttribsGL->m_GlBuffer, ResetVAO);
+
+    if (pCounterBuffer != nullptr)
+    {
+#    if GL_ARB_indirect_parameters
+        auto* pCounterBufferGL = ValidatedCast<BufferGLImpl>(pCounterBuffer);
+        // GL_COMMAND_BARRIER_BIT also covers the GL_PARAMETER_BUFFER binding
+        pCounterBufferGL->BufferMemoryBarrier(GL_COMMAND_BARRIER_BIT, m_ContextState);
+        m_ContextState.BindBuffer(GL_PARAMETER_BUFFER_ARB, pCounterBufferGL->m_GlBuffer, ResetVAO);
+#    else
+        UNSUPPORTED("Indirect draw counter buffer is not supported");
+#    endif
+    }
+#endif
+}
+
+void DeviceContextGLImpl::PostIndirectDraw(IBuffer* pCounterBuffer)
+{
+#if GL_ARB_draw_indirect
+    constexpr bool ResetVAO = false; // GL_DRAW_INDIRECT_BUFFER does not affect VAO
+    m_ContextState.BindBuffer(GL_DRAW_INDIRECT_BUFFER, GLObjectWrappers::GLBufferObj::Null(), ResetVAO);
+#    if GL_ARB_indirect_parameters
+    if (pCounterBuffer != nullptr)
+        m_ContextState.BindBuffer(GL_PARAMETER_BUFFER_ARB, GLObjectWrappers::GLBufferObj::Null(), ResetVAO);
+#    endif
 #endif
 }
 
@@ -1050,7 +1166,7 @@ void DeviceContextGLImpl::DrawIndirect(const DrawIndirectAttribs& Attribs, IBuff
     PrepareForDraw(Attribs.Flags, true, GlTopology);
 
     // http://www.opengl.org/wiki/Vertex_Rendering
-    PrepareForIndirectDraw(pAttribsBuffer);
+    PrepareForIndirectDraw(pAttribsBuffer, Attribs.pCounterBuffer);
 
     //typedef  struct {
     //   GLuint  count;
@@ -1058,12 +1174,13 @@ void DeviceContextGLImpl::DrawIndirect(const DrawIndirectAttribs& Attribs, IBuff
     //   GLuint  first;
     //   GLuint  baseInstance;
     //} DrawArraysIndirectCommand;
-    glDrawArraysIndirect(GlTopology, reinterpret_cast<const void*>(static_cast<size_t>(Attribs.IndirectDrawArgsOffset)));
-    // Note that on GLES 3.1, baseInstance is present but reserved and must be zero
-    DEV_CHECK_GL_ERROR("glDrawArraysIndirect() failed");
+    const Uint32 ArgsStride = Attribs.DrawArgsStride != 0 ? Attribs.DrawArgsStride : Uint32{sizeof(GLuint) * 4};
+    if (Attribs.pCounterBuffer != nullptr)
+        MultiDrawArraysIndirectCount(GlTopology, Attribs.IndirectDrawArgsOffset, Attribs.CounterOffset, Attribs.DrawCount, ArgsStride);
+    else
+        MultiDrawArraysIndirect(GlTopology, Attribs.IndirectDrawArgsOffset, Attribs.DrawCount, ArgsStride);
 
-    constexpr bool ResetVAO = false; // GL_DRAW_INDIRECT_BUFFER does not affect VAO
-    m_ContextState.BindBuffer(GL_DRAW_INDIRECT_BUFFER, GLObjectWrappers::GLBufferObj::Null(), ResetVAO);
+    PostIndirectDraw(Attribs.pCounterBuffer);
 
     PostDraw();
 #else
@@ -1084,7 +1201,7 @@ void DeviceContextGLImpl::DrawIndexedIndirect(const DrawIndexedIndirectAttribs&
     PrepareForIndexedDraw(Attribs.IndexType, 0, GLIndexType, FirstIndexByteOffset);
 
     // http://www.opengl.org/wiki/Vertex_Rendering
-    PrepareForIndirectDraw(pAttribsBuffer);
+    PrepareForIndirectDraw(pAttribsBuffer, Attribs.pCounterBuffer);
 
     //typedef  struct {
     //    GLuint  count;
@@ -1093,12 +1210,13 @@ void DeviceContextGLImpl::DrawIndexedIndirect(const DrawIndexedIndirectAttribs&
     //    GLuint  baseVertex;
     //    GLuint  baseInstance;
     //} DrawElementsIndirectCommand;
-    glDrawElementsIndirect(GlTopology, GLIndexType, reinterpret_cast<const void*>(static_cast<size_t>(Attribs.IndirectDrawArgsOffset)));
-    // Note that on GLES 3.1, baseInstance is present but reserved and must be zero
-    DEV_CHECK_GL_ERROR("glDrawElementsIndirect() failed");
+    const Uint32 ArgsStride = Attribs.DrawArgsStride != 0 ? Attribs.DrawArgsStride : Uint32{sizeof(GLuint) * 5};
+    if (Attribs.pCounterBuffer != nullptr)
+        MultiDrawElementsIndirectCount(GlTopology, GLIndexType, Attribs.IndirectDrawArgsOffset, Attribs.CounterOffset, Attribs.DrawCount, ArgsStride);
+    else
+        MultiDrawElementsIndirect(GlTopology, GLIndexType, Attribs.IndirectDrawArgsOffset, Attribs.DrawCount, ArgsStride);
 
-    constexpr bool ResetVAO = false; // GL_DISPATCH_INDIRECT_BUFFER does not affect VAO
-    m_ContextState.BindBuffer(GL_DRAW_INDIRECT_BUFFER, GLObjectWrappers::GLBufferObj::Null(), ResetVAO);
+    PostIndirectDraw(Attribs.pCounterBuffer);
 
     PostDraw();
 #else
@@ -1306,6 +1424,15 @@ void DeviceContextGLImpl::WaitForFence(IFence* pFence, Uint64 Value, bool FlushC
     pFenceGLImpl->Wait(Value, FlushContext);
 }
 
+void DeviceContextGLImpl::DeviceWaitForFence(IFence* pFence, Uint64 Value)
+{
+    VERIFY(!m_bIsDeferred, "Fence can only be waited from immediate context");
+    DEV_CHECK_ERR(pFence != nullptr, "Fence must not be null");
+    // OpenGL executes all commands in submission order, so the fence has either been
+    // signaled by the preceding commands or will never be signaled by the context.
+    Flush();
+}
+
 void DeviceContextGLImpl::WaitForIdle()
 {
     VERIFY(!m_bIsDeferred, "Only immediate contexts can be idled");
@@ -377,6 +377,7 @@ RenderDeviceGLImpl::RenderDeviceGLImpl(IReferenceCounters*       pRefCounters,
         SET_FEATURE_STATE(ShaderInt8,                CheckExtension("GL_EXT_shader_explicit_arithmetic_types_int8"),    "8-bit integer shader operations are");
         SET_FEATURE_STATE(ResourceBuffer8BitAccess,  CheckExtension("GL_EXT_shader_8bit_storage"),                      "8-bit resoure buffer access is");
         SET_FEATURE_STATE(UniformBuffer8BitAccess,   CheckExtension("GL_EXT_shader_8bit_storage"),                      "8-bit uniform buffer access is");
+        SET_FEATURE_STATE(DrawIndirectCounterBuffer, IsGL46OrAbove || CheckExtension("GL_ARB_indirect_parameters"),     "Indirect draw counter buffer is");
         // clang-format on
 
         TexCaps.MaxTexture1DDimension     = MaxTextureSize;
@@ -440,6 +441,7 @@ RenderDeviceGLImpl::RenderDeviceGLImpl(IReferenceCounters*       pRefCounters,
         SET_FEATURE_STATE(ShaderInt8,                strstr(Extensions, "shader_explicit_arithmetic_types_int8"),    "8-bit integer shader operations are");
         SET_FEATURE_STATE(ResourceBuffer8BitAccess,  strstr(Extensions, "shader_8bit_storage"),                      "8-bit resoure buffer access is");
         SET_FEATURE_STATE(UniformBuffer8BitAccess,   strstr(Extensions, "shader_8bit_storage"),                      "8-bit uniform buffer access is");
+        SET_FEATURE_STATE(DrawIndirectCounterBuffer, false,                                                          "Indirect draw counter buffer is");
         // clang-format on
 
         TexCaps.MaxTexture1DDimension     = 0; // Not supported in GLES 3.2
@@ -467,7 +469,7 @@ RenderDeviceGLImpl::RenderDeviceGLImpl(IReferenceCounters*       pRefCounters,
 #undef SET_FEATURE_STATE
 
 #if defined(_MSC_VER) && defined(_WIN64)
-    static_assert(sizeof(DeviceFeatures) == 32, "Did you add a new feature to DeviceFeatures? Please handle its satus here.");
+    static_assert(sizeof(DeviceFeatures) == 33, "Did you add a new feature to DeviceFeatures? Please handle its satus here.");
 #endif
 }
 
@@ -690,13 +692,14 @@ void RenderDeviceGLImpl::CreateSampler(const SamplerDesc& SamplerDesc, ISampler*
         "sampler", SamplerDesc, ppSampler,
         [&]() //
         {
-            m_SamplersRegistry.Find(SamplerDesc, reinterpret_cast<IDeviceObject**>(ppSampler));
+            const auto SamplerHash = m_SamplersRegistry.ComputeHash(SamplerDesc);
+            m_SamplersRegistry.Find(SamplerDesc, SamplerHash, reinterpret_cast<IDeviceObject**>(ppSampler));
             if (*ppSampler == nullptr)
             {
                 SamplerGLImpl* pSamplerOGL(NEW_RC_OBJ(m_SamplerObjAllocator, "SamplerGLImpl instance", SamplerGLImpl)(this, SamplerDesc, bIsDeviceInternal));
                 pSamplerOGL->QueryInterface(IID_Sampler, reinterpret_cast<IObject**>(ppSampler));
                 OnCreateDeviceObject(pSamplerOGL);
-                m_SamplersRegistry.Add(SamplerDesc, *ppSampler);
+                m_SamplersRegistry.Add(SamplerDesc, SamplerHash, *ppSampler);
             }
         } //
     );
@@ -779,9 +782,16 @@ void RenderDeviceGLImpl::CreateRenderPass(const RenderPassDesc& Desc, IRenderPas
         "RenderPass", Desc, ppRenderPass,
         [&]() //
         {
-            RenderPassGLImpl* pRenderPassOGL(NEW_RC_OBJ(m_RenderPassAllocator, "RenderPassGLImpl instance", RenderPassGLImpl)(this, Desc));
-            pRenderPassOGL->QueryInterface(IID_RenderPass, reinterpret_cast<IObject**>(ppRenderPass));
-            OnCreateDeviceObject(pRenderPassOGL);
+            ValidateRenderPassDesc(Desc);
+            const auto RenderPassHash = m_RenderPassRegistry.ComputeHash(Desc);
+            m_RenderPassRegistry.Find(Desc, RenderPassHash, reinterpret_cast<IDeviceObject**>(ppRenderPass));
+            if (*ppRenderPass == nullptr)
+            {
+                RenderPassGLImpl* pRenderPassOGL(NEW_RC_OBJ(m_RenderPassAllocator, "RenderPassGLImpl instance", RenderPassGLImpl)(this, Desc));
+                pRenderPassOGL->QueryInterface(IID_RenderPass, reinterpret_cast<IObject**>(ppRenderPass));
+                OnCreateDeviceObject(pRenderPassOGL);
+                m_RenderPassRegistry.Add(Desc, RenderPassHash, *ppRenderPass);
+            }
         } //
     );
 }
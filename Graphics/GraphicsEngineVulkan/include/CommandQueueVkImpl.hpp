@@ -49,7 +49,8 @@ public:
 
     CommandQueueVkImpl(IReferenceCounters*                                   pRefCounters,
                        std::shared_ptr<VulkanUtilities::VulkanLogicalDevice> LogicalDevice,
-                       uint32_t                                              QueueFamilyIndex);
+                       uint32_t                                              QueueFamilyIndex,
+                       uint32_t                                              QueueIndex = 0);
     ~CommandQueueVkImpl();
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_CommandQueueVk, TBase)
@@ -137,7 +137,8 @@ public:
                           std::string                       PoolName,
                           std::vector<VkDescriptorPoolSize> PoolSizes,
                           uint32_t                          MaxSets,
-                          bool                              AllowFreeing) noexcept;
+                          bool                              AllowFreeing,
+                          bool                              UpdateAfterBind) noexcept;
     ~DescriptorPoolManager();
 
     DescriptorPoolManager             (const DescriptorPoolManager&) = delete;
@@ -168,6 +169,7 @@ protected:
     const std::vector<VkDescriptorPoolSize> m_PoolSizes;
     const uint32_t                          m_MaxSets;
     const bool                              m_AllowFreeing;
+    const bool                              m_UpdateAfterBind; // Sets with update-after-bind bindings may be allocated from the pools
 
     std::mutex                                         m_Mutex;
     std::deque<VulkanUtilities::DescriptorPoolWrapper> m_Pools;
@@ -191,7 +193,8 @@ public:
                            std::string                       PoolName,
                            std::vector<VkDescriptorPoolSize> PoolSizes,
                            uint32_t                          MaxSets,
-                           bool                              AllowFreeing) noexcept :
+                           bool                              AllowFreeing,
+                           bool                              UpdateAfterBind) noexcept :
         // clang-format off
         DescriptorPoolManager
         {
@@ -199,7 +202,8 @@ public:
             std::move(PoolName),
             std::move(PoolSizes),
             MaxSets,
-            AllowFreeing
+            AllowFreeing,
+            UpdateAfterBind
         }
     // clang-format on
     {
@@ -242,6 +242,9 @@ public:
     /// Implementation of IDeviceContext::WaitForFence() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE WaitForFence(IFence* pFence, Uint64 Value, bool FlushContext) override final;
 
+    /// Implementation of IDeviceContext::DeviceWaitForFence() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE DeviceWaitForFence(IFence* pFence, Uint64 Value) override final;
+
     /// Implementation of IDeviceContext::WaitForIdle() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE WaitForIdle() override final;
 
@@ -319,12 +322,14 @@ public:
                              RESOURCE_STATE    NewState,
                              bool              UpdateInternalState);
 
-    void AddWaitSemaphore(ManagedSemaphore* pWaitSemaphore, VkPipelineStageFlags WaitDstStageMask)
+    // WaitValue is only used by timeline semaphores and is ignored for binary semaphores
+    void AddWaitSemaphore(ManagedSemaphore* pWaitSemaphore, VkPipelineStageFlags WaitDstStageMask, Uint64 WaitValue = 0)
     {
         VERIFY_EXPR(pWaitSemaphore != nullptr);
         m_WaitSemaphores.emplace_back(pWaitSemaphore);
         m_VkWaitSemaphores.push_back(pWaitSemaphore->Get());
         m_WaitDstStageMasks.push_back(WaitDstStageMask);
+        m_WaitSemaphoreValues.push_back(WaitValue);
     }
     void AddSignalSemaphore(ManagedSemaphore* pSignalSemaphore)
     {
@@ -393,6 +398,7 @@ public:
 private:
     void               TransitionRenderTargets(RESOURCE_STATE_TRANSITION_MODE StateTransitionMode);
     __forceinline void CommitRenderPassAndFramebuffer(bool VerifyStates);
+    void               CommitDynamicRendering(bool VerifyStates);
     void               CommitVkVertexBuffers();
     void               CommitViewports();
     void               CommitScissorRects();
@@ -459,9 +465,17 @@ private:
     __forceinline void          PrepareForRayTracing();
 
     void DvpLogRenderPass_PSOMismatch();
+    bool DvpIsPSOCompatibleWithRenderTargets();
 
     void CreateASCompactedSizeQueryPool();
 
+    // Returns false and logs an error if the context is a compute context that can't execute graphics commands
+    bool IsGraphicsCommandAllowed(const char* Command) const;
+
+    /// Indicates if the context submits commands to a queue from a compute-only family,
+    /// in which case graphics commands and resource states are not allowed.
+    const bool m_IsComputeOnly;
+
     VulkanUtilities::VulkanCommandBuffer m_CommandBuffer;
 
     struct ContextState
@@ -484,6 +498,14 @@ private:
     /// This framebuffer may or may not be currently set in the command buffer
     VkFramebuffer m_vkFramebuffer = VK_NULL_HANDLE;
 
+    /// Indicates if render targets set by SetRenderTargets() are rendered to with
+    /// VK_KHR_dynamic_rendering, in which case m_vkRenderPass and m_vkFramebuffer are not used.
+    const bool m_UseDynamicRendering;
+
+    /// Indicates if render targets for dynamic rendering are bound.
+    /// Dynamic rendering may or may not be currently active in the command buffer
+    bool m_DynamicRenderingTargetsBound = false;
+
     FixedBlockMemoryAllocator m_CmdListAllocator;
 
     // Semaphores are not owned by the command context
@@ -493,6 +515,7 @@ private:
 
     std::vector<VkSemaphore> m_VkWaitSemaphores;
     std::vector<VkSemaphore> m_VkSignalSemaphores;
+    std::vector<Uint64>      m_WaitSemaphoreValues;
 
     // List of fences to signal next time the command context is flushed
     std::vector<std::pair<Uint64, RefCntAutoPtr<IFence>>> m_PendingFences;
@@ -534,6 +557,9 @@ private:
     PipelineLayout::DescriptorSetBindInfo m_DescrSetBindInfo;
     std::shared_ptr<GenerateMipsVkHelper> m_GenerateMipsHelper;
     RefCntAutoPtr<IShaderResourceBinding> m_GenerateMipsSRB;
+    RefCntAutoPtr<IShaderResourceBinding> m_GenerateMipsSPDSRB;
+    // Atomic counters of the single-pass downsampler; every context uses its own buffer
+    RefCntAutoPtr<IBuffer> m_GenerateMipsSPDCounter;
 
     // In Vulkan we can't bind null vertex buffer, so we have to create a dummy VB
     RefCntAutoPtr<BufferVkImpl> m_DummyVB;
@@ -31,10 +31,13 @@
 /// Declaration of Diligent::FenceVkImpl class
 
 #include <deque>
+#include <mutex>
+#include <vector>
 #include "FenceVk.h"
 #include "FenceBase.hpp"
 #include "VulkanUtilities/VulkanFencePool.hpp"
 #include "RenderDeviceVkImpl.hpp"
+#include "ManagedVulkanObject.hpp"
 
 namespace Diligent
 {
@@ -56,29 +59,63 @@ public:
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_FenceVk, TFenceBase)
 
     /// Implementation of IFence::GetCompletedValue() in Vulkan backend.
-    /// Note that this method is not thread-safe. The reason is that VulkanFencePool is not thread
-    /// safe, and DeviceContextVkImpl::SignalFence() adds the fence to the pending fences list that
-    /// are signaled later by the command context when it submits the command list. So there is no
-    /// guarantee that the fence pool is not accessed simultaneously by multiple threads even if the
-    /// fence object itself is protected by mutex.
+    /// The fence pool and the pending fences are protected by a mutex, because the fence may be
+    /// signaled by one context and waited for by another context that runs in a different thread.
     virtual Uint64 DILIGENT_CALL_TYPE GetCompletedValue() override final;
 
     /// Implementation of IFence::Reset() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE Reset(Uint64 Value) override final;
 
-    VulkanUtilities::FenceWrapper GetVkFence() { return m_FencePool.GetFence(); }
+    VulkanUtilities::FenceWrapper GetVkFence()
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        return m_FencePool.GetFence();
+    }
 
     void AddPendingFence(VulkanUtilities::FenceWrapper&& vkFence, Uint64 FenceValue)
     {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
         m_PendingFences.emplace_back(FenceValue, std::move(vkFence));
     }
 
     void Wait(Uint64 Value);
 
+    // Returns the semaphore that must be signaled on the GPU when the fence reaches the given value,
+    // or null if no command queue can wait for it. With timeline semaphores, the semaphore must be
+    // signaled with the fence value; otherwise a new binary semaphore is created for every value,
+    // and AddSignaledSemaphore() must be called once its signal operation has been submitted.
+    RefCntAutoPtr<ManagedSemaphore> GetSemaphoreToSignal(Uint64 Value);
+
+    void AddSignaledSemaphore(Uint64 Value, RefCntAutoPtr<ManagedSemaphore>&& pSemaphore);
+
+    // Returns the semaphore that a command queue must wait for to make sure the fence has reached
+    // the given value, or null if there is no such semaphore. Binary semaphores can only be waited
+    // for once, so they are removed from the list. With timeline semaphores, the wait value is Value.
+    RefCntAutoPtr<ManagedSemaphore> GetSemaphoreToWait(Uint64 Value);
+
+    bool HasTimelineSemaphore() const { return m_TimelineSemaphore; }
+
+    // Releases the binary semaphores whose values have been completed, as there is nothing to wait for.
+    // Returns true if there are semaphores that have not been waited for yet.
+    bool ReleaseCompletedSemaphores();
+
 private:
+    // Moves the binary semaphores whose values have been completed to StaleSemaphores.
+    // m_Mtx must be locked.
+    void PopCompletedSemaphores(std::vector<RefCntAutoPtr<ManagedSemaphore>>& StaleSemaphores);
+
+    std::mutex m_Mtx;
+
     VulkanUtilities::VulkanFencePool                             m_FencePool;
     std::deque<std::pair<Uint64, VulkanUtilities::FenceWrapper>> m_PendingFences;
     volatile Uint64                                              m_LastCompletedFenceValue = 0;
+
+    // Timeline semaphore that is signaled with the fence values when VK_KHR_timeline_semaphore is enabled
+    RefCntAutoPtr<ManagedSemaphore> m_TimelineSemaphore;
+    Uint64                          m_LastSignaledValue = 0;
+
+    // Binary semaphores that have been signaled, but not waited for yet
+    std::deque<std::pair<Uint64, RefCntAutoPtr<ManagedSemaphore>>> m_SignaledSemaphores;
 };
 
 } // namespace Diligent
@@ -54,21 +54,44 @@ public:
     GenerateMipsVkHelper& operator = (      GenerateMipsVkHelper&&) = delete;
     // clang-format on
 
-    void GenerateMips(TextureViewVkImpl& TexView, DeviceContextVkImpl& Ctx, IShaderResourceBinding* pSRB);
+    void GenerateMips(TextureViewVkImpl& TexView, DeviceContextVkImpl& Ctx, IShaderResourceBinding* pSRB, IShaderResourceBinding* pSPDSRB, IBuffer* pSPDCounter);
     void CreateSRB(IShaderResourceBinding** ppSRB);
+
+    /// Creates the single-pass downsampler SRB and the atomic counter buffer bound to it.
+    /// Contexts may run on different queues, so every context must use its own counter buffer.
+    void CreateSPDSRB(IShaderResourceBinding** ppSRB, IBuffer** ppCounterBuffer);
     void WarmUpCache(TEXTURE_FORMAT Fmt);
 
+    /// Maximum number of mip levels written by one single-pass downsampler dispatch
+    static constexpr Uint32 MaxMipsHandledBySPD = 12;
+
+    /// Maximum number of array slices processed by one single-pass downsampler dispatch
+    static constexpr Uint32 MaxSPDArraySlices = 2048;
+
+    /// Returns true if the mip chain of the given dimensions can be generated by the single-pass downsampler.
+    static bool IsSPDCompatible(Uint32 Width, Uint32 Height, Uint32 NumMipLevels, Uint32 NumArraySlices);
+
 private:
-    std::array<RefCntAutoPtr<IPipelineState>, 4>  CreatePSOs(TEXTURE_FORMAT Fmt);
-    std::array<RefCntAutoPtr<IPipelineState>, 4>& FindPSOs(TEXTURE_FORMAT Fmt);
+    struct FormatPSOs
+    {
+        // Multi-pass downsampler PSOs indexed by the NON_POWER_OF_TWO value
+        std::array<RefCntAutoPtr<IPipelineState>, 4> CS;
+
+        // Single-pass downsampler PSO
+        RefCntAutoPtr<IPipelineState> SPD;
+    };
+
+    FormatPSOs  CreatePSOs(TEXTURE_FORMAT Fmt);
+    FormatPSOs& FindPSOs(TEXTURE_FORMAT Fmt);
 
     VkImageLayout GenerateMipsCS(TextureViewVkImpl& TexView, DeviceContextVkImpl& Ctx, IShaderResourceBinding& SRB, VkImageSubresourceRange& SubresRange);
+    VkImageLayout GenerateMipsSPD(TextureViewVkImpl& TexView, DeviceContextVkImpl& Ctx, IShaderResourceBinding& SRB, IBuffer& CounterBuffer, VkImageSubresourceRange& SubresRange);
     VkImageLayout GenerateMipsBlit(TextureViewVkImpl& TexView, DeviceContextVkImpl& Ctx, VkImageSubresourceRange& SubresRange) const;
 
     RenderDeviceVkImpl& m_DeviceVkImpl;
 
-    std::mutex                                                                       m_PSOMutex;
-    std::unordered_map<TEXTURE_FORMAT, std::array<RefCntAutoPtr<IPipelineState>, 4>> m_PSOHash;
+    std::mutex                                     m_PSOMutex;
+    std::unordered_map<TEXTURE_FORMAT, FormatPSOs> m_PSOHash;
 
     static void GetGlImageFormat(const TextureFormatAttribs& FmtAttribs, std::array<char, 16>& GlFmt);
 
@@ -44,6 +44,36 @@ class RenderDeviceVkImpl;
 class DeviceContextVkImpl;
 class ShaderResourceCacheVk;
 
+/// Collects descriptor writes of the push descriptor set from all shader stages, so that
+/// they can be recorded with a single vkCmdPushDescriptorSetKHR command.
+class PushDescriptorWriter
+{
+public:
+    /// Maximum number of descriptors in a push descriptor set that the engine uses.
+    /// Sets with more descriptors are allocated from descriptor pools.
+    static constexpr Uint32 MaxDescriptors = 32;
+
+    /// Copies the writes as well as the descriptor infos they reference.
+    void AddWrites(const VkWriteDescriptorSet* pWrites, Uint32 NumWrites);
+
+    Uint32                      GetWriteCount() const { return m_NumWrites; }
+    const VkWriteDescriptorSet* GetWrites() const { return m_Writes.data(); }
+
+private:
+    // Do not zero-initialize arrays
+    std::array<VkWriteDescriptorSet, MaxDescriptors>                         m_Writes;
+    std::array<VkDescriptorImageInfo, MaxDescriptors>                        m_ImgInfos;
+    std::array<VkDescriptorBufferInfo, MaxDescriptors>                       m_BuffInfos;
+    std::array<VkBufferView, MaxDescriptors>                                 m_BuffViews;
+    std::array<VkWriteDescriptorSetAccelerationStructureKHR, MaxDescriptors> m_AccelStructs;
+
+    Uint32 m_NumWrites       = 0;
+    Uint32 m_NumImgInfos     = 0;
+    Uint32 m_NumBuffInfos    = 0;
+    Uint32 m_NumBuffViews    = 0;
+    Uint32 m_NumAccelStructs = 0;
+};
+
 /// Implementation of the Diligent::PipelineLayout class
 class PipelineLayout
 {
@@ -52,18 +82,23 @@ public:
 
     PipelineLayout();
     void Release(RenderDeviceVkImpl* pDeviceVkImpl, Uint64 CommandQueueMask);
-    void Finalize(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice);
+    // MaxPushDescriptors is the maximum number of descriptors in a push descriptor set,
+    // or zero if push descriptors are not enabled.
+    void Finalize(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice, Uint32 MaxPushDescriptors);
 
     VkPipelineLayout GetVkPipelineLayout() const { return m_LayoutMgr.GetVkPipelineLayout(); }
 
-    std::array<Uint32, 2> GetDescriptorSetSizes(Uint32& NumSets) const;
+    std::array<Uint32, 3> GetDescriptorSetSizes(Uint32& NumSets) const;
 
     void InitResourceCache(RenderDeviceVkImpl*    pDeviceVkImpl,
                            ShaderResourceCacheVk& ResourceCache,
                            IMemoryAllocator&      CacheMemAllocator,
                            const char*            DbgPipelineName) const;
 
+    // ArraySize is the number of descriptors in the binding. It differs from ResAttribs.ArraySize for
+    // runtime-sized arrays, which are placed into the update-after-bind descriptor set.
     void AllocateResourceSlot(const SPIRVShaderResourceAttribs& ResAttribs,
+                              Uint32                            ArraySize,
                               SHADER_RESOURCE_VARIABLE_TYPE     VariableType,
                               VkSampler                         vkImmutableSampler,
                               SHADER_TYPE                       ShaderType,
@@ -91,12 +126,20 @@ public:
         return m_LayoutMgr.GetDescriptorSet(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC).VkLayout;
     }
 
+    // Returns true if dynamic resources are written with vkCmdPushDescriptorSetKHR
+    // instead of to a descriptor set allocated from the dynamic descriptor pool.
+    bool IsDynamicDescriptorSetPushed() const
+    {
+        return m_LayoutMgr.GetDescriptorSet(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC).IsPushDescriptorSet;
+    }
+
     struct DescriptorSetBindInfo
     {
         std::vector<VkDescriptorSet> vkSets;
         std::vector<uint32_t>        DynamicOffsets;
         const ShaderResourceCacheVk* pResourceCache          = nullptr;
         VkPipelineBindPoint          BindPoint               = VK_PIPELINE_BIND_POINT_MAX_ENUM;
+        Uint32                       FirstSet                = 0; // Index of the first set in vkSets; non-zero when set 0 is a push descriptor set
         Uint32                       SetCout                 = 0;
         Uint32                       DynamicOffsetCount      = 0;
         bool                         DynamicBuffersPresent   = false;
@@ -116,6 +159,7 @@ public:
         {
             pResourceCache          = nullptr;
             BindPoint               = VK_PIPELINE_BIND_POINT_MAX_ENUM;
+            FirstSet                = 0;
             SetCout                 = 0;
             DynamicOffsetCount      = 0;
             DynamicBuffersPresent   = false;
@@ -141,6 +185,13 @@ public:
                                DescriptorSetBindInfo&       BindInfo,
                                VkDescriptorSet              VkDynamicDescrSet) const;
 
+#if DILIGENT_VK_PUSH_DESCRIPTOR_SUPPORTED
+    // Records the dynamic resource descriptors collected by Writer into the command buffer
+    void PushDynamicDescriptorSet(VulkanUtilities::VulkanCommandBuffer& CmdBuffer,
+                                  VkPipelineBindPoint                   BindPoint,
+                                  const PushDescriptorWriter&           Writer) const;
+#endif
+
     // Computes dynamic offsets and binds descriptor sets
     __forceinline void BindDescriptorSetsWithDynamicOffsets(VulkanUtilities::VulkanCommandBuffer& CmdBuffer,
                                                             Uint32                                CtxId,
@@ -165,6 +216,8 @@ private:
             int8_t                                      SetIndex              = -1;
             uint8_t                                     NumDynamicDescriptors = 0; // Total number of uniform and storage buffers, counting all array elements
             uint16_t                                    NumLayoutBindings     = 0;
+            bool                                        IsPushDescriptorSet   = false; // Created with VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR
+            bool                                        IsUpdateAfterBind     = false; // All bindings are partially bound and can be updated after the set is bound
             VkDescriptorSetLayoutBinding*               pBindings             = nullptr;
             VulkanUtilities::DescriptorSetLayoutWrapper VkLayout;
 
@@ -192,18 +245,24 @@ private:
         DescriptorSetLayoutManager& operator= (DescriptorSetLayoutManager&&)      = delete;
         // clang-format on
 
-        void Finalize(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice);
+        void Finalize(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice, Uint32 MaxPushDescriptors);
         void Release(RenderDeviceVkImpl* pRenderDeviceVk, Uint64 CommandQueueMask);
 
         DescriptorSetLayout&       GetDescriptorSet(SHADER_RESOURCE_VARIABLE_TYPE VarType) { return m_DescriptorSetLayouts[VarType == SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC ? 1 : 0]; }
         const DescriptorSetLayout& GetDescriptorSet(SHADER_RESOURCE_VARIABLE_TYPE VarType) const { return m_DescriptorSetLayouts[VarType == SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC ? 1 : 0]; }
 
+        // Runtime-sized arrays of mutable variables are kept in a separate set as update-after-bind
+        // sets must not contain dynamic uniform or storage buffers (13.2.1)
+        DescriptorSetLayout&       GetUpdateAfterBindSet() { return m_DescriptorSetLayouts[2]; }
+        const DescriptorSetLayout& GetUpdateAfterBindSet() const { return m_DescriptorSetLayouts[2]; }
+
         bool             operator==(const DescriptorSetLayoutManager& rhs) const;
         bool             operator!=(const DescriptorSetLayoutManager& rhs) const { return !(*this == rhs); }
         size_t           GetHash() const;
         VkPipelineLayout GetVkPipelineLayout() const { return m_VkPipelineLayout; }
 
         void AllocateResourceSlot(const SPIRVShaderResourceAttribs& ResAttribs,
+                                  Uint32                            ArraySize,
                                   SHADER_RESOURCE_VARIABLE_TYPE     VariableType,
                                   VkSampler                         vkImmutableSampler,
                                   SHADER_TYPE                       ShaderType,
@@ -214,7 +273,7 @@ private:
     private:
         IMemoryAllocator&                                                                           m_MemAllocator;
         VulkanUtilities::PipelineLayoutWrapper                                                      m_VkPipelineLayout;
-        std::array<DescriptorSetLayout, 2>                                                          m_DescriptorSetLayouts;
+        std::array<DescriptorSetLayout, 3>                                                          m_DescriptorSetLayouts;
         std::vector<VkDescriptorSetLayoutBinding, STDAllocatorRawMem<VkDescriptorSetLayoutBinding>> m_LayoutBindings;
         uint8_t                                                                                     m_ActiveSets = 0;
     };
@@ -232,6 +291,8 @@ __forceinline void PipelineLayout::BindDescriptorSetsWithDynamicOffsets(VulkanUt
     VERIFY(BindInfo.pDbgPipelineLayout != nullptr, "Pipeline layout is not initialized, which most likely means that CommitShaderResources() has never been called");
     VERIFY(BindInfo.pDbgPipelineLayout->IsSameAs(*this), "Inconsistent pipeline layout");
     VERIFY(BindInfo.DynamicOffsetCount > 0, "This function should only be called for pipelines that contain dynamic descriptors");
+    // Push descriptor sets never contain dynamic buffers, so there must be at least one set to bind
+    VERIFY_EXPR(BindInfo.SetCout > 0);
 
     VERIFY_EXPR(BindInfo.pResourceCache != nullptr);
 #ifdef DILIGENT_DEBUG
@@ -258,7 +319,7 @@ __forceinline void PipelineLayout::BindDescriptorSetsWithDynamicOffsets(VulkanUt
     // applied via these sets are no longer valid (13.2.5)
     CmdBuffer.BindDescriptorSets(BindInfo.BindPoint,
                                  m_LayoutMgr.GetVkPipelineLayout(),
-                                 0, // First set
+                                 BindInfo.FirstSet,
                                  BindInfo.SetCout,
                                  BindInfo.vkSets.data(), // BindInfo.vkSets is never empty
                                  // dynamicOffsetCount must equal the total number of dynamic descriptors in the sets being bound (13.2.5)
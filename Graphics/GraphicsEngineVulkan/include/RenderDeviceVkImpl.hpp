@@ -30,6 +30,9 @@
 /// \file
 /// Declaration of Diligent::RenderDeviceVkImpl class
 #include <memory>
+#include <mutex>
+#include <vector>
+#include <array>
 
 #include "RenderDeviceVk.h"
 #include "RenderDeviceBase.hpp"
@@ -163,6 +166,40 @@ public:
                                                                  RESOURCE_STATE             InitialState,
                                                                  ITopLevelAS**              ppTLAS) override final;
 
+    /// Implementation of IRenderDeviceVk::CreateShaderFromSPIRV().
+    virtual void DILIGENT_CALL_TYPE CreateShaderFromSPIRV(const ShaderCreateInfo& ShaderCI,
+                                                          const void*             pSerializedResources,
+                                                          size_t                  SerializedResourcesSize,
+                                                          IShader**               ppShader) override final;
+
+    /// Implementation of IRenderDeviceVk::CreateTransientTexture().
+    virtual void DILIGENT_CALL_TYPE CreateTransientTexture(const TextureDesc& TexDesc,
+                                                           Uint32             FirstUse,
+                                                           Uint32             LastUse,
+                                                           ITexture**         ppTexture) override final;
+
+    /// Implementation of IRenderDeviceVk::GetMemoryHeapCount().
+    virtual Uint32 DILIGENT_CALL_TYPE GetMemoryHeapCount() const override final;
+
+    /// Implementation of IRenderDeviceVk::GetMemoryHeapBudget().
+    virtual MemoryHeapBudgetVk DILIGENT_CALL_TYPE GetMemoryHeapBudget(Uint32 HeapIndex) override final;
+
+    /// Implementation of IRenderDeviceVk::AddMemoryBudgetCallback().
+    virtual Uint32 DILIGENT_CALL_TYPE AddMemoryBudgetCallback(Float32                  Threshold,
+                                                              MemoryBudgetCallbackType Callback,
+                                                              void*                    pUserData) override final;
+
+    /// Implementation of IRenderDeviceVk::RemoveMemoryBudgetCallback().
+    virtual void DILIGENT_CALL_TYPE RemoveMemoryBudgetCallback(Uint32 CallbackId) override final;
+
+    /// Implementation of IRenderDeviceVk::CopyTexturesOnTransferQueue().
+    virtual Bool DILIGENT_CALL_TYPE CopyTexturesOnTransferQueue(IDeviceContext*           pImmediateContext,
+                                                                const CopyTextureAttribs* pCopyAttribs,
+                                                                Uint32                    NumCopies) override final;
+
+    // Checks memory usage of all heaps and calls memory budget callbacks whose thresholds have been crossed.
+    void CheckMemoryBudget();
+
     /// Implementation of IRenderDevice::IdleGPU() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE IdleGPU() override final;
 
@@ -173,6 +210,52 @@ public:
     void AllocateTransientCmdPool(VulkanUtilities::CommandPoolWrapper& CmdPool, VkCommandBuffer& vkCmdBuff, const Char* DebugPoolName = nullptr);
     void ExecuteAndDisposeTransientCmdBuff(Uint32 QueueIndex, VkCommandBuffer vkCmdBuff, VulkanUtilities::CommandPoolWrapper&& CmdPool);
 
+    static constexpr Uint32 InvalidQueueIndex = ~Uint32{0};
+
+    // Returns true if the device has a queue from a dedicated transfer queue family that is
+    // used to upload initial data of buffers and textures.
+    bool   HasTransferQueue() const { return m_TransferQueueIndex != InvalidQueueIndex; }
+    Uint32 GetTransferQueueIndex() const { return m_TransferQueueIndex; }
+
+    // Allocates a one-time command buffer for the transfer queue. Must only be called if HasTransferQueue() returns true.
+    void AllocateTransferCmdPool(VulkanUtilities::CommandPoolWrapper& CmdPool, VkCommandBuffer& vkCmdBuff, const Char* DebugPoolName = nullptr);
+
+    // Submits the command buffer to the transfer queue and hands the resources written by it over to the graphics queue.
+    // srcAccessMask of every barrier must describe the writes performed by the command buffer, and dstAccessMask
+    // the accesses that follow on the graphics queue; image barriers must not change the layout. The method
+    // sets the queue family indices, records the release barriers at the end of the command buffer and defers
+    // the matching acquire barriers until the next submission to the graphics queue.
+    void ExecuteAndDisposeTransferCmdBuff(VkCommandBuffer                       vkCmdBuff,
+                                          VulkanUtilities::CommandPoolWrapper&& CmdPool,
+                                          Uint32                                NumBufferBarriers,
+                                          const VkBufferMemoryBarrier*          pBufferBarriers,
+                                          Uint32                                NumImageBarriers,
+                                          const VkImageMemoryBarrier*           pImageBarriers,
+                                          VulkanUtilities::SemaphoreWrapper&&   WaitSemaphore = {});
+
+    // Moves stale resources of the transfer queue into its release queue and purges the queue.
+    void DiscardTransferQueueStaleResources();
+
+    // Returns the mask of the command queues used by compute contexts.
+    Uint64 GetComputeQueueMask() const { return m_ComputeQueueMask; }
+
+    // Returns the queue families that share buffers and textures when there are compute contexts,
+    // or an empty list if resources are only used by the graphics queue family.
+    const std::vector<uint32_t>& GetConcurrentQueueFamilies() const { return m_ConcurrentQueueFamilies; }
+
+    // Returns true if fences are signaled and waited for on the GPU with a timeline semaphore.
+    bool UseTimelineSemaphores() const { return m_UseTimelineSemaphores; }
+
+    // Any object that may be used by the graphics queue may also be used by compute contexts,
+    // so its release is also deferred until the compute queues no longer use it.
+    template <typename ObjectType, typename = typename std::enable_if<std::is_object<ObjectType>::value>::type>
+    void SafeReleaseDeviceObject(ObjectType&& Object, Uint64 QueueMask)
+    {
+        if ((QueueMask & Uint64{1}) != 0)
+            QueueMask |= m_ComputeQueueMask;
+        TRenderDeviceBase::SafeReleaseDeviceObject(std::move(Object), QueueMask);
+    }
+
     /// Implementation of IRenderDevice::ReleaseStaleResources() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE ReleaseStaleResources(bool ForceRelease = false) override final;
 
@@ -180,6 +263,11 @@ public:
     {
         return m_DescriptorSetAllocator.Allocate(CommandQueueMask, SetLayout, DebugName);
     }
+    DescriptorSetAllocation AllocateUpdateAfterBindDescriptorSet(Uint64 CommandQueueMask, VkDescriptorSetLayout SetLayout, const char* DebugName = "")
+    {
+        VERIFY(m_RuntimeDescriptorArraySize != 0, "Update-after-bind descriptor sets require descriptor indexing");
+        return m_UpdateAfterBindDescriptorSetAllocator.Allocate(CommandQueueMask, SetLayout, DebugName);
+    }
     DescriptorPoolManager& GetDynamicDescriptorPool() { return m_DynamicDescriptorPool; }
 
     std::shared_ptr<const VulkanUtilities::VulkanInstance> GetVulkanInstance() const { return m_VulkanInstance; }
@@ -190,6 +278,18 @@ public:
     FramebufferCache& GetFramebufferCache() { return m_FramebufferCache; }
     RenderPassCache&  GetImplicitRenderPassCache() { return m_ImplicitRenderPassCache; }
 
+    // Returns true if render targets set by IDeviceContext::SetRenderTargets() are rendered to with
+    // VK_KHR_dynamic_rendering instead of implicit render passes and framebuffers.
+    bool UseDynamicRendering() const { return m_UseDynamicRendering; }
+
+    // Returns the maximum number of descriptors in a push descriptor set, or zero if
+    // VK_KHR_push_descriptor is not enabled.
+    Uint32 GetMaxPushDescriptors() const { return m_MaxPushDescriptors; }
+
+    // Returns the number of descriptors in runtime-sized shader resource arrays, or zero if
+    // descriptor indexing is not enabled and such arrays are not supported.
+    Uint32 GetRuntimeDescriptorArraySize() const { return m_RuntimeDescriptorArraySize; }
+
     VulkanUtilities::VulkanMemoryAllocation AllocateMemory(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProperties, VkMemoryAllocateFlags AllocateFlags = 0)
     {
         return m_MemoryMgr.Allocate(MemReqs, MemoryProperties, AllocateFlags);
@@ -201,6 +301,10 @@ public:
         const auto MemoryFlags = MemoryProps.memoryTypes[MemoryTypeIndex].propertyFlags;
         return m_MemoryMgr.Allocate(Size, Alignment, MemoryTypeIndex, (MemoryFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0, AllocateFlags);
     }
+    VulkanUtilities::VulkanMemoryAllocation AllocateTransientMemory(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProperties, Uint32 FirstUse, Uint32 LastUse)
+    {
+        return m_MemoryMgr.AllocateTransient(MemReqs, MemoryProperties, FirstUse, LastUse);
+    }
     VulkanUtilities::VulkanMemoryManager& GetGlobalMemoryManager() { return m_MemoryMgr; }
 
     VulkanDynamicMemoryManager& GetDynamicMemoryManager() { return m_DynamicMemoryManager; }
@@ -237,22 +341,59 @@ private:
     //      * SubmittedFenceValue    - fence value associated with the submitted command buffer
     void SubmitCommandBuffer(Uint32 QueueIndex, const VkSubmitInfo& SubmitInfo, Uint64& SubmittedCmdBuffNumber, Uint64& SubmittedFenceValue, std::vector<std::pair<Uint64, RefCntAutoPtr<IFence>>>* pFences);
 
+    // Submits the pending transfer queue acquire barriers to the graphics queue. If pReleaseBarriers is not null,
+    // the barriers that release the images to the transfer queue are recorded after the acquire barriers and
+    // the returned semaphore is signaled when the submitted commands are complete.
+    VulkanUtilities::SemaphoreWrapper SubmitGraphicsQueueOwnershipTransfers(const std::vector<VkImageMemoryBarrier>* pReleaseBarriers = nullptr);
+
+    // Releases the binary semaphores of the fences whose values have been completed.
+    // Called when the release queues are purged.
+    void ReleaseCompletedFenceSemaphores();
+
     std::shared_ptr<VulkanUtilities::VulkanInstance>       m_VulkanInstance;
     std::unique_ptr<VulkanUtilities::VulkanPhysicalDevice> m_PhysicalDevice;
     std::shared_ptr<VulkanUtilities::VulkanLogicalDevice>  m_LogicalVkDevice;
 
     EngineVkCreateInfo m_EngineAttribs;
 
+    // Mask of the queues from compute-only families
+    Uint64 m_ComputeQueueMask = 0;
+
+    // Must be initialized before the dynamic memory manager that creates the dynamic heap buffer
+    const std::vector<uint32_t> m_ConcurrentQueueFamilies;
+
     FramebufferCache       m_FramebufferCache;
     RenderPassCache        m_ImplicitRenderPassCache;
     DescriptorSetAllocator m_DescriptorSetAllocator;
     DescriptorPoolManager  m_DynamicDescriptorPool;
+    DescriptorSetAllocator m_UpdateAfterBindDescriptorSetAllocator;
 
     // These one-time command pools are used by buffer and texture constructors to
     // issue copy commands. Vulkan requires that every command pool is used by one thread
     // at a time, so every constructor must allocate command buffer from its own pool.
     CommandPoolManager m_TransientCmdPoolMgr;
 
+    // Index of the queue from a dedicated transfer family, or InvalidQueueIndex if there is no such queue.
+    Uint32   m_TransferQueueIndex       = InvalidQueueIndex;
+    uint32_t m_GraphicsQueueFamilyIndex = 0;
+    uint32_t m_TransferQueueFamilyIndex = 0;
+
+    std::unique_ptr<CommandPoolManager> m_TransferCmdPoolMgr;
+
+    // Resources uploaded on the transfer queue that the graphics queue has not acquired yet
+    struct PendingTransferAcquire
+    {
+        VulkanUtilities::SemaphoreWrapper  Semaphore;
+        std::vector<VkBufferMemoryBarrier> BufferBarriers;
+        std::vector<VkImageMemoryBarrier>  ImageBarriers;
+    };
+    std::mutex                          m_PendingTransferAcquiresMtx;
+    std::vector<PendingTransferAcquire> m_PendingTransferAcquires;
+
+    // Fences that have signaled binary semaphores that may never be waited for
+    std::mutex                         m_FencesWithSemaphoresMtx;
+    std::vector<RefCntWeakPtr<IFence>> m_FencesWithSemaphores;
+
     VulkanUtilities::VulkanMemoryManager m_MemoryMgr;
 
     VulkanDynamicMemoryManager m_DynamicMemoryManager;
@@ -260,6 +401,26 @@ private:
     std::unique_ptr<IDXCompiler> m_pDxCompiler;
 
     Properties m_Properties;
+
+    bool   m_UseDynamicRendering   = false;
+    Uint32 m_MaxPushDescriptors         = 0;
+    bool   m_UseTimelineSemaphores      = false;
+    Uint32 m_RuntimeDescriptorArraySize = 0;
+
+    void GetMemoryHeapBudgets(MemoryHeapBudgetVk Budgets[VK_MAX_MEMORY_HEAPS]);
+
+    struct MemoryBudgetCallbackInfo
+    {
+        Uint32                   Id        = 0;
+        Float32                  Threshold = 0;
+        MemoryBudgetCallbackType Callback  = nullptr;
+        void*                    pUserData = nullptr;
+
+        std::array<bool, VK_MAX_MEMORY_HEAPS> IsOverThreshold = {};
+    };
+    std::mutex                            m_MemoryBudgetCallbacksMtx;
+    std::vector<MemoryBudgetCallbackInfo> m_MemoryBudgetCallbacks;
+    Uint32                                m_NextMemoryBudgetCallbackId = 1;
 };
 
 } // namespace Diligent
@@ -101,6 +101,7 @@ namespace Diligent
 {
 
 class ShaderVkImpl;
+class PushDescriptorWriter;
 
 /// Diligent::ShaderResourceLayoutVk class
 // sizeof(ShaderResourceLayoutVk)==40 (MS compiler, x64)
@@ -176,8 +177,10 @@ public:
 
         static constexpr const Uint32 InvalidSamplerInd  = (1 << SamplerIndBits)-1;
 
-        static constexpr const Uint32 ResourceDimBits = 7;
-        static constexpr const Uint32 IsMSFlagBits    = 8 - ResourceDimBits;
+        static constexpr const Uint32 ResourceDimBits           = 6;
+        static constexpr const Uint32 IsMSFlagBits              = 1;
+        static constexpr const Uint32 UpdateAfterBindFlagBits   = 1;
+        static_assert(ResourceDimBits + IsMSFlagBits + UpdateAfterBindFlagBits == 8, "Elements are expected to be packed into 8 bits");
         static_assert(RESOURCE_DIM_NUM_DIMENSIONS <= (1 << ResourceDimBits), "Not enough bits to represent RESOURCE_DIMENSION");
 
         using ResourceType = SPIRVShaderResourceAttribs::ResourceType;
@@ -191,11 +194,12 @@ public:
 /* 7.5 */ const Uint32 VariableType             : VariableTypeBits;  
 /* 7.7 */ const Uint32 ImmutableSamplerAssigned : ImmutableSamplerFlagBits;
 
-/* 8   */ const Uint16 ArraySize;
+/* 8   */ const Uint16 ArraySize; // For runtime-sized arrays, the number of descriptors allocated in the update-after-bind set
 
 /* 10  */ const ResourceType                Type;
-/* 11.0*/ const Uint8                       ResourceDim : ResourceDimBits;
-/* 11.7*/ const Uint8                       IsMS        : IsMSFlagBits;
+/* 11.0*/ const Uint8                       ResourceDim     : ResourceDimBits;
+/* 11.6*/ const Uint8                       IsMS            : IsMSFlagBits;
+/* 11.7*/ const Uint8                       UpdateAfterBind : UpdateAfterBindFlagBits; // Runtime-sized array in the update-after-bind set
 
 /* 16  */ const char* const                 Name;
 /* 24  */ const ShaderResourceLayoutVk&     ParentResLayout;
@@ -209,6 +213,7 @@ public:
         VkResource(const ShaderResourceLayoutVk&     _ParentLayout,
                    const char*                       _Name,
                    const SPIRVShaderResourceAttribs& _Attribs,
+                   Uint32                            _ArraySize,
                    SHADER_RESOURCE_VARIABLE_TYPE     _VariableType,
                    uint32_t                          _Binding,
                    uint32_t                          _DescriptorSet,
@@ -222,10 +227,11 @@ public:
             SamplerInd               {_SamplerInd  },
             VariableType             {_VariableType},
             ImmutableSamplerAssigned {_ImmutableSamplerAssigned ? 1U : 0U},
-            ArraySize                {_Attribs.ArraySize  },
+            ArraySize                {static_cast<decltype(ArraySize)>(_ArraySize)},
             Type                     {_Attribs.Type       },
             ResourceDim              {_Attribs.ResourceDim},
             IsMS                     {_Attribs.IsMS       },
+            UpdateAfterBind          {_Attribs.ArraySize == 0 ? Uint8{1} : Uint8{0}},
 #ifdef DILIGENT_DEVELOPMENT
             BufferStaticSize         {_Attribs.BufferStaticSize},
             BufferStride             {_Attribs.BufferStride    },
@@ -244,6 +250,8 @@ public:
             VERIFY(_DescriptorSet <= std::numeric_limits<decltype(DescriptorSet)>::max(), "Descriptor set (", _DescriptorSet, ") exceeds max representable value ", std::numeric_limits<decltype(DescriptorSet)>::max());
             VERIFY(_VariableType  < (1 << VariableTypeBits),                              "Variable type (", Uint32{_VariableType}, ") exceeds max representable value ", (1 << VariableTypeBits) );
             VERIFY(_Attribs.ResourceDim < (1 << ResourceDimBits),                         "Resource dimension (", Uint32{_Attribs.ResourceDim}, ") exceeds max representable value ", (1 << ResourceDimBits) );
+            VERIFY(_ArraySize     <= std::numeric_limits<decltype(ArraySize)>::max(),     "Array size (", _ArraySize, ") exceeds max representable value ", std::numeric_limits<decltype(ArraySize)>::max());
+            VERIFY(_ArraySize == _Attribs.ArraySize || _Attribs.ArraySize == 0,           "Array size may only be overridden for runtime-sized arrays");
             // clang-format on
         }
 
@@ -276,6 +284,17 @@ public:
             return static_cast<SHADER_RESOURCE_VARIABLE_TYPE>(VariableType);
         }
 
+        bool IsUpdateAfterBind() const
+        {
+            return UpdateAfterBind != 0;
+        }
+
+        // Elements of update-after-bind arrays may be rebound at any time, the same way as dynamic variables
+        SHADER_RESOURCE_VARIABLE_TYPE GetRebindVariableType() const
+        {
+            return IsUpdateAfterBind() ? SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC : GetVariableType();
+        }
+
         String GetPrintName(Uint32 ArrayInd) const
         {
             VERIFY_EXPR(ArrayInd < ArraySize);
@@ -307,10 +326,11 @@ public:
         bool IsCompatibleWith(const VkResource& rhs) const
         {
             // clang-format off
-            return Binding       == rhs.Binding       &&
-                   DescriptorSet == rhs.DescriptorSet &&
-                   ArraySize     == rhs.ArraySize     &&
-                   Type          == rhs.Type;
+            return Binding         == rhs.Binding         &&
+                   DescriptorSet   == rhs.DescriptorSet   &&
+                   ArraySize       == rhs.ArraySize       &&
+                   Type            == rhs.Type            &&
+                   UpdateAfterBind == rhs.UpdateAfterBind;
             // clang-format on
         }
 
@@ -387,6 +407,10 @@ public:
     void CommitDynamicResources(const ShaderResourceCacheVk& ResourceCache,
                                 VkDescriptorSet              vkDynamicDescriptorSet) const;
 
+    // Adds dynamic resource descriptor writes from ResourceCache to the push descriptor writer
+    void CommitDynamicResources(const ShaderResourceCacheVk& ResourceCache,
+                                PushDescriptorWriter&        PushWriter) const;
+
     const Char* GetShaderName() const
     {
         return GetStringPoolData();
@@ -406,6 +430,12 @@ public:
     bool IsCompatibleWith(const ShaderResourceLayoutVk& ResLayout) const;
 
 private:
+    // Batches descriptor writes of all dynamic resources and passes every batch to FlushWrites
+    template <typename HandlerType>
+    void WriteDynamicResourceDescriptors(const ShaderResourceCacheVk& ResourceCache,
+                                         VkDescriptorSet              vkDynamicDescriptorSet,
+                                         HandlerType                  FlushWrites) const;
+
     Uint32 GetResourceOffset(SHADER_RESOURCE_VARIABLE_TYPE VarType, Uint32 r) const
     {
         VERIFY_EXPR(r < m_NumResources[VarType]);
@@ -48,7 +48,13 @@ class ShaderVkImpl final : public ShaderBase<IShaderVk, RenderDeviceVkImpl>
 public:
     using TShaderBase = ShaderBase<IShaderVk, RenderDeviceVkImpl>;
 
-    ShaderVkImpl(IReferenceCounters* pRefCounters, RenderDeviceVkImpl* pRenderDeviceVk, const ShaderCreateInfo& CreationAttribs);
+    // If pSerializedResources is not null, shader resources are loaded from the serialized
+    // data instead of reflecting the SPIRV byte code (see SPIRVShaderResources::Serialize()).
+    ShaderVkImpl(IReferenceCounters*     pRefCounters,
+                 RenderDeviceVkImpl*     pRenderDeviceVk,
+                 const ShaderCreateInfo& CreationAttribs,
+                 const void*             pSerializedResources    = nullptr,
+                 size_t                  SerializedResourcesSize = 0);
     ~ShaderVkImpl();
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_ShaderVk, TShaderBase)
@@ -74,6 +80,7 @@ public:
 
 private:
     void MapHLSLVertexShaderInputs();
+    void ValidateSerializedResources() const;
 
     // SPIRVShaderResources class instance must be referenced through the shared pointer, because
     // it is referenced by ShaderResourceLayoutVk class instances
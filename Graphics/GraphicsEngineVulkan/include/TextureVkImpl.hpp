@@ -49,12 +49,15 @@ public:
     using TTextureBase = TextureBase<ITextureVk, RenderDeviceVkImpl, TextureViewVkImpl, FixedBlockMemoryAllocator>;
     using ViewImplType = TextureViewVkImpl;
 
-    // Creates a new Vk resource
+    // Creates a new Vk resource. TransientFirstUse and TransientLastUse define the usage
+    // interval of a texture created with MISC_TEXTURE_FLAG_TRANSIENT flag.
     TextureVkImpl(IReferenceCounters*        pRefCounters,
                   FixedBlockMemoryAllocator& TexViewObjAllocator,
                   RenderDeviceVkImpl*        pDeviceVk,
                   const TextureDesc&         TexDesc,
-                  const TextureData*         pInitData = nullptr);
+                  const TextureData*         pInitData         = nullptr,
+                  Uint32                     TransientFirstUse = 0,
+                  Uint32                     TransientLastUse  = ~Uint32{0});
 
     // Attaches to an existing Vk resource
     TextureVkImpl(IReferenceCounters*        pRefCounters,
@@ -99,6 +102,22 @@ public:
 
     void InvalidateStagingRange(VkDeviceSize Offset, VkDeviceSize Size);
 
+    bool IsTransient() const { return m_MemoryAllocation.TransientRangeId != 0; }
+
+    // Returns true if memory of the transient texture has been taken over by another
+    // transient texture since this texture last acquired it.
+    bool IsTransientMemoryOverwritten() const
+    {
+        VERIFY_EXPR(IsTransient());
+        return m_MemoryAllocation.Page->IsTransientRangeOverwritten(m_MemoryAllocation.TransientRangeId);
+    }
+
+    void AcquireTransientMemory()
+    {
+        VERIFY_EXPR(IsTransient());
+        m_MemoryAllocation.Page->AcquireTransientRange(m_MemoryAllocation.TransientRangeId);
+    }
+
     // Buffer offset must be a multiple of 4 (18.4)
     static constexpr Uint32 StagingBufferOffsetAlignment = 4;
 
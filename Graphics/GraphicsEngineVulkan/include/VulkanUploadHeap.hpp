@@ -28,6 +28,11 @@
 #pragma once
 
 #include <unordered_map>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
 #include "VulkanUtilities/VulkanMemoryManager.hpp"
 #include "VulkanUtilities/VulkanObjectWrappers.hpp"
 
@@ -38,7 +43,11 @@ namespace Diligent
 // UpdateBufferRegion() and UpdateTextureRegion().
 //
 // The heap allocates pages from the global memory manager.
-// The pages are released and returned to the manager at the end of every frame.
+// At the end of every frame, the pages are handed over to the release queues. Once the GPU
+// is done with a page, it is returned to the heap's page pool and reused by subsequent
+// allocations instead of creating a new buffer. Large allocations use pages whose size is
+// rounded up to a power of two, so that they can be cached in size buckets as well.
+// Pages that have not been reused for a while are returned to the memory manager.
 //
 //   _______________________________________________________________________________________________________________________________
 //  |                                                                                                                               |
@@ -49,12 +58,23 @@ namespace Diligent
 //  |__________|____________________________________________________________________________________________________________________|
 //             |                                      A                   |
 //             |                                      |                   |
-//             |Allocate()             CreateNewPage()|                   |ReleaseAllocatedPages()
+//             |Allocate()              AcquirePage()|                   |ReleaseAllocatedPages()
 //             |                                ______|___________________V____
 //             V                               |                              |
-//   VulkanUploadAllocation                    |    Global Memory Manager     |
-//                                             |    (VulkanMemoryManager)     |
+//   VulkanUploadAllocation                    |         Release queue        |
+//                                             |______________________________|
+//                                                    A                   |
+//                                                    |                   |Fence completed
+//                                              ______|___________________V____
 //                                             |                              |
+//                                             |          Page pool           |
+//                                             |______________________________|
+//                                                    A                   |
+//                                     CreateNewPage()|                   |TrimPagePool()
+//                                              ______|___________________V____
+//                                             |                              |
+//                                             |    Global Memory Manager     |
+//                                             |    (VulkanMemoryManager)     |
 //                                             |______________________________|
 //
 class RenderDeviceVkImpl;
@@ -102,9 +122,10 @@ public:
 
     VulkanUploadAllocation Allocate(VkDeviceSize SizeInBytes, VkDeviceSize Alignment);
 
-    // Releases all allocated pages that are later returned to the global memory manager by the release queues.
-    // As global memory manager is hosted by the render device, the upload heap can be destroyed before the
-    // pages are actually returned to the manager.
+    // Releases all allocated pages that are later returned to the page pool by the release queues once
+    // the GPU is done with them. Pages that stay unused in the pool for a while are returned to the global
+    // memory manager. The pool is shared with the release queues, so the upload heap can be destroyed before
+    // the pages are actually returned; in this case they go directly to the memory manager.
     void ReleaseAllocatedPages(Uint64 CmdQueueMask);
 
     size_t GetStalePagesCount() const
@@ -122,20 +143,51 @@ private:
         // clang-format off
         UploadPageInfo(VulkanUtilities::VulkanMemoryAllocation&& _MemAllocation, 
                        VulkanUtilities::BufferWrapper&&          _Buffer,
-                       Uint8*                                    _CPUAddress) :
+                       Uint8*                                    _CPUAddress,
+                       VkDeviceSize                              _Size) :
             MemAllocation{std::move(_MemAllocation)},
             Buffer       {std::move(_Buffer)       },
-            CPUAddress   {_CPUAddress              }
+            CPUAddress   {_CPUAddress              },
+            Size         {_Size                    }
         {
         }
+
+        UploadPageInfo            (const UploadPageInfo&)  = delete;
+        UploadPageInfo& operator= (const UploadPageInfo&)  = delete;
+        UploadPageInfo            (      UploadPageInfo&&) = default;
+        UploadPageInfo& operator= (      UploadPageInfo&&) = default;
         // clang-format on
 
         VulkanUtilities::VulkanMemoryAllocation MemAllocation;
         VulkanUtilities::BufferWrapper          Buffer;
-        Uint8* const                            CPUAddress = nullptr;
+        Uint8*                                  CPUAddress = nullptr;
+        // Size of the buffer, which may be smaller than the size of the memory allocation
+        VkDeviceSize Size = 0;
     };
     std::vector<UploadPageInfo> m_Pages;
 
+    // Pages that are no longer used by the GPU, keyed by the page size.
+    // The pool is shared with the stale pages in the release queues because the
+    // heap may be destroyed before all pages are returned.
+    struct PagePool
+    {
+        struct FreePage
+        {
+            UploadPageInfo                        Page;
+            std::chrono::steady_clock::time_point ReleaseTime;
+        };
+
+        std::mutex                                              Mtx;
+        std::unordered_map<VkDeviceSize, std::vector<FreePage>> FreePages;
+
+        // When the heap is destroyed, returned pages are released immediately
+        bool IsHeapAlive = true;
+
+        // Total size of all pages created by the heap that have not been destroyed yet
+        std::atomic<VkDeviceSize> ResidentSize{0};
+    };
+    std::shared_ptr<PagePool> m_pPagePool;
+
     struct CurrPageInfo
     {
         VkBuffer     vkBuffer       = VK_NULL_HANDLE;
@@ -163,8 +215,15 @@ private:
     VkDeviceSize m_PeakFrameSize     = 0;
     VkDeviceSize m_CurrAllocatedSize = 0;
     VkDeviceSize m_PeakAllocatedSize = 0;
+    VkDeviceSize m_PeakResidentSize  = 0;
+
+    Uint64 m_PoolHits   = 0;
+    Uint64 m_PoolMisses = 0;
 
     UploadPageInfo CreateNewPage(VkDeviceSize SizeInBytes) const;
+    UploadPageInfo AcquirePage(VkDeviceSize PageSize);
+    void           TrimPagePool();
+    VkDeviceSize   GetLargePageSize(VkDeviceSize SizeInBytes) const;
 };
 
 } // namespace Diligent
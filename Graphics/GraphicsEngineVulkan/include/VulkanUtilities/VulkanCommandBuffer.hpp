@@ -52,7 +52,7 @@ public:
                                        const VkImageSubresourceRange& Subresource)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "vkCmdClearColorImage() must be called outside of render pass (17.1)");
+        VERIFY(!IsInsideRenderPass(), "vkCmdClearColorImage() must be called outside of render pass (17.1)");
         VERIFY(Subresource.aspectMask == VK_IMAGE_ASPECT_COLOR_BIT, "The aspectMask of all image subresource ranges must only include VK_IMAGE_ASPECT_COLOR_BIT (17.1)");
 
         vkCmdClearColorImage(
@@ -69,7 +69,7 @@ public:
                                               const VkImageSubresourceRange&  Subresource)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "vkCmdClearDepthStencilImage() must be called outside of render pass (17.1)");
+        VERIFY(!IsInsideRenderPass(), "vkCmdClearDepthStencilImage() must be called outside of render pass (17.1)");
         // clang-format off
         VERIFY((Subresource.aspectMask &  (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT)) != 0 &&
                (Subresource.aspectMask & ~(VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT)) == 0,
@@ -88,7 +88,7 @@ public:
     __forceinline void ClearAttachment(const VkClearAttachment& Attachment, const VkClearRect& ClearRect)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdClearAttachments() must be called inside render pass (17.2)");
+        VERIFY(IsInsideRenderPass(), "vkCmdClearAttachments() must be called inside render pass (17.2)");
 
         vkCmdClearAttachments(
             m_VkCmdBuffer,
@@ -103,7 +103,7 @@ public:
     __forceinline void Draw(uint32_t VertexCount, uint32_t InstanceCount, uint32_t FirstVertex, uint32_t FirstInstance)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdDraw() must be called inside render pass (19.3)");
+        VERIFY(IsInsideRenderPass(), "vkCmdDraw() must be called inside render pass (19.3)");
         VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
 
         vkCmdDraw(m_VkCmdBuffer, VertexCount, InstanceCount, FirstVertex, FirstInstance);
@@ -112,7 +112,7 @@ public:
     __forceinline void DrawIndexed(uint32_t IndexCount, uint32_t InstanceCount, uint32_t FirstIndex, int32_t VertexOffset, uint32_t FirstInstance)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdDrawIndexed() must be called inside render pass (19.3)");
+        VERIFY(IsInsideRenderPass(), "vkCmdDrawIndexed() must be called inside render pass (19.3)");
         VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
         VERIFY(m_State.IndexBuffer != VK_NULL_HANDLE, "No index buffer bound");
 
@@ -122,7 +122,7 @@ public:
     __forceinline void DrawIndirect(VkBuffer Buffer, VkDeviceSize Offset, uint32_t DrawCount, uint32_t Stride)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdDrawIndirect() must be called inside render pass (19.3)");
+        VERIFY(IsInsideRenderPass(), "vkCmdDrawIndirect() must be called inside render pass (19.3)");
         VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
 
         vkCmdDrawIndirect(m_VkCmdBuffer, Buffer, Offset, DrawCount, Stride);
@@ -131,18 +131,39 @@ public:
     __forceinline void DrawIndexedIndirect(VkBuffer Buffer, VkDeviceSize Offset, uint32_t DrawCount, uint32_t Stride)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdDrawIndirect() must be called inside render pass (19.3)");
+        VERIFY(IsInsideRenderPass(), "vkCmdDrawIndirect() must be called inside render pass (19.3)");
         VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
         VERIFY(m_State.IndexBuffer != VK_NULL_HANDLE, "No index buffer bound");
 
         vkCmdDrawIndexedIndirect(m_VkCmdBuffer, Buffer, Offset, DrawCount, Stride);
     }
 
+#if DILIGENT_VK_DRAW_INDIRECT_COUNT_SUPPORTED
+    __forceinline void DrawIndirectCount(VkBuffer Buffer, VkDeviceSize Offset, VkBuffer CountBuffer, VkDeviceSize CountBufferOffset, uint32_t MaxDrawCount, uint32_t Stride)
+    {
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        VERIFY(IsInsideRenderPass(), "vkCmdDrawIndirectCountKHR() must be called inside render pass");
+        VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
+
+        vkCmdDrawIndirectCountKHR(m_VkCmdBuffer, Buffer, Offset, CountBuffer, CountBufferOffset, MaxDrawCount, Stride);
+    }
+
+    __forceinline void DrawIndexedIndirectCount(VkBuffer Buffer, VkDeviceSize Offset, VkBuffer CountBuffer, VkDeviceSize CountBufferOffset, uint32_t MaxDrawCount, uint32_t Stride)
+    {
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        VERIFY(IsInsideRenderPass(), "vkCmdDrawIndexedIndirectCountKHR() must be called inside render pass");
+        VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
+        VERIFY(m_State.IndexBuffer != VK_NULL_HANDLE, "No index buffer bound");
+
+        vkCmdDrawIndexedIndirectCountKHR(m_VkCmdBuffer, Buffer, Offset, CountBuffer, CountBufferOffset, MaxDrawCount, Stride);
+    }
+#endif
+
     __forceinline void DrawMesh(uint32_t TaskCount, uint32_t FirstTask)
     {
 #if DILIGENT_USE_VOLK
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdDrawMeshTasksNV() must be called inside render pass");
+        VERIFY(IsInsideRenderPass(), "vkCmdDrawMeshTasksNV() must be called inside render pass");
         VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
 
         vkCmdDrawMeshTasksNV(m_VkCmdBuffer, TaskCount, FirstTask);
@@ -155,7 +176,7 @@ public:
     {
 #if DILIGENT_USE_VOLK
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdDrawMeshTasksNV() must be called inside render pass");
+        VERIFY(IsInsideRenderPass(), "vkCmdDrawMeshTasksNV() must be called inside render pass");
         VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
 
         vkCmdDrawMeshTasksIndirectNV(m_VkCmdBuffer, Buffer, Offset, DrawCount, Stride);
@@ -167,7 +188,7 @@ public:
     __forceinline void Dispatch(uint32_t GroupCountX, uint32_t GroupCountY, uint32_t GroupCountZ)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "vkCmdDispatch() must be called outside of render pass (27)");
+        VERIFY(!IsInsideRenderPass(), "vkCmdDispatch() must be called outside of render pass (27)");
         VERIFY(m_State.ComputePipeline != VK_NULL_HANDLE, "No compute pipeline bound");
 
         vkCmdDispatch(m_VkCmdBuffer, GroupCountX, GroupCountY, GroupCountZ);
@@ -176,7 +197,7 @@ public:
     __forceinline void DispatchIndirect(VkBuffer Buffer, VkDeviceSize Offset)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "vkCmdDispatchIndirect() must be called outside of render pass (27)");
+        VERIFY(!IsInsideRenderPass(), "vkCmdDispatchIndirect() must be called outside of render pass (27)");
         VERIFY(m_State.ComputePipeline != VK_NULL_HANDLE, "No compute pipeline bound");
 
         vkCmdDispatchIndirect(m_VkCmdBuffer, Buffer, Offset);
@@ -190,7 +211,7 @@ public:
                                        const VkClearValue* pClearValues    = nullptr)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "Current pass has not been ended");
+        VERIFY(!IsInsideRenderPass(), "Current pass has not been ended");
 
         if (m_State.RenderPass != RenderPass || m_State.Framebuffer != Framebuffer)
         {
@@ -221,11 +242,37 @@ public:
         }
     }
 
+#if DILIGENT_VK_DYNAMIC_RENDERING_SUPPORTED
+    __forceinline void BeginRendering(const VkRenderingInfoKHR& RenderingInfo)
+    {
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        VERIFY(!IsInsideRenderPass(), "Current pass has not been ended");
+
+        vkCmdBeginRenderingKHR(m_VkCmdBuffer, &RenderingInfo);
+        m_State.DynamicRendering  = true;
+        m_State.FramebufferWidth  = RenderingInfo.renderArea.extent.width;
+        m_State.FramebufferHeight = RenderingInfo.renderArea.extent.height;
+    }
+#endif
+
+    // Ends the render pass instance that was begun either by BeginRenderPass() or BeginRendering()
     __forceinline void EndRenderPass()
     {
-        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "Render pass has not been started");
+        VERIFY(IsInsideRenderPass(), "Render pass has not been started");
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        vkCmdEndRenderPass(m_VkCmdBuffer);
+        if (m_State.DynamicRendering)
+        {
+#if DILIGENT_VK_DYNAMIC_RENDERING_SUPPORTED
+            vkCmdEndRenderingKHR(m_VkCmdBuffer);
+#else
+            UNEXPECTED("Dynamic rendering is not supported");
+#endif
+        }
+        else
+        {
+            vkCmdEndRenderPass(m_VkCmdBuffer);
+        }
+        m_State.DynamicRendering  = false;
         m_State.RenderPass        = VK_NULL_HANDLE;
         m_State.Framebuffer       = VK_NULL_HANDLE;
         m_State.FramebufferWidth  = 0;
@@ -354,7 +401,7 @@ public:
                                              VkPipelineStageFlags           DestStages = 0)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (IsInsideRenderPass())
         {
             // Image layout transitions within a render pass execute
             // dependencies between attachments
@@ -363,6 +410,30 @@ public:
         TransitionImageLayout(m_VkCmdBuffer, Image, OldLayout, NewLayout, SubresRange, m_EnabledShaderStages, SrcStages, DestStages);
     }
 
+    // Makes the image the new owner of memory it shares with other aliased resources.
+    // The barrier waits for all previous writes to the memory and discards its contents.
+    static void AliasingImageBarrier(VkCommandBuffer                CmdBuffer,
+                                     VkImage                        Image,
+                                     VkImageLayout                  NewLayout,
+                                     const VkImageSubresourceRange& SubresRange,
+                                     VkPipelineStageFlags           EnabledShaderStages,
+                                     VkPipelineStageFlags           DestStages = 0);
+
+    __forceinline void AliasingImageBarrier(VkImage                        Image,
+                                            VkImageLayout                  NewLayout,
+                                            const VkImageSubresourceRange& SubresRange,
+                                            VkPipelineStageFlags           DestStages = 0)
+    {
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        if (IsInsideRenderPass())
+        {
+            // Image layout transitions within a render pass execute
+            // dependencies between attachments
+            EndRenderPass();
+        }
+        AliasingImageBarrier(m_VkCmdBuffer, Image, NewLayout, SubresRange, m_EnabledShaderStages, DestStages);
+    }
+
 
     static void BufferMemoryBarrier(VkCommandBuffer      CmdBuffer,
                                     VkBuffer             Buffer,
@@ -379,7 +450,7 @@ public:
                                            VkPipelineStageFlags DestStages = 0)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (IsInsideRenderPass())
         {
             // Image layout transitions within a render pass execute
             // dependencies between attachments
@@ -403,7 +474,7 @@ public:
                                        VkPipelineStageFlags DestStages = 0)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (IsInsideRenderPass())
         {
             // Image layout transitions within a render pass execute
             // dependencies between attachments
@@ -424,13 +495,25 @@ public:
         vkCmdBindDescriptorSets(m_VkCmdBuffer, pipelineBindPoint, layout, firstSet, descriptorSetCount, pDescriptorSets, dynamicOffsetCount, pDynamicOffsets);
     }
 
+#if DILIGENT_VK_PUSH_DESCRIPTOR_SUPPORTED
+    __forceinline void PushDescriptorSet(VkPipelineBindPoint         pipelineBindPoint,
+                                         VkPipelineLayout            layout,
+                                         uint32_t                    set,
+                                         uint32_t                    descriptorWriteCount,
+                                         const VkWriteDescriptorSet* pDescriptorWrites)
+    {
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        vkCmdPushDescriptorSetKHR(m_VkCmdBuffer, pipelineBindPoint, layout, set, descriptorWriteCount, pDescriptorWrites);
+    }
+#endif
+
     __forceinline void CopyBuffer(VkBuffer            srcBuffer,
                                   VkBuffer            dstBuffer,
                                   uint32_t            regionCount,
                                   const VkBufferCopy* pRegions)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (IsInsideRenderPass())
         {
             // Copy buffer operation must be performed outside of render pass.
             EndRenderPass();
@@ -446,7 +529,7 @@ public:
                                  const VkImageCopy* pRegions)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (IsInsideRenderPass())
         {
             // Copy operations must be performed outside of render pass.
             EndRenderPass();
@@ -462,7 +545,7 @@ public:
                                          const VkBufferImageCopy* pRegions)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (IsInsideRenderPass())
         {
             // Copy operations must be performed outside of render pass.
             EndRenderPass();
@@ -478,7 +561,7 @@ public:
                                          const VkBufferImageCopy* pRegions)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (IsInsideRenderPass())
         {
             // Copy operations must be performed outside of render pass.
             EndRenderPass();
@@ -496,7 +579,7 @@ public:
                                  VkFilter           filter)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (IsInsideRenderPass())
         {
             // Blit must be performed outside of render pass.
             EndRenderPass();
@@ -513,7 +596,7 @@ public:
                                     const VkImageResolve* pRegions)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (IsInsideRenderPass())
         {
             // Resolve must be performed outside of render pass.
             EndRenderPass();
@@ -542,7 +625,7 @@ public:
 
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
         vkCmdBeginQuery(m_VkCmdBuffer, queryPool, query, flags);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (IsInsideRenderPass())
             m_State.InsidePassQueries |= queryFlag;
         else
             m_State.OutsidePassQueries |= queryFlag;
@@ -554,7 +637,7 @@ public:
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
         vkCmdEndQuery(m_VkCmdBuffer, queryPool, query);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (IsInsideRenderPass())
         {
             VERIFY((m_State.InsidePassQueries & queryFlag) != 0, "No active inside-pass queries found.");
             m_State.InsidePassQueries &= ~queryFlag;
@@ -579,7 +662,7 @@ public:
                                       uint32_t    queryCount)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (IsInsideRenderPass())
         {
             // Query pool reset must be performed outside of render pass (17.2).
             EndRenderPass();
@@ -596,7 +679,7 @@ public:
                                             VkQueryResultFlags flags)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (IsInsideRenderPass())
         {
             // Copy query results must be performed outside of render pass (17.2).
             EndRenderPass();
@@ -611,7 +694,7 @@ public:
     {
 #if DILIGENT_USE_VOLK
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (IsInsideRenderPass())
         {
             // Build AS operations must be performed outside of render pass.
             EndRenderPass();
@@ -626,7 +709,7 @@ public:
     {
 #if DILIGENT_USE_VOLK
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (IsInsideRenderPass())
         {
             // Copy AS operations must be performed outside of render pass.
             EndRenderPass();
@@ -641,7 +724,7 @@ public:
     {
 #if DILIGENT_USE_VOLK
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (IsInsideRenderPass())
         {
             // Write AS properties operations must be performed outside of render pass.
             EndRenderPass();
@@ -694,10 +777,15 @@ public:
         uint32_t      FramebufferHeight  = 0;
         uint32_t      InsidePassQueries  = 0;
         uint32_t      OutsidePassQueries = 0;
+        bool          DynamicRendering   = false; // Whether dynamic rendering (VK_KHR_dynamic_rendering) is active
     };
 
     const StateCache& GetState() const { return m_State; }
 
+    // Returns true if a render pass instance is active, which is either a render pass
+    // begun by vkCmdBeginRenderPass or dynamic rendering begun by vkCmdBeginRenderingKHR.
+    bool IsInsideRenderPass() const { return m_State.RenderPass != VK_NULL_HANDLE || m_State.DynamicRendering; }
+
 private:
     StateCache                 m_State;
     VkCommandBuffer            m_VkCmdBuffer = VK_NULL_HANDLE;
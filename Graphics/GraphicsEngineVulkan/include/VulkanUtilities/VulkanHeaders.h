@@ -39,6 +39,43 @@
 #    include "volk/volk.h"
 #endif
 
+// VK_KHR_dynamic_rendering (core in Vulkan 1.3) requires recent Vulkan headers, and its commands
+// can only be used when they are loaded through volk.
+#if DILIGENT_USE_VOLK && defined(VK_KHR_dynamic_rendering)
+#    define DILIGENT_VK_DYNAMIC_RENDERING_SUPPORTED 1
+#else
+#    define DILIGENT_VK_DYNAMIC_RENDERING_SUPPORTED 0
+#endif
+
+// vkCmdPushDescriptorSetKHR (VK_KHR_push_descriptor) is an extension command that is only available through volk.
+#if DILIGENT_USE_VOLK && defined(VK_KHR_push_descriptor)
+#    define DILIGENT_VK_PUSH_DESCRIPTOR_SUPPORTED 1
+#else
+#    define DILIGENT_VK_PUSH_DESCRIPTOR_SUPPORTED 0
+#endif
+
+// vkCmdDraw*IndirectCountKHR (VK_KHR_draw_indirect_count) are extension commands that are only available through volk.
+#if DILIGENT_USE_VOLK && defined(VK_KHR_draw_indirect_count)
+#    define DILIGENT_VK_DRAW_INDIRECT_COUNT_SUPPORTED 1
+#else
+#    define DILIGENT_VK_DRAW_INDIRECT_COUNT_SUPPORTED 0
+#endif
+
+// VK_EXT_memory_budget is queried with vkGetPhysicalDeviceMemoryProperties2KHR that is only available through volk.
+#if DILIGENT_USE_VOLK && defined(VK_EXT_memory_budget)
+#    define DILIGENT_VK_MEMORY_BUDGET_SUPPORTED 1
+#else
+#    define DILIGENT_VK_MEMORY_BUDGET_SUPPORTED 0
+#endif
+
+// VK_KHR_timeline_semaphore (core in Vulkan 1.2) only adds structures that are passed to vkCreateSemaphore
+// and vkQueueSubmit. Note that the feature is queried with vkGetPhysicalDeviceFeatures2KHR that requires volk.
+#if defined(VK_KHR_timeline_semaphore)
+#    define DILIGENT_VK_TIMELINE_SEMAPHORE_SUPPORTED 1
+#else
+#    define DILIGENT_VK_TIMELINE_SEMAPHORE_SUPPORTED 0
+#endif
+
 #if defined(VK_USE_PLATFORM_XLIB_KHR) || defined(_X11_XLIB_H_)
 
 // Undef symbols defined by XLib
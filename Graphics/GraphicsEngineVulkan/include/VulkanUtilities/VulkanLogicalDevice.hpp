@@ -220,6 +220,10 @@ public:
 
     VkResult GetRayTracingShaderGroupHandles(VkPipeline pipeline, uint32_t firstGroup, uint32_t groupCount, size_t dataSize, void* pData) const;
 
+#if DILIGENT_VK_TIMELINE_SEMAPHORE_SUPPORTED
+    VkResult SignalSemaphore(const VkSemaphoreSignalInfoKHR& SignalInfo) const;
+#endif
+
     VkPipelineStageFlags GetEnabledShaderStages() const { return m_EnabledShaderStages; }
 
     const VkPhysicalDeviceFeatures& GetEnabledFeatures() const { return m_EnabledFeatures; }
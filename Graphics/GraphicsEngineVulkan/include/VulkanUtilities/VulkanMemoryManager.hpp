@@ -29,6 +29,7 @@
 
 #include <mutex>
 #include <array>
+#include <vector>
 #include <unordered_map>
 #include <atomic>
 #include <string>
@@ -53,31 +54,36 @@ struct VulkanMemoryAllocation
     VulkanMemoryAllocation            (const VulkanMemoryAllocation&) = delete;
     VulkanMemoryAllocation& operator= (const VulkanMemoryAllocation&) = delete;
 
-	VulkanMemoryAllocation(VulkanMemoryPage* _Page, VkDeviceSize _UnalignedOffset, VkDeviceSize _Size)noexcept : 
-        Page           {_Page           }, 
-        UnalignedOffset{_UnalignedOffset}, 
-        Size           {_Size           }
+	VulkanMemoryAllocation(VulkanMemoryPage* _Page, VkDeviceSize _UnalignedOffset, VkDeviceSize _Size, uint32_t _TransientRangeId = 0)noexcept : 
+        Page            {_Page            }, 
+        UnalignedOffset {_UnalignedOffset }, 
+        Size            {_Size            },
+        TransientRangeId{_TransientRangeId}
     {}
     
     VulkanMemoryAllocation(VulkanMemoryAllocation&& rhs)noexcept :
-        Page           {rhs.Page           },
-        UnalignedOffset{rhs.UnalignedOffset},
-        Size           {rhs.Size           }
+        Page            {rhs.Page            },
+        UnalignedOffset {rhs.UnalignedOffset },
+        Size            {rhs.Size            },
+        TransientRangeId{rhs.TransientRangeId}
     {
-        rhs.Page            = nullptr;
-        rhs.UnalignedOffset = 0;
-        rhs.Size            = 0;
+        rhs.Page             = nullptr;
+        rhs.UnalignedOffset  = 0;
+        rhs.Size             = 0;
+        rhs.TransientRangeId = 0;
     }
 
     VulkanMemoryAllocation& operator= (VulkanMemoryAllocation&& rhs)noexcept
     {
-        Page            = rhs.Page;
-        UnalignedOffset = rhs.UnalignedOffset;
-        Size            = rhs.Size;
+        Page             = rhs.Page;
+        UnalignedOffset  = rhs.UnalignedOffset;
+        Size             = rhs.Size;
+        TransientRangeId = rhs.TransientRangeId;
 
-        rhs.Page            = nullptr;
-        rhs.UnalignedOffset = 0;
-        rhs.Size            = 0;
+        rhs.Page             = nullptr;
+        rhs.UnalignedOffset  = 0;
+        rhs.Size             = 0;
+        rhs.TransientRangeId = 0;
 
         return *this;
     }
@@ -87,9 +93,10 @@ struct VulkanMemoryAllocation
     // The allocation must not be in use by the GPU.
     ~VulkanMemoryAllocation();
 
-    VulkanMemoryPage* Page            = nullptr; // Memory page that contains this allocation
-    VkDeviceSize      UnalignedOffset = 0;       // Unaligned offset from the start of the memory
-    VkDeviceSize      Size            = 0;       // Reserved size of this allocation
+    VulkanMemoryPage* Page             = nullptr; // Memory page that contains this allocation
+    VkDeviceSize      UnalignedOffset  = 0;       // Unaligned offset from the start of the memory
+    VkDeviceSize      Size             = 0;       // Reserved size of this allocation
+    uint32_t          TransientRangeId = 0;       // Range id in a transient page, or 0
 };
 
 class VulkanMemoryPage
@@ -99,15 +106,21 @@ public:
                      VkDeviceSize          PageSize,
                      uint32_t              MemoryTypeIndex,
                      bool                  IsHostVisible,
-                     VkMemoryAllocateFlags AllocateFlags) noexcept;
+                     VkMemoryAllocateFlags AllocateFlags,
+                     bool                  IsTransient = false) noexcept;
     ~VulkanMemoryPage();
 
     // clang-format off
     VulkanMemoryPage(VulkanMemoryPage&& rhs)noexcept :
-        m_ParentMemoryMgr {rhs.m_ParentMemoryMgr         },
-        m_AllocationMgr   {std::move(rhs.m_AllocationMgr)},
-        m_VkMemory        {std::move(rhs.m_VkMemory)     },
-        m_CPUMemory       {rhs.m_CPUMemory               }
+        m_ParentMemoryMgr       {rhs.m_ParentMemoryMgr            },
+        m_AllocationMgr         {std::move(rhs.m_AllocationMgr)   },
+        m_VkMemory              {std::move(rhs.m_VkMemory)        },
+        m_CPUMemory             {rhs.m_CPUMemory                  },
+        m_MemoryTypeIndex       {rhs.m_MemoryTypeIndex            },
+        m_IsTransient           {rhs.m_IsTransient                },
+        m_TransientRanges       {std::move(rhs.m_TransientRanges) },
+        m_NextTransientRangeId  {rhs.m_NextTransientRangeId       },
+        m_TransientAcquireCount {rhs.m_TransientAcquireCount      }
     {
         rhs.m_CPUMemory = nullptr;
     }
@@ -116,8 +129,10 @@ public:
     VulkanMemoryPage& operator= (VulkanMemoryPage&)       = delete;
     VulkanMemoryPage& operator= (VulkanMemoryPage&& rhs)  = delete;
     
-    bool IsEmpty() const { return m_AllocationMgr.IsEmpty(); }
+    bool IsEmpty() const { return m_IsTransient ? m_TransientRanges.empty() : m_AllocationMgr.IsEmpty(); }
     bool IsFull()  const { return m_AllocationMgr.IsFull();  }
+    bool IsTransient() const { return m_IsTransient; }
+    uint32_t GetMemoryTypeIndex() const { return m_MemoryTypeIndex; }
     VkDeviceSize GetPageSize() const { return m_AllocationMgr.GetMaxSize();  }
     VkDeviceSize GetUsedSize() const { return m_AllocationMgr.GetUsedSize(); }
 
@@ -125,6 +140,17 @@ public:
 
     VulkanMemoryAllocation Allocate(VkDeviceSize size, VkDeviceSize alignment);
 
+    // Allocates a range in a transient page. The range may overlap ranges of other allocations
+    // whose usage intervals [FirstUse, LastUse] do not intersect the requested interval.
+    VulkanMemoryAllocation AllocateTransient(VkDeviceSize size, VkDeviceSize alignment, uint32_t FirstUse, uint32_t LastUse);
+
+    // Makes the transient range the current owner of its memory.
+    void AcquireTransientRange(uint32_t RangeId);
+
+    // Returns true if memory of the transient range has been acquired by an overlapping
+    // range since the range was last acquired.
+    bool IsTransientRangeOverwritten(uint32_t RangeId);
+
     VkDeviceMemory GetVkMemory() const { return m_VkMemory; }
     void*          GetCPUMemory() const { return m_CPUMemory; }
 
@@ -141,6 +167,22 @@ private:
     Diligent::VariableSizeAllocationsManager m_AllocationMgr;
     VulkanUtilities::DeviceMemoryWrapper     m_VkMemory;
     void*                                    m_CPUMemory = nullptr;
+    uint32_t                                 m_MemoryTypeIndex;
+
+    struct TransientRange
+    {
+        uint32_t     Id;
+        VkDeviceSize Offset;
+        VkDeviceSize Size;
+        uint32_t     FirstUse;
+        uint32_t     LastUse;
+        // Value of m_TransientAcquireCount when the range was last acquired, or 0
+        uint64_t AcquireIndex;
+    };
+    bool                        m_IsTransient = false;
+    std::vector<TransientRange> m_TransientRanges;
+    uint32_t                    m_NextTransientRangeId  = 1;
+    uint64_t                    m_TransientAcquireCount = 0;
 };
 
 class VulkanMemoryManager
@@ -175,6 +217,7 @@ public:
         m_PhysicalDevice  {rhs.m_PhysicalDevice    },
         m_Allocator       {rhs.m_Allocator         },
         m_Pages           {std::move(rhs.m_Pages)  },
+        m_TransientPages  {std::move(rhs.m_TransientPages)},
     
         m_DeviceLocalPageSize    {rhs.m_DeviceLocalPageSize   },
         m_HostVisiblePageSize    {rhs.m_HostVisiblePageSize   },
@@ -184,7 +227,8 @@ public:
         //m_CurrUsedSize      {rhs.m_CurrUsedSize},
         m_PeakUsedSize      {rhs.m_PeakUsedSize     },
         m_CurrAllocatedSize {rhs.m_CurrAllocatedSize},
-        m_PeakAllocatedSize {rhs.m_PeakAllocatedSize}
+        m_PeakAllocatedSize {rhs.m_PeakAllocatedSize},
+        m_HeapAllocatedSize {rhs.m_HeapAllocatedSize}
     {
         // clang-format on
         for (size_t i = 0; i < m_CurrUsedSize.size(); ++i)
@@ -201,7 +245,15 @@ public:
 
     VulkanMemoryAllocation Allocate(VkDeviceSize Size, VkDeviceSize Alignment, uint32_t MemoryTypeIndex, bool HostVisible, VkMemoryAllocateFlags AllocateFlags);
     VulkanMemoryAllocation Allocate(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProps, VkMemoryAllocateFlags AllocateFlags);
-    void                   ShrinkMemory();
+
+    // Allocates memory for a transient resource that is only used in the interval [FirstUse, LastUse]
+    // of every frame. Transient resources whose intervals do not overlap may share memory.
+    VulkanMemoryAllocation AllocateTransient(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProps, uint32_t FirstUse, uint32_t LastUse);
+
+    void ShrinkMemory();
+
+    // Returns the total size of the pages allocated from the given memory heap
+    VkDeviceSize GetHeapAllocatedSize(uint32_t HeapIndex);
 
 protected:
     friend class VulkanMemoryPage;
@@ -250,12 +302,16 @@ protected:
     };
     std::unordered_multimap<MemoryPageIndex, VulkanMemoryPage, MemoryPageIndex::Hasher> m_Pages;
 
+    // Pages for transient resources, indexed by memory type index. Protected by m_PagesMtx.
+    std::unordered_multimap<uint32_t, VulkanMemoryPage> m_TransientPages;
+
     const VkDeviceSize m_DeviceLocalPageSize;
     const VkDeviceSize m_HostVisiblePageSize;
     const VkDeviceSize m_DeviceLocalReserveSize;
     const VkDeviceSize m_HostVisibleReserveSize;
 
     void OnFreeAllocation(VkDeviceSize Size, bool IsHostVisble);
+    void UpdateHeapAllocatedSize(const VulkanMemoryPage& Page, bool IsCreated);
 
     // 0 == Device local, 1 == Host-visible
     std::array<std::atomic_int64_t, 2> m_CurrUsedSize      = {};
@@ -263,6 +319,9 @@ protected:
     std::array<VkDeviceSize, 2>        m_CurrAllocatedSize = {};
     std::array<VkDeviceSize, 2>        m_PeakAllocatedSize = {};
 
+    // Size of the pages allocated from every memory heap. Protected by m_PagesMtx.
+    std::array<VkDeviceSize, VK_MAX_MEMORY_HEAPS> m_HeapAllocatedSize = {};
+
     // If adding new member, do not forget to update move ctor
 };
 
@@ -49,6 +49,21 @@ public:
         bool                                             Spirv15             = false; // DXC shaders with ray tracing requires Vulkan 1.2 with SPIRV 1.5
         VkPhysicalDeviceBufferDeviceAddressFeaturesKHR   BufferDeviceAddress = {};
         VkPhysicalDeviceDescriptorIndexingFeaturesEXT    DescriptorIndexing  = {};
+#if DILIGENT_VK_DYNAMIC_RENDERING_SUPPORTED
+        VkPhysicalDeviceDynamicRenderingFeaturesKHR DynamicRendering = {};
+#endif
+#if DILIGENT_VK_PUSH_DESCRIPTOR_SUPPORTED
+        bool PushDescriptor = false; // VK_KHR_push_descriptor has no feature struct
+#endif
+#if DILIGENT_VK_DRAW_INDIRECT_COUNT_SUPPORTED
+        bool DrawIndirectCount = false; // VK_KHR_draw_indirect_count has no feature struct
+#endif
+#if DILIGENT_VK_MEMORY_BUDGET_SUPPORTED
+        bool MemoryBudget = false; // VK_EXT_memory_budget has no feature struct
+#endif
+#if DILIGENT_VK_TIMELINE_SEMAPHORE_SUPPORTED
+        VkPhysicalDeviceTimelineSemaphoreFeaturesKHR TimelineSemaphore = {};
+#endif
     };
 
     struct ExtensionProperties
@@ -57,6 +72,9 @@ public:
         VkPhysicalDeviceAccelerationStructurePropertiesKHR AccelStruct        = {};
         VkPhysicalDeviceRayTracingPipelinePropertiesKHR    RayTracingPipeline = {};
         VkPhysicalDeviceDescriptorIndexingPropertiesEXT    DescriptorIndexing = {};
+#if DILIGENT_VK_PUSH_DESCRIPTOR_SUPPORTED
+        VkPhysicalDevicePushDescriptorPropertiesKHR PushDescriptor = {};
+#endif
     };
 
 public:
@@ -72,12 +90,15 @@ public:
 
     // clang-format off
     uint32_t         FindQueueFamily     (VkQueueFlags QueueFlags)                           const;
+    uint32_t         FindDedicatedTransferQueueFamily()                                      const;
+    uint32_t         FindDedicatedComputeQueueFamily ()                                      const;
     VkPhysicalDevice GetVkDeviceHandle   ()                                                  const { return m_VkDevice; }
     bool             IsExtensionSupported(const char* ExtensionName)                         const;
     bool             CheckPresentSupport (uint32_t queueFamilyIndex, VkSurfaceKHR VkSurface) const;
     // clang-format on
 
-    static constexpr uint32_t InvalidMemoryTypeIndex = ~uint32_t{0};
+    static constexpr uint32_t InvalidMemoryTypeIndex  = ~uint32_t{0};
+    static constexpr uint32_t InvalidQueueFamilyIndex = ~uint32_t{0};
 
     uint32_t GetMemoryTypeIndex(uint32_t typeBits, VkMemoryPropertyFlags properties) const;
 
@@ -86,8 +107,17 @@ public:
     const ExtensionFeatures&                GetExtFeatures() const { return m_ExtFeatures; }
     const ExtensionProperties&              GetExtProperties() const { return m_ExtProperties; }
     const VkPhysicalDeviceMemoryProperties& GetMemoryProperties() const { return m_MemoryProperties; }
+    const VkQueueFamilyProperties&          GetQueueFamilyProperties(uint32_t FamilyIndex) const { return m_QueueFamilyProperties[FamilyIndex]; }
     VkFormatProperties                      GetPhysicalDeviceFormatProperties(VkFormat imageFormat) const;
 
+    // Queries the current budget and usage of every memory heap (VK_EXT_memory_budget).
+    // Returns false if the extension is not supported.
+    bool GetMemoryBudget(VkDeviceSize HeapBudget[VK_MAX_MEMORY_HEAPS], VkDeviceSize HeapUsage[VK_MAX_MEMORY_HEAPS]) const;
+
+    // Returns true if the descriptor indexing features include everything that is required for
+    // runtime-sized resource arrays with update-after-bind and partially bound descriptors.
+    static bool SupportsUpdateAfterBindArrays(const VkPhysicalDeviceDescriptorIndexingFeaturesEXT& Features);
+
 private:
     VulkanPhysicalDevice(VkPhysicalDevice      vkDevice,
                          const VulkanInstance& Instance);
@@ -31,6 +31,7 @@
 /// Definition of the Diligent::IRenderDeviceVk interface
 
 #include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
 
 DILIGENT_BEGIN_NAMESPACE(Diligent)
 
@@ -41,6 +42,37 @@ static const INTERFACE_ID IID_RenderDeviceVk =
 #define DILIGENT_INTERFACE_NAME IRenderDeviceVk
 #include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
 
+/// Budget and usage of a Vulkan memory heap
+struct MemoryHeapBudgetVk
+{
+    /// Estimated amount of heap memory the process can allocate without a performance penalty.
+    /// When VK_EXT_memory_budget is not supported, this is the heap size.
+    Uint64 Budget DEFAULT_INITIALIZER(0);
+
+    /// Estimated heap memory used by the process, including memory allocated outside of the engine.
+    /// When VK_EXT_memory_budget is not supported, this is the size of the memory allocated by the engine.
+    Uint64 Usage DEFAULT_INITIALIZER(0);
+
+    /// Size of the memory pages allocated from the heap by the engine.
+    Uint64 EngineAllocatedSize DEFAULT_INITIALIZER(0);
+
+    /// Whether the heap is device-local.
+    Bool IsDeviceLocal DEFAULT_INITIALIZER(False);
+};
+typedef struct MemoryHeapBudgetVk MemoryHeapBudgetVk;
+
+/// Type of the memory budget callback function
+
+/// \param [in] HeapIndex     - Index of the memory heap.
+/// \param [in] Budget        - Current budget and usage of the heap.
+/// \param [in] OverThreshold - True if the usage has risen above the callback threshold,
+///                             and false if it has dropped back below the threshold.
+/// \param [in] pUserData     - User data provided to IRenderDeviceVk::AddMemoryBudgetCallback().
+typedef void (*MemoryBudgetCallbackType)(Uint32                       HeapIndex,
+                                         const MemoryHeapBudgetVk REF Budget,
+                                         Bool                         OverThreshold,
+                                         void*                        pUserData);
+
 #define IRenderDeviceVkInclusiveMethods \
     IRenderDeviceInclusiveMethods;      \
     IRenderDeviceVkMethods RenderDeviceVk
@@ -150,6 +182,113 @@ DILIGENT_BEGIN_INTERFACE(IRenderDeviceVk, IRenderDevice)
                                                       const TopLevelASDesc REF   Desc,
                                                       RESOURCE_STATE             InitialState,
                                                       ITopLevelAS**              ppTLAS) PURE;
+
+    /// Creates a shader object from SPIRV byte code and serialized shader resources
+
+    /// \param [in]  ShaderCI                - Shader create info. The byte code must be provided
+    ///                                       through the ByteCode and ByteCodeSize members.
+    /// \param [in]  pSerializedResources    - Pointer to the shader resources serialized by the offline
+    ///                                       shader packer (see ShaderArchive.hpp). When not null,
+    ///                                       the engine does not reflect the SPIRV byte code.
+    /// \param [in]  SerializedResourcesSize - Size of the serialized resources data, in bytes.
+    /// \param [out] ppShader                - Address of the memory location where the pointer to the
+    ///                                       shader interface will be stored.
+    ///                                       The function calls AddRef(), so that the new object will contain
+    ///                                       one reference.
+    VIRTUAL void METHOD(CreateShaderFromSPIRV)(THIS_
+                                               const ShaderCreateInfo REF ShaderCI,
+                                               const void*                pSerializedResources,
+                                               size_t                     SerializedResourcesSize,
+                                               IShader**                  ppShader) PURE;
+
+    /// Creates a transient texture that may share memory with other transient textures
+
+    /// \param [in]  TexDesc  - Texture description. MISC_TEXTURE_FLAG_TRANSIENT flag is set automatically.
+    ///                         Only USAGE_DEFAULT textures may be transient.
+    /// \param [in]  FirstUse - First position in the frame where the texture is used, e.g. the index
+    ///                         of the first render pass that accesses the texture.
+    /// \param [in]  LastUse  - Last position in the frame where the texture is used.
+    /// \param [out] ppTexture - Address of the memory location where the pointer to the
+    ///                         texture interface will be stored.
+    ///                         The function calls AddRef(), so that the new object will contain
+    ///                         one reference.
+    ///
+    /// \remarks  Transient textures whose usage intervals [FirstUse, LastUse] do not overlap may be
+    ///           placed in the same memory. The intervals are the same in every frame, and the textures
+    ///           must be used in the order of their intervals on the same immediate context.
+    ///           Contents of a transient texture are undefined every time it is first accessed in
+    ///           its interval; the engine issues an aliasing barrier when the texture is transitioned
+    ///           out of RESOURCE_STATE_UNDEFINED or when its memory has been used by another
+    ///           texture. This requires RESOURCE_STATE_TRANSITION_MODE_TRANSITION or an explicit
+    ///           state transition before each interval.
+    ///
+    ///           Render targets, depth buffers and input attachments that have no other bind flags
+    ///           use lazily allocated memory when the device supports it. Such textures can only be
+    ///           accessed as attachments, e.g. they can't be cleared outside of a render pass.
+    ///
+    ///           A texture created with MISC_TEXTURE_FLAG_TRANSIENT flag through IRenderDevice::CreateTexture()
+    ///           uses the interval [0, 0xFFFFFFFF] and never shares memory with other textures.
+    VIRTUAL void METHOD(CreateTransientTexture)(THIS_
+                                                const TextureDesc REF TexDesc,
+                                                Uint32                FirstUse,
+                                                Uint32                LastUse,
+                                                ITexture**            ppTexture) PURE;
+
+    /// Returns the number of Vulkan memory heaps
+    VIRTUAL Uint32 METHOD(GetMemoryHeapCount)(THIS) CONST PURE;
+
+    /// Returns the current budget and usage of the memory heap
+
+    /// \remarks The budget is queried from VK_EXT_memory_budget when the device supports it.
+    ///          The values reported by the driver are only updated when the application
+    ///          submits commands, allocates or frees memory.
+    VIRTUAL MemoryHeapBudgetVk METHOD(GetMemoryHeapBudget)(THIS_
+                                                           Uint32 HeapIndex) PURE;
+
+    /// Adds a callback that is called when memory usage of a heap crosses the threshold
+
+    /// \param [in] Threshold - Fraction of the heap budget, e.g. 0.9.
+    /// \param [in] Callback  - Callback function.
+    /// \param [in] pUserData - User data passed to the callback.
+    ///
+    /// \return     Callback identifier that can be passed to RemoveMemoryBudgetCallback().
+    ///
+    /// \remarks    Memory usage is checked when an immediate context finishes the frame.
+    ///             The callback is called once when the usage rises above the threshold,
+    ///             and once when it drops back below, in the thread that finishes the frame.
+    ///             The callback may release device objects.
+    VIRTUAL Uint32 METHOD(AddMemoryBudgetCallback)(THIS_
+                                                   Float32                  Threshold,
+                                                   MemoryBudgetCallbackType Callback,
+                                                   void*                    pUserData) PURE;
+
+    /// Removes the memory budget callback
+    VIRTUAL void METHOD(RemoveMemoryBudgetCallback)(THIS_
+                                                    Uint32 CallbackId) PURE;
+
+    /// Copies data from staging textures on the dedicated transfer queue
+
+    /// \param [in] pImmediateContext - Immediate device context. The context is flushed before the copies
+    ///                                 are submitted.
+    /// \param [in] pCopyAttribs      - Array of copy attributes. Source textures must be staging textures created
+    ///                                 with CPU_ACCESS_WRITE flag, destination textures must not be staging textures.
+    ///                                 Only whole mip levels can be copied.
+    /// \param [in] NumCopies         - The number of elements in pCopyAttribs array.
+    ///
+    /// \return     true if the copies have been submitted to the transfer queue, and false otherwise.
+    ///             If the device has no transfer queue, or any of the copies can't be executed on it,
+    ///             no commands are submitted and the application should copy the textures through
+    ///             the device context.
+    ///
+    /// \remarks    The ownership of every destination texture is transferred from the graphics queue to the
+    ///             transfer queue and back. The graphics queue waits for the copies before executing the
+    ///             next command buffer submitted by the immediate context, where the textures are in
+    ///             RESOURCE_STATE_COPY_DEST state.
+    ///             Staging textures that are copied on the transfer queue must not be used by the device contexts.
+    VIRTUAL Bool METHOD(CopyTexturesOnTransferQueue)(THIS_
+                                                     IDeviceContext*           pImmediateContext,
+                                                     const CopyTextureAttribs* pCopyAttribs,
+                                                     Uint32                    NumCopies) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -169,6 +308,13 @@ DILIGENT_END_INTERFACE
 #    define IRenderDeviceVk_CreateBufferFromVulkanResource(This, ...) CALL_IFACE_METHOD(RenderDeviceVk, CreateBufferFromVulkanResource, This, __VA_ARGS__)
 #    define IRenderDeviceVk_CreateBLASFromVulkanResource(This, ...)   CALL_IFACE_METHOD(RenderDeviceVk, CreateBLASFromVulkanResource,   This, __VA_ARGS__)
 #    define IRenderDeviceVk_CreateTLASFromVulkanResource(This, ...)   CALL_IFACE_METHOD(RenderDeviceVk, CreateTLASFromVulkanResource,   This, __VA_ARGS__)
+#    define IRenderDeviceVk_CreateShaderFromSPIRV(This, ...)          CALL_IFACE_METHOD(RenderDeviceVk, CreateShaderFromSPIRV,          This, __VA_ARGS__)
+#    define IRenderDeviceVk_CreateTransientTexture(This, ...)         CALL_IFACE_METHOD(RenderDeviceVk, CreateTransientTexture,         This, __VA_ARGS__)
+#    define IRenderDeviceVk_GetMemoryHeapCount(This)                  CALL_IFACE_METHOD(RenderDeviceVk, GetMemoryHeapCount,             This)
+#    define IRenderDeviceVk_GetMemoryHeapBudget(This, ...)            CALL_IFACE_METHOD(RenderDeviceVk, GetMemoryHeapBudget,            This, __VA_ARGS__)
+#    define IRenderDeviceVk_AddMemoryBudgetCallback(This, ...)        CALL_IFACE_METHOD(RenderDeviceVk, AddMemoryBudgetCallback,        This, __VA_ARGS__)
+#    define IRenderDeviceVk_RemoveMemoryBudgetCallback(This, ...)     CALL_IFACE_METHOD(RenderDeviceVk, RemoveMemoryBudgetCallback,     This, __VA_ARGS__)
+#    define IRenderDeviceVk_CopyTexturesOnTransferQueue(This, ...)    CALL_IFACE_METHOD(RenderDeviceVk, CopyTexturesOnTransferQueue,    This, __VA_ARGS__)
 
 // clang-format on
 
@@ -0,0 +1,253 @@
+"// Single-pass mip chain downsampler.\n"
+"//\n"
+"// Every work group reduces a 64x64 tile of the source mip level to a single texel of OutMip5,\n"
+"// writing the intermediate levels OutMip0 - OutMip4 along the way. The last work group to finish\n"
+"// (determined through a global atomic counter) then reduces OutMip5 down to OutMip11.\n"
+"// All arithmetic is performed in linear space; sRGB encoding is only applied when a value\n"
+"// is written to or read back from a storage image.\n"
+"\n"
+"#ifndef CONVERT_TO_SRGB\n"
+"#define CONVERT_TO_SRGB 0\n"
+"#endif\n"
+"\n"
+"#ifndef IMG_FORMAT\n"
+"#define IMG_FORMAT rgba8\n"
+"#endif\n"
+"\n"
+"layout(IMG_FORMAT) uniform writeonly image2DArray OutMip0;\n"
+"layout(IMG_FORMAT) uniform writeonly image2DArray OutMip1;\n"
+"layout(IMG_FORMAT) uniform writeonly image2DArray OutMip2;\n"
+"layout(IMG_FORMAT) uniform writeonly image2DArray OutMip3;\n"
+"layout(IMG_FORMAT) uniform writeonly image2DArray OutMip4;\n"
+"// OutMip5 is written by all work groups and read back by the last one\n"
+"layout(IMG_FORMAT) uniform coherent   image2DArray OutMip5;\n"
+"layout(IMG_FORMAT) uniform writeonly image2DArray OutMip6;\n"
+"layout(IMG_FORMAT) uniform writeonly image2DArray OutMip7;\n"
+"layout(IMG_FORMAT) uniform writeonly image2DArray OutMip8;\n"
+"layout(IMG_FORMAT) uniform writeonly image2DArray OutMip9;\n"
+"layout(IMG_FORMAT) uniform writeonly image2DArray OutMip10;\n"
+"layout(IMG_FORMAT) uniform writeonly image2DArray OutMip11;\n"
+"\n"
+"uniform sampler2DArray SrcMip;\n"
+"\n"
+"uniform CB\n"
+"{\n"
+"    ivec2 SrcMipSize;     // Dimensions of the source mip level\n"
+"    int   NumMipLevels;   // Number of OutMips to write: [1, 12]\n"
+"    uint  NumWorkGroups;  // Number of work groups per array slice\n"
+"    vec2  InvSrcMipSize;  // 1.0 / SrcMipSize\n"
+"};\n"
+"\n"
+"// One counter per array slice. The last work group resets its counter\n"
+"// back to zero, so the buffer never needs to be cleared between dispatches.\n"
+"layout(std430) coherent buffer SPDCounter\n"
+"{\n"
+"    uint Counter[];\n"
+"};\n"
+"\n"
+"shared float gs_R[256];\n"
+"shared float gs_G[256];\n"
+"shared float gs_B[256];\n"
+"shared float gs_A[256];\n"
+"shared bool  gs_IsLastGroup;\n"
+"\n"
+"void StoreColor(uint Index, vec4 Color)\n"
+"{\n"
+"    gs_R[Index] = Color.r;\n"
+"    gs_G[Index] = Color.g;\n"
+"    gs_B[Index] = Color.b;\n"
+"    gs_A[Index] = Color.a;\n"
+"}\n"
+"\n"
+"vec4 LoadColor(uint Index)\n"
+"{\n"
+"    return vec4(gs_R[Index], gs_G[Index], gs_B[Index], gs_A[Index]);\n"
+"}\n"
+"\n"
+"float LinearToSRGB(float x)\n"
+"{\n"
+"    return x <= 0.0031308 ? 12.92 * x : 1.055 * pow(x, 1.0 / 2.4) - 0.055;\n"
+"}\n"
+"\n"
+"float SRGBToLinear(float x)\n"
+"{\n"
+"    return x <= 0.04045 ? x / 12.92 : pow((x + 0.055) / 1.055, 2.4);\n"
+"}\n"
+"\n"
+"vec4 PackColor(vec4 Linear)\n"
+"{\n"
+"#if CONVERT_TO_SRGB\n"
+"    return vec4(LinearToSRGB(Linear.r), LinearToSRGB(Linear.g), LinearToSRGB(Linear.b), Linear.a);\n"
+"#else\n"
+"    return Linear;\n"
+"#endif\n"
+"}\n"
+"\n"
+"vec4 UnpackColor(vec4 Color)\n"
+"{\n"
+"#if CONVERT_TO_SRGB\n"
+"    return vec4(SRGBToLinear(Color.r), SRGBToLinear(Color.g), SRGBToLinear(Color.b), Color.a);\n"
+"#else\n"
+"    return Color;\n"
+"#endif\n"
+"}\n"
+"\n"
+"ivec2 GetOutMipSize(int Level)\n"
+"{\n"
+"    return max(SrcMipSize >> (Level + 1), ivec2(1, 1));\n"
+"}\n"
+"\n"
+"void WriteOutMip(int Level, ivec2 Coord, int ArraySlice, vec4 Linear)\n"
+"{\n"
+"    if (Level >= NumMipLevels || any(greaterThanEqual(Coord, GetOutMipSize(Level))))\n"
+"        return;\n"
+"\n"
+"    ivec3 Location = ivec3(Coord, ArraySlice);\n"
+"    vec4  Color    = PackColor(Linear);\n"
+"    switch (Level)\n"
+"    {\n"
+"        case 0:  imageStore(OutMip0,  Location, Color); break;\n"
+"        case 1:  imageStore(OutMip1,  Location, Color); break;\n"
+"        case 2:  imageStore(OutMip2,  Location, Color); break;\n"
+"        case 3:  imageStore(OutMip3,  Location, Color); break;\n"
+"        case 4:  imageStore(OutMip4,  Location, Color); break;\n"
+"        case 5:  imageStore(OutMip5,  Location, Color); break;\n"
+"        case 6:  imageStore(OutMip6,  Location, Color); break;\n"
+"        case 7:  imageStore(OutMip7,  Location, Color); break;\n"
+"        case 8:  imageStore(OutMip8,  Location, Color); break;\n"
+"        case 9:  imageStore(OutMip9,  Location, Color); break;\n"
+"        case 10: imageStore(OutMip10, Location, Color); break;\n"
+"        case 11: imageStore(OutMip11, Location, Color); break;\n"
+"    }\n"
+"}\n"
+"\n"
+"// Returns the linear value of texel Coord of mip level BaseLevel, which is either\n"
+"// the first level of the chain (sampled from the source) or level 6 (reduced from OutMip5).\n"
+"// Coordinates are clamped to the level dimensions so that a dimension that has\n"
+"// collapsed to a single texel replicates it instead of averaging in garbage.\n"
+"vec4 LoadBaseLevel(int BaseLevel, ivec2 Coord, int ArraySlice)\n"
+"{\n"
+"    Coord = min(Coord, GetOutMipSize(BaseLevel) - ivec2(1, 1));\n"
+"    if (BaseLevel == 0)\n"
+"    {\n"
+"        // Bilinear sample at the center of the 2x2 source quad\n"
+"        vec2 UV = (vec2(Coord * 2) + vec2(1.0, 1.0)) * InvSrcMipSize;\n"
+"        return textureLod(SrcMip, vec3(UV, float(ArraySlice)), 0.0);\n"
+"    }\n"
+"    else\n"
+"    {\n"
+"        ivec2 MaxCoord = GetOutMipSize(BaseLevel - 1) - ivec2(1, 1);\n"
+"        ivec2 Src      = Coord * 2;\n"
+"\n"
+"        vec4 Color = UnpackColor(imageLoad(OutMip5, ivec3(min(Src + ivec2(0, 0), MaxCoord), ArraySlice)));\n"
+"        Color     += UnpackColor(imageLoad(OutMip5, ivec3(min(Src + ivec2(1, 0), MaxCoord), ArraySlice)));\n"
+"        Color     += UnpackColor(imageLoad(OutMip5, ivec3(min(Src + ivec2(0, 1), MaxCoord), ArraySlice)));\n"
+"        Color     += UnpackColor(imageLoad(OutMip5, ivec3(min(Src + ivec2(1, 1), MaxCoord), ArraySlice)));\n"
+"        return Color * 0.25;\n"
+"    }\n"
+"}\n"
+"\n"
+"void GroupMemoryBarrierWithGroupSync()\n"
+"{\n"
+"    groupMemoryBarrier();\n"
+"    memoryBarrierShared();\n"
+"    barrier();\n"
+"}\n"
+"\n"
+"// Reduces a 32x32 block of level BaseLevel down to a single texel of level BaseLevel + 5.\n"
+"// TileId is the position of the block in units of 32x32 texels of BaseLevel.\n"
+"void DownsampleTile(int BaseLevel, ivec2 TileId, int ArraySlice, uint LocalInd)\n"
+"{\n"
+"    ivec2 ThreadId = ivec2(LocalInd & 15u, LocalInd >> 4u);\n"
+"\n"
+"    // Every thread produces a 2x2 quad of BaseLevel and one texel of BaseLevel + 1\n"
+"    // without going through shared memory.\n"
+"    ivec2 Origin = TileId * 32;\n"
+"    vec4  Sum    = vec4(0.0, 0.0, 0.0, 0.0);\n"
+"    for (int i = 0; i < 4; ++i)\n"
+"    {\n"
+"        ivec2 Coord = Origin + ThreadId * 2 + ivec2(i & 1, i >> 1);\n"
+"        vec4  Color = LoadBaseLevel(BaseLevel, Coord, ArraySlice);\n"
+"        WriteOutMip(BaseLevel, Coord, ArraySlice, Color);\n"
+"        Sum += Color;\n"
+"    }\n"
+"    Sum *= 0.25;\n"
+"    WriteOutMip(BaseLevel + 1, TileId * 16 + ThreadId, ArraySlice, Sum);\n"
+"    StoreColor(LocalInd, Sum);\n"
+"\n"
+"    // The remaining levels are reduced through shared memory, with the texels of\n"
+"    // the input level stored in a 16-texel wide grid.\n"
+"    for (int Level = 2; Level < 6; ++Level)\n"
+"    {\n"
+"        // NumMipLevels is uniform, so the barriers below are in uniform control flow\n"
+"        if (BaseLevel + Level >= NumMipLevels)\n"
+"            break;\n"
+"\n"
+"        int   Dim       = 16 >> (Level - 1); // Output level tile dimension: 8, 4, 2, 1\n"
+"        ivec2 InOrigin  = TileId * (Dim * 2);\n"
+"        ivec2 InMaxDim  = GetOutMipSize(BaseLevel + Level - 1) - InOrigin - ivec2(1, 1);\n"
+"        bool  IsActive  = LocalInd < uint(Dim * Dim);\n"
+"        ivec2 OutCoord  = ivec2(int(LocalInd) % Dim, int(LocalInd) / Dim);\n"
+"        vec4  Color     = vec4(0.0, 0.0, 0.0, 0.0);\n"
+"\n"
+"        GroupMemoryBarrierWithGroupSync();\n"
+"        if (IsActive)\n"
+"        {\n"
+"            ivec2 Src0 = clamp(OutCoord * 2, ivec2(0, 0), max(InMaxDim, ivec2(0, 0)));\n"
+"            ivec2 Src1 = clamp(OutCoord * 2 + ivec2(1, 1), ivec2(0, 0), max(InMaxDim, ivec2(0, 0)));\n"
+"\n"
+"            Color = LoadColor(uint(Src0.y * 16 + Src0.x));\n"
+"            Color += LoadColor(uint(Src0.y * 16 + Src1.x));\n"
+"            Color += LoadColor(uint(Src1.y * 16 + Src0.x));\n"
+"            Color += LoadColor(uint(Src1.y * 16 + Src1.x));\n"
+"            Color *= 0.25;\n"
+"        }\n"
+"\n"
+"        GroupMemoryBarrierWithGroupSync();\n"
+"        if (IsActive)\n"
+"        {\n"
+"            StoreColor(uint(OutCoord.y * 16 + OutCoord.x), Color);\n"
+"            WriteOutMip(BaseLevel + Level, TileId * Dim + OutCoord, ArraySlice, Color);\n"
+"        }\n"
+"    }\n"
+"}\n"
+"\n"
+"layout (local_size_x = 256, local_size_y = 1, local_size_z = 1) in;\n"
+"void main()\n"
+"{\n"
+"    uint LocalInd   = gl_LocalInvocationIndex;\n"
+"    int  ArraySlice = int(gl_WorkGroupID.z);\n"
+"\n"
+"    // Levels 0 - 5\n"
+"    DownsampleTile(0, ivec2(gl_WorkGroupID.xy), ArraySlice, LocalInd);\n"
+"\n"
+"    // A scalar (constant) branch can exit all threads coherently.\n"
+"    if (NumMipLevels <= 6)\n"
+"        return;\n"
+"\n"
+"    // Make OutMip5 writes of this group visible to other groups before signaling completion\n"
+"    memoryBarrierImage();\n"
+"    GroupMemoryBarrierWithGroupSync();\n"
+"\n"
+"    if (LocalInd == 0u)\n"
+"    {\n"
+"        memoryBarrier();\n"
+"        uint NumFinished = atomicAdd(Counter[ArraySlice], 1u);\n"
+"        gs_IsLastGroup   = NumFinished == NumWorkGroups - 1u;\n"
+"    }\n"
+"    GroupMemoryBarrierWithGroupSync();\n"
+"\n"
+"    if (!gs_IsLastGroup)\n"
+"        return;\n"
+"\n"
+"    if (LocalInd == 0u)\n"
+"    {\n"
+"        // Reset the counter for the next dispatch\n"
+"        atomicExchange(Counter[ArraySlice], 0u);\n"
+"    }\n"
+"    memoryBarrierImage();\n"
+"\n"
+"    // Levels 6 - 11. OutMip5 is at most 64x64 texels, so its entire\n"
+"    // reduction fits into a single tile.\n"
+"    DownsampleTile(6, ivec2(0, 0), ArraySlice, LocalInd);\n"
+"}\n"
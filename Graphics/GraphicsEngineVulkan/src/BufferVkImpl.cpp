@@ -173,7 +173,8 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
 
     if (m_Desc.Usage == USAGE_DYNAMIC)
     {
-        auto CtxCount = 1 + pRenderDeviceVk->GetNumDeferredContexts();
+        // Compute contexts follow the deferred contexts
+        auto CtxCount = 1 + pRenderDeviceVk->GetNumDeferredContexts() + PlatformMisc::CountOneBits(pRenderDeviceVk->GetComputeQueueMask());
         m_DynamicData.reserve(CtxCount);
         for (Uint32 ctx = 0; ctx < CtxCount; ++ctx)
             m_DynamicData.emplace_back();
@@ -207,10 +208,21 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
     }
     else
     {
-        VkBuffCI.sharingMode           = VK_SHARING_MODE_EXCLUSIVE; // sharing mode of the buffer when it will be accessed by multiple queue families.
-        VkBuffCI.queueFamilyIndexCount = 0;                         // number of entries in the pQueueFamilyIndices array
-        VkBuffCI.pQueueFamilyIndices   = nullptr;                   // list of queue families that will access this buffer
-                                                                    // (ignored if sharingMode is not VK_SHARING_MODE_CONCURRENT).
+        const auto& ConcurrentQueueFamilies = pRenderDeviceVk->GetConcurrentQueueFamilies();
+        if (!ConcurrentQueueFamilies.empty())
+        {
+            // Buffers that may be accessed by compute contexts are shared by all queue families that use them
+            VkBuffCI.sharingMode           = VK_SHARING_MODE_CONCURRENT;
+            VkBuffCI.queueFamilyIndexCount = static_cast<uint32_t>(ConcurrentQueueFamilies.size());
+            VkBuffCI.pQueueFamilyIndices   = ConcurrentQueueFamilies.data();
+        }
+        else
+        {
+            VkBuffCI.sharingMode           = VK_SHARING_MODE_EXCLUSIVE; // sharing mode of the buffer when it will be accessed by multiple queue families.
+            VkBuffCI.queueFamilyIndexCount = 0;                         // number of entries in the pQueueFamilyIndices array
+            VkBuffCI.pQueueFamilyIndices   = nullptr;                   // list of queue families that will access this buffer
+                                                                        // (ignored if sharingMode is not VK_SHARING_MODE_CONCURRENT).
+        }
 
         m_VulkanBuffer = LogicalDevice.CreateBuffer(VkBuffCI, m_Desc.Name);
 
@@ -320,9 +332,15 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
                 err = LogicalDevice.BindBufferMemory(StagingBuffer, StagingBufferMemory, AlignedStagingMemOffset);
                 CHECK_VK_ERROR_AND_THROW(err, "Failed to bind staging bufer memory");
 
+                // The copy is executed on the dedicated transfer queue, if there is one
+                const bool UseTransferQueue = pRenderDeviceVk->HasTransferQueue();
+
                 VulkanUtilities::CommandPoolWrapper CmdPool;
                 VkCommandBuffer                     vkCmdBuff;
-                pRenderDeviceVk->AllocateTransientCmdPool(CmdPool, vkCmdBuff, "Transient command pool to copy staging data to a device buffer");
+                if (UseTransferQueue)
+                    pRenderDeviceVk->AllocateTransferCmdPool(CmdPool, vkCmdBuff, "Transfer command pool to copy staging data to a device buffer");
+                else
+                    pRenderDeviceVk->AllocateTransientCmdPool(CmdPool, vkCmdBuff, "Transient command pool to copy staging data to a device buffer");
 
                 auto EnabledShaderStages = LogicalDevice.GetEnabledShaderStages();
                 VulkanUtilities::VulkanCommandBuffer::BufferMemoryBarrier(vkCmdBuff, StagingBuffer, 0, VK_ACCESS_TRANSFER_READ_BIT, EnabledShaderStages);
@@ -340,7 +358,24 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
                 vkCmdCopyBuffer(vkCmdBuff, StagingBuffer, m_VulkanBuffer, 1, &BuffCopy);
 
                 Uint32 QueueIndex = 0;
-                pRenderDeviceVk->ExecuteAndDisposeTransientCmdBuff(QueueIndex, vkCmdBuff, std::move(CmdPool));
+                if (UseTransferQueue)
+                {
+                    // Hand the buffer over to the graphics queue
+                    VkBufferMemoryBarrier OwnershipBarrier = {};
+                    OwnershipBarrier.sType                 = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+                    OwnershipBarrier.srcAccessMask         = VK_ACCESS_TRANSFER_WRITE_BIT;
+                    OwnershipBarrier.dstAccessMask         = AccessFlags;
+                    OwnershipBarrier.buffer                = m_VulkanBuffer;
+                    OwnershipBarrier.offset                = 0;
+                    OwnershipBarrier.size                  = VK_WHOLE_SIZE;
+
+                    QueueIndex = pRenderDeviceVk->GetTransferQueueIndex();
+                    pRenderDeviceVk->ExecuteAndDisposeTransferCmdBuff(vkCmdBuff, std::move(CmdPool), 1, &OwnershipBarrier, 0, nullptr);
+                }
+                else
+                {
+                    pRenderDeviceVk->ExecuteAndDisposeTransientCmdBuff(QueueIndex, vkCmdBuff, std::move(CmdPool));
+                }
 
 
                 // After command buffer is submitted, safe-release staging resources. This strategy
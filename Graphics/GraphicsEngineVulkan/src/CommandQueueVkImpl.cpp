@@ -34,11 +34,12 @@ namespace Diligent
 
 CommandQueueVkImpl::CommandQueueVkImpl(IReferenceCounters*                                   pRefCounters,
                                        std::shared_ptr<VulkanUtilities::VulkanLogicalDevice> LogicalDevice,
-                                       uint32_t                                              QueueFamilyIndex) :
+                                       uint32_t                                              QueueFamilyIndex,
+                                       uint32_t                                              QueueIndex) :
     // clang-format off
     TBase{pRefCounters},
     m_LogicalDevice    {LogicalDevice},
-    m_VkQueue          {LogicalDevice->GetQueue(QueueFamilyIndex, 0)},
+    m_VkQueue          {LogicalDevice->GetQueue(QueueFamilyIndex, QueueIndex)},
     m_QueueFamilyIndex {QueueFamilyIndex},
     m_NextFenceValue   {1}
 // clang-format on
@@ -52,7 +52,11 @@ VulkanUtilities::DescriptorPoolWrapper DescriptorPoolManager::CreateDescriptorPo
     // VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT specifies that descriptor sets can
     // return their individual allocations to the pool, i.e. all of vkAllocateDescriptorSets,
     // vkFreeDescriptorSets, and vkResetDescriptorPool are allowed. (13.2.3)
-    PoolCI.flags         = m_AllowFreeing ? VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT : 0;
+    PoolCI.flags = m_AllowFreeing ? VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT : 0;
+    // Descriptor sets whose layouts are created with VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT
+    // must be allocated from pools created with VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT (13.2.3)
+    if (m_UpdateAfterBind)
+        PoolCI.flags |= VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
     PoolCI.maxSets       = m_MaxSets;
     PoolCI.poolSizeCount = static_cast<uint32_t>(m_PoolSizes.size());
     PoolCI.pPoolSizes    = m_PoolSizes.data();
@@ -64,6 +68,13 @@ static std::vector<VkDescriptorPoolSize> PrunePoolSizes(RenderDeviceVkImpl& Devi
     const auto& Feats = DeviceVkImpl.GetLogicalDevice().GetEnabledExtFeatures();
     for (auto iter = PoolSizes.begin(); iter != PoolSizes.end();)
     {
+        // descriptorCount must be greater than 0 (13.2.3)
+        if (iter->descriptorCount == 0)
+        {
+            iter = PoolSizes.erase(iter);
+            continue;
+        }
+
         switch (iter->type)
         {
             case VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR:
@@ -83,13 +94,15 @@ DescriptorPoolManager::DescriptorPoolManager(RenderDeviceVkImpl&               D
                                              std::string                       PoolName,
                                              std::vector<VkDescriptorPoolSize> PoolSizes,
                                              uint32_t                          MaxSets,
-                                             bool                              AllowFreeing) noexcept :
+                                             bool                              AllowFreeing,
+                                             bool                              UpdateAfterBind) noexcept :
     // clang-format off
-    m_DeviceVkImpl{DeviceVkImpl        },
-    m_PoolName    {std::move(PoolName) },
-    m_PoolSizes   (PrunePoolSizes(DeviceVkImpl, std::move(PoolSizes))),
-    m_MaxSets     {MaxSets             },
-    m_AllowFreeing{AllowFreeing        }
+    m_DeviceVkImpl   {DeviceVkImpl        },
+    m_PoolName       {std::move(PoolName) },
+    m_PoolSizes      (PrunePoolSizes(DeviceVkImpl, std::move(PoolSizes))),
+    m_MaxSets        {MaxSets             },
+    m_AllowFreeing   {AllowFreeing        },
+    m_UpdateAfterBind{UpdateAfterBind     }
 // clang-format on
 {
 #ifdef DILIGENT_DEVELOPMENT
@@ -41,17 +41,31 @@
 namespace Diligent
 {
 
-static std::string GetContextObjectName(const char* Object, bool bIsDeferred, Uint32 ContextId)
+static std::string GetContextObjectName(const char* Object, bool bIsDeferred, Uint32 ContextId, Uint32 CommandQueueId)
 {
     std::stringstream ss;
     ss << Object;
     if (bIsDeferred)
         ss << " of deferred context #" << ContextId;
+    else if (CommandQueueId != 0)
+        ss << " of compute context #" << ContextId;
     else
         ss << " of immediate context";
     return ss.str();
 }
 
+// Resource states that require a queue that supports graphics operations
+static constexpr RESOURCE_STATE GraphicsOnlyResourceStates = static_cast<RESOURCE_STATE>(
+    RESOURCE_STATE_VERTEX_BUFFER |
+    RESOURCE_STATE_INDEX_BUFFER |
+    RESOURCE_STATE_RENDER_TARGET |
+    RESOURCE_STATE_DEPTH_WRITE |
+    RESOURCE_STATE_DEPTH_READ |
+    RESOURCE_STATE_STREAM_OUT |
+    RESOURCE_STATE_INPUT_ATTACHMENT |
+    RESOURCE_STATE_RESOLVE_DEST |
+    RESOURCE_STATE_RESOLVE_SOURCE);
+
 DeviceContextVkImpl::DeviceContextVkImpl(IReferenceCounters*                   pRefCounters,
                                          RenderDeviceVkImpl*                   pDeviceVkImpl,
                                          bool                                  bIsDeferred,
@@ -69,7 +83,15 @@ DeviceContextVkImpl::DeviceContextVkImpl(IReferenceCounters*                   p
         bIsDeferred ? std::numeric_limits<decltype(m_NumCommandsToFlush)>::max() : EngineCI.NumCommandsToFlushCmdBuffer,
         bIsDeferred
     },
-    m_CommandBuffer { pDeviceVkImpl->GetLogicalDevice().GetEnabledShaderStages() },
+    // Compute contexts submit commands to queues that do not support graphics operations,
+    // so graphics pipeline stages must not be used in their barriers
+    m_IsComputeOnly { !bIsDeferred && CommandQueueId != 0 },
+    m_CommandBuffer
+    {
+        pDeviceVkImpl->GetLogicalDevice().GetEnabledShaderStages() &
+        (m_IsComputeOnly ? VkPipelineStageFlags{VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR} : ~VkPipelineStageFlags{0})
+    },
+    m_UseDynamicRendering { pDeviceVkImpl->UseDynamicRendering() },
     m_CmdListAllocator { GetRawAllocator(), sizeof(CommandListVkImpl), 64 },
     // Command pools must be thread safe because command buffers are returned into pools by release queues
     // potentially running in another thread
@@ -83,19 +105,19 @@ DeviceContextVkImpl::DeviceContextVkImpl(IReferenceCounters*                   p
     m_UploadHeap
     {
         *pDeviceVkImpl,
-        GetContextObjectName("Upload heap", bIsDeferred, ContextId),
+        GetContextObjectName("Upload heap", bIsDeferred, ContextId, CommandQueueId),
         EngineCI.UploadHeapPageSize
     },
     m_DynamicHeap
     {
         pDeviceVkImpl->GetDynamicMemoryManager(),
-        GetContextObjectName("Dynamic heap", bIsDeferred, ContextId),
+        GetContextObjectName("Dynamic heap", bIsDeferred, ContextId, CommandQueueId),
         EngineCI.DynamicHeapPageSize
     },
     m_DynamicDescrSetAllocator
     {
         pDeviceVkImpl->GetDynamicDescriptorPool(),
-        GetContextObjectName("Dynamic descriptor set allocator", bIsDeferred, ContextId),
+        GetContextObjectName("Dynamic descriptor set allocator", bIsDeferred, ContextId, CommandQueueId),
     },
     m_GenerateMipsHelper{std::move(GenerateMipsHelper)}
 // clang-format on
@@ -106,6 +128,7 @@ DeviceContextVkImpl::DeviceContextVkImpl(IReferenceCounters*                   p
     }
 
     m_GenerateMipsHelper->CreateSRB(&m_GenerateMipsSRB);
+    m_GenerateMipsHelper->CreateSPDSRB(&m_GenerateMipsSPDSRB, &m_GenerateMipsSPDCounter);
 
     BufferDesc DummyVBDesc;
     DummyVBDesc.Name          = "Dummy vertex buffer";
@@ -159,9 +182,11 @@ DeviceContextVkImpl::~DeviceContextVkImpl()
     m_pDevice->SafeReleaseDeviceObject(std::move(VkCmdPool), ~Uint64{0});
 
     // clang-format off
-    m_pDevice->SafeReleaseDeviceObject(std::move(m_GenerateMipsHelper), ~Uint64{0});
-    m_pDevice->SafeReleaseDeviceObject(std::move(m_GenerateMipsSRB),    ~Uint64{0});
-    m_pDevice->SafeReleaseDeviceObject(std::move(m_DummyVB),            ~Uint64{0});
+    m_pDevice->SafeReleaseDeviceObject(std::move(m_GenerateMipsHelper),     ~Uint64{0});
+    m_pDevice->SafeReleaseDeviceObject(std::move(m_GenerateMipsSRB),        ~Uint64{0});
+    m_pDevice->SafeReleaseDeviceObject(std::move(m_GenerateMipsSPDSRB),     ~Uint64{0});
+    m_pDevice->SafeReleaseDeviceObject(std::move(m_GenerateMipsSPDCounter), ~Uint64{0});
+    m_pDevice->SafeReleaseDeviceObject(std::move(m_DummyVB),                ~Uint64{0});
     // clang-format on
 
     // The main reason we need to idle the GPU is because we need to make sure that all command buffers are returned to the
@@ -218,7 +243,7 @@ void DeviceContextVkImpl::DisposeVkCmdBuffer(Uint32 CmdQueue, VkCommandBuffer vk
 
 inline void DeviceContextVkImpl::DisposeCurrentCmdBuffer(Uint32 CmdQueue, Uint64 FenceValue)
 {
-    VERIFY(m_CommandBuffer.GetState().RenderPass == VK_NULL_HANDLE, "Disposing command buffer with unifinished render pass");
+    VERIFY(!m_CommandBuffer.IsInsideRenderPass(), "Disposing command buffer with unifinished render pass");
     auto vkCmdBuff = m_CommandBuffer.GetVkCmdBuffer();
     if (vkCmdBuff != VK_NULL_HANDLE)
     {
@@ -234,6 +259,9 @@ void DeviceContextVkImpl::SetPipelineState(IPipelineState* pPipelineState)
     if (PipelineStateVkImpl::IsSameObject(m_pPipelineState, pPipelineStateVk))
         return;
 
+    if (pPipelineStateVk->GetDesc().IsAnyGraphicsPipeline() && !IsGraphicsCommandAllowed("Setting graphics pipeline state"))
+        return;
+
     if (m_State.NumCommands >= m_NumCommandsToFlush &&
         !m_bIsDeferred &&           // Never flush deferred context
         !m_pActiveRenderPass &&     // Never flush inside active render pass (https://www.khronos.org/registry/vulkan/specs/1.2-extensions/html/vkspec.html#VUID-vkEndCommandBuffer-commandBuffer-00060)
@@ -333,6 +361,9 @@ void DeviceContextVkImpl::CommitShaderResources(IShaderResourceBinding* pShaderR
 
 void DeviceContextVkImpl::SetStencilRef(Uint32 StencilRef)
 {
+    if (!IsGraphicsCommandAllowed("SetStencilRef()"))
+        return;
+
     if (TDeviceContextBase::SetStencilRef(StencilRef, 0))
     {
         EnsureVkCmdBuffer();
@@ -342,6 +373,9 @@ void DeviceContextVkImpl::SetStencilRef(Uint32 StencilRef)
 
 void DeviceContextVkImpl::SetBlendFactors(const float* pBlendFactors)
 {
+    if (!IsGraphicsCommandAllowed("SetBlendFactors()"))
+        return;
+
     if (TDeviceContextBase::SetBlendFactors(pBlendFactors, 0))
     {
         EnsureVkCmdBuffer();
@@ -438,14 +472,40 @@ void DeviceContextVkImpl::DvpLogRenderPass_PSOMismatch()
     LOG_ERROR_MESSAGE(ss.str());
 }
 
+bool DeviceContextVkImpl::DvpIsPSOCompatibleWithRenderTargets()
+{
+    // With dynamic rendering, the pipeline must have been created with exactly the same
+    // number and formats of attachments, and the same sample count
+    const auto& GrPipeline = m_pPipelineState->GetGraphicsPipelineDesc();
+    if (GrPipeline.NumRenderTargets != m_NumBoundRenderTargets)
+        return false;
+
+    Uint32 SampleCount = 0;
+    for (Uint32 rt = 0; rt < m_NumBoundRenderTargets; ++rt)
+    {
+        auto* pRTV = m_pBoundRenderTargets[rt].RawPtr();
+        if (GrPipeline.RTVFormats[rt] != (pRTV != nullptr ? pRTV->GetDesc().Format : TEX_FORMAT_UNKNOWN))
+            return false;
+        if (pRTV != nullptr)
+            SampleCount = pRTV->GetTexture()->GetDesc().SampleCount;
+    }
+
+    if (GrPipeline.DSVFormat != (m_pBoundDepthStencil ? m_pBoundDepthStencil->GetDesc().Format : TEX_FORMAT_UNKNOWN))
+        return false;
+    if (m_pBoundDepthStencil)
+        SampleCount = m_pBoundDepthStencil->GetTexture()->GetDesc().SampleCount;
+
+    return SampleCount == 0 || SampleCount == GrPipeline.SmplDesc.Count;
+}
+
 void DeviceContextVkImpl::PrepareForDraw(DRAW_FLAGS Flags)
 {
 #ifdef DILIGENT_DEVELOPMENT
     if ((Flags & DRAW_FLAG_VERIFY_RENDER_TARGETS) != 0)
         DvpVerifyRenderTargets();
 
-    VERIFY(m_vkRenderPass != VK_NULL_HANDLE, "No render pass is active while executing draw command");
-    VERIFY(m_vkFramebuffer != VK_NULL_HANDLE, "No framebuffer is bound while executing draw command");
+    VERIFY(m_vkRenderPass != VK_NULL_HANDLE || m_DynamicRenderingTargetsBound, "No render pass is active while executing draw command");
+    VERIFY(m_vkFramebuffer != VK_NULL_HANDLE || m_DynamicRenderingTargetsBound, "No framebuffer is bound while executing draw command");
 #endif
 
     EnsureVkCmdBuffer();
@@ -492,7 +552,9 @@ void DeviceContextVkImpl::PrepareForDraw(DRAW_FLAGS Flags)
     if (m_pPipelineState->GetGraphicsPipelineDesc().pRenderPass == nullptr)
     {
 #ifdef DILIGENT_DEVELOPMENT
-        if (m_pPipelineState->GetRenderPass()->GetVkRenderPass() != m_vkRenderPass)
+        if (m_UseDynamicRendering ?
+                !DvpIsPSOCompatibleWithRenderTargets() :
+                m_pPipelineState->GetRenderPass()->GetVkRenderPass() != m_vkRenderPass)
         {
             // Note that different Vulkan render passes may still be compatible,
             // so we should only verify implicit render passes
@@ -537,6 +599,9 @@ void DeviceContextVkImpl::PrepareForIndexedDraw(DRAW_FLAGS Flags, VALUE_TYPE Ind
 
 void DeviceContextVkImpl::Draw(const DrawAttribs& Attribs)
 {
+    if (!IsGraphicsCommandAllowed("Draw()"))
+        return;
+
     if (!DvpVerifyDrawArguments(Attribs))
         return;
 
@@ -548,6 +613,9 @@ void DeviceContextVkImpl::Draw(const DrawAttribs& Attribs)
 
 void DeviceContextVkImpl::DrawIndexed(const DrawIndexedAttribs& Attribs)
 {
+    if (!IsGraphicsCommandAllowed("DrawIndexed()"))
+        return;
+
     if (!DvpVerifyDrawIndexedArguments(Attribs))
         return;
 
@@ -559,36 +627,93 @@ void DeviceContextVkImpl::DrawIndexed(const DrawIndexedAttribs& Attribs)
 
 void DeviceContextVkImpl::DrawIndirect(const DrawIndirectAttribs& Attribs, IBuffer* pAttribsBuffer)
 {
+    if (!IsGraphicsCommandAllowed("DrawIndirect()"))
+        return;
+
     if (!DvpVerifyDrawIndirectArguments(Attribs, pAttribsBuffer))
         return;
 
     // We must prepare indirect draw attribs buffer first because state transitions must
     // be performed outside of render pass, and PrepareForDraw commits render pass
     BufferVkImpl* pIndirectDrawAttribsVk = PrepareIndirectDrawAttribsBuffer(pAttribsBuffer, Attribs.IndirectAttribsBufferStateTransitionMode);
+    BufferVkImpl* pCounterBufferVk       = Attribs.pCounterBuffer != nullptr ?
+        PrepareIndirectDrawAttribsBuffer(Attribs.pCounterBuffer, Attribs.CounterBufferStateTransitionMode) :
+        nullptr;
 
     PrepareForDraw(Attribs.Flags);
 
-    m_CommandBuffer.DrawIndirect(pIndirectDrawAttribsVk->GetVkBuffer(), pIndirectDrawAttribsVk->GetDynamicOffset(m_ContextId, this) + Attribs.IndirectDrawArgsOffset, 1, 0);
+    const VkDeviceSize ArgsOffset = pIndirectDrawAttribsVk->GetDynamicOffset(m_ContextId, this) + Attribs.IndirectDrawArgsOffset;
+    const Uint32       ArgsStride = Attribs.DrawArgsStride != 0 ? Attribs.DrawArgsStride : Uint32{sizeof(VkDrawIndirectCommand)};
+    if (pCounterBufferVk != nullptr)
+    {
+#if DILIGENT_VK_DRAW_INDIRECT_COUNT_SUPPORTED
+        m_CommandBuffer.DrawIndirectCount(pIndirectDrawAttribsVk->GetVkBuffer(), ArgsOffset,
+                                          pCounterBufferVk->GetVkBuffer(), pCounterBufferVk->GetDynamicOffset(m_ContextId, this) + Attribs.CounterOffset,
+                                          Attribs.DrawCount, ArgsStride);
+#else
+        UNEXPECTED("Indirect draw counter buffer is not supported");
+#endif
+    }
+    else if (Attribs.DrawCount == 1 || m_pDevice->GetLogicalDevice().GetEnabledFeatures().multiDrawIndirect != VK_FALSE)
+    {
+        m_CommandBuffer.DrawIndirect(pIndirectDrawAttribsVk->GetVkBuffer(), ArgsOffset, Attribs.DrawCount, ArgsStride);
+    }
+    else
+    {
+        // Without multiDrawIndirect feature, drawCount must be 0 or 1
+        for (Uint32 i = 0; i < Attribs.DrawCount; ++i)
+            m_CommandBuffer.DrawIndirect(pIndirectDrawAttribsVk->GetVkBuffer(), ArgsOffset + VkDeviceSize{ArgsStride} * i, 1, ArgsStride);
+    }
     ++m_State.NumCommands;
 }
 
 void DeviceContextVkImpl::DrawIndexedIndirect(const DrawIndexedIndirectAttribs& Attribs, IBuffer* pAttribsBuffer)
 {
+    if (!IsGraphicsCommandAllowed("DrawIndexedIndirect()"))
+        return;
+
     if (!DvpVerifyDrawIndexedIndirectArguments(Attribs, pAttribsBuffer))
         return;
 
     // We must prepare indirect draw attribs buffer first because state transitions must
     // be performed outside of render pass, and PrepareForDraw commits render pass
     BufferVkImpl* pIndirectDrawAttribsVk = PrepareIndirectDrawAttribsBuffer(pAttribsBuffer, Attribs.IndirectAttribsBufferStateTransitionMode);
+    BufferVkImpl* pCounterBufferVk       = Attribs.pCounterBuffer != nullptr ?
+        PrepareIndirectDrawAttribsBuffer(Attribs.pCounterBuffer, Attribs.CounterBufferStateTransitionMode) :
+        nullptr;
 
     PrepareForIndexedDraw(Attribs.Flags, Attribs.IndexType);
 
-    m_CommandBuffer.DrawIndexedIndirect(pIndirectDrawAttribsVk->GetVkBuffer(), pIndirectDrawAttribsVk->GetDynamicOffset(m_ContextId, this) + Attribs.IndirectDrawArgsOffset, 1, 0);
+    const VkDeviceSize ArgsOffset = pIndirectDrawAttribsVk->GetDynamicOffset(m_ContextId, this) + Attribs.IndirectDrawArgsOffset;
+    const Uint32       ArgsStride = Attribs.DrawArgsStride != 0 ? Attribs.DrawArgsStride : Uint32{sizeof(VkDrawIndexedIndirectCommand)};
+    if (pCounterBufferVk != nullptr)
+    {
+#if DILIGENT_VK_DRAW_INDIRECT_COUNT_SUPPORTED
+        m_CommandBuffer.DrawIndexedIndirectCount(pIndirectDrawAttribsVk->GetVkBuffer(), ArgsOffset,
+                                                 pCounterBufferVk->GetVkBuffer(), pCounterBufferVk->GetDynamicOffset(m_ContextId, this) + Attribs.CounterOffset,
+                                                 Attribs.DrawCount, ArgsStride);
+#else
+        UNEXPECTED("Indirect draw counter buffer is not supported");
+#endif
+    }
+    else if (Attribs.DrawCount == 1 || m_pDevice->GetLogicalDevice().GetEnabledFeatures().multiDrawIndirect != VK_FALSE)
+    {
+        m_CommandBuffer.DrawIndexedIndirect(pIndirectDrawAttribsVk->GetVkBuffer(), ArgsOffset, Attribs.DrawCount, ArgsStride);
+    }
+    else
+    {
+        // Without multiDrawIndirect feature, drawCount must be 0 or 1
+        for (Uint32 i = 0; i < Attribs.DrawCount; ++i)
+            m_CommandBuffer.DrawIndexedIndirect(pIndirectDrawAttribsVk->GetVkBuffer(), ArgsOffset + VkDeviceSize{ArgsStride} * i, 1, ArgsStride);
+    }
     ++m_State.NumCommands;
 }
 
 void DeviceContextVkImpl::DrawMesh(const DrawMeshAttribs& Attribs)
 {
+    if (!IsGraphicsCommandAllowed("DrawMesh()"))
+        return;
+
     if (!DvpVerifyDrawMeshArguments(Attribs))
         return;
 
@@ -600,6 +725,9 @@ void DeviceContextVkImpl::DrawMesh(const DrawMeshAttribs& Attribs)
 
 void DeviceContextVkImpl::DrawMeshIndirect(const DrawMeshIndirectAttribs& Attribs, IBuffer* pAttribsBuffer)
 {
+    if (!IsGraphicsCommandAllowed("DrawMeshIndirect()"))
+        return;
+
     if (!DvpVerifyDrawMeshIndirectArguments(Attribs, pAttribsBuffer))
         return;
 
@@ -618,7 +746,7 @@ void DeviceContextVkImpl::PrepareForDispatchCompute()
     EnsureVkCmdBuffer();
 
     // Dispatch commands must be executed outside of render pass
-    if (m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE)
+    if (m_CommandBuffer.IsInsideRenderPass())
         m_CommandBuffer.EndRenderPass();
 
     if (m_DescrSetBindInfo.DynamicOffsetCount != 0)
@@ -691,6 +819,9 @@ void DeviceContextVkImpl::ClearDepthStencil(ITextureView*                  pView
                                             Uint8                          Stencil,
                                             RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    if (!IsGraphicsCommandAllowed("ClearDepthStencil()"))
+        return;
+
     if (!TDeviceContextBase::ClearDepthStencil(pView))
         return;
 
@@ -709,7 +840,7 @@ void DeviceContextVkImpl::ClearDepthStencil(ITextureView*                  pView
            "checks if the DSV is bound as a framebuffer attachment and returns false otherwise (in development mode).");
     if (ClearAsAttachment)
     {
-        VERIFY_EXPR(m_vkRenderPass != VK_NULL_HANDLE && m_vkFramebuffer != VK_NULL_HANDLE);
+        VERIFY_EXPR((m_vkRenderPass != VK_NULL_HANDLE && m_vkFramebuffer != VK_NULL_HANDLE) || m_DynamicRenderingTargetsBound);
         if (m_pActiveRenderPass == nullptr)
         {
             // Render pass may not be currently committed
@@ -741,7 +872,7 @@ void DeviceContextVkImpl::ClearDepthStencil(ITextureView*                  pView
     else
     {
         // End render pass to clear the buffer with vkCmdClearDepthStencilImage
-        if (m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE)
+        if (m_CommandBuffer.IsInsideRenderPass())
             m_CommandBuffer.EndRenderPass();
 
         auto* pTexture   = pVkDSV->GetTexture();
@@ -830,7 +961,7 @@ void DeviceContextVkImpl::ClearRenderTarget(ITextureView* pView, const float* RG
 
     if (attachmentIndex != InvalidAttachmentIndex)
     {
-        VERIFY_EXPR(m_vkRenderPass != VK_NULL_HANDLE && m_vkFramebuffer != VK_NULL_HANDLE);
+        VERIFY_EXPR((m_vkRenderPass != VK_NULL_HANDLE && m_vkFramebuffer != VK_NULL_HANDLE) || m_DynamicRenderingTargetsBound);
         if (m_pActiveRenderPass == nullptr)
         {
             // Render pass may not be currently committed
@@ -864,7 +995,7 @@ void DeviceContextVkImpl::ClearRenderTarget(ITextureView* pView, const float* RG
         VERIFY(m_pActiveRenderPass == nullptr, "This branch should never execute inside a render pass.");
 
         // End current render pass and clear the image with vkCmdClearColorImage
-        if (m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE)
+        if (m_CommandBuffer.IsInsideRenderPass())
             m_CommandBuffer.EndRenderPass();
 
         auto* pTexture   = pVkRTV->GetTexture();
@@ -954,6 +1085,13 @@ void DeviceContextVkImpl::FinishFrame()
     // be destroyed before the pools are actually returned to the global pool manager.
     m_DynamicDescrSetAllocator.ReleasePools(m_SubmittedBuffersCmdQueueMask);
 
+    // Only the main immediate context maintains the transfer queue and checks the memory budget
+    if (!m_bIsDeferred && !m_IsComputeOnly)
+    {
+        m_pDevice->DiscardTransferQueueStaleResources();
+        m_pDevice->CheckMemoryBudget();
+    }
+
     EndFrame();
 }
 
@@ -991,7 +1129,7 @@ void DeviceContextVkImpl::Flush()
 
         if (m_State.NumCommands != 0)
         {
-            if (m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE)
+            if (m_CommandBuffer.IsInsideRenderPass())
             {
                 m_CommandBuffer.EndRenderPass();
             }
@@ -1014,6 +1152,20 @@ void DeviceContextVkImpl::Flush()
     SubmitInfo.signalSemaphoreCount = static_cast<uint32_t>(m_SignalSemaphores.size());
     SubmitInfo.pSignalSemaphores    = SubmitInfo.signalSemaphoreCount != 0 ? m_VkSignalSemaphores.data() : nullptr;
 
+#if DILIGENT_VK_TIMELINE_SEMAPHORE_SUPPORTED
+    // Values of the timeline semaphores that fences wait for in DeviceWaitForFence().
+    // Values of binary semaphores are ignored (6.4.1), and all signaled semaphores are binary.
+    VkTimelineSemaphoreSubmitInfoKHR TimelineSubmitInfo{};
+    if (m_pDevice->UseTimelineSemaphores() && SubmitInfo.waitSemaphoreCount != 0)
+    {
+        VERIFY_EXPR(m_WaitSemaphoreValues.size() == m_WaitSemaphores.size());
+        TimelineSubmitInfo.sType                   = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR;
+        TimelineSubmitInfo.waitSemaphoreValueCount = SubmitInfo.waitSemaphoreCount;
+        TimelineSubmitInfo.pWaitSemaphoreValues    = m_WaitSemaphoreValues.data();
+        SubmitInfo.pNext                           = &TimelineSubmitInfo;
+    }
+#endif
+
     // Submit command buffer even if there are no commands to release stale resources.
     //if (SubmitInfo.commandBufferCount != 0 || SubmitInfo.waitSemaphoreCount !=0 || SubmitInfo.signalSemaphoreCount != 0)
     auto SubmittedFenceValue = m_pDevice->ExecuteCommandBuffer(m_CommandQueueId, SubmitInfo, this, &m_PendingFences);
@@ -1023,6 +1175,7 @@ void DeviceContextVkImpl::Flush()
     m_SignalSemaphores.clear();
     m_VkWaitSemaphores.clear();
     m_VkSignalSemaphores.clear();
+    m_WaitSemaphoreValues.clear();
     m_PendingFences.clear();
 
     if (vkCmdBuff != VK_NULL_HANDLE)
@@ -1045,6 +1198,9 @@ void DeviceContextVkImpl::SetVertexBuffers(Uint32                         StartS
                                            RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
                                            SET_VERTEX_BUFFERS_FLAGS       Flags)
 {
+    if (!IsGraphicsCommandAllowed("SetVertexBuffers()"))
+        return;
+
     TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags);
     for (Uint32 Buff = 0; Buff < m_NumVertexStreams; ++Buff)
     {
@@ -1064,16 +1220,20 @@ void DeviceContextVkImpl::InvalidateState()
         LOG_WARNING_MESSAGE("Invalidating context that has outstanding commands in it. Call Flush() to submit commands for execution");
 
     TDeviceContextBase::InvalidateState();
-    m_State         = ContextState{};
-    m_vkRenderPass  = VK_NULL_HANDLE;
-    m_vkFramebuffer = VK_NULL_HANDLE;
+    m_State                        = ContextState{};
+    m_vkRenderPass                 = VK_NULL_HANDLE;
+    m_vkFramebuffer                = VK_NULL_HANDLE;
+    m_DynamicRenderingTargetsBound = false;
     m_DescrSetBindInfo.Reset();
-    VERIFY(m_CommandBuffer.GetState().RenderPass == VK_NULL_HANDLE, "Invalidating context with unifinished render pass");
+    VERIFY(!m_CommandBuffer.IsInsideRenderPass(), "Invalidating context with unifinished render pass");
     m_CommandBuffer.Reset();
 }
 
 void DeviceContextVkImpl::SetIndexBuffer(IBuffer* pIndexBuffer, Uint32 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    if (!IsGraphicsCommandAllowed("SetIndexBuffer()"))
+        return;
+
     TDeviceContextBase::SetIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode);
     if (m_pIndexBuffer)
     {
@@ -1132,6 +1292,9 @@ void DeviceContextVkImpl::CommitViewports()
 
 void DeviceContextVkImpl::SetViewports(Uint32 NumViewports, const Viewport* pViewports, Uint32 RTWidth, Uint32 RTHeight)
 {
+    if (!IsGraphicsCommandAllowed("SetViewports()"))
+        return;
+
     TDeviceContextBase::SetViewports(NumViewports, pViewports, RTWidth, RTHeight);
     VERIFY(NumViewports == m_NumViewports, "Unexpected number of viewports");
 
@@ -1161,6 +1324,9 @@ void DeviceContextVkImpl::CommitScissorRects()
 
 void DeviceContextVkImpl::SetScissorRects(Uint32 NumRects, const Rect* pRects, Uint32 RTWidth, Uint32 RTHeight)
 {
+    if (!IsGraphicsCommandAllowed("SetScissorRects()"))
+        return;
+
     TDeviceContextBase::SetScissorRects(NumRects, pRects, RTWidth, RTHeight);
 
     // Only commit scissor rects if scissor test is enabled in the rasterizer state.
@@ -1201,10 +1367,16 @@ void DeviceContextVkImpl::CommitRenderPassAndFramebuffer(bool VerifyStates)
 {
     VERIFY(m_pActiveRenderPass == nullptr, "This method must not be called inside an active render pass.");
 
+    if (m_UseDynamicRendering)
+    {
+        CommitDynamicRendering(VerifyStates);
+        return;
+    }
+
     const auto& CmdBufferState = m_CommandBuffer.GetState();
     if (CmdBufferState.Framebuffer != m_vkFramebuffer)
     {
-        if (CmdBufferState.RenderPass != VK_NULL_HANDLE)
+        if (m_CommandBuffer.IsInsideRenderPass())
             m_CommandBuffer.EndRenderPass();
 
         if (m_vkFramebuffer != VK_NULL_HANDLE)
@@ -1221,11 +1393,79 @@ void DeviceContextVkImpl::CommitRenderPassAndFramebuffer(bool VerifyStates)
     }
 }
 
+void DeviceContextVkImpl::CommitDynamicRendering(bool VerifyStates)
+{
+    // Dynamic rendering is ended whenever bound render targets change, so if it is
+    // active, it always matches the currently bound render targets.
+    if (m_CommandBuffer.GetState().DynamicRendering || !m_DynamicRenderingTargetsBound)
+        return;
+
+#if DILIGENT_VK_DYNAMIC_RENDERING_SUPPORTED
+    if (m_CommandBuffer.IsInsideRenderPass())
+        m_CommandBuffer.EndRenderPass();
+
+#    ifdef DILIGENT_DEVELOPMENT
+    if (VerifyStates)
+    {
+        TransitionRenderTargets(RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+    }
+#    endif
+
+    // Attachments are loaded and stored the same way as by the implicit render pass
+    // (see PipelineStateVkImpl::GetImplicitRenderPassDesc)
+    std::array<VkRenderingAttachmentInfoKHR, MAX_RENDER_TARGETS> ColorAttachments;
+    for (Uint32 rt = 0; rt < m_NumBoundRenderTargets; ++rt)
+    {
+        auto& Attachment = ColorAttachments[rt];
+
+        Attachment       = {};
+        Attachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
+        // If imageView is VK_NULL_HANDLE, writes to the attachment are discarded
+        Attachment.imageView   = m_pBoundRenderTargets[rt] ? m_pBoundRenderTargets[rt]->GetVulkanImageView() : VK_NULL_HANDLE;
+        Attachment.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        Attachment.loadOp      = VK_ATTACHMENT_LOAD_OP_LOAD;
+        Attachment.storeOp     = VK_ATTACHMENT_STORE_OP_STORE;
+    }
+
+    VkRenderingAttachmentInfoKHR DepthStencilAttachment = {};
+    DepthStencilAttachment.sType                        = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
+    DepthStencilAttachment.imageLayout                  = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+    DepthStencilAttachment.loadOp                       = VK_ATTACHMENT_LOAD_OP_LOAD;
+    DepthStencilAttachment.storeOp                      = VK_ATTACHMENT_STORE_OP_STORE;
+
+    VkRenderingInfoKHR RenderingInfo   = {};
+    RenderingInfo.sType                = VK_STRUCTURE_TYPE_RENDERING_INFO_KHR;
+    RenderingInfo.renderArea           = {{0, 0}, {m_FramebufferWidth, m_FramebufferHeight}};
+    RenderingInfo.layerCount           = m_FramebufferSlices;
+    RenderingInfo.colorAttachmentCount = m_NumBoundRenderTargets;
+    RenderingInfo.pColorAttachments    = m_NumBoundRenderTargets > 0 ? ColorAttachments.data() : nullptr;
+    if (m_pBoundDepthStencil)
+    {
+        DepthStencilAttachment.imageView = m_pBoundDepthStencil->GetVulkanImageView();
+        RenderingInfo.pDepthAttachment   = &DepthStencilAttachment;
+
+        // Stencil attachment must be the same view as the depth attachment and must only be
+        // set if the format has a stencil aspect
+        const auto& FmtAttribs = GetTextureFormatAttribs(m_pBoundDepthStencil->GetDesc().Format);
+        if (FmtAttribs.ComponentType == COMPONENT_TYPE_DEPTH_STENCIL)
+            RenderingInfo.pStencilAttachment = &DepthStencilAttachment;
+    }
+
+    m_CommandBuffer.BeginRendering(RenderingInfo);
+#else
+    (void)VerifyStates;
+    UNEXPECTED("Dynamic rendering is not supported");
+#endif
+}
+
 void DeviceContextVkImpl::SetRenderTargets(Uint32                         NumRenderTargets,
                                            ITextureView*                  ppRenderTargets[],
                                            ITextureView*                  pDepthStencil,
                                            RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    if (!IsGraphicsCommandAllowed("SetRenderTargets()"))
+        return;
+
 #ifdef DILIGENT_DEVELOPMENT
     if (m_pActiveRenderPass != nullptr)
     {
@@ -1236,50 +1476,64 @@ void DeviceContextVkImpl::SetRenderTargets(Uint32                         NumRen
 
     if (TDeviceContextBase::SetRenderTargets(NumRenderTargets, ppRenderTargets, pDepthStencil))
     {
-        FramebufferCache::FramebufferCacheKey FBKey;
-        RenderPassCache::RenderPassCacheKey   RenderPassKey;
-        if (m_pBoundDepthStencil)
+        if (m_UseDynamicRendering)
         {
-            auto* pDepthBuffer        = m_pBoundDepthStencil->GetTexture();
-            FBKey.DSV                 = m_pBoundDepthStencil->GetVulkanImageView();
-            RenderPassKey.DSVFormat   = m_pBoundDepthStencil->GetDesc().Format;
-            RenderPassKey.SampleCount = static_cast<Uint8>(pDepthBuffer->GetDesc().SampleCount);
+            // Attachments are referenced directly by the texture views when rendering begins, so there
+            // is no need to look up render pass and framebuffer objects. End the current rendering so that
+            // CommitDynamicRendering() begins a new one with the new attachments.
+            m_vkRenderPass                 = VK_NULL_HANDLE;
+            m_vkFramebuffer                = VK_NULL_HANDLE;
+            m_DynamicRenderingTargetsBound = true;
+            if (m_CommandBuffer.GetVkCmdBuffer() != VK_NULL_HANDLE && m_CommandBuffer.IsInsideRenderPass())
+                m_CommandBuffer.EndRenderPass();
         }
         else
         {
-            FBKey.DSV               = VK_NULL_HANDLE;
-            RenderPassKey.DSVFormat = TEX_FORMAT_UNKNOWN;
-        }
-
-        FBKey.NumRenderTargets         = m_NumBoundRenderTargets;
-        RenderPassKey.NumRenderTargets = static_cast<Uint8>(m_NumBoundRenderTargets);
-
-        for (Uint32 rt = 0; rt < m_NumBoundRenderTargets; ++rt)
-        {
-            if (auto* pRTVVk = m_pBoundRenderTargets[rt].RawPtr())
+            FramebufferCache::FramebufferCacheKey FBKey;
+            RenderPassCache::RenderPassCacheKey   RenderPassKey;
+            if (m_pBoundDepthStencil)
             {
-                auto* pRenderTarget          = pRTVVk->GetTexture();
-                FBKey.RTVs[rt]               = pRTVVk->GetVulkanImageView();
-                RenderPassKey.RTVFormats[rt] = pRenderTarget->GetDesc().Format;
-                if (RenderPassKey.SampleCount == 0)
-                    RenderPassKey.SampleCount = static_cast<Uint8>(pRenderTarget->GetDesc().SampleCount);
-                else
-                    VERIFY(RenderPassKey.SampleCount == pRenderTarget->GetDesc().SampleCount, "Inconsistent sample count");
+                auto* pDepthBuffer        = m_pBoundDepthStencil->GetTexture();
+                FBKey.DSV                 = m_pBoundDepthStencil->GetVulkanImageView();
+                RenderPassKey.DSVFormat   = m_pBoundDepthStencil->GetDesc().Format;
+                RenderPassKey.SampleCount = static_cast<Uint8>(pDepthBuffer->GetDesc().SampleCount);
             }
             else
             {
-                FBKey.RTVs[rt]               = VK_NULL_HANDLE;
-                RenderPassKey.RTVFormats[rt] = TEX_FORMAT_UNKNOWN;
+                FBKey.DSV               = VK_NULL_HANDLE;
+                RenderPassKey.DSVFormat = TEX_FORMAT_UNKNOWN;
             }
-        }
 
-        auto& FBCache = m_pDevice->GetFramebufferCache();
-        auto& RPCache = m_pDevice->GetImplicitRenderPassCache();
+            FBKey.NumRenderTargets         = m_NumBoundRenderTargets;
+            RenderPassKey.NumRenderTargets = static_cast<Uint8>(m_NumBoundRenderTargets);
 
-        m_vkRenderPass         = RPCache.GetRenderPass(RenderPassKey)->GetVkRenderPass();
-        FBKey.Pass             = m_vkRenderPass;
-        FBKey.CommandQueueMask = ~Uint64{0};
-        m_vkFramebuffer        = FBCache.GetFramebuffer(FBKey, m_FramebufferWidth, m_FramebufferHeight, m_FramebufferSlices);
+            for (Uint32 rt = 0; rt < m_NumBoundRenderTargets; ++rt)
+            {
+                if (auto* pRTVVk = m_pBoundRenderTargets[rt].RawPtr())
+                {
+                    auto* pRenderTarget          = pRTVVk->GetTexture();
+                    FBKey.RTVs[rt]               = pRTVVk->GetVulkanImageView();
+                    RenderPassKey.RTVFormats[rt] = pRenderTarget->GetDesc().Format;
+                    if (RenderPassKey.SampleCount == 0)
+                        RenderPassKey.SampleCount = static_cast<Uint8>(pRenderTarget->GetDesc().SampleCount);
+                    else
+                        VERIFY(RenderPassKey.SampleCount == pRenderTarget->GetDesc().SampleCount, "Inconsistent sample count");
+                }
+                else
+                {
+                    FBKey.RTVs[rt]               = VK_NULL_HANDLE;
+                    RenderPassKey.RTVFormats[rt] = TEX_FORMAT_UNKNOWN;
+                }
+            }
+
+            auto& FBCache = m_pDevice->GetFramebufferCache();
+            auto& RPCache = m_pDevice->GetImplicitRenderPassCache();
+
+            m_vkRenderPass         = RPCache.GetRenderPass(RenderPassKey)->GetVkRenderPass();
+            FBKey.Pass             = m_vkRenderPass;
+            FBKey.CommandQueueMask = ~Uint64{0};
+            m_vkFramebuffer        = FBCache.GetFramebuffer(FBKey, m_FramebufferWidth, m_FramebufferHeight, m_FramebufferSlices);
+        }
 
         // Set the viewport to match the render target size
         SetViewports(1, nullptr, 0, 0);
@@ -1295,14 +1549,18 @@ void DeviceContextVkImpl::SetRenderTargets(Uint32                         NumRen
 void DeviceContextVkImpl::ResetRenderTargets()
 {
     TDeviceContextBase::ResetRenderTargets();
-    m_vkRenderPass  = VK_NULL_HANDLE;
-    m_vkFramebuffer = VK_NULL_HANDLE;
-    if (m_CommandBuffer.GetVkCmdBuffer() != VK_NULL_HANDLE && m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE)
+    m_vkRenderPass                 = VK_NULL_HANDLE;
+    m_vkFramebuffer                = VK_NULL_HANDLE;
+    m_DynamicRenderingTargetsBound = false;
+    if (m_CommandBuffer.GetVkCmdBuffer() != VK_NULL_HANDLE && m_CommandBuffer.IsInsideRenderPass())
         m_CommandBuffer.EndRenderPass();
 }
 
 void DeviceContextVkImpl::BeginRenderPass(const BeginRenderPassAttribs& Attribs)
 {
+    if (!IsGraphicsCommandAllowed("BeginRenderPass()"))
+        return;
+
     TDeviceContextBase::BeginRenderPass(Attribs);
 
     VERIFY_EXPR(m_pActiveRenderPass != nullptr);
@@ -1350,6 +1608,9 @@ void DeviceContextVkImpl::BeginRenderPass(const BeginRenderPassAttribs& Attribs)
 
 void DeviceContextVkImpl::NextSubpass()
 {
+    if (!IsGraphicsCommandAllowed("NextSubpass()"))
+        return;
+
     TDeviceContextBase::NextSubpass();
     VERIFY_EXPR(m_CommandBuffer.GetVkCmdBuffer() != VK_NULL_HANDLE && m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE);
     m_CommandBuffer.NextSubpass();
@@ -1357,6 +1618,9 @@ void DeviceContextVkImpl::NextSubpass()
 
 void DeviceContextVkImpl::EndRenderPass()
 {
+    if (!IsGraphicsCommandAllowed("EndRenderPass()"))
+        return;
+
     TDeviceContextBase::EndRenderPass();
     // TDeviceContextBase::EndRenderPass calls ResetRenderTargets() that in turn
     // calls m_CommandBuffer.EndRenderPass()
@@ -1807,8 +2071,11 @@ void DeviceContextVkImpl::UpdateTextureRegion(const void*                    pSr
 
 void DeviceContextVkImpl::GenerateMips(ITextureView* pTexView)
 {
+    if (!IsGraphicsCommandAllowed("GenerateMips()"))
+        return;
+
     TDeviceContextBase::GenerateMips(pTexView);
-    m_GenerateMipsHelper->GenerateMips(*ValidatedCast<TextureViewVkImpl>(pTexView), *this, m_GenerateMipsSRB);
+    m_GenerateMipsHelper->GenerateMips(*ValidatedCast<TextureViewVkImpl>(pTexView), *this, m_GenerateMipsSRB, m_GenerateMipsSPDSRB, m_GenerateMipsSPDCounter);
 }
 
 static VkBufferImageCopy GetBufferImageCopyInfo(Uint32             BufferOffset,
@@ -2077,7 +2344,7 @@ void DeviceContextVkImpl::FinishCommandList(class ICommandList** ppCommandList)
 {
     VERIFY(m_pActiveRenderPass == nullptr, "Finishing command list inside an active render pass.");
 
-    if (m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE)
+    if (m_CommandBuffer.IsInsideRenderPass())
     {
         m_CommandBuffer.EndRenderPass();
     }
@@ -2106,6 +2373,10 @@ void DeviceContextVkImpl::ExecuteCommandList(class ICommandList* pCommandList)
         return;
     }
 
+    // Command buffers of deferred contexts are allocated from the pools of the graphics queue family
+    if (!IsGraphicsCommandAllowed("ExecuteCommandList()"))
+        return;
+
     Flush();
 
     InvalidateState();
@@ -2148,6 +2419,49 @@ void DeviceContextVkImpl::WaitForFence(IFence* pFence, Uint64 Value, bool FlushC
     pFenceVk->Wait(Value);
 }
 
+void DeviceContextVkImpl::DeviceWaitForFence(IFence* pFence, Uint64 Value)
+{
+    VERIFY(!m_bIsDeferred, "Fence can only be waited from immediate context");
+    DEV_CHECK_ERR(pFence != nullptr, "Fence must not be null");
+
+    // Commands recorded before this call must not wait for the fence
+    Flush();
+
+    // Without compute contexts, all fences are signaled by the graphics queue that executes commands in order
+    if (m_pDevice->GetComputeQueueMask() == 0)
+        return;
+
+    auto* pFenceVk = ValidatedCast<FenceVkImpl>(pFence);
+    // There is nothing to wait for if the value has already been reached
+    if (pFenceVk->GetCompletedValue() >= Value)
+        return;
+
+    auto pSemaphore = pFenceVk->GetSemaphoreToWait(Value);
+    if (!pSemaphore)
+    {
+        // Binary semaphore is created when the signaling context is flushed, and can only be waited for once
+        LOG_WARNING_MESSAGE("There is no semaphore for value ", Value, " of fence '", pFenceVk->GetDesc().Name,
+                            "' that the GPU can wait for. Make sure that the context that signals the fence has been flushed, "
+                            "and that every value is waited for once. Waiting for the fence on the CPU.");
+        pFenceVk->Wait(Value);
+        return;
+    }
+
+    // The wait is performed before any commands of the next submission
+    AddWaitSemaphore(pSemaphore, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, Value);
+}
+
+bool DeviceContextVkImpl::IsGraphicsCommandAllowed(const char* Command) const
+{
+    if (m_IsComputeOnly)
+    {
+        LOG_ERROR_MESSAGE(Command, " is not allowed in compute context #", m_ContextId,
+                          ". Compute contexts can only execute compute, ray tracing and copy commands.");
+        return false;
+    }
+    return true;
+}
+
 void DeviceContextVkImpl::WaitForIdle()
 {
     VERIFY(!m_bIsDeferred, "Only immediate contexts can be idled");
@@ -2165,6 +2479,11 @@ void DeviceContextVkImpl::BeginQuery(IQuery* pQuery)
     auto       vkQueryPool  = m_QueryMgr->GetQueryPool(QueryType);
     auto       Idx          = pQueryVkImpl->GetQueryPoolIndex(0);
 
+    // Occlusion and pipeline statistics queries require a queue that supports graphics operations
+    if ((QueryType == QUERY_TYPE_OCCLUSION || QueryType == QUERY_TYPE_BINARY_OCCLUSION || QueryType == QUERY_TYPE_PIPELINE_STATISTICS) &&
+        !IsGraphicsCommandAllowed("Beginning occlusion or pipeline statistics query"))
+        return;
+
     EnsureVkCmdBuffer();
     if (QueryType == QUERY_TYPE_TIMESTAMP)
     {
@@ -2225,12 +2544,12 @@ void DeviceContextVkImpl::EndQuery(IQuery* pQuery)
                "No query flag is set which indicates there was no matching BeginQuery call or there was an error while beginning the query.");
         if (CmdBuffState.OutsidePassQueries & (1 << QueryType))
         {
-            if (m_CommandBuffer.GetState().RenderPass)
+            if (m_CommandBuffer.IsInsideRenderPass())
                 m_CommandBuffer.EndRenderPass();
         }
         else
         {
-            if (!m_CommandBuffer.GetState().RenderPass)
+            if (!m_CommandBuffer.IsInsideRenderPass())
                 LOG_ERROR_MESSAGE("The query was started inside render pass, but is being ended oustside of render pass. "
                                   "Vulkan requires that a query must either begin and end inside the same "
                                   "subpass of a render pass instance, or must both begin and end outside of a render pass "
@@ -2254,7 +2573,7 @@ void DeviceContextVkImpl::TransitionImageLayout(ITexture* pTexture, VkImageLayou
         return;
     }
     auto NewState = VkImageLayoutToResourceState(NewLayout);
-    if (!pTextureVk->CheckState(NewState))
+    if (!pTextureVk->CheckState(NewState) || (pTextureVk->IsTransient() && pTextureVk->IsTransientMemoryOverwritten()))
     {
         TransitionTextureState(*pTextureVk, RESOURCE_STATE_UNKNOWN, NewState, true);
     }
@@ -2305,6 +2624,14 @@ void DeviceContextVkImpl::TransitionTextureState(TextureVkImpl&           Textur
         }
     }
 
+    if (m_IsComputeOnly && ((OldState | NewState) & GraphicsOnlyResourceStates) != 0)
+    {
+        LOG_ERROR_MESSAGE("Failed to transition the state of texture '", TextureVk.GetDesc().Name, "' from ", GetResourceStateString(OldState),
+                          " to ", GetResourceStateString(NewState), " because compute contexts do not support graphics resource states."
+                          " Transition the texture in a graphics context.");
+        return;
+    }
+
     EnsureVkCmdBuffer();
 
     auto vkImg = TextureVk.GetVkImage();
@@ -2338,6 +2665,54 @@ void DeviceContextVkImpl::TransitionTextureState(TextureVkImpl&           Textur
             pSubresRange->aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
     }
 
+    if (TextureVk.IsTransient() && (OldState == RESOURCE_STATE_UNDEFINED || TextureVk.IsTransientMemoryOverwritten()))
+    {
+        // The texture shares memory with other transient resources that may have been used
+        // since the texture was last accessed. Previous contents are discarded, and the barrier
+        // makes sure all writes to the memory by the aliased resources are complete.
+        // The memory is acquired by the entire texture, so the barrier must cover all subresources,
+        // not only the ones being transitioned.
+        const auto& TexDesc = TextureVk.GetDesc();
+
+        VkImageSubresourceRange AliasingRange;
+        AliasingRange.aspectMask     = pSubresRange->aspectMask;
+        AliasingRange.baseArrayLayer = 0;
+        AliasingRange.layerCount     = VK_REMAINING_ARRAY_LAYERS;
+        AliasingRange.baseMipLevel   = 0;
+        AliasingRange.levelCount     = VK_REMAINING_MIP_LEVELS;
+
+        const auto ArraySize   = TexDesc.Type == RESOURCE_DIM_TEX_3D ? 1 : TexDesc.ArraySize;
+        const bool IsFullRange =
+            pSubresRange->baseMipLevel == 0 && (pSubresRange->levelCount == VK_REMAINING_MIP_LEVELS || pSubresRange->levelCount >= TexDesc.MipLevels) &&
+            pSubresRange->baseArrayLayer == 0 && (pSubresRange->layerCount == VK_REMAINING_ARRAY_LAYERS || pSubresRange->layerCount >= ArraySize);
+
+        auto OldLayout = ResourceStateToVkImageLayout(OldState);
+        auto NewLayout = ResourceStateToVkImageLayout(NewState);
+        if (IsFullRange || OldLayout == VK_IMAGE_LAYOUT_UNDEFINED)
+        {
+            // When only a part of the texture is transitioned, the other subresources may be used by any
+            // stage later, so all of them must wait for the barrier. Their contents are undefined and they
+            // will be transitioned from the undefined layout, which is valid for any current layout.
+            VkPipelineStageFlags NewStages = IsFullRange ?
+                ResourceStateFlagsToVkPipelineStageFlags(NewState, m_CommandBuffer.GetEnabledShaderStages()) :
+                VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+            m_CommandBuffer.AliasingImageBarrier(vkImg, NewLayout, AliasingRange, NewStages);
+            TextureVk.AcquireTransientMemory();
+            if (UpdateTextureState)
+            {
+                TextureVk.SetState(NewState);
+                VERIFY_EXPR(TextureVk.GetLayout() == NewLayout);
+            }
+            return;
+        }
+
+        // Only a part of the texture is transitioned. Move all subresources to the layout described by the
+        // old state, so that the subresources that are not transitioned still match the texture state,
+        // and transition the requested subresources below.
+        m_CommandBuffer.AliasingImageBarrier(vkImg, OldLayout, AliasingRange, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+        TextureVk.AcquireTransientMemory();
+    }
+
     // Always add barrier after writes.
     const bool AfterWrite = ResourceStateHasWriteAccess(OldState);
 
@@ -2438,6 +2813,14 @@ void DeviceContextVkImpl::TransitionBufferState(BufferVkImpl& BufferVk, RESOURCE
 
     if (((OldState & NewState) != NewState) || AfterWrite)
     {
+        if (m_IsComputeOnly && ((OldState | NewState) & GraphicsOnlyResourceStates) != 0)
+        {
+            LOG_ERROR_MESSAGE("Failed to transition the state of buffer '", BufferVk.GetDesc().Name, "' from ", GetResourceStateString(OldState),
+                              " to ", GetResourceStateString(NewState), " because compute contexts do not support graphics resource states."
+                              " Transition the buffer in a graphics context.");
+            return;
+        }
+
         DEV_CHECK_ERR(BufferVk.m_VulkanBuffer != VK_NULL_HANDLE, "Cannot transition suballocated buffer");
         VERIFY_EXPR(BufferVk.GetDynamicOffset(m_ContextId, this) == 0);
 
@@ -2682,6 +3065,9 @@ void DeviceContextVkImpl::ResolveTextureSubresource(ITexture*
                                                     ITexture*                               pDstTexture,
                                                     const ResolveTextureSubresourceAttribs& ResolveAttribs)
 {
+    if (!IsGraphicsCommandAllowed("ResolveTextureSubresource()"))
+        return;
+
     TDeviceContextBase::ResolveTextureSubresource(pSrcTexture, pDstTexture, ResolveAttribs);
 
     auto*       pSrcTexVk  = ValidatedCast<TextureVkImpl>(pSrcTexture);
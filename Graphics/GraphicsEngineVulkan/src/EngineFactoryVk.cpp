@@ -133,7 +133,7 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& _E
     SetRawAllocator(EngineCI.pRawMemAllocator);
 
     *ppDevice = nullptr;
-    memset(ppContexts, 0, sizeof(*ppContexts) * (1 + EngineCI.NumDeferredContexts));
+    memset(ppContexts, 0, sizeof(*ppContexts) * (1 + EngineCI.NumDeferredContexts + EngineCI.NumComputeContexts));
 
     try
     {
@@ -156,17 +156,86 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& _E
         // at least one queue family of at least one physical device exposed by the implementation
         // must support both graphics and compute operations.
 
-        VkDeviceQueueCreateInfo QueueInfo{};
-        QueueInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
-        QueueInfo.flags = 0; // reserved for future use
-        // All commands that are allowed on a queue that supports transfer operations are also allowed on a
-        // queue that supports either graphics or compute operations. Thus, if the capabilities of a queue family
-        // include VK_QUEUE_GRAPHICS_BIT or VK_QUEUE_COMPUTE_BIT, then reporting the VK_QUEUE_TRANSFER_BIT
-        // capability separately for that queue family is optional (4.1).
-        QueueInfo.queueFamilyIndex       = PhysicalDevice->FindQueueFamily(VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT);
-        QueueInfo.queueCount             = 1;
         const float defaultQueuePriority = 1.0f; // Ask for highest priority for our queue. (range [0,1])
-        QueueInfo.pQueuePriorities       = &defaultQueuePriority;
+
+        std::vector<VkDeviceQueueCreateInfo> QueueInfos;
+
+        // Command queues in the order they are passed to the render device. Queue 0 is always the graphics queue,
+        // followed by the queues of compute contexts and the transfer queue.
+        struct CommandQueueInfo
+        {
+            uint32_t    FamilyIndex;
+            uint32_t    QueueIndex; // Index of the queue within the family
+            const char* FenceName;
+        };
+        std::vector<CommandQueueInfo> CmdQueueInfos;
+
+        {
+            VkDeviceQueueCreateInfo QueueInfo{};
+            QueueInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+            QueueInfo.flags = 0; // reserved for future use
+            // All commands that are allowed on a queue that supports transfer operations are also allowed on a
+            // queue that supports either graphics or compute operations. Thus, if the capabilities of a queue family
+            // include VK_QUEUE_GRAPHICS_BIT or VK_QUEUE_COMPUTE_BIT, then reporting the VK_QUEUE_TRANSFER_BIT
+            // capability separately for that queue family is optional (4.1).
+            QueueInfo.queueFamilyIndex = PhysicalDevice->FindQueueFamily(VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT);
+            QueueInfo.queueCount       = 1;
+            QueueInfo.pQueuePriorities = &defaultQueuePriority;
+            QueueInfos.push_back(QueueInfo);
+            CmdQueueInfos.push_back({QueueInfo.queueFamilyIndex, 0, "Command queue internal fence"});
+        }
+
+        // Every compute context submits commands to its own queue from a compute-only family. Such queues
+        // are usually executed by the asynchronous compute engines and run concurrently with the graphics queue.
+        std::vector<float> ComputeQueuePriorities;
+        if (EngineCI.NumComputeContexts > 0)
+        {
+            const auto ComputeQueueFamilyIndex = PhysicalDevice->FindDedicatedComputeQueueFamily();
+            if (ComputeQueueFamilyIndex != VulkanUtilities::VulkanPhysicalDevice::InvalidQueueFamilyIndex)
+            {
+                const auto FamilyQueueCount = PhysicalDevice->GetQueueFamilyProperties(ComputeQueueFamilyIndex).queueCount;
+                const auto NumComputeQueues = std::min(EngineCI.NumComputeContexts, FamilyQueueCount);
+                if (NumComputeQueues < EngineCI.NumComputeContexts)
+                {
+                    LOG_WARNING_MESSAGE("The compute queue family only has ", FamilyQueueCount, (FamilyQueueCount > 1 ? " queues" : " queue"),
+                                        ", so only ", NumComputeQueues, " of ", EngineCI.NumComputeContexts, " compute contexts will be created");
+                }
+                ComputeQueuePriorities.resize(NumComputeQueues, defaultQueuePriority);
+
+                VkDeviceQueueCreateInfo ComputeQueueInfo{};
+                ComputeQueueInfo.sType            = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+                ComputeQueueInfo.flags            = 0;
+                ComputeQueueInfo.queueFamilyIndex = ComputeQueueFamilyIndex;
+                ComputeQueueInfo.queueCount       = NumComputeQueues;
+                ComputeQueueInfo.pQueuePriorities = ComputeQueuePriorities.data();
+                QueueInfos.push_back(ComputeQueueInfo);
+                for (uint32_t q = 0; q < NumComputeQueues; ++q)
+                    CmdQueueInfos.push_back({ComputeQueueFamilyIndex, q, "Compute queue internal fence"});
+            }
+            else
+            {
+                LOG_WARNING_MESSAGE("The device does not have a compute-only queue family, so compute contexts will not be created");
+            }
+        }
+
+        // Resource uploads are executed on a queue from a dedicated transfer family, if there is one.
+        // Such queues are usually backed by the copy engines and run concurrently with the graphics queue.
+        // Uploaded resources are only acquired by the graphics queue, so the transfer queue is not used
+        // when there are compute contexts.
+        uint32_t TransferQueueFamilyIndex = VulkanUtilities::VulkanPhysicalDevice::InvalidQueueFamilyIndex;
+        if (EngineCI.EnableTransferQueue && ComputeQueuePriorities.empty())
+            TransferQueueFamilyIndex = PhysicalDevice->FindDedicatedTransferQueueFamily();
+        if (TransferQueueFamilyIndex != VulkanUtilities::VulkanPhysicalDevice::InvalidQueueFamilyIndex)
+        {
+            VkDeviceQueueCreateInfo TransferQueueInfo{};
+            TransferQueueInfo.sType            = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+            TransferQueueInfo.flags            = 0;
+            TransferQueueInfo.queueFamilyIndex = TransferQueueFamilyIndex;
+            TransferQueueInfo.queueCount       = 1;
+            TransferQueueInfo.pQueuePriorities = &defaultQueuePriority;
+            QueueInfos.push_back(TransferQueueInfo);
+            CmdQueueInfos.push_back({TransferQueueFamilyIndex, 0, "Transfer queue internal fence"});
+        }
 
         VkDeviceCreateInfo DeviceCreateInfo = {};
         DeviceCreateInfo.sType              = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
@@ -174,10 +243,11 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& _E
         // https://www.khronos.org/registry/vulkan/specs/1.0/html/vkspec.html#extended-functionality-device-layer-deprecation
         DeviceCreateInfo.enabledLayerCount       = 0;       // Deprecated and ignored.
         DeviceCreateInfo.ppEnabledLayerNames     = nullptr; // Deprecated and ignored
-        DeviceCreateInfo.queueCreateInfoCount    = 1;
-        DeviceCreateInfo.pQueueCreateInfos       = &QueueInfo;
+        DeviceCreateInfo.queueCreateInfoCount    = static_cast<uint32_t>(QueueInfos.size());
+        DeviceCreateInfo.pQueueCreateInfos       = QueueInfos.data();
         VkPhysicalDeviceFeatures EnabledFeatures = {};
         EnabledFeatures.fullDrawIndexUint32      = PhysicalDeviceFeatures.fullDrawIndexUint32;
+        EnabledFeatures.multiDrawIndirect        = PhysicalDeviceFeatures.multiDrawIndirect;
 
         auto GetFeatureState = [](DEVICE_FEATURE_STATE RequestedState, bool IsFeatureSupported, const char* FeatureName) //
         {
@@ -279,6 +349,12 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& _E
         // clang-format on
 
         ENABLE_FEATURE(DeviceExtFeatures.AccelStruct.accelerationStructure != VK_FALSE && DeviceExtFeatures.RayTracingPipeline.rayTracingPipeline != VK_FALSE, RayTracing, "Ray tracing is");
+
+#if DILIGENT_VK_DRAW_INDIRECT_COUNT_SUPPORTED
+        ENABLE_FEATURE(DeviceExtFeatures.DrawIndirectCount, DrawIndirectCounterBuffer, "Indirect draw counter buffer is");
+#else
+        ENABLE_FEATURE(false, DrawIndirectCounterBuffer, "Indirect draw counter buffer is");
+#endif
 #undef FeatureSupport
 
 
@@ -447,12 +523,123 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& _E
                 NextExt  = &EnabledExtFeats.BufferDeviceAddress.pNext;
             }
 
+            // Descriptor indexing for runtime-sized resource arrays
+            if (EngineCI.EnableDescriptorIndexing && VulkanUtilities::VulkanPhysicalDevice::SupportsUpdateAfterBindArrays(DeviceExtFeatures.DescriptorIndexing))
+            {
+                VERIFY(PhysicalDevice->IsExtensionSupported(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME),
+                       "VK_EXT_descriptor_indexing extension must be supported as it has already been checked by VulkanPhysicalDevice");
+
+                // Ray tracing has already enabled the extension together with all supported descriptor indexing features
+                if (EngineCI.Features.RayTracing == DEVICE_FEATURE_STATE_DISABLED)
+                {
+                    DeviceExtensions.push_back(VK_KHR_MAINTENANCE3_EXTENSION_NAME); // required for VK_EXT_descriptor_indexing
+                    DeviceExtensions.push_back(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+
+                    auto& DescrIndexing = EnabledExtFeats.DescriptorIndexing;
+
+                    DescrIndexing       = {};
+                    DescrIndexing.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+
+                    DescrIndexing.runtimeDescriptorArray                             = VK_TRUE;
+                    DescrIndexing.descriptorBindingPartiallyBound                    = VK_TRUE;
+                    DescrIndexing.descriptorBindingUpdateUnusedWhilePending          = VK_TRUE;
+                    DescrIndexing.descriptorBindingSampledImageUpdateAfterBind       = VK_TRUE;
+                    DescrIndexing.descriptorBindingStorageImageUpdateAfterBind       = VK_TRUE;
+                    DescrIndexing.descriptorBindingUniformTexelBufferUpdateAfterBind = VK_TRUE;
+                    DescrIndexing.descriptorBindingStorageTexelBufferUpdateAfterBind = VK_TRUE;
+                    // Allow shaders to index the arrays with non-uniform indices, e.g. per-instance material indices
+                    DescrIndexing.shaderSampledImageArrayNonUniformIndexing       = DeviceExtFeatures.DescriptorIndexing.shaderSampledImageArrayNonUniformIndexing;
+                    DescrIndexing.shaderStorageImageArrayNonUniformIndexing       = DeviceExtFeatures.DescriptorIndexing.shaderStorageImageArrayNonUniformIndexing;
+                    DescrIndexing.shaderUniformTexelBufferArrayNonUniformIndexing = DeviceExtFeatures.DescriptorIndexing.shaderUniformTexelBufferArrayNonUniformIndexing;
+                    DescrIndexing.shaderStorageTexelBufferArrayNonUniformIndexing = DeviceExtFeatures.DescriptorIndexing.shaderStorageTexelBufferArrayNonUniformIndexing;
+
+                    *NextExt = &DescrIndexing;
+                    NextExt  = &DescrIndexing.pNext;
+                }
+            }
+
+#if DILIGENT_VK_DYNAMIC_RENDERING_SUPPORTED
+            // Dynamic rendering
+            if (EngineCI.EnableDynamicRendering && DeviceExtFeatures.DynamicRendering.dynamicRendering != VK_FALSE)
+            {
+                VERIFY(PhysicalDevice->IsExtensionSupported(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME),
+                       "VK_KHR_dynamic_rendering extension must be supported as it has already been checked by VulkanPhysicalDevice "
+                       "and dynamicRendering feature is TRUE");
+
+                // VK_KHR_dynamic_rendering requires VK_KHR_depth_stencil_resolve that in turn requires VK_KHR_create_renderpass2,
+                // VK_KHR_multiview and VK_KHR_maintenance2. These extensions were added to Vulkan 1.2 core.
+                if (PhysicalDevice->GetProperties().apiVersion < VK_API_VERSION_1_2)
+                {
+                    DeviceExtensions.push_back(VK_KHR_MULTIVIEW_EXTENSION_NAME);
+                    DeviceExtensions.push_back(VK_KHR_MAINTENANCE2_EXTENSION_NAME);
+                    DeviceExtensions.push_back(VK_KHR_CREATE_RENDERPASS_2_EXTENSION_NAME);
+                    DeviceExtensions.push_back(VK_KHR_DEPTH_STENCIL_RESOLVE_EXTENSION_NAME);
+                }
+                DeviceExtensions.push_back(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME);
+
+                EnabledExtFeats.DynamicRendering = DeviceExtFeatures.DynamicRendering;
+
+                *NextExt = &EnabledExtFeats.DynamicRendering;
+                NextExt  = &EnabledExtFeats.DynamicRendering.pNext;
+            }
+#endif
+
+#if DILIGENT_VK_PUSH_DESCRIPTOR_SUPPORTED
+            // Push descriptors
+            if (EngineCI.EnablePushDescriptors && DeviceExtFeatures.PushDescriptor)
+            {
+                VERIFY(PhysicalDevice->IsExtensionSupported(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME),
+                       "VK_KHR_push_descriptor extension must be supported as it has already been checked by VulkanPhysicalDevice");
+                DeviceExtensions.push_back(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME);
+                // There is no feature struct to chain, the flag only records that the extension is enabled
+                EnabledExtFeats.PushDescriptor = true;
+            }
+#endif
+
+#if DILIGENT_VK_TIMELINE_SEMAPHORE_SUPPORTED
+            // Timeline semaphores are only needed to synchronize queues on the GPU.
+            if (!ComputeQueuePriorities.empty() && DeviceExtFeatures.TimelineSemaphore.timelineSemaphore != VK_FALSE)
+            {
+                VERIFY(PhysicalDevice->IsExtensionSupported(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME),
+                       "VK_KHR_timeline_semaphore extension must be supported as it has already been checked by VulkanPhysicalDevice");
+                DeviceExtensions.push_back(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME);
+
+                EnabledExtFeats.TimelineSemaphore                   = DeviceExtFeatures.TimelineSemaphore;
+                EnabledExtFeats.TimelineSemaphore.timelineSemaphore = VK_TRUE;
+
+                *NextExt = &EnabledExtFeats.TimelineSemaphore;
+                NextExt  = &EnabledExtFeats.TimelineSemaphore.pNext;
+            }
+#endif
+
             // make sure that last pNext is null
             *NextExt = nullptr;
         }
 
+#if DILIGENT_VK_DRAW_INDIRECT_COUNT_SUPPORTED
+        // Indirect draw counter buffer
+        if (EngineCI.Features.DrawIndirectCounterBuffer == DEVICE_FEATURE_STATE_ENABLED)
+        {
+            VERIFY(PhysicalDevice->IsExtensionSupported(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME),
+                   "VK_KHR_draw_indirect_count extension must be supported as it has already been checked by VulkanPhysicalDevice");
+            DeviceExtensions.push_back(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+            EnabledExtFeats.DrawIndirectCount = true;
+        }
+#endif
+
+#if DILIGENT_VK_MEMORY_BUDGET_SUPPORTED
+        // Memory budget
+        if (DeviceExtFeatures.MemoryBudget)
+        {
+            VERIFY(PhysicalDevice->IsExtensionSupported(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME),
+                   "VK_EXT_memory_budget extension must be supported as it has already been checked by VulkanPhysicalDevice");
+            DeviceExtensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+            EnabledExtFeats.MemoryBudget = true;
+        }
+#endif
+
 #if defined(_MSC_VER) && defined(_WIN64)
-        static_assert(sizeof(DeviceFeatures) == 32, "Did you add a new feature to DeviceFeatures? Please handle its satus here.");
+        static_assert(sizeof(DeviceFeatures) == 33, "Did you add a new feature to DeviceFeatures? Please handle its satus here.");
 #endif
 
         DeviceCreateInfo.ppEnabledExtensionNames = DeviceExtensions.empty() ? nullptr : DeviceExtensions.data();
@@ -463,22 +650,29 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& _E
 
         auto& RawMemAllocator = GetRawAllocator();
 
-        RefCntAutoPtr<CommandQueueVkImpl> pCmdQueueVk{
-            NEW_RC_OBJ(RawMemAllocator, "CommandQueueVk instance", CommandQueueVkImpl)(LogicalDevice, QueueInfo.queueFamilyIndex)};
+        std::vector<RefCntAutoPtr<CommandQueueVkImpl>> pCmdQueuesVk(CmdQueueInfos.size());
+        std::vector<ICommandQueueVk*>                  CommandQueues(CmdQueueInfos.size());
+        for (size_t q = 0; q < CmdQueueInfos.size(); ++q)
+        {
+            pCmdQueuesVk[q]  = NEW_RC_OBJ(RawMemAllocator, "CommandQueueVk instance", CommandQueueVkImpl)(LogicalDevice, CmdQueueInfos[q].FamilyIndex, CmdQueueInfos[q].QueueIndex);
+            CommandQueues[q] = pCmdQueuesVk[q];
+        }
 
         OnRenderDeviceCreated = [&](RenderDeviceVkImpl* pRenderDeviceVk) //
         {
-            FenceDesc Desc;
-            Desc.Name = "Command queue internal fence";
-            // Render device owns command queue that in turn owns the fence, so it is an internal device object
-            constexpr bool IsDeviceInternal = true;
-
-            RefCntAutoPtr<FenceVkImpl> pFenceVk{
-                NEW_RC_OBJ(RawMemAllocator, "FenceVkImpl instance", FenceVkImpl)(pRenderDeviceVk, Desc, IsDeviceInternal)};
-            pCmdQueueVk->SetFence(std::move(pFenceVk));
+            for (size_t q = 0; q < CmdQueueInfos.size(); ++q)
+            {
+                FenceDesc Desc;
+                Desc.Name = CmdQueueInfos[q].FenceName;
+                // Render device owns command queue that in turn owns the fence, so it is an internal device object
+                constexpr bool IsDeviceInternal = true;
+
+                RefCntAutoPtr<FenceVkImpl> pFenceVk{
+                    NEW_RC_OBJ(RawMemAllocator, "FenceVkImpl instance", FenceVkImpl)(pRenderDeviceVk, Desc, IsDeviceInternal)};
+                pCmdQueuesVk[q]->SetFence(std::move(pFenceVk));
+            }
         };
 
-        std::array<ICommandQueueVk*, 1> CommandQueues = {{pCmdQueueVk}};
         AttachToVulkanDevice(Instance, std::move(PhysicalDevice), LogicalDevice, CommandQueues.size(), CommandQueues.data(), EngineCI, ppDevice, ppContexts);
     }
     catch (std::runtime_error&)
@@ -499,7 +693,10 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& _E
 /// \param [out] ppContexts - Address of the memory location where pointers to
 ///                           the contexts will be written. Immediate context goes at
 ///                           position 0. If EngineCI.NumDeferredContexts > 0,
-///                           pointers to the deferred contexts are written afterwards.
+///                           pointers to the deferred contexts are written afterwards,
+///                           followed by EngineCI.NumComputeContexts compute contexts.
+///                           Compute contexts are only created for the command queues
+///                           from compute-only families, the remaining pointers are null.
 void EngineFactoryVkImpl::AttachToVulkanDevice(std::shared_ptr<VulkanUtilities::VulkanInstance>       Instance,
                                                std::unique_ptr<VulkanUtilities::VulkanPhysicalDevice> PhysicalDevice,
                                                std::shared_ptr<VulkanUtilities::VulkanLogicalDevice>  LogicalDevice,
@@ -523,7 +720,7 @@ void EngineFactoryVkImpl::AttachToVulkanDevice(std::shared_ptr<VulkanUtilities::
         return;
 
     *ppDevice = nullptr;
-    memset(ppContexts, 0, sizeof(*ppContexts) * (1 + EngineCI.NumDeferredContexts));
+    memset(ppContexts, 0, sizeof(*ppContexts) * (1 + EngineCI.NumDeferredContexts + EngineCI.NumComputeContexts));
 
     try
     {
@@ -551,6 +748,22 @@ void EngineFactoryVkImpl::AttachToVulkanDevice(std::shared_ptr<VulkanUtilities::
             pDeferredCtxVk->QueryInterface(IID_DeviceContext, reinterpret_cast<IObject**>(ppContexts + 1 + DeferredCtx));
             pRenderDeviceVk->SetDeferredContext(DeferredCtx, pDeferredCtxVk);
         }
+
+        // Every command queue from a compute-only family is used by its own compute context.
+        Uint32 ComputeCtx = 0;
+        for (Uint32 q = 1; q < CommandQueueCount && ComputeCtx < EngineCI.NumComputeContexts; ++q)
+        {
+            const auto& FamilyProps = pRenderDeviceVk->GetPhysicalDevice().GetQueueFamilyProperties(ppCommandQueues[q]->GetQueueFamilyIndex());
+            if ((FamilyProps.queueFlags & VK_QUEUE_COMPUTE_BIT) == 0 || (FamilyProps.queueFlags & VK_QUEUE_GRAPHICS_BIT) != 0)
+                continue;
+
+            const Uint32 ContextId = 1 + EngineCI.NumDeferredContexts + ComputeCtx;
+
+            RefCntAutoPtr<DeviceContextVkImpl> pComputeCtxVk(NEW_RC_OBJ(RawMemAllocator, "DeviceContextVkImpl instance", DeviceContextVkImpl)(pRenderDeviceVk, false, EngineCI, ContextId, q, GenerateMipsHelper));
+            // Compute contexts are owned by the application only
+            pComputeCtxVk->QueryInterface(IID_DeviceContext, reinterpret_cast<IObject**>(ppContexts + ContextId));
+            ++ComputeCtx;
+        }
     }
     catch (const std::runtime_error&)
     {
@@ -559,7 +772,7 @@ void EngineFactoryVkImpl::AttachToVulkanDevice(std::shared_ptr<VulkanUtilities::
             (*ppDevice)->Release();
             *ppDevice = nullptr;
         }
-        for (Uint32 ctx = 0; ctx < 1 + EngineCI.NumDeferredContexts; ++ctx)
+        for (Uint32 ctx = 0; ctx < 1 + EngineCI.NumDeferredContexts + EngineCI.NumComputeContexts; ++ctx)
         {
             if (ppContexts[ctx] != nullptr)
             {
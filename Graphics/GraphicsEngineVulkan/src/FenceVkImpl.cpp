@@ -49,6 +49,25 @@ FenceVkImpl::FenceVkImpl(IReferenceCounters* pRefCounters,
     m_FencePool{pRendeDeviceVkImpl->GetLogicalDevice().GetSharedPtr()}
 // clang-format on
 {
+#if DILIGENT_VK_TIMELINE_SEMAPHORE_SUPPORTED
+    // Internal fences are owned by the render device and are never waited for by other queues.
+    // Besides, the semaphore would keep a strong reference to the device.
+    if (pRendeDeviceVkImpl->UseTimelineSemaphores() && !IsDeviceInternal)
+    {
+        VkSemaphoreTypeCreateInfoKHR SemaphoreTypeCI{};
+        SemaphoreTypeCI.sType         = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO_KHR;
+        SemaphoreTypeCI.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE_KHR;
+        SemaphoreTypeCI.initialValue  = 0;
+
+        VkSemaphoreCreateInfo SemaphoreCI{};
+        SemaphoreCI.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        SemaphoreCI.pNext = &SemaphoreTypeCI;
+        SemaphoreCI.flags = 0; // reserved for future use
+
+        auto Semaphore = pRendeDeviceVkImpl->GetLogicalDevice().CreateSemaphore(SemaphoreCI, "Fence timeline semaphore");
+        ManagedSemaphore::Create(pRendeDeviceVkImpl, std::move(Semaphore), "Fence timeline semaphore", &m_TimelineSemaphore);
+    }
+#endif
 }
 
 FenceVkImpl::~FenceVkImpl()
@@ -66,6 +85,8 @@ FenceVkImpl::~FenceVkImpl()
 
 Uint64 FenceVkImpl::GetCompletedValue()
 {
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
     const auto& LogicalDevice = m_pDevice->GetLogicalDevice();
     while (!m_PendingFences.empty())
     {
@@ -90,14 +111,36 @@ Uint64 FenceVkImpl::GetCompletedValue()
 
 void FenceVkImpl::Reset(Uint64 Value)
 {
+    // Semaphores are released outside of the lock
+    std::vector<RefCntAutoPtr<ManagedSemaphore>> StaleSemaphores;
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
     DEV_CHECK_ERR(Value >= m_LastCompletedFenceValue, "Resetting fence '", m_Desc.Name, "' to the value (", Value, ") that is smaller than the last completed value (", m_LastCompletedFenceValue, ")");
     if (Value > m_LastCompletedFenceValue)
         m_LastCompletedFenceValue = Value;
+
+#if DILIGENT_VK_TIMELINE_SEMAPHORE_SUPPORTED
+    // Command queues that wait for the timeline semaphore must see the new value
+    if (m_TimelineSemaphore && Value > m_LastSignaledValue)
+    {
+        VkSemaphoreSignalInfoKHR SignalInfo{};
+        SignalInfo.sType     = VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO_KHR;
+        SignalInfo.semaphore = m_TimelineSemaphore->Get();
+        SignalInfo.value     = Value;
+        m_pDevice->GetLogicalDevice().SignalSemaphore(SignalInfo);
+        m_LastSignaledValue = Value;
+    }
+#endif
+
+    PopCompletedSemaphores(StaleSemaphores);
 }
 
 
 void FenceVkImpl::Wait(Uint64 Value)
 {
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
     const auto& LogicalDevice = m_pDevice->GetLogicalDevice();
     while (!m_PendingFences.empty())
     {
@@ -123,4 +166,97 @@ void FenceVkImpl::Wait(Uint64 Value)
     }
 }
 
+RefCntAutoPtr<ManagedSemaphore> FenceVkImpl::GetSemaphoreToSignal(Uint64 Value)
+{
+    if (m_TimelineSemaphore)
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        // Timeline semaphore value must strictly increase with every signal operation
+        if (Value <= m_LastSignaledValue)
+        {
+            LOG_WARNING_MESSAGE("Fence '", m_Desc.Name, "' is signaled with value ", Value, " that is not greater than the previously signaled value ",
+                                m_LastSignaledValue, ". Command queues will not be able to wait for this value on the GPU.");
+            return {};
+        }
+        m_LastSignaledValue = Value;
+        return m_TimelineSemaphore;
+    }
+
+    // Only compute contexts wait for fences signaled by other queues
+    if (m_pDevice->GetComputeQueueMask() == 0)
+        return {};
+
+    VkSemaphoreCreateInfo SemaphoreCI{};
+    SemaphoreCI.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    SemaphoreCI.pNext = nullptr;
+    SemaphoreCI.flags = 0; // reserved for future use
+
+    auto Semaphore = m_pDevice->GetLogicalDevice().CreateSemaphore(SemaphoreCI, "Fence semaphore");
+
+    RefCntAutoPtr<ManagedSemaphore> pSemaphore;
+    ManagedSemaphore::Create(m_pDevice, std::move(Semaphore), "Fence semaphore", &pSemaphore);
+    return pSemaphore;
+}
+
+void FenceVkImpl::AddSignaledSemaphore(Uint64 Value, RefCntAutoPtr<ManagedSemaphore>&& pSemaphore)
+{
+    if (pSemaphore == m_TimelineSemaphore)
+        return;
+
+    // Semaphores are released outside of the lock
+    std::vector<RefCntAutoPtr<ManagedSemaphore>> StaleSemaphores;
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    PopCompletedSemaphores(StaleSemaphores);
+    m_SignaledSemaphores.emplace_back(Value, std::move(pSemaphore));
+}
+
+void FenceVkImpl::PopCompletedSemaphores(std::vector<RefCntAutoPtr<ManagedSemaphore>>& StaleSemaphores)
+{
+    // Fence values are not required to be signaled in order
+    for (auto it = m_SignaledSemaphores.begin(); it != m_SignaledSemaphores.end();)
+    {
+        if (it->first <= m_LastCompletedFenceValue)
+        {
+            StaleSemaphores.emplace_back(std::move(it->second));
+            it = m_SignaledSemaphores.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+bool FenceVkImpl::ReleaseCompletedSemaphores()
+{
+    // Update the last completed value
+    GetCompletedValue();
+
+    // Semaphores are released outside of the lock
+    std::vector<RefCntAutoPtr<ManagedSemaphore>> StaleSemaphores;
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    PopCompletedSemaphores(StaleSemaphores);
+    return !m_SignaledSemaphores.empty();
+}
+
+RefCntAutoPtr<ManagedSemaphore> FenceVkImpl::GetSemaphoreToWait(Uint64 Value)
+{
+    if (m_TimelineSemaphore)
+        return m_TimelineSemaphore;
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    for (auto it = m_SignaledSemaphores.begin(); it != m_SignaledSemaphores.end(); ++it)
+    {
+        if (it->first >= Value)
+        {
+            auto pSemaphore = std::move(it->second);
+            m_SignaledSemaphores.erase(it);
+            return pSemaphore;
+        }
+    }
+    return {};
+}
+
 } // namespace Diligent
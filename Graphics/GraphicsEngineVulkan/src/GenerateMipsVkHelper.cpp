@@ -32,6 +32,7 @@
 #include "DeviceContextVkImpl.hpp"
 #include "TextureViewVkImpl.hpp"
 #include "TextureVkImpl.hpp"
+#include "BufferVkImpl.hpp"
 #include "PlatformMisc.hpp"
 #include "VulkanTypeConversions.hpp"
 #include "../../GraphicsTools/interface/ShaderMacroHelper.hpp"
@@ -44,11 +45,19 @@ static const char* g_GenerateMipsCSSource =
 {
     #include "../shaders/GenerateMipsCS_inc.h"
 };
+
+static const char* g_GenerateMipsSPDSource =
+{
+    #include "../shaders/GenerateMipsSPD_inc.h"
+};
 // clang-format on
 
 namespace Diligent
 {
 
+constexpr Uint32 GenerateMipsVkHelper::MaxMipsHandledBySPD;
+constexpr Uint32 GenerateMipsVkHelper::MaxSPDArraySlices;
+
 void GenerateMipsVkHelper::GetGlImageFormat(const TextureFormatAttribs& FmtAttribs, std::array<char, 16>& GlFmt)
 {
     size_t pos   = 0;
@@ -110,9 +119,9 @@ void GenerateMipsVkHelper::GetGlImageFormat(const TextureFormatAttribs& FmtAttri
     GlFmt[pos] = 0;
 }
 
-std::array<RefCntAutoPtr<IPipelineState>, 4> GenerateMipsVkHelper::CreatePSOs(TEXTURE_FORMAT Fmt)
+GenerateMipsVkHelper::FormatPSOs GenerateMipsVkHelper::CreatePSOs(TEXTURE_FORMAT Fmt)
 {
-    std::array<RefCntAutoPtr<IPipelineState>, 4> PSOs;
+    FormatPSOs PSOs;
 
 #if !DILIGENT_NO_GLSLANG
     ShaderCreateInfo CSCreateInfo;
@@ -170,8 +179,51 @@ std::array<RefCntAutoPtr<IPipelineState>, 4> GenerateMipsVkHelper::CreatePSOs(TE
         PSODesc.ResourceLayout.ImmutableSamplers    = &ImtblSampler;
         PSODesc.ResourceLayout.NumImmutableSamplers = 1;
 
-        m_DeviceVkImpl.CreateComputePipelineState(PSOCreateInfo, &PSOs[NonPowOfTwo]);
-        PSOs[NonPowOfTwo]->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "CB")->Set(m_ConstantsCB);
+        m_DeviceVkImpl.CreateComputePipelineState(PSOCreateInfo, &PSOs.CS[NonPowOfTwo]);
+        PSOs.CS[NonPowOfTwo]->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "CB")->Set(m_ConstantsCB);
+    }
+
+    {
+        ShaderMacroHelper Macros;
+        Macros.AddShaderMacro("CONVERT_TO_SRGB", IsGamma);
+        Macros.AddShaderMacro("IMG_FORMAT", GlFmt.data());
+        Macros.Finalize();
+
+        CSCreateInfo.Source = g_GenerateMipsSPDSource;
+        CSCreateInfo.Macros = Macros;
+
+        std::stringstream name_ss;
+        name_ss << "Generate mips single pass " << GlFmt.data();
+        auto name              = name_ss.str();
+        CSCreateInfo.Desc.Name = name.c_str();
+        RefCntAutoPtr<IShader> pCS;
+
+        m_DeviceVkImpl.CreateShader(CSCreateInfo, &pCS);
+
+        ComputePipelineStateCreateInfo PSOCreateInfo;
+        PipelineStateDesc&             PSODesc = PSOCreateInfo.PSODesc;
+
+        PSODesc.PipelineType = PIPELINE_TYPE_COMPUTE;
+        PSODesc.Name         = name.c_str();
+        PSOCreateInfo.pCS    = pCS;
+
+        // clang-format off
+        PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC;
+        ShaderResourceVariableDesc Vars[] =
+        {
+            {SHADER_TYPE_COMPUTE, "CB",         SHADER_RESOURCE_VARIABLE_TYPE_STATIC},
+            {SHADER_TYPE_COMPUTE, "SPDCounter", SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE}
+        };
+        // clang-format on
+        PSODesc.ResourceLayout.Variables    = Vars;
+        PSODesc.ResourceLayout.NumVariables = _countof(Vars);
+
+        const ImmutableSamplerDesc ImtblSampler{SHADER_TYPE_COMPUTE, "SrcMip", Sam_LinearClamp};
+        PSODesc.ResourceLayout.ImmutableSamplers    = &ImtblSampler;
+        PSODesc.ResourceLayout.NumImmutableSamplers = 1;
+
+        m_DeviceVkImpl.CreateComputePipelineState(PSOCreateInfo, &PSOs.SPD);
+        PSOs.SPD->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "CB")->Set(m_ConstantsCB);
     }
 #endif
 
@@ -199,12 +251,36 @@ void GenerateMipsVkHelper::CreateSRB(IShaderResourceBinding** ppSRB)
 {
 #if !DILIGENT_NO_GLSLANG
     // All PSOs are compatible
-    auto& PSO = FindPSOs(TEX_FORMAT_RGBA8_UNORM);
-    PSO[0]->CreateShaderResourceBinding(ppSRB, true);
+    auto& PSOs = FindPSOs(TEX_FORMAT_RGBA8_UNORM);
+    PSOs.CS[0]->CreateShaderResourceBinding(ppSRB, true);
+#endif
+}
+
+void GenerateMipsVkHelper::CreateSPDSRB(IShaderResourceBinding** ppSRB, IBuffer** ppCounterBuffer)
+{
+#if !DILIGENT_NO_GLSLANG
+    // All PSOs are compatible
+    auto& PSOs = FindPSOs(TEX_FORMAT_RGBA8_UNORM);
+    PSOs.SPD->CreateShaderResourceBinding(ppSRB, true);
+
+    BufferDesc SPDCounterDesc;
+    SPDCounterDesc.Name              = "Single-pass downsampler atomic counter buffer";
+    SPDCounterDesc.BindFlags         = BIND_UNORDERED_ACCESS;
+    SPDCounterDesc.Usage             = USAGE_DEFAULT;
+    SPDCounterDesc.Mode              = BUFFER_MODE_STRUCTURED;
+    SPDCounterDesc.ElementByteStride = sizeof(Uint32);
+    SPDCounterDesc.uiSizeInBytes     = sizeof(Uint32) * MaxSPDArraySlices;
+
+    // The counters must start at zero; every dispatch resets them back when it is done
+    std::vector<Uint32> ZeroCounters(MaxSPDArraySlices);
+    BufferData          SPDCounterData{ZeroCounters.data(), SPDCounterDesc.uiSizeInBytes};
+    m_DeviceVkImpl.CreateBuffer(SPDCounterDesc, &SPDCounterData, ppCounterBuffer);
+
+    (*ppSRB)->GetVariableByName(SHADER_TYPE_COMPUTE, "SPDCounter")->Set((*ppCounterBuffer)->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
 #endif
 }
 
-std::array<RefCntAutoPtr<IPipelineState>, 4>& GenerateMipsVkHelper::FindPSOs(TEXTURE_FORMAT Fmt)
+GenerateMipsVkHelper::FormatPSOs& GenerateMipsVkHelper::FindPSOs(TEXTURE_FORMAT Fmt)
 {
     std::lock_guard<std::mutex> Lock{m_PSOMutex};
 
@@ -219,7 +295,30 @@ void GenerateMipsVkHelper::WarmUpCache(TEXTURE_FORMAT Fmt)
     FindPSOs(Fmt);
 }
 
-void GenerateMipsVkHelper::GenerateMips(TextureViewVkImpl& TexView, DeviceContextVkImpl& Ctx, IShaderResourceBinding* pSRB)
+bool GenerateMipsVkHelper::IsSPDCompatible(Uint32 Width, Uint32 Height, Uint32 NumMipLevels, Uint32 NumArraySlices)
+{
+    const Uint32 NumOutMips = NumMipLevels - 1;
+    if (NumOutMips > MaxMipsHandledBySPD || NumArraySlices > MaxSPDArraySlices)
+        return false;
+
+    // The last work group reduces the entire 6th output level, so it must fit into a single 64x64 tile
+    if (NumOutMips > 6 && ((Width >> 6) > 64 || (Height >> 6) > 64))
+        return false;
+
+    // Unlike the multi-pass downsampler, the single-pass one always uses 2x2 box filter
+    // and would undersample odd dimensions, so only use it when every level halves exactly.
+    for (Uint32 Mip = 0; Mip < NumOutMips; ++Mip)
+    {
+        const Uint32 MipWidth  = Width >> Mip;
+        const Uint32 MipHeight = Height >> Mip;
+        if ((MipWidth > 1 && (MipWidth & 0x01) != 0) || (MipHeight > 1 && (MipHeight & 0x01) != 0))
+            return false;
+    }
+
+    return true;
+}
+
+void GenerateMipsVkHelper::GenerateMips(TextureViewVkImpl& TexView, DeviceContextVkImpl& Ctx, IShaderResourceBinding* pSRB, IShaderResourceBinding* pSPDSRB, IBuffer* pSPDCounter)
 {
     auto* pTexVk = TexView.GetTexture<TextureVkImpl>();
     if (!pTexVk->IsInKnownState())
@@ -263,8 +362,17 @@ void GenerateMipsVkHelper::GenerateMips(TextureViewVkImpl& TexView, DeviceContex
 #if !DILIGENT_NO_GLSLANG
     if (TexView.HasMipLevelViews())
     {
-        VERIFY_EXPR(pSRB != nullptr);
-        AffectedMipLevelLayout = GenerateMipsCS(TexView, Ctx, *pSRB, SubresRange);
+        const Uint32 SrcWidth  = std::max(TexDesc.Width >> ViewDesc.MostDetailedMip, 1u);
+        const Uint32 SrcHeight = std::max(TexDesc.Height >> ViewDesc.MostDetailedMip, 1u);
+        if (pSPDSRB != nullptr && pSPDCounter != nullptr && IsSPDCompatible(SrcWidth, SrcHeight, ViewDesc.NumMipLevels, ViewDesc.NumArraySlices))
+        {
+            AffectedMipLevelLayout = GenerateMipsSPD(TexView, Ctx, *pSPDSRB, *pSPDCounter, SubresRange);
+        }
+        else
+        {
+            VERIFY_EXPR(pSRB != nullptr);
+            AffectedMipLevelLayout = GenerateMipsCS(TexView, Ctx, *pSRB, SubresRange);
+        }
     }
     else
 #endif
@@ -345,7 +453,7 @@ VkImageLayout GenerateMipsVkHelper::GenerateMipsCS(TextureViewVkImpl& TexView, D
         // Determine if the first downsample is more than 2:1.  This happens whenever
         // the source width or height is odd.
         uint32_t NonPowerOfTwo = (SrcWidth & 1) | (SrcHeight & 1) << 1;
-        Ctx.SetPipelineState(PSOs[NonPowerOfTwo]);
+        Ctx.SetPipelineState(PSOs.CS[NonPowerOfTwo]);
 
         // We can downsample up to four times, but if the ratio between levels is not
         // exactly 2:1, we have to shift our blend weights, which gets complicated or
@@ -412,6 +520,98 @@ VkImageLayout GenerateMipsVkHelper::GenerateMipsCS(TextureViewVkImpl& TexView, D
     return VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
 }
 
+VkImageLayout GenerateMipsVkHelper::GenerateMipsSPD(TextureViewVkImpl& TexView, DeviceContextVkImpl& Ctx, IShaderResourceBinding& SRB, IBuffer& CounterBuffer, VkImageSubresourceRange& SubresRange)
+{
+    auto*       pTexVk   = TexView.GetTexture<TextureVkImpl>();
+    const auto& TexDesc  = pTexVk->GetDesc();
+    const auto& ViewDesc = TexView.GetDesc();
+
+    VERIFY(TexDesc.Type == RESOURCE_DIM_TEX_2D || TexDesc.Type == RESOURCE_DIM_TEX_2D_ARRAY,
+           "CS-based mipmap generation is only supported for 2D textures and texture arrays");
+
+    const Uint32 SrcWidth   = std::max(TexDesc.Width >> ViewDesc.MostDetailedMip, 1u);
+    const Uint32 SrcHeight  = std::max(TexDesc.Height >> ViewDesc.MostDetailedMip, 1u);
+    const Uint32 NumOutMips = ViewDesc.NumMipLevels - 1;
+    VERIFY_EXPR(IsSPDCompatible(SrcWidth, SrcHeight, ViewDesc.NumMipLevels, ViewDesc.NumArraySlices));
+
+    auto& PSOs = FindPSOs(ViewDesc.Format);
+
+    const auto OriginalState  = pTexVk->GetState();
+    const auto OriginalLayout = pTexVk->GetLayout();
+
+    // Transition the lowest mip level to VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+    SubresRange.baseMipLevel = ViewDesc.MostDetailedMip;
+    SubresRange.levelCount   = 1;
+    if (OriginalState != RESOURCE_STATE_SHADER_RESOURCE)
+        Ctx.TransitionTextureState(*pTexVk, OriginalState, RESOURCE_STATE_SHADER_RESOURCE, false /*UpdateTextureState*/, &SubresRange);
+    VERIFY_EXPR(ResourceStateToVkImageLayout(RESOURCE_STATE_SHADER_RESOURCE) == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+    // All mip levels are bound at once, so the SRB only needs to be committed once
+    SRB.GetVariableByName(SHADER_TYPE_COMPUTE, "SrcMip")->Set(TexView.GetMipLevelSRV(0));
+
+    static const char* OutMipNames[MaxMipsHandledBySPD] =
+        {
+            "OutMip0", "OutMip1", "OutMip2", "OutMip3", "OutMip4", "OutMip5",
+            "OutMip6", "OutMip7", "OutMip8", "OutMip9", "OutMip10", "OutMip11" //
+        };
+    for (Uint32 u = 0; u < MaxMipsHandledBySPD; ++u)
+    {
+        // Unused variables are bound to the last mip level, the shader never writes to them
+        auto* MipLevelUAV = TexView.GetMipLevelUAV(std::min(u + 1, NumOutMips));
+        SRB.GetVariableByName(SHADER_TYPE_COMPUTE, OutMipNames[u])->Set(MipLevelUAV);
+    }
+
+    // Every work group processes 64x64 texels of the source mip level
+    const Uint32 NumGroupsX = (SrcWidth + 63) / 64;
+    const Uint32 NumGroupsY = (SrcHeight + 63) / 64;
+
+    {
+        struct CBData
+        {
+            Int32  SrcMipSize[2];
+            Int32  NumMipLevels;     // Number of OutMips to write: [1, 12]
+            Uint32 NumWorkGroups;    // Number of work groups per array slice
+            float  InvSrcMipSize[2]; // 1.0 / SrcMipSize
+        };
+        MapHelper<CBData> MappedData(&Ctx, m_ConstantsCB, MAP_WRITE, MAP_FLAG_DISCARD);
+
+        *MappedData =
+            {
+                {
+                    static_cast<Int32>(SrcWidth), static_cast<Int32>(SrcHeight) //
+                },
+                static_cast<Int32>(NumOutMips),
+                NumGroupsX * NumGroupsY,
+                {
+                    1.0f / static_cast<float>(SrcWidth), 1.0f / static_cast<float>(SrcHeight) //
+                }                                                                             //
+            };
+    }
+
+    SubresRange.baseMipLevel = ViewDesc.MostDetailedMip + 1;
+    SubresRange.levelCount   = NumOutMips;
+    if (OriginalLayout != VK_IMAGE_LAYOUT_GENERAL)
+        Ctx.TransitionImageLayout(*pTexVk, OriginalLayout, VK_IMAGE_LAYOUT_GENERAL, SubresRange);
+
+    // The counter buffer is owned by the context and is only ever accessed by this shader, so its state
+    // is not tracked. Make the counter resets and the initial upload visible to the dispatch. All dispatches
+    // that use the buffer are recorded by the same context, so they are all submitted to the same queue.
+    Ctx.GetCommandBuffer().BufferMemoryBarrier(ValidatedCast<BufferVkImpl>(&CounterBuffer)->GetVkBuffer(),
+                                               VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+                                               VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+                                               VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                                               VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+
+    Ctx.SetPipelineState(PSOs.SPD);
+    Ctx.CommitShaderResources(&SRB, RESOURCE_STATE_TRANSITION_MODE_NONE);
+    DispatchComputeAttribs DispatchAttrs(NumGroupsX, NumGroupsY, ViewDesc.NumArraySlices);
+    Ctx.DispatchCompute(DispatchAttrs);
+
+    Ctx.TransitionImageLayout(*pTexVk, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, SubresRange);
+
+    return VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+}
+
 VkImageLayout GenerateMipsVkHelper::GenerateMipsBlit(TextureViewVkImpl& TexView, DeviceContextVkImpl& Ctx, VkImageSubresourceRange& SubresRange) const
 {
     auto*       pTexVk   = TexView.GetTexture<TextureVkImpl>();
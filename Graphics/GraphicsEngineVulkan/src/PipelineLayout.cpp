@@ -75,6 +75,66 @@ VkDescriptorType PipelineLayout::GetVkDescriptorType(SPIRVShaderResourceAttribs:
     return ResTypeToVkDescrType[Type];
 }
 
+void PushDescriptorWriter::AddWrites(const VkWriteDescriptorSet* pWrites, Uint32 NumWrites)
+{
+    for (Uint32 w = 0; w < NumWrites; ++w)
+    {
+        const auto& SrcWrite = pWrites[w];
+        VERIFY(m_NumWrites < m_Writes.size(), "Too many descriptor writes for a push descriptor set");
+        auto& DstWrite = m_Writes[m_NumWrites++];
+
+        DstWrite        = SrcWrite;
+        DstWrite.dstSet = VK_NULL_HANDLE; // dstSet is ignored by vkCmdPushDescriptorSetKHR
+
+        const auto Count = SrcWrite.descriptorCount;
+        // Only the array that corresponds to the descriptor type is initialized by the writer (13.2.4)
+        switch (SrcWrite.descriptorType)
+        {
+            case VK_DESCRIPTOR_TYPE_SAMPLER:
+            case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+            case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+            case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+            case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
+                VERIFY(m_NumImgInfos + Count <= m_ImgInfos.size(), "Too many image descriptors for a push descriptor set");
+                std::copy(SrcWrite.pImageInfo, SrcWrite.pImageInfo + Count, &m_ImgInfos[m_NumImgInfos]);
+                DstWrite.pImageInfo = &m_ImgInfos[m_NumImgInfos];
+                m_NumImgInfos += Count;
+                break;
+
+            case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+            case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+                VERIFY(m_NumBuffInfos + Count <= m_BuffInfos.size(), "Too many buffer descriptors for a push descriptor set");
+                std::copy(SrcWrite.pBufferInfo, SrcWrite.pBufferInfo + Count, &m_BuffInfos[m_NumBuffInfos]);
+                DstWrite.pBufferInfo = &m_BuffInfos[m_NumBuffInfos];
+                m_NumBuffInfos += Count;
+                break;
+
+            case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
+            case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
+                VERIFY(m_NumBuffViews + Count <= m_BuffViews.size(), "Too many texel buffer descriptors for a push descriptor set");
+                std::copy(SrcWrite.pTexelBufferView, SrcWrite.pTexelBufferView + Count, &m_BuffViews[m_NumBuffViews]);
+                DstWrite.pTexelBufferView = &m_BuffViews[m_NumBuffViews];
+                m_NumBuffViews += Count;
+                break;
+
+            case VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR:
+            {
+                const auto* pSrcAccelStructs = static_cast<const VkWriteDescriptorSetAccelerationStructureKHR*>(SrcWrite.pNext);
+                VERIFY(m_NumAccelStructs + Count <= m_AccelStructs.size(), "Too many acceleration structure descriptors for a push descriptor set");
+                std::copy(pSrcAccelStructs, pSrcAccelStructs + Count, &m_AccelStructs[m_NumAccelStructs]);
+                DstWrite.pNext = &m_AccelStructs[m_NumAccelStructs];
+                m_NumAccelStructs += Count;
+                break;
+            }
+
+            default:
+                // Dynamic uniform and storage buffers are not allowed in push descriptor sets (13.2.1)
+                UNEXPECTED("Unexpected descriptor type");
+        }
+    }
+}
+
+
 PipelineLayout::DescriptorSetLayoutManager::DescriptorSetLayoutManager(IMemoryAllocator& MemAllocator) :
     m_MemAllocator{MemAllocator},
     m_LayoutBindings(STD_ALLOCATOR_RAW_MEM(VkDescriptorSetLayoutBinding, MemAllocator, "Allocator for Layout Bindings"))
@@ -167,7 +227,38 @@ void PipelineLayout::DescriptorSetLayoutManager::DescriptorSetLayout::Finalize(c
     SetLayoutCI.flags        = 0;
     SetLayoutCI.bindingCount = NumLayoutBindings;
     SetLayoutCI.pBindings    = pBindings;
-    VkLayout                 = LogicalDevice.CreateDescriptorSetLayout(SetLayoutCI);
+#if DILIGENT_VK_PUSH_DESCRIPTOR_SUPPORTED
+    if (IsPushDescriptorSet)
+        SetLayoutCI.flags |= VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR;
+#else
+    VERIFY(!IsPushDescriptorSet, "Push descriptors are not supported");
+#endif
+
+    VkDescriptorSetLayoutBindingFlagsCreateInfoEXT BindingFlagsCI = {};
+    std::vector<VkDescriptorBindingFlagsEXT>        BindingFlags;
+    if (IsUpdateAfterBind)
+    {
+        VERIFY(!IsPushDescriptorSet, "Push descriptor set can't be an update-after-bind set");
+        VERIFY(NumDynamicDescriptors == 0, "Update-after-bind set must not contain dynamic uniform or storage buffers");
+
+        // Descriptors of partially bound bindings that are not dynamically used need not contain valid descriptors.
+        // Update-after-bind descriptors can be updated after the set has been bound and, if they are not used by
+        // the pending command buffers, also while the command buffers are executing (13.2.1).
+        BindingFlags.resize(NumLayoutBindings,
+                            VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT |
+                                VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT |
+                                VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT);
+
+        BindingFlagsCI.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+        BindingFlagsCI.pNext         = nullptr;
+        BindingFlagsCI.bindingCount  = NumLayoutBindings;
+        BindingFlagsCI.pBindingFlags = BindingFlags.data();
+
+        SetLayoutCI.pNext = &BindingFlagsCI;
+        SetLayoutCI.flags |= VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT;
+    }
+
+    VkLayout = LogicalDevice.CreateDescriptorSetLayout(SetLayoutCI);
 
     MemAllocator.Free(pBindings);
     pBindings = pNewBindings;
@@ -196,7 +287,9 @@ bool PipelineLayout::DescriptorSetLayoutManager::DescriptorSetLayout::operator==
     if (TotalDescriptors      != rhs.TotalDescriptors      ||
         SetIndex              != rhs.SetIndex              ||
         NumDynamicDescriptors != rhs.NumDynamicDescriptors ||
-        NumLayoutBindings     != rhs.NumLayoutBindings)
+        NumLayoutBindings     != rhs.NumLayoutBindings     ||
+        IsPushDescriptorSet   != rhs.IsPushDescriptorSet   ||
+        IsUpdateAfterBind     != rhs.IsUpdateAfterBind)
         return false;
     // clang-format on
 
@@ -222,7 +315,7 @@ bool PipelineLayout::DescriptorSetLayoutManager::DescriptorSetLayout::operator==
 
 size_t PipelineLayout::DescriptorSetLayoutManager::DescriptorSetLayout::GetHash() const
 {
-    size_t Hash = ComputeHash(SetIndex, NumLayoutBindings, TotalDescriptors, NumDynamicDescriptors);
+    size_t Hash = ComputeHash(SetIndex, NumLayoutBindings, TotalDescriptors, NumDynamicDescriptors, IsPushDescriptorSet, IsUpdateAfterBind);
     for (uint32_t b = 0; b < NumLayoutBindings; ++b)
     {
         const auto& B = pBindings[b];
@@ -232,8 +325,24 @@ size_t PipelineLayout::DescriptorSetLayoutManager::DescriptorSetLayout::GetHash(
     return Hash;
 }
 
-void PipelineLayout::DescriptorSetLayoutManager::Finalize(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice)
+void PipelineLayout::DescriptorSetLayoutManager::Finalize(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice, Uint32 MaxPushDescriptors)
 {
+    // Dynamic resources are committed every time an SRB is committed, so the dynamic set is the only
+    // candidate for the push descriptor set (there can be at most one per pipeline layout).
+    // Dynamic uniform and storage buffers are not allowed in push descriptor sets (13.2.1), so
+    // sets that contain them keep using descriptor sets allocated from the dynamic pool.
+    // The remaining sets are bound by a single vkCmdBindDescriptorSets command, so the push descriptor
+    // set must either be the first or the last one.
+    {
+        auto& DynamicSet = GetDescriptorSet(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC);
+
+        DynamicSet.IsPushDescriptorSet =
+            DynamicSet.SetIndex >= 0 &&
+            (DynamicSet.SetIndex == 0 || DynamicSet.SetIndex == m_ActiveSets - 1) &&
+            DynamicSet.NumDynamicDescriptors == 0 &&
+            DynamicSet.TotalDescriptors <= std::min(MaxPushDescriptors, Uint32{PushDescriptorWriter::MaxDescriptors});
+    }
+
     size_t TotalBindings = 0;
     for (const auto& Layout : m_DescriptorSetLayouts)
     {
@@ -242,7 +351,7 @@ void PipelineLayout::DescriptorSetLayoutManager::Finalize(const VulkanUtilities:
     m_LayoutBindings.resize(TotalBindings);
     size_t BindingOffset = 0;
 
-    std::array<VkDescriptorSetLayout, 2> ActiveDescrSetLayouts = {};
+    std::array<VkDescriptorSetLayout, 3> ActiveDescrSetLayouts = {};
     for (auto& Layout : m_DescriptorSetLayouts)
     {
         if (Layout.SetIndex >= 0)
@@ -255,9 +364,10 @@ void PipelineLayout::DescriptorSetLayoutManager::Finalize(const VulkanUtilities:
     }
     VERIFY_EXPR(BindingOffset == TotalBindings);
     // clang-format off
-    VERIFY_EXPR(m_ActiveSets == 0 && ActiveDescrSetLayouts[0] == VK_NULL_HANDLE && ActiveDescrSetLayouts[1] == VK_NULL_HANDLE ||
-                m_ActiveSets == 1 && ActiveDescrSetLayouts[0] != VK_NULL_HANDLE && ActiveDescrSetLayouts[1] == VK_NULL_HANDLE ||
-                m_ActiveSets == 2 && ActiveDescrSetLayouts[0] != VK_NULL_HANDLE && ActiveDescrSetLayouts[1] != VK_NULL_HANDLE);
+    VERIFY_EXPR(m_ActiveSets == 0 && ActiveDescrSetLayouts[0] == VK_NULL_HANDLE && ActiveDescrSetLayouts[1] == VK_NULL_HANDLE && ActiveDescrSetLayouts[2] == VK_NULL_HANDLE ||
+                m_ActiveSets == 1 && ActiveDescrSetLayouts[0] != VK_NULL_HANDLE && ActiveDescrSetLayouts[1] == VK_NULL_HANDLE && ActiveDescrSetLayouts[2] == VK_NULL_HANDLE ||
+                m_ActiveSets == 2 && ActiveDescrSetLayouts[0] != VK_NULL_HANDLE && ActiveDescrSetLayouts[1] != VK_NULL_HANDLE && ActiveDescrSetLayouts[2] == VK_NULL_HANDLE ||
+                m_ActiveSets == 3 && ActiveDescrSetLayouts[0] != VK_NULL_HANDLE && ActiveDescrSetLayouts[1] != VK_NULL_HANDLE && ActiveDescrSetLayouts[2] != VK_NULL_HANDLE);
     // clang-format on
 
     VkPipelineLayoutCreateInfo PipelineLayoutCI = {};
@@ -313,6 +423,7 @@ size_t PipelineLayout::DescriptorSetLayoutManager::GetHash() const
 }
 
 void PipelineLayout::DescriptorSetLayoutManager::AllocateResourceSlot(const SPIRVShaderResourceAttribs& ResAttribs,
+                                                                      Uint32                            ArraySize,
                                                                       SHADER_RESOURCE_VARIABLE_TYPE     VariableType,
                                                                       VkSampler                         vkImmutableSampler,
                                                                       SHADER_TYPE                       ShaderType,
@@ -320,10 +431,15 @@ void PipelineLayout::DescriptorSetLayoutManager::AllocateResourceSlot(const SPIR
                                                                       Uint32&                           Binding,
                                                                       Uint32&                           OffsetInCache)
 {
-    auto& DescrSet = GetDescriptorSet(VariableType);
+    // Runtime-sized arrays are reported with zero size
+    const bool IsRuntimeArray = ResAttribs.ArraySize == 0;
+    VERIFY(!IsRuntimeArray || VariableType == SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE, "Runtime-sized arrays must be mutable");
+
+    auto& DescrSet = IsRuntimeArray ? GetUpdateAfterBindSet() : GetDescriptorSet(VariableType);
     if (DescrSet.SetIndex < 0)
     {
-        DescrSet.SetIndex = m_ActiveSets++;
+        DescrSet.SetIndex          = m_ActiveSets++;
+        DescrSet.IsUpdateAfterBind = IsRuntimeArray;
     }
     DescriptorSet = DescrSet.SetIndex;
 
@@ -333,7 +449,7 @@ void PipelineLayout::DescriptorSetLayoutManager::AllocateResourceSlot(const SPIR
 
     VkBinding.binding         = Binding;
     VkBinding.descriptorType  = GetVkDescriptorType(ResAttribs.Type);
-    VkBinding.descriptorCount = ResAttribs.ArraySize;
+    VkBinding.descriptorCount = ArraySize;
     // There are no limitations on what combinations of stages can use a descriptor binding (13.2.1)
     VkBinding.stageFlags = ShaderTypeToVkShaderStageFlagBit(ShaderType);
     if (vkImmutableSampler != VK_NULL_HANDLE)
@@ -365,6 +481,7 @@ void PipelineLayout::Release(RenderDeviceVkImpl* pDeviceVkImpl, Uint64 CommandQu
 }
 
 void PipelineLayout::AllocateResourceSlot(const SPIRVShaderResourceAttribs& ResAttribs,
+                                          Uint32                            ArraySize,
                                           SHADER_RESOURCE_VARIABLE_TYPE     VariableType,
                                           VkSampler                         vkImmutableSampler,
                                           SHADER_TYPE                       ShaderType,
@@ -376,18 +493,18 @@ void PipelineLayout::AllocateResourceSlot(const SPIRVShaderResourceAttribs& ResA
             ResAttribs.Type == SPIRVShaderResourceAttribs::ResourceType::SeparateSampler) ||
                vkImmutableSampler == VK_NULL_HANDLE,
            "Immutable sampler should only be specified for combined image samplers or separate samplers");
-    m_LayoutMgr.AllocateResourceSlot(ResAttribs, VariableType, vkImmutableSampler, ShaderType, DescriptorSet, Binding, OffsetInCache);
+    m_LayoutMgr.AllocateResourceSlot(ResAttribs, ArraySize, VariableType, vkImmutableSampler, ShaderType, DescriptorSet, Binding, OffsetInCache);
 }
 
-void PipelineLayout::Finalize(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice)
+void PipelineLayout::Finalize(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice, Uint32 MaxPushDescriptors)
 {
-    m_LayoutMgr.Finalize(LogicalDevice);
+    m_LayoutMgr.Finalize(LogicalDevice, MaxPushDescriptors);
 }
 
-std::array<Uint32, 2> PipelineLayout::GetDescriptorSetSizes(Uint32& NumSets) const
+std::array<Uint32, 3> PipelineLayout::GetDescriptorSetSizes(Uint32& NumSets) const
 {
     NumSets                        = 0;
-    std::array<Uint32, 2> SetSizes = {};
+    std::array<Uint32, 3> SetSizes = {};
 
     const auto& StaticAndMutSet = m_LayoutMgr.GetDescriptorSet(SHADER_RESOURCE_VARIABLE_TYPE_STATIC);
     if (StaticAndMutSet.SetIndex >= 0)
@@ -403,6 +520,13 @@ std::array<Uint32, 2> PipelineLayout::GetDescriptorSetSizes(Uint32& NumSets) con
         SetSizes[DynamicSet.SetIndex] = DynamicSet.TotalDescriptors;
     }
 
+    const auto& UpdateAfterBindSet = m_LayoutMgr.GetUpdateAfterBindSet();
+    if (UpdateAfterBindSet.SetIndex >= 0)
+    {
+        NumSets                               = std::max(NumSets, static_cast<Uint32>(UpdateAfterBindSet.SetIndex + 1));
+        SetSizes[UpdateAfterBindSet.SetIndex] = UpdateAfterBindSet.TotalDescriptors;
+    }
+
     return SetSizes;
 }
 
@@ -430,6 +554,22 @@ void PipelineLayout::InitResourceCache(RenderDeviceVkImpl*    pDeviceVkImpl,
         DescriptorSetAllocation SetAllocation = pDeviceVkImpl->AllocateDescriptorSet(~Uint64{0}, StaticAndMutSet.VkLayout, DescrSetName);
         ResourceCache.GetDescriptorSet(StaticAndMutSet.SetIndex).AssignDescriptorSetAllocation(std::move(SetAllocation));
     }
+
+    // Runtime-sized arrays live in a separate set allocated from the update-after-bind pool. As
+    // the set is owned by the resource cache, elements are written once when they are set, and
+    // committing the resources does not touch the descriptors.
+    const auto& UpdateAfterBindSet = m_LayoutMgr.GetUpdateAfterBindSet();
+    if (UpdateAfterBindSet.SetIndex >= 0)
+    {
+        const char* DescrSetName = "Update-after-bind Descriptor Set";
+#ifdef DILIGENT_DEVELOPMENT
+        std::string _DescrSetName(DbgPipelineName);
+        _DescrSetName.append(" - update-after-bind set");
+        DescrSetName = _DescrSetName.c_str();
+#endif
+        DescriptorSetAllocation SetAllocation = pDeviceVkImpl->AllocateUpdateAfterBindDescriptorSet(~Uint64{0}, UpdateAfterBindSet.VkLayout, DescrSetName);
+        ResourceCache.GetDescriptorSet(UpdateAfterBindSet.SetIndex).AssignDescriptorSetAllocation(std::move(SetAllocation));
+    }
 }
 
 void PipelineLayout::PrepareDescriptorSets(DeviceContextVkImpl*         pCtxVkImpl,
@@ -449,28 +589,48 @@ void PipelineLayout::PrepareDescriptorSets(DeviceContextVkImpl*         pCtxVkIm
            "Static and mutable variables are expected to share the same descriptor set");
     Uint32 TotalDynamicDescriptors = 0;
 
+    // The push descriptor set is written by vkCmdPushDescriptorSetKHR and must not be bound by
+    // vkCmdBindDescriptorSets. If it is set 0, the remaining sets are bound starting at set 1.
+    const auto& DynamicSet = m_LayoutMgr.GetDescriptorSet(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC);
+    VERIFY(!DynamicSet.IsPushDescriptorSet || VkDynamicDescrSet == VK_NULL_HANDLE, "Dynamic descriptor set must not be allocated for push descriptor set");
+    BindInfo.FirstSet = (DynamicSet.IsPushDescriptorSet && DynamicSet.SetIndex == 0) ? 1 : 0;
+
     BindInfo.SetCout = 0;
     for (SHADER_RESOURCE_VARIABLE_TYPE VarType = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE; VarType <= SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC; VarType = static_cast<SHADER_RESOURCE_VARIABLE_TYPE>(VarType + 1))
     {
         const auto& Set = m_LayoutMgr.GetDescriptorSet(VarType);
-        if (Set.SetIndex >= 0)
+        if (Set.SetIndex >= 0 && !Set.IsPushDescriptorSet)
         {
-            BindInfo.SetCout = std::max(BindInfo.SetCout, static_cast<Uint32>(Set.SetIndex + 1));
+            const auto BindIndex = static_cast<Uint32>(Set.SetIndex) - BindInfo.FirstSet;
+            BindInfo.SetCout     = std::max(BindInfo.SetCout, BindIndex + 1);
             if (BindInfo.SetCout > BindInfo.vkSets.size())
                 BindInfo.vkSets.resize(BindInfo.SetCout);
-            VERIFY_EXPR(BindInfo.vkSets[Set.SetIndex] == VK_NULL_HANDLE);
+            VERIFY_EXPR(BindInfo.vkSets[BindIndex] == VK_NULL_HANDLE);
             if (VarType == SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE)
-                BindInfo.vkSets[Set.SetIndex] = ResourceCache.GetDescriptorSet(Set.SetIndex).GetVkDescriptorSet();
+                BindInfo.vkSets[BindIndex] = ResourceCache.GetDescriptorSet(Set.SetIndex).GetVkDescriptorSet();
             else
             {
                 VERIFY_EXPR(ResourceCache.GetDescriptorSet(Set.SetIndex).GetVkDescriptorSet() == VK_NULL_HANDLE);
-                BindInfo.vkSets[Set.SetIndex] = VkDynamicDescrSet;
+                BindInfo.vkSets[BindIndex] = VkDynamicDescrSet;
             }
-            VERIFY(BindInfo.vkSets[Set.SetIndex] != VK_NULL_HANDLE, "Descriptor set must not be null");
+            VERIFY(BindInfo.vkSets[BindIndex] != VK_NULL_HANDLE, "Descriptor set must not be null");
         }
         TotalDynamicDescriptors += Set.NumDynamicDescriptors;
     }
 
+    const auto& UpdateAfterBindSet = m_LayoutMgr.GetUpdateAfterBindSet();
+    if (UpdateAfterBindSet.SetIndex >= 0)
+    {
+        VERIFY(UpdateAfterBindSet.NumDynamicDescriptors == 0, "Update-after-bind set must not contain dynamic descriptors");
+        const auto BindIndex = static_cast<Uint32>(UpdateAfterBindSet.SetIndex) - BindInfo.FirstSet;
+        BindInfo.SetCout     = std::max(BindInfo.SetCout, BindIndex + 1);
+        if (BindInfo.SetCout > BindInfo.vkSets.size())
+            BindInfo.vkSets.resize(BindInfo.SetCout);
+        VERIFY_EXPR(BindInfo.vkSets[BindIndex] == VK_NULL_HANDLE);
+        BindInfo.vkSets[BindIndex] = ResourceCache.GetDescriptorSet(UpdateAfterBindSet.SetIndex).GetVkDescriptorSet();
+        VERIFY(BindInfo.vkSets[BindIndex] != VK_NULL_HANDLE, "Descriptor set must not be null");
+    }
+
 #ifdef DILIGENT_DEBUG
     for (const auto& set : BindInfo.vkSets)
         VERIFY(set != VK_NULL_HANDLE, "Descriptor set must not be null");
@@ -486,13 +646,13 @@ void PipelineLayout::PrepareDescriptorSets(DeviceContextVkImpl*         pCtxVkIm
 #endif
     BindInfo.DynamicBuffersPresent = ResourceCache.GetNumDynamicBuffers() > 0;
 
-    if (TotalDynamicDescriptors == 0)
+    if (TotalDynamicDescriptors == 0 && BindInfo.SetCout > 0)
     {
         // There are no dynamic descriptors, so we can bind descriptor sets right now
         auto& CmdBuffer = pCtxVkImpl->GetCommandBuffer();
         CmdBuffer.BindDescriptorSets(BindInfo.BindPoint,
                                      m_LayoutMgr.GetVkPipelineLayout(),
-                                     0, // First set
+                                     BindInfo.FirstSet,
                                      BindInfo.SetCout,
                                      BindInfo.vkSets.data(), // BindInfo.vkSets is never empty
                                      0,
@@ -502,4 +662,26 @@ void PipelineLayout::PrepareDescriptorSets(DeviceContextVkImpl*         pCtxVkIm
     BindInfo.DynamicDescriptorsBound = false;
 }
 
+#if DILIGENT_VK_PUSH_DESCRIPTOR_SUPPORTED
+void PipelineLayout::PushDynamicDescriptorSet(VulkanUtilities::VulkanCommandBuffer& CmdBuffer,
+                                              VkPipelineBindPoint                   BindPoint,
+                                              const PushDescriptorWriter&           Writer) const
+{
+    const auto& DynamicSet = m_LayoutMgr.GetDescriptorSet(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC);
+    VERIFY(DynamicSet.IsPushDescriptorSet, "Dynamic descriptor set is not a push descriptor set");
+    VERIFY_EXPR(DynamicSet.SetIndex >= 0);
+
+    if (Writer.GetWriteCount() == 0)
+        return; // All dynamic resources are immutable samplers
+
+    // Unlike descriptor sets, pushed descriptors are consumed at record time, so there is nothing to
+    // allocate and nothing to release at the end of the frame.
+    CmdBuffer.PushDescriptorSet(BindPoint,
+                                m_LayoutMgr.GetVkPipelineLayout(),
+                                static_cast<uint32_t>(DynamicSet.SetIndex),
+                                Writer.GetWriteCount(),
+                                Writer.GetWrites());
+}
+#endif
+
 } // namespace Diligent
@@ -334,6 +334,32 @@ void CreateGraphicsPipeline(RenderDeviceVkImpl*                           pDevic
     PipelineCI.basePipelineHandle = VK_NULL_HANDLE; // a pipeline to derive from
     PipelineCI.basePipelineIndex  = -1;             // an index into the pCreateInfos parameter to use as a pipeline to derive from
 
+#if DILIGENT_VK_DYNAMIC_RENDERING_SUPPORTED
+    // Pipelines that do not use explicit render pass are used with render targets set by SetRenderTargets(),
+    // which are rendered to with dynamic rendering. Such pipelines are created against attachment formats.
+    VkPipelineRenderingCreateInfoKHR         RenderingCI = {};
+    std::array<VkFormat, MAX_RENDER_TARGETS> ColorAttachmentFormats;
+    if (GraphicsPipeline.pRenderPass == nullptr && pDeviceVk->UseDynamicRendering())
+    {
+        for (Uint32 rt = 0; rt < GraphicsPipeline.NumRenderTargets; ++rt)
+            ColorAttachmentFormats[rt] = TexFormatToVkFormat(GraphicsPipeline.RTVFormats[rt]);
+
+        RenderingCI.sType                   = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR;
+        RenderingCI.colorAttachmentCount    = GraphicsPipeline.NumRenderTargets;
+        RenderingCI.pColorAttachmentFormats = GraphicsPipeline.NumRenderTargets > 0 ? ColorAttachmentFormats.data() : nullptr;
+        if (GraphicsPipeline.DSVFormat != TEX_FORMAT_UNKNOWN)
+        {
+            RenderingCI.depthAttachmentFormat = TexFormatToVkFormat(GraphicsPipeline.DSVFormat);
+            if (GetTextureFormatAttribs(GraphicsPipeline.DSVFormat).ComponentType == COMPONENT_TYPE_DEPTH_STENCIL)
+                RenderingCI.stencilAttachmentFormat = RenderingCI.depthAttachmentFormat;
+        }
+
+        PipelineCI.pNext      = &RenderingCI;
+        PipelineCI.renderPass = VK_NULL_HANDLE;
+        PipelineCI.subpass    = 0;
+    }
+#endif
+
     Pipeline = LogicalDevice.CreateGraphicsPipeline(PipelineCI, VK_NULL_HANDLE, PSODesc.Name);
 }
 
@@ -614,7 +640,7 @@ void PipelineStateVkImpl::InitResourceLayouts(const PipelineStateCreateInfo& Cre
                                        m_Desc.ResourceLayout, m_PipelineLayout,
                                        (CreateInfo.Flags & PSO_CREATE_FLAG_IGNORE_MISSING_VARIABLES) == 0,
                                        (CreateInfo.Flags & PSO_CREATE_FLAG_IGNORE_MISSING_IMMUTABLE_SAMPLERS) == 0);
-    m_PipelineLayout.Finalize(LogicalDevice);
+    m_PipelineLayout.Finalize(LogicalDevice, pDeviceVk->GetMaxPushDescriptors());
 
     if (m_Desc.SRBAllocationGranularity > 1)
     {
@@ -940,9 +966,38 @@ void PipelineStateVkImpl::CommitAndTransitionShaderResources(IShaderResourceBind
 
     if (CommitResources)
     {
+        VkPipelineBindPoint BindPoint = VK_PIPELINE_BIND_POINT_MAX_ENUM;
+        switch (m_Desc.PipelineType)
+        {
+            // clang-format off
+            case PIPELINE_TYPE_GRAPHICS:
+            case PIPELINE_TYPE_MESH:        BindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;        break;
+            case PIPELINE_TYPE_COMPUTE:     BindPoint = VK_PIPELINE_BIND_POINT_COMPUTE;         break;
+            case PIPELINE_TYPE_RAY_TRACING: BindPoint = VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR; break;
+            // clang-format on
+            default: UNEXPECTED("Unknown pipeline type");
+        }
+
         VkDescriptorSet DynamicDescrSet              = VK_NULL_HANDLE;
         auto            DynamicDescriptorSetVkLayout = m_PipelineLayout.GetDynamicDescriptorSetVkLayout();
-        if (DynamicDescriptorSetVkLayout != VK_NULL_HANDLE)
+        if (DynamicDescriptorSetVkLayout != VK_NULL_HANDLE && m_PipelineLayout.IsDynamicDescriptorSetPushed())
+        {
+#if DILIGENT_VK_PUSH_DESCRIPTOR_SUPPORTED
+            // Push all dynamic resource descriptors directly into the command buffer. This requires
+            // no descriptor set allocation from the dynamic descriptor pool.
+            PushDescriptorWriter PushWriter;
+            for (Uint32 s = 0; s < GetNumShaderStages(); ++s)
+            {
+                const auto& Layout = m_ShaderResourceLayouts[s];
+                if (Layout.GetResourceCount(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC) != 0)
+                    Layout.CommitDynamicResources(ResourceCache, PushWriter);
+            }
+            m_PipelineLayout.PushDynamicDescriptorSet(pCtxVkImpl->GetCommandBuffer(), BindPoint, PushWriter);
+#else
+            UNEXPECTED("Push descriptors are not supported");
+#endif
+        }
+        else if (DynamicDescriptorSetVkLayout != VK_NULL_HANDLE)
         {
             const char* DynamicDescrSetName = "Dynamic Descriptor Set";
 #ifdef DILIGENT_DEVELOPMENT
@@ -961,19 +1016,6 @@ void PipelineStateVkImpl::CommitAndTransitionShaderResources(IShaderResourceBind
             }
         }
 
-
-        VkPipelineBindPoint BindPoint = VK_PIPELINE_BIND_POINT_MAX_ENUM;
-        switch (m_Desc.PipelineType)
-        {
-            // clang-format off
-            case PIPELINE_TYPE_GRAPHICS:
-            case PIPELINE_TYPE_MESH:        BindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;        break;
-            case PIPELINE_TYPE_COMPUTE:     BindPoint = VK_PIPELINE_BIND_POINT_COMPUTE;         break;
-            case PIPELINE_TYPE_RAY_TRACING: BindPoint = VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR; break;
-            // clang-format on
-            default: UNEXPECTED("Unknown pipeline type");
-        }
-
         VERIFY_EXPR(pDescrSetBindInfo != nullptr);
         // Prepare descriptor sets, and also bind them if there are no dynamic descriptors
         m_PipelineLayout.PrepareDescriptorSets(pCtxVkImpl, BindPoint, ResourceCache, *pDescrSetBindInfo, DynamicDescrSet);
@@ -47,6 +47,39 @@
 namespace Diligent
 {
 
+// Returns the mask of the command queues from compute-only families
+static Uint64 GetComputeQueueMask(const VulkanUtilities::VulkanPhysicalDevice& PhysicalDevice, size_t CommandQueueCount, ICommandQueueVk** CmdQueues)
+{
+    Uint64 Mask = 0;
+    for (Uint32 q = 1; q < CommandQueueCount; ++q)
+    {
+        const auto& FamilyProps = PhysicalDevice.GetQueueFamilyProperties(CmdQueues[q]->GetQueueFamilyIndex());
+        if ((FamilyProps.queueFlags & VK_QUEUE_COMPUTE_BIT) != 0 && (FamilyProps.queueFlags & VK_QUEUE_GRAPHICS_BIT) == 0)
+            Mask |= Uint64{1} << Uint64{q};
+    }
+    return Mask;
+}
+
+// Buffers and textures are created with VK_SHARING_MODE_CONCURRENT when they may be accessed by compute
+// queues, so that they can be used by different queue families without ownership transfers (11.7).
+static std::vector<uint32_t> GetConcurrentQueueFamilies(ICommandQueueVk** CmdQueues, Uint64 ComputeQueueMask)
+{
+    std::vector<uint32_t> Families;
+    if (ComputeQueueMask == 0)
+        return Families;
+
+    Families.push_back(CmdQueues[0]->GetQueueFamilyIndex());
+    while (ComputeQueueMask != 0)
+    {
+        const auto q           = PlatformMisc::GetLSB(ComputeQueueMask);
+        const auto FamilyIndex = CmdQueues[q]->GetQueueFamilyIndex();
+        if (std::find(Families.begin(), Families.end(), FamilyIndex) == Families.end())
+            Families.push_back(FamilyIndex);
+        ComputeQueueMask &= ~(Uint64{1} << Uint64{q});
+    }
+    return Families;
+}
+
 RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*                                    pRefCounters,
                                        IMemoryAllocator&                                      RawMemAllocator,
                                        IEngineFactory*                                        pEngineFactory,
@@ -88,6 +121,8 @@ RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*
     m_PhysicalDevice         {std::move(PhysicalDevice)},
     m_LogicalVkDevice        {std::move(LogicalDevice) },
     m_EngineAttribs          {EngineCI                 },
+    m_ComputeQueueMask       {GetComputeQueueMask(*m_PhysicalDevice, CommandQueueCount, CmdQueues)},
+    m_ConcurrentQueueFamilies{GetConcurrentQueueFamilies(CmdQueues, m_ComputeQueueMask)},
     m_FramebufferCache       {*this                    },
     m_ImplicitRenderPassCache{*this                    },
     m_DescriptorSetAllocator
@@ -110,7 +145,8 @@ RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*
             {VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR, EngineCI.MainDescriptorPoolSize.NumAccelStructDescriptors}
         },
         EngineCI.MainDescriptorPoolSize.MaxDescriptorSets,
-        true
+        true,
+        false
     },
     m_DynamicDescriptorPool
     {
@@ -132,7 +168,26 @@ RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*
             {VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR, EngineCI.MainDescriptorPoolSize.NumAccelStructDescriptors}
         },
         EngineCI.DynamicDescriptorPoolSize.MaxDescriptorSets,
-        false // Pools can only be reset
+        false, // Pools can only be reset
+        false
+    },
+    m_UpdateAfterBindDescriptorSetAllocator
+    {
+        *this,
+        "Update-after-bind descriptor pool",
+        // Update-after-bind sets only contain runtime-sized arrays of textures, texel buffers and samplers
+        std::vector<VkDescriptorPoolSize>
+        {
+            {VK_DESCRIPTOR_TYPE_SAMPLER,                EngineCI.UpdateAfterBindDescriptorPoolSize.NumSeparateSamplerDescriptors},
+            {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, EngineCI.UpdateAfterBindDescriptorPoolSize.NumCombinedSamplerDescriptors},
+            {VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,          EngineCI.UpdateAfterBindDescriptorPoolSize.NumSampledImageDescriptors},
+            {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,          EngineCI.UpdateAfterBindDescriptorPoolSize.NumStorageImageDescriptors},
+            {VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER,   EngineCI.UpdateAfterBindDescriptorPoolSize.NumUniformTexelBufferDescriptors},
+            {VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER,   EngineCI.UpdateAfterBindDescriptorPoolSize.NumStorageTexelBufferDescriptors}
+        },
+        EngineCI.UpdateAfterBindDescriptorPoolSize.MaxDescriptorSets,
+        true,
+        true
     },
     m_TransientCmdPoolMgr
     {
@@ -180,6 +235,54 @@ RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*
         m_DeviceProperties.MaxRayTracingRecursionDepth = m_Properties.MaxRayTracingRecursionDepth;
     }
 
+#if DILIGENT_VK_DYNAMIC_RENDERING_SUPPORTED
+    m_UseDynamicRendering = m_LogicalVkDevice->GetEnabledExtFeatures().DynamicRendering.dynamicRendering != VK_FALSE;
+#endif
+#if DILIGENT_VK_PUSH_DESCRIPTOR_SUPPORTED
+    if (m_LogicalVkDevice->GetEnabledExtFeatures().PushDescriptor)
+        m_MaxPushDescriptors = m_PhysicalDevice->GetExtProperties().PushDescriptor.maxPushDescriptors;
+#endif
+    if (EngineCI.EnableDescriptorIndexing &&
+        VulkanUtilities::VulkanPhysicalDevice::SupportsUpdateAfterBindArrays(m_LogicalVkDevice->GetEnabledExtFeatures().DescriptorIndexing))
+    {
+        // Every element of a runtime-sized array is a separate descriptor that counts towards the per-stage limits.
+        // Array sizes are stored in 16-bit fields of the shader resource layout.
+        const auto& Limits = m_PhysicalDevice->GetExtProperties().DescriptorIndexing;
+        // clang-format off
+        m_RuntimeDescriptorArraySize = std::min({EngineCI.RuntimeDescriptorArraySize,
+                                                 Limits.maxPerStageDescriptorUpdateAfterBindSamplers,
+                                                 Limits.maxPerStageDescriptorUpdateAfterBindSampledImages,
+                                                 Limits.maxPerStageDescriptorUpdateAfterBindStorageImages,
+                                                 Limits.maxPerStageUpdateAfterBindResources,
+                                                 Uint32{std::numeric_limits<Uint16>::max()}});
+        // clang-format on
+    }
+#if DILIGENT_VK_TIMELINE_SEMAPHORE_SUPPORTED
+    m_UseTimelineSemaphores = m_LogicalVkDevice->GetEnabledExtFeatures().TimelineSemaphore.timelineSemaphore != VK_FALSE;
+#endif
+
+    // Queue 0 is always the graphics queue used by the immediate context. If there is
+    // a queue from a dedicated transfer family, resource uploads are executed on it.
+    // Uploaded resources are only acquired by the graphics queue family, so the transfer
+    // queue is not used when there are compute queues.
+    m_GraphicsQueueFamilyIndex = CmdQueues[0]->GetQueueFamilyIndex();
+    if (EngineCI.EnableTransferQueue && m_ComputeQueueMask == 0)
+    {
+        for (Uint32 q = 1; q < CommandQueueCount; ++q)
+        {
+            const auto  FamilyIndex = CmdQueues[q]->GetQueueFamilyIndex();
+            const auto& FamilyProps = m_PhysicalDevice->GetQueueFamilyProperties(FamilyIndex);
+            if ((FamilyProps.queueFlags & VK_QUEUE_TRANSFER_BIT) != 0 &&
+                (FamilyProps.queueFlags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)) == 0)
+            {
+                m_TransferQueueIndex       = q;
+                m_TransferQueueFamilyIndex = FamilyIndex;
+                m_TransferCmdPoolMgr.reset(new CommandPoolManager{*this, "Transfer command buffer pool manager", FamilyIndex, VK_COMMAND_POOL_CREATE_TRANSIENT_BIT});
+                break;
+            }
+        }
+    }
+
     m_DeviceCaps.DevType      = RENDER_DEVICE_TYPE_VULKAN;
     m_DeviceCaps.MajorVersion = 1;
     m_DeviceCaps.MinorVersion = 0;
@@ -249,7 +352,7 @@ RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*
     Features.DurationQueries               = DEVICE_FEATURE_STATE_ENABLED;
 
 #if defined(_MSC_VER) && defined(_WIN64)
-    static_assert(sizeof(DeviceFeatures) == 32, "Did you add a new feature to DeviceFeatures? Please handle its satus here (if necessary).");
+    static_assert(sizeof(DeviceFeatures) == 33, "Did you add a new feature to DeviceFeatures? Please handle its satus here (if necessary).");
 #endif
 
     const auto& vkDeviceLimits    = m_PhysicalDevice->GetProperties().limits;
@@ -290,13 +393,21 @@ RenderDeviceVkImpl::~RenderDeviceVkImpl()
 
     ReleaseStaleResources(true);
 
+    VERIFY(m_PendingTransferAcquires.empty(), "All pending transfer queue acquires must have been submitted by IdleGPU()");
+
     DEV_CHECK_ERR(m_DescriptorSetAllocator.GetAllocatedDescriptorSetCounter() == 0, "All allocated descriptor sets must have been released now.");
+    DEV_CHECK_ERR(m_UpdateAfterBindDescriptorSetAllocator.GetAllocatedDescriptorSetCounter() == 0, "All allocated update-after-bind descriptor sets must have been released now.");
     DEV_CHECK_ERR(m_TransientCmdPoolMgr.GetAllocatedPoolCount() == 0, "All allocated transient command pools must have been released now. If there are outstanding references to the pools in release queues, the app will crash when CommandPoolManager::FreeCommandPool() is called.");
     DEV_CHECK_ERR(m_DynamicDescriptorPool.GetAllocatedPoolCounter() == 0, "All allocated dynamic descriptor pools must have been released now.");
     DEV_CHECK_ERR(m_DynamicMemoryManager.GetMasterBlockCounter() == 0, "All allocated dynamic master blocks must have been returned to the pool.");
 
     // Immediately destroys all command pools
     m_TransientCmdPoolMgr.DestroyPools();
+    if (m_TransferCmdPoolMgr)
+    {
+        DEV_CHECK_ERR(m_TransferCmdPoolMgr->GetAllocatedPoolCount() == 0, "All allocated transfer command pools must have been released now.");
+        m_TransferCmdPoolMgr->DestroyPools();
+    }
 
     // We must destroy command queues explicitly prior to releasing Vulkan device
     DestroyCommandQueues();
@@ -310,10 +421,8 @@ RenderDeviceVkImpl::~RenderDeviceVkImpl()
 }
 
 
-void RenderDeviceVkImpl::AllocateTransientCmdPool(VulkanUtilities::CommandPoolWrapper& CmdPool, VkCommandBuffer& vkCmdBuff, const Char* DebugPoolName)
+static VkCommandBuffer BeginOneTimeCmdBuffer(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice, VkCommandPool CmdPool)
 {
-    CmdPool = m_TransientCmdPoolMgr.AllocateCommandPool(DebugPoolName);
-
     // Allocate command buffer from the cmd pool
     VkCommandBufferAllocateInfo BuffAllocInfo = {};
 
@@ -323,7 +432,7 @@ void RenderDeviceVkImpl::AllocateTransientCmdPool(VulkanUtilities::CommandPoolWr
     BuffAllocInfo.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
     BuffAllocInfo.commandBufferCount = 1;
 
-    vkCmdBuff = m_LogicalVkDevice->AllocateVkCommandBuffer(BuffAllocInfo);
+    auto vkCmdBuff = LogicalDevice.AllocateVkCommandBuffer(BuffAllocInfo);
     DEV_CHECK_ERR(vkCmdBuff != VK_NULL_HANDLE, "Failed to allocate Vulkan command buffer");
 
 
@@ -339,6 +448,21 @@ void RenderDeviceVkImpl::AllocateTransientCmdPool(VulkanUtilities::CommandPoolWr
     auto err = vkBeginCommandBuffer(vkCmdBuff, &CmdBuffBeginInfo);
     DEV_CHECK_ERR(err == VK_SUCCESS, "vkBeginCommandBuffer() failed");
     (void)err;
+
+    return vkCmdBuff;
+}
+
+void RenderDeviceVkImpl::AllocateTransientCmdPool(VulkanUtilities::CommandPoolWrapper& CmdPool, VkCommandBuffer& vkCmdBuff, const Char* DebugPoolName)
+{
+    CmdPool   = m_TransientCmdPoolMgr.AllocateCommandPool(DebugPoolName);
+    vkCmdBuff = BeginOneTimeCmdBuffer(*m_LogicalVkDevice, CmdPool);
+}
+
+void RenderDeviceVkImpl::AllocateTransferCmdPool(VulkanUtilities::CommandPoolWrapper& CmdPool, VkCommandBuffer& vkCmdBuff, const Char* DebugPoolName)
+{
+    VERIFY(HasTransferQueue(), "The device has no transfer queue");
+    CmdPool   = m_TransferCmdPoolMgr->AllocateCommandPool(DebugPoolName);
+    vkCmdBuff = BeginOneTimeCmdBuffer(*m_LogicalVkDevice, CmdPool);
 }
 
 
@@ -391,6 +515,181 @@ void RenderDeviceVkImpl::ExecuteAndDisposeTransientCmdBuff(Uint32 QueueIndex, Vk
     m_TransientCmdPoolMgr.SafeReleaseCommandPool(std::move(CmdPool), QueueIndex, FenceValue);
 }
 
+void RenderDeviceVkImpl::ExecuteAndDisposeTransferCmdBuff(VkCommandBuffer                       vkCmdBuff,
+                                                          VulkanUtilities::CommandPoolWrapper&& CmdPool,
+                                                          Uint32                                NumBufferBarriers,
+                                                          const VkBufferMemoryBarrier*          pBufferBarriers,
+                                                          Uint32                                NumImageBarriers,
+                                                          const VkImageMemoryBarrier*           pImageBarriers,
+                                                          VulkanUtilities::SemaphoreWrapper&&   WaitSemaphore)
+{
+    VERIFY_EXPR(vkCmdBuff != VK_NULL_HANDLE);
+    VERIFY(HasTransferQueue(), "The device has no transfer queue");
+
+    // Resources created with VK_SHARING_MODE_EXCLUSIVE must be released by the transfer queue family
+    // and acquired by the graphics queue family with a matching pair of barriers (6.7.4).
+    PendingTransferAcquire Acquire;
+    Acquire.BufferBarriers.assign(pBufferBarriers, pBufferBarriers + NumBufferBarriers);
+    Acquire.ImageBarriers.assign(pImageBarriers, pImageBarriers + NumImageBarriers);
+    for (auto& BuffBarrier : Acquire.BufferBarriers)
+    {
+        BuffBarrier.srcQueueFamilyIndex = m_TransferQueueFamilyIndex;
+        BuffBarrier.dstQueueFamilyIndex = m_GraphicsQueueFamilyIndex;
+    }
+    for (auto& ImgBarrier : Acquire.ImageBarriers)
+    {
+        VERIFY(ImgBarrier.oldLayout == ImgBarrier.newLayout, "Image layout must not be changed by the ownership transfer");
+        ImgBarrier.srcQueueFamilyIndex = m_TransferQueueFamilyIndex;
+        ImgBarrier.dstQueueFamilyIndex = m_GraphicsQueueFamilyIndex;
+    }
+
+    {
+        // The dstAccessMask of the release barrier and the srcAccessMask of the acquire barrier are ignored (6.7.4)
+        std::vector<VkBufferMemoryBarrier> ReleaseBufferBarriers{Acquire.BufferBarriers};
+        std::vector<VkImageMemoryBarrier>  ReleaseImageBarriers{Acquire.ImageBarriers};
+        for (auto& BuffBarrier : ReleaseBufferBarriers)
+            BuffBarrier.dstAccessMask = 0;
+        for (auto& ImgBarrier : ReleaseImageBarriers)
+            ImgBarrier.dstAccessMask = 0;
+        vkCmdPipelineBarrier(vkCmdBuff, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0,
+                             0, nullptr,
+                             static_cast<uint32_t>(ReleaseBufferBarriers.size()), ReleaseBufferBarriers.data(),
+                             static_cast<uint32_t>(ReleaseImageBarriers.size()), ReleaseImageBarriers.data());
+    }
+    for (auto& BuffBarrier : Acquire.BufferBarriers)
+        BuffBarrier.srcAccessMask = 0;
+    for (auto& ImgBarrier : Acquire.ImageBarriers)
+        ImgBarrier.srcAccessMask = 0;
+
+    auto err = vkEndCommandBuffer(vkCmdBuff);
+    DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to end command buffer");
+    (void)err;
+
+    VkSemaphoreCreateInfo SemaphoreCI = {};
+    SemaphoreCI.sType                 = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    Acquire.Semaphore                 = m_LogicalVkDevice->CreateSemaphore(SemaphoreCI, "Transfer queue upload semaphore");
+
+    const VkSemaphore          vkWaitSemaphore   = WaitSemaphore;
+    const VkSemaphore          vkSignalSemaphore = Acquire.Semaphore;
+    const VkPipelineStageFlags WaitDstStageMask  = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+
+    VkSubmitInfo SubmitInfo = {};
+
+    SubmitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    SubmitInfo.waitSemaphoreCount   = vkWaitSemaphore != VK_NULL_HANDLE ? 1 : 0;
+    SubmitInfo.pWaitSemaphores      = &vkWaitSemaphore;
+    SubmitInfo.pWaitDstStageMask    = &WaitDstStageMask;
+    SubmitInfo.commandBufferCount   = 1;
+    SubmitInfo.pCommandBuffers      = &vkCmdBuff;
+    SubmitInfo.signalSemaphoreCount = 1;
+    SubmitInfo.pSignalSemaphores    = &vkSignalSemaphore;
+
+    // No device context records commands for the transfer queue, so unlike transient command buffers
+    // submitted to the graphics queue, it is safe to discard stale resources here.
+    auto CmdBuffInfo = TRenderDeviceBase::SubmitCommandBuffer(m_TransferQueueIndex, SubmitInfo, true);
+    m_TransferCmdPoolMgr->SafeReleaseCommandPool(std::move(CmdPool), m_TransferQueueIndex, CmdBuffInfo.FenceValue);
+    // The semaphore must be released after the submission so that it is associated with a later fence value
+    if (WaitSemaphore != VK_NULL_HANDLE)
+        SafeReleaseDeviceObject(std::move(WaitSemaphore), Uint64{1} << Uint64{m_TransferQueueIndex});
+
+    // The wait operation must be submitted after the signal operation, so the acquire barriers
+    // can only be added to the list once the command buffer has been submitted.
+    std::lock_guard<std::mutex> Lock{m_PendingTransferAcquiresMtx};
+    m_PendingTransferAcquires.emplace_back(std::move(Acquire));
+}
+
+VulkanUtilities::SemaphoreWrapper RenderDeviceVkImpl::SubmitGraphicsQueueOwnershipTransfers(const std::vector<VkImageMemoryBarrier>* pReleaseBarriers)
+{
+    VulkanUtilities::SemaphoreWrapper SignalSemaphore;
+    if (!HasTransferQueue())
+        return SignalSemaphore;
+
+    // Keep the mutex locked until the command buffer is submitted to make sure that no other
+    // submission to the graphics queue can get ahead of the acquire barriers.
+    std::lock_guard<std::mutex> Lock{m_PendingTransferAcquiresMtx};
+
+    const bool HasReleaseBarriers = pReleaseBarriers != nullptr && !pReleaseBarriers->empty();
+    if (m_PendingTransferAcquires.empty() && !HasReleaseBarriers)
+        return SignalSemaphore;
+
+    VulkanUtilities::CommandPoolWrapper CmdPool;
+    VkCommandBuffer                     vkCmdBuff = VK_NULL_HANDLE;
+    AllocateTransientCmdPool(CmdPool, vkCmdBuff, "Transient command pool for queue family ownership transfers");
+
+    std::vector<VkSemaphore>          WaitSemaphores;
+    std::vector<VkPipelineStageFlags> WaitDstStageMasks;
+    WaitSemaphores.reserve(m_PendingTransferAcquires.size());
+    WaitDstStageMasks.reserve(m_PendingTransferAcquires.size());
+    for (const auto& Acquire : m_PendingTransferAcquires)
+    {
+        WaitSemaphores.push_back(Acquire.Semaphore);
+        WaitDstStageMasks.push_back(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+        vkCmdPipelineBarrier(vkCmdBuff, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0,
+                             0, nullptr,
+                             static_cast<uint32_t>(Acquire.BufferBarriers.size()), Acquire.BufferBarriers.data(),
+                             static_cast<uint32_t>(Acquire.ImageBarriers.size()), Acquire.ImageBarriers.data());
+    }
+
+    VkSemaphore vkSignalSemaphore = VK_NULL_HANDLE;
+    if (HasReleaseBarriers)
+    {
+        vkCmdPipelineBarrier(vkCmdBuff, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0,
+                             0, nullptr,
+                             0, nullptr,
+                             static_cast<uint32_t>(pReleaseBarriers->size()), pReleaseBarriers->data());
+
+        VkSemaphoreCreateInfo SemaphoreCI = {};
+        SemaphoreCI.sType                 = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        SignalSemaphore                   = m_LogicalVkDevice->CreateSemaphore(SemaphoreCI, "Graphics queue release semaphore");
+        vkSignalSemaphore                 = SignalSemaphore;
+    }
+
+    auto err = vkEndCommandBuffer(vkCmdBuff);
+    DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to end command buffer");
+    (void)err;
+
+    VkSubmitInfo SubmitInfo = {};
+
+    SubmitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    SubmitInfo.waitSemaphoreCount   = static_cast<uint32_t>(WaitSemaphores.size());
+    SubmitInfo.pWaitSemaphores      = WaitSemaphores.data();
+    SubmitInfo.pWaitDstStageMask    = WaitDstStageMasks.data();
+    SubmitInfo.commandBufferCount   = 1;
+    SubmitInfo.pCommandBuffers      = &vkCmdBuff;
+    SubmitInfo.signalSemaphoreCount = vkSignalSemaphore != VK_NULL_HANDLE ? 1 : 0;
+    SubmitInfo.pSignalSemaphores    = &vkSignalSemaphore;
+
+    // Similar to other transient command buffers, submit directly to the queue
+    // to avoid interference with the command buffer counter
+    Uint64 FenceValue = 0;
+    LockCmdQueueAndRun(0,
+                       [&](ICommandQueueVk* pCmdQueueVk) //
+                       {
+                           FenceValue = pCmdQueueVk->Submit(SubmitInfo);
+                       } //
+    );
+    m_TransientCmdPoolMgr.SafeReleaseCommandPool(std::move(CmdPool), 0, FenceValue);
+
+    for (auto& Acquire : m_PendingTransferAcquires)
+        SafeReleaseDeviceObject(std::move(Acquire.Semaphore), Uint64{1});
+    m_PendingTransferAcquires.clear();
+
+    return SignalSemaphore;
+}
+
+void RenderDeviceVkImpl::DiscardTransferQueueStaleResources()
+{
+    if (!HasTransferQueue())
+        return;
+
+    // Objects that are released for all command queues (e.g. framebuffers) are also added to the stale list of
+    // the transfer queue, which may not be used for a long time. Submit an empty batch to move them into the
+    // release queue.
+    VkSubmitInfo DummySumbitInfo = {};
+    TRenderDeviceBase::SubmitCommandBuffer(m_TransferQueueIndex, DummySumbitInfo, true);
+    PurgeReleaseQueue(m_TransferQueueIndex);
+}
+
 void RenderDeviceVkImpl::SubmitCommandBuffer(Uint32                                                 QueueIndex,
                                              const VkSubmitInfo&                                    SubmitInfo,
                                              Uint64&                                                SubmittedCmdBuffNumber, // Number of the submitted command buffer
@@ -398,6 +697,11 @@ void RenderDeviceVkImpl::SubmitCommandBuffer(Uint32
                                              std::vector<std::pair<Uint64, RefCntAutoPtr<IFence>>>* pFences                 // List of fences to signal
 )
 {
+    // Resources uploaded on the transfer queue must be acquired before they are used by the command buffer.
+    // This also makes sure that stale resources are not discarded before the acquire barriers are submitted.
+    if (QueueIndex == 0)
+        SubmitGraphicsQueueOwnershipTransfers();
+
     // Submit the command list to the queue
     auto CmbBuffInfo       = TRenderDeviceBase::SubmitCommandBuffer(QueueIndex, SubmitInfo, true);
     SubmittedFenceValue    = CmbBuffInfo.FenceValue;
@@ -410,10 +714,77 @@ void RenderDeviceVkImpl::SubmitCommandBuffer(Uint32
             auto  vkFence      = pFenceVkImpl->GetVkFence();
             m_CommandQueues[QueueIndex].CmdQueue->SignalFence(vkFence);
             pFenceVkImpl->AddPendingFence(std::move(vkFence), val_fence.first);
+
+            // Signal the semaphore that other queues wait for in IDeviceContext::DeviceWaitForFence()
+            auto pSemaphore = pFenceVkImpl->GetSemaphoreToSignal(val_fence.first);
+            if (!pSemaphore)
+                continue;
+
+            VkSemaphore vkSemaphore = pSemaphore->Get();
+
+            VkSubmitInfo SignalSubmitInfo{};
+            SignalSubmitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            SignalSubmitInfo.signalSemaphoreCount = 1;
+            SignalSubmitInfo.pSignalSemaphores    = &vkSemaphore;
+#if DILIGENT_VK_TIMELINE_SEMAPHORE_SUPPORTED
+            VkTimelineSemaphoreSubmitInfoKHR TimelineInfo{};
+            if (m_UseTimelineSemaphores)
+            {
+                TimelineInfo.sType                     = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR;
+                TimelineInfo.signalSemaphoreValueCount = 1;
+                TimelineInfo.pSignalSemaphoreValues    = &val_fence.first;
+                SignalSubmitInfo.pNext                 = &TimelineInfo;
+            }
+#endif
+            LockCmdQueueAndRun(QueueIndex,
+                               [&](ICommandQueueVk* pCmdQueueVk) //
+                               {
+                                   pCmdQueueVk->Submit(SignalSubmitInfo);
+                               } //
+            );
+            // Binary semaphore can only be waited for after its signal operation has been submitted
+            const bool IsBinarySemaphore = !pFenceVkImpl->HasTimelineSemaphore();
+            pFenceVkImpl->AddSignaledSemaphore(val_fence.first, std::move(pSemaphore));
+            if (IsBinarySemaphore)
+            {
+                RefCntWeakPtr<IFence>       wpFence{val_fence.second};
+                std::lock_guard<std::mutex> Lock{m_FencesWithSemaphoresMtx};
+                if (std::find(m_FencesWithSemaphores.begin(), m_FencesWithSemaphores.end(), wpFence) == m_FencesWithSemaphores.end())
+                    m_FencesWithSemaphores.emplace_back(std::move(wpFence));
+            }
         }
     }
 }
 
+void RenderDeviceVkImpl::ReleaseCompletedFenceSemaphores()
+{
+    std::vector<RefCntWeakPtr<IFence>> Fences;
+    {
+        std::lock_guard<std::mutex> Lock{m_FencesWithSemaphoresMtx};
+        Fences.swap(m_FencesWithSemaphores);
+    }
+    if (Fences.empty())
+        return;
+
+    // Fences are processed outside of the lock as the last reference to the fence may be released here
+    for (auto it = Fences.begin(); it != Fences.end();)
+    {
+        auto pFence = it->Lock();
+        if (pFence && pFence.RawPtr<FenceVkImpl>()->ReleaseCompletedSemaphores())
+            ++it;
+        else
+            it = Fences.erase(it);
+    }
+
+    std::lock_guard<std::mutex> Lock{m_FencesWithSemaphoresMtx};
+    for (auto& wpFence : Fences)
+    {
+        // The fence may have been added again while the lock was released
+        if (std::find(m_FencesWithSemaphores.begin(), m_FencesWithSemaphores.end(), wpFence) == m_FencesWithSemaphores.end())
+            m_FencesWithSemaphores.emplace_back(std::move(wpFence));
+    }
+}
+
 Uint64 RenderDeviceVkImpl::ExecuteCommandBuffer(Uint32 QueueIndex, const VkSubmitInfo& SubmitInfo, DeviceContextVkImpl* pImmediateCtx, std::vector<std::pair<Uint64, RefCntAutoPtr<IFence>>>* pSignalFences)
 {
     // pImmediateCtx parameter is only used to make sure the command buffer is submitted from the immediate context
@@ -426,6 +797,7 @@ Uint64 RenderDeviceVkImpl::ExecuteCommandBuffer(Uint32 QueueIndex, const VkSubmi
 
     m_MemoryMgr.ShrinkMemory();
     PurgeReleaseQueue(QueueIndex);
+    ReleaseCompletedFenceSemaphores();
 
     return SubmittedFenceValue;
 }
@@ -433,6 +805,7 @@ Uint64 RenderDeviceVkImpl::ExecuteCommandBuffer(Uint32 QueueIndex, const VkSubmi
 
 void RenderDeviceVkImpl::IdleGPU()
 {
+    SubmitGraphicsQueueOwnershipTransfers();
     IdleAllCommandQueues(true);
     m_LogicalVkDevice->WaitIdle();
     ReleaseStaleResources();
@@ -442,6 +815,7 @@ void RenderDeviceVkImpl::FlushStaleResources(Uint32 CmdQueueIndex)
 {
     // Submit empty command buffer to the queue. This will effectively signal the fence and
     // discard all resources
+    SubmitGraphicsQueueOwnershipTransfers();
     VkSubmitInfo DummySumbitInfo = {};
     TRenderDeviceBase::SubmitCommandBuffer(0, DummySumbitInfo, true);
 }
@@ -450,6 +824,7 @@ void RenderDeviceVkImpl::ReleaseStaleResources(bool ForceRelease)
 {
     m_MemoryMgr.ShrinkMemory();
     PurgeReleaseQueues(ForceRelease);
+    ReleaseCompletedFenceSemaphores();
 }
 
 
@@ -640,6 +1015,23 @@ void RenderDeviceVkImpl::CreateShader(const ShaderCreateInfo& ShaderCI, IShader*
 }
 
 
+void RenderDeviceVkImpl::CreateShaderFromSPIRV(const ShaderCreateInfo& ShaderCI,
+                                               const void*             pSerializedResources,
+                                               size_t                  SerializedResourcesSize,
+                                               IShader**               ppShader)
+{
+    CreateDeviceObject(
+        "shader", ShaderCI.Desc, ppShader,
+        [&]() //
+        {
+            ShaderVkImpl* pShaderVk(NEW_RC_OBJ(m_ShaderObjAllocator, "ShaderVkImpl instance", ShaderVkImpl)(this, ShaderCI, pSerializedResources, SerializedResourcesSize));
+            pShaderVk->QueryInterface(IID_Shader, reinterpret_cast<IObject**>(ppShader));
+
+            OnCreateDeviceObject(pShaderVk);
+        } //
+    );
+}
+
 void RenderDeviceVkImpl::CreateTextureFromVulkanImage(VkImage vkImage, const TextureDesc& TexDesc, RESOURCE_STATE InitialState, ITexture** ppTexture)
 {
     CreateDeviceObject(
@@ -684,19 +1076,303 @@ void RenderDeviceVkImpl::CreateTexture(const TextureDesc& TexDesc, const Texture
     );
 }
 
+void RenderDeviceVkImpl::CreateTransientTexture(const TextureDesc& TexDesc, Uint32 FirstUse, Uint32 LastUse, ITexture** ppTexture)
+{
+    TextureDesc TransientTexDesc = TexDesc;
+    TransientTexDesc.MiscFlags |= MISC_TEXTURE_FLAG_TRANSIENT;
+    CreateDeviceObject(
+        "texture", TransientTexDesc, ppTexture,
+        [&]() //
+        {
+            TextureVkImpl* pTextureVk = NEW_RC_OBJ(m_TexObjAllocator, "TextureVkImpl instance", TextureVkImpl)(m_TexViewObjAllocator, this, TransientTexDesc, nullptr, FirstUse, LastUse);
+
+            pTextureVk->QueryInterface(IID_Texture, reinterpret_cast<IObject**>(ppTexture));
+            pTextureVk->CreateDefaultViews();
+            OnCreateDeviceObject(pTextureVk);
+        } //
+    );
+}
+
+Uint32 RenderDeviceVkImpl::GetMemoryHeapCount() const
+{
+    return m_PhysicalDevice->GetMemoryProperties().memoryHeapCount;
+}
+
+void RenderDeviceVkImpl::GetMemoryHeapBudgets(MemoryHeapBudgetVk Budgets[VK_MAX_MEMORY_HEAPS])
+{
+    const auto& MemoryProps = m_PhysicalDevice->GetMemoryProperties();
+
+    VkDeviceSize HeapBudget[VK_MAX_MEMORY_HEAPS] = {};
+    VkDeviceSize HeapUsage[VK_MAX_MEMORY_HEAPS]  = {};
+
+    bool BudgetQueried = false;
+#if DILIGENT_VK_MEMORY_BUDGET_SUPPORTED
+    if (m_LogicalVkDevice->GetEnabledExtFeatures().MemoryBudget)
+        BudgetQueried = m_PhysicalDevice->GetMemoryBudget(HeapBudget, HeapUsage);
+#endif
+
+    for (Uint32 heap = 0; heap < MemoryProps.memoryHeapCount; ++heap)
+    {
+        auto& Budget               = Budgets[heap];
+        Budget.EngineAllocatedSize = m_MemoryMgr.GetHeapAllocatedSize(heap);
+        Budget.IsDeviceLocal       = (MemoryProps.memoryHeaps[heap].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0;
+        if (BudgetQueried)
+        {
+            Budget.Budget = HeapBudget[heap];
+            Budget.Usage  = HeapUsage[heap];
+        }
+        else
+        {
+            Budget.Budget = MemoryProps.memoryHeaps[heap].size;
+            Budget.Usage  = Budget.EngineAllocatedSize;
+        }
+    }
+}
+
+MemoryHeapBudgetVk RenderDeviceVkImpl::GetMemoryHeapBudget(Uint32 HeapIndex)
+{
+    MemoryHeapBudgetVk Budgets[VK_MAX_MEMORY_HEAPS];
+    if (HeapIndex >= GetMemoryHeapCount())
+    {
+        UNEXPECTED("Heap index (", HeapIndex, ") is out of range");
+        return Budgets[0];
+    }
+    GetMemoryHeapBudgets(Budgets);
+    return Budgets[HeapIndex];
+}
+
+Uint32 RenderDeviceVkImpl::AddMemoryBudgetCallback(Float32 Threshold, MemoryBudgetCallbackType Callback, void* pUserData)
+{
+    DEV_CHECK_ERR(Callback != nullptr, "Callback must not be null");
+    DEV_CHECK_ERR(Threshold > 0, "Threshold (", Threshold, ") must be positive");
+
+    std::lock_guard<std::mutex> Lock{m_MemoryBudgetCallbacksMtx};
+
+    MemoryBudgetCallbackInfo CallbackInfo;
+    CallbackInfo.Id        = m_NextMemoryBudgetCallbackId++;
+    CallbackInfo.Threshold = Threshold;
+    CallbackInfo.Callback  = Callback;
+    CallbackInfo.pUserData = pUserData;
+    m_MemoryBudgetCallbacks.push_back(CallbackInfo);
+    return CallbackInfo.Id;
+}
+
+void RenderDeviceVkImpl::RemoveMemoryBudgetCallback(Uint32 CallbackId)
+{
+    std::lock_guard<std::mutex> Lock{m_MemoryBudgetCallbacksMtx};
+    for (auto it = m_MemoryBudgetCallbacks.begin(); it != m_MemoryBudgetCallbacks.end(); ++it)
+    {
+        if (it->Id == CallbackId)
+        {
+            m_MemoryBudgetCallbacks.erase(it);
+            return;
+        }
+    }
+    LOG_ERROR_MESSAGE("Memory budget callback ", CallbackId, " is not found");
+}
+
+Bool RenderDeviceVkImpl::CopyTexturesOnTransferQueue(IDeviceContext*           pImmediateContext,
+                                                     const CopyTextureAttribs* pCopyAttribs,
+                                                     Uint32                    NumCopies)
+{
+    if (!HasTransferQueue() || NumCopies == 0)
+        return false;
+
+    DEV_CHECK_ERR(pImmediateContext != nullptr, "Immediate context must not be null");
+    DEV_CHECK_ERR(pCopyAttribs != nullptr, "Copy attributes must not be null");
+
+    std::vector<TextureVkImpl*> DstTextures;
+    for (Uint32 i = 0; i < NumCopies; ++i)
+    {
+        const auto& CopyAttribs = pCopyAttribs[i];
+
+        auto* pSrcTexVk = ValidatedCast<TextureVkImpl>(CopyAttribs.pSrcTexture);
+        auto* pDstTexVk = ValidatedCast<TextureVkImpl>(CopyAttribs.pDstTexture);
+        DEV_CHECK_ERR(pSrcTexVk != nullptr && pDstTexVk != nullptr, "Source and destination textures must not be null");
+
+        const auto& SrcTexDesc = pSrcTexVk->GetDesc();
+        const auto& DstTexDesc = pDstTexVk->GetDesc();
+        if (SrcTexDesc.Usage != USAGE_STAGING || (SrcTexDesc.CPUAccessFlags & CPU_ACCESS_WRITE) == 0 || DstTexDesc.Usage == USAGE_STAGING)
+            return false;
+
+        // Queues from transfer families may have coarse image transfer granularity, but
+        // copying whole mip levels is always allowed (4.1)
+        if (CopyAttribs.pSrcBox != nullptr || CopyAttribs.DstX != 0 || CopyAttribs.DstY != 0 || CopyAttribs.DstZ != 0)
+            return false;
+
+        const auto SrcMipInfo = GetMipLevelProperties(SrcTexDesc, CopyAttribs.SrcMipLevel);
+        const auto DstMipInfo = GetMipLevelProperties(DstTexDesc, CopyAttribs.DstMipLevel);
+        if (SrcMipInfo.LogicalWidth != DstMipInfo.LogicalWidth || SrcMipInfo.LogicalHeight != DstMipInfo.LogicalHeight || SrcMipInfo.Depth != DstMipInfo.Depth)
+            return false;
+
+        const auto& FmtAttribs = GetTextureFormatAttribs(DstTexDesc.Format);
+        if (FmtAttribs.ComponentType == COMPONENT_TYPE_DEPTH || FmtAttribs.ComponentType == COMPONENT_TYPE_DEPTH_STENCIL)
+            return false;
+
+        // The state of the texture is required to transfer the ownership
+        if (!pDstTexVk->IsInKnownState() || pDstTexVk->IsTransient())
+            return false;
+
+        if (std::find(DstTextures.begin(), DstTextures.end(), pDstTexVk) == DstTextures.end())
+            DstTextures.push_back(pDstTexVk);
+    }
+
+    // All commands that use the destination textures must be submitted before the textures are released by the graphics queue
+    pImmediateContext->Flush();
+
+    std::vector<VkImageMemoryBarrier> ReleaseBarriers;  // Release the textures from the graphics queue
+    std::vector<VkImageMemoryBarrier> AcquireBarriers;  // Acquire the textures on the transfer queue
+    std::vector<VkImageMemoryBarrier> HandOverBarriers; // Hand the textures back to the graphics queue
+    for (auto* pDstTexVk : DstTextures)
+    {
+        VkImageMemoryBarrier Barrier = {};
+
+        Barrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        Barrier.image                           = pDstTexVk->GetVkImage();
+        Barrier.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+        Barrier.subresourceRange.baseMipLevel   = 0;
+        Barrier.subresourceRange.levelCount     = VK_REMAINING_MIP_LEVELS;
+        Barrier.subresourceRange.baseArrayLayer = 0;
+        Barrier.subresourceRange.layerCount     = VK_REMAINING_ARRAY_LAYERS;
+        Barrier.newLayout                       = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+
+        if (pDstTexVk->GetState() == RESOURCE_STATE_UNDEFINED)
+        {
+            // The contents of the texture are undefined, so the transfer queue
+            // can take the ownership without a release operation (6.7.4)
+            Barrier.oldLayout           = VK_IMAGE_LAYOUT_UNDEFINED;
+            Barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            Barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            Barrier.srcAccessMask       = 0;
+            Barrier.dstAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT;
+            AcquireBarriers.push_back(Barrier);
+        }
+        else
+        {
+            // The layout transition is performed once by the matching pair of barriers
+            Barrier.oldLayout           = pDstTexVk->GetLayout();
+            Barrier.srcQueueFamilyIndex = m_GraphicsQueueFamilyIndex;
+            Barrier.dstQueueFamilyIndex = m_TransferQueueFamilyIndex;
+            Barrier.srcAccessMask       = ResourceStateFlagsToVkAccessFlags(pDstTexVk->GetState());
+            Barrier.dstAccessMask       = 0;
+            ReleaseBarriers.push_back(Barrier);
+
+            Barrier.srcAccessMask = 0;
+            Barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            AcquireBarriers.push_back(Barrier);
+        }
+
+        Barrier.oldLayout           = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        Barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        Barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        Barrier.srcAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT;
+        Barrier.dstAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT;
+        HandOverBarriers.push_back(Barrier);
+    }
+
+    // The semaphore is signaled when the graphics queue has released the textures
+    auto ReleaseSemaphore = SubmitGraphicsQueueOwnershipTransfers(&ReleaseBarriers);
+
+    VulkanUtilities::CommandPoolWrapper CmdPool;
+    VkCommandBuffer                     vkCmdBuff = VK_NULL_HANDLE;
+    AllocateTransferCmdPool(CmdPool, vkCmdBuff, "Transfer command pool to copy staging textures");
+
+    vkCmdPipelineBarrier(vkCmdBuff, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+                         0, nullptr,
+                         0, nullptr,
+                         static_cast<uint32_t>(AcquireBarriers.size()), AcquireBarriers.data());
+
+    for (Uint32 i = 0; i < NumCopies; ++i)
+    {
+        const auto& CopyAttribs = pCopyAttribs[i];
+
+        auto*       pSrcTexVk  = ValidatedCast<TextureVkImpl>(CopyAttribs.pSrcTexture);
+        auto*       pDstTexVk  = ValidatedCast<TextureVkImpl>(CopyAttribs.pDstTexture);
+        const auto& SrcTexDesc = pSrcTexVk->GetDesc();
+        const auto  SrcMipInfo = GetMipLevelProperties(SrcTexDesc, CopyAttribs.SrcMipLevel);
+
+        VkBufferImageCopy CopyRegion = {};
+        CopyRegion.bufferOffset      = GetStagingTextureSubresourceOffset(SrcTexDesc, CopyAttribs.SrcSlice, CopyAttribs.SrcMipLevel, TextureVkImpl::StagingBufferOffsetAlignment);
+        // GetStagingTextureSubresourceOffset assumes texels are tightly packed
+        CopyRegion.bufferRowLength   = SrcMipInfo.StorageWidth;
+        CopyRegion.bufferImageHeight = 0;
+
+        CopyRegion.imageSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+        CopyRegion.imageSubresource.mipLevel       = CopyAttribs.DstMipLevel;
+        CopyRegion.imageSubresource.baseArrayLayer = CopyAttribs.DstSlice;
+        CopyRegion.imageSubresource.layerCount     = 1;
+        CopyRegion.imageOffset                     = VkOffset3D{0, 0, 0};
+        CopyRegion.imageExtent                     = VkExtent3D{SrcMipInfo.LogicalWidth, SrcMipInfo.LogicalHeight, SrcMipInfo.Depth};
+
+        vkCmdCopyBufferToImage(vkCmdBuff, pSrcTexVk->GetVkStagingBuffer(), pDstTexVk->GetVkImage(),
+                               VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &CopyRegion);
+    }
+
+    ExecuteAndDisposeTransferCmdBuff(vkCmdBuff, std::move(CmdPool), 0, nullptr,
+                                     static_cast<Uint32>(HandOverBarriers.size()), HandOverBarriers.data(),
+                                     std::move(ReleaseSemaphore));
+
+    // The textures will be acquired by the graphics queue in TRANSFER_DST_OPTIMAL layout
+    for (auto* pDstTexVk : DstTextures)
+        pDstTexVk->SetState(RESOURCE_STATE_COPY_DEST);
+
+    return true;
+}
+
+void RenderDeviceVkImpl::CheckMemoryBudget()
+{
+    struct PendingCall
+    {
+        MemoryBudgetCallbackType Callback;
+        void*                    pUserData;
+        Uint32                   HeapIndex;
+        bool                     OverThreshold;
+    };
+    std::vector<PendingCall> PendingCalls;
+
+    MemoryHeapBudgetVk Budgets[VK_MAX_MEMORY_HEAPS];
+    {
+        std::lock_guard<std::mutex> Lock{m_MemoryBudgetCallbacksMtx};
+        if (m_MemoryBudgetCallbacks.empty())
+            return;
+
+        GetMemoryHeapBudgets(Budgets);
+        const auto HeapCount = GetMemoryHeapCount();
+        for (auto& CallbackInfo : m_MemoryBudgetCallbacks)
+        {
+            for (Uint32 heap = 0; heap < HeapCount; ++heap)
+            {
+                const auto& Budget = Budgets[heap];
+
+                const bool OverThreshold = static_cast<double>(Budget.Usage) > static_cast<double>(Budget.Budget) * CallbackInfo.Threshold;
+                if (OverThreshold != CallbackInfo.IsOverThreshold[heap])
+                {
+                    CallbackInfo.IsOverThreshold[heap] = OverThreshold;
+                    PendingCalls.push_back({CallbackInfo.Callback, CallbackInfo.pUserData, heap, OverThreshold});
+                }
+            }
+        }
+    }
+
+    // Callbacks are called without holding the mutex as they may release device objects
+    for (const auto& Call : PendingCalls)
+        Call.Callback(Call.HeapIndex, Budgets[Call.HeapIndex], Call.OverThreshold, Call.pUserData);
+}
+
 void RenderDeviceVkImpl::CreateSampler(const SamplerDesc& SamplerDesc, ISampler** ppSampler)
 {
     CreateDeviceObject(
         "sampler", SamplerDesc, ppSampler,
         [&]() //
         {
-            m_SamplersRegistry.Find(SamplerDesc, reinterpret_cast<IDeviceObject**>(ppSampler));
+            const auto SamplerHash = m_SamplersRegistry.ComputeHash(SamplerDesc);
+            m_SamplersRegistry.Find(SamplerDesc, SamplerHash, reinterpret_cast<IDeviceObject**>(ppSampler));
             if (*ppSampler == nullptr)
             {
                 SamplerVkImpl* pSamplerVk(NEW_RC_OBJ(m_SamplerObjAllocator, "SamplerVkImpl instance", SamplerVkImpl)(this, SamplerDesc));
                 pSamplerVk->QueryInterface(IID_Sampler, reinterpret_cast<IObject**>(ppSampler));
                 OnCreateDeviceObject(pSamplerVk);
-                m_SamplersRegistry.Add(SamplerDesc, *ppSampler);
+                m_SamplersRegistry.Add(SamplerDesc, SamplerHash, *ppSampler);
             }
         } //
     );
@@ -736,9 +1412,25 @@ void RenderDeviceVkImpl::CreateRenderPass(const RenderPassDesc& Desc,
         "RenderPass", Desc, ppRenderPass,
         [&]() //
         {
-            RenderPassVkImpl* pRenderPassVk(NEW_RC_OBJ(m_RenderPassAllocator, "RenderPassVkImpl instance", RenderPassVkImpl)(this, Desc, IsDeviceInternal));
-            pRenderPassVk->QueryInterface(IID_RenderPass, reinterpret_cast<IObject**>(ppRenderPass));
-            OnCreateDeviceObject(pRenderPassVk);
+            ValidateRenderPassDesc(Desc);
+
+            // Internal render passes do not keep a strong reference to the device and
+            // must never be handed out to the application, so they bypass the registry.
+            size_t RenderPassHash = 0;
+            if (!IsDeviceInternal)
+            {
+                RenderPassHash = m_RenderPassRegistry.ComputeHash(Desc);
+                m_RenderPassRegistry.Find(Desc, RenderPassHash, reinterpret_cast<IDeviceObject**>(ppRenderPass));
+            }
+
+            if (*ppRenderPass == nullptr)
+            {
+                RenderPassVkImpl* pRenderPassVk(NEW_RC_OBJ(m_RenderPassAllocator, "RenderPassVkImpl instance", RenderPassVkImpl)(this, Desc, IsDeviceInternal));
+                pRenderPassVk->QueryInterface(IID_RenderPass, reinterpret_cast<IObject**>(ppRenderPass));
+                OnCreateDeviceObject(pRenderPassVk);
+                if (!IsDeviceInternal)
+                    m_RenderPassRegistry.Add(Desc, RenderPassHash, *ppRenderPass);
+            }
         } //
     );
 }
@@ -275,7 +275,10 @@ void ShaderResourceCacheVk::TransitionResources(DeviceContextVkImpl* pCtxVkImpl)
                             VERIFY_EXPR(ResourceStateToVkImageLayout(RequiredState) == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
                         }
                     }
-                    const bool IsInRequiredState = pTextureVk->CheckState(RequiredState);
+                    // Memory of a transient texture may have been taken over by an aliased resource,
+                    // in which case the texture must be transitioned even if its state matches.
+                    const bool IsInRequiredState = pTextureVk->CheckState(RequiredState) &&
+                        !(pTextureVk->IsTransient() && pTextureVk->IsTransientMemoryOverwritten());
 
                     if (VerifyOnly)
                     {
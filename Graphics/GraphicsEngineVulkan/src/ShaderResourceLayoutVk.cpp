@@ -40,6 +40,7 @@
 #include "StringTools.hpp"
 #include "PipelineStateVkImpl.hpp"
 #include "TopLevelASVkImpl.hpp"
+#include "RenderDeviceVkImpl.hpp"
 
 namespace Diligent
 {
@@ -300,7 +301,8 @@ static void VerifyResourceMerge(const ShaderResourceLayoutVk::VkResource& Existi
                   "' exists in multiple shaders from the same shader stage, but its resource dimension is not consistent between "
                   "shaders. All variables with the same name from the same shader stage must have the same resource dimension.");
 
-    DEV_CHECK_ERR(ExistingRes.ArraySize == NewResAttribs.ArraySize,
+    DEV_CHECK_ERR((NewResAttribs.ArraySize == 0) == ExistingRes.IsUpdateAfterBind() &&
+                      (ExistingRes.IsUpdateAfterBind() || ExistingRes.ArraySize == NewResAttribs.ArraySize),
                   "Shader variable '", NewResAttribs.Name,
                   "' exists in multiple shaders from the same shader stage, but its array size is not consistent between "
                   "shaders. All variables with the same name from the same shader stage must have the same array size.");
@@ -378,6 +380,7 @@ void ShaderResourceLayoutVk::InitializeStaticResourceLayout(const std::vector<co
                             *this,
                             stringPool.CopyString(Attribs.Name),
                             Attribs,
+                            Attribs.ArraySize,
                             VarType,
                             Binding,
                             DescriptorSet,
@@ -640,7 +643,36 @@ void ShaderResourceLayoutVk::Initialize(IRenderDevice*                    pRende
                 }
             }
 
-            PipelineLayout.AllocateResourceSlot(Attribs, VarType, vkImmutableSampler, Resources.GetShaderType(), DescriptorSet, Binding, CacheOffset);
+            // Runtime-sized arrays (e.g. Texture2D g_Textures[]) are placed into the update-after-bind set
+            // of the pipeline layout and are given the number of descriptors supported by the device.
+            Uint32 ArraySize = Attribs.ArraySize;
+            if (ArraySize == 0)
+            {
+                ArraySize = ValidatedCast<RenderDeviceVkImpl>(pRenderDevice)->GetRuntimeDescriptorArraySize();
+                if (ArraySize == 0)
+                {
+                    LOG_ERROR_AND_THROW("Shader variable '", Attribs.Name, "' in shader '", Resources.GetShaderName(),
+                                        "' is a runtime-sized array, which requires descriptor indexing. "
+                                        "Make sure that EngineVkCreateInfo::EnableDescriptorIndexing is true and the device supports update-after-bind descriptors.");
+                }
+                if (VarType != SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE)
+                {
+                    LOG_ERROR_AND_THROW("Runtime-sized array '", Attribs.Name, "' in shader '", Resources.GetShaderName(), "' is labeled as ",
+                                        GetShaderVariableTypeLiteralName(VarType), " variable. Runtime-sized arrays must be mutable.");
+                }
+                if (Attribs.Type != SPIRVShaderResourceAttribs::ResourceType::UniformTexelBuffer &&
+                    Attribs.Type != SPIRVShaderResourceAttribs::ResourceType::StorageTexelBuffer &&
+                    Attribs.Type != SPIRVShaderResourceAttribs::ResourceType::StorageImage &&
+                    Attribs.Type != SPIRVShaderResourceAttribs::ResourceType::SampledImage &&
+                    Attribs.Type != SPIRVShaderResourceAttribs::ResourceType::SeparateImage &&
+                    Attribs.Type != SPIRVShaderResourceAttribs::ResourceType::SeparateSampler)
+                {
+                    LOG_ERROR_AND_THROW("Runtime-sized array '", Attribs.Name, "' in shader '", Resources.GetShaderName(),
+                                        "' is not supported: only textures, texel buffers, storage images and samplers can be runtime-sized arrays.");
+                }
+            }
+
+            PipelineLayout.AllocateResourceSlot(Attribs, ArraySize, VarType, vkImmutableSampler, Resources.GetShaderType(), DescriptorSet, Binding, CacheOffset);
             VERIFY(DescriptorSet <= std::numeric_limits<decltype(VkResource::DescriptorSet)>::max(), "Descriptor set (", DescriptorSet, ") excceeds maximum representable value");
             VERIFY(Binding <= std::numeric_limits<decltype(VkResource::Binding)>::max(), "Binding (", Binding, ") excceeds maximum representable value");
 
@@ -663,6 +695,7 @@ void ShaderResourceLayoutVk::Initialize(IRenderDevice*                    pRende
                     ResLayout,
                     stringPools[ShaderStageInd].CopyString(Attribs.Name),
                     Attribs,
+                    ArraySize,
                     VarType,
                     Binding,
                     DescriptorSet,
@@ -826,7 +859,7 @@ bool ShaderResourceLayoutVk::VkResource::UpdateCachedResource(ShaderResourceCach
     // resource mapping can be of wrong type
     if (pObject)
     {
-        if (GetVariableType() != SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC && DstRes.pObject != nullptr)
+        if (GetRebindVariableType() != SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC && DstRes.pObject != nullptr)
         {
             // Do not update resource if one is already bound unless it is dynamic. This may be
             // dangerous as writing descriptors while they are used by the GPU is an undefined behavior
@@ -852,7 +885,7 @@ void ShaderResourceLayoutVk::VkResource::CacheUniformBuffer(IDeviceObject*
     VERIFY(Type == SPIRVShaderResourceAttribs::ResourceType::UniformBuffer, "Uniform buffer resource is expected");
     RefCntAutoPtr<BufferVkImpl> pBufferVk{pBuffer, IID_BufferVk};
 #ifdef DILIGENT_DEVELOPMENT
-    VerifyConstantBufferBinding(*this, GetVariableType(), ArrayInd, pBuffer, pBufferVk.RawPtr(), DstRes.pObject.RawPtr(), ParentResLayout.GetShaderName());
+    VerifyConstantBufferBinding(*this, GetRebindVariableType(), ArrayInd, pBuffer, pBufferVk.RawPtr(), DstRes.pObject.RawPtr(), ParentResLayout.GetShaderName());
 
     if (pBufferVk->GetDesc().uiSizeInBytes < BufferStaticSize)
     {
@@ -904,7 +937,7 @@ void ShaderResourceLayoutVk::VkResource::CacheStorageBuffer(IDeviceObject*
     {
         // HLSL buffer SRVs are mapped to storge buffers in GLSL
         auto RequiredViewType = Type == SPIRVShaderResourceAttribs::ResourceType::ROStorageBuffer ? BUFFER_VIEW_SHADER_RESOURCE : BUFFER_VIEW_UNORDERED_ACCESS;
-        VerifyResourceViewBinding(*this, GetVariableType(), ArrayInd, pBufferView, pBufferViewVk.RawPtr(), {RequiredViewType}, DstRes.pObject.RawPtr(), ParentResLayout.GetShaderName());
+        VerifyResourceViewBinding(*this, GetRebindVariableType(), ArrayInd, pBufferView, pBufferViewVk.RawPtr(), {RequiredViewType}, DstRes.pObject.RawPtr(), ParentResLayout.GetShaderName());
         if (pBufferViewVk != nullptr)
         {
             const auto& ViewDesc = pBufferViewVk->GetDesc();
@@ -978,7 +1011,7 @@ void ShaderResourceLayoutVk::VkResource::CacheTexelBuffer(IDeviceObject*
     {
         // HLSL buffer SRVs are mapped to storge buffers in GLSL
         auto RequiredViewType = Type == SPIRVShaderResourceAttribs::ResourceType::StorageTexelBuffer ? BUFFER_VIEW_UNORDERED_ACCESS : BUFFER_VIEW_SHADER_RESOURCE;
-        VerifyResourceViewBinding(*this, GetVariableType(), ArrayInd, pBufferView, pBufferViewVk.RawPtr(), {RequiredViewType}, DstRes.pObject.RawPtr(), ParentResLayout.GetShaderName());
+        VerifyResourceViewBinding(*this, GetRebindVariableType(), ArrayInd, pBufferView, pBufferViewVk.RawPtr(), {RequiredViewType}, DstRes.pObject.RawPtr(), ParentResLayout.GetShaderName());
         if (pBufferViewVk != nullptr)
         {
             const auto& ViewDesc = pBufferViewVk->GetDesc();
@@ -1037,7 +1070,7 @@ void ShaderResourceLayoutVk::VkResource::CacheImage(IDeviceObject*
     {
         // HLSL buffer SRVs are mapped to storge buffers in GLSL
         auto RequiredViewType = Type == SPIRVShaderResourceAttribs::ResourceType::StorageImage ? TEXTURE_VIEW_UNORDERED_ACCESS : TEXTURE_VIEW_SHADER_RESOURCE;
-        VerifyResourceViewBinding(*this, GetVariableType(), ArrayInd, pTexView, pTexViewVk0.RawPtr(), {RequiredViewType}, DstRes.pObject.RawPtr(), ParentResLayout.GetShaderName());
+        VerifyResourceViewBinding(*this, GetRebindVariableType(), ArrayInd, pTexView, pTexViewVk0.RawPtr(), {RequiredViewType}, DstRes.pObject.RawPtr(), ParentResLayout.GetShaderName());
     }
 #endif
     if (UpdateCachedResource(DstRes, std::move(pTexViewVk0), [](const TextureViewVkImpl*, const TextureViewVkImpl*) {}))
@@ -1103,7 +1136,7 @@ void ShaderResourceLayoutVk::VkResource::CacheSeparateSampler(IDeviceObject*
         LOG_ERROR_MESSAGE("Failed to bind object '", pSampler->GetDesc().Name, "' to variable '", GetPrintName(ArrayInd),
                           "' in shader '", ParentResLayout.GetShaderName(), "'. Unexpected object type: sampler is expected");
     }
-    if (GetVariableType() != SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC && DstRes.pObject != nullptr && DstRes.pObject != pSamplerVk)
+    if (GetRebindVariableType() != SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC && DstRes.pObject != nullptr && DstRes.pObject != pSamplerVk)
     {
         auto VarTypeStr = GetShaderVariableTypeLiteralName(GetVariableType());
         LOG_ERROR_MESSAGE("Non-null sampler is already bound to ", VarTypeStr, " shader variable '", GetPrintName(ArrayInd),
@@ -1132,7 +1165,7 @@ void ShaderResourceLayoutVk::VkResource::CacheInputAttachment(IDeviceObject*
     VERIFY(Type == SPIRVShaderResourceAttribs::ResourceType::InputAttachment, "Input attachment resource is expected");
     RefCntAutoPtr<TextureViewVkImpl> pTexViewVk0{pTexView, IID_TextureViewVk};
 #ifdef DILIGENT_DEVELOPMENT
-    VerifyResourceViewBinding(*this, GetVariableType(), ArrayInd, pTexView, pTexViewVk0.RawPtr(), {TEXTURE_VIEW_SHADER_RESOURCE}, DstRes.pObject.RawPtr(), ParentResLayout.GetShaderName());
+    VerifyResourceViewBinding(*this, GetRebindVariableType(), ArrayInd, pTexView, pTexViewVk0.RawPtr(), {TEXTURE_VIEW_SHADER_RESOURCE}, DstRes.pObject.RawPtr(), ParentResLayout.GetShaderName());
 #endif
     if (UpdateCachedResource(DstRes, std::move(pTexViewVk0), [](const TextureViewVkImpl*, const TextureViewVkImpl*) {}))
     {
@@ -1155,7 +1188,7 @@ void ShaderResourceLayoutVk::VkResource::CacheAccelerationStructure(IDeviceObjec
     VERIFY(Type == SPIRVShaderResourceAttribs::ResourceType::AccelerationStructure, "Acceleration Structure resource is expected");
     RefCntAutoPtr<TopLevelASVkImpl> pTLASVk{pTLAS, IID_TopLevelASVk};
 #ifdef DILIGENT_DEVELOPMENT
-    VerifyTLASResourceBinding(*this, GetVariableType(), ArrayInd, pTLASVk.RawPtr(), DstRes.pObject.RawPtr(), ParentResLayout.GetShaderName());
+    VerifyTLASResourceBinding(*this, GetRebindVariableType(), ArrayInd, pTLASVk.RawPtr(), DstRes.pObject.RawPtr(), ParentResLayout.GetShaderName());
 #endif
     if (UpdateCachedResource(DstRes, std::move(pTLASVk), [](const TopLevelASVkImpl*, const TopLevelASVkImpl*) {}))
     {
@@ -1260,7 +1293,9 @@ void ShaderResourceLayoutVk::VkResource::BindResource(IDeviceObject* pObj, Uint3
     }
     else
     {
-        if (DstRes.pObject && GetVariableType() != SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC)
+        // Descriptors of update-after-bind arrays are partially bound, so unbinding an element
+        // leaves the old descriptor in place. It is never accessed as long as the shader does not use the element.
+        if (DstRes.pObject && GetRebindVariableType() != SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC)
         {
             LOG_ERROR_MESSAGE("Shader variable '", Name, "' in shader '", ParentResLayout.GetShaderName(),
                               "' is not dynamic but being unbound. This is an error and may cause unpredicted behavior. "
@@ -1350,7 +1385,8 @@ bool ShaderResourceLayoutVk::dvpVerifyBindings(const ShaderResourceCacheVk& Reso
                 const auto& CachedDescrSet = ResourceCache.GetDescriptorSet(Res.DescriptorSet);
                 const auto& CachedRes      = CachedDescrSet.GetResource(Res.CacheOffset + ArrInd);
                 VERIFY(CachedRes.Type == Res.Type, "Inconsistent types");
-                if (CachedRes.pObject == nullptr &&
+                // Update-after-bind arrays are partially bound, so only the elements the shader accesses need to be valid
+                if (CachedRes.pObject == nullptr && !Res.IsUpdateAfterBind() &&
                     !(Res.Type == SPIRVShaderResourceAttribs::ResourceType::SeparateSampler && Res.IsImmutableSamplerAssigned()))
                 {
                     LOG_ERROR_MESSAGE("No resource is bound to ", GetShaderVariableTypeLiteralName(Res.GetVariableType()), " variable '", Res.GetPrintName(ArrInd), "' in shader '", GetShaderName(), "'");
@@ -1394,10 +1430,34 @@ void ShaderResourceLayoutVk::InitializeResourceMemoryInCache(ShaderResourceCache
 
 void ShaderResourceLayoutVk::CommitDynamicResources(const ShaderResourceCacheVk& ResourceCache,
                                                     VkDescriptorSet              vkDynamicDescriptorSet) const
+{
+    VERIFY_EXPR(vkDynamicDescriptorSet != VK_NULL_HANDLE);
+    WriteDynamicResourceDescriptors(ResourceCache, vkDynamicDescriptorSet,
+                                    [&](Uint32 DescrWriteCount, const VkWriteDescriptorSet* pDescrWrites) //
+                                    {
+                                        m_LogicalDevice.UpdateDescriptorSets(DescrWriteCount, pDescrWrites, 0, nullptr);
+                                    });
+}
+
+void ShaderResourceLayoutVk::CommitDynamicResources(const ShaderResourceCacheVk& ResourceCache,
+                                                    PushDescriptorWriter&        PushWriter) const
+{
+    // dstSet is ignored by vkCmdPushDescriptorSetKHR. The writes reference the local batch arrays
+    // of WriteDynamicResourceDescriptors(), so the writer copies them.
+    WriteDynamicResourceDescriptors(ResourceCache, VK_NULL_HANDLE,
+                                    [&](Uint32 DescrWriteCount, const VkWriteDescriptorSet* pDescrWrites) //
+                                    {
+                                        PushWriter.AddWrites(pDescrWrites, DescrWriteCount);
+                                    });
+}
+
+template <typename HandlerType>
+void ShaderResourceLayoutVk::WriteDynamicResourceDescriptors(const ShaderResourceCacheVk& ResourceCache,
+                                                             VkDescriptorSet              vkDynamicDescriptorSet,
+                                                             HandlerType                  FlushWrites) const
 {
     Uint32 NumDynamicResources = m_NumResources[SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC];
     VERIFY(NumDynamicResources != 0, "This shader resource layout does not contain dynamic resources");
-    VERIFY_EXPR(vkDynamicDescriptorSet != VK_NULL_HANDLE);
 
 #ifdef DILIGENT_DEBUG
     static constexpr size_t ImgUpdateBatchSize          = 4;
@@ -1445,8 +1505,7 @@ void ShaderResourceLayoutVk::CommitDynamicResources(const ShaderResourceCacheVk&
         WriteDescrSetIt->sType   = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
         WriteDescrSetIt->pNext   = nullptr;
         VERIFY(SetResources.GetVkDescriptorSet() == VK_NULL_HANDLE, "Dynamic descriptor set must not be assigned to the resource cache");
-        WriteDescrSetIt->dstSet = vkDynamicDescriptorSet;
-        VERIFY(WriteDescrSetIt->dstSet != VK_NULL_HANDLE, "Vulkan descriptor set must not be null");
+        WriteDescrSetIt->dstSet          = vkDynamicDescriptorSet;
         WriteDescrSetIt->dstBinding      = Res.Binding;
         WriteDescrSetIt->dstArrayElement = ArrElem;
         // descriptorType must be the same type as that specified in VkDescriptorSetLayoutBinding for dstSet at dstBinding.
@@ -1567,7 +1626,7 @@ void ShaderResourceLayoutVk::CommitDynamicResources(const ShaderResourceCacheVk&
         {
             auto DescrWriteCount = static_cast<Uint32>(std::distance(WriteDescrSetArr.begin(), WriteDescrSetIt));
             if (DescrWriteCount > 0)
-                m_LogicalDevice.UpdateDescriptorSets(DescrWriteCount, WriteDescrSetArr.data(), 0, nullptr);
+                FlushWrites(DescrWriteCount, WriteDescrSetArr.data());
 
             DescrImgIt      = DescrImgInfoArr.begin();
             DescrBuffIt     = DescrBuffInfoArr.begin();
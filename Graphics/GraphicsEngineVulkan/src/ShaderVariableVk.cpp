@@ -210,7 +210,8 @@ void ShaderVariableManagerVk::BindResources(IResourceMapping* pResourceMapping,
             }
             else
             {
-                if ((Flags & BIND_SHADER_RESOURCES_VERIFY_ALL_RESOLVED) && !Res.IsBound(ArrInd, m_ResourceCache))
+                // Update-after-bind arrays are partially bound and are not expected to be fully populated
+                if ((Flags & BIND_SHADER_RESOURCES_VERIFY_ALL_RESOLVED) && !Res.IsUpdateAfterBind() && !Res.IsBound(ArrInd, m_ResourceCache))
                 {
                     LOG_ERROR_MESSAGE("Unable to bind resource to shader variable '", Res.GetPrintName(ArrInd),
                                       "': resource is not found in the resource mapping. "
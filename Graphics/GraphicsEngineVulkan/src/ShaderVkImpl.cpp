@@ -45,7 +45,9 @@ namespace Diligent
 
 ShaderVkImpl::ShaderVkImpl(IReferenceCounters*     pRefCounters,
                            RenderDeviceVkImpl*     pRenderDeviceVk,
-                           const ShaderCreateInfo& ShaderCI) :
+                           const ShaderCreateInfo& ShaderCI,
+                           const void*             pSerializedResources,
+                           size_t                  SerializedResourcesSize) :
     // clang-format off
     TShaderBase
     {
@@ -167,17 +169,44 @@ ShaderVkImpl::ShaderVkImpl(IReferenceCounters*     pRefCounters,
     auto& Allocator        = GetRawAllocator();
     auto* pRawMem          = ALLOCATE(Allocator, "Allocator for ShaderResources", SPIRVShaderResources, 1);
     auto  LoadShaderInputs = m_Desc.ShaderType == SHADER_TYPE_VERTEX;
-    auto* pResources       = new (pRawMem) SPIRVShaderResources //
+    try
+    {
+        SPIRVShaderResources* pResources = nullptr;
+        if (pSerializedResources != nullptr)
+        {
+            DEV_CHECK_ERR(ShaderCI.ByteCode != nullptr, "Serialized resources can only be used with SPIRV byte code");
+            // Skip SPIRV reflection and load resources from the serialized data
+            pResources = new (pRawMem) SPIRVShaderResources //
+                {
+                    Allocator,
+                    pSerializedResources,
+                    SerializedResourcesSize,
+                    m_EntryPoint //
+                };
+        }
+        else
         {
-            Allocator,
-            pRenderDeviceVk,
-            m_SPIRV,
-            m_Desc,
-            ShaderCI.UseCombinedTextureSamplers ? ShaderCI.CombinedSamplerSuffix : nullptr,
-            LoadShaderInputs,
-            m_EntryPoint //
-        };
-    m_pShaderResources.reset(pResources, STDDeleterRawMem<SPIRVShaderResources>(Allocator));
+            pResources = new (pRawMem) SPIRVShaderResources //
+                {
+                    Allocator,
+                    pRenderDeviceVk,
+                    m_SPIRV,
+                    m_Desc,
+                    ShaderCI.UseCombinedTextureSamplers ? ShaderCI.CombinedSamplerSuffix : nullptr,
+                    LoadShaderInputs,
+                    m_EntryPoint //
+                };
+        }
+        m_pShaderResources.reset(pResources, STDDeleterRawMem<SPIRVShaderResources>(Allocator));
+    }
+    catch (...)
+    {
+        Allocator.Free(pRawMem);
+        throw;
+    }
+
+    if (pSerializedResources != nullptr)
+        ValidateSerializedResources();
 
     if (LoadShaderInputs && m_pShaderResources->IsHLSLSource())
     {
@@ -185,6 +214,43 @@ ShaderVkImpl::ShaderVkImpl(IReferenceCounters*     pRefCounters,
     }
 }
 
+void ShaderVkImpl::ValidateSerializedResources() const
+{
+    // Serialized resources are not reflected from the byte code, so they must be checked
+    // before the decoration offsets are used to patch the byte code.
+    if (m_pShaderResources->GetShaderType() != m_Desc.ShaderType)
+    {
+        LOG_ERROR_AND_THROW("Shader type of the serialized resources (", GetShaderTypeLiteralName(m_pShaderResources->GetShaderType()),
+                            ") does not match the type (", GetShaderTypeLiteralName(m_Desc.ShaderType), ") of shader '", m_Desc.Name, "'");
+    }
+
+    const size_t SPIRVSize = m_SPIRV.size();
+    for (Uint32 i = 0; i < m_pShaderResources->GetTotalResources(); ++i)
+    {
+        const auto& Res = m_pShaderResources->GetResource(i);
+        if (Res.BindingDecorationOffset >= SPIRVSize)
+        {
+            LOG_ERROR_AND_THROW("Binding decoration offset (", Res.BindingDecorationOffset, ") of resource '", Res.Name,
+                                "' in shader '", m_Desc.Name, "' exceeds the SPIRV size (", SPIRVSize, ")");
+        }
+        if (Res.DescriptorSetDecorationOffset >= SPIRVSize)
+        {
+            LOG_ERROR_AND_THROW("Descriptor set decoration offset (", Res.DescriptorSetDecorationOffset, ") of resource '", Res.Name,
+                                "' in shader '", m_Desc.Name, "' exceeds the SPIRV size (", SPIRVSize, ")");
+        }
+    }
+
+    for (Uint32 i = 0; i < m_pShaderResources->GetNumShaderStageInputs(); ++i)
+    {
+        const auto& Input = m_pShaderResources->GetShaderStageInputAttribs(i);
+        if (Input.LocationDecorationOffset >= SPIRVSize)
+        {
+            LOG_ERROR_AND_THROW("Location decoration offset (", Input.LocationDecorationOffset, ") of input '", Input.Semantic,
+                                "' in shader '", m_Desc.Name, "' exceeds the SPIRV size (", SPIRVSize, ")");
+        }
+    }
+}
+
 void ShaderVkImpl::MapHLSLVertexShaderInputs()
 {
     for (Uint32 i = 0; i < m_pShaderResources->GetNumShaderStageInputs(); ++i)
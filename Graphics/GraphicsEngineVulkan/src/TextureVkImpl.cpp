@@ -43,7 +43,9 @@ TextureVkImpl::TextureVkImpl(IReferenceCounters*        pRefCounters,
                              FixedBlockMemoryAllocator& TexViewObjAllocator,
                              RenderDeviceVkImpl*        pRenderDeviceVk,
                              const TextureDesc&         TexDesc,
-                             const TextureData*         pInitData /*= nullptr*/) :
+                             const TextureData*         pInitData /*= nullptr*/,
+                             Uint32                     TransientFirstUse /*= 0*/,
+                             Uint32                     TransientLastUse /*= ~Uint32{0}*/) :
     // clang-format off
     TTextureBase
     {
@@ -61,6 +63,25 @@ TextureVkImpl::TextureVkImpl(IReferenceCounters*        pRefCounters,
     const auto& LogicalDevice = pRenderDeviceVk->GetLogicalDevice();
 
     const bool bInitializeTexture = (pInitData != nullptr && pInitData->pSubResources != nullptr && pInitData->NumSubresources > 0);
+
+    const bool bTransient = (m_Desc.MiscFlags & MISC_TEXTURE_FLAG_TRANSIENT) != 0;
+    if (bTransient && bInitializeTexture)
+        LOG_ERROR_AND_THROW("Transient textures can't be initialized with data");
+    if (TransientFirstUse > TransientLastUse)
+        LOG_ERROR_AND_THROW("Transient texture usage interval [", TransientFirstUse, ", ", TransientLastUse, "] is invalid");
+
+    // Transient attachments that are never accessed outside of a render pass may use lazily
+    // allocated memory, which on tiled GPUs may never be backed by physical memory.
+    bool bUseLazyMemory = false;
+    if (bTransient &&
+        (m_Desc.BindFlags & ~(BIND_RENDER_TARGET | BIND_DEPTH_STENCIL | BIND_INPUT_ATTACHMENT)) == 0 &&
+        (m_Desc.BindFlags & (BIND_RENDER_TARGET | BIND_DEPTH_STENCIL)) != 0 &&
+        (m_Desc.MiscFlags & MISC_TEXTURE_FLAG_GENERATE_MIPS) == 0)
+    {
+        const auto& MemoryProps = pRenderDeviceVk->GetPhysicalDevice().GetMemoryProperties();
+        for (uint32_t i = 0; i < MemoryProps.memoryTypeCount && !bUseLazyMemory; ++i)
+            bUseLazyMemory = (MemoryProps.memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT) != 0;
+    }
     if (m_Desc.Usage == USAGE_IMMUTABLE || m_Desc.Usage == USAGE_DEFAULT || m_Desc.Usage == USAGE_DYNAMIC)
     {
         VkImageCreateInfo ImageCI = {};
@@ -121,16 +142,23 @@ TextureVkImpl::TextureVkImpl(IReferenceCounters*        pRefCounters,
         ImageCI.samples = static_cast<VkSampleCountFlagBits>(m_Desc.SampleCount);
         ImageCI.tiling  = VK_IMAGE_TILING_OPTIMAL;
 
-        ImageCI.usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+        // Transient attachments can't be used with any other usage than attachment usages
+        ImageCI.usage = bUseLazyMemory ?
+            VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT :
+            VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
         if (m_Desc.BindFlags & BIND_RENDER_TARGET)
         {
             // VK_IMAGE_USAGE_TRANSFER_DST_BIT is required for vkCmdClearColorImage()
-            ImageCI.usage |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+            ImageCI.usage |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+            if (!bUseLazyMemory)
+                ImageCI.usage |= VK_IMAGE_USAGE_TRANSFER_DST_BIT;
         }
         if (m_Desc.BindFlags & BIND_DEPTH_STENCIL)
         {
             // VK_IMAGE_USAGE_TRANSFER_DST_BIT is required for vkCmdClearDepthStencilImage()
-            ImageCI.usage |= VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+            ImageCI.usage |= VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+            if (!bUseLazyMemory)
+                ImageCI.usage |= VK_IMAGE_USAGE_TRANSFER_DST_BIT;
         }
         if (m_Desc.BindFlags & BIND_UNORDERED_ACCESS)
         {
@@ -168,9 +196,20 @@ TextureVkImpl::TextureVkImpl(IReferenceCounters*        pRefCounters,
             }
         }
 
-        ImageCI.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
-        ImageCI.queueFamilyIndexCount = 0;
-        ImageCI.pQueueFamilyIndices   = nullptr;
+        // Images that may be accessed by compute contexts are shared by all queue families that use them
+        const auto& ConcurrentQueueFamilies = pRenderDeviceVk->GetConcurrentQueueFamilies();
+        if (!ConcurrentQueueFamilies.empty())
+        {
+            ImageCI.sharingMode           = VK_SHARING_MODE_CONCURRENT;
+            ImageCI.queueFamilyIndexCount = static_cast<uint32_t>(ConcurrentQueueFamilies.size());
+            ImageCI.pQueueFamilyIndices   = ConcurrentQueueFamilies.data();
+        }
+        else
+        {
+            ImageCI.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
+            ImageCI.queueFamilyIndexCount = 0;
+            ImageCI.pQueueFamilyIndices   = nullptr;
+        }
 
         // initialLayout must be either VK_IMAGE_LAYOUT_UNDEFINED or VK_IMAGE_LAYOUT_PREINITIALIZED (11.4)
         // If it is VK_IMAGE_LAYOUT_PREINITIALIZED, then the image data can be preinitialized by the host
@@ -190,7 +229,20 @@ TextureVkImpl::TextureVkImpl(IReferenceCounters*        pRefCounters,
             ImageMemoryFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
 
         VERIFY(IsPowerOfTwo(MemReqs.alignment), "Alignment is not power of 2!");
-        m_MemoryAllocation = pRenderDeviceVk->AllocateMemory(MemReqs, ImageMemoryFlags);
+        if (bTransient)
+        {
+            if (bUseLazyMemory)
+            {
+                const auto LazyMemoryFlags = ImageMemoryFlags | VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;
+                if (pRenderDeviceVk->GetPhysicalDevice().GetMemoryTypeIndex(MemReqs.memoryTypeBits, LazyMemoryFlags) != VulkanUtilities::VulkanPhysicalDevice::InvalidMemoryTypeIndex)
+                    ImageMemoryFlags = LazyMemoryFlags;
+            }
+            m_MemoryAllocation = pRenderDeviceVk->AllocateTransientMemory(MemReqs, ImageMemoryFlags, TransientFirstUse, TransientLastUse);
+        }
+        else
+        {
+            m_MemoryAllocation = pRenderDeviceVk->AllocateMemory(MemReqs, ImageMemoryFlags);
+        }
         auto AlignedOffset = Align(m_MemoryAllocation.UnalignedOffset, MemReqs.alignment);
         VERIFY_EXPR(m_MemoryAllocation.Size >= MemReqs.size + (AlignedOffset - m_MemoryAllocation.UnalignedOffset));
         auto Memory = m_MemoryAllocation.Page->GetVkMemory();
@@ -198,206 +250,240 @@ TextureVkImpl::TextureVkImpl(IReferenceCounters*        pRefCounters,
         CHECK_VK_ERROR_AND_THROW(err, "Failed to bind image memory");
 
 
-        // Vulkan validation layers do not like uninitialized memory, so if no initial data
-        // is provided, we will clear the memory
-
-        VulkanUtilities::CommandPoolWrapper CmdPool;
-        VkCommandBuffer                     vkCmdBuff;
-        pRenderDeviceVk->AllocateTransientCmdPool(CmdPool, vkCmdBuff, "Transient command pool to copy staging data to a device buffer");
-
-        VkImageAspectFlags aspectMask = 0;
-        if (FmtAttribs.ComponentType == COMPONENT_TYPE_DEPTH)
-            aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
-        else if (FmtAttribs.ComponentType == COMPONENT_TYPE_DEPTH_STENCIL)
+        if (bTransient)
         {
-            if (bInitializeTexture)
-            {
-                UNSUPPORTED("Initializing depth-stencil texture is not currently supported");
-                // Only single aspect bit must be specified when copying texture data
-            }
-            aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+            // Memory of a transient texture may be shared with other transient textures, so its
+            // contents are undefined until the texture is first used in its interval.
+            SetState(RESOURCE_STATE_UNDEFINED);
         }
         else
-            aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-
-        // For either clear or copy command, dst layout must be VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
-        VkImageSubresourceRange SubresRange;
-        SubresRange.aspectMask     = aspectMask;
-        SubresRange.baseArrayLayer = 0;
-        SubresRange.layerCount     = VK_REMAINING_ARRAY_LAYERS;
-        SubresRange.baseMipLevel   = 0;
-        SubresRange.levelCount     = VK_REMAINING_MIP_LEVELS;
-        auto EnabledShaderStages   = LogicalDevice.GetEnabledShaderStages();
-        VulkanUtilities::VulkanCommandBuffer::TransitionImageLayout(vkCmdBuff, m_VulkanImage, ImageCI.initialLayout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, SubresRange, EnabledShaderStages);
-        SetState(RESOURCE_STATE_COPY_DEST);
-        const auto CurrentLayout = GetLayout();
-        VERIFY_EXPR(CurrentLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-
-        if (bInitializeTexture)
         {
-            Uint32 ExpectedNumSubresources = ImageCI.mipLevels * ImageCI.arrayLayers;
-            if (pInitData->NumSubresources != ExpectedNumSubresources)
-                LOG_ERROR_AND_THROW("Incorrect number of subresources in init data. ", ExpectedNumSubresources, " expected, while ", pInitData->NumSubresources, " provided");
+            // Vulkan validation layers do not like uninitialized memory, so if no initial data
+            // is provided, we will clear the memory
 
-            std::vector<VkBufferImageCopy> Regions(pInitData->NumSubresources);
+            // Initial data is uploaded on the dedicated transfer queue, if there is one. Clear commands
+            // are not supported by transfer queues and are always executed on the graphics queue.
+            const bool UseTransferQueue = bInitializeTexture && pRenderDeviceVk->HasTransferQueue();
 
-            Uint64 uploadBufferSize = 0;
-            Uint32 subres           = 0;
-            for (Uint32 layer = 0; layer < ImageCI.arrayLayers; ++layer)
+            VulkanUtilities::CommandPoolWrapper CmdPool;
+            VkCommandBuffer                     vkCmdBuff;
+            if (UseTransferQueue)
+                pRenderDeviceVk->AllocateTransferCmdPool(CmdPool, vkCmdBuff, "Transfer command pool to copy staging data to a texture");
+            else
+                pRenderDeviceVk->AllocateTransientCmdPool(CmdPool, vkCmdBuff, "Transient command pool to copy staging data to a device buffer");
+
+            VkImageAspectFlags aspectMask = 0;
+            if (FmtAttribs.ComponentType == COMPONENT_TYPE_DEPTH)
+                aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+            else if (FmtAttribs.ComponentType == COMPONENT_TYPE_DEPTH_STENCIL)
             {
-                for (Uint32 mip = 0; mip < ImageCI.mipLevels; ++mip)
+                if (bInitializeTexture)
                 {
-                    const auto& SubResData = pInitData->pSubResources[subres];
-                    (void)SubResData;
-                    auto& CopyRegion = Regions[subres];
-
-                    auto MipInfo = GetMipLevelProperties(m_Desc, mip);
-
-                    CopyRegion.bufferOffset = uploadBufferSize; // offset in bytes from the start of the buffer object
-                    // bufferRowLength and bufferImageHeight specify the data in buffer memory as a subregion
-                    // of a larger two- or three-dimensional image, and control the addressing calculations of
-                    // data in buffer memory. If either of these values is zero, that aspect of the buffer memory
-                    // is considered to be tightly packed according to the imageExtent. (18.4)
-                    CopyRegion.bufferRowLength   = 0;
-                    CopyRegion.bufferImageHeight = 0;
-                    // For block-compression formats, all parameters are still specified in texels rather than compressed texel blocks (18.4.1)
-                    CopyRegion.imageOffset = VkOffset3D{0, 0, 0};
-                    CopyRegion.imageExtent = VkExtent3D{MipInfo.LogicalWidth, MipInfo.LogicalHeight, MipInfo.Depth};
-
-                    CopyRegion.imageSubresource.aspectMask     = aspectMask;
-                    CopyRegion.imageSubresource.mipLevel       = mip;
-                    CopyRegion.imageSubresource.baseArrayLayer = layer;
-                    CopyRegion.imageSubresource.layerCount     = 1;
-
-                    VERIFY(SubResData.Stride == 0 || SubResData.Stride >= MipInfo.RowSize, "Stride is too small");
-                    // For compressed-block formats, MipInfo.RowSize is the size of one row of blocks
-                    VERIFY(SubResData.DepthStride == 0 || SubResData.DepthStride >= (MipInfo.StorageHeight / FmtAttribs.BlockHeight) * MipInfo.RowSize, "Depth stride is too small");
-
-                    // bufferOffset must be a multiple of 4 (18.4)
-                    // If the calling command's VkImage parameter is a compressed image, bufferOffset
-                    // must be a multiple of the compressed texel block size in bytes (18.4). This
-                    // is automatically guaranteed as MipWidth and MipHeight are rounded to block size
-                    uploadBufferSize += (MipInfo.MipSize + 3) & (~3);
-                    ++subres;
+                    UNSUPPORTED("Initializing depth-stencil texture is not currently supported");
+                    // Only single aspect bit must be specified when copying texture data
                 }
+                aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
             }
-            VERIFY_EXPR(subres == pInitData->NumSubresources);
-
-            VkBufferCreateInfo VkStagingBuffCI    = {};
-            VkStagingBuffCI.sType                 = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-            VkStagingBuffCI.pNext                 = nullptr;
-            VkStagingBuffCI.flags                 = 0;
-            VkStagingBuffCI.size                  = uploadBufferSize;
-            VkStagingBuffCI.usage                 = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-            VkStagingBuffCI.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
-            VkStagingBuffCI.queueFamilyIndexCount = 0;
-            VkStagingBuffCI.pQueueFamilyIndices   = nullptr;
-
-            std::string StagingBufferName = "Upload buffer for '";
-            StagingBufferName += m_Desc.Name;
-            StagingBufferName += '\'';
-            VulkanUtilities::BufferWrapper StagingBuffer = LogicalDevice.CreateBuffer(VkStagingBuffCI, StagingBufferName.c_str());
+            else
+                aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+
+            // For either clear or copy command, dst layout must be VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
+            VkImageSubresourceRange SubresRange;
+            SubresRange.aspectMask     = aspectMask;
+            SubresRange.baseArrayLayer = 0;
+            SubresRange.layerCount     = VK_REMAINING_ARRAY_LAYERS;
+            SubresRange.baseMipLevel   = 0;
+            SubresRange.levelCount     = VK_REMAINING_MIP_LEVELS;
+            auto EnabledShaderStages   = LogicalDevice.GetEnabledShaderStages();
+            VulkanUtilities::VulkanCommandBuffer::TransitionImageLayout(vkCmdBuff, m_VulkanImage, ImageCI.initialLayout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, SubresRange, EnabledShaderStages);
+            SetState(RESOURCE_STATE_COPY_DEST);
+            const auto CurrentLayout = GetLayout();
+            VERIFY_EXPR(CurrentLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
 
-            VkMemoryRequirements StagingBufferMemReqs = LogicalDevice.GetBufferMemoryRequirements(StagingBuffer);
-            VERIFY(IsPowerOfTwo(StagingBufferMemReqs.alignment), "Alignment is not power of 2!");
-            // VK_MEMORY_PROPERTY_HOST_COHERENT_BIT bit specifies that the host cache management commands vkFlushMappedMemoryRanges
-            // and vkInvalidateMappedMemoryRanges are NOT needed to flush host writes to the device or make device writes visible
-            // to the host (10.2)
-            auto StagingMemoryAllocation = pRenderDeviceVk->AllocateMemory(StagingBufferMemReqs, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-            auto StagingBufferMemory     = StagingMemoryAllocation.Page->GetVkMemory();
-            auto AlignedStagingMemOffset = Align(StagingMemoryAllocation.UnalignedOffset, StagingBufferMemReqs.alignment);
-            VERIFY_EXPR(StagingMemoryAllocation.Size >= StagingBufferMemReqs.size + (AlignedStagingMemOffset - StagingMemoryAllocation.UnalignedOffset));
+            if (bInitializeTexture)
+            {
+                Uint32 ExpectedNumSubresources = ImageCI.mipLevels * ImageCI.arrayLayers;
+                if (pInitData->NumSubresources != ExpectedNumSubresources)
+                    LOG_ERROR_AND_THROW("Incorrect number of subresources in init data. ", ExpectedNumSubresources, " expected, while ", pInitData->NumSubresources, " provided");
 
-            auto* StagingData = reinterpret_cast<uint8_t*>(StagingMemoryAllocation.Page->GetCPUMemory());
-            VERIFY_EXPR(StagingData != nullptr);
-            StagingData += AlignedStagingMemOffset;
+                std::vector<VkBufferImageCopy> Regions(pInitData->NumSubresources);
 
-            subres = 0;
-            for (Uint32 layer = 0; layer < ImageCI.arrayLayers; ++layer)
-            {
-                for (Uint32 mip = 0; mip < ImageCI.mipLevels; ++mip)
+                Uint64 uploadBufferSize = 0;
+                Uint32 subres           = 0;
+                for (Uint32 layer = 0; layer < ImageCI.arrayLayers; ++layer)
+                {
+                    for (Uint32 mip = 0; mip < ImageCI.mipLevels; ++mip)
+                    {
+                        const auto& SubResData = pInitData->pSubResources[subres];
+                        (void)SubResData;
+                        auto& CopyRegion = Regions[subres];
+
+                        auto MipInfo = GetMipLevelProperties(m_Desc, mip);
+
+                        CopyRegion.bufferOffset = uploadBufferSize; // offset in bytes from the start of the buffer object
+                        // bufferRowLength and bufferImageHeight specify the data in buffer memory as a subregion
+                        // of a larger two- or three-dimensional image, and control the addressing calculations of
+                        // data in buffer memory. If either of these values is zero, that aspect of the buffer memory
+                        // is considered to be tightly packed according to the imageExtent. (18.4)
+                        CopyRegion.bufferRowLength   = 0;
+                        CopyRegion.bufferImageHeight = 0;
+                        // For block-compression formats, all parameters are still specified in texels rather than compressed texel blocks (18.4.1)
+                        CopyRegion.imageOffset = VkOffset3D{0, 0, 0};
+                        CopyRegion.imageExtent = VkExtent3D{MipInfo.LogicalWidth, MipInfo.LogicalHeight, MipInfo.Depth};
+
+                        CopyRegion.imageSubresource.aspectMask     = aspectMask;
+                        CopyRegion.imageSubresource.mipLevel       = mip;
+                        CopyRegion.imageSubresource.baseArrayLayer = layer;
+                        CopyRegion.imageSubresource.layerCount     = 1;
+
+                        VERIFY(SubResData.Stride == 0 || SubResData.Stride >= MipInfo.RowSize, "Stride is too small");
+                        // For compressed-block formats, MipInfo.RowSize is the size of one row of blocks
+                        VERIFY(SubResData.DepthStride == 0 || SubResData.DepthStride >= (MipInfo.StorageHeight / FmtAttribs.BlockHeight) * MipInfo.RowSize, "Depth stride is too small");
+
+                        // bufferOffset must be a multiple of 4 (18.4)
+                        // If the calling command's VkImage parameter is a compressed image, bufferOffset
+                        // must be a multiple of the compressed texel block size in bytes (18.4). This
+                        // is automatically guaranteed as MipWidth and MipHeight are rounded to block size
+                        uploadBufferSize += (MipInfo.MipSize + 3) & (~3);
+                        ++subres;
+                    }
+                }
+                VERIFY_EXPR(subres == pInitData->NumSubresources);
+
+                VkBufferCreateInfo VkStagingBuffCI    = {};
+                VkStagingBuffCI.sType                 = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+                VkStagingBuffCI.pNext                 = nullptr;
+                VkStagingBuffCI.flags                 = 0;
+                VkStagingBuffCI.size                  = uploadBufferSize;
+                VkStagingBuffCI.usage                 = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+                VkStagingBuffCI.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
+                VkStagingBuffCI.queueFamilyIndexCount = 0;
+                VkStagingBuffCI.pQueueFamilyIndices   = nullptr;
+
+                std::string StagingBufferName = "Upload buffer for '";
+                StagingBufferName += m_Desc.Name;
+                StagingBufferName += '\'';
+                VulkanUtilities::BufferWrapper StagingBuffer = LogicalDevice.CreateBuffer(VkStagingBuffCI, StagingBufferName.c_str());
+
+                VkMemoryRequirements StagingBufferMemReqs = LogicalDevice.GetBufferMemoryRequirements(StagingBuffer);
+                VERIFY(IsPowerOfTwo(StagingBufferMemReqs.alignment), "Alignment is not power of 2!");
+                // VK_MEMORY_PROPERTY_HOST_COHERENT_BIT bit specifies that the host cache management commands vkFlushMappedMemoryRanges
+                // and vkInvalidateMappedMemoryRanges are NOT needed to flush host writes to the device or make device writes visible
+                // to the host (10.2)
+                auto StagingMemoryAllocation = pRenderDeviceVk->AllocateMemory(StagingBufferMemReqs, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+                auto StagingBufferMemory     = StagingMemoryAllocation.Page->GetVkMemory();
+                auto AlignedStagingMemOffset = Align(StagingMemoryAllocation.UnalignedOffset, StagingBufferMemReqs.alignment);
+                VERIFY_EXPR(StagingMemoryAllocation.Size >= StagingBufferMemReqs.size + (AlignedStagingMemOffset - StagingMemoryAllocation.UnalignedOffset));
+
+                auto* StagingData = reinterpret_cast<uint8_t*>(StagingMemoryAllocation.Page->GetCPUMemory());
+                VERIFY_EXPR(StagingData != nullptr);
+                StagingData += AlignedStagingMemOffset;
+
+                subres = 0;
+                for (Uint32 layer = 0; layer < ImageCI.arrayLayers; ++layer)
                 {
-                    const auto& SubResData = pInitData->pSubResources[subres];
-                    const auto& CopyRegion = Regions[subres];
+                    for (Uint32 mip = 0; mip < ImageCI.mipLevels; ++mip)
+                    {
+                        const auto& SubResData = pInitData->pSubResources[subres];
+                        const auto& CopyRegion = Regions[subres];
 
-                    auto MipInfo = GetMipLevelProperties(m_Desc, mip);
+                        auto MipInfo = GetMipLevelProperties(m_Desc, mip);
 
-                    VERIFY_EXPR(MipInfo.LogicalWidth == CopyRegion.imageExtent.width);
-                    VERIFY_EXPR(MipInfo.LogicalHeight == CopyRegion.imageExtent.height);
-                    VERIFY_EXPR(MipInfo.Depth == CopyRegion.imageExtent.depth);
+                        VERIFY_EXPR(MipInfo.LogicalWidth == CopyRegion.imageExtent.width);
+                        VERIFY_EXPR(MipInfo.LogicalHeight == CopyRegion.imageExtent.height);
+                        VERIFY_EXPR(MipInfo.Depth == CopyRegion.imageExtent.depth);
 
-                    VERIFY(SubResData.Stride == 0 || SubResData.Stride >= MipInfo.RowSize, "Stride is too small");
-                    // For compressed-block formats, MipInfo.RowSize is the size of one row of blocks
-                    VERIFY(SubResData.DepthStride == 0 || SubResData.DepthStride >= (MipInfo.StorageHeight / FmtAttribs.BlockHeight) * MipInfo.RowSize, "Depth stride is too small");
+                        VERIFY(SubResData.Stride == 0 || SubResData.Stride >= MipInfo.RowSize, "Stride is too small");
+                        // For compressed-block formats, MipInfo.RowSize is the size of one row of blocks
+                        VERIFY(SubResData.DepthStride == 0 || SubResData.DepthStride >= (MipInfo.StorageHeight / FmtAttribs.BlockHeight) * MipInfo.RowSize, "Depth stride is too small");
 
-                    for (Uint32 z = 0; z < MipInfo.Depth; ++z)
-                    {
-                        for (Uint32 y = 0; y < MipInfo.StorageHeight; y += FmtAttribs.BlockHeight)
+                        for (Uint32 z = 0; z < MipInfo.Depth; ++z)
                         {
-                            memcpy(StagingData + CopyRegion.bufferOffset + ((y + z * MipInfo.StorageHeight) / FmtAttribs.BlockHeight) * MipInfo.RowSize,
-                                   // SubResData.Stride must be the stride of one row of compressed blocks
-                                   reinterpret_cast<const uint8_t*>(SubResData.pData) + (y / FmtAttribs.BlockHeight) * SubResData.Stride + z * SubResData.DepthStride,
-                                   MipInfo.RowSize);
+                            for (Uint32 y = 0; y < MipInfo.StorageHeight; y += FmtAttribs.BlockHeight)
+                            {
+                                memcpy(StagingData + CopyRegion.bufferOffset + ((y + z * MipInfo.StorageHeight) / FmtAttribs.BlockHeight) * MipInfo.RowSize,
+                                       // SubResData.Stride must be the stride of one row of compressed blocks
+                                       reinterpret_cast<const uint8_t*>(SubResData.pData) + (y / FmtAttribs.BlockHeight) * SubResData.Stride + z * SubResData.DepthStride,
+                                       MipInfo.RowSize);
+                            }
                         }
-                    }
 
-                    ++subres;
+                        ++subres;
+                    }
                 }
-            }
-            VERIFY_EXPR(subres == pInitData->NumSubresources);
-
-            err = LogicalDevice.BindBufferMemory(StagingBuffer, StagingBufferMemory, AlignedStagingMemOffset);
-            CHECK_VK_ERROR_AND_THROW(err, "Failed to bind staging bufer memory");
+                VERIFY_EXPR(subres == pInitData->NumSubresources);
 
-            VulkanUtilities::VulkanCommandBuffer::BufferMemoryBarrier(vkCmdBuff, StagingBuffer, 0, VK_ACCESS_TRANSFER_READ_BIT, EnabledShaderStages);
+                err = LogicalDevice.BindBufferMemory(StagingBuffer, StagingBufferMemory, AlignedStagingMemOffset);
+                CHECK_VK_ERROR_AND_THROW(err, "Failed to bind staging bufer memory");
 
-            // Copy commands MUST be recorded outside of a render pass instance. This is OK here
-            // as copy will be the only command in the cmd buffer
-            vkCmdCopyBufferToImage(vkCmdBuff, StagingBuffer, m_VulkanImage,
-                                   CurrentLayout, // dstImageLayout must be VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL or VK_IMAGE_LAYOUT_GENERAL (18.4)
-                                   static_cast<uint32_t>(Regions.size()), Regions.data());
+                VulkanUtilities::VulkanCommandBuffer::BufferMemoryBarrier(vkCmdBuff, StagingBuffer, 0, VK_ACCESS_TRANSFER_READ_BIT, EnabledShaderStages);
 
-            Uint32 QueueIndex = 0;
-            pRenderDeviceVk->ExecuteAndDisposeTransientCmdBuff(QueueIndex, vkCmdBuff, std::move(CmdPool));
+                // Copy commands MUST be recorded outside of a render pass instance. This is OK here
+                // as copy will be the only command in the cmd buffer
+                vkCmdCopyBufferToImage(vkCmdBuff, StagingBuffer, m_VulkanImage,
+                                       CurrentLayout, // dstImageLayout must be VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL or VK_IMAGE_LAYOUT_GENERAL (18.4)
+                                       static_cast<uint32_t>(Regions.size()), Regions.data());
 
-            // After command buffer is submitted, safe-release resources. This strategy
-            // is little overconservative as the resources will be released after the first
-            // command buffer submitted through the immediate context will be completed
-            pRenderDeviceVk->SafeReleaseDeviceObject(std::move(StagingBuffer), Uint64{1} << Uint64{QueueIndex});
-            pRenderDeviceVk->SafeReleaseDeviceObject(std::move(StagingMemoryAllocation), Uint64{1} << Uint64{QueueIndex});
-        }
-        else
-        {
-            VkImageSubresourceRange Subresource;
-            Subresource.aspectMask     = aspectMask;
-            Subresource.baseMipLevel   = 0;
-            Subresource.levelCount     = VK_REMAINING_MIP_LEVELS;
-            Subresource.baseArrayLayer = 0;
-            Subresource.layerCount     = VK_REMAINING_ARRAY_LAYERS;
-            if (aspectMask == VK_IMAGE_ASPECT_COLOR_BIT)
-            {
-                if (FmtAttribs.ComponentType != COMPONENT_TYPE_COMPRESSED)
+                Uint32 QueueIndex = 0;
+                if (UseTransferQueue)
                 {
-                    VkClearColorValue ClearColor = {};
-                    vkCmdClearColorImage(vkCmdBuff, m_VulkanImage,
-                                         CurrentLayout, // must be VK_IMAGE_LAYOUT_GENERAL or VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
-                                         &ClearColor, 1, &Subresource);
+                    // Hand the texture over to the graphics queue
+                    VkImageMemoryBarrier OwnershipBarrier = {};
+                    OwnershipBarrier.sType                = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+                    OwnershipBarrier.srcAccessMask        = VK_ACCESS_TRANSFER_WRITE_BIT;
+                    OwnershipBarrier.dstAccessMask        = VK_ACCESS_TRANSFER_WRITE_BIT;
+                    OwnershipBarrier.oldLayout            = CurrentLayout;
+                    OwnershipBarrier.newLayout            = CurrentLayout;
+                    OwnershipBarrier.image                = m_VulkanImage;
+                    OwnershipBarrier.subresourceRange     = SubresRange;
+
+                    QueueIndex = pRenderDeviceVk->GetTransferQueueIndex();
+                    pRenderDeviceVk->ExecuteAndDisposeTransferCmdBuff(vkCmdBuff, std::move(CmdPool), 0, nullptr, 1, &OwnershipBarrier);
                 }
-            }
-            else if (aspectMask == VK_IMAGE_ASPECT_DEPTH_BIT ||
-                     aspectMask == (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT))
-            {
-                VkClearDepthStencilValue ClearValue = {};
-                vkCmdClearDepthStencilImage(vkCmdBuff, m_VulkanImage,
-                                            CurrentLayout, // must be VK_IMAGE_LAYOUT_GENERAL or VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
-                                            &ClearValue, 1, &Subresource);
+                else
+                {
+                    pRenderDeviceVk->ExecuteAndDisposeTransientCmdBuff(QueueIndex, vkCmdBuff, std::move(CmdPool));
+                }
+
+                // After command buffer is submitted, safe-release resources. This strategy
+                // is little overconservative as the resources will be released after the first
+                // command buffer submitted through the immediate context will be completed
+                pRenderDeviceVk->SafeReleaseDeviceObject(std::move(StagingBuffer), Uint64{1} << Uint64{QueueIndex});
+                pRenderDeviceVk->SafeReleaseDeviceObject(std::move(StagingMemoryAllocation), Uint64{1} << Uint64{QueueIndex});
             }
             else
             {
-                UNEXPECTED("Unexpected aspect mask");
+                VkImageSubresourceRange Subresource;
+                Subresource.aspectMask     = aspectMask;
+                Subresource.baseMipLevel   = 0;
+                Subresource.levelCount     = VK_REMAINING_MIP_LEVELS;
+                Subresource.baseArrayLayer = 0;
+                Subresource.layerCount     = VK_REMAINING_ARRAY_LAYERS;
+                if (aspectMask == VK_IMAGE_ASPECT_COLOR_BIT)
+                {
+                    if (FmtAttribs.ComponentType != COMPONENT_TYPE_COMPRESSED)
+                    {
+                        VkClearColorValue ClearColor = {};
+                        vkCmdClearColorImage(vkCmdBuff, m_VulkanImage,
+                                             CurrentLayout, // must be VK_IMAGE_LAYOUT_GENERAL or VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
+                                             &ClearColor, 1, &Subresource);
+                    }
+                }
+                else if (aspectMask == VK_IMAGE_ASPECT_DEPTH_BIT ||
+                         aspectMask == (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT))
+                {
+                    VkClearDepthStencilValue ClearValue = {};
+                    vkCmdClearDepthStencilImage(vkCmdBuff, m_VulkanImage,
+                                                CurrentLayout, // must be VK_IMAGE_LAYOUT_GENERAL or VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
+                                                &ClearValue, 1, &Subresource);
+                }
+                else
+                {
+                    UNEXPECTED("Unexpected aspect mask");
+                }
+                Uint32 QueueIndex = 0;
+                pRenderDeviceVk->ExecuteAndDisposeTransientCmdBuff(QueueIndex, vkCmdBuff, std::move(CmdPool));
             }
-            Uint32 QueueIndex = 0;
-            pRenderDeviceVk->ExecuteAndDisposeTransientCmdBuff(QueueIndex, vkCmdBuff, std::move(CmdPool));
         }
     }
     else if (m_Desc.Usage == USAGE_STAGING)
@@ -441,9 +527,19 @@ TextureVkImpl::TextureVkImpl(IReferenceCounters*        pRefCounters,
         else
             UNEXPECTED("Unexpected CPU access");
 
-        VkStagingBuffCI.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
-        VkStagingBuffCI.queueFamilyIndexCount = 0;
-        VkStagingBuffCI.pQueueFamilyIndices   = nullptr;
+        const auto& ConcurrentQueueFamilies = pRenderDeviceVk->GetConcurrentQueueFamilies();
+        if (!ConcurrentQueueFamilies.empty())
+        {
+            VkStagingBuffCI.sharingMode           = VK_SHARING_MODE_CONCURRENT;
+            VkStagingBuffCI.queueFamilyIndexCount = static_cast<uint32_t>(ConcurrentQueueFamilies.size());
+            VkStagingBuffCI.pQueueFamilyIndices   = ConcurrentQueueFamilies.data();
+        }
+        else
+        {
+            VkStagingBuffCI.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
+            VkStagingBuffCI.queueFamilyIndexCount = 0;
+            VkStagingBuffCI.pQueueFamilyIndices   = nullptr;
+        }
 
         std::string StagingBufferName = "Staging buffer for '";
         StagingBufferName += m_Desc.Name;
@@ -66,9 +66,20 @@ VulkanDynamicMemoryManager::VulkanDynamicMemoryManager(IMemoryAllocator&   Alloc
         VK_BUFFER_USAGE_INDEX_BUFFER_BIT |
         VK_BUFFER_USAGE_VERTEX_BUFFER_BIT |
         VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
-    VkBuffCI.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
-    VkBuffCI.queueFamilyIndexCount = 0;
-    VkBuffCI.pQueueFamilyIndices   = nullptr;
+    // Dynamic heap is shared by all contexts, including compute contexts
+    const auto& ConcurrentQueueFamilies = DeviceVk.GetConcurrentQueueFamilies();
+    if (!ConcurrentQueueFamilies.empty())
+    {
+        VkBuffCI.sharingMode           = VK_SHARING_MODE_CONCURRENT;
+        VkBuffCI.queueFamilyIndexCount = static_cast<uint32_t>(ConcurrentQueueFamilies.size());
+        VkBuffCI.pQueueFamilyIndices   = ConcurrentQueueFamilies.data();
+    }
+    else
+    {
+        VkBuffCI.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
+        VkBuffCI.queueFamilyIndexCount = 0;
+        VkBuffCI.pQueueFamilyIndices   = nullptr;
+    }
 
     const auto& LogicalDevice    = DeviceVk.GetLogicalDevice();
     m_VkBuffer                   = LogicalDevice.CreateBuffer(VkBuffCI, "Dynamic heap buffer");
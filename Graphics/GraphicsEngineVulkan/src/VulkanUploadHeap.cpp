@@ -28,17 +28,31 @@
 #include "pch.h"
 #include "VulkanUploadHeap.hpp"
 #include "RenderDeviceVkImpl.hpp"
+#include "PlatformMisc.hpp"
 
 namespace Diligent
 {
 
+namespace
+{
+
+// Free pages that have not been reused for this long are returned to the memory manager
+constexpr std::chrono::seconds PagePoolTrimTimeout{2};
+
+// Large pages up to this many regular pages are rounded up to a power of two and cached.
+// Larger allocations are rare and are allocated with the exact size and never cached.
+constexpr VkDeviceSize MaxCachedLargePageSizeInPages = 32;
+
+} // namespace
+
 VulkanUploadHeap::VulkanUploadHeap(RenderDeviceVkImpl& RenderDevice,
                                    std::string         HeapName,
                                    VkDeviceSize        PageSize) :
     // clang-format off
     m_RenderDevice {RenderDevice       },
     m_HeapName     {std::move(HeapName)},
-    m_PageSize     {PageSize           }
+    m_PageSize     {PageSize           },
+    m_pPagePool    {std::make_shared<PagePool>()}
 // clang-format on
 {
 }
@@ -46,10 +60,27 @@ VulkanUploadHeap::VulkanUploadHeap(RenderDeviceVkImpl& RenderDevice,
 VulkanUploadHeap::~VulkanUploadHeap()
 {
     DEV_CHECK_ERR(m_Pages.empty(), "Upload heap '", m_HeapName, "' not all pages are released");
+
+    {
+        // Free pages are not used by the GPU and can be destroyed right away. Pages that are
+        // still in the release queues will be destroyed when they are returned to the pool.
+        std::lock_guard<std::mutex> Lock{m_pPagePool->Mtx};
+        for (auto& Bucket : m_pPagePool->FreePages)
+        {
+            for (auto& FreePage : Bucket.second)
+                m_pPagePool->ResidentSize -= FreePage.Page.Size;
+        }
+        m_pPagePool->FreePages.clear();
+        m_pPagePool->IsHeapAlive = false;
+    }
+
     auto PeakAllocatedPages = m_PeakAllocatedSize / m_PageSize;
     LOG_INFO_MESSAGE(m_HeapName, " peak used/allocated frame size: ", FormatMemorySize(m_PeakFrameSize, 2, m_PeakAllocatedSize),
                      " / ", FormatMemorySize(m_PeakAllocatedSize, 2),
-                     " (", PeakAllocatedPages, (PeakAllocatedPages == 1 ? " page)" : " pages)"));
+                     " (", PeakAllocatedPages, (PeakAllocatedPages == 1 ? " page)" : " pages)"),
+                     ". Peak resident size: ", FormatMemorySize(m_PeakResidentSize, 2),
+                     ". Page pool hit rate: ", m_PoolHits * 100 / std::max(m_PoolHits + m_PoolMisses, Uint64{1}), '%',
+                     " (", m_PoolHits, " / ", m_PoolHits + m_PoolMisses, " page requests)");
 }
 
 VulkanUploadHeap::UploadPageInfo VulkanUploadHeap::CreateNewPage(VkDeviceSize SizeInBytes) const
@@ -87,7 +118,61 @@ VulkanUploadHeap::UploadPageInfo VulkanUploadHeap::CreateNewPage(VkDeviceSize Si
     (void)err;
     auto CPUAddress = reinterpret_cast<Uint8*>(MemAllocation.Page->GetCPUMemory()) + AlignedOffset;
 
-    return UploadPageInfo{std::move(MemAllocation), std::move(NewBuffer), CPUAddress};
+    return UploadPageInfo{std::move(MemAllocation), std::move(NewBuffer), CPUAddress, SizeInBytes};
+}
+
+VkDeviceSize VulkanUploadHeap::GetLargePageSize(VkDeviceSize SizeInBytes) const
+{
+    if (SizeInBytes > m_PageSize * MaxCachedLargePageSizeInPages)
+        return SizeInBytes;
+
+    // Round the size up to a power of two so that similar allocations share the same bucket
+    VkDeviceSize PageSize = VkDeviceSize{1} << PlatformMisc::GetMSB(SizeInBytes);
+    if (PageSize < SizeInBytes)
+        PageSize <<= 1;
+    return PageSize;
+}
+
+VulkanUploadHeap::UploadPageInfo VulkanUploadHeap::AcquirePage(VkDeviceSize PageSize)
+{
+    {
+        std::lock_guard<std::mutex> Lock{m_pPagePool->Mtx};
+
+        auto Bucket = m_pPagePool->FreePages.find(PageSize);
+        if (Bucket != m_pPagePool->FreePages.end() && !Bucket->second.empty())
+        {
+            // Take the most recently released page so that rarely used pages can be trimmed
+            auto Page = std::move(Bucket->second.back().Page);
+            Bucket->second.pop_back();
+            ++m_PoolHits;
+            return Page;
+        }
+    }
+
+    ++m_PoolMisses;
+    auto NewPage       = CreateNewPage(PageSize);
+    m_PeakResidentSize = std::max(m_pPagePool->ResidentSize += NewPage.Size, m_PeakResidentSize);
+    return NewPage;
+}
+
+void VulkanUploadHeap::TrimPagePool()
+{
+    const auto CurrTime = std::chrono::steady_clock::now();
+
+    std::lock_guard<std::mutex> Lock{m_pPagePool->Mtx};
+    for (auto& Bucket : m_pPagePool->FreePages)
+    {
+        auto& FreePages = Bucket.second;
+        // Pages are ordered by release time, so the oldest ones are at the front
+        auto FirstToKeep = std::find_if(FreePages.begin(), FreePages.end(),
+                                        [&](const PagePool::FreePage& FreePage) //
+                                        {
+                                            return CurrTime - FreePage.ReleaseTime < PagePoolTrimTimeout;
+                                        });
+        for (auto it = FreePages.begin(); it != FirstToKeep; ++it)
+            m_pPagePool->ResidentSize -= it->Page.Size;
+        FreePages.erase(FreePages.begin(), FirstToKeep);
+    }
 }
 
 VulkanUploadAllocation VulkanUploadHeap::Allocate(VkDeviceSize SizeInBytes, VkDeviceSize Alignment)
@@ -97,8 +182,8 @@ VulkanUploadAllocation VulkanUploadHeap::Allocate(VkDeviceSize SizeInBytes, VkDe
     VulkanUploadAllocation Allocation;
     if (SizeInBytes >= m_PageSize / 2)
     {
-        // Allocate large chunk directly from the memory manager
-        auto NewPage          = CreateNewPage(SizeInBytes);
+        // Use a dedicated page for large chunks
+        auto NewPage          = AcquirePage(GetLargePageSize(SizeInBytes));
         Allocation.vkBuffer   = NewPage.Buffer;
         Allocation.CPUAddress = NewPage.CPUAddress;
         Allocation.Size       = SizeInBytes;
@@ -113,7 +198,7 @@ VulkanUploadAllocation VulkanUploadHeap::Allocate(VkDeviceSize SizeInBytes, VkDe
         if (m_CurrPage.AvailableSize < SizeInBytes + AlignmentOffset)
         {
             // Allocate new page
-            auto NewPage = CreateNewPage(m_PageSize);
+            auto NewPage = AcquirePage(m_PageSize);
             m_CurrPage.Reset(NewPage, m_PageSize);
             m_CurrAllocatedSize += NewPage.MemAllocation.Size;
             m_Pages.emplace_back(std::move(NewPage));
@@ -139,16 +224,70 @@ VulkanUploadAllocation VulkanUploadHeap::Allocate(VkDeviceSize SizeInBytes, VkDe
 
 void VulkanUploadHeap::ReleaseAllocatedPages(Uint64 CmdQueueMask)
 {
+    // Returns the page to the pool when the release queue destroys the object,
+    // which happens once the GPU has finished all commands that use the page.
+    struct StalePage
+    {
+        UploadPageInfo            Page;
+        std::shared_ptr<PagePool> pPool;
+
+        // clang-format off
+        StalePage(UploadPageInfo&& _Page, std::shared_ptr<PagePool> _pPool) noexcept :
+            Page {std::move(_Page) },
+            pPool{std::move(_pPool)}
+        {
+        }
+
+        StalePage            (const StalePage&)  = delete;
+        StalePage& operator= (const StalePage&)  = delete;
+        StalePage& operator= (      StalePage&&) = delete;
+
+        StalePage(StalePage&& rhs) noexcept :
+            Page {std::move(rhs.Page) },
+            pPool{std::move(rhs.pPool)}
+        {
+        }
+        // clang-format on
+
+        ~StalePage()
+        {
+            if (!pPool)
+                return;
+
+            std::lock_guard<std::mutex> Lock{pPool->Mtx};
+            if (pPool->IsHeapAlive)
+            {
+                auto& FreePages = pPool->FreePages[Page.Size];
+                FreePages.emplace_back(PagePool::FreePage{std::move(Page), std::chrono::steady_clock::now()});
+            }
+            else
+            {
+                pPool->ResidentSize -= Page.Size;
+            }
+        }
+    };
+
     // The pages will go into the stale resources queue first, however they will move into the release
     // queue rightaway when RenderDeviceVkImpl::FlushStaleResources() is called by the DeviceContextVkImpl::FinishFrame()
     for (auto& Page : m_Pages)
     {
-        m_RenderDevice.SafeReleaseDeviceObject(std::move(Page.MemAllocation), CmdQueueMask);
-        m_RenderDevice.SafeReleaseDeviceObject(std::move(Page.Buffer), CmdQueueMask);
+        if (Page.Size <= m_PageSize * MaxCachedLargePageSizeInPages)
+        {
+            m_RenderDevice.SafeReleaseDeviceObject(StalePage{std::move(Page), m_pPagePool}, CmdQueueMask);
+        }
+        else
+        {
+            // Very large pages are not cached
+            m_pPagePool->ResidentSize -= Page.Size;
+            m_RenderDevice.SafeReleaseDeviceObject(std::move(Page.MemAllocation), CmdQueueMask);
+            m_RenderDevice.SafeReleaseDeviceObject(std::move(Page.Buffer), CmdQueueMask);
+        }
     }
 
     m_Pages.clear();
 
+    TrimPagePool();
+
     m_CurrPage          = CurrPageInfo{};
     m_CurrFrameSize     = 0;
     m_CurrAllocatedSize = 0;
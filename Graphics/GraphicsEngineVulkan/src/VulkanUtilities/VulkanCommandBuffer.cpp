@@ -336,6 +336,48 @@ void VulkanCommandBuffer::TransitionImageLayout(VkCommandBuffer                C
     // of the pipeline stages in dstStageMask (6.6)
 }
 
+void VulkanCommandBuffer::AliasingImageBarrier(VkCommandBuffer                CmdBuffer,
+                                               VkImage                        Image,
+                                               VkImageLayout                  NewLayout,
+                                               const VkImageSubresourceRange& SubresRange,
+                                               VkPipelineStageFlags           EnabledShaderStages,
+                                               VkPipelineStageFlags           DestStages)
+{
+    VERIFY_EXPR(CmdBuffer != VK_NULL_HANDLE);
+
+    VkImageMemoryBarrier ImgBarrier = {};
+    ImgBarrier.sType                = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    ImgBarrier.pNext                = nullptr;
+    // Writes to the memory by a previously active aliased resource must complete before
+    // the new resource starts using it
+    ImgBarrier.srcAccessMask       = VK_ACCESS_MEMORY_WRITE_BIT;
+    ImgBarrier.dstAccessMask       = AccessMaskFromImageLayout(NewLayout, true);
+    ImgBarrier.oldLayout           = VK_IMAGE_LAYOUT_UNDEFINED; // Previous contents are discarded
+    ImgBarrier.newLayout           = NewLayout;
+    ImgBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    ImgBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    ImgBarrier.image               = Image;
+    ImgBarrier.subresourceRange    = SubresRange;
+
+    if (DestStages == 0)
+    {
+        DestStages = ImgBarrier.dstAccessMask != 0 ?
+            PipelineStageFromAccessFlags(ImgBarrier.dstAccessMask, EnabledShaderStages) :
+            VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+    }
+
+    vkCmdPipelineBarrier(CmdBuffer,
+                         VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                         DestStages,
+                         0,       // a bitmask specifying how execution and memory dependencies are formed
+                         0,       // memoryBarrierCount
+                         nullptr, // pMemoryBarriers
+                         0,       // bufferMemoryBarrierCount
+                         nullptr, // pBufferMemoryBarriers
+                         1,
+                         &ImgBarrier);
+}
+
 
 void VulkanCommandBuffer::BufferMemoryBarrier(VkCommandBuffer      CmdBuffer,
                                               VkBuffer             Buffer,
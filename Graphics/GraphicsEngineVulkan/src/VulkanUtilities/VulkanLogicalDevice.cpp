@@ -588,4 +588,19 @@ VkResult VulkanLogicalDevice::GetRayTracingShaderGroupHandles(VkPipeline pipelin
 #endif
 }
 
+#if DILIGENT_VK_TIMELINE_SEMAPHORE_SUPPORTED
+VkResult VulkanLogicalDevice::SignalSemaphore(const VkSemaphoreSignalInfoKHR& SignalInfo) const
+{
+    VERIFY_EXPR(SignalInfo.sType == VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO_KHR);
+#    if DILIGENT_USE_VOLK
+    auto err = vkSignalSemaphoreKHR(m_VkDevice, &SignalInfo);
+    DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to signal semaphore");
+    return err;
+#    else
+    UNSUPPORTED("vkSignalSemaphoreKHR is only available through Volk");
+    return VK_ERROR_FEATURE_NOT_PRESENT;
+#    endif
+}
+#endif
+
 } // namespace VulkanUtilities
@@ -27,6 +27,7 @@
 
 #include "pch.h"
 #include <sstream>
+#include <algorithm>
 #include "VulkanUtilities/VulkanMemoryManager.hpp"
 
 namespace VulkanUtilities
@@ -44,10 +45,13 @@ VulkanMemoryPage::VulkanMemoryPage(VulkanMemoryManager&  ParentMemoryMgr,
                                    VkDeviceSize          PageSize,
                                    uint32_t              MemoryTypeIndex,
                                    bool                  IsHostVisible,
-                                   VkMemoryAllocateFlags AllocateFlags) noexcept :
+                                   VkMemoryAllocateFlags AllocateFlags,
+                                   bool                  IsTransient) noexcept :
     // clang-format off
     m_ParentMemoryMgr{ParentMemoryMgr},
-    m_AllocationMgr  {static_cast<AllocationsMgrOffsetType>(PageSize), ParentMemoryMgr.m_Allocator}
+    m_AllocationMgr  {static_cast<AllocationsMgrOffsetType>(PageSize), ParentMemoryMgr.m_Allocator},
+    m_MemoryTypeIndex{MemoryTypeIndex},
+    m_IsTransient    {IsTransient}
 // clang-format on
 {
     VERIFY(PageSize <= std::numeric_limits<AllocationsMgrOffsetType>::max(),
@@ -116,8 +120,106 @@ VulkanMemoryAllocation VulkanMemoryPage::Allocate(VkDeviceSize size, VkDeviceSiz
     }
 }
 
+VulkanMemoryAllocation VulkanMemoryPage::AllocateTransient(VkDeviceSize size, VkDeviceSize alignment, uint32_t FirstUse, uint32_t LastUse)
+{
+    VERIFY(m_IsTransient, "Transient allocations can only be made from transient pages");
+    VERIFY(FirstUse <= LastUse, "Invalid usage interval");
+
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+
+    // Collect ranges whose usage intervals overlap the requested one. These ranges
+    // are alive at the same time as the new allocation and must not share memory with it.
+    std::vector<const TransientRange*> BusyRanges;
+    for (const auto& Range : m_TransientRanges)
+    {
+        if (Range.FirstUse <= LastUse && FirstUse <= Range.LastUse)
+            BusyRanges.push_back(&Range);
+    }
+    std::sort(BusyRanges.begin(), BusyRanges.end(),
+              [](const TransientRange* lhs, const TransientRange* rhs) //
+              {
+                  return lhs->Offset < rhs->Offset;
+              });
+
+    // First fit
+    VkDeviceSize Offset = 0;
+    for (const auto* pRange : BusyRanges)
+    {
+        if (Offset + size <= pRange->Offset)
+            break;
+        Offset = std::max(Offset, Diligent::Align(pRange->Offset + pRange->Size, alignment));
+    }
+
+    if (Offset + size > GetPageSize())
+        return VulkanMemoryAllocation{};
+
+    TransientRange NewRange;
+    NewRange.Id           = m_NextTransientRangeId++;
+    NewRange.Offset       = Offset;
+    NewRange.Size         = size;
+    NewRange.FirstUse     = FirstUse;
+    NewRange.LastUse      = LastUse;
+    NewRange.AcquireIndex = 0;
+    m_TransientRanges.push_back(NewRange);
+
+    return VulkanMemoryAllocation{this, Offset, size, NewRange.Id};
+}
+
+void VulkanMemoryPage::AcquireTransientRange(uint32_t RangeId)
+{
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+    for (auto& Range : m_TransientRanges)
+    {
+        if (Range.Id == RangeId)
+        {
+            Range.AcquireIndex = ++m_TransientAcquireCount;
+            return;
+        }
+    }
+    UNEXPECTED("Transient range ", RangeId, " is not found");
+}
+
+bool VulkanMemoryPage::IsTransientRangeOverwritten(uint32_t RangeId)
+{
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+
+    auto it = std::find_if(m_TransientRanges.begin(), m_TransientRanges.end(),
+                           [RangeId](const TransientRange& Range) { return Range.Id == RangeId; });
+    if (it == m_TransientRanges.end())
+    {
+        UNEXPECTED("Transient range ", RangeId, " is not found");
+        return false;
+    }
+
+    const auto& Range = *it;
+    if (Range.AcquireIndex == 0)
+        return true;
+
+    for (const auto& Other : m_TransientRanges)
+    {
+        if (Other.Id != Range.Id &&
+            Other.AcquireIndex > Range.AcquireIndex &&
+            Other.Offset < Range.Offset + Range.Size &&
+            Range.Offset < Other.Offset + Other.Size)
+            return true;
+    }
+    return false;
+}
+
 void VulkanMemoryPage::Free(VulkanMemoryAllocation&& Allocation)
 {
+    if (m_IsTransient)
+    {
+        std::lock_guard<std::mutex> Lock{m_Mutex};
+        auto it = std::find_if(m_TransientRanges.begin(), m_TransientRanges.end(),
+                               [&Allocation](const TransientRange& Range) { return Range.Id == Allocation.TransientRangeId; });
+        VERIFY(it != m_TransientRanges.end(), "Transient range ", Allocation.TransientRangeId, " is not found");
+        if (it != m_TransientRanges.end())
+            m_TransientRanges.erase(it);
+        Allocation = VulkanMemoryAllocation{};
+        return;
+    }
+
     m_ParentMemoryMgr.OnFreeAllocation(Allocation.Size, m_CPUMemory != nullptr);
     std::lock_guard<std::mutex> Lock{m_Mutex};
     VERIFY_EXPR(Allocation.UnalignedOffset <= std::numeric_limits<AllocationsMgrOffsetType>::max());
@@ -194,6 +296,7 @@ VulkanMemoryAllocation VulkanMemoryManager::Allocate(VkDeviceSize Size, VkDevice
         LOG_INFO_MESSAGE("VulkanMemoryManager '", m_MgrName, "': created new ", (HostVisible ? "host-visible" : "device-local"),
                          " page. (", Diligent::FormatMemorySize(PageSize, 2), ", type idx: ", MemoryTypeIndex,
                          "). Current allocated size: ", Diligent::FormatMemorySize(m_CurrAllocatedSize[stat_ind], 2));
+        UpdateHeapAllocatedSize(it->second, true);
         OnNewPageCreated(it->second);
         Allocation = it->second.Allocate(Size, Alignment);
         DEV_CHECK_ERR(Allocation.Page != nullptr, "Failed to allocate new memory page");
@@ -210,6 +313,49 @@ VulkanMemoryAllocation VulkanMemoryManager::Allocate(VkDeviceSize Size, VkDevice
     return Allocation;
 }
 
+VulkanMemoryAllocation VulkanMemoryManager::AllocateTransient(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProps, uint32_t FirstUse, uint32_t LastUse)
+{
+    VERIFY((MemoryProps & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) == 0, "Transient memory must not be host-visible");
+
+    auto MemoryTypeIndex = m_PhysicalDevice.GetMemoryTypeIndex(MemReqs.memoryTypeBits, MemoryProps);
+    if (MemoryTypeIndex == VulkanUtilities::VulkanPhysicalDevice::InvalidMemoryTypeIndex)
+    {
+        LOG_ERROR_AND_THROW("Failed to find suitable device memory type for a transient resource");
+    }
+
+    VulkanMemoryAllocation Allocation;
+
+    std::lock_guard<std::mutex> Lock{m_PagesMtx};
+
+    auto range = m_TransientPages.equal_range(MemoryTypeIndex);
+    for (auto page_it = range.first; page_it != range.second; ++page_it)
+    {
+        Allocation = page_it->second.AllocateTransient(MemReqs.size, MemReqs.alignment, FirstUse, LastUse);
+        if (Allocation.Page != nullptr)
+            break;
+    }
+
+    if (Allocation.Page == nullptr)
+    {
+        auto PageSize = m_DeviceLocalPageSize;
+        while (PageSize < MemReqs.size)
+            PageSize *= 2;
+
+        m_CurrAllocatedSize[0] += PageSize;
+        m_PeakAllocatedSize[0] = std::max(m_PeakAllocatedSize[0], m_CurrAllocatedSize[0]);
+
+        auto it = m_TransientPages.emplace(MemoryTypeIndex, VulkanMemoryPage{*this, PageSize, MemoryTypeIndex, false, 0, true});
+        LOG_INFO_MESSAGE("VulkanMemoryManager '", m_MgrName, "': created new transient page. (", Diligent::FormatMemorySize(PageSize, 2),
+                         ", type idx: ", MemoryTypeIndex, "). Current allocated size: ", Diligent::FormatMemorySize(m_CurrAllocatedSize[0], 2));
+        UpdateHeapAllocatedSize(it->second, true);
+        OnNewPageCreated(it->second);
+        Allocation = it->second.AllocateTransient(MemReqs.size, MemReqs.alignment, FirstUse, LastUse);
+        DEV_CHECK_ERR(Allocation.Page != nullptr, "Failed to allocate new transient memory page");
+    }
+
+    return Allocation;
+}
+
 void VulkanMemoryManager::ShrinkMemory()
 {
     std::lock_guard<std::mutex> Lock{m_PagesMtx};
@@ -232,10 +378,51 @@ void VulkanMemoryManager::ShrinkMemory()
                              " page (", Diligent::FormatMemorySize(PageSize, 2),
                              "). Current allocated size: ",
                              Diligent::FormatMemorySize(m_CurrAllocatedSize[IsHostVisible ? 1 : 0], 2));
+            UpdateHeapAllocatedSize(Page, false);
             OnPageDestroy(Page);
             m_Pages.erase(curr_it);
         }
     }
+
+    for (auto page_it = m_TransientPages.begin(); page_it != m_TransientPages.end();)
+    {
+        auto curr_it = page_it;
+        ++page_it;
+        auto& Page = curr_it->second;
+        if (Page.IsEmpty() && m_CurrAllocatedSize[0] > m_DeviceLocalReserveSize)
+        {
+            auto PageSize = Page.GetPageSize();
+            m_CurrAllocatedSize[0] -= PageSize;
+            LOG_INFO_MESSAGE("VulkanMemoryManager '", m_MgrName, "': destroying transient page (", Diligent::FormatMemorySize(PageSize, 2),
+                             "). Current allocated size: ", Diligent::FormatMemorySize(m_CurrAllocatedSize[0], 2));
+            UpdateHeapAllocatedSize(Page, false);
+            OnPageDestroy(Page);
+            m_TransientPages.erase(curr_it);
+        }
+    }
+}
+
+void VulkanMemoryManager::UpdateHeapAllocatedSize(const VulkanMemoryPage& Page, bool IsCreated)
+{
+    const auto& MemoryProps = m_PhysicalDevice.GetMemoryProperties();
+    VERIFY_EXPR(Page.GetMemoryTypeIndex() < MemoryProps.memoryTypeCount);
+    const auto HeapIndex = MemoryProps.memoryTypes[Page.GetMemoryTypeIndex()].heapIndex;
+    if (IsCreated)
+    {
+        m_HeapAllocatedSize[HeapIndex] += Page.GetPageSize();
+    }
+    else
+    {
+        VERIFY_EXPR(m_HeapAllocatedSize[HeapIndex] >= Page.GetPageSize());
+        m_HeapAllocatedSize[HeapIndex] -= Page.GetPageSize();
+    }
+}
+
+VkDeviceSize VulkanMemoryManager::GetHeapAllocatedSize(uint32_t HeapIndex)
+{
+    VERIFY_EXPR(HeapIndex < VK_MAX_MEMORY_HEAPS);
+    std::lock_guard<std::mutex> Lock{m_PagesMtx};
+    return m_HeapAllocatedSize[HeapIndex];
 }
 
 void VulkanMemoryManager::OnFreeAllocation(VkDeviceSize Size, bool IsHostVisble)
@@ -259,6 +446,8 @@ VulkanMemoryManager::~VulkanMemoryManager()
 
     for (auto it = m_Pages.begin(); it != m_Pages.end(); ++it)
         VERIFY(it->second.IsEmpty(), "The page contains outstanding allocations");
+    for (auto it = m_TransientPages.begin(); it != m_TransientPages.end(); ++it)
+        VERIFY(it->second.IsEmpty(), "The transient page contains outstanding allocations");
     VERIFY(m_CurrUsedSize[0] == 0 && m_CurrUsedSize[1] == 0, "Not all allocations have been released");
 }
 
@@ -169,6 +169,53 @@ VulkanPhysicalDevice::VulkanPhysicalDevice(VkPhysicalDevice      vkDevice,
             m_ExtProperties.DescriptorIndexing.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES_EXT;
         }
 
+#    if DILIGENT_VK_DYNAMIC_RENDERING_SUPPORTED
+        // Get dynamic rendering features.
+        if (IsExtensionSupported(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME))
+        {
+            *NextFeat = &m_ExtFeatures.DynamicRendering;
+            NextFeat  = &m_ExtFeatures.DynamicRendering.pNext;
+
+            m_ExtFeatures.DynamicRendering.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR;
+        }
+#    endif
+
+#    if DILIGENT_VK_PUSH_DESCRIPTOR_SUPPORTED
+        // Get push descriptor properties.
+        if (IsExtensionSupported(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME))
+        {
+            m_ExtFeatures.PushDescriptor = true;
+
+            *NextProp = &m_ExtProperties.PushDescriptor;
+            NextProp  = &m_ExtProperties.PushDescriptor.pNext;
+
+            m_ExtProperties.PushDescriptor.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PUSH_DESCRIPTOR_PROPERTIES_KHR;
+        }
+#    endif
+
+#    if DILIGENT_VK_DRAW_INDIRECT_COUNT_SUPPORTED
+        if (IsExtensionSupported(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME))
+            m_ExtFeatures.DrawIndirectCount = true;
+#    endif
+
+#    if DILIGENT_VK_TIMELINE_SEMAPHORE_SUPPORTED
+        // Get timeline semaphore features.
+        if (IsExtensionSupported(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME))
+        {
+            *NextFeat = &m_ExtFeatures.TimelineSemaphore;
+            NextFeat  = &m_ExtFeatures.TimelineSemaphore.pNext;
+
+            m_ExtFeatures.TimelineSemaphore.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR;
+        }
+#    endif
+
+#    if DILIGENT_VK_MEMORY_BUDGET_SUPPORTED
+        // Memory budget is queried with vkGetPhysicalDeviceMemoryProperties2KHR,
+        // which requires VK_KHR_get_physical_device_properties2.
+        if (IsExtensionSupported(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME))
+            m_ExtFeatures.MemoryBudget = true;
+#    endif
+
         // Additional extension that is required for ray tracing shader.
         if (IsExtensionSupported(VK_KHR_SPIRV_1_4_EXTENSION_NAME))
             m_ExtFeatures.Spirv14 = true;
@@ -260,6 +307,42 @@ uint32_t VulkanPhysicalDevice::FindQueueFamily(VkQueueFlags QueueFlags) const
     return FamilyInd;
 }
 
+uint32_t VulkanPhysicalDevice::FindDedicatedTransferQueueFamily() const
+{
+    for (uint32_t i = 0; i < m_QueueFamilyProperties.size(); ++i)
+    {
+        // Dedicated transfer queues typically map to the DMA engines of the GPU and
+        // can copy data concurrently with graphics and compute work.
+        const auto& Props = m_QueueFamilyProperties[i];
+        if ((Props.queueFlags & VK_QUEUE_TRANSFER_BIT) != 0 &&
+            (Props.queueFlags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)) == 0 &&
+            Props.queueCount > 0)
+        {
+            return i;
+        }
+    }
+
+    return InvalidQueueFamilyIndex;
+}
+
+uint32_t VulkanPhysicalDevice::FindDedicatedComputeQueueFamily() const
+{
+    for (uint32_t i = 0; i < m_QueueFamilyProperties.size(); ++i)
+    {
+        // Queues from compute-only families are executed by the asynchronous compute engines
+        // and can run concurrently with the graphics queue.
+        const auto& Props = m_QueueFamilyProperties[i];
+        if ((Props.queueFlags & VK_QUEUE_COMPUTE_BIT) != 0 &&
+            (Props.queueFlags & VK_QUEUE_GRAPHICS_BIT) == 0 &&
+            Props.queueCount > 0)
+        {
+            return i;
+        }
+    }
+
+    return InvalidQueueFamilyIndex;
+}
+
 bool VulkanPhysicalDevice::IsExtensionSupported(const char* ExtensionName) const
 {
     for (const auto& Extension : m_SupportedExtensions)
@@ -330,4 +413,40 @@ VkFormatProperties VulkanPhysicalDevice::GetPhysicalDeviceFormatProperties(VkFor
     return formatProperties;
 }
 
+bool VulkanPhysicalDevice::GetMemoryBudget(VkDeviceSize HeapBudget[VK_MAX_MEMORY_HEAPS], VkDeviceSize HeapUsage[VK_MAX_MEMORY_HEAPS]) const
+{
+#if DILIGENT_VK_MEMORY_BUDGET_SUPPORTED
+    if (!m_ExtFeatures.MemoryBudget)
+        return false;
+
+    VkPhysicalDeviceMemoryBudgetPropertiesEXT BudgetProps = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT};
+    VkPhysicalDeviceMemoryProperties2         MemProps2   = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2};
+    MemProps2.pNext                                       = &BudgetProps;
+    vkGetPhysicalDeviceMemoryProperties2KHR(m_VkDevice, &MemProps2);
+
+    for (uint32_t heap = 0; heap < m_MemoryProperties.memoryHeapCount; ++heap)
+    {
+        HeapBudget[heap] = BudgetProps.heapBudget[heap];
+        HeapUsage[heap]  = BudgetProps.heapUsage[heap];
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool VulkanPhysicalDevice::SupportsUpdateAfterBindArrays(const VkPhysicalDeviceDescriptorIndexingFeaturesEXT& Features)
+{
+    // Samplers and combined image samplers are covered by descriptorBindingSampledImageUpdateAfterBind
+    // clang-format off
+    return Features.runtimeDescriptorArray                             != VK_FALSE &&
+           Features.descriptorBindingPartiallyBound                    != VK_FALSE &&
+           Features.descriptorBindingUpdateUnusedWhilePending          != VK_FALSE &&
+           Features.descriptorBindingSampledImageUpdateAfterBind       != VK_FALSE &&
+           Features.descriptorBindingStorageImageUpdateAfterBind       != VK_FALSE &&
+           Features.descriptorBindingUniformTexelBufferUpdateAfterBind != VK_FALSE &&
+           Features.descriptorBindingStorageTexelBufferUpdateAfterBind != VK_FALSE;
+    // clang-format on
+}
+
 } // namespace VulkanUtilities
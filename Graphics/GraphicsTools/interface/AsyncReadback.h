@@ -0,0 +1,254 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of AsyncReadback interface and related data structures
+
+#include <functional>
+#include <future>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/Buffer.h"
+#include "../../GraphicsEngine/interface/Texture.h"
+#include "../../GraphicsEngine/interface/Fence.h"
+
+namespace Diligent
+{
+
+// {0F2C1D4B-6B7E-4C53-9E0A-2D8F3B51A7C4}
+static const INTERFACE_ID IID_AsyncReadback =
+    {0x0f2c1d4b, 0x6b7e, 0x4c53, {0x9e, 0x0a, 0x2d, 0x8f, 0x3b, 0x51, 0xa7, 0xc4}};
+
+
+/// Data of a completed readback request that is passed to the readback callback.
+struct AsyncReadbackData
+{
+    /// Request id returned by IAsyncReadback::ReadBuffer() or IAsyncReadback::ReadTexture().
+    Uint64 RequestId = 0;
+
+    /// Pointer to the mapped data, or null if the request failed or was cancelled.
+
+    /// \note The pointer is only valid while the callback is running.
+    const void* pData = nullptr;
+
+    /// Size of the data, in bytes.
+    Uint32 DataSize = 0;
+
+    /// Row stride of the texture data, in bytes. For buffers, this is equal to DataSize.
+    Uint32 RowStride = 0;
+
+    /// Depth slice stride of the texture data, in bytes. For buffers, this is equal to DataSize.
+    Uint32 DepthStride = 0;
+
+    /// Texture region width. For buffers, this is equal to DataSize.
+    Uint32 Width = 0;
+
+    /// Texture region height. For buffers, this is 1.
+    Uint32 Height = 0;
+
+    /// Texture region depth. For buffers, this is 1.
+    Uint32 Depth = 0;
+
+    /// Texture format. For buffers, this is TEX_FORMAT_UNKNOWN.
+    TEXTURE_FORMAT Format = TEX_FORMAT_UNKNOWN;
+};
+
+/// Readback callback. The callback is called by IAsyncReadback::ProcessCompletedReadbacks()
+/// in the same order in which the requests were issued.
+using AsyncReadbackCallbackType = std::function<void(const AsyncReadbackData& Data)>;
+
+
+/// Texture readback attributes.
+struct AsyncReadbackTextureAttribs
+{
+    /// Texture to read the data from.
+    ITexture* pTexture = nullptr;
+
+    /// Mip level to read.
+    Uint32 MipLevel = 0;
+
+    /// Array slice to read. Must be 0 for non-array textures.
+    Uint32 ArraySlice = 0;
+
+    /// Region to read. Use nullptr to read the entire subresource.
+    /// For compressed formats, the region must be block-aligned.
+    const Box* pRegion = nullptr;
+
+    /// Texture state transition mode (see Diligent::RESOURCE_STATE_TRANSITION_MODE).
+    RESOURCE_STATE_TRANSITION_MODE TransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+};
+
+
+/// Asynchronous GPU->CPU readback.
+
+/// Buffer readbacks are suballocated from CPU-readable staging pages that are recycled
+/// once the GPU is done with them, texture readbacks use pooled staging textures.
+/// The copy commands are recorded into the context immediately, while the data is delivered
+/// to the callback a few frames later, without stalling the pipeline:
+///
+///     pReadback->ReadBuffer(pContext, pHistogramBuffer, 0, HistogramSize, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+///                           [](const AsyncReadbackData& Data) { ... });
+///     ...
+///     pReadback->FinishFrame(pContext);
+///     pSwapChain->Present();
+///
+/// All methods except for GetFence() must be called from the thread that owns the immediate
+/// context; the object is not thread-safe.
+struct IAsyncReadback : public IObject
+{
+    /// Records the copy of a buffer region into the staging memory.
+
+    /// \param [in] pContext       - Immediate device context.
+    /// \param [in] pBuffer        - Buffer to read the data from.
+    /// \param [in] Offset         - Offset of the region to read, in bytes.
+    /// \param [in] Size           - Size of the region to read, in bytes.
+    /// \param [in] TransitionMode - Buffer state transition mode (see Diligent::RESOURCE_STATE_TRANSITION_MODE).
+    /// \param [in] Callback       - Callback that will be called when the data is available.
+    ///
+    /// \return     Request id, or 0 if the request is invalid. The callback is not called for
+    ///             invalid requests.
+    virtual Uint64 ReadBuffer(IDeviceContext*                pContext,
+                              IBuffer*                       pBuffer,
+                              Uint32                         Offset,
+                              Uint32                         Size,
+                              RESOURCE_STATE_TRANSITION_MODE TransitionMode,
+                              AsyncReadbackCallbackType      Callback) = 0;
+
+
+    /// Records the copy of a texture region into a staging texture.
+
+    /// \param [in] pContext - Immediate device context.
+    /// \param [in] Attribs  - Readback attributes, see Diligent::AsyncReadbackTextureAttribs.
+    /// \param [in] Callback - Callback that will be called when the data is available.
+    ///
+    /// \return     Request id, or 0 if the request is invalid. The callback is not called for
+    ///             invalid requests.
+    virtual Uint64 ReadTexture(IDeviceContext*                    pContext,
+                               const AsyncReadbackTextureAttribs& Attribs,
+                               AsyncReadbackCallbackType          Callback) = 0;
+
+
+    /// Ends the current frame of readback requests.
+
+    /// The method signals the internal fence after all copies of the current frame and
+    /// delivers the data of all frames that have been completed by the GPU.
+    /// If the number of frames in flight exceeds AsyncReadbackCreateInfo::MaxFramesInFlight,
+    /// the method waits for the oldest frame to complete.
+    ///
+    /// \param [in] pContext - Immediate device context.
+    ///
+    /// \return     The fence value that will be signaled when all copies of the frame are complete.
+    virtual Uint64 FinishFrame(IDeviceContext* pContext) = 0;
+
+
+    /// Calls the callbacks of all readbacks that have been completed by the GPU and recycles their staging memory.
+
+    /// \param [in] pContext - Immediate device context.
+    ///
+    /// \return     The number of callbacks that were called.
+    virtual Uint32 ProcessCompletedReadbacks(IDeviceContext* pContext) = 0;
+
+
+    /// Finishes the current frame, waits until all pending readbacks are complete and calls their callbacks.
+    virtual void WaitForAllReadbacks(IDeviceContext* pContext) = 0;
+
+
+    /// Returns the number of requests whose callbacks have not been called yet.
+    virtual Uint32 GetNumPendingReadbacks() const = 0;
+
+
+    /// Returns the fence that is signaled by FinishFrame().
+    virtual IFence* GetFence() = 0;
+};
+
+
+/// Async readback create information.
+struct AsyncReadbackCreateInfo
+{
+    /// The size of one staging page used for buffer readbacks, in bytes.
+
+    /// Buffer requests larger than the page size use dedicated staging buffers
+    /// that are not recycled.
+    Uint32 StagingPageSize = 1 << 20;
+
+    /// The maximum number of frames whose readbacks may be in flight, see IAsyncReadback::FinishFrame().
+    Uint32 MaxFramesInFlight = 3;
+
+    /// The maximum number of free staging pages that are kept for reuse.
+    Uint32 MaxCachedPages = 4;
+
+    /// The maximum number of free staging textures that are kept for reuse.
+    Uint32 MaxCachedTextures = 8;
+};
+
+/// Creates a new async readback object.
+
+/// \param[in]  pDevice     - Pointer to the render device.
+/// \param[in]  CreateInfo  - Async readback create info, see Diligent::AsyncReadbackCreateInfo.
+/// \param[in]  ppReadback  - Memory location where pointer to the async readback object will be stored.
+void CreateAsyncReadback(IRenderDevice*                 pDevice,
+                         const AsyncReadbackCreateInfo& CreateInfo,
+                         IAsyncReadback**               ppReadback);
+
+
+/// Readback data copied into CPU memory, see ReadBufferAsync() and ReadTextureAsync().
+struct AsyncReadbackResult
+{
+    /// Readback data. Empty if the request failed or was cancelled.
+    std::vector<Uint8> Data;
+
+    Uint32         RowStride   = 0;
+    Uint32         DepthStride = 0;
+    Uint32         Width       = 0;
+    Uint32         Height      = 0;
+    Uint32         Depth       = 0;
+    TEXTURE_FORMAT Format      = TEX_FORMAT_UNKNOWN;
+};
+
+/// Issues a buffer readback request and returns a future that is ready once the data
+/// has been delivered by IAsyncReadback::ProcessCompletedReadbacks().
+
+/// \note   The future becomes ready on the thread that processes the readbacks, so waiting for
+///         it on that thread without calling FinishFrame() or WaitForAllReadbacks() will deadlock.
+///         If the request is invalid, the returned future is ready immediately and contains no data.
+std::future<AsyncReadbackResult> ReadBufferAsync(IAsyncReadback*                pReadback,
+                                                 IDeviceContext*                pContext,
+                                                 IBuffer*                       pBuffer,
+                                                 Uint32                         Offset,
+                                                 Uint32                         Size,
+                                                 RESOURCE_STATE_TRANSITION_MODE TransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+/// Issues a texture readback request and returns a future, see ReadBufferAsync().
+std::future<AsyncReadbackResult> ReadTextureAsync(IAsyncReadback*                    pReadback,
+                                                  IDeviceContext*                    pContext,
+                                                  const AsyncReadbackTextureAttribs& Attribs);
+
+} // namespace Diligent
@@ -0,0 +1,151 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of BindlessResourceTable interface and related data structures
+
+#include "../../GraphicsEngine/interface/DeviceObject.h"
+#include "../../GraphicsEngine/interface/ShaderResourceVariable.h"
+
+namespace Diligent
+{
+
+// {B3D1E6A2-58C4-4F0B-9A3E-7C21D4F5E816}
+static const INTERFACE_ID IID_BindlessResourceTable =
+    {0xb3d1e6a2, 0x58c4, 0x4f0b, {0x9a, 0x3e, 0x7c, 0x21, 0xd4, 0xf5, 0xe8, 0x16}};
+
+/// Slot index returned by IBindlessResourceTable::Allocate() when the table is full.
+static constexpr Uint32 InvalidBindlessSlot = ~Uint32{0};
+
+
+/// Bindless resource table.
+
+/// The table is a fixed-size array of device objects (texture views, buffer views or samplers)
+/// that is bound to a single shader resource array variable, e.g. `Texture2D g_Textures[1024]`.
+/// Objects are placed into slots, and shaders access them by the slot index, for instance
+/// a material index read from a structured buffer. This allows rendering many materials with a
+/// single shader resource binding.
+///
+/// Free slots are filled with the default object, so every element of the shader array always
+/// references a valid resource.
+///
+/// In Vulkan backend, declare the shader array as a runtime-sized array, e.g. `Texture2D g_Textures[]`,
+/// and label it as a mutable variable. Such arrays are placed into an update-after-bind descriptor set
+/// with partially bound descriptors (see Diligent::EngineVkCreateInfo::EnableDescriptorIndexing), so only the
+/// slots that have changed are written into the set, and committing the resource binding does not
+/// rewrite any descriptors. Other backends use a fixed-size dynamic array variable instead.
+struct IBindlessResourceTable : public IObject
+{
+    /// Places the object into a free slot.
+
+    /// \param[in]  pObject - Object to place into the slot. If null, the default object is used.
+    ///
+    /// \return     Index of the slot that shaders use to access the object, or
+    ///             InvalidBindlessSlot if there are no free slots.
+    ///
+    /// \remarks    The method is thread-safe and can be called from multiple threads simultaneously.
+    virtual Uint32 Allocate(IDeviceObject* pObject) = 0;
+
+
+    /// Replaces the object in a previously allocated slot.
+
+    /// \param[in]  Slot    - Slot index returned by Allocate().
+    /// \param[in]  pObject - New object. If null, the default object is used.
+    ///
+    /// \remarks    The method is thread-safe.
+    virtual void Update(Uint32 Slot, IDeviceObject* pObject) = 0;
+
+
+    /// Frees a slot previously returned by Allocate().
+
+    /// \remarks    The slot is reset to the default object and may be returned by subsequent
+    ///             calls to Allocate(). The method is thread-safe.
+    ///             With a dynamic variable, resource bindings that were committed before the slot was
+    ///             freed keep referencing the old object. With an update-after-bind array, Bind() writes
+    ///             the descriptor in place, so the slot must not be freed, updated or reused while it may
+    ///             still be accessed by the GPU commands that are in flight.
+    virtual void Free(Uint32 Slot) = 0;
+
+
+    /// Binds all slots of the table to the shader resource array variable.
+
+    /// \param[in]  pVariable - Shader resource array variable. If the array is smaller than the
+    ///                         table capacity, only the first slots are bound.
+    ///
+    /// \remarks    In Vulkan backend, the variable should be a mutable runtime-sized array, whose
+    ///             elements can be changed at any time. In other backends, the variable should be
+    ///             dynamic (see Diligent::SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC): mutable variables
+    ///             must not be changed once the resource binding has been committed, and all elements
+    ///             of a dynamic array are written every time the resource binding is committed.
+    ///             The first call for a variable sets all elements of the array. Subsequent calls
+    ///             for the same variable only set the slots that have changed since the previous call,
+    ///             so the variable must not be modified by other means between the calls.
+    ///             The method is thread-safe, but the variable must be externally synchronized.
+    virtual void Bind(IShaderResourceVariable* pVariable) = 0;
+
+
+    /// Returns the total number of slots in the table.
+    virtual Uint32 GetCapacity() const = 0;
+
+
+    /// Returns the number of allocated slots.
+    virtual Uint32 GetAllocatedSlotCount() const = 0;
+
+
+    /// Returns the table version. The version is incremented every time
+    /// a slot is allocated, updated or freed.
+
+    /// \remarks    An application may use the version to skip Bind() when the
+    ///             table has not changed since the last call.
+    virtual Uint32 GetVersion() const = 0;
+};
+
+/// Bindless resource table create information.
+struct BindlessResourceTableCreateInfo
+{
+    /// Table name, used for debug messages.
+    const char* Name = nullptr;
+
+    /// The number of slots in the table. Typically this is the size
+    /// of the shader resource array that the table is bound to.
+    Uint32 Capacity = 0;
+
+    /// The object that is used for free slots, e.g. a 1x1 texture view or a default sampler.
+    /// Must not be null.
+    IDeviceObject* pDefaultObject = nullptr;
+};
+
+/// Creates a new bindless resource table.
+
+/// \param[in]  CreateInfo - Table create info, see Diligent::BindlessResourceTableCreateInfo.
+/// \param[in]  ppTable    - Memory location where pointer to the bindless resource table will be stored.
+void CreateBindlessResourceTable(const BindlessResourceTableCreateInfo& CreateInfo,
+                                 IBindlessResourceTable**               ppTable);
+
+} // namespace Diligent
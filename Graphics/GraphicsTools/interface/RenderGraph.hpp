@@ -0,0 +1,344 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of a RenderGraph class
+
+#include <vector>
+#include <string>
+#include <functional>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../../Primitives/interface/FlagEnum.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+class ThreadPool;
+
+/// Render graph resource identifier.
+using RenderGraphResourceId = Uint32;
+
+/// Invalid render graph resource identifier.
+static constexpr RenderGraphResourceId InvalidRenderGraphResourceId = ~Uint32{0};
+
+/// Render graph pass flags.
+enum RENDER_GRAPH_PASS_FLAGS : Uint32
+{
+    /// No flags.
+    RENDER_GRAPH_PASS_FLAG_NONE = 0u,
+
+    /// The pass is never culled, even if none of its outputs are consumed.
+    /// Use this flag for passes with side effects that the graph does not see
+    /// (e.g. writes to resources that are not registered in the graph).
+    RENDER_GRAPH_PASS_FLAG_NEVER_CULL = 1u << 0u
+};
+DEFINE_FLAG_ENUM_OPERATORS(RENDER_GRAPH_PASS_FLAGS)
+
+
+/// Render graph (frame graph).
+
+/// The application declares the passes of the frame together with the resources each pass
+/// reads and writes. The graph then
+///   - culls the passes whose results are never consumed,
+///   - computes the state transitions required before every pass,
+///   - assigns physical objects to transient resources, reusing the same object for transient
+///     resources with identical descriptions whose lifetimes do not overlap,
+///   - records the passes into the immediate context or, optionally, into several deferred
+///     contexts in parallel.
+///
+/// Transient resources are created by the graph and are only valid during Execute().
+/// Their physical objects are kept in a pool between frames and are released when they have not
+/// been used for a number of frames. Imported resources are owned by the application.
+///
+/// A typical frame looks as follows:
+///
+///     Graph.Reset();
+///     auto GBuffer = Graph.CreateTexture(GBufferDesc);
+///     auto Color   = Graph.ImportTexture(pBackBuffer, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_PRESENT);
+///     auto GBufferPass = Graph.AddPass("GBuffer", [&](const RenderGraph::PassContext& Ctx) {...});
+///     Graph.Write(GBufferPass, GBuffer, RESOURCE_STATE_RENDER_TARGET);
+///     auto LightingPass = Graph.AddPass("Lighting", [&](const RenderGraph::PassContext& Ctx) {...});
+///     Graph.Read(LightingPass, GBuffer, RESOURCE_STATE_SHADER_RESOURCE);
+///     Graph.Write(LightingPass, Color, RESOURCE_STATE_RENDER_TARGET);
+///     Graph.Execute(pDevice, pContext);
+///
+/// \note   The graph performs all state transitions of the resources it knows about.
+///         Pass functions must use RESOURCE_STATE_TRANSITION_MODE_NONE or
+///         RESOURCE_STATE_TRANSITION_MODE_VERIFY for these resources and must end
+///         all render passes they begin. When passes are recorded into deferred contexts,
+///         resource states are only updated after all command lists have been executed,
+///         so only RESOURCE_STATE_TRANSITION_MODE_NONE may be used.
+///
+/// \remarks The class is not thread-safe.
+class RenderGraph
+{
+public:
+    /// Pass execution context.
+    struct PassContext
+    {
+        /// Device context the pass must record its commands into.
+        IDeviceContext* pContext = nullptr;
+
+        /// Index of the pass being executed.
+        Uint32 PassIndex = 0;
+
+        /// Graph being executed.
+        const RenderGraph* pGraph = nullptr;
+
+        /// Returns the texture that is bound to the resource with the given id.
+        ITexture* GetTexture(RenderGraphResourceId Id) const;
+
+        /// Returns the buffer that is bound to the resource with the given id.
+        IBuffer* GetBuffer(RenderGraphResourceId Id) const;
+    };
+
+    /// Pass execution function.
+    using ExecuteFuncType = std::function<void(const PassContext& Context)>;
+
+    /// Resource state transition computed by the graph.
+    struct Barrier
+    {
+        /// Resource to transition.
+        RenderGraphResourceId ResourceId = InvalidRenderGraphResourceId;
+
+        /// Resource state before the transition. RESOURCE_STATE_UNKNOWN indicates the
+        /// first use of the resource in the frame; in this case the actual state is
+        /// determined when the graph is executed.
+        RESOURCE_STATE OldState = RESOURCE_STATE_UNKNOWN;
+
+        /// Resource state after the transition.
+        RESOURCE_STATE NewState = RESOURCE_STATE_UNKNOWN;
+    };
+
+    /// \param [in] NumFramesToKeepUnused - Number of frames a pooled physical object
+    ///                                     may stay unused before it is released.
+    explicit RenderGraph(Uint32 NumFramesToKeepUnused = 4);
+
+    // clang-format off
+    RenderGraph           (const RenderGraph&)  = delete;
+    RenderGraph& operator=(const RenderGraph&)  = delete;
+    RenderGraph           (      RenderGraph&&) = delete;
+    RenderGraph& operator=(      RenderGraph&&) = delete;
+    // clang-format on
+
+    ~RenderGraph();
+
+    /// Declares a transient texture and returns its id.
+    RenderGraphResourceId CreateTexture(const TextureDesc& Desc);
+
+    /// Declares a transient buffer and returns its id.
+    RenderGraphResourceId CreateBuffer(const BufferDesc& Desc);
+
+    /// Imports an application-owned texture and returns its id.
+
+    /// \param [in] pTexture     - Texture to import.
+    /// \param [in] InitialState - State of the texture when the graph starts executing.
+    ///                            If RESOURCE_STATE_UNKNOWN, the state tracked by the texture
+    ///                            is used. If that state is also unknown, the first transition
+    ///                            of the texture is skipped.
+    /// \param [in] FinalState   - State the texture is transitioned to after all passes
+    ///                            have been executed. If RESOURCE_STATE_UNKNOWN, the texture
+    ///                            is left in the state required by the last pass that uses it.
+    ///
+    /// \remarks Passes that write imported resources are never culled.
+    RenderGraphResourceId ImportTexture(ITexture*      pTexture,
+                                        RESOURCE_STATE InitialState = RESOURCE_STATE_UNKNOWN,
+                                        RESOURCE_STATE FinalState   = RESOURCE_STATE_UNKNOWN);
+
+    /// Imports an application-owned buffer and returns its id, see ImportTexture().
+    RenderGraphResourceId ImportBuffer(IBuffer*       pBuffer,
+                                       RESOURCE_STATE InitialState = RESOURCE_STATE_UNKNOWN,
+                                       RESOURCE_STATE FinalState   = RESOURCE_STATE_UNKNOWN);
+
+    /// Adds a pass to the graph and returns its index.
+
+    /// \param [in] Name        - Pass name, used for debug groups and diagnostic messages.
+    /// \param [in] ExecuteFunc - Function that records the pass commands.
+    /// \param [in] Flags       - Pass flags, see Diligent::RENDER_GRAPH_PASS_FLAGS.
+    ///
+    /// \remarks Passes are executed in the order they are added.
+    Uint32 AddPass(const char* Name, ExecuteFuncType ExecuteFunc, RENDER_GRAPH_PASS_FLAGS Flags = RENDER_GRAPH_PASS_FLAG_NONE);
+
+    /// Declares that the pass reads the resource in the given state.
+    void Read(Uint32 Pass, RenderGraphResourceId Resource, RESOURCE_STATE State);
+
+    /// Declares that the pass writes the resource in the given state.
+    void Write(Uint32 Pass, RenderGraphResourceId Resource, RESOURCE_STATE State);
+
+    /// Culls unused passes, computes state transitions and assigns physical objects.
+
+    /// \return true if the graph is valid, and false otherwise.
+    ///
+    /// \remarks Compile() does not access the device and is called automatically
+    ///          by Execute() if the graph has been modified.
+    bool Compile();
+
+    /// Executes the graph.
+
+    /// \param [in] pDevice             - Render device used to create transient resources.
+    /// \param [in] pContext            - Immediate device context.
+    /// \param [in] ppDeferredContexts  - Optional array of deferred contexts.
+    /// \param [in] NumDeferredContexts - Number of deferred contexts in ppDeferredContexts.
+    /// \param [in] pThreadPool         - Optional thread pool.
+    ///
+    /// \return true if the graph was executed successfully, and false otherwise.
+    ///
+    /// \remarks If deferred contexts and the thread pool are provided, live passes are
+    ///          split into contiguous batches that are recorded in parallel, one batch per
+    ///          deferred context. The command lists are then executed by the immediate context
+    ///          in pass order. Otherwise all passes are recorded into the immediate context.
+    ///          If a batch fails to record, it and all following batches are not executed,
+    ///          the final transitions are skipped and the method returns false.
+    bool Execute(IRenderDevice*         pDevice,
+                 IDeviceContext*        pContext,
+                 IDeviceContext* const* ppDeferredContexts  = nullptr,
+                 Uint32                 NumDeferredContexts = 0,
+                 ThreadPool*            pThreadPool         = nullptr);
+
+    /// Removes all passes and resources. Pooled physical objects are kept.
+    void Reset();
+
+    /// Returns the number of passes in the graph.
+    Uint32 GetPassCount() const { return static_cast<Uint32>(m_Passes.size()); }
+
+    /// Returns true if the pass was culled by the last Compile().
+    bool IsPassCulled(Uint32 Pass) const;
+
+    /// Returns the indices of the passes that are executed, in execution order.
+    const std::vector<Uint32>& GetExecutionOrder() const { return m_ExecutionOrder; }
+
+    /// Returns the state transitions that are performed before the pass.
+    const std::vector<Barrier>& GetPassBarriers(Uint32 Pass) const;
+
+    /// Returns the state transitions that are performed after all passes.
+    const std::vector<Barrier>& GetFinalBarriers() const { return m_FinalBarriers; }
+
+    /// Returns the index of the physical object assigned to the resource by the last Compile().
+
+    /// Transient resources with the same physical index share the same object. Every imported
+    /// resource has its own index. If a transient resource is not used by any live pass,
+    /// ~0u is returned.
+    Uint32 GetPhysicalResourceIndex(RenderGraphResourceId Resource) const;
+
+    /// Returns the number of physical objects used by the graph.
+    Uint32 GetPhysicalResourceCount() const { return static_cast<Uint32>(m_PhysicalResources.size()); }
+
+    /// Returns the number of physical objects currently kept in the pool.
+    Uint32 GetPooledResourceCount() const { return static_cast<Uint32>(m_Pool.size()); }
+
+    /// Returns the texture bound to the resource during the last Execute(), or null.
+    ITexture* GetTexture(RenderGraphResourceId Resource) const;
+
+    /// Returns the buffer bound to the resource during the last Execute(), or null.
+    IBuffer* GetBuffer(RenderGraphResourceId Resource) const;
+
+private:
+    struct ResourceInfo
+    {
+        std::string Name;
+        bool        IsTexture  = false;
+        bool        IsImported = false;
+        TextureDesc TexDesc;
+        BufferDesc  BuffDesc;
+
+        RefCntAutoPtr<ITexture> pImportedTexture;
+        RefCntAutoPtr<IBuffer>  pImportedBuffer;
+        RESOURCE_STATE          InitialState = RESOURCE_STATE_UNKNOWN;
+        RESOURCE_STATE          FinalState   = RESOURCE_STATE_UNKNOWN;
+
+        // Physical object index assigned by Compile()
+        Uint32 PhysicalIndex = ~0u;
+
+        // Objects bound to the resource during the last Execute()
+        ITexture* pTexture = nullptr;
+        IBuffer*  pBuffer  = nullptr;
+    };
+
+    struct ResourceAccess
+    {
+        RenderGraphResourceId Resource = InvalidRenderGraphResourceId;
+        RESOURCE_STATE        State    = RESOURCE_STATE_UNKNOWN;
+        bool                  IsWrite  = false;
+    };
+
+    struct PassInfo
+    {
+        std::string                 Name;
+        ExecuteFuncType             ExecuteFunc;
+        RENDER_GRAPH_PASS_FLAGS     Flags = RENDER_GRAPH_PASS_FLAG_NONE;
+        std::vector<ResourceAccess> Accesses;
+        std::vector<Barrier>        Barriers;
+        bool                        IsCulled = false;
+    };
+
+    struct PhysicalResource
+    {
+        // The first resource assigned to this object; defines the object description.
+        RenderGraphResourceId FirstResource = InvalidRenderGraphResourceId;
+
+        // Position in the execution order of the last pass that uses the object.
+        Uint32 LastUse = 0;
+    };
+
+    struct PooledResource
+    {
+        RefCntAutoPtr<ITexture> pTexture;
+        RefCntAutoPtr<IBuffer>  pBuffer;
+        Uint64                  LastUsedFrame = 0;
+    };
+
+    void AddAccess(Uint32 Pass, RenderGraphResourceId Resource, RESOURCE_STATE State, bool IsWrite);
+    bool CullPasses();
+    void ComputeBarriers();
+    void AssignPhysicalResources();
+    bool AcquirePhysicalResources(IRenderDevice* pDevice);
+    void RecordPass(IDeviceContext* pContext, Uint32 ExecutionIndex);
+
+    std::vector<ResourceInfo> m_Resources;
+    std::vector<PassInfo>     m_Passes;
+    std::vector<Uint32>       m_ExecutionOrder;
+    std::vector<Barrier>      m_FinalBarriers;
+
+    std::vector<PhysicalResource> m_PhysicalResources;
+
+    // Resolved state transitions for every live pass (in execution order) and the final
+    // transitions, computed by Execute().
+    std::vector<std::vector<StateTransitionDesc>> m_ResolvedBarriers;
+
+    std::vector<PooledResource> m_Pool;
+
+    const Uint32 m_NumFramesToKeepUnused;
+    Uint64       m_FrameNumber = 0;
+    bool         m_IsCompiled  = false;
+};
+
+} // namespace Diligent
@@ -0,0 +1,180 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of a ResidencyManager class
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <functional>
+#include <unordered_map>
+
+#include "../../../Primitives/interface/BasicTypes.h"
+
+namespace Diligent
+{
+
+/// Evictable resource identifier.
+using EvictableResourceId = Uint32;
+
+/// Invalid evictable resource identifier.
+static constexpr EvictableResourceId InvalidEvictableResourceId = 0;
+
+/// Evictable resource information that is passed to the eviction policy.
+struct EvictableResourceInfo
+{
+    /// Resource identifier.
+    EvictableResourceId Id = InvalidEvictableResourceId;
+
+    /// Memory size of the resource, in bytes.
+    Uint64 Size = 0;
+
+    /// Fence value that was passed to ResidencyManager::MarkUsed() the last time
+    /// the resource was used.
+    Uint64 LastUsedFenceValue = 0;
+};
+
+/// Eviction policy selects the resources to evict when memory needs to be freed.
+class EvictionPolicy
+{
+public:
+    virtual ~EvictionPolicy() {}
+
+    /// Selects the resources to evict.
+
+    /// \param [in]  Candidates  - Resources that can be evicted. GPU work that used these
+    ///                            resources has completed.
+    /// \param [in]  BytesToFree - Amount of memory that needs to be freed.
+    /// \param [out] Victims     - Identifiers of the resources to evict.
+    virtual void SelectVictims(const std::vector<EvictableResourceInfo>& Candidates,
+                               Uint64                                    BytesToFree,
+                               std::vector<EvictableResourceId>&         Victims) = 0;
+};
+
+/// Evicts the least recently used resources first.
+class LRUEvictionPolicy final : public EvictionPolicy
+{
+public:
+    virtual void SelectVictims(const std::vector<EvictableResourceInfo>& Candidates,
+                               Uint64                                    BytesToFree,
+                               std::vector<EvictableResourceId>&         Victims) override final;
+};
+
+
+/// Residency manager keeps track of evictable resources and evicts them when
+/// the application needs to reduce its memory usage.
+
+/// The manager does not own the resources. The application registers a resource together with
+/// a callback that releases the resource, and reports every frame in which the resource is used
+/// with the fence value that will be signaled when the frame is complete. When memory usage
+/// exceeds the budget, the application calls Evict(). The manager then selects resources whose
+/// last use has completed on the GPU with the eviction policy, unregisters them and calls
+/// their eviction callbacks. An evicted resource must be registered again when it is reloaded.
+///
+/// In Vulkan backend, resources can be marked used with IRenderDeviceVk::GetNextFenceValue(),
+/// and the manager can be driven by IRenderDeviceVk::AddMemoryBudgetCallback():
+///
+///     static void OnMemoryBudget(Uint32 HeapIndex, const MemoryHeapBudgetVk& Budget, Bool OverThreshold, void* pUserData)
+///     {
+///         if (OverThreshold && Budget.IsDeviceLocal)
+///         {
+///             auto* pApp        = static_cast<MyApp*>(pUserData);
+///             auto  TargetUsage = static_cast<Uint64>(Budget.Budget * 0.8);
+///             pApp->ResidencyMgr.Evict(Budget.Usage - TargetUsage, pApp->pDeviceVk->GetCompletedFenceValue(0));
+///         }
+///     }
+///
+/// \remarks The class is thread-safe. Eviction callbacks are called without holding the internal lock.
+class ResidencyManager
+{
+public:
+    /// Eviction callback type. The callback must release the resource.
+    using EvictCallbackType = std::function<void(EvictableResourceId)>;
+
+    /// Creates the residency manager.
+
+    /// \param [in] pPolicy - Eviction policy. If null, LRUEvictionPolicy is used.
+    explicit ResidencyManager(std::unique_ptr<EvictionPolicy> pPolicy = nullptr);
+
+    // clang-format off
+    ResidencyManager           (const ResidencyManager&) = delete;
+    ResidencyManager& operator=(const ResidencyManager&) = delete;
+    // clang-format on
+
+    /// Registers an evictable resource.
+
+    /// \param [in] Size          - Memory size of the resource, in bytes.
+    /// \param [in] EvictCallback - Callback that releases the resource when it is evicted.
+    /// \param [in] FenceValue    - Fence value of the first use of the resource.
+    /// \return     Resource identifier.
+    EvictableResourceId RegisterResource(Uint64 Size, EvictCallbackType EvictCallback, Uint64 FenceValue = 0);
+
+    /// Unregisters the resource without calling its eviction callback.
+    void UnregisterResource(EvictableResourceId Id);
+
+    /// Marks the resource as used by the GPU work that will signal the fence value.
+    void MarkUsed(EvictableResourceId Id, Uint64 FenceValue);
+
+    /// Evicts resources to free the given amount of memory.
+
+    /// \param [in] BytesToFree         - Amount of memory to free.
+    /// \param [in] CompletedFenceValue - Last completed fence value. Only resources that
+    ///                                   were last used at or before this value may be evicted.
+    /// \return     Total size of the evicted resources.
+    Uint64 Evict(Uint64 BytesToFree, Uint64 CompletedFenceValue);
+
+    /// Sets the eviction policy. If pPolicy is null, LRUEvictionPolicy is used.
+    void SetEvictionPolicy(std::unique_ptr<EvictionPolicy> pPolicy);
+
+    /// Returns true if the resource is registered and has not been evicted.
+    bool IsResident(EvictableResourceId Id) const;
+
+    /// Returns the total size of the registered resources.
+    Uint64 GetResidentSize() const;
+
+    /// Returns the number of the registered resources.
+    Uint32 GetResidentCount() const;
+
+private:
+    struct ResourceInfo
+    {
+        Uint64            Size               = 0;
+        Uint64            LastUsedFenceValue = 0;
+        EvictCallbackType EvictCallback;
+    };
+
+    mutable std::mutex                                    m_Mtx;
+    std::unique_ptr<EvictionPolicy>                       m_pPolicy;
+    std::unordered_map<EvictableResourceId, ResourceInfo> m_Resources;
+    EvictableResourceId                                   m_NextId       = 1;
+    Uint64                                                m_ResidentSize = 0;
+};
+
+} // namespace Diligent
@@ -39,6 +39,8 @@
 namespace Diligent
 {
 
+class ThreadPool;
+
 class ScreenCapture
 {
 public:
@@ -62,6 +64,24 @@ public:
 
     void RecycleStagingTexture(RefCntAutoPtr<ITexture>&& pTexture);
 
+    /// Reads the captured image into CPU memory converting it to the given format.
+
+    /// \param [in]  pContext    - Device context used to map the staging texture.
+    /// \param [in]  Capture     - Capture returned by GetCapture().
+    /// \param [in]  DstFormat   - Destination format, see ConvertTextureData().
+    /// \param [out] pDstData    - Destination memory, must be large enough to hold the
+    ///                            entire image.
+    /// \param [in]  DstStride   - Destination row stride, in bytes.
+    /// \param [in]  pThreadPool - Optional thread pool. If not null, rows are converted
+    ///                            by the worker threads of the pool while the texture is mapped.
+    /// \return true if the data was successfully read and converted, and false otherwise.
+    bool ReadCaptureData(IDeviceContext*    pContext,
+                         const CaptureInfo& Capture,
+                         TEXTURE_FORMAT     DstFormat,
+                         void*              pDstData,
+                         Uint32             DstStride,
+                         ThreadPool*        pThreadPool = nullptr);
+
     size_t GetNumPendingCaptures()
     {
         std::lock_guard<std::mutex> Lock{m_PendingTexturesMtx};
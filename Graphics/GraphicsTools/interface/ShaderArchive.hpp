@@ -0,0 +1,334 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of the shader archive writer and reader
+
+// Shader archive is a single binary file that contains precompiled shaders for one
+// target (SPIR-V, GLSL, DXIL or DXBC), optionally with the serialized resource reflection,
+// and pipeline descriptions that reference the shaders by name. The archive is designed
+// to be memory-mapped and used in place: all tables are sorted and looked up with
+// binary search, and no per-record allocations are performed when the archive is opened.
+//
+//  | Header | Shader records | Pipeline records | String table | Data section |
+//
+// Shader permutations are identified by the shader name and the canonical permutation key
+// (see BuildShaderPermutationKey()), which does not depend on the order of the macros.
+
+#include <string>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/Shader.h"
+#include "../../GraphicsEngine/interface/PipelineState.h"
+#include "../../../Primitives/interface/DataBlob.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Shader archive target
+enum SHADER_ARCHIVE_TARGET : Uint8
+{
+    SHADER_ARCHIVE_TARGET_UNKNOWN = 0,
+
+    /// SPIR-V byte code (Vulkan)
+    SHADER_ARCHIVE_TARGET_SPIRV,
+
+    /// Preprocessed GLSL source (OpenGL/GLES)
+    SHADER_ARCHIVE_TARGET_GLSL,
+
+    /// DXIL byte code (Direct3D12)
+    SHADER_ARCHIVE_TARGET_DXIL,
+
+    /// DXBC byte code (Direct3D11 and Direct3D12)
+    SHADER_ARCHIVE_TARGET_DXBC,
+
+    SHADER_ARCHIVE_TARGET_COUNT
+};
+
+/// Returns the preferred shader archive target for the given device type
+SHADER_ARCHIVE_TARGET GetShaderArchiveTarget(RENDER_DEVICE_TYPE DeviceType);
+
+/// Returns true if shaders compiled for the given target can be used by the device
+bool IsShaderArchiveTargetCompatible(SHADER_ARCHIVE_TARGET Target, RENDER_DEVICE_TYPE DeviceType);
+
+/// Returns the literal name of the shader archive target, e.g. "SPIRV"
+const char* GetShaderArchiveTargetString(SHADER_ARCHIVE_TARGET Target);
+
+/// Builds the canonical permutation key from the null-terminated array of shader macros.
+
+/// The macros are sorted by name, so the key does not depend on the order in which
+/// the macros are defined. Macros with the same name are not allowed.
+std::string BuildShaderPermutationKey(const ShaderMacro* Macros);
+
+
+/// Reference to an archived shader permutation
+struct ShaderArchiveShaderRef
+{
+    /// Shader name. Null name indicates that the stage is not used.
+    const char* Name = nullptr;
+
+    /// Null-terminated array of macros that identify the permutation.
+    const ShaderMacro* Macros = nullptr;
+
+    ShaderArchiveShaderRef() noexcept {}
+
+    ShaderArchiveShaderRef(const char* _Name, const ShaderMacro* _Macros = nullptr) noexcept :
+        Name{_Name},
+        Macros{_Macros}
+    {}
+};
+
+/// Archived shaders used by a graphics pipeline
+struct ShaderArchiveGraphicsShaders
+{
+    ShaderArchiveShaderRef VS;
+    ShaderArchiveShaderRef PS;
+    ShaderArchiveShaderRef DS;
+    ShaderArchiveShaderRef HS;
+    ShaderArchiveShaderRef GS;
+    ShaderArchiveShaderRef AS;
+    ShaderArchiveShaderRef MS;
+};
+
+
+/// Builds the shader archive.
+
+/// The writer copies all the data, so the pointers passed to AddShader() and
+/// Add*Pipeline() methods do not need to be valid after the methods return.
+class ShaderArchiveWriter
+{
+public:
+    /// Shader permutation data
+    struct ShaderData
+    {
+        /// Shader name
+        const char* Name = nullptr;
+
+        /// Null-terminated array of macros that identify the permutation.
+        const ShaderMacro* Macros = nullptr;
+
+        /// Shader type
+        SHADER_TYPE ShaderType = SHADER_TYPE_UNKNOWN;
+
+        /// Shader entry point
+        const char* EntryPoint = "main";
+
+        /// Whether the shader uses combined texture samplers, see ShaderCreateInfo::UseCombinedTextureSamplers.
+        bool UseCombinedTextureSamplers = false;
+
+        /// Combined sampler suffix, see ShaderCreateInfo::CombinedSamplerSuffix.
+        const char* CombinedSamplerSuffix = "_sampler";
+
+        /// Shader byte code or GLSL source
+        const void* pByteCode = nullptr;
+
+        /// Byte code size. For GLSL target, this is the source length,
+        /// not including the null terminator.
+        size_t ByteCodeSize = 0;
+
+        /// Optional serialized shader resources (see SPIRVShaderResources::Serialize).
+        /// Only used with SPIR-V target.
+        const void* pResources = nullptr;
+
+        /// Size of the serialized shader resources
+        size_t ResourcesSize = 0;
+    };
+
+    explicit ShaderArchiveWriter(SHADER_ARCHIVE_TARGET Target);
+
+    // clang-format off
+    ShaderArchiveWriter           (const ShaderArchiveWriter&)  = delete;
+    ShaderArchiveWriter& operator=(const ShaderArchiveWriter&)  = delete;
+    ShaderArchiveWriter           (      ShaderArchiveWriter&&) = delete;
+    ShaderArchiveWriter& operator=(      ShaderArchiveWriter&&) = delete;
+    // clang-format on
+
+    ~ShaderArchiveWriter();
+
+    /// Adds a shader permutation to the archive.
+
+    /// \return     false if a permutation with the same name and macros already exists
+    ///             or if the data is invalid, and true otherwise.
+    bool AddShader(const ShaderData& Data);
+
+    /// Adds a graphics pipeline to the archive.
+
+    /// \param [in] PSOCreateInfo - Pipeline create info. Shader pointers are ignored and
+    ///                             explicit render passes are not supported.
+    /// \param [in] Shaders       - Archived shaders used by the pipeline. The shaders must
+    ///                             be added to the archive before Serialize() is called.
+    /// \return     true if the pipeline was added successfully, and false otherwise.
+    bool AddGraphicsPipeline(const GraphicsPipelineStateCreateInfo& PSOCreateInfo,
+                             const ShaderArchiveGraphicsShaders&    Shaders);
+
+    /// Adds a compute pipeline to the archive.
+    bool AddComputePipeline(const ComputePipelineStateCreateInfo& PSOCreateInfo,
+                            const ShaderArchiveShaderRef&         CS);
+
+    /// Serializes the archive into a data blob.
+
+    /// \return     false if the archive could not be serialized, e.g. because
+    ///             a pipeline references a shader that is not in the archive.
+    bool Serialize(IDataBlob** ppArchive) const;
+
+    SHADER_ARCHIVE_TARGET GetTarget() const { return m_Target; }
+
+    size_t GetShaderCount() const;
+    size_t GetPipelineCount() const;
+
+private:
+    struct ShaderRecord;
+    struct PipelineRecord;
+
+    const SHADER_ARCHIVE_TARGET m_Target;
+
+    std::vector<ShaderRecord>   m_Shaders;
+    std::vector<PipelineRecord> m_Pipelines;
+};
+
+
+/// Provides read-only access to the shader archive.
+
+/// The archive data is used in place and is never copied. When the archive is created
+/// from a raw memory pointer (e.g. memory-mapped file), the memory must remain valid
+/// for the lifetime of the ShaderArchive object. The data must be at least 8-byte aligned.
+class ShaderArchive
+{
+public:
+    /// Opens the archive that references raw memory.
+    ShaderArchive(const void* pData, size_t Size);
+
+    /// Opens the archive that keeps a strong reference to the data blob.
+    explicit ShaderArchive(IDataBlob* pArchiveData);
+
+    // clang-format off
+    ShaderArchive           (const ShaderArchive&)  = delete;
+    ShaderArchive& operator=(const ShaderArchive&)  = delete;
+    ShaderArchive           (      ShaderArchive&&) = delete;
+    ShaderArchive& operator=(      ShaderArchive&&) = delete;
+    // clang-format on
+
+    ~ShaderArchive();
+
+    /// Returns true if the archive data is valid
+    bool IsValid() const { return m_pHeader != nullptr; }
+
+    SHADER_ARCHIVE_TARGET GetTarget() const;
+
+    Uint32 GetShaderCount() const;
+    Uint32 GetPipelineCount() const;
+
+    /// Archived shader permutation information. All pointers reference the archive data.
+    struct ShaderInfo
+    {
+        const char* Name                  = nullptr;
+        const char* PermutationKey        = nullptr;
+        const char* EntryPoint            = nullptr;
+        const char* CombinedSamplerSuffix = nullptr;
+
+        SHADER_TYPE ShaderType                 = SHADER_TYPE_UNKNOWN;
+        bool        UseCombinedTextureSamplers = false;
+
+        const void* pByteCode    = nullptr;
+        size_t      ByteCodeSize = 0;
+
+        const void* pResources    = nullptr;
+        size_t      ResourcesSize = 0;
+    };
+
+    /// Finds the shader permutation in the archive.
+
+    /// \return     true if the permutation was found, and false otherwise.
+    bool FindShader(const char* Name, const ShaderMacro* Macros, ShaderInfo& Info) const;
+
+    /// Returns the shader permutation information by index in the range [0, GetShaderCount()).
+    ShaderInfo GetShaderInfo(Uint32 Index) const;
+
+    /// Returns the name of the pipeline with the given index in the range [0, GetPipelineCount()).
+    const char* GetPipelineName(Uint32 Index) const;
+
+    /// Creates the shader from the archived permutation.
+
+    /// \param [in]  pDevice  - Render device. The archive target must be compatible with the device type.
+    /// \param [in]  Name     - Shader name.
+    /// \param [in]  Macros   - Null-terminated array of macros that identify the permutation.
+    /// \param [out] ppShader - Address of the memory location where the pointer to the shader
+    ///                         will be written. If the shader is not found, or could not
+    ///                         be created, null is written.
+    void CreateShader(IRenderDevice*     pDevice,
+                      const char*        Name,
+                      const ShaderMacro* Macros,
+                      IShader**          ppShader) const;
+
+    /// Creates the pipeline state from the archived description.
+
+    /// \param [in]  pDevice - Render device.
+    /// \param [in]  Name    - Pipeline name.
+    /// \param [out] ppPSO   - Address of the memory location where the pointer to the pipeline
+    ///                        will be written. If the pipeline is not found, or could not be
+    ///                        created, null is written.
+    ///
+    /// \remarks    Shaders referenced by the pipeline are created from the archive every time
+    ///             the method is called. Applications should cache the pipelines rather than
+    ///             create them repeatedly.
+    void CreatePipelineState(IRenderDevice*   pDevice,
+                             const char*      Name,
+                             IPipelineState** ppPSO) const;
+
+    /// Current archive format version
+    static constexpr Uint32 FormatVersion = 1;
+
+private:
+    friend class ShaderArchiveWriter;
+
+    void Initialize(const void* pData, size_t Size);
+
+    Uint32 FindShaderRecord(const char* Name, const char* PermutationKey) const;
+
+    void CreateShader(IRenderDevice*    pDevice,
+                      const ShaderInfo& Info,
+                      IShader**         ppShader) const;
+
+    const char* GetString(Uint32 Offset) const;
+
+    template <typename RecordType>
+    const RecordType* GetRecords(Uint32 Offset) const;
+
+    struct Header;
+
+    RefCntAutoPtr<IDataBlob> m_pArchiveData;
+
+    const Uint8*  m_pData    = nullptr;
+    size_t        m_DataSize = 0;
+    const Header* m_pHeader  = nullptr;
+};
+
+} // namespace Diligent
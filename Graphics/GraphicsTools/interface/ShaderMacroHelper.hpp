@@ -42,12 +42,16 @@
 //--------------------------------------------------------------------------------------
 #pragma once
 
-#include <set>
 #include <vector>
+#include <memory>
 #include <sstream>
 #include <iomanip>
+#include <cstdio>
+#include <cstring>
 #include "../../GraphicsEngine/interface/Shader.h"
 #include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
+#include "../../../Common/interface/DynamicLinearAllocator.hpp"
+#include "../../../Common/interface/DefaultRawMemoryAllocator.hpp"
 
 
 namespace Diligent
@@ -56,18 +60,39 @@ namespace Diligent
 class ShaderMacroHelper
 {
 public:
-    template <typename DefintionType>
-    void AddShaderMacro(const Char* Name, DefintionType Definition)
+    ShaderMacroHelper() = default;
+
+    // Macro definitions are stored in the pool owned by the helper, so
+    // the copy gets its own pool and its macros point to the copied strings.
+    ShaderMacroHelper(const ShaderMacroHelper& Other)
     {
-#if DILIGENT_DEBUG
-        for (size_t i = 0; i < m_Macros.size() && m_Macros[i].Definition != nullptr; ++i)
+        *this = Other;
+    }
+
+    ShaderMacroHelper& operator=(const ShaderMacroHelper& Other)
+    {
+        if (this == &Other)
+            return *this;
+
+        Clear();
+        m_Macros.reserve(Other.m_Macros.size());
+        for (const auto& Macro : Other.m_Macros)
         {
-            if (strcmp(m_Macros[i].Name, Name) == 0)
-            {
-                UNEXPECTED("Macro '", Name, "' already exists. Use UpdateMacro() to update the macro value.");
-            }
+            m_Macros.emplace_back(Macro.Name, Macro.Definition != nullptr ? CopyDefinition(Macro.Definition) : nullptr);
         }
-#endif
+        m_bIsFinalized = Other.m_bIsFinalized;
+
+        return *this;
+    }
+
+    // clang-format off
+    ShaderMacroHelper           (ShaderMacroHelper&&) = default;
+    ShaderMacroHelper& operator=(ShaderMacroHelper&&) = default;
+    // clang-format on
+
+    template <typename DefintionType>
+    void AddShaderMacro(const Char* Name, DefintionType Definition)
+    {
         std::ostringstream ss;
         ss << Definition;
         AddShaderMacro<const Char*>(Name, ss.str().c_str());
@@ -95,7 +120,9 @@ public:
     void Clear()
     {
         m_Macros.clear();
-        m_DefinitionsPool.clear();
+        // Keep the pool pages to reuse them for the next set of macros
+        if (m_DefinitionsPool)
+            m_DefinitionsPool->Discard();
         m_bIsFinalized = false;
     }
 
@@ -131,17 +158,51 @@ public:
     }
 
 private:
+    const Char* CopyDefinition(const Char* Definition)
+    {
+        if (!m_DefinitionsPool)
+            m_DefinitionsPool.reset(new DynamicLinearAllocator{DefaultRawMemoryAllocator::GetAllocator(), 1024});
+
+        const auto Len = strlen(Definition);
+        auto*      Dst = m_DefinitionsPool->Allocate<Char>(Len + 1);
+        memcpy(Dst, Definition, Len + 1);
+        return Dst;
+    }
+
     std::vector<ShaderMacro> m_Macros;
-    std::set<std::string>    m_DefinitionsPool;
-    bool                     m_bIsFinalized = false;
+    // Linear pool avoids allocating every definition string on the heap
+    std::unique_ptr<DynamicLinearAllocator> m_DefinitionsPool;
+    bool                                    m_bIsFinalized = false;
 };
 
 template <>
 inline void ShaderMacroHelper::AddShaderMacro(const Char* Name, const Char* Definition)
 {
+#if DILIGENT_DEBUG
+    for (size_t i = 0; i < m_Macros.size() && m_Macros[i].Definition != nullptr; ++i)
+    {
+        if (strcmp(m_Macros[i].Name, Name) == 0)
+        {
+            UNEXPECTED("Macro '", Name, "' already exists. Use UpdateMacro() to update the macro value.");
+        }
+    }
+#endif
     Reopen();
-    auto* PooledDefinition = m_DefinitionsPool.insert(Definition).first->c_str();
-    m_Macros.emplace_back(Name, PooledDefinition);
+    m_Macros.emplace_back(Name, CopyDefinition(Definition));
+}
+
+template <>
+inline void ShaderMacroHelper::AddShaderMacro(const Char* Name, Char* Definition)
+{
+    AddShaderMacro<const Char*>(Name, Definition);
+}
+
+template <>
+inline void ShaderMacroHelper::AddShaderMacro(const Char* Name, Int32 Definition)
+{
+    char Buffer[16];
+    snprintf(Buffer, sizeof(Buffer), "%d", Definition);
+    AddShaderMacro<const Char*>(Name, Buffer);
 }
 
 template <>
@@ -169,9 +230,9 @@ template <>
 inline void ShaderMacroHelper::AddShaderMacro(const Char* Name, Uint32 Definition)
 {
     // Make sure that uint constants have the 'u' suffix to avoid problems in GLES.
-    std::ostringstream ss;
-    ss << Definition << 'u';
-    AddShaderMacro<const Char*>(Name, ss.str().c_str());
+    char Buffer[16];
+    snprintf(Buffer, sizeof(Buffer), "%uu", Definition);
+    AddShaderMacro<const Char*>(Name, Buffer);
 }
 
 template <>
@@ -0,0 +1,140 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of the ShaderSourceDependencyRecorder class
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/Shader.h"
+#include "../../../Common/interface/ObjectBase.hpp"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Shader source stream factory that records shader source dependencies.
+
+/// The recorder wraps another shader source stream factory and keeps track of all files
+/// that are opened through it: the shader source file itself and all files it includes,
+/// directly or indirectly. For every file, the hash of its contents is recorded, so that
+/// the dependency hash can be used to key a shader byte code cache: the byte code is
+/// up to date as long as all dependencies still have the same contents (see AreDependenciesUpToDate()).
+///
+/// Files that were requested but not found are recorded as well, since a file that is added
+/// later may change the result of the compilation.
+///
+/// To record dependencies of a shader, create a recorder, set it as ShaderCreateInfo::pShaderSourceStreamFactory
+/// and compile the shader. The recorder may be reused for another shader after calling Reset().
+class ShaderSourceDependencyRecorder final : public ObjectBase<IShaderSourceInputStreamFactory>
+{
+public:
+    using TBase = ObjectBase<IShaderSourceInputStreamFactory>;
+
+    struct Dependency
+    {
+        /// File name, as requested by the compiler.
+        std::string Name;
+
+        /// Hash of the file contents.
+        size_t ContentHash = 0;
+
+        /// File size.
+        size_t Size = 0;
+
+        /// Whether the file was found.
+        bool Found = false;
+
+        Dependency() noexcept {}
+
+        Dependency(std::string _Name, size_t _ContentHash, size_t _Size, bool _Found) :
+            // clang-format off
+            Name       {std::move(_Name)},
+            ContentHash{_ContentHash     },
+            Size       {_Size            },
+            Found      {_Found           }
+        // clang-format on
+        {}
+
+        bool operator==(const Dependency& rhs) const
+        {
+            // clang-format off
+            return ContentHash == rhs.ContentHash &&
+                   Size        == rhs.Size        &&
+                   Found       == rhs.Found       &&
+                   Name        == rhs.Name;
+            // clang-format on
+        }
+    };
+
+    /// \param [in] pRefCounters - Reference counters object that controls the lifetime of this object.
+    /// \param [in] pFactory     - Shader source stream factory that is used to open files.
+    ShaderSourceDependencyRecorder(IReferenceCounters*              pRefCounters,
+                                   IShaderSourceInputStreamFactory* pFactory);
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_IShaderSourceInputStreamFactory, TBase);
+
+    virtual void DILIGENT_CALL_TYPE CreateInputStream(const Char* Name, IFileStream** ppStream) override final;
+
+    virtual void DILIGENT_CALL_TYPE CreateInputStream2(const Char*                             Name,
+                                                       CREATE_SHADER_SOURCE_INPUT_STREAM_FLAGS Flags,
+                                                       IFileStream**                           ppStream) override final;
+
+    /// Returns the dependencies recorded since the recorder was created or last reset,
+    /// sorted by name. Every file is recorded only once.
+    std::vector<Dependency> GetDependencies() const;
+
+    /// Returns the hash of all recorded dependencies.
+    size_t GetDependencyHash() const;
+
+    /// Clears all recorded dependencies.
+    void Reset();
+
+    /// Computes the hash of the dependency list. Like ComputeContentHash(), the function uses
+    /// the FNV-1a hash, so the result does not depend on the standard library implementation.
+    static size_t ComputeDependencyHash(const std::vector<Dependency>& Dependencies);
+
+    /// Checks if the dependencies recorded by a previous compilation are still up to date,
+    /// i.e. all files have the same contents and missing files are still missing.
+    static bool AreDependenciesUpToDate(IShaderSourceInputStreamFactory* pFactory,
+                                        const std::vector<Dependency>&   Dependencies);
+
+    /// Computes the hash of the file contents in the same way the recorder does.
+    static size_t ComputeContentHash(const void* pData, size_t Size);
+
+private:
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> m_pFactory;
+
+    mutable std::mutex      m_Mtx;
+    std::vector<Dependency> m_Dependencies;
+};
+
+} // namespace Diligent
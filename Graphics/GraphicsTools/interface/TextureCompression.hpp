@@ -0,0 +1,137 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines CPU block compression functions
+
+#include <vector>
+
+#include "../../GraphicsEngine/interface/GraphicsTypes.h"
+
+namespace Diligent
+{
+
+class ThreadPool;
+
+/// Block compression quality preset
+enum TEXTURE_COMPRESSION_QUALITY : Uint8
+{
+    /// Endpoints are fitted along the principal axis of the block texels
+    /// and are not refined.
+    TEXTURE_COMPRESSION_QUALITY_FAST = 0,
+
+    /// Endpoints are fitted along the principal axis and refined once
+    /// with the least squares fit to the selected indices.
+    TEXTURE_COMPRESSION_QUALITY_NORMAL,
+
+    /// Endpoints are refined until the error stops improving, alternative
+    /// BC4 interpolation mode and all BC7 p-bit combinations are evaluated.
+    TEXTURE_COMPRESSION_QUALITY_HIGH
+};
+
+/// Texture compression attributes
+struct TextureCompressionAttribs
+{
+    /// Block-compressed destination format.
+
+    /// The following formats are supported: BC1_UNORM, BC1_UNORM_SRGB, BC3_UNORM, BC3_UNORM_SRGB,
+    /// BC4_UNORM, BC5_UNORM, BC7_UNORM and BC7_UNORM_SRGB.
+    /// BC1 blocks are always encoded as opaque; source alpha is ignored.
+    /// BC7 blocks are encoded using mode 6 (single subset with 4-bit indices).
+    TEXTURE_FORMAT DstFormat = TEX_FORMAT_UNKNOWN;
+
+    /// Compression quality preset.
+    TEXTURE_COMPRESSION_QUALITY Quality = TEXTURE_COMPRESSION_QUALITY_NORMAL;
+
+    /// Optional thread pool. If not null, rows of blocks are compressed in parallel
+    /// by the worker threads of the pool. The compression functions must not be called
+    /// from a worker thread of the same pool.
+    ThreadPool* pThreadPool = nullptr;
+};
+
+/// Returns true if CompressTextureData can produce the given format.
+bool IsTextureCompressionSupported(TEXTURE_FORMAT Format);
+
+/// Compresses 2D texture data.
+
+/// \param [in]  Width     - Image width, in texels. Does not need to be a multiple of the block size.
+/// \param [in]  Height    - Image height, in texels. Does not need to be a multiple of the block size.
+/// \param [in]  SrcFormat - Format of the source data. Must be an 8-bit UNORM or UNORM_SRGB format
+///                          with one, two or four components, e.g. TEX_FORMAT_R8_UNORM,
+///                          TEX_FORMAT_RG8_UNORM, TEX_FORMAT_RGBA8_UNORM or TEX_FORMAT_BGRA8_UNORM.
+///                          Missing color components are read as zero and missing alpha as one.
+/// \param [in]  pSrcData  - Source data.
+/// \param [in]  SrcStride - Source data row stride, in bytes.
+/// \param [out] pDstData  - Memory where compressed blocks will be written.
+/// \param [in]  DstStride - Stride between rows of blocks in the destination memory, in bytes.
+/// \param [in]  Attribs   - Compression attributes.
+///
+/// \remarks    Texels are compressed as they are stored: no color space conversion is performed.
+///             Blocks that extend past the image boundaries are padded by replicating the edge texels.
+void CompressTextureData(Uint32                           Width,
+                         Uint32                           Height,
+                         TEXTURE_FORMAT                   SrcFormat,
+                         const void*                      pSrcData,
+                         Uint32                           SrcStride,
+                         void*                            pDstData,
+                         Uint32                           DstStride,
+                         const TextureCompressionAttribs& Attribs);
+
+/// Compressed mip level produced by CompressMipChain
+struct CompressedMipLevel
+{
+    Uint32 Width  = 0;
+    Uint32 Height = 0;
+
+    /// Stride between rows of blocks, in bytes
+    Uint32 Stride = 0;
+
+    std::vector<Uint8> Data;
+};
+
+/// Generates the mip chain of an uncompressed image and compresses every level.
+
+/// \param [in]  Width, Height, SrcFormat, pSrcData, SrcStride - Top mip level, see CompressTextureData.
+/// \param [in]  NumMipLevels - The number of mip levels to generate. If zero, the full mip chain is generated.
+/// \param [in]  Attribs      - Compression attributes.
+/// \param [out] MipLevels    - Compressed mip levels.
+///
+/// \remarks    Coarse mip levels are computed from the uncompressed data with ComputeMipLevel,
+///             so compression errors do not accumulate down the chain. Level data can be directly
+///             referenced by TextureSubResData when creating a texture.
+void CompressMipChain(Uint32                           Width,
+                      Uint32                           Height,
+                      TEXTURE_FORMAT                   SrcFormat,
+                      const void*                      pSrcData,
+                      Uint32                           SrcStride,
+                      Uint32                           NumMipLevels,
+                      const TextureCompressionAttribs& Attribs,
+                      std::vector<CompressedMipLevel>& MipLevels);
+
+} // namespace Diligent
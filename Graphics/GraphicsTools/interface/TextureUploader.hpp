@@ -33,6 +33,8 @@
 namespace Diligent
 {
 
+class ThreadPool;
+
 // clang-format off
 
 /// Upload buffer description
@@ -146,4 +148,32 @@ public:
 
 void CreateTextureUploader(IRenderDevice* pDevice, const TextureUploaderDesc& Desc, ITextureUploader** ppUploader);
 
+/// Writes texel data to the upload buffer subresource converting it to the buffer format.
+
+/// \param [in] pUploadBuffer  - Upload buffer to write data to.
+/// \param [in] Mip            - Mip level of the upload buffer.
+/// \param [in] Slice          - Array slice of the upload buffer.
+/// \param [in] SrcFormat      - Format of the source data. Can be any format supported by
+///                              ConvertTextureData(), including block-compressed formats, which
+///                              allows e.g. decompressing BC textures for devices that don't support them.
+/// \param [in] pSrcData       - Source data.
+/// \param [in] SrcStride      - Source row stride, in bytes. For block-compressed formats,
+///                              this is the stride between rows of blocks.
+/// \param [in] SrcDepthStride - Source depth slice stride, in bytes. Only used for 3D upload buffers.
+/// \param [in] pThreadPool    - Optional thread pool used to convert rows in parallel.
+///                              Must be null when the function is called from a worker thread of the pool.
+/// \return true if the data was successfully converted, and false otherwise.
+///
+/// \remarks  The function does not use the device context and is intended to be called from
+///           the worker thread that loads the texture, after the buffer has been allocated and before
+///           the GPU copy is scheduled.
+bool WriteUploadBufferData(IUploadBuffer* pUploadBuffer,
+                           Uint32         Mip,
+                           Uint32         Slice,
+                           TEXTURE_FORMAT SrcFormat,
+                           const void*    pSrcData,
+                           Uint32         SrcStride,
+                           Uint32         SrcDepthStride = 0,
+                           ThreadPool*    pThreadPool    = nullptr);
+
 } // namespace Diligent
@@ -0,0 +1,565 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#include "AsyncReadback.h"
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+
+#include "DebugUtilities.hpp"
+#include "ObjectBase.hpp"
+#include "RefCntAutoPtr.hpp"
+#include "Align.hpp"
+#include "GraphicsAccessories.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+class AsyncReadbackImpl final : public ObjectBase<IAsyncReadback>
+{
+public:
+    using TBase = ObjectBase<IAsyncReadback>;
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_AsyncReadback, TBase)
+
+    AsyncReadbackImpl(IReferenceCounters*            pRefCounters,
+                      IRenderDevice*                 pDevice,
+                      const AsyncReadbackCreateInfo& CreateInfo) :
+        // clang-format off
+        TBase              {pRefCounters},
+        m_pDevice          {pDevice},
+        m_PageSize         {std::max(CreateInfo.StagingPageSize, Uint32{StagingDataAlignment})},
+        m_MaxFramesInFlight{std::max(CreateInfo.MaxFramesInFlight, 1u)},
+        m_MaxCachedPages   {CreateInfo.MaxCachedPages},
+        m_MaxCachedTextures{CreateInfo.MaxCachedTextures}
+    // clang-format on
+    {
+        if (m_pDevice == nullptr)
+            LOG_ERROR_AND_THROW("Render device must not be null");
+
+        FenceDesc Desc;
+        Desc.Name = "Async readback fence";
+        m_pDevice->CreateFence(Desc, &m_pFence);
+        if (!m_pFence)
+            LOG_ERROR_AND_THROW("Failed to create async readback fence");
+    }
+
+    ~AsyncReadbackImpl()
+    {
+        // Without a device context, the data of pending requests can't be read,
+        // so notify the callbacks that the requests have been cancelled.
+        for (auto& Frame : m_PendingFrames)
+            CancelRequests(Frame);
+        CancelRequests(m_CurrentFrame);
+    }
+
+    virtual Uint64 ReadBuffer(IDeviceContext*                pContext,
+                              IBuffer*                       pBuffer,
+                              Uint32                         Offset,
+                              Uint32                         Size,
+                              RESOURCE_STATE_TRANSITION_MODE TransitionMode,
+                              AsyncReadbackCallbackType      Callback) override final
+    {
+        DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+        if (pBuffer == nullptr)
+        {
+            LOG_ERROR_MESSAGE("Buffer must not be null");
+            return 0;
+        }
+        const auto& BuffDesc = pBuffer->GetDesc();
+        if (Size == 0 || Offset > BuffDesc.uiSizeInBytes || Size > BuffDesc.uiSizeInBytes - Offset)
+        {
+            LOG_ERROR_MESSAGE("Invalid readback region [", Offset, ", ", Offset + Size, ") of buffer '", BuffDesc.Name,
+                              "' of size ", BuffDesc.uiSizeInBytes);
+            return 0;
+        }
+
+        Uint32 PageOffset = 0;
+        auto   PageIdx    = AllocateStagingMemory(Size, PageOffset);
+        if (PageIdx == InvalidPageIdx)
+            return 0;
+
+        pContext->CopyBuffer(pBuffer, Offset, TransitionMode,
+                             m_CurrentFrame.Pages[PageIdx].pBuffer, PageOffset, Size, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        ReadbackRequest Request;
+        Request.Id          = m_NextRequestId++;
+        Request.Callback    = std::move(Callback);
+        Request.PageIdx     = PageIdx;
+        Request.PageOffset  = PageOffset;
+        Request.Data.Width  = Size;
+        Request.Data.Height = 1;
+        Request.Data.Depth  = 1;
+        m_CurrentFrame.Requests.emplace_back(std::move(Request));
+        ++m_NumPendingReadbacks;
+
+        return m_CurrentFrame.Requests.back().Id;
+    }
+
+    virtual Uint64 ReadTexture(IDeviceContext*                    pContext,
+                               const AsyncReadbackTextureAttribs& Attribs,
+                               AsyncReadbackCallbackType          Callback) override final
+    {
+        DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+        if (Attribs.pTexture == nullptr)
+        {
+            LOG_ERROR_MESSAGE("Texture must not be null");
+            return 0;
+        }
+
+        const auto& TexDesc = Attribs.pTexture->GetDesc();
+        if (Attribs.MipLevel >= TexDesc.MipLevels)
+        {
+            LOG_ERROR_MESSAGE("Mip level ", Attribs.MipLevel, " is out of range for texture '", TexDesc.Name,
+                              "' that has ", TexDesc.MipLevels, " levels");
+            return 0;
+        }
+        if (TexDesc.SampleCount > 1)
+        {
+            LOG_ERROR_MESSAGE("Multisampled texture '", TexDesc.Name, "' can't be read back. Resolve it first.");
+            return 0;
+        }
+
+        const auto MipProps = GetMipLevelProperties(TexDesc, Attribs.MipLevel);
+        const bool Is3D     = TexDesc.Type == RESOURCE_DIM_TEX_3D;
+        if (!Is3D && Attribs.ArraySlice >= TexDesc.ArraySize)
+        {
+            LOG_ERROR_MESSAGE("Array slice ", Attribs.ArraySlice, " is out of range for texture '", TexDesc.Name,
+                              "' that has ", TexDesc.ArraySize, " slices");
+            return 0;
+        }
+
+        Box Region{0, MipProps.LogicalWidth, 0, MipProps.LogicalHeight, 0, Is3D ? MipProps.Depth : 1};
+        if (Attribs.pRegion != nullptr)
+        {
+            const auto& R = *Attribs.pRegion;
+            // clang-format off
+            if (R.MinX >= R.MaxX || R.MaxX > Region.MaxX ||
+                R.MinY >= R.MaxY || R.MaxY > Region.MaxY ||
+                R.MinZ >= R.MaxZ || R.MaxZ > Region.MaxZ)
+            // clang-format on
+            {
+                LOG_ERROR_MESSAGE("Readback region [", R.MinX, ", ", R.MaxX, ") x [", R.MinY, ", ", R.MaxY, ") x [", R.MinZ, ", ", R.MaxZ,
+                                  ") is out of bounds of mip level ", Attribs.MipLevel, " of texture '", TexDesc.Name, "'");
+                return 0;
+            }
+            Region = R;
+        }
+
+        TextureDesc StagingDesc;
+        StagingDesc.Name           = "Async readback staging texture";
+        StagingDesc.Type           = Is3D ? RESOURCE_DIM_TEX_3D : RESOURCE_DIM_TEX_2D;
+        StagingDesc.Width          = Region.MaxX - Region.MinX;
+        StagingDesc.Height         = Region.MaxY - Region.MinY;
+        StagingDesc.Depth          = Is3D ? Region.MaxZ - Region.MinZ : 1;
+        StagingDesc.Format         = TexDesc.Format;
+        StagingDesc.Usage          = USAGE_STAGING;
+        StagingDesc.CPUAccessFlags = CPU_ACCESS_READ;
+
+        auto pStagingTex = GetStagingTexture(StagingDesc);
+        if (!pStagingTex)
+            return 0;
+
+        CopyTextureAttribs CopyAttribs{Attribs.pTexture, Attribs.TransitionMode, pStagingTex, RESOURCE_STATE_TRANSITION_MODE_TRANSITION};
+        CopyAttribs.SrcMipLevel = Attribs.MipLevel;
+        CopyAttribs.SrcSlice    = Is3D ? 0 : Attribs.ArraySlice;
+        CopyAttribs.pSrcBox     = &Region;
+        pContext->CopyTexture(CopyAttribs);
+
+        ReadbackRequest Request;
+        Request.Id          = m_NextRequestId++;
+        Request.Callback    = std::move(Callback);
+        Request.pStagingTex = std::move(pStagingTex);
+        Request.Data.Width  = StagingDesc.Width;
+        Request.Data.Height = StagingDesc.Height;
+        Request.Data.Depth  = StagingDesc.Depth;
+        Request.Data.Format = StagingDesc.Format;
+        m_CurrentFrame.Requests.emplace_back(std::move(Request));
+        ++m_NumPendingReadbacks;
+
+        return m_CurrentFrame.Requests.back().Id;
+    }
+
+    virtual Uint64 FinishFrame(IDeviceContext* pContext) override final
+    {
+        DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+
+        if (!m_CurrentFrame.Requests.empty())
+        {
+            m_CurrentFrame.FenceValue = m_NextFenceValue++;
+            pContext->SignalFence(m_pFence, m_CurrentFrame.FenceValue);
+            m_PendingFrames.emplace_back(std::move(m_CurrentFrame));
+            m_CurrentFrame = FrameData{};
+        }
+        else
+        {
+            VERIFY_EXPR(m_CurrentFrame.Pages.empty());
+        }
+
+        ProcessCompletedReadbacks(pContext);
+
+        while (m_PendingFrames.size() > m_MaxFramesInFlight)
+        {
+            pContext->WaitForFence(m_pFence, m_PendingFrames.front().FenceValue, true);
+            ProcessCompletedReadbacks(pContext);
+        }
+
+        return m_NextFenceValue - 1;
+    }
+
+    virtual Uint32 ProcessCompletedReadbacks(IDeviceContext* pContext) override final
+    {
+        DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+
+        Uint32     NumProcessed        = 0;
+        const auto CompletedFenceValue = m_pFence->GetCompletedValue();
+        while (!m_PendingFrames.empty() && m_PendingFrames.front().FenceValue <= CompletedFenceValue)
+        {
+            // Move the frame out of the queue first as the callbacks may issue new requests
+            auto Frame = std::move(m_PendingFrames.front());
+            m_PendingFrames.pop_front();
+            NumProcessed += ProcessFrame(pContext, Frame);
+        }
+        return NumProcessed;
+    }
+
+    virtual void WaitForAllReadbacks(IDeviceContext* pContext) override final
+    {
+        FinishFrame(pContext);
+        if (!m_PendingFrames.empty())
+        {
+            pContext->WaitForFence(m_pFence, m_PendingFrames.back().FenceValue, true);
+            ProcessCompletedReadbacks(pContext);
+        }
+    }
+
+    virtual Uint32 GetNumPendingReadbacks() const override final
+    {
+        return m_NumPendingReadbacks;
+    }
+
+    virtual IFence* GetFence() override final
+    {
+        return m_pFence;
+    }
+
+private:
+    static constexpr Uint32 StagingDataAlignment = 16;
+    static constexpr size_t InvalidPageIdx       = ~size_t{0};
+
+    struct StagingPage
+    {
+        RefCntAutoPtr<IBuffer> pBuffer;
+        Uint32                 Size   = 0;
+        Uint32                 Offset = 0;
+    };
+
+    struct ReadbackRequest
+    {
+        Uint64                    Id = 0;
+        AsyncReadbackCallbackType Callback;
+
+        // Buffer requests
+        size_t PageIdx    = InvalidPageIdx;
+        Uint32 PageOffset = 0;
+
+        // Texture requests
+        RefCntAutoPtr<ITexture> pStagingTex;
+
+        AsyncReadbackData Data;
+    };
+
+    struct FrameData
+    {
+        Uint64                       FenceValue = 0;
+        std::vector<StagingPage>     Pages;
+        std::vector<ReadbackRequest> Requests;
+    };
+
+    size_t AllocateStagingMemory(Uint32 Size, Uint32& Offset)
+    {
+        auto& Pages = m_CurrentFrame.Pages;
+        if (!Pages.empty())
+        {
+            auto& Page = Pages.back();
+            auto  Pos  = Align(Page.Offset, StagingDataAlignment);
+            if (Pos <= Page.Size && Size <= Page.Size - Pos)
+            {
+                Offset      = Pos;
+                Page.Offset = Pos + Size;
+                return Pages.size() - 1;
+            }
+        }
+
+        StagingPage NewPage;
+        if (Size <= m_PageSize && !m_FreePages.empty())
+        {
+            NewPage = std::move(m_FreePages.back());
+            m_FreePages.pop_back();
+        }
+        else
+        {
+            // Requests that do not fit into a page get a dedicated buffer
+            NewPage.Size = std::max(m_PageSize, Size);
+
+            BufferDesc Desc;
+            Desc.Name           = "Async readback staging page";
+            Desc.uiSizeInBytes  = NewPage.Size;
+            Desc.Usage          = USAGE_STAGING;
+            Desc.CPUAccessFlags = CPU_ACCESS_READ;
+            m_pDevice->CreateBuffer(Desc, nullptr, &NewPage.pBuffer);
+            if (!NewPage.pBuffer)
+            {
+                LOG_ERROR_MESSAGE("Failed to create async readback staging buffer of size ", NewPage.Size);
+                return InvalidPageIdx;
+            }
+        }
+
+        Offset         = 0;
+        NewPage.Offset = Size;
+        Pages.emplace_back(std::move(NewPage));
+        return Pages.size() - 1;
+    }
+
+    RefCntAutoPtr<ITexture> GetStagingTexture(const TextureDesc& Desc)
+    {
+        for (auto it = m_FreeTextures.begin(); it != m_FreeTextures.end(); ++it)
+        {
+            const auto& TexDesc = (*it)->GetDesc();
+            // clang-format off
+            if (TexDesc.Type   == Desc.Type   &&
+                TexDesc.Width  == Desc.Width  &&
+                TexDesc.Height == Desc.Height &&
+                TexDesc.Depth  == Desc.Depth  &&
+                TexDesc.Format == Desc.Format)
+            // clang-format on
+            {
+                auto pTex = std::move(*it);
+                m_FreeTextures.erase(it);
+                return pTex;
+            }
+        }
+
+        RefCntAutoPtr<ITexture> pTex;
+        m_pDevice->CreateTexture(Desc, nullptr, &pTex);
+        if (!pTex)
+            LOG_ERROR_MESSAGE("Failed to create async readback staging texture");
+        return pTex;
+    }
+
+    void InvokeCallback(ReadbackRequest& Request)
+    {
+        VERIFY_EXPR(m_NumPendingReadbacks > 0);
+        --m_NumPendingReadbacks;
+        Request.Data.RequestId = Request.Id;
+        if (Request.Callback)
+            Request.Callback(Request.Data);
+    }
+
+    Uint32 ProcessFrame(IDeviceContext* pContext, FrameData& Frame)
+    {
+        std::vector<const Uint8*> MappedPages(Frame.Pages.size());
+        for (size_t i = 0; i < Frame.Pages.size(); ++i)
+        {
+            PVoid pData = nullptr;
+            pContext->MapBuffer(Frame.Pages[i].pBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pData);
+            if (pData == nullptr)
+                LOG_ERROR_MESSAGE("Failed to map async readback staging buffer");
+            MappedPages[i] = static_cast<const Uint8*>(pData);
+        }
+
+        for (auto& Request : Frame.Requests)
+        {
+            auto& Data = Request.Data;
+            if (Request.pStagingTex)
+            {
+                MappedTextureSubresource MappedData;
+                pContext->MapTextureSubresource(Request.pStagingTex, 0, 0, MAP_READ, MAP_FLAG_DO_NOT_WAIT, nullptr, MappedData);
+                if (MappedData.pData != nullptr)
+                {
+                    const auto& StagingDesc = Request.pStagingTex->GetDesc();
+                    const auto  MipProps    = GetMipLevelProperties(StagingDesc, 0);
+                    const auto& FmtAttribs  = GetTextureFormatAttribs(StagingDesc.Format);
+                    // For compressed formats, every row contains a row of blocks
+                    const auto NumRows = FmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED ?
+                        MipProps.StorageHeight / FmtAttribs.BlockHeight :
+                        MipProps.StorageHeight;
+
+                    Data.pData       = MappedData.pData;
+                    Data.RowStride   = MappedData.Stride;
+                    Data.DepthStride = MappedData.DepthStride != 0 ? MappedData.DepthStride : MappedData.Stride * NumRows;
+                    Data.DataSize    = (Data.Depth - 1) * Data.DepthStride + (NumRows - 1) * Data.RowStride + MipProps.RowSize;
+                }
+                else
+                {
+                    LOG_ERROR_MESSAGE("Failed to map async readback staging texture");
+                }
+
+                InvokeCallback(Request);
+
+                if (MappedData.pData != nullptr)
+                    pContext->UnmapTextureSubresource(Request.pStagingTex, 0, 0);
+
+                if (m_FreeTextures.size() < m_MaxCachedTextures)
+                    m_FreeTextures.emplace_back(std::move(Request.pStagingTex));
+            }
+            else
+            {
+                VERIFY_EXPR(Request.PageIdx < MappedPages.size());
+                if (const auto* pPageData = MappedPages[Request.PageIdx])
+                {
+                    Data.pData       = pPageData + Request.PageOffset;
+                    Data.DataSize    = Data.Width;
+                    Data.RowStride   = Data.Width;
+                    Data.DepthStride = Data.Width;
+                }
+                InvokeCallback(Request);
+            }
+        }
+
+        for (size_t i = 0; i < Frame.Pages.size(); ++i)
+        {
+            auto& Page = Frame.Pages[i];
+            if (MappedPages[i] != nullptr)
+                pContext->UnmapBuffer(Page.pBuffer, MAP_READ);
+
+            if (Page.Size == m_PageSize && m_FreePages.size() < m_MaxCachedPages)
+            {
+                Page.Offset = 0;
+                m_FreePages.emplace_back(std::move(Page));
+            }
+        }
+
+        return static_cast<Uint32>(Frame.Requests.size());
+    }
+
+    void CancelRequests(FrameData& Frame)
+    {
+        for (auto& Request : Frame.Requests)
+            InvokeCallback(Request);
+        Frame.Requests.clear();
+    }
+
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+    RefCntAutoPtr<IFence>        m_pFence;
+
+    const Uint32 m_PageSize;
+    const Uint32 m_MaxFramesInFlight;
+    const Uint32 m_MaxCachedPages;
+    const Uint32 m_MaxCachedTextures;
+
+    FrameData             m_CurrentFrame;
+    std::deque<FrameData> m_PendingFrames;
+
+    std::vector<StagingPage>             m_FreePages;
+    std::vector<RefCntAutoPtr<ITexture>> m_FreeTextures;
+
+    Uint64 m_NextFenceValue      = 1;
+    Uint64 m_NextRequestId       = 1;
+    Uint32 m_NumPendingReadbacks = 0;
+};
+
+std::future<AsyncReadbackResult> MakeReadbackFuture(const std::function<Uint64(AsyncReadbackCallbackType)>& IssueRequest)
+{
+    // std::function requires copyable callables, so the promise is shared
+    auto pPromise = std::make_shared<std::promise<AsyncReadbackResult>>();
+    auto Future   = pPromise->get_future();
+
+    auto RequestId = IssueRequest(
+        [pPromise](const AsyncReadbackData& Data) //
+        {
+            AsyncReadbackResult Result;
+            if (Data.pData != nullptr)
+            {
+                const auto* pData = static_cast<const Uint8*>(Data.pData);
+                Result.Data.assign(pData, pData + Data.DataSize);
+            }
+            Result.RowStride   = Data.RowStride;
+            Result.DepthStride = Data.DepthStride;
+            Result.Width       = Data.Width;
+            Result.Height      = Data.Height;
+            Result.Depth       = Data.Depth;
+            Result.Format      = Data.Format;
+            pPromise->set_value(std::move(Result));
+        });
+
+    if (RequestId == 0)
+        pPromise->set_value(AsyncReadbackResult{});
+
+    return Future;
+}
+
+} // namespace
+
+
+void CreateAsyncReadback(IRenderDevice*                 pDevice,
+                         const AsyncReadbackCreateInfo& CreateInfo,
+                         IAsyncReadback**               ppReadback)
+{
+    try
+    {
+        auto* pReadback = MakeNewRCObj<AsyncReadbackImpl>()(pDevice, CreateInfo);
+        pReadback->QueryInterface(IID_AsyncReadback, reinterpret_cast<IObject**>(ppReadback));
+    }
+    catch (...)
+    {
+        LOG_ERROR_MESSAGE("Failed to create async readback");
+    }
+}
+
+std::future<AsyncReadbackResult> ReadBufferAsync(IAsyncReadback*                pReadback,
+                                                 IDeviceContext*                pContext,
+                                                 IBuffer*                       pBuffer,
+                                                 Uint32                         Offset,
+                                                 Uint32                         Size,
+                                                 RESOURCE_STATE_TRANSITION_MODE TransitionMode)
+{
+    DEV_CHECK_ERR(pReadback != nullptr, "Readback must not be null");
+    return MakeReadbackFuture(
+        [&](AsyncReadbackCallbackType Callback) //
+        {
+            return pReadback->ReadBuffer(pContext, pBuffer, Offset, Size, TransitionMode, std::move(Callback));
+        });
+}
+
+std::future<AsyncReadbackResult> ReadTextureAsync(IAsyncReadback*                    pReadback,
+                                                  IDeviceContext*                    pContext,
+                                                  const AsyncReadbackTextureAttribs& Attribs)
+{
+    DEV_CHECK_ERR(pReadback != nullptr, "Readback must not be null");
+    return MakeReadbackFuture(
+        [&](AsyncReadbackCallbackType Callback) //
+        {
+            return pReadback->ReadTexture(pContext, Attribs, std::move(Callback));
+        });
+}
+
+} // namespace Diligent
@@ -0,0 +1,269 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#include "BindlessResourceTable.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "DebugUtilities.hpp"
+#include "ObjectBase.hpp"
+#include "RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+class BindlessResourceTableImpl final : public ObjectBase<IBindlessResourceTable>
+{
+public:
+    using TBase = ObjectBase<IBindlessResourceTable>;
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_BindlessResourceTable, TBase)
+
+    BindlessResourceTableImpl(IReferenceCounters*                    pRefCounters,
+                              const BindlessResourceTableCreateInfo& CreateInfo) :
+        // clang-format off
+        TBase           {pRefCounters},
+        m_Name          {CreateInfo.Name != nullptr ? CreateInfo.Name : "Bindless resource table"},
+        m_pDefaultObject{CreateInfo.pDefaultObject}
+    // clang-format on
+    {
+        if (CreateInfo.Capacity == 0)
+            LOG_ERROR_AND_THROW("Capacity of bindless resource table '", m_Name, "' must not be zero");
+        if (!m_pDefaultObject)
+            LOG_ERROR_AND_THROW("Default object of bindless resource table '", m_Name, "' must not be null");
+
+        m_Objects.resize(CreateInfo.Capacity, m_pDefaultObject);
+        m_RawObjects.resize(CreateInfo.Capacity, m_pDefaultObject.RawPtr());
+        m_IsSlotAllocated.resize(CreateInfo.Capacity, false);
+        m_SlotVersions.resize(CreateInfo.Capacity, 0);
+
+        // Hand out low indices first
+        m_FreeSlots.reserve(CreateInfo.Capacity);
+        for (Uint32 Slot = CreateInfo.Capacity; Slot > 0; --Slot)
+            m_FreeSlots.push_back(Slot - 1);
+    }
+
+    virtual Uint32 Allocate(IDeviceObject* pObject) override final
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        if (m_FreeSlots.empty())
+        {
+            LOG_WARNING_MESSAGE("Bindless resource table '", m_Name, "' is full (", m_Objects.size(), " slots)");
+            return InvalidBindlessSlot;
+        }
+
+        const auto Slot = m_FreeSlots.back();
+        m_FreeSlots.pop_back();
+        VERIFY_EXPR(!m_IsSlotAllocated[Slot]);
+        m_IsSlotAllocated[Slot] = true;
+        SetSlotObject(Slot, pObject);
+        return Slot;
+    }
+
+    virtual void Update(Uint32 Slot, IDeviceObject* pObject) override final
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        if (!IsValidAllocatedSlot(Slot))
+            return;
+
+        SetSlotObject(Slot, pObject);
+    }
+
+    virtual void Free(Uint32 Slot) override final
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        if (!IsValidAllocatedSlot(Slot))
+            return;
+
+        m_IsSlotAllocated[Slot] = false;
+        SetSlotObject(Slot, nullptr);
+        m_FreeSlots.push_back(Slot);
+    }
+
+    virtual void Bind(IShaderResourceVariable* pVariable) override final
+    {
+        if (pVariable == nullptr)
+        {
+            UNEXPECTED("Shader resource variable must not be null");
+            return;
+        }
+
+        // Mutable variables are expected to be update-after-bind arrays (Vulkan backend), whose
+        // elements can be set after the resource binding has been committed.
+        DEV_CHECK_ERR(pVariable->GetType() == SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC || pVariable->GetType() == SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE,
+                      "Bindless resource table '", m_Name, "' should be bound to a dynamic shader variable or a mutable runtime-sized array");
+
+        ShaderResourceDesc ResDesc;
+        pVariable->GetResourceDesc(ResDesc);
+
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        const auto                  NumElements = std::min(ResDesc.ArraySize, static_cast<Uint32>(m_RawObjects.size()));
+
+        auto it = std::find_if(m_BoundVariables.begin(), m_BoundVariables.end(),
+                               [pVariable](const BoundVariable& Var) { return Var.pVariable == pVariable; });
+        // The variable may have been destroyed and a new one created at the same address
+        if (it != m_BoundVariables.end() && !it->wpVariable.IsValid())
+        {
+            m_BoundVariables.erase(it);
+            it = m_BoundVariables.end();
+        }
+
+        const auto Version = m_Version.load();
+        if (it == m_BoundVariables.end())
+        {
+            // Drop the variables that no longer exist
+            m_BoundVariables.erase(std::remove_if(m_BoundVariables.begin(), m_BoundVariables.end(),
+                                                  [](const BoundVariable& Var) { return !Var.wpVariable.IsValid(); }),
+                                   m_BoundVariables.end());
+
+            pVariable->SetArray(m_RawObjects.data(), 0, NumElements);
+            m_BoundVariables.emplace_back(pVariable, Version);
+            return;
+        }
+
+        // Only update the contiguous ranges of slots that changed since the last bind
+        const auto LastVersion = it->Version;
+        for (Uint32 Slot = 0; Slot < NumElements;)
+        {
+            if (m_SlotVersions[Slot] <= LastVersion)
+            {
+                ++Slot;
+                continue;
+            }
+
+            const auto FirstSlot = Slot;
+            while (Slot < NumElements && m_SlotVersions[Slot] > LastVersion)
+                ++Slot;
+            pVariable->SetArray(m_RawObjects.data() + FirstSlot, FirstSlot, Slot - FirstSlot);
+        }
+        it->Version = Version;
+    }
+
+    virtual Uint32 GetCapacity() const override final
+    {
+        return static_cast<Uint32>(m_Objects.size());
+    }
+
+    virtual Uint32 GetAllocatedSlotCount() const override final
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        return static_cast<Uint32>(m_Objects.size() - m_FreeSlots.size());
+    }
+
+    virtual Uint32 GetVersion() const override final
+    {
+        return m_Version.load();
+    }
+
+private:
+    bool IsValidAllocatedSlot(Uint32 Slot) const
+    {
+        if (Slot >= m_Objects.size())
+        {
+            UNEXPECTED("Slot ", Slot, " is out of range of bindless resource table '", m_Name, "' (", m_Objects.size(), " slots)");
+            return false;
+        }
+        if (!m_IsSlotAllocated[Slot])
+        {
+            UNEXPECTED("Slot ", Slot, " of bindless resource table '", m_Name, "' is not allocated");
+            return false;
+        }
+        return true;
+    }
+
+    void SetSlotObject(Uint32 Slot, IDeviceObject* pObject)
+    {
+        if (pObject == nullptr)
+            pObject = m_pDefaultObject;
+
+        m_Objects[Slot]    = pObject;
+        m_RawObjects[Slot] = pObject;
+        // Slot changes are made under the mutex, so the version can't be concurrently modified
+        m_SlotVersions[Slot] = m_Version.fetch_add(1) + 1;
+    }
+
+    const std::string m_Name;
+
+    RefCntAutoPtr<IDeviceObject> m_pDefaultObject;
+
+    mutable std::mutex m_Mtx;
+
+    // Strong references that keep the objects alive
+    std::vector<RefCntAutoPtr<IDeviceObject>> m_Objects;
+    // Raw pointers to the same objects in the layout expected by IShaderResourceVariable::SetArray()
+    std::vector<IDeviceObject*> m_RawObjects;
+    std::vector<bool>           m_IsSlotAllocated;
+    std::vector<Uint32>         m_FreeSlots;
+    // Table version at the last modification of every slot
+    std::vector<Uint32> m_SlotVersions;
+
+    std::atomic<Uint32> m_Version{0};
+
+    struct BoundVariable
+    {
+        BoundVariable(IShaderResourceVariable* _pVariable, Uint32 _Version) :
+            pVariable{_pVariable},
+            wpVariable{_pVariable},
+            Version{_Version}
+        {}
+
+        // The raw pointer is only used to find the variable and is never dereferenced
+        IShaderResourceVariable*               pVariable;
+        RefCntWeakPtr<IShaderResourceVariable> wpVariable;
+
+        // Table version at the last Bind() call
+        Uint32 Version;
+    };
+    // Variables the table has been bound to
+    std::vector<BoundVariable> m_BoundVariables;
+};
+
+} // namespace
+
+
+void CreateBindlessResourceTable(const BindlessResourceTableCreateInfo& CreateInfo,
+                                 IBindlessResourceTable**               ppTable)
+{
+    try
+    {
+        auto* pTable = MakeNewRCObj<BindlessResourceTableImpl>()(CreateInfo);
+        pTable->QueryInterface(IID_BindlessResourceTable, reinterpret_cast<IObject**>(ppTable));
+    }
+    catch (...)
+    {
+        LOG_ERROR_MESSAGE("Failed to create bindless resource table");
+    }
+}
+
+} // namespace Diligent
@@ -28,6 +28,7 @@
 #include "pch.h"
 #include <algorithm>
 #include <cmath>
+#include <limits>
 
 #include "GraphicsUtilities.h"
 #include "DebugUtilities.hpp"
@@ -133,20 +134,39 @@ void GenerateCheckerBoardPattern(Uint32 Width, Uint32 Height, TEXTURE_FORMAT Fmt
 
 
 
+template <typename ChannelType>
+float ChannelToLinear(ChannelType c)
+{
+    static constexpr float MaxValInv = 1.f / static_cast<float>(std::numeric_limits<ChannelType>::max());
+    return FastSRGBToLinear(static_cast<float>(c) * MaxValInv);
+}
+
+// 8-bit channels are linearized through a look-up table that holds exactly
+// the same values as the generic version
+template <>
+float ChannelToLinear<Uint8>(Uint8 c)
+{
+    struct LinearValues
+    {
+        LinearValues()
+        {
+            for (Uint32 i = 0; i < 256; ++i)
+                Values[i] = FastSRGBToLinear(static_cast<float>(i) * (1.f / 255.f));
+        }
+        float Values[256];
+    };
+    static const LinearValues LUT;
+    return LUT.Values[c];
+}
+
 template <typename ChannelType>
 ChannelType SRGBAverage(ChannelType c0, ChannelType c1, ChannelType c2, ChannelType c3)
 {
     static_assert(std::numeric_limits<ChannelType>::is_integer && !std::numeric_limits<ChannelType>::is_signed, "Unsigned integers are expected");
 
-    static constexpr float MaxVal    = static_cast<float>(std::numeric_limits<ChannelType>::max());
-    static constexpr float MaxValInv = 1.f / MaxVal;
-
-    float fc0 = static_cast<float>(c0) * MaxValInv;
-    float fc1 = static_cast<float>(c1) * MaxValInv;
-    float fc2 = static_cast<float>(c2) * MaxValInv;
-    float fc3 = static_cast<float>(c3) * MaxValInv;
+    static constexpr float MaxVal = static_cast<float>(std::numeric_limits<ChannelType>::max());
 
-    float fLinearAverage = (FastSRGBToLinear(fc0) + FastSRGBToLinear(fc1) + FastSRGBToLinear(fc2) + FastSRGBToLinear(fc3)) * 0.25f;
+    float fLinearAverage = (ChannelToLinear(c0) + ChannelToLinear(c1) + ChannelToLinear(c2) + ChannelToLinear(c3)) * 0.25f;
     float fSRGBAverage   = FastLinearToSRGB(fLinearAverage) * MaxVal;
 
     // Clamping on both ends is essential because fast SRGB math is imprecise
@@ -0,0 +1,748 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#include "RenderGraph.hpp"
+
+#include <algorithm>
+
+#include "DebugUtilities.hpp"
+#include "GraphicsAccessories.hpp"
+#include "ThreadPool.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// clang-format off
+constexpr RESOURCE_STATE WriteStates =
+    RESOURCE_STATE_RENDER_TARGET    |
+    RESOURCE_STATE_UNORDERED_ACCESS |
+    RESOURCE_STATE_DEPTH_WRITE      |
+    RESOURCE_STATE_STREAM_OUT       |
+    RESOURCE_STATE_COPY_DEST        |
+    RESOURCE_STATE_RESOLVE_DEST     |
+    RESOURCE_STATE_BUILD_AS_WRITE;
+// clang-format on
+
+// Returns true if a resource in the CurrState state can be accessed in the RequiredState
+// state without a transition.
+bool IsStateCompatible(RESOURCE_STATE CurrState, RESOURCE_STATE RequiredState)
+{
+    if (CurrState == RequiredState)
+        return true;
+
+    // Read-only states can be combined
+    return (CurrState & WriteStates) == 0 && (CurrState & RequiredState) == RequiredState;
+}
+
+} // namespace
+
+
+ITexture* RenderGraph::PassContext::GetTexture(RenderGraphResourceId Id) const
+{
+    return pGraph->GetTexture(Id);
+}
+
+IBuffer* RenderGraph::PassContext::GetBuffer(RenderGraphResourceId Id) const
+{
+    return pGraph->GetBuffer(Id);
+}
+
+
+RenderGraph::RenderGraph(Uint32 NumFramesToKeepUnused) :
+    m_NumFramesToKeepUnused{NumFramesToKeepUnused}
+{
+}
+
+RenderGraph::~RenderGraph()
+{
+}
+
+RenderGraphResourceId RenderGraph::CreateTexture(const TextureDesc& Desc)
+{
+    ResourceInfo Res;
+    Res.Name         = Desc.Name != nullptr ? Desc.Name : "Render graph texture";
+    Res.IsTexture    = true;
+    Res.TexDesc      = Desc;
+    Res.TexDesc.Name = nullptr;
+    m_Resources.emplace_back(std::move(Res));
+    m_IsCompiled = false;
+    return static_cast<RenderGraphResourceId>(m_Resources.size() - 1);
+}
+
+RenderGraphResourceId RenderGraph::CreateBuffer(const BufferDesc& Desc)
+{
+    ResourceInfo Res;
+    Res.Name          = Desc.Name != nullptr ? Desc.Name : "Render graph buffer";
+    Res.BuffDesc      = Desc;
+    Res.BuffDesc.Name = nullptr;
+    m_Resources.emplace_back(std::move(Res));
+    m_IsCompiled = false;
+    return static_cast<RenderGraphResourceId>(m_Resources.size() - 1);
+}
+
+RenderGraphResourceId RenderGraph::ImportTexture(ITexture* pTexture, RESOURCE_STATE InitialState, RESOURCE_STATE FinalState)
+{
+    if (pTexture == nullptr)
+    {
+        LOG_ERROR_MESSAGE("Texture must not be null");
+        return InvalidRenderGraphResourceId;
+    }
+
+    const auto& Desc = pTexture->GetDesc();
+
+    ResourceInfo Res;
+    Res.Name             = Desc.Name != nullptr ? Desc.Name : "Imported texture";
+    Res.IsTexture        = true;
+    Res.IsImported       = true;
+    Res.TexDesc          = Desc;
+    Res.TexDesc.Name     = nullptr;
+    Res.pImportedTexture = pTexture;
+    Res.pTexture         = pTexture;
+    Res.InitialState     = InitialState;
+    Res.FinalState       = FinalState;
+    m_Resources.emplace_back(std::move(Res));
+    m_IsCompiled = false;
+    return static_cast<RenderGraphResourceId>(m_Resources.size() - 1);
+}
+
+RenderGraphResourceId RenderGraph::ImportBuffer(IBuffer* pBuffer, RESOURCE_STATE InitialState, RESOURCE_STATE FinalState)
+{
+    if (pBuffer == nullptr)
+    {
+        LOG_ERROR_MESSAGE("Buffer must not be null");
+        return InvalidRenderGraphResourceId;
+    }
+
+    const auto& Desc = pBuffer->GetDesc();
+
+    ResourceInfo Res;
+    Res.Name            = Desc.Name != nullptr ? Desc.Name : "Imported buffer";
+    Res.IsImported      = true;
+    Res.BuffDesc        = Desc;
+    Res.BuffDesc.Name   = nullptr;
+    Res.pImportedBuffer = pBuffer;
+    Res.pBuffer         = pBuffer;
+    Res.InitialState    = InitialState;
+    Res.FinalState      = FinalState;
+    m_Resources.emplace_back(std::move(Res));
+    m_IsCompiled = false;
+    return static_cast<RenderGraphResourceId>(m_Resources.size() - 1);
+}
+
+Uint32 RenderGraph::AddPass(const char* Name, ExecuteFuncType ExecuteFunc, RENDER_GRAPH_PASS_FLAGS Flags)
+{
+    PassInfo Pass;
+    Pass.Name        = Name != nullptr ? Name : "Render graph pass";
+    Pass.ExecuteFunc = std::move(ExecuteFunc);
+    Pass.Flags       = Flags;
+    m_Passes.emplace_back(std::move(Pass));
+    m_IsCompiled = false;
+    return static_cast<Uint32>(m_Passes.size() - 1);
+}
+
+void RenderGraph::AddAccess(Uint32 Pass, RenderGraphResourceId Resource, RESOURCE_STATE State, bool IsWrite)
+{
+    if (Pass >= m_Passes.size())
+    {
+        LOG_ERROR_MESSAGE("Pass index (", Pass, ") is out of range");
+        return;
+    }
+    if (Resource >= m_Resources.size())
+    {
+        LOG_ERROR_MESSAGE("Resource id (", Resource, ") is out of range");
+        return;
+    }
+    DEV_CHECK_ERR(State != RESOURCE_STATE_UNKNOWN && State != RESOURCE_STATE_UNDEFINED,
+                  "Pass '", m_Passes[Pass].Name, "' accesses resource '", m_Resources[Resource].Name, "' in unknown or undefined state");
+    DEV_CHECK_ERR(IsWrite == ((State & WriteStates) != 0),
+                  "Pass '", m_Passes[Pass].Name, "' ", (IsWrite ? "writes" : "reads"), " resource '", m_Resources[Resource].Name,
+                  "' in state ", GetResourceStateString(State), (IsWrite ? ", which is a read-only state" : ", which is a writable state"));
+
+    m_IsCompiled = false;
+
+    auto& Accesses = m_Passes[Pass].Accesses;
+    for (auto& Access : Accesses)
+    {
+        if (Access.Resource == Resource)
+        {
+            Access.State |= State;
+            Access.IsWrite = Access.IsWrite || IsWrite;
+            return;
+        }
+    }
+
+    ResourceAccess Access;
+    Access.Resource = Resource;
+    Access.State    = State;
+    Access.IsWrite  = IsWrite;
+    Accesses.emplace_back(Access);
+}
+
+void RenderGraph::Read(Uint32 Pass, RenderGraphResourceId Resource, RESOURCE_STATE State)
+{
+    AddAccess(Pass, Resource, State, false);
+}
+
+void RenderGraph::Write(Uint32 Pass, RenderGraphResourceId Resource, RESOURCE_STATE State)
+{
+    AddAccess(Pass, Resource, State, true);
+}
+
+bool RenderGraph::Compile()
+{
+    m_IsCompiled = false;
+    m_ExecutionOrder.clear();
+    m_FinalBarriers.clear();
+    m_PhysicalResources.clear();
+    for (auto& Res : m_Resources)
+        Res.PhysicalIndex = ~0u;
+    for (auto& Pass : m_Passes)
+    {
+        Pass.Barriers.clear();
+        Pass.IsCulled = true;
+    }
+
+    for (const auto& Pass : m_Passes)
+    {
+        for (const auto& Access : Pass.Accesses)
+        {
+            const auto& Res = m_Resources[Access.Resource];
+            if (!VerifyResourceStates(Access.State, Res.IsTexture))
+            {
+                LOG_ERROR_MESSAGE("Pass '", Pass.Name, "' accesses resource '", Res.Name, "' in invalid state");
+                return false;
+            }
+        }
+    }
+
+    for (const auto& Res : m_Resources)
+    {
+        if (Res.FinalState != RESOURCE_STATE_UNKNOWN && !VerifyResourceStates(Res.FinalState, Res.IsTexture))
+        {
+            LOG_ERROR_MESSAGE("Final state of resource '", Res.Name, "' is invalid");
+            return false;
+        }
+    }
+
+    if (!CullPasses())
+        return false;
+
+    ComputeBarriers();
+    AssignPhysicalResources();
+
+    m_IsCompiled = true;
+    return true;
+}
+
+bool RenderGraph::CullPasses()
+{
+    const auto NumPasses = static_cast<Uint32>(m_Passes.size());
+
+    // Passes every pass depends on
+    std::vector<std::vector<Uint32>> Dependencies(NumPasses);
+    std::vector<Uint32>              LastWriter(m_Resources.size(), ~0u);
+    for (Uint32 p = 0; p < NumPasses; ++p)
+    {
+        const auto& Pass = m_Passes[p];
+        for (const auto& Access : Pass.Accesses)
+        {
+            const auto Writer = LastWriter[Access.Resource];
+            if (Writer != ~0u)
+            {
+                // Writes depend on the previous writer as well since the pass
+                // may only update a part of the resource.
+                Dependencies[p].push_back(Writer);
+            }
+            else if (!Access.IsWrite && !m_Resources[Access.Resource].IsImported)
+            {
+                LOG_ERROR_MESSAGE("Pass '", Pass.Name, "' reads transient resource '", m_Resources[Access.Resource].Name,
+                                  "' that is not written by any previous pass");
+                return false;
+            }
+        }
+
+        for (const auto& Access : Pass.Accesses)
+        {
+            if (Access.IsWrite)
+                LastWriter[Access.Resource] = p;
+        }
+    }
+
+    // Passes with side effects are the roots of the live set
+    std::vector<bool> IsLive(NumPasses, false);
+    for (Uint32 p = 0; p < NumPasses; ++p)
+    {
+        const auto& Pass = m_Passes[p];
+        if ((Pass.Flags & RENDER_GRAPH_PASS_FLAG_NEVER_CULL) != 0)
+        {
+            IsLive[p] = true;
+            continue;
+        }
+
+        for (const auto& Access : Pass.Accesses)
+        {
+            if (Access.IsWrite && m_Resources[Access.Resource].IsImported)
+            {
+                IsLive[p] = true;
+                break;
+            }
+        }
+    }
+
+    // Dependencies always refer to earlier passes, so a single backward sweep is enough
+    for (Uint32 p = NumPasses; p-- > 0;)
+    {
+        if (!IsLive[p])
+            continue;
+
+        for (auto Dependency : Dependencies[p])
+            IsLive[Dependency] = true;
+    }
+
+    for (Uint32 p = 0; p < NumPasses; ++p)
+    {
+        m_Passes[p].IsCulled = !IsLive[p];
+        if (IsLive[p])
+            m_ExecutionOrder.push_back(p);
+    }
+
+    return true;
+}
+
+void RenderGraph::ComputeBarriers()
+{
+    // RESOURCE_STATE_UNKNOWN indicates that the resource has not been used yet
+    std::vector<RESOURCE_STATE> CurrStates(m_Resources.size(), RESOURCE_STATE_UNKNOWN);
+    for (auto p : m_ExecutionOrder)
+    {
+        auto& Pass = m_Passes[p];
+        for (const auto& Access : Pass.Accesses)
+        {
+            auto& CurrState = CurrStates[Access.Resource];
+            if (CurrState != RESOURCE_STATE_UNKNOWN && IsStateCompatible(CurrState, Access.State))
+            {
+                // Consecutive unordered accesses still need to be synchronized
+                if (Access.State != RESOURCE_STATE_UNORDERED_ACCESS)
+                    continue;
+            }
+
+            Barrier NewBarrier;
+            NewBarrier.ResourceId = Access.Resource;
+            NewBarrier.OldState   = CurrState;
+            NewBarrier.NewState   = Access.State;
+            Pass.Barriers.emplace_back(NewBarrier);
+
+            CurrState = Access.State;
+        }
+    }
+
+    for (Uint32 r = 0; r < m_Resources.size(); ++r)
+    {
+        const auto& Res = m_Resources[r];
+        if (!Res.IsImported || Res.FinalState == RESOURCE_STATE_UNKNOWN)
+            continue;
+
+        const auto CurrState = CurrStates[r];
+        if (CurrState != RESOURCE_STATE_UNKNOWN && IsStateCompatible(CurrState, Res.FinalState))
+            continue;
+
+        Barrier FinalBarrier;
+        FinalBarrier.ResourceId = r;
+        FinalBarrier.OldState   = CurrState;
+        FinalBarrier.NewState   = Res.FinalState;
+        m_FinalBarriers.emplace_back(FinalBarrier);
+    }
+}
+
+void RenderGraph::AssignPhysicalResources()
+{
+    // Range of positions in the execution order where every resource is used
+    std::vector<Uint32> FirstUse(m_Resources.size(), ~0u);
+    std::vector<Uint32> LastUse(m_Resources.size(), 0);
+    for (Uint32 i = 0; i < m_ExecutionOrder.size(); ++i)
+    {
+        for (const auto& Access : m_Passes[m_ExecutionOrder[i]].Accesses)
+        {
+            FirstUse[Access.Resource] = std::min(FirstUse[Access.Resource], i);
+            LastUse[Access.Resource]  = std::max(LastUse[Access.Resource], i);
+        }
+    }
+
+    std::vector<RenderGraphResourceId> Transients;
+    for (Uint32 r = 0; r < m_Resources.size(); ++r)
+    {
+        auto& Res = m_Resources[r];
+        if (Res.IsImported)
+        {
+            // Imported resources are never shared
+            PhysicalResource Phys;
+            Phys.FirstResource = r;
+            Res.PhysicalIndex  = static_cast<Uint32>(m_PhysicalResources.size());
+            m_PhysicalResources.emplace_back(Phys);
+        }
+        else if (FirstUse[r] != ~0u)
+        {
+            Transients.push_back(r);
+        }
+    }
+
+    // Greedy interval partitioning: process transient resources in the order of their first use
+    // and reuse the first object with the same description that is no longer used.
+    std::stable_sort(Transients.begin(), Transients.end(),
+                     [&FirstUse](RenderGraphResourceId r0, RenderGraphResourceId r1) {
+                         return FirstUse[r0] < FirstUse[r1];
+                     });
+
+    for (auto r : Transients)
+    {
+        auto& Res = m_Resources[r];
+        for (Uint32 i = 0; i < m_PhysicalResources.size(); ++i)
+        {
+            const auto& Phys  = m_PhysicalResources[i];
+            const auto& Owner = m_Resources[Phys.FirstResource];
+            if (Owner.IsImported || Owner.IsTexture != Res.IsTexture || Phys.LastUse >= FirstUse[r])
+                continue;
+
+            if (Res.IsTexture ? Owner.TexDesc == Res.TexDesc : Owner.BuffDesc == Res.BuffDesc)
+            {
+                Res.PhysicalIndex = i;
+                break;
+            }
+        }
+
+        if (Res.PhysicalIndex == ~0u)
+        {
+            PhysicalResource Phys;
+            Phys.FirstResource = r;
+            Res.PhysicalIndex  = static_cast<Uint32>(m_PhysicalResources.size());
+            m_PhysicalResources.emplace_back(Phys);
+        }
+        m_PhysicalResources[Res.PhysicalIndex].LastUse = LastUse[r];
+    }
+}
+
+bool RenderGraph::AcquirePhysicalResources(IRenderDevice* pDevice)
+{
+    std::vector<bool> IsPoolEntryUsed(m_Pool.size(), false);
+
+    std::vector<ITexture*> PhysTextures(m_PhysicalResources.size());
+    std::vector<IBuffer*>  PhysBuffers(m_PhysicalResources.size());
+    for (size_t i = 0; i < m_PhysicalResources.size(); ++i)
+    {
+        const auto& Res = m_Resources[m_PhysicalResources[i].FirstResource];
+        if (Res.IsImported)
+        {
+            PhysTextures[i] = Res.pTexture;
+            PhysBuffers[i]  = Res.pBuffer;
+            continue;
+        }
+
+        // Look for a pooled object with the same description
+        size_t PoolIdx = 0;
+        for (; PoolIdx < m_Pool.size(); ++PoolIdx)
+        {
+            if (IsPoolEntryUsed[PoolIdx])
+                continue;
+
+            const auto& Entry = m_Pool[PoolIdx];
+            if (Res.IsTexture ?
+                    (Entry.pTexture && Entry.pTexture->GetDesc() == Res.TexDesc) :
+                    (Entry.pBuffer && Entry.pBuffer->GetDesc() == Res.BuffDesc))
+                break;
+        }
+
+        if (PoolIdx == m_Pool.size())
+        {
+            PooledResource Entry;
+            if (Res.IsTexture)
+            {
+                auto Desc = Res.TexDesc;
+                Desc.Name = Res.Name.c_str();
+                pDevice->CreateTexture(Desc, nullptr, &Entry.pTexture);
+                if (!Entry.pTexture)
+                {
+                    LOG_ERROR_MESSAGE("Failed to create transient texture '", Res.Name, "'");
+                    return false;
+                }
+            }
+            else
+            {
+                auto Desc = Res.BuffDesc;
+                Desc.Name = Res.Name.c_str();
+                pDevice->CreateBuffer(Desc, nullptr, &Entry.pBuffer);
+                if (!Entry.pBuffer)
+                {
+                    LOG_ERROR_MESSAGE("Failed to create transient buffer '", Res.Name, "'");
+                    return false;
+                }
+            }
+            m_Pool.emplace_back(std::move(Entry));
+            IsPoolEntryUsed.push_back(false);
+        }
+
+        auto& Entry              = m_Pool[PoolIdx];
+        Entry.LastUsedFrame      = m_FrameNumber;
+        IsPoolEntryUsed[PoolIdx] = true;
+        PhysTextures[i]          = Entry.pTexture;
+        PhysBuffers[i]           = Entry.pBuffer;
+    }
+
+    for (auto& Res : m_Resources)
+    {
+        if (Res.IsImported)
+            continue;
+
+        Res.pTexture = Res.PhysicalIndex != ~0u ? PhysTextures[Res.PhysicalIndex] : nullptr;
+        Res.pBuffer  = Res.PhysicalIndex != ~0u ? PhysBuffers[Res.PhysicalIndex] : nullptr;
+    }
+
+    // Release the objects that have not been used for a while. Objects used in this frame
+    // are never released, so the pointers above remain valid.
+    m_Pool.erase(std::remove_if(m_Pool.begin(), m_Pool.end(),
+                                [this](const PooledResource& Entry) {
+                                    return Entry.LastUsedFrame + m_NumFramesToKeepUnused < m_FrameNumber;
+                                }),
+                 m_Pool.end());
+
+    return true;
+}
+
+void RenderGraph::RecordPass(IDeviceContext* pContext, Uint32 ExecutionIndex)
+{
+    auto& Barriers = m_ResolvedBarriers[ExecutionIndex];
+    if (!Barriers.empty())
+        pContext->TransitionResourceStates(static_cast<Uint32>(Barriers.size()), Barriers.data());
+
+    const auto PassIndex = m_ExecutionOrder[ExecutionIndex];
+    const auto& Pass     = m_Passes[PassIndex];
+    if (Pass.ExecuteFunc)
+    {
+        PassContext Context;
+        Context.pContext  = pContext;
+        Context.PassIndex = PassIndex;
+        Context.pGraph    = this;
+        Pass.ExecuteFunc(Context);
+    }
+}
+
+bool RenderGraph::Execute(IRenderDevice*         pDevice,
+                          IDeviceContext*        pContext,
+                          IDeviceContext* const* ppDeferredContexts,
+                          Uint32                 NumDeferredContexts,
+                          ThreadPool*            pThreadPool)
+{
+    DEV_CHECK_ERR(pDevice != nullptr, "Render device must not be null");
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+
+    if (!m_IsCompiled && !Compile())
+        return false;
+
+    ++m_FrameNumber;
+    if (!AcquirePhysicalResources(pDevice))
+        return false;
+
+    const auto NumPasses = static_cast<Uint32>(m_ExecutionOrder.size());
+
+    const bool UseDeferredContexts = ppDeferredContexts != nullptr && NumDeferredContexts > 0 && pThreadPool != nullptr && NumPasses > 0;
+
+    // Actual states of the physical objects. Transient resources that share the same object
+    // start in the state left by the previous resource.
+    std::vector<RESOURCE_STATE> PhysStates(m_PhysicalResources.size());
+    for (size_t i = 0; i < m_PhysicalResources.size(); ++i)
+    {
+        const auto& Res = m_Resources[m_PhysicalResources[i].FirstResource];
+
+        auto State = Res.InitialState;
+        if (State == RESOURCE_STATE_UNKNOWN)
+            State = Res.IsTexture ? Res.pTexture->GetState() : Res.pBuffer->GetState();
+        PhysStates[i] = State;
+    }
+
+    auto ResolveBarriers = [&](const std::vector<Barrier>& Barriers, std::vector<StateTransitionDesc>& Resolved, bool UpdateState) //
+    {
+        Resolved.clear();
+        for (const auto& B : Barriers)
+        {
+            const auto& Res       = m_Resources[B.ResourceId];
+            auto&       PhysState = PhysStates[Res.PhysicalIndex];
+
+            auto OldState = B.OldState;
+            if (OldState == RESOURCE_STATE_UNKNOWN)
+            {
+                // First use of the resource in the frame
+                OldState = PhysState;
+                if (OldState == RESOURCE_STATE_UNKNOWN)
+                {
+                    // The state of the object is not tracked. Following the engine convention,
+                    // the transition is skipped.
+                    PhysState = B.NewState;
+                    continue;
+                }
+                if (OldState == B.NewState && B.NewState != RESOURCE_STATE_UNORDERED_ACCESS)
+                    continue;
+            }
+            VERIFY(OldState == PhysState, "Unexpected resource state");
+            PhysState = B.NewState;
+
+            if (Res.IsTexture)
+                Resolved.emplace_back(Res.pTexture, OldState, B.NewState, UpdateState);
+            else
+                Resolved.emplace_back(Res.pBuffer, OldState, B.NewState, UpdateState);
+        }
+    };
+
+    std::vector<RESOURCE_STATE> InitialStates;
+    if (UseDeferredContexts)
+        InitialStates = PhysStates;
+
+    m_ResolvedBarriers.resize(NumPasses);
+    for (Uint32 i = 0; i < NumPasses; ++i)
+        ResolveBarriers(m_Passes[m_ExecutionOrder[i]].Barriers, m_ResolvedBarriers[i], !UseDeferredContexts);
+
+    if (UseDeferredContexts)
+    {
+        const auto NumBatches = std::min(NumDeferredContexts, NumPasses);
+
+        std::vector<RefCntAutoPtr<ICommandList>> CommandLists(NumBatches);
+        for (Uint32 Batch = 0; Batch < NumBatches; ++Batch)
+        {
+            const Uint32 FirstPass = NumPasses * Batch / NumBatches;
+            const Uint32 EndPass   = NumPasses * (Batch + 1) / NumBatches;
+            pThreadPool->EnqueueTask(
+                [this, Batch, FirstPass, EndPass, ppDeferredContexts, &CommandLists](Uint32) //
+                {
+                    auto* pDeferredCtx = ppDeferredContexts[Batch];
+                    for (Uint32 i = FirstPass; i < EndPass; ++i)
+                        RecordPass(pDeferredCtx, i);
+                    pDeferredCtx->FinishCommandList(&CommandLists[Batch]);
+                });
+        }
+        pThreadPool->WaitForAllTasks();
+
+        // Barriers of every batch expect the resources in the states left by the previous one,
+        // so nothing is executed after the first batch that failed to record.
+        Uint32 NumExecutedBatches = 0;
+        for (; NumExecutedBatches < NumBatches; ++NumExecutedBatches)
+        {
+            if (!CommandLists[NumExecutedBatches])
+            {
+                LOG_ERROR_MESSAGE("Failed to record command list for render graph batch ", NumExecutedBatches);
+                break;
+            }
+            pContext->ExecuteCommandList(CommandLists[NumExecutedBatches]);
+        }
+
+        for (Uint32 Batch = 0; Batch < NumBatches; ++Batch)
+            ppDeferredContexts[Batch]->FinishFrame();
+
+        if (NumExecutedBatches < NumBatches)
+        {
+            // Only keep the states left by the passes that have actually been executed
+            PhysStates = std::move(InitialStates);
+
+            const Uint32 NumExecutedPasses = NumPasses * NumExecutedBatches / NumBatches;
+
+            std::vector<StateTransitionDesc> ExecutedBarriers;
+            for (Uint32 i = 0; i < NumExecutedPasses; ++i)
+                ResolveBarriers(m_Passes[m_ExecutionOrder[i]].Barriers, ExecutedBarriers, false);
+        }
+
+        // Command lists were recorded without updating the resource states
+        for (size_t i = 0; i < m_PhysicalResources.size(); ++i)
+        {
+            if (PhysStates[i] == RESOURCE_STATE_UNKNOWN)
+                continue;
+
+            const auto& Res = m_Resources[m_PhysicalResources[i].FirstResource];
+            if (Res.IsTexture)
+                Res.pTexture->SetState(PhysStates[i]);
+            else
+                Res.pBuffer->SetState(PhysStates[i]);
+        }
+
+        if (NumExecutedBatches < NumBatches)
+            return false;
+    }
+    else
+    {
+        for (Uint32 i = 0; i < NumPasses; ++i)
+            RecordPass(pContext, i);
+    }
+
+    std::vector<StateTransitionDesc> FinalBarriers;
+    ResolveBarriers(m_FinalBarriers, FinalBarriers, true);
+    if (!FinalBarriers.empty())
+        pContext->TransitionResourceStates(static_cast<Uint32>(FinalBarriers.size()), FinalBarriers.data());
+
+    return true;
+}
+
+void RenderGraph::Reset()
+{
+    m_Resources.clear();
+    m_Passes.clear();
+    m_ExecutionOrder.clear();
+    m_FinalBarriers.clear();
+    m_PhysicalResources.clear();
+    m_ResolvedBarriers.clear();
+    m_IsCompiled = false;
+}
+
+bool RenderGraph::IsPassCulled(Uint32 Pass) const
+{
+    DEV_CHECK_ERR(Pass < m_Passes.size(), "Pass index (", Pass, ") is out of range");
+    return m_Passes[Pass].IsCulled;
+}
+
+const std::vector<RenderGraph::Barrier>& RenderGraph::GetPassBarriers(Uint32 Pass) const
+{
+    DEV_CHECK_ERR(Pass < m_Passes.size(), "Pass index (", Pass, ") is out of range");
+    return m_Passes[Pass].Barriers;
+}
+
+Uint32 RenderGraph::GetPhysicalResourceIndex(RenderGraphResourceId Resource) const
+{
+    DEV_CHECK_ERR(Resource < m_Resources.size(), "Resource id (", Resource, ") is out of range");
+    return m_Resources[Resource].PhysicalIndex;
+}
+
+ITexture* RenderGraph::GetTexture(RenderGraphResourceId Resource) const
+{
+    DEV_CHECK_ERR(Resource < m_Resources.size(), "Resource id (", Resource, ") is out of range");
+    return m_Resources[Resource].pTexture;
+}
+
+IBuffer* RenderGraph::GetBuffer(RenderGraphResourceId Resource) const
+{
+    DEV_CHECK_ERR(Resource < m_Resources.size(), "Resource id (", Resource, ") is out of range");
+    return m_Resources[Resource].pBuffer;
+}
+
+} // namespace Diligent
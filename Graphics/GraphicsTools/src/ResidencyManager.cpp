@@ -0,0 +1,195 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#include "ResidencyManager.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+void LRUEvictionPolicy::SelectVictims(const std::vector<EvictableResourceInfo>& Candidates,
+                                      Uint64                                    BytesToFree,
+                                      std::vector<EvictableResourceId>&         Victims)
+{
+    std::vector<const EvictableResourceInfo*> SortedCandidates;
+    SortedCandidates.reserve(Candidates.size());
+    for (const auto& Candidate : Candidates)
+        SortedCandidates.push_back(&Candidate);
+
+    std::sort(SortedCandidates.begin(), SortedCandidates.end(),
+              [](const EvictableResourceInfo* lhs, const EvictableResourceInfo* rhs) //
+              {
+                  if (lhs->LastUsedFenceValue != rhs->LastUsedFenceValue)
+                      return lhs->LastUsedFenceValue < rhs->LastUsedFenceValue;
+                  // Resources registered earlier are evicted first
+                  return lhs->Id < rhs->Id;
+              });
+
+    Uint64 FreedSize = 0;
+    for (const auto* pCandidate : SortedCandidates)
+    {
+        if (FreedSize >= BytesToFree)
+            break;
+        Victims.push_back(pCandidate->Id);
+        FreedSize += pCandidate->Size;
+    }
+}
+
+
+ResidencyManager::ResidencyManager(std::unique_ptr<EvictionPolicy> pPolicy)
+{
+    SetEvictionPolicy(std::move(pPolicy));
+}
+
+void ResidencyManager::SetEvictionPolicy(std::unique_ptr<EvictionPolicy> pPolicy)
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    m_pPolicy = pPolicy ? std::move(pPolicy) : std::unique_ptr<EvictionPolicy>{new LRUEvictionPolicy};
+}
+
+EvictableResourceId ResidencyManager::RegisterResource(Uint64 Size, EvictCallbackType EvictCallback, Uint64 FenceValue)
+{
+    DEV_CHECK_ERR(EvictCallback, "Eviction callback must not be null");
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    const auto Id = m_NextId++;
+    VERIFY(Id != InvalidEvictableResourceId, "Resource id overflow");
+
+    auto& Info              = m_Resources[Id];
+    Info.Size               = Size;
+    Info.LastUsedFenceValue = FenceValue;
+    Info.EvictCallback      = std::move(EvictCallback);
+    m_ResidentSize += Size;
+
+    return Id;
+}
+
+void ResidencyManager::UnregisterResource(EvictableResourceId Id)
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    auto it = m_Resources.find(Id);
+    if (it == m_Resources.end())
+    {
+        LOG_ERROR_MESSAGE("Resource ", Id, " is not registered");
+        return;
+    }
+    m_ResidentSize -= it->second.Size;
+    m_Resources.erase(it);
+}
+
+void ResidencyManager::MarkUsed(EvictableResourceId Id, Uint64 FenceValue)
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    auto it = m_Resources.find(Id);
+    if (it == m_Resources.end())
+    {
+        LOG_ERROR_MESSAGE("Resource ", Id, " is not registered");
+        return;
+    }
+    it->second.LastUsedFenceValue = std::max(it->second.LastUsedFenceValue, FenceValue);
+}
+
+Uint64 ResidencyManager::Evict(Uint64 BytesToFree, Uint64 CompletedFenceValue)
+{
+    if (BytesToFree == 0)
+        return 0;
+
+    std::vector<std::pair<EvictableResourceId, EvictCallbackType>> EvictedResources;
+
+    Uint64 EvictedSize = 0;
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        std::vector<EvictableResourceInfo> Candidates;
+        Candidates.reserve(m_Resources.size());
+        for (const auto& it : m_Resources)
+        {
+            // Resources that may still be used by the GPU can't be evicted
+            if (it.second.LastUsedFenceValue > CompletedFenceValue)
+                continue;
+
+            EvictableResourceInfo Candidate;
+            Candidate.Id                 = it.first;
+            Candidate.Size               = it.second.Size;
+            Candidate.LastUsedFenceValue = it.second.LastUsedFenceValue;
+            Candidates.push_back(Candidate);
+        }
+        if (Candidates.empty())
+            return 0;
+
+        std::vector<EvictableResourceId> Victims;
+        m_pPolicy->SelectVictims(Candidates, BytesToFree, Victims);
+
+        EvictedResources.reserve(Victims.size());
+        for (auto Id : Victims)
+        {
+            auto it = m_Resources.find(Id);
+            if (it == m_Resources.end() || it->second.LastUsedFenceValue > CompletedFenceValue)
+            {
+                UNEXPECTED("Eviction policy selected resource ", Id, " that is not a candidate");
+                continue;
+            }
+            EvictedSize += it->second.Size;
+            m_ResidentSize -= it->second.Size;
+            EvictedResources.emplace_back(Id, std::move(it->second.EvictCallback));
+            m_Resources.erase(it);
+        }
+    }
+
+    // Callbacks are called without holding the lock so that they can register or unregister resources
+    for (auto& Evicted : EvictedResources)
+        Evicted.second(Evicted.first);
+
+    return EvictedSize;
+}
+
+bool ResidencyManager::IsResident(EvictableResourceId Id) const
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    return m_Resources.find(Id) != m_Resources.end();
+}
+
+Uint64 ResidencyManager::GetResidentSize() const
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    return m_ResidentSize;
+}
+
+Uint32 ResidencyManager::GetResidentCount() const
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    return static_cast<Uint32>(m_Resources.size());
+}
+
+} // namespace Diligent
@@ -27,6 +27,7 @@
 
 #include "pch.h"
 #include "ScreenCapture.hpp"
+#include "TextureFormatConversion.hpp"
 
 namespace Diligent
 {
@@ -129,4 +130,34 @@ void ScreenCapture::RecycleStagingTexture(RefCntAutoPtr<ITexture>&& pTexture)
     m_AvailableTextures.emplace_back(std::move(pTexture));
 }
 
+bool ScreenCapture::ReadCaptureData(IDeviceContext*    pContext,
+                                    const CaptureInfo& Capture,
+                                    TEXTURE_FORMAT     DstFormat,
+                                    void*              pDstData,
+                                    Uint32             DstStride,
+                                    ThreadPool*        pThreadPool)
+{
+    if (!Capture)
+    {
+        LOG_ERROR_MESSAGE("Capture is empty");
+        return false;
+    }
+
+    auto*       pTexture = Capture.pTexture.RawPtr<ITexture>();
+    const auto& TexDesc  = pTexture->GetDesc();
+
+    MappedTextureSubresource MappedData;
+    pContext->MapTextureSubresource(pTexture, 0, 0, MAP_READ, MAP_FLAG_DO_NOT_WAIT, nullptr, MappedData);
+    if (MappedData.pData == nullptr)
+    {
+        LOG_ERROR_MESSAGE("Failed to map the staging texture");
+        return false;
+    }
+
+    auto Res = ConvertTextureData(TexDesc.Width, TexDesc.Height, TexDesc.Format, MappedData.pData, MappedData.Stride,
+                                  DstFormat, pDstData, DstStride, pThreadPool);
+    pContext->UnmapTextureSubresource(pTexture, 0, 0);
+    return Res;
+}
+
 } // namespace Diligent
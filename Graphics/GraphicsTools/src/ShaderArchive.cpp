@@ -0,0 +1,1253 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#include "ShaderArchive.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <unordered_map>
+
+#include "DataBlobImpl.hpp"
+#include "DebugUtilities.hpp"
+#include "Align.hpp"
+
+#if VULKAN_SUPPORTED
+#    include "vulkan/vulkan.h"
+#    include "../../GraphicsEngineVulkan/interface/RenderDeviceVk.h"
+#endif
+
+namespace Diligent
+{
+
+namespace
+{
+
+constexpr Uint32 ShaderArchiveMagic = 0x52415344; // 'DSAR'
+constexpr Uint32 InvalidOffset      = ~0u;
+
+// Alignment of every entry in the data section
+constexpr Uint32 DataAlignment = 8;
+
+// Graphics pipeline shader stages. Compute pipelines use the first slot.
+enum ARCHIVE_SHADER_STAGE : Uint32
+{
+    ARCHIVE_SHADER_STAGE_VS = 0,
+    ARCHIVE_SHADER_STAGE_PS,
+    ARCHIVE_SHADER_STAGE_DS,
+    ARCHIVE_SHADER_STAGE_HS,
+    ARCHIVE_SHADER_STAGE_GS,
+    ARCHIVE_SHADER_STAGE_AS,
+    ARCHIVE_SHADER_STAGE_MS,
+    ARCHIVE_SHADER_STAGE_COUNT,
+    ARCHIVE_SHADER_STAGE_CS = 0
+};
+
+enum ARCHIVED_SHADER_FLAGS : Uint32
+{
+    ARCHIVED_SHADER_FLAG_NONE                          = 0x00,
+    ARCHIVED_SHADER_FLAG_USE_COMBINED_TEXTURE_SAMPLERS = 0x01
+};
+
+struct ArchivedShaderRecord
+{
+    Uint32 Name;
+    Uint32 PermutationKey;
+    Uint32 EntryPoint;
+    Uint32 CombinedSamplerSuffix;
+    Uint32 ShaderType;
+    Uint32 Flags;
+    Uint32 ByteCodeOffset;
+    Uint32 ByteCodeSize;
+    Uint32 ResourcesOffset;
+    Uint32 ResourcesSize;
+};
+static_assert(sizeof(ArchivedShaderRecord) == 40, "The size of ArchivedShaderRecord is expected to be 40 bytes");
+
+struct ArchivedPipelineRecord
+{
+    Uint32 Name;
+    Uint32 PipelineType;
+    Uint32 DataOffset;
+    Uint32 DataSize;
+};
+static_assert(sizeof(ArchivedPipelineRecord) == 16, "The size of ArchivedPipelineRecord is expected to be 16 bytes");
+
+struct ArchivedShaderRef
+{
+    Uint32 Name           = InvalidOffset;
+    Uint32 PermutationKey = InvalidOffset;
+};
+
+// Pipeline data in the data section:
+//
+//  | ArchivedPipelineData | Variables | Immutable samplers | Layout elements |
+//
+// Blend, rasterizer and depth-stencil state descriptions are plain structures and
+// are stored as is. The archive header records the size of ArchivedPipelineData,
+// so that the archive built by an incompatible version of the engine is rejected.
+static_assert(sizeof(BlendStateDesc) == 82, "Unexpected size of BlendStateDesc. This will break the archived pipeline data.");
+static_assert(sizeof(RasterizerStateDesc) == 20, "Unexpected size of RasterizerStateDesc. This will break the archived pipeline data.");
+static_assert(sizeof(DepthStencilStateDesc) == 14, "Unexpected size of DepthStencilStateDesc. This will break the archived pipeline data.");
+struct ArchivedPipelineData
+{
+    Uint64 CommandQueueMask;
+    Uint32 Flags;
+    Uint32 SRBAllocationGranularity;
+    Uint32 DefaultVariableType;
+    Uint32 NumVariables;
+    Uint32 NumImmutableSamplers;
+    Uint32 NumLayoutElements;
+
+    ArchivedShaderRef Shaders[ARCHIVE_SHADER_STAGE_COUNT];
+
+    Uint32 SampleMask;
+    Uint32 NodeMask;
+    Uint8  PrimitiveTopology;
+    Uint8  NumViewports;
+    Uint8  NumRenderTargets;
+    Uint8  SampleCount;
+    Uint8  SampleQuality;
+    Uint8  Padding0;
+    Uint16 DSVFormat;
+    Uint16 RTVFormats[MAX_RENDER_TARGETS];
+
+    BlendStateDesc        BlendDesc;
+    RasterizerStateDesc   RasterizerDesc;
+    DepthStencilStateDesc DepthStencilDesc;
+};
+
+struct ArchivedVariable
+{
+    Uint32 ShaderStages;
+    Uint32 Name;
+    Uint32 Type;
+};
+
+struct ArchivedImmutableSampler
+{
+    Uint32  ShaderStages;
+    Uint32  Name;
+    Uint8   MinFilter;
+    Uint8   MagFilter;
+    Uint8   MipFilter;
+    Uint8   AddressU;
+    Uint8   AddressV;
+    Uint8   AddressW;
+    Uint8   ComparisonFunc;
+    Uint8   Padding;
+    Float32 MipLODBias;
+    Uint32  MaxAnisotropy;
+    Float32 BorderColor[4];
+    Float32 MinLOD;
+    Float32 MaxLOD;
+};
+static_assert(sizeof(ArchivedImmutableSampler) == 48, "The size of ArchivedImmutableSampler is expected to be 48 bytes");
+
+struct ArchivedLayoutElement
+{
+    Uint32 HLSLSemantic;
+    Uint32 InputIndex;
+    Uint32 BufferSlot;
+    Uint32 NumComponents;
+    Uint32 ValueType;
+    Uint32 IsNormalized;
+    Uint32 RelativeOffset;
+    Uint32 Stride;
+    Uint32 Frequency;
+    Uint32 InstanceDataStepRate;
+};
+static_assert(sizeof(ArchivedLayoutElement) == 40, "The size of ArchivedLayoutElement is expected to be 40 bytes");
+
+class StringTable
+{
+public:
+    StringTable()
+    {
+        // Offset 0 is always an empty string
+        m_Data.push_back('\0');
+        m_Offsets.emplace("", 0);
+    }
+
+    Uint32 Add(const std::string& Str)
+    {
+        auto it = m_Offsets.find(Str);
+        if (it != m_Offsets.end())
+            return it->second;
+
+        const auto Offset = static_cast<Uint32>(m_Data.size());
+        m_Data.insert(m_Data.end(), Str.begin(), Str.end());
+        m_Data.push_back('\0');
+        m_Offsets.emplace(Str, Offset);
+        return Offset;
+    }
+
+    const std::vector<char>& GetData() const { return m_Data; }
+
+private:
+    std::vector<char>                       m_Data;
+    std::unordered_map<std::string, Uint32> m_Offsets;
+};
+
+const char* SafeStr(const char* Str)
+{
+    return Str != nullptr ? Str : "";
+}
+
+} // namespace
+
+
+struct ShaderArchive::Header
+{
+    Uint32 Magic;
+    Uint32 Version;
+    Uint32 Target;
+    Uint32 PipelineDataSize;
+
+    Uint32 NumShaders;
+    Uint32 ShadersOffset;
+    Uint32 NumPipelines;
+    Uint32 PipelinesOffset;
+
+    Uint32 StringsOffset;
+    Uint32 StringsSize;
+    Uint32 DataOffset;
+    Uint32 DataSize;
+};
+
+
+SHADER_ARCHIVE_TARGET GetShaderArchiveTarget(RENDER_DEVICE_TYPE DeviceType)
+{
+    switch (DeviceType)
+    {
+        // clang-format off
+        case RENDER_DEVICE_TYPE_D3D11:  return SHADER_ARCHIVE_TARGET_DXBC;
+        case RENDER_DEVICE_TYPE_D3D12:  return SHADER_ARCHIVE_TARGET_DXIL;
+        case RENDER_DEVICE_TYPE_GL:     return SHADER_ARCHIVE_TARGET_GLSL;
+        case RENDER_DEVICE_TYPE_GLES:   return SHADER_ARCHIVE_TARGET_GLSL;
+        case RENDER_DEVICE_TYPE_VULKAN: return SHADER_ARCHIVE_TARGET_SPIRV;
+        // clang-format on
+        default:
+            return SHADER_ARCHIVE_TARGET_UNKNOWN;
+    }
+}
+
+bool IsShaderArchiveTargetCompatible(SHADER_ARCHIVE_TARGET Target, RENDER_DEVICE_TYPE DeviceType)
+{
+    if (Target == SHADER_ARCHIVE_TARGET_UNKNOWN)
+        return false;
+
+    // Direct3D12 can consume both DXIL and DXBC byte code
+    if (DeviceType == RENDER_DEVICE_TYPE_D3D12 && Target == SHADER_ARCHIVE_TARGET_DXBC)
+        return true;
+
+    return GetShaderArchiveTarget(DeviceType) == Target;
+}
+
+const char* GetShaderArchiveTargetString(SHADER_ARCHIVE_TARGET Target)
+{
+    switch (Target)
+    {
+        // clang-format off
+        case SHADER_ARCHIVE_TARGET_UNKNOWN: return "UNKNOWN";
+        case SHADER_ARCHIVE_TARGET_SPIRV:   return "SPIRV";
+        case SHADER_ARCHIVE_TARGET_GLSL:    return "GLSL";
+        case SHADER_ARCHIVE_TARGET_DXIL:    return "DXIL";
+        case SHADER_ARCHIVE_TARGET_DXBC:    return "DXBC";
+        // clang-format on
+        default:
+            UNEXPECTED("Unexpected shader archive target");
+            return "UNKNOWN";
+    }
+}
+
+std::string BuildShaderPermutationKey(const ShaderMacro* Macros)
+{
+    if (Macros == nullptr)
+        return std::string{};
+
+    std::vector<const ShaderMacro*> SortedMacros;
+    for (const auto* pMacro = Macros; pMacro->Name != nullptr; ++pMacro)
+        SortedMacros.push_back(pMacro);
+
+    std::sort(SortedMacros.begin(), SortedMacros.end(),
+              [](const ShaderMacro* lhs, const ShaderMacro* rhs) {
+                  return strcmp(lhs->Name, rhs->Name) < 0;
+              });
+
+    std::string Key;
+    for (size_t i = 0; i < SortedMacros.size(); ++i)
+    {
+        const auto& Macro = *SortedMacros[i];
+        DEV_CHECK_ERR(i == 0 || strcmp(SortedMacros[i - 1]->Name, Macro.Name) != 0,
+                      "Macro '", Macro.Name, "' is defined more than once");
+        Key += Macro.Name;
+        Key += '=';
+        Key += SafeStr(Macro.Definition);
+        Key += '\n';
+    }
+    return Key;
+}
+
+
+struct ShaderArchiveWriter::ShaderRecord
+{
+    std::string Name;
+    std::string PermutationKey;
+    std::string EntryPoint;
+    std::string CombinedSamplerSuffix;
+
+    SHADER_TYPE ShaderType                 = SHADER_TYPE_UNKNOWN;
+    bool        UseCombinedTextureSamplers = false;
+
+    std::vector<Uint8> ByteCode;
+    std::vector<Uint8> Resources;
+
+    bool operator<(const ShaderRecord& rhs) const
+    {
+        return Name != rhs.Name ? Name < rhs.Name : PermutationKey < rhs.PermutationKey;
+    }
+};
+
+struct ShaderArchiveWriter::PipelineRecord
+{
+    std::string   Name;
+    PIPELINE_TYPE PipelineType = PIPELINE_TYPE_GRAPHICS;
+
+    PSO_CREATE_FLAGS              Flags                    = PSO_CREATE_FLAG_NONE;
+    Uint32                        SRBAllocationGranularity = 1;
+    Uint64                        CommandQueueMask         = 1;
+    SHADER_RESOURCE_VARIABLE_TYPE DefaultVariableType      = SHADER_RESOURCE_VARIABLE_TYPE_STATIC;
+
+    // Name pointers in the descriptions below are not used; names are
+    // kept in the parallel string arrays.
+    std::vector<ShaderResourceVariableDesc> Variables;
+    std::vector<std::string>                VariableNames;
+    std::vector<ImmutableSamplerDesc>       ImmutableSamplers;
+    std::vector<std::string>                ImmutableSamplerNames;
+    std::vector<LayoutElement>              LayoutElements;
+    std::vector<std::string>                LayoutElementSemantics;
+
+    GraphicsPipelineDesc GraphicsPipeline;
+
+    std::array<std::string, ARCHIVE_SHADER_STAGE_COUNT> ShaderNames;
+    std::array<std::string, ARCHIVE_SHADER_STAGE_COUNT> ShaderPermutationKeys;
+
+    bool InitCommon(const PipelineStateCreateInfo& CI)
+    {
+        const auto& Desc = CI.PSODesc;
+        if (Desc.Name == nullptr || *Desc.Name == '\0')
+        {
+            LOG_ERROR_MESSAGE("Archived pipeline must have a name");
+            return false;
+        }
+
+        Name                     = Desc.Name;
+        PipelineType             = Desc.PipelineType;
+        Flags                    = CI.Flags;
+        SRBAllocationGranularity = Desc.SRBAllocationGranularity;
+        CommandQueueMask         = Desc.CommandQueueMask;
+
+        const auto& ResLayout = Desc.ResourceLayout;
+        DefaultVariableType   = ResLayout.DefaultVariableType;
+        for (Uint32 i = 0; i < ResLayout.NumVariables; ++i)
+        {
+            Variables.push_back(ResLayout.Variables[i]);
+            VariableNames.emplace_back(SafeStr(ResLayout.Variables[i].Name));
+        }
+        for (Uint32 i = 0; i < ResLayout.NumImmutableSamplers; ++i)
+        {
+            ImmutableSamplers.push_back(ResLayout.ImmutableSamplers[i]);
+            ImmutableSamplerNames.emplace_back(SafeStr(ResLayout.ImmutableSamplers[i].SamplerOrTextureName));
+        }
+        return true;
+    }
+
+    void SetShader(ARCHIVE_SHADER_STAGE Stage, const ShaderArchiveShaderRef& Ref)
+    {
+        if (Ref.Name == nullptr)
+            return;
+        ShaderNames[Stage]           = Ref.Name;
+        ShaderPermutationKeys[Stage] = BuildShaderPermutationKey(Ref.Macros);
+    }
+};
+
+
+ShaderArchiveWriter::ShaderArchiveWriter(SHADER_ARCHIVE_TARGET Target) :
+    m_Target{Target}
+{
+    DEV_CHECK_ERR(m_Target > SHADER_ARCHIVE_TARGET_UNKNOWN && m_Target < SHADER_ARCHIVE_TARGET_COUNT, "Invalid shader archive target");
+}
+
+ShaderArchiveWriter::~ShaderArchiveWriter()
+{
+}
+
+size_t ShaderArchiveWriter::GetShaderCount() const
+{
+    return m_Shaders.size();
+}
+
+size_t ShaderArchiveWriter::GetPipelineCount() const
+{
+    return m_Pipelines.size();
+}
+
+bool ShaderArchiveWriter::AddShader(const ShaderData& Data)
+{
+    if (Data.Name == nullptr || *Data.Name == '\0')
+    {
+        LOG_ERROR_MESSAGE("Archived shader must have a name");
+        return false;
+    }
+    if (Data.pByteCode == nullptr || Data.ByteCodeSize == 0)
+    {
+        LOG_ERROR_MESSAGE("Byte code of shader '", Data.Name, "' is empty");
+        return false;
+    }
+    if (Data.ShaderType == SHADER_TYPE_UNKNOWN)
+    {
+        LOG_ERROR_MESSAGE("Type of shader '", Data.Name, "' is unknown");
+        return false;
+    }
+    if (Data.pResources != nullptr && m_Target != SHADER_ARCHIVE_TARGET_SPIRV)
+    {
+        LOG_WARNING_MESSAGE("Serialized resources of shader '", Data.Name, "' are ignored: they are only supported for SPIRV target");
+    }
+
+    ShaderRecord Record;
+    Record.Name                       = Data.Name;
+    Record.PermutationKey             = BuildShaderPermutationKey(Data.Macros);
+    Record.EntryPoint                 = SafeStr(Data.EntryPoint);
+    Record.CombinedSamplerSuffix      = SafeStr(Data.CombinedSamplerSuffix);
+    Record.ShaderType                 = Data.ShaderType;
+    Record.UseCombinedTextureSamplers = Data.UseCombinedTextureSamplers;
+
+    const auto* pByteCode = static_cast<const Uint8*>(Data.pByteCode);
+    Record.ByteCode.assign(pByteCode, pByteCode + Data.ByteCodeSize);
+    if (m_Target == SHADER_ARCHIVE_TARGET_GLSL)
+    {
+        // GLSL source is used in place by the loader and must be null-terminated
+        Record.ByteCode.push_back(0);
+    }
+
+    if (Data.pResources != nullptr && Data.ResourcesSize != 0 && m_Target == SHADER_ARCHIVE_TARGET_SPIRV)
+    {
+        const auto* pResources = static_cast<const Uint8*>(Data.pResources);
+        Record.Resources.assign(pResources, pResources + Data.ResourcesSize);
+    }
+
+    auto it = std::lower_bound(m_Shaders.begin(), m_Shaders.end(), Record);
+    if (it != m_Shaders.end() && !(Record < *it))
+    {
+        LOG_ERROR_MESSAGE("Shader '", Data.Name, "' with the same permutation has already been added to the archive");
+        return false;
+    }
+    m_Shaders.emplace(it, std::move(Record));
+    return true;
+}
+
+bool ShaderArchiveWriter::AddGraphicsPipeline(const GraphicsPipelineStateCreateInfo& PSOCreateInfo,
+                                              const ShaderArchiveGraphicsShaders&    Shaders)
+{
+    const auto& GraphicsPipeline = PSOCreateInfo.GraphicsPipeline;
+    if (GraphicsPipeline.pRenderPass != nullptr)
+    {
+        LOG_ERROR_MESSAGE("Pipeline '", SafeStr(PSOCreateInfo.PSODesc.Name), "' uses explicit render pass, which is not supported by the shader archive");
+        return false;
+    }
+    if (PSOCreateInfo.PSODesc.PipelineType != PIPELINE_TYPE_GRAPHICS && PSOCreateInfo.PSODesc.PipelineType != PIPELINE_TYPE_MESH)
+    {
+        LOG_ERROR_MESSAGE("Pipeline '", SafeStr(PSOCreateInfo.PSODesc.Name), "' is not a graphics or mesh pipeline");
+        return false;
+    }
+
+    PipelineRecord Record;
+    if (!Record.InitCommon(PSOCreateInfo))
+        return false;
+
+    Record.GraphicsPipeline              = GraphicsPipeline;
+    Record.GraphicsPipeline.InputLayout  = InputLayoutDesc{};
+    Record.GraphicsPipeline.pRenderPass  = nullptr;
+    Record.GraphicsPipeline.SubpassIndex = 0;
+
+    const auto& InputLayout = GraphicsPipeline.InputLayout;
+    for (Uint32 i = 0; i < InputLayout.NumElements; ++i)
+    {
+        Record.LayoutElements.push_back(InputLayout.LayoutElements[i]);
+        Record.LayoutElementSemantics.emplace_back(SafeStr(InputLayout.LayoutElements[i].HLSLSemantic));
+    }
+
+    Record.SetShader(ARCHIVE_SHADER_STAGE_VS, Shaders.VS);
+    Record.SetShader(ARCHIVE_SHADER_STAGE_PS, Shaders.PS);
+    Record.SetShader(ARCHIVE_SHADER_STAGE_DS, Shaders.DS);
+    Record.SetShader(ARCHIVE_SHADER_STAGE_HS, Shaders.HS);
+    Record.SetShader(ARCHIVE_SHADER_STAGE_GS, Shaders.GS);
+    Record.SetShader(ARCHIVE_SHADER_STAGE_AS, Shaders.AS);
+    Record.SetShader(ARCHIVE_SHADER_STAGE_MS, Shaders.MS);
+
+    auto it = std::lower_bound(m_Pipelines.begin(), m_Pipelines.end(), Record.Name,
+                               [](const PipelineRecord& Rec, const std::string& Name) { return Rec.Name < Name; });
+    if (it != m_Pipelines.end() && it->Name == Record.Name)
+    {
+        LOG_ERROR_MESSAGE("Pipeline '", Record.Name, "' has already been added to the archive");
+        return false;
+    }
+    m_Pipelines.emplace(it, std::move(Record));
+    return true;
+}
+
+bool ShaderArchiveWriter::AddComputePipeline(const ComputePipelineStateCreateInfo& PSOCreateInfo,
+                                             const ShaderArchiveShaderRef&         CS)
+{
+    if (PSOCreateInfo.PSODesc.PipelineType != PIPELINE_TYPE_COMPUTE)
+    {
+        LOG_ERROR_MESSAGE("Pipeline '", SafeStr(PSOCreateInfo.PSODesc.Name), "' is not a compute pipeline");
+        return false;
+    }
+
+    PipelineRecord Record;
+    if (!Record.InitCommon(PSOCreateInfo))
+        return false;
+
+    Record.SetShader(ARCHIVE_SHADER_STAGE_CS, CS);
+
+    auto it = std::lower_bound(m_Pipelines.begin(), m_Pipelines.end(), Record.Name,
+                               [](const PipelineRecord& Rec, const std::string& Name) { return Rec.Name < Name; });
+    if (it != m_Pipelines.end() && it->Name == Record.Name)
+    {
+        LOG_ERROR_MESSAGE("Pipeline '", Record.Name, "' has already been added to the archive");
+        return false;
+    }
+    m_Pipelines.emplace(it, std::move(Record));
+    return true;
+}
+
+bool ShaderArchiveWriter::Serialize(IDataBlob** ppArchive) const
+{
+    DEV_CHECK_ERR(ppArchive != nullptr && *ppArchive == nullptr, "ppArchive must not be null and must point to null");
+
+    StringTable        Strings;
+    std::vector<Uint8> Data;
+
+    auto AppendData = [&Data](const void* pSrc, size_t Size) //
+    {
+        Data.resize(Align(Data.size(), size_t{DataAlignment}));
+        const auto Offset = static_cast<Uint32>(Data.size());
+        Data.resize(Data.size() + Size);
+        if (Size != 0)
+            memcpy(&Data[Offset], pSrc, Size);
+        return Offset;
+    };
+
+    std::vector<ArchivedShaderRecord> ShaderRecords;
+    ShaderRecords.reserve(m_Shaders.size());
+    for (const auto& Shader : m_Shaders)
+    {
+        ArchivedShaderRecord Rec{};
+        Rec.Name                  = Strings.Add(Shader.Name);
+        Rec.PermutationKey        = Strings.Add(Shader.PermutationKey);
+        Rec.EntryPoint            = Strings.Add(Shader.EntryPoint);
+        Rec.CombinedSamplerSuffix = Strings.Add(Shader.CombinedSamplerSuffix);
+        Rec.ShaderType            = static_cast<Uint32>(Shader.ShaderType);
+        Rec.Flags                 = Shader.UseCombinedTextureSamplers ? ARCHIVED_SHADER_FLAG_USE_COMBINED_TEXTURE_SAMPLERS : ARCHIVED_SHADER_FLAG_NONE;
+        Rec.ByteCodeOffset        = AppendData(Shader.ByteCode.data(), Shader.ByteCode.size());
+        Rec.ByteCodeSize          = static_cast<Uint32>(Shader.ByteCode.size());
+        if (!Shader.Resources.empty())
+        {
+            Rec.ResourcesOffset = AppendData(Shader.Resources.data(), Shader.Resources.size());
+            Rec.ResourcesSize   = static_cast<Uint32>(Shader.Resources.size());
+        }
+        else
+        {
+            Rec.ResourcesOffset = InvalidOffset;
+            Rec.ResourcesSize   = 0;
+        }
+        ShaderRecords.push_back(Rec);
+    }
+
+    auto FindShader = [this](const std::string& Name, const std::string& PermutationKey) //
+    {
+        ShaderRecord Key;
+        Key.Name           = Name;
+        Key.PermutationKey = PermutationKey;
+
+        auto it = std::lower_bound(m_Shaders.begin(), m_Shaders.end(), Key);
+        return it != m_Shaders.end() && !(Key < *it);
+    };
+
+    std::vector<ArchivedPipelineRecord> PipelineRecords;
+    PipelineRecords.reserve(m_Pipelines.size());
+    for (const auto& Pipeline : m_Pipelines)
+    {
+        // Construct the data in zeroed memory to keep the padding bytes deterministic
+        alignas(ArchivedPipelineData) Uint8 PipelineDataBuffer[sizeof(ArchivedPipelineData)] = {};
+
+        auto& PipelineData = *new (PipelineDataBuffer) ArchivedPipelineData{};
+
+        PipelineData.CommandQueueMask         = Pipeline.CommandQueueMask;
+        PipelineData.Flags                    = static_cast<Uint32>(Pipeline.Flags);
+        PipelineData.SRBAllocationGranularity = Pipeline.SRBAllocationGranularity;
+        PipelineData.DefaultVariableType      = static_cast<Uint32>(Pipeline.DefaultVariableType);
+        PipelineData.NumVariables             = static_cast<Uint32>(Pipeline.Variables.size());
+        PipelineData.NumImmutableSamplers     = static_cast<Uint32>(Pipeline.ImmutableSamplers.size());
+        PipelineData.NumLayoutElements        = static_cast<Uint32>(Pipeline.LayoutElements.size());
+
+        for (Uint32 Stage = 0; Stage < ARCHIVE_SHADER_STAGE_COUNT; ++Stage)
+        {
+            const auto& ShaderName = Pipeline.ShaderNames[Stage];
+            if (ShaderName.empty())
+                continue;
+
+            const auto& PermutationKey = Pipeline.ShaderPermutationKeys[Stage];
+            if (!FindShader(ShaderName, PermutationKey))
+            {
+                LOG_ERROR_MESSAGE("Pipeline '", Pipeline.Name, "' references shader '", ShaderName, "' that is not found in the archive");
+                return false;
+            }
+            PipelineData.Shaders[Stage].Name           = Strings.Add(ShaderName);
+            PipelineData.Shaders[Stage].PermutationKey = Strings.Add(PermutationKey);
+        }
+
+        const auto& GrDesc             = Pipeline.GraphicsPipeline;
+        PipelineData.SampleMask        = GrDesc.SampleMask;
+        PipelineData.NodeMask          = GrDesc.NodeMask;
+        PipelineData.PrimitiveTopology = static_cast<Uint8>(GrDesc.PrimitiveTopology);
+        PipelineData.NumViewports      = GrDesc.NumViewports;
+        PipelineData.NumRenderTargets  = GrDesc.NumRenderTargets;
+        PipelineData.SampleCount       = GrDesc.SmplDesc.Count;
+        PipelineData.SampleQuality     = GrDesc.SmplDesc.Quality;
+        PipelineData.DSVFormat         = static_cast<Uint16>(GrDesc.DSVFormat);
+        for (Uint32 rt = 0; rt < MAX_RENDER_TARGETS; ++rt)
+            PipelineData.RTVFormats[rt] = static_cast<Uint16>(GrDesc.RTVFormats[rt]);
+        PipelineData.BlendDesc        = GrDesc.BlendDesc;
+        PipelineData.RasterizerDesc   = GrDesc.RasterizerDesc;
+        PipelineData.DepthStencilDesc = GrDesc.DepthStencilDesc;
+
+        std::vector<ArchivedVariable> Variables(Pipeline.Variables.size());
+        for (size_t i = 0; i < Variables.size(); ++i)
+        {
+            Variables[i].ShaderStages = static_cast<Uint32>(Pipeline.Variables[i].ShaderStages);
+            Variables[i].Name         = Strings.Add(Pipeline.VariableNames[i]);
+            Variables[i].Type         = static_cast<Uint32>(Pipeline.Variables[i].Type);
+        }
+
+        std::vector<ArchivedImmutableSampler> ImtblSamplers(Pipeline.ImmutableSamplers.size());
+        for (size_t i = 0; i < ImtblSamplers.size(); ++i)
+        {
+            const auto& Src = Pipeline.ImmutableSamplers[i];
+            const auto& Smp = Src.Desc;
+
+            auto& Dst{ImtblSamplers[i]};
+            Dst.ShaderStages   = static_cast<Uint32>(Src.ShaderStages);
+            Dst.Name           = Strings.Add(Pipeline.ImmutableSamplerNames[i]);
+            Dst.MinFilter      = static_cast<Uint8>(Smp.MinFilter);
+            Dst.MagFilter      = static_cast<Uint8>(Smp.MagFilter);
+            Dst.MipFilter      = static_cast<Uint8>(Smp.MipFilter);
+            Dst.AddressU       = static_cast<Uint8>(Smp.AddressU);
+            Dst.AddressV       = static_cast<Uint8>(Smp.AddressV);
+            Dst.AddressW       = static_cast<Uint8>(Smp.AddressW);
+            Dst.ComparisonFunc = static_cast<Uint8>(Smp.ComparisonFunc);
+            Dst.MipLODBias     = Smp.MipLODBias;
+            Dst.MaxAnisotropy  = Smp.MaxAnisotropy;
+            for (Uint32 c = 0; c < 4; ++c)
+                Dst.BorderColor[c] = Smp.BorderColor[c];
+            Dst.MinLOD = Smp.MinLOD;
+            Dst.MaxLOD = Smp.MaxLOD;
+        }
+
+        std::vector<ArchivedLayoutElement> LayoutElems(Pipeline.LayoutElements.size());
+        for (size_t i = 0; i < LayoutElems.size(); ++i)
+        {
+            const auto& Src = Pipeline.LayoutElements[i];
+
+            auto& Dst{LayoutElems[i]};
+            Dst.HLSLSemantic         = Strings.Add(Pipeline.LayoutElementSemantics[i]);
+            Dst.InputIndex           = Src.InputIndex;
+            Dst.BufferSlot           = Src.BufferSlot;
+            Dst.NumComponents        = Src.NumComponents;
+            Dst.ValueType            = static_cast<Uint32>(Src.ValueType);
+            Dst.IsNormalized         = Src.IsNormalized ? 1 : 0;
+            Dst.RelativeOffset       = Src.RelativeOffset;
+            Dst.Stride               = Src.Stride;
+            Dst.Frequency            = static_cast<Uint32>(Src.Frequency);
+            Dst.InstanceDataStepRate = Src.InstanceDataStepRate;
+        }
+
+        ArchivedPipelineRecord Rec{};
+        Rec.Name         = Strings.Add(Pipeline.Name);
+        Rec.PipelineType = static_cast<Uint32>(Pipeline.PipelineType);
+        Rec.DataOffset   = AppendData(&PipelineData, sizeof(PipelineData));
+        // Arrays immediately follow the pipeline data; all records are 4-byte aligned
+        static_assert(sizeof(ArchivedPipelineData) % 4 == 0, "ArchivedPipelineData size must be a multiple of 4");
+        Data.insert(Data.end(), reinterpret_cast<const Uint8*>(Variables.data()), reinterpret_cast<const Uint8*>(Variables.data() + Variables.size()));
+        Data.insert(Data.end(), reinterpret_cast<const Uint8*>(ImtblSamplers.data()), reinterpret_cast<const Uint8*>(ImtblSamplers.data() + ImtblSamplers.size()));
+        Data.insert(Data.end(), reinterpret_cast<const Uint8*>(LayoutElems.data()), reinterpret_cast<const Uint8*>(LayoutElems.data() + LayoutElems.size()));
+        Rec.DataSize = static_cast<Uint32>(Data.size() - Rec.DataOffset);
+
+        PipelineRecords.push_back(Rec);
+    }
+
+    const auto& StringData = Strings.GetData();
+
+    ShaderArchive::Header Header{};
+    Header.Magic            = ShaderArchiveMagic;
+    Header.Version          = ShaderArchive::FormatVersion;
+    Header.Target           = m_Target;
+    Header.PipelineDataSize = sizeof(ArchivedPipelineData);
+    Header.NumShaders       = static_cast<Uint32>(ShaderRecords.size());
+    Header.ShadersOffset    = sizeof(Header);
+    Header.NumPipelines     = static_cast<Uint32>(PipelineRecords.size());
+    Header.PipelinesOffset  = Header.ShadersOffset + static_cast<Uint32>(sizeof(ArchivedShaderRecord) * ShaderRecords.size());
+    Header.StringsOffset    = Header.PipelinesOffset + static_cast<Uint32>(sizeof(ArchivedPipelineRecord) * PipelineRecords.size());
+    Header.StringsSize      = static_cast<Uint32>(StringData.size());
+    Header.DataOffset       = Align(Header.StringsOffset + Header.StringsSize, DataAlignment);
+    Header.DataSize         = static_cast<Uint32>(Data.size());
+
+    const size_t TotalSize = size_t{Header.DataOffset} + size_t{Header.DataSize};
+    if (TotalSize > size_t{~Uint32{0}})
+    {
+        LOG_ERROR_MESSAGE("Shader archive size exceeds 4GB");
+        return false;
+    }
+
+    auto  pArchive  = MakeNewRCObj<DataBlobImpl>()(TotalSize);
+    auto* pDstBytes = reinterpret_cast<Uint8*>(pArchive->GetDataPtr());
+    memset(pDstBytes, 0, TotalSize);
+    memcpy(pDstBytes, &Header, sizeof(Header));
+    if (!ShaderRecords.empty())
+        memcpy(pDstBytes + Header.ShadersOffset, ShaderRecords.data(), sizeof(ArchivedShaderRecord) * ShaderRecords.size());
+    if (!PipelineRecords.empty())
+        memcpy(pDstBytes + Header.PipelinesOffset, PipelineRecords.data(), sizeof(ArchivedPipelineRecord) * PipelineRecords.size());
+    memcpy(pDstBytes + Header.StringsOffset, StringData.data(), StringData.size());
+    if (!Data.empty())
+        memcpy(pDstBytes + Header.DataOffset, Data.data(), Data.size());
+
+    pArchive->QueryInterface(IID_DataBlob, reinterpret_cast<IObject**>(ppArchive));
+    return true;
+}
+
+
+
+ShaderArchive::ShaderArchive(const void* pData, size_t Size)
+{
+    Initialize(pData, Size);
+}
+
+ShaderArchive::ShaderArchive(IDataBlob* pArchiveData) :
+    m_pArchiveData{pArchiveData}
+{
+    if (m_pArchiveData)
+        Initialize(m_pArchiveData->GetDataPtr(), m_pArchiveData->GetSize());
+    else
+        LOG_ERROR_MESSAGE("Shader archive data must not be null");
+}
+
+ShaderArchive::~ShaderArchive()
+{
+}
+
+void ShaderArchive::Initialize(const void* pData, size_t Size)
+{
+    static_assert(sizeof(Header) == 48, "The size of ShaderArchive::Header is expected to be 48 bytes");
+
+    if (pData == nullptr || Size < sizeof(Header))
+    {
+        LOG_ERROR_MESSAGE("Shader archive data is too small");
+        return;
+    }
+    if ((reinterpret_cast<size_t>(pData) % DataAlignment) != 0)
+    {
+        LOG_ERROR_MESSAGE("Shader archive data must be ", DataAlignment, "-byte aligned");
+        return;
+    }
+
+    const auto* pHeader = reinterpret_cast<const Header*>(pData);
+    if (pHeader->Magic != ShaderArchiveMagic)
+    {
+        LOG_ERROR_MESSAGE("The data is not a shader archive");
+        return;
+    }
+    if (pHeader->Version != FormatVersion || pHeader->PipelineDataSize != sizeof(ArchivedPipelineData))
+    {
+        LOG_ERROR_MESSAGE("Shader archive version (", pHeader->Version, ") is not compatible with the engine version (", Uint32{FormatVersion},
+                          "). The archive must be rebuilt.");
+        return;
+    }
+    if (pHeader->Target == SHADER_ARCHIVE_TARGET_UNKNOWN || pHeader->Target >= SHADER_ARCHIVE_TARGET_COUNT)
+    {
+        LOG_ERROR_MESSAGE("Shader archive target (", pHeader->Target, ") is invalid");
+        return;
+    }
+
+    // clang-format off
+    const bool RangesValid =
+        size_t{pHeader->ShadersOffset}   + size_t{pHeader->NumShaders}   * sizeof(ArchivedShaderRecord)   <= Size &&
+        size_t{pHeader->PipelinesOffset} + size_t{pHeader->NumPipelines} * sizeof(ArchivedPipelineRecord) <= Size &&
+        size_t{pHeader->StringsOffset}   + size_t{pHeader->StringsSize}                                   <= Size &&
+        size_t{pHeader->DataOffset}      + size_t{pHeader->DataSize}                                      <= Size &&
+        pHeader->ShadersOffset   % 4 == 0 &&
+        pHeader->PipelinesOffset % 4 == 0 &&
+        pHeader->DataOffset      % DataAlignment == 0;
+    // clang-format on
+    if (!RangesValid)
+    {
+        LOG_ERROR_MESSAGE("Shader archive is corrupted: table ranges are out of bounds");
+        return;
+    }
+
+    const auto* pBytes = reinterpret_cast<const Uint8*>(pData);
+    // All strings are referenced by offset, so it is enough to check that the table ends with the null terminator
+    if (pHeader->StringsSize == 0 || pBytes[pHeader->StringsOffset + pHeader->StringsSize - 1] != 0)
+    {
+        LOG_ERROR_MESSAGE("Shader archive is corrupted: string table is not null-terminated");
+        return;
+    }
+
+    const auto* pShaders = reinterpret_cast<const ArchivedShaderRecord*>(pBytes + pHeader->ShadersOffset);
+    for (Uint32 i = 0; i < pHeader->NumShaders; ++i)
+    {
+        const auto& Rec = pShaders[i];
+        // clang-format off
+        const bool IsValid =
+            Rec.Name                  < pHeader->StringsSize &&
+            Rec.PermutationKey        < pHeader->StringsSize &&
+            Rec.EntryPoint            < pHeader->StringsSize &&
+            Rec.CombinedSamplerSuffix < pHeader->StringsSize &&
+            size_t{Rec.ByteCodeOffset} + size_t{Rec.ByteCodeSize} <= pHeader->DataSize &&
+            (Rec.ResourcesOffset == InvalidOffset || size_t{Rec.ResourcesOffset} + size_t{Rec.ResourcesSize} <= pHeader->DataSize);
+        // clang-format on
+        if (!IsValid)
+        {
+            LOG_ERROR_MESSAGE("Shader archive is corrupted: shader record ", i, " is invalid");
+            return;
+        }
+    }
+
+    const auto* pPipelines = reinterpret_cast<const ArchivedPipelineRecord*>(pBytes + pHeader->PipelinesOffset);
+    for (Uint32 i = 0; i < pHeader->NumPipelines; ++i)
+    {
+        const auto& Rec = pPipelines[i];
+        if (Rec.Name >= pHeader->StringsSize ||
+            size_t{Rec.DataOffset} + size_t{Rec.DataSize} > pHeader->DataSize ||
+            Rec.DataSize < sizeof(ArchivedPipelineData) ||
+            Rec.DataOffset % DataAlignment != 0)
+        {
+            LOG_ERROR_MESSAGE("Shader archive is corrupted: pipeline record ", i, " is invalid");
+            return;
+        }
+    }
+
+    m_pData    = pBytes;
+    m_DataSize = Size;
+    m_pHeader  = pHeader;
+}
+
+SHADER_ARCHIVE_TARGET ShaderArchive::GetTarget() const
+{
+    return m_pHeader != nullptr ? static_cast<SHADER_ARCHIVE_TARGET>(m_pHeader->Target) : SHADER_ARCHIVE_TARGET_UNKNOWN;
+}
+
+Uint32 ShaderArchive::GetShaderCount() const
+{
+    return m_pHeader != nullptr ? m_pHeader->NumShaders : 0;
+}
+
+Uint32 ShaderArchive::GetPipelineCount() const
+{
+    return m_pHeader != nullptr ? m_pHeader->NumPipelines : 0;
+}
+
+const char* ShaderArchive::GetString(Uint32 Offset) const
+{
+    VERIFY_EXPR(m_pHeader != nullptr);
+    if (Offset >= m_pHeader->StringsSize)
+    {
+        UNEXPECTED("String offset is out of range");
+        return "";
+    }
+    return reinterpret_cast<const char*>(m_pData + m_pHeader->StringsOffset + Offset);
+}
+
+template <typename RecordType>
+const RecordType* ShaderArchive::GetRecords(Uint32 Offset) const
+{
+    VERIFY_EXPR(m_pHeader != nullptr);
+    return reinterpret_cast<const RecordType*>(m_pData + Offset);
+}
+
+ShaderArchive::ShaderInfo ShaderArchive::GetShaderInfo(Uint32 Index) const
+{
+    ShaderInfo Info;
+    if (Index >= GetShaderCount())
+    {
+        UNEXPECTED("Shader index (", Index, ") is out of range");
+        return Info;
+    }
+
+    const auto& Rec = GetRecords<ArchivedShaderRecord>(m_pHeader->ShadersOffset)[Index];
+
+    const auto* pDataSection = m_pData + m_pHeader->DataOffset;
+
+    Info.Name                       = GetString(Rec.Name);
+    Info.PermutationKey             = GetString(Rec.PermutationKey);
+    Info.EntryPoint                 = GetString(Rec.EntryPoint);
+    Info.CombinedSamplerSuffix      = GetString(Rec.CombinedSamplerSuffix);
+    Info.ShaderType                 = static_cast<SHADER_TYPE>(Rec.ShaderType);
+    Info.UseCombinedTextureSamplers = (Rec.Flags & ARCHIVED_SHADER_FLAG_USE_COMBINED_TEXTURE_SAMPLERS) != 0;
+    Info.pByteCode                  = pDataSection + Rec.ByteCodeOffset;
+    Info.ByteCodeSize               = Rec.ByteCodeSize;
+    if (m_pHeader->Target == SHADER_ARCHIVE_TARGET_GLSL && Info.ByteCodeSize > 0)
+    {
+        // Do not count the null terminator
+        --Info.ByteCodeSize;
+    }
+    if (Rec.ResourcesOffset != InvalidOffset)
+    {
+        Info.pResources    = pDataSection + Rec.ResourcesOffset;
+        Info.ResourcesSize = Rec.ResourcesSize;
+    }
+
+    return Info;
+}
+
+const char* ShaderArchive::GetPipelineName(Uint32 Index) const
+{
+    if (Index >= GetPipelineCount())
+    {
+        UNEXPECTED("Pipeline index (", Index, ") is out of range");
+        return nullptr;
+    }
+    return GetString(GetRecords<ArchivedPipelineRecord>(m_pHeader->PipelinesOffset)[Index].Name);
+}
+
+Uint32 ShaderArchive::FindShaderRecord(const char* Name, const char* PermutationKey) const
+{
+    const auto* pBegin = GetRecords<ArchivedShaderRecord>(m_pHeader->ShadersOffset);
+    const auto* pEnd   = pBegin + m_pHeader->NumShaders;
+
+    auto Compare = [&](const ArchivedShaderRecord& Rec) {
+        auto NameCmp = strcmp(GetString(Rec.Name), Name);
+        return NameCmp != 0 ? NameCmp : strcmp(GetString(Rec.PermutationKey), PermutationKey);
+    };
+
+    const auto* it = std::lower_bound(pBegin, pEnd, 0,
+                                      [&](const ArchivedShaderRecord& Rec, int) { return Compare(Rec) < 0; });
+    if (it == pEnd || Compare(*it) != 0)
+        return InvalidOffset;
+
+    return static_cast<Uint32>(it - pBegin);
+}
+
+bool ShaderArchive::FindShader(const char* Name, const ShaderMacro* Macros, ShaderInfo& Info) const
+{
+    if (m_pHeader == nullptr || Name == nullptr)
+        return false;
+
+    const auto Index = FindShaderRecord(Name, BuildShaderPermutationKey(Macros).c_str());
+    if (Index == InvalidOffset)
+        return false;
+
+    Info = GetShaderInfo(Index);
+    return true;
+}
+
+void ShaderArchive::CreateShader(IRenderDevice*     pDevice,
+                                 const char*        Name,
+                                 const ShaderMacro* Macros,
+                                 IShader**          ppShader) const
+{
+    DEV_CHECK_ERR(pDevice != nullptr, "pDevice must not be null");
+    DEV_CHECK_ERR(ppShader != nullptr && *ppShader == nullptr, "ppShader must not be null and must point to null");
+
+    if (m_pHeader == nullptr)
+    {
+        LOG_ERROR_MESSAGE("Failed to create shader '", SafeStr(Name), "': the archive is not valid");
+        return;
+    }
+
+    const auto DeviceType = pDevice->GetDeviceCaps().DevType;
+    const auto Target     = GetTarget();
+    if (!IsShaderArchiveTargetCompatible(Target, DeviceType))
+    {
+        LOG_ERROR_MESSAGE("Failed to create shader '", SafeStr(Name), "': shader archive target ", GetShaderArchiveTargetString(Target),
+                          " is not compatible with the render device");
+        return;
+    }
+
+    ShaderInfo Info;
+    if (!FindShader(Name, Macros, Info))
+    {
+        LOG_ERROR_MESSAGE("Shader '", SafeStr(Name), "' with the requested permutation is not found in the archive");
+        return;
+    }
+
+    CreateShader(pDevice, Info, ppShader);
+}
+
+void ShaderArchive::CreateShader(IRenderDevice*    pDevice,
+                                 const ShaderInfo& Info,
+                                 IShader**         ppShader) const
+{
+    const auto Target = GetTarget();
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.Desc.Name                  = Info.Name;
+    ShaderCI.Desc.ShaderType            = Info.ShaderType;
+    ShaderCI.EntryPoint                 = Info.EntryPoint;
+    ShaderCI.UseCombinedTextureSamplers = Info.UseCombinedTextureSamplers;
+    ShaderCI.CombinedSamplerSuffix      = Info.CombinedSamplerSuffix;
+
+    if (Target == SHADER_ARCHIVE_TARGET_GLSL)
+    {
+        ShaderCI.Source         = static_cast<const char*>(Info.pByteCode);
+        ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_GLSL_VERBATIM;
+    }
+    else
+    {
+        ShaderCI.ByteCode     = Info.pByteCode;
+        ShaderCI.ByteCodeSize = Info.ByteCodeSize;
+    }
+
+#if VULKAN_SUPPORTED
+    if (Target == SHADER_ARCHIVE_TARGET_SPIRV && Info.pResources != nullptr)
+    {
+        RefCntAutoPtr<IRenderDeviceVk> pDeviceVk{pDevice, IID_RenderDeviceVk};
+        if (pDeviceVk)
+        {
+            // Use the serialized resources to avoid reflecting SPIRV at run time
+            pDeviceVk->CreateShaderFromSPIRV(ShaderCI, Info.pResources, Info.ResourcesSize, ppShader);
+            return;
+        }
+    }
+#endif
+
+    pDevice->CreateShader(ShaderCI, ppShader);
+}
+
+void ShaderArchive::CreatePipelineState(IRenderDevice*   pDevice,
+                                        const char*      Name,
+                                        IPipelineState** ppPSO) const
+{
+    DEV_CHECK_ERR(pDevice != nullptr, "pDevice must not be null");
+    DEV_CHECK_ERR(ppPSO != nullptr && *ppPSO == nullptr, "ppPSO must not be null and must point to null");
+
+    if (m_pHeader == nullptr || Name == nullptr)
+    {
+        LOG_ERROR_MESSAGE("Failed to create pipeline '", SafeStr(Name), "': the archive is not valid");
+        return;
+    }
+
+    const auto* pBegin = GetRecords<ArchivedPipelineRecord>(m_pHeader->PipelinesOffset);
+    const auto* pEnd   = pBegin + m_pHeader->NumPipelines;
+
+    const auto* it = std::lower_bound(pBegin, pEnd, Name,
+                                      [this](const ArchivedPipelineRecord& Rec, const char* Name) { return strcmp(GetString(Rec.Name), Name) < 0; });
+    if (it == pEnd || strcmp(GetString(it->Name), Name) != 0)
+    {
+        LOG_ERROR_MESSAGE("Pipeline '", Name, "' is not found in the archive");
+        return;
+    }
+
+    const auto DeviceType = pDevice->GetDeviceCaps().DevType;
+    if (!IsShaderArchiveTargetCompatible(GetTarget(), DeviceType))
+    {
+        LOG_ERROR_MESSAGE("Failed to create pipeline '", Name, "': shader archive target ", GetShaderArchiveTargetString(GetTarget()),
+                          " is not compatible with the render device");
+        return;
+    }
+
+    const auto& Rec = *it;
+
+    const auto* pPipelineBytes = m_pData + m_pHeader->DataOffset + Rec.DataOffset;
+
+    ArchivedPipelineData PipelineData;
+    memcpy(&PipelineData, pPipelineBytes, sizeof(PipelineData));
+
+    const size_t RequiredSize =
+        sizeof(ArchivedPipelineData) +
+        sizeof(ArchivedVariable) * PipelineData.NumVariables +
+        sizeof(ArchivedImmutableSampler) * PipelineData.NumImmutableSamplers +
+        sizeof(ArchivedLayoutElement) * PipelineData.NumLayoutElements;
+    if (RequiredSize > Rec.DataSize)
+    {
+        LOG_ERROR_MESSAGE("Shader archive is corrupted: data of pipeline '", Name, "' is truncated");
+        return;
+    }
+
+    // Records that follow the pipeline data are 4-byte aligned
+    const auto* pVariables     = reinterpret_cast<const ArchivedVariable*>(pPipelineBytes + sizeof(ArchivedPipelineData));
+    const auto* pImtblSamplers = reinterpret_cast<const ArchivedImmutableSampler*>(pVariables + PipelineData.NumVariables);
+    const auto* pLayoutElems   = reinterpret_cast<const ArchivedLayoutElement*>(pImtblSamplers + PipelineData.NumImmutableSamplers);
+
+    std::array<RefCntAutoPtr<IShader>, ARCHIVE_SHADER_STAGE_COUNT> Shaders;
+    for (Uint32 Stage = 0; Stage < ARCHIVE_SHADER_STAGE_COUNT; ++Stage)
+    {
+        const auto& Ref = PipelineData.Shaders[Stage];
+        if (Ref.Name == InvalidOffset)
+            continue;
+        if (Ref.Name >= m_pHeader->StringsSize || Ref.PermutationKey >= m_pHeader->StringsSize)
+        {
+            LOG_ERROR_MESSAGE("Shader archive is corrupted: shader reference of pipeline '", Name, "' is invalid");
+            return;
+        }
+
+        const char* ShaderName  = GetString(Ref.Name);
+        const auto  ShaderIndex = FindShaderRecord(ShaderName, GetString(Ref.PermutationKey));
+        if (ShaderIndex == InvalidOffset)
+        {
+            LOG_ERROR_MESSAGE("Shader '", ShaderName, "' referenced by pipeline '", Name, "' is not found in the archive");
+            return;
+        }
+
+        CreateShader(pDevice, GetShaderInfo(ShaderIndex), &Shaders[Stage]);
+        if (!Shaders[Stage])
+        {
+            LOG_ERROR_MESSAGE("Failed to create shader '", ShaderName, "' for pipeline '", Name, "'");
+            return;
+        }
+    }
+
+    std::vector<ShaderResourceVariableDesc> Variables(PipelineData.NumVariables);
+    for (Uint32 i = 0; i < PipelineData.NumVariables; ++i)
+    {
+        ArchivedVariable Var;
+        memcpy(&Var, pVariables + i, sizeof(Var));
+        Variables[i].ShaderStages = static_cast<SHADER_TYPE>(Var.ShaderStages);
+        Variables[i].Name         = GetString(Var.Name);
+        Variables[i].Type         = static_cast<SHADER_RESOURCE_VARIABLE_TYPE>(Var.Type);
+    }
+
+    std::vector<ImmutableSamplerDesc> ImtblSamplers(PipelineData.NumImmutableSamplers);
+    for (Uint32 i = 0; i < PipelineData.NumImmutableSamplers; ++i)
+    {
+        ArchivedImmutableSampler Src;
+        memcpy(&Src, pImtblSamplers + i, sizeof(Src));
+
+        auto& Dst{ImtblSamplers[i]};
+        Dst.ShaderStages         = static_cast<SHADER_TYPE>(Src.ShaderStages);
+        Dst.SamplerOrTextureName = GetString(Src.Name);
+
+        auto& Smp{Dst.Desc};
+        Smp.MinFilter      = static_cast<FILTER_TYPE>(Src.MinFilter);
+        Smp.MagFilter      = static_cast<FILTER_TYPE>(Src.MagFilter);
+        Smp.MipFilter      = static_cast<FILTER_TYPE>(Src.MipFilter);
+        Smp.AddressU       = static_cast<TEXTURE_ADDRESS_MODE>(Src.AddressU);
+        Smp.AddressV       = static_cast<TEXTURE_ADDRESS_MODE>(Src.AddressV);
+        Smp.AddressW       = static_cast<TEXTURE_ADDRESS_MODE>(Src.AddressW);
+        Smp.ComparisonFunc = static_cast<COMPARISON_FUNCTION>(Src.ComparisonFunc);
+        Smp.MipLODBias     = Src.MipLODBias;
+        Smp.MaxAnisotropy  = Src.MaxAnisotropy;
+        for (Uint32 c = 0; c < 4; ++c)
+            Smp.BorderColor[c] = Src.BorderColor[c];
+        Smp.MinLOD = Src.MinLOD;
+        Smp.MaxLOD = Src.MaxLOD;
+    }
+
+    std::vector<LayoutElement> LayoutElems(PipelineData.NumLayoutElements);
+    for (Uint32 i = 0; i < PipelineData.NumLayoutElements; ++i)
+    {
+        ArchivedLayoutElement Src;
+        memcpy(&Src, pLayoutElems + i, sizeof(Src));
+
+        auto& Dst{LayoutElems[i]};
+        Dst.HLSLSemantic         = GetString(Src.HLSLSemantic);
+        Dst.InputIndex           = Src.InputIndex;
+        Dst.BufferSlot           = Src.BufferSlot;
+        Dst.NumComponents        = Src.NumComponents;
+        Dst.ValueType            = static_cast<VALUE_TYPE>(Src.ValueType);
+        Dst.IsNormalized         = Src.IsNormalized != 0;
+        Dst.RelativeOffset       = Src.RelativeOffset;
+        Dst.Stride               = Src.Stride;
+        Dst.Frequency            = static_cast<INPUT_ELEMENT_FREQUENCY>(Src.Frequency);
+        Dst.InstanceDataStepRate = Src.InstanceDataStepRate;
+    }
+
+    auto InitCommon = [&](PipelineStateCreateInfo& CI) //
+    {
+        auto& Desc                    = CI.PSODesc;
+        Desc.Name                     = GetString(Rec.Name);
+        Desc.PipelineType             = static_cast<PIPELINE_TYPE>(Rec.PipelineType);
+        Desc.SRBAllocationGranularity = PipelineData.SRBAllocationGranularity;
+        Desc.CommandQueueMask         = PipelineData.CommandQueueMask;
+        CI.Flags                      = static_cast<PSO_CREATE_FLAGS>(PipelineData.Flags);
+
+        auto& ResLayout                = Desc.ResourceLayout;
+        ResLayout.DefaultVariableType  = static_cast<SHADER_RESOURCE_VARIABLE_TYPE>(PipelineData.DefaultVariableType);
+        ResLayout.NumVariables         = PipelineData.NumVariables;
+        ResLayout.Variables            = Variables.data();
+        ResLayout.NumImmutableSamplers = PipelineData.NumImmutableSamplers;
+        ResLayout.ImmutableSamplers    = ImtblSamplers.data();
+    };
+
+    const auto PipelineType = static_cast<PIPELINE_TYPE>(Rec.PipelineType);
+    if (PipelineType == PIPELINE_TYPE_COMPUTE)
+    {
+        ComputePipelineStateCreateInfo PSOCreateInfo;
+        InitCommon(PSOCreateInfo);
+        PSOCreateInfo.pCS = Shaders[ARCHIVE_SHADER_STAGE_CS];
+        pDevice->CreateComputePipelineState(PSOCreateInfo, ppPSO);
+    }
+    else if (PipelineType == PIPELINE_TYPE_GRAPHICS || PipelineType == PIPELINE_TYPE_MESH)
+    {
+        GraphicsPipelineStateCreateInfo PSOCreateInfo;
+        InitCommon(PSOCreateInfo);
+
+        auto& GrDesc             = PSOCreateInfo.GraphicsPipeline;
+        GrDesc.BlendDesc         = PipelineData.BlendDesc;
+        GrDesc.SampleMask        = PipelineData.SampleMask;
+        GrDesc.RasterizerDesc    = PipelineData.RasterizerDesc;
+        GrDesc.DepthStencilDesc  = PipelineData.DepthStencilDesc;
+        GrDesc.PrimitiveTopology = static_cast<PRIMITIVE_TOPOLOGY>(PipelineData.PrimitiveTopology);
+        GrDesc.NumViewports      = PipelineData.NumViewports;
+        GrDesc.NumRenderTargets  = PipelineData.NumRenderTargets;
+        GrDesc.DSVFormat         = static_cast<TEXTURE_FORMAT>(PipelineData.DSVFormat);
+        for (Uint32 rt = 0; rt < MAX_RENDER_TARGETS; ++rt)
+            GrDesc.RTVFormats[rt] = static_cast<TEXTURE_FORMAT>(PipelineData.RTVFormats[rt]);
+        GrDesc.SmplDesc.Count   = PipelineData.SampleCount;
+        GrDesc.SmplDesc.Quality = PipelineData.SampleQuality;
+        GrDesc.NodeMask         = PipelineData.NodeMask;
+
+        GrDesc.InputLayout.LayoutElements = LayoutElems.data();
+        GrDesc.InputLayout.NumElements    = PipelineData.NumLayoutElements;
+
+        PSOCreateInfo.pVS = Shaders[ARCHIVE_SHADER_STAGE_VS];
+        PSOCreateInfo.pPS = Shaders[ARCHIVE_SHADER_STAGE_PS];
+        PSOCreateInfo.pDS = Shaders[ARCHIVE_SHADER_STAGE_DS];
+        PSOCreateInfo.pHS = Shaders[ARCHIVE_SHADER_STAGE_HS];
+        PSOCreateInfo.pGS = Shaders[ARCHIVE_SHADER_STAGE_GS];
+        PSOCreateInfo.pAS = Shaders[ARCHIVE_SHADER_STAGE_AS];
+        PSOCreateInfo.pMS = Shaders[ARCHIVE_SHADER_STAGE_MS];
+        pDevice->CreateGraphicsPipelineState(PSOCreateInfo, ppPSO);
+    }
+    else
+    {
+        LOG_ERROR_MESSAGE("Pipeline '", Name, "' has unsupported pipeline type");
+    }
+}
+
+} // namespace Diligent
@@ -0,0 +1,200 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#include "ShaderSourceDependencyRecorder.hpp"
+
+#include <algorithm>
+
+#include "DataBlobImpl.hpp"
+#include "MemoryFileStream.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// 64-bit FNV-1a hash. Unlike std::hash, the result does not depend on the
+// standard library or the platform, so it can be stored persistently.
+constexpr Uint64 FNV1aOffsetBasis = 14695981039346656037ull;
+
+Uint64 FNV1a(Uint64 Hash, const void* pData, size_t Size)
+{
+    const auto* pByte = static_cast<const Uint8*>(pData);
+    for (size_t i = 0; i < Size; ++i)
+    {
+        Hash ^= pByte[i];
+        Hash *= 1099511628211ull;
+    }
+    return Hash;
+}
+
+Uint64 FNV1a(Uint64 Hash, Uint64 Value)
+{
+    // Hash the value byte by byte to get the same result regardless of the endianness
+    for (Uint32 i = 0; i < 8; ++i)
+    {
+        const auto Byte = static_cast<Uint8>(Value >> (i * 8));
+        Hash            = FNV1a(Hash, &Byte, 1);
+    }
+    return Hash;
+}
+
+} // namespace
+
+ShaderSourceDependencyRecorder::ShaderSourceDependencyRecorder(IReferenceCounters*              pRefCounters,
+                                                               IShaderSourceInputStreamFactory* pFactory) :
+    TBase{pRefCounters},
+    m_pFactory{pFactory}
+{
+    DEV_CHECK_ERR(m_pFactory, "Shader source stream factory must not be null");
+}
+
+void ShaderSourceDependencyRecorder::CreateInputStream(const Char* Name, IFileStream** ppStream)
+{
+    CreateInputStream2(Name, CREATE_SHADER_SOURCE_INPUT_STREAM_FLAG_NONE, ppStream);
+}
+
+void ShaderSourceDependencyRecorder::CreateInputStream2(const Char*                             Name,
+                                                        CREATE_SHADER_SOURCE_INPUT_STREAM_FLAGS Flags,
+                                                        IFileStream**                           ppStream)
+{
+    DEV_CHECK_ERR(Name != nullptr, "File name must not be null");
+    DEV_CHECK_ERR(ppStream != nullptr, "ppStream must not be null");
+    *ppStream = nullptr;
+
+    RefCntAutoPtr<IFileStream> pSrcStream;
+    m_pFactory->CreateInputStream2(Name, Flags, &pSrcStream);
+
+    Dependency Dep{Name, 0, 0, false};
+
+    RefCntAutoPtr<IDataBlob> pData;
+    if (pSrcStream)
+    {
+        // Read the entire file to compute the hash and return a memory stream
+        // that serves the data that has been hashed.
+        pData = MakeNewRCObj<DataBlobImpl>()(0);
+        pSrcStream->ReadBlob(pData);
+
+        Dep.ContentHash = ComputeContentHash(pData->GetConstDataPtr(), pData->GetSize());
+        Dep.Size        = pData->GetSize();
+        Dep.Found       = true;
+    }
+
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        auto it = std::lower_bound(m_Dependencies.begin(), m_Dependencies.end(), Dep,
+                                   [](const Dependency& lhs, const Dependency& rhs) {
+                                       return lhs.Name < rhs.Name;
+                                   });
+        if (it == m_Dependencies.end() || it->Name != Dep.Name)
+        {
+            m_Dependencies.emplace(it, std::move(Dep));
+        }
+        else if (!(*it == Dep))
+        {
+            // The file has been modified during the compilation. Keep the most recent version
+            // so that the next up-to-date check triggers recompilation.
+            LOG_WARNING_MESSAGE("Contents of shader source file '", it->Name, "' have changed during the shader compilation");
+            *it = std::move(Dep);
+        }
+    }
+
+    if (pData)
+    {
+        RefCntAutoPtr<MemoryFileStream> pMemStream{MakeNewRCObj<MemoryFileStream>()(pData)};
+        pMemStream->QueryInterface(IID_FileStream, reinterpret_cast<IObject**>(ppStream));
+    }
+}
+
+std::vector<ShaderSourceDependencyRecorder::Dependency> ShaderSourceDependencyRecorder::GetDependencies() const
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    return m_Dependencies;
+}
+
+size_t ShaderSourceDependencyRecorder::GetDependencyHash() const
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    return ComputeDependencyHash(m_Dependencies);
+}
+
+void ShaderSourceDependencyRecorder::Reset()
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    m_Dependencies.clear();
+}
+
+size_t ShaderSourceDependencyRecorder::ComputeDependencyHash(const std::vector<Dependency>& Dependencies)
+{
+    auto Hash = FNV1a(FNV1aOffsetBasis, Uint64{Dependencies.size()});
+    for (const auto& Dep : Dependencies)
+    {
+        // Include the terminating null character to separate the name from the next field
+        Hash = FNV1a(Hash, Dep.Name.c_str(), Dep.Name.length() + 1);
+        Hash = FNV1a(Hash, Uint64{Dep.ContentHash});
+        Hash = FNV1a(Hash, Uint64{Dep.Size});
+        Hash = FNV1a(Hash, Uint64{Dep.Found ? 1u : 0u});
+    }
+    return static_cast<size_t>(Hash);
+}
+
+bool ShaderSourceDependencyRecorder::AreDependenciesUpToDate(IShaderSourceInputStreamFactory* pFactory,
+                                                             const std::vector<Dependency>&   Dependencies)
+{
+    DEV_CHECK_ERR(pFactory != nullptr, "Shader source stream factory must not be null");
+
+    for (const auto& Dep : Dependencies)
+    {
+        RefCntAutoPtr<IFileStream> pStream;
+        pFactory->CreateInputStream2(Dep.Name.c_str(), CREATE_SHADER_SOURCE_INPUT_STREAM_FLAG_SILENT, &pStream);
+        if (!pStream)
+        {
+            if (Dep.Found)
+                return false;
+            continue;
+        }
+        if (!Dep.Found || pStream->GetSize() != Dep.Size)
+            return false;
+
+        RefCntAutoPtr<IDataBlob> pData{MakeNewRCObj<DataBlobImpl>()(0)};
+        pStream->ReadBlob(pData);
+        if (ComputeContentHash(pData->GetConstDataPtr(), pData->GetSize()) != Dep.ContentHash)
+            return false;
+    }
+
+    return true;
+}
+
+size_t ShaderSourceDependencyRecorder::ComputeContentHash(const void* pData, size_t Size)
+{
+    return static_cast<size_t>(FNV1a(FNV1aOffsetBasis, pData, Size));
+}
+
+} // namespace Diligent
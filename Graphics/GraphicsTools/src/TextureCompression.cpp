@@ -0,0 +1,981 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#include "pch.h"
+#include "TextureCompression.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define TC_USE_SSE2 1
+#endif
+
+#include "GraphicsAccessories.hpp"
+#include "GraphicsUtilities.h"
+#include "ThreadPool.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// Texels of a 4x4 block. Every channel is stored in a separate array, so
+// that four texels can be processed at once.
+struct BlockTexels
+{
+    alignas(16) float Ch[4][16];
+};
+
+struct EncoderSettings
+{
+    Uint32 NumPowerIterations = 0;
+    Uint32 MaxRefinements     = 0;
+    bool   ExhaustiveSearch   = false;
+
+    explicit EncoderSettings(TEXTURE_COMPRESSION_QUALITY Quality)
+    {
+        switch (Quality)
+        {
+            case TEXTURE_COMPRESSION_QUALITY_FAST:
+                NumPowerIterations = 3;
+                MaxRefinements     = 0;
+                break;
+
+            case TEXTURE_COMPRESSION_QUALITY_NORMAL:
+                NumPowerIterations = 6;
+                MaxRefinements     = 1;
+                break;
+
+            case TEXTURE_COMPRESSION_QUALITY_HIGH:
+                NumPowerIterations = 8;
+                MaxRefinements     = 8;
+                ExhaustiveSearch   = true;
+                break;
+
+            default:
+                UNEXPECTED("Unexpected compression quality");
+                NumPowerIterations = 6;
+                MaxRefinements     = 1;
+        }
+    }
+};
+
+struct SourceImage
+{
+    const Uint8* pData         = nullptr;
+    Uint32       Width         = 0;
+    Uint32       Height        = 0;
+    Uint32       Stride        = 0;
+    Uint32       NumComponents = 0;
+    bool         IsBGRA        = false;
+
+    void LoadBlock(Uint32 BlockX, Uint32 BlockY, BlockTexels& Block) const
+    {
+        for (Uint32 y = 0; y < 4; ++y)
+        {
+            const auto  Row  = std::min(BlockY * 4 + y, Height - 1);
+            const auto* pRow = pData + size_t{Row} * Stride;
+            for (Uint32 x = 0; x < 4; ++x)
+            {
+                const auto  Col    = std::min(BlockX * 4 + x, Width - 1);
+                const auto* pTexel = pRow + size_t{Col} * NumComponents;
+                const auto  i      = y * 4 + x;
+
+                Block.Ch[0][i] = pTexel[0];
+                Block.Ch[1][i] = NumComponents > 1 ? pTexel[1] : 0;
+                Block.Ch[2][i] = NumComponents > 2 ? pTexel[2] : 0;
+                Block.Ch[3][i] = NumComponents > 3 ? pTexel[3] : 255;
+                if (IsBGRA)
+                    std::swap(Block.Ch[0][i], Block.Ch[2][i]);
+            }
+        }
+    }
+};
+
+inline float Clamp255(float f)
+{
+    return std::min(std::max(f, 0.f), 255.f);
+}
+
+inline int RoundToInt(float f)
+{
+    return static_cast<int>(std::floor(f + 0.5f));
+}
+
+// Selects the nearest palette entry for every texel and returns the total squared error.
+// Only the first NumChannels channels of the block starting with pChannels are compared.
+float SelectIndices(const float (*pChannels)[16],
+                    Uint32 NumChannels,
+                    const float (*Palette)[4],
+                    Uint32 NumEntries,
+                    Uint8  Indices[16])
+{
+    float TotalError = 0;
+#if TC_USE_SSE2
+    for (Uint32 i = 0; i < 16; i += 4)
+    {
+        __m128  BestDist = _mm_set1_ps(FLT_MAX);
+        __m128i BestIdx  = _mm_setzero_si128();
+        for (Uint32 e = 0; e < NumEntries; ++e)
+        {
+            __m128 Dist = _mm_setzero_ps();
+            for (Uint32 c = 0; c < NumChannels; ++c)
+            {
+                const __m128 Diff = _mm_sub_ps(_mm_load_ps(&pChannels[c][i]), _mm_set1_ps(Palette[e][c]));
+                Dist              = _mm_add_ps(Dist, _mm_mul_ps(Diff, Diff));
+            }
+            const __m128i IsCloser = _mm_castps_si128(_mm_cmplt_ps(Dist, BestDist));
+
+            BestDist = _mm_min_ps(Dist, BestDist);
+            BestIdx  = _mm_or_si128(_mm_and_si128(IsCloser, _mm_set1_epi32(static_cast<int>(e))), _mm_andnot_si128(IsCloser, BestIdx));
+        }
+
+        alignas(16) Int32 Idx[4];
+        alignas(16) float Dist[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(Idx), BestIdx);
+        _mm_store_ps(Dist, BestDist);
+        for (Uint32 k = 0; k < 4; ++k)
+        {
+            Indices[i + k] = static_cast<Uint8>(Idx[k]);
+            TotalError += Dist[k];
+        }
+    }
+#else
+    for (Uint32 i = 0; i < 16; ++i)
+    {
+        float BestDist = FLT_MAX;
+        Uint8 BestIdx  = 0;
+        for (Uint32 e = 0; e < NumEntries; ++e)
+        {
+            float Dist = 0;
+            for (Uint32 c = 0; c < NumChannels; ++c)
+            {
+                const float Diff = pChannels[c][i] - Palette[e][c];
+                Dist += Diff * Diff;
+            }
+            if (Dist < BestDist)
+            {
+                BestDist = Dist;
+                BestIdx  = static_cast<Uint8>(e);
+            }
+        }
+        Indices[i] = BestIdx;
+        TotalError += BestDist;
+    }
+#endif
+    return TotalError;
+}
+
+// Computes the mean of the texels and the principal axis of their distribution
+void ComputePrincipalAxis(const float (*pChannels)[16],
+                          Uint32 NumChannels,
+                          Uint32 NumIterations,
+                          float  Mean[4],
+                          float  Axis[4])
+{
+    float Min[4] = {};
+    float Max[4] = {};
+    for (Uint32 c = 0; c < NumChannels; ++c)
+    {
+        Mean[c] = 0;
+        Min[c]  = FLT_MAX;
+        Max[c]  = -FLT_MAX;
+        for (Uint32 i = 0; i < 16; ++i)
+        {
+            Mean[c] += pChannels[c][i];
+            Min[c] = std::min(Min[c], pChannels[c][i]);
+            Max[c] = std::max(Max[c], pChannels[c][i]);
+        }
+        Mean[c] /= 16.f;
+    }
+
+    float Cov[4][4] = {};
+    for (Uint32 c0 = 0; c0 < NumChannels; ++c0)
+    {
+        for (Uint32 c1 = c0; c1 < NumChannels; ++c1)
+        {
+            float Sum = 0;
+            for (Uint32 i = 0; i < 16; ++i)
+                Sum += (pChannels[c0][i] - Mean[c0]) * (pChannels[c1][i] - Mean[c1]);
+            Cov[c0][c1] = Cov[c1][c0] = Sum;
+        }
+    }
+
+    // Power iteration starting from the bounding box diagonal
+    for (Uint32 c = 0; c < NumChannels; ++c)
+        Axis[c] = Max[c] - Min[c];
+
+    for (Uint32 it = 0; it < NumIterations; ++it)
+    {
+        float NewAxis[4] = {};
+        float MaxComp    = 0;
+        for (Uint32 c0 = 0; c0 < NumChannels; ++c0)
+        {
+            for (Uint32 c1 = 0; c1 < NumChannels; ++c1)
+                NewAxis[c0] += Cov[c0][c1] * Axis[c1];
+            MaxComp = std::max(MaxComp, std::abs(NewAxis[c0]));
+        }
+        if (MaxComp == 0)
+            break;
+        for (Uint32 c = 0; c < NumChannels; ++c)
+            Axis[c] = NewAxis[c] / MaxComp;
+    }
+
+    float LenSq = 0;
+    for (Uint32 c = 0; c < NumChannels; ++c)
+        LenSq += Axis[c] * Axis[c];
+    const float InvLen = LenSq > 0 ? 1.f / std::sqrt(LenSq) : 0.f;
+    for (Uint32 c = 0; c < NumChannels; ++c)
+        Axis[c] *= InvLen;
+}
+
+// Computes the endpoints as the extreme projections of the texels onto the principal axis
+void ComputeAxisEndpoints(const float (*pChannels)[16],
+                          Uint32 NumChannels,
+                          Uint32 NumPowerIterations,
+                          float  E0[4],
+                          float  E1[4])
+{
+    float Mean[4] = {};
+    float Axis[4] = {};
+    ComputePrincipalAxis(pChannels, NumChannels, NumPowerIterations, Mean, Axis);
+
+    float MinT = FLT_MAX;
+    float MaxT = -FLT_MAX;
+    for (Uint32 i = 0; i < 16; ++i)
+    {
+        float t = 0;
+        for (Uint32 c = 0; c < NumChannels; ++c)
+            t += (pChannels[c][i] - Mean[c]) * Axis[c];
+        MinT = std::min(MinT, t);
+        MaxT = std::max(MaxT, t);
+    }
+
+    for (Uint32 c = 0; c < NumChannels; ++c)
+    {
+        E0[c] = Clamp255(Mean[c] + Axis[c] * MinT);
+        E1[c] = Clamp255(Mean[c] + Axis[c] * MaxT);
+    }
+}
+
+// Finds the endpoints that minimize the squared error for the given indices.
+// IndexWeights[Idx] is the weight of the second endpoint for the palette entry Idx.
+bool FitEndpoints(const float (*pChannels)[16],
+                  Uint32       NumChannels,
+                  const Uint8  Indices[16],
+                  const float* IndexWeights,
+                  float        E0[4],
+                  float        E1[4])
+{
+    float A00 = 0, A01 = 0, A11 = 0;
+    float R0[4] = {};
+    float R1[4] = {};
+    for (Uint32 i = 0; i < 16; ++i)
+    {
+        const float w1 = IndexWeights[Indices[i]];
+        const float w0 = 1.f - w1;
+        A00 += w0 * w0;
+        A01 += w0 * w1;
+        A11 += w1 * w1;
+        for (Uint32 c = 0; c < NumChannels; ++c)
+        {
+            R0[c] += w0 * pChannels[c][i];
+            R1[c] += w1 * pChannels[c][i];
+        }
+    }
+
+    const float Det = A00 * A11 - A01 * A01;
+    if (std::abs(Det) < 1e-6f)
+        return false;
+
+    const float InvDet = 1.f / Det;
+    for (Uint32 c = 0; c < NumChannels; ++c)
+    {
+        E0[c] = Clamp255((R0[c] * A11 - R1[c] * A01) * InvDet);
+        E1[c] = Clamp255((R1[c] * A00 - R0[c] * A01) * InvDet);
+    }
+    return true;
+}
+
+class BitWriter
+{
+public:
+    explicit BitWriter(Uint8* pDst, size_t Size) :
+        m_pDst{pDst}
+    {
+        std::memset(pDst, 0, Size);
+    }
+
+    void Write(Uint32 Value, Uint32 NumBits)
+    {
+        for (Uint32 b = 0; b < NumBits; ++b, ++m_Pos)
+        {
+            if ((Value >> b) & 0x01u)
+                m_pDst[m_Pos >> 3] |= static_cast<Uint8>(1u << (m_Pos & 0x07u));
+        }
+    }
+
+    Uint32 GetPosition() const { return m_Pos; }
+
+private:
+    Uint8* const m_pDst;
+    Uint32       m_Pos = 0;
+};
+
+
+// ---------------------------------------------------------------------------------------------
+// BC1 color block
+
+inline Uint32 Expand5(Uint32 v) { return (v << 3) | (v >> 2); }
+inline Uint32 Expand6(Uint32 v) { return (v << 2) | (v >> 4); }
+
+Uint16 QuantizeRGB565(const float C[3])
+{
+    const auto r = static_cast<Uint32>(RoundToInt(Clamp255(C[0]) * 31.f / 255.f));
+    const auto g = static_cast<Uint32>(RoundToInt(Clamp255(C[1]) * 63.f / 255.f));
+    const auto b = static_cast<Uint32>(RoundToInt(Clamp255(C[2]) * 31.f / 255.f));
+    return static_cast<Uint16>((r << 11u) | (g << 5u) | b);
+}
+
+void BuildBC1Palette(Uint16 C0, Uint16 C1, float Palette[4][4])
+{
+    const Uint32 Endpoints[2][3] =
+        {
+            {Expand5(C0 >> 11u), Expand6((C0 >> 5u) & 0x3Fu), Expand5(C0 & 0x1Fu)},
+            {Expand5(C1 >> 11u), Expand6((C1 >> 5u) & 0x3Fu), Expand5(C1 & 0x1Fu)} //
+        };
+    for (Uint32 c = 0; c < 3; ++c)
+    {
+        const auto e0 = Endpoints[0][c];
+        const auto e1 = Endpoints[1][c];
+
+        Palette[0][c] = static_cast<float>(e0);
+        Palette[1][c] = static_cast<float>(e1);
+        Palette[2][c] = static_cast<float>((2 * e0 + e1 + 1) / 3);
+        Palette[3][c] = static_cast<float>((e0 + 2 * e1 + 1) / 3);
+    }
+}
+
+// Optimal 5- and 6-bit endpoint pairs that reproduce every 8-bit value as
+// the 2/3 * e0 + 1/3 * e1 interpolated palette entry.
+struct BC1SingleColorTables
+{
+    Uint8 Match5[256][2];
+    Uint8 Match6[256][2];
+
+    BC1SingleColorTables()
+    {
+        InitTable(Match5, 5);
+        InitTable(Match6, 6);
+    }
+
+private:
+    static void InitTable(Uint8 Table[256][2], Uint32 NumBits)
+    {
+        const Uint32 NumValues = 1u << NumBits;
+        for (int Value = 0; Value < 256; ++Value)
+        {
+            int BestErr = INT_MAX;
+            for (Uint32 v0 = 0; v0 < NumValues; ++v0)
+            {
+                const int e0 = static_cast<int>(NumBits == 5 ? Expand5(v0) : Expand6(v0));
+                for (Uint32 v1 = 0; v1 < NumValues; ++v1)
+                {
+                    const int e1 = static_cast<int>(NumBits == 5 ? Expand5(v1) : Expand6(v1));
+                    // Prefer close endpoints to reduce the impact of decoder rounding differences
+                    const int Err = std::abs((2 * e0 + e1 + 1) / 3 - Value) * 256 + std::abs(e0 - e1);
+                    if (Err < BestErr)
+                    {
+                        BestErr         = Err;
+                        Table[Value][0] = static_cast<Uint8>(v0);
+                        Table[Value][1] = static_cast<Uint8>(v1);
+                    }
+                }
+            }
+        }
+    }
+};
+
+void WriteBC1Block(Uint16 C0, Uint16 C1, Uint8 Indices[16], Uint8* pDst)
+{
+    if (C0 < C1)
+    {
+        // Make sure the block is decoded in four-color mode
+        static constexpr Uint8 SwappedIndex[] = {1, 0, 3, 2};
+        std::swap(C0, C1);
+        for (Uint32 i = 0; i < 16; ++i)
+            Indices[i] = SwappedIndex[Indices[i]];
+    }
+    else if (C0 == C1)
+    {
+        // Three-color mode: the third color is black
+        for (Uint32 i = 0; i < 16; ++i)
+            Indices[i] = 0;
+    }
+
+    Uint32 Bits = 0;
+    for (Uint32 i = 0; i < 16; ++i)
+        Bits |= Uint32{Indices[i]} << (i * 2);
+
+    pDst[0] = static_cast<Uint8>(C0 & 0xFFu);
+    pDst[1] = static_cast<Uint8>(C0 >> 8u);
+    pDst[2] = static_cast<Uint8>(C1 & 0xFFu);
+    pDst[3] = static_cast<Uint8>(C1 >> 8u);
+    for (Uint32 b = 0; b < 4; ++b)
+        pDst[4 + b] = static_cast<Uint8>((Bits >> (b * 8)) & 0xFFu);
+}
+
+void EncodeBC1ColorBlock(const BlockTexels& Block, const EncoderSettings& Settings, Uint8* pDst)
+{
+    const float(*pRGB)[16] = Block.Ch;
+
+    bool IsSingleColor = true;
+    for (Uint32 i = 1; i < 16 && IsSingleColor; ++i)
+        IsSingleColor = pRGB[0][i] == pRGB[0][0] && pRGB[1][i] == pRGB[1][0] && pRGB[2][i] == pRGB[2][0];
+
+    Uint8 Indices[16];
+    if (IsSingleColor)
+    {
+        static const BC1SingleColorTables Tables;
+
+        const auto r = static_cast<Uint32>(pRGB[0][0]);
+        const auto g = static_cast<Uint32>(pRGB[1][0]);
+        const auto b = static_cast<Uint32>(pRGB[2][0]);
+
+        const auto C0 = static_cast<Uint16>((Tables.Match5[r][0] << 11u) | (Tables.Match6[g][0] << 5u) | Tables.Match5[b][0]);
+        const auto C1 = static_cast<Uint16>((Tables.Match5[r][1] << 11u) | (Tables.Match6[g][1] << 5u) | Tables.Match5[b][1]);
+        for (Uint32 i = 0; i < 16; ++i)
+            Indices[i] = 2;
+        WriteBC1Block(C0, C1, Indices, pDst);
+        return;
+    }
+
+    float E0[4], E1[4];
+    ComputeAxisEndpoints(pRGB, 3, Settings.NumPowerIterations, E0, E1);
+
+    auto  C0 = QuantizeRGB565(E1);
+    auto  C1 = QuantizeRGB565(E0);
+    float Palette[4][4];
+    BuildBC1Palette(C0, C1, Palette);
+    auto BestError = SelectIndices(pRGB, 3, Palette, 4, Indices);
+
+    static constexpr float IndexWeights[] = {0.f, 1.f, 1.f / 3.f, 2.f / 3.f};
+    for (Uint32 r = 0; r < Settings.MaxRefinements && BestError > 0; ++r)
+    {
+        if (!FitEndpoints(pRGB, 3, Indices, IndexWeights, E0, E1))
+            break;
+
+        const auto NewC0 = QuantizeRGB565(E0);
+        const auto NewC1 = QuantizeRGB565(E1);
+        if (NewC0 == C0 && NewC1 == C1)
+            break;
+
+        Uint8 NewIndices[16];
+        BuildBC1Palette(NewC0, NewC1, Palette);
+        const auto Error = SelectIndices(pRGB, 3, Palette, 4, NewIndices);
+        if (Error >= BestError)
+            break;
+
+        BestError = Error;
+        C0        = NewC0;
+        C1        = NewC1;
+        std::memcpy(Indices, NewIndices, sizeof(Indices));
+    }
+
+    WriteBC1Block(C0, C1, Indices, pDst);
+}
+
+
+// ---------------------------------------------------------------------------------------------
+// BC4 single-channel block
+
+void BuildBC4Palette(Uint32 A0, Uint32 A1, float Palette[8][4])
+{
+    Palette[0][0] = static_cast<float>(A0);
+    Palette[1][0] = static_cast<float>(A1);
+    if (A0 > A1)
+    {
+        for (Uint32 i = 2; i < 8; ++i)
+            Palette[i][0] = static_cast<float>(((8 - i) * A0 + (i - 1) * A1 + 3) / 7);
+    }
+    else
+    {
+        for (Uint32 i = 2; i < 6; ++i)
+            Palette[i][0] = static_cast<float>(((6 - i) * A0 + (i - 1) * A1 + 2) / 5);
+        Palette[6][0] = 0;
+        Palette[7][0] = 255;
+    }
+}
+
+void WriteBC4Block(Uint32 A0, Uint32 A1, const Uint8 Indices[16], Uint8* pDst)
+{
+    pDst[0] = static_cast<Uint8>(A0);
+    pDst[1] = static_cast<Uint8>(A1);
+
+    Uint64 Bits = 0;
+    for (Uint32 i = 0; i < 16; ++i)
+        Bits |= Uint64{Indices[i]} << (i * 3);
+    for (Uint32 b = 0; b < 6; ++b)
+        pDst[2 + b] = static_cast<Uint8>((Bits >> (b * 8)) & 0xFFu);
+}
+
+void EncodeBC4Block(const float (*pChannel)[16], const EncoderSettings& Settings, Uint8* pDst)
+{
+    float Min = 255, Max = 0;
+    for (Uint32 i = 0; i < 16; ++i)
+    {
+        Min = std::min(Min, (*pChannel)[i]);
+        Max = std::max(Max, (*pChannel)[i]);
+    }
+
+    Uint8 Indices[16] = {};
+    if (Min == Max)
+    {
+        const auto A = static_cast<Uint32>(Min);
+        WriteBC4Block(A, A, Indices, pDst);
+        return;
+    }
+
+    // Eight-value mode (A0 > A1)
+    auto  A0 = static_cast<Uint32>(Max);
+    auto  A1 = static_cast<Uint32>(Min);
+    float Palette[8][4];
+    BuildBC4Palette(A0, A1, Palette);
+    auto BestError = SelectIndices(pChannel, 1, Palette, 8, Indices);
+
+    static constexpr float IndexWeights[] = {0.f, 1.f, 1.f / 7.f, 2.f / 7.f, 3.f / 7.f, 4.f / 7.f, 5.f / 7.f, 6.f / 7.f};
+    for (Uint32 r = 0; r < Settings.MaxRefinements && BestError > 0; ++r)
+    {
+        float E0[4], E1[4];
+        if (!FitEndpoints(pChannel, 1, Indices, IndexWeights, E0, E1))
+            break;
+
+        const auto NewA0 = static_cast<Uint32>(RoundToInt(E0[0]));
+        const auto NewA1 = static_cast<Uint32>(RoundToInt(E1[0]));
+        if (NewA0 <= NewA1 || (NewA0 == A0 && NewA1 == A1))
+            break;
+
+        Uint8 NewIndices[16];
+        BuildBC4Palette(NewA0, NewA1, Palette);
+        const auto Error = SelectIndices(pChannel, 1, Palette, 8, NewIndices);
+        if (Error >= BestError)
+            break;
+
+        BestError = Error;
+        A0        = NewA0;
+        A1        = NewA1;
+        std::memcpy(Indices, NewIndices, sizeof(Indices));
+    }
+
+    if (Settings.ExhaustiveSearch && BestError > 0)
+    {
+        // Six-value mode (A0 <= A1) with explicit 0 and 255 values works better
+        // for blocks that combine extreme values with a narrow range of other values.
+        float Min6 = 255, Max6 = 0;
+        for (Uint32 i = 0; i < 16; ++i)
+        {
+            const auto v = (*pChannel)[i];
+            if (v != 0 && v != 255)
+            {
+                Min6 = std::min(Min6, v);
+                Max6 = std::max(Max6, v);
+            }
+        }
+        if (Min6 > Max6)
+        {
+            Min6 = 0;
+            Max6 = 255;
+        }
+
+        const auto A0_6 = static_cast<Uint32>(Min6);
+        const auto A1_6 = static_cast<Uint32>(Max6);
+
+        Uint8 Indices6[16];
+        BuildBC4Palette(A0_6, A1_6, Palette);
+        const auto Error = SelectIndices(pChannel, 1, Palette, 8, Indices6);
+        if (Error < BestError)
+        {
+            A0 = A0_6;
+            A1 = A1_6;
+            std::memcpy(Indices, Indices6, sizeof(Indices));
+        }
+    }
+
+    WriteBC4Block(A0, A1, Indices, pDst);
+}
+
+
+// ---------------------------------------------------------------------------------------------
+// BC7 mode 6 block
+
+constexpr Uint32 BC7Weights4[] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+struct BC7Mode6Endpoint
+{
+    Uint32 Color[4]; // 7-bit components
+    Uint32 PBit;
+
+    Uint32 Value(Uint32 c) const
+    {
+        return (Color[c] << 1u) | PBit;
+    }
+};
+
+BC7Mode6Endpoint QuantizeBC7Mode6Endpoint(const float E[4], Uint32 PBit)
+{
+    BC7Mode6Endpoint Ep;
+    Ep.PBit = PBit;
+    for (Uint32 c = 0; c < 4; ++c)
+        Ep.Color[c] = static_cast<Uint32>(std::min(std::max(RoundToInt((E[c] - static_cast<float>(PBit)) * 0.5f), 0), 127));
+    return Ep;
+}
+
+float ComputeEndpointError(const BC7Mode6Endpoint& Ep, const float E[4])
+{
+    float Err = 0;
+    for (Uint32 c = 0; c < 4; ++c)
+    {
+        const float Diff = static_cast<float>(Ep.Value(c)) - E[c];
+        Err += Diff * Diff;
+    }
+    return Err;
+}
+
+// Quantizes the endpoint with the p-bit that gives the smallest quantization error
+BC7Mode6Endpoint QuantizeBC7Mode6Endpoint(const float E[4])
+{
+    const auto Ep0 = QuantizeBC7Mode6Endpoint(E, 0);
+    const auto Ep1 = QuantizeBC7Mode6Endpoint(E, 1);
+    return ComputeEndpointError(Ep0, E) <= ComputeEndpointError(Ep1, E) ? Ep0 : Ep1;
+}
+
+float EvaluateBC7Mode6(const BlockTexels& Block, const BC7Mode6Endpoint& Ep0, const BC7Mode6Endpoint& Ep1, Uint8 Indices[16])
+{
+    float Palette[16][4];
+    for (Uint32 i = 0; i < 16; ++i)
+    {
+        const auto w = BC7Weights4[i];
+        for (Uint32 c = 0; c < 4; ++c)
+            Palette[i][c] = static_cast<float>(((64 - w) * Ep0.Value(c) + w * Ep1.Value(c) + 32) >> 6u);
+    }
+    return SelectIndices(Block.Ch, 4, Palette, 16, Indices);
+}
+
+float FindBestBC7Mode6Endpoints(const BlockTexels&     Block,
+                                const EncoderSettings& Settings,
+                                const float            E0[4],
+                                const float            E1[4],
+                                BC7Mode6Endpoint&      Ep0,
+                                BC7Mode6Endpoint&      Ep1,
+                                Uint8                  Indices[16])
+{
+    if (!Settings.ExhaustiveSearch)
+    {
+        Ep0 = QuantizeBC7Mode6Endpoint(E0);
+        Ep1 = QuantizeBC7Mode6Endpoint(E1);
+        return EvaluateBC7Mode6(Block, Ep0, Ep1, Indices);
+    }
+
+    float BestError = FLT_MAX;
+    for (Uint32 p = 0; p < 4; ++p)
+    {
+        const auto TestEp0 = QuantizeBC7Mode6Endpoint(E0, p & 0x01u);
+        const auto TestEp1 = QuantizeBC7Mode6Endpoint(E1, p >> 1u);
+
+        Uint8      TestIndices[16];
+        const auto Error = EvaluateBC7Mode6(Block, TestEp0, TestEp1, TestIndices);
+        if (Error < BestError)
+        {
+            BestError = Error;
+            Ep0       = TestEp0;
+            Ep1       = TestEp1;
+            std::memcpy(Indices, TestIndices, sizeof(TestIndices));
+        }
+    }
+    return BestError;
+}
+
+void EncodeBC7Block(const BlockTexels& Block, const EncoderSettings& Settings, Uint8* pDst)
+{
+    float E0[4], E1[4];
+    ComputeAxisEndpoints(Block.Ch, 4, Settings.NumPowerIterations, E0, E1);
+
+    BC7Mode6Endpoint Ep0, Ep1;
+    Uint8            Indices[16];
+    auto             BestError = FindBestBC7Mode6Endpoints(Block, Settings, E0, E1, Ep0, Ep1, Indices);
+
+    static const auto IndexWeights = []() {
+        std::array<float, 16> Weights;
+        for (Uint32 i = 0; i < 16; ++i)
+            Weights[i] = static_cast<float>(BC7Weights4[i]) / 64.f;
+        return Weights;
+    }();
+    for (Uint32 r = 0; r < Settings.MaxRefinements && BestError > 0; ++r)
+    {
+        if (!FitEndpoints(Block.Ch, 4, Indices, IndexWeights.data(), E0, E1))
+            break;
+
+        BC7Mode6Endpoint NewEp0, NewEp1;
+        Uint8            NewIndices[16];
+        const auto       Error = FindBestBC7Mode6Endpoints(Block, Settings, E0, E1, NewEp0, NewEp1, NewIndices);
+        if (Error >= BestError)
+            break;
+
+        BestError = Error;
+        Ep0       = NewEp0;
+        Ep1       = NewEp1;
+        std::memcpy(Indices, NewIndices, sizeof(Indices));
+    }
+
+    // The most significant bit of the first (anchor) index is implicitly zero
+    if (Indices[0] & 0x08u)
+    {
+        std::swap(Ep0, Ep1);
+        for (Uint32 i = 0; i < 16; ++i)
+            Indices[i] = static_cast<Uint8>(15 - Indices[i]);
+    }
+
+    BitWriter Writer{pDst, 16};
+    Writer.Write(1u << 6u, 7); // Mode 6
+    for (Uint32 c = 0; c < 4; ++c)
+    {
+        Writer.Write(Ep0.Color[c], 7);
+        Writer.Write(Ep1.Color[c], 7);
+    }
+    Writer.Write(Ep0.PBit, 1);
+    Writer.Write(Ep1.PBit, 1);
+    Writer.Write(Indices[0], 3);
+    for (Uint32 i = 1; i < 16; ++i)
+        Writer.Write(Indices[i], 4);
+    VERIFY_EXPR(Writer.GetPosition() == 128);
+}
+
+
+void EncodeBlock(TEXTURE_FORMAT Format, const BlockTexels& Block, const EncoderSettings& Settings, Uint8* pDst)
+{
+    switch (Format)
+    {
+        case TEX_FORMAT_BC1_UNORM:
+        case TEX_FORMAT_BC1_UNORM_SRGB:
+            EncodeBC1ColorBlock(Block, Settings, pDst);
+            break;
+
+        case TEX_FORMAT_BC3_UNORM:
+        case TEX_FORMAT_BC3_UNORM_SRGB:
+            EncodeBC4Block(&Block.Ch[3], Settings, pDst);
+            EncodeBC1ColorBlock(Block, Settings, pDst + 8);
+            break;
+
+        case TEX_FORMAT_BC4_UNORM:
+            EncodeBC4Block(&Block.Ch[0], Settings, pDst);
+            break;
+
+        case TEX_FORMAT_BC5_UNORM:
+            EncodeBC4Block(&Block.Ch[0], Settings, pDst);
+            EncodeBC4Block(&Block.Ch[1], Settings, pDst + 8);
+            break;
+
+        case TEX_FORMAT_BC7_UNORM:
+        case TEX_FORMAT_BC7_UNORM_SRGB:
+            EncodeBC7Block(Block, Settings, pDst);
+            break;
+
+        default:
+            UNEXPECTED("Unexpected format");
+    }
+}
+
+} // namespace
+
+
+bool IsTextureCompressionSupported(TEXTURE_FORMAT Format)
+{
+    switch (Format)
+    {
+        case TEX_FORMAT_BC1_UNORM:
+        case TEX_FORMAT_BC1_UNORM_SRGB:
+        case TEX_FORMAT_BC3_UNORM:
+        case TEX_FORMAT_BC3_UNORM_SRGB:
+        case TEX_FORMAT_BC4_UNORM:
+        case TEX_FORMAT_BC5_UNORM:
+        case TEX_FORMAT_BC7_UNORM:
+        case TEX_FORMAT_BC7_UNORM_SRGB:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+void CompressTextureData(Uint32                           Width,
+                         Uint32                           Height,
+                         TEXTURE_FORMAT                   SrcFormat,
+                         const void*                      pSrcData,
+                         Uint32                           SrcStride,
+                         void*                            pDstData,
+                         Uint32                           DstStride,
+                         const TextureCompressionAttribs& Attribs)
+{
+    if (!IsTextureCompressionSupported(Attribs.DstFormat))
+    {
+        LOG_ERROR_MESSAGE("Compression to format ", GetTextureFormatAttribs(Attribs.DstFormat).Name, " is not supported");
+        return;
+    }
+
+    const auto& SrcFmtAttribs = GetTextureFormatAttribs(SrcFormat);
+    if (SrcFmtAttribs.ComponentSize != 1 ||
+        (SrcFmtAttribs.ComponentType != COMPONENT_TYPE_UNORM && SrcFmtAttribs.ComponentType != COMPONENT_TYPE_UNORM_SRGB) ||
+        (SrcFmtAttribs.NumComponents != 1 && SrcFmtAttribs.NumComponents != 2 && SrcFmtAttribs.NumComponents != 4))
+    {
+        LOG_ERROR_MESSAGE("Source format ", SrcFmtAttribs.Name, " is not supported. Only 8-bit UNORM formats with one, two or four components are allowed.");
+        return;
+    }
+
+    if (Width == 0 || Height == 0)
+        return;
+
+    const auto& DstFmtAttribs = GetTextureFormatAttribs(Attribs.DstFormat);
+
+    const auto NumBlocksX = (Width + 3) / 4;
+    const auto NumBlocksY = (Height + 3) / 4;
+    const auto BlockSize  = Uint32{DstFmtAttribs.ComponentSize};
+
+    DEV_CHECK_ERR(pSrcData != nullptr, "Source data must not be null");
+    DEV_CHECK_ERR(pDstData != nullptr, "Destination data must not be null");
+    DEV_CHECK_ERR(Height == 1 || SrcStride >= Width * SrcFmtAttribs.NumComponents, "Source stride is too small");
+    DEV_CHECK_ERR(NumBlocksY == 1 || DstStride >= NumBlocksX * BlockSize, "Destination stride is too small");
+
+    SourceImage Src;
+    Src.pData         = static_cast<const Uint8*>(pSrcData);
+    Src.Width         = Width;
+    Src.Height        = Height;
+    Src.Stride        = SrcStride;
+    Src.NumComponents = SrcFmtAttribs.NumComponents;
+    Src.IsBGRA        = SrcFormat == TEX_FORMAT_BGRA8_UNORM || SrcFormat == TEX_FORMAT_BGRA8_UNORM_SRGB;
+
+    const EncoderSettings Settings{Attribs.Quality};
+
+    auto CompressBlockRow = [&](Uint32 BlockY) //
+    {
+        auto* pDstRow = static_cast<Uint8*>(pDstData) + size_t{BlockY} * DstStride;
+
+        BlockTexels Block;
+        for (Uint32 BlockX = 0; BlockX < NumBlocksX; ++BlockX)
+        {
+            Src.LoadBlock(BlockX, BlockY, Block);
+            EncodeBlock(Attribs.DstFormat, Block, Settings, pDstRow + size_t{BlockX} * BlockSize);
+        }
+    };
+
+    if (Attribs.pThreadPool != nullptr && NumBlocksY > 1)
+    {
+        VERIFY(Attribs.pThreadPool->GetCurrentThreadId() == ~0u, "Texture data must not be compressed from a worker thread of the pool");
+        for (Uint32 BlockY = 0; BlockY < NumBlocksY; ++BlockY)
+        {
+            Attribs.pThreadPool->EnqueueTask([&CompressBlockRow, BlockY](Uint32) //
+                                             {
+                                                 CompressBlockRow(BlockY);
+                                             });
+        }
+        Attribs.pThreadPool->WaitForAllTasks();
+    }
+    else
+    {
+        for (Uint32 BlockY = 0; BlockY < NumBlocksY; ++BlockY)
+            CompressBlockRow(BlockY);
+    }
+}
+
+void CompressMipChain(Uint32                           Width,
+                      Uint32                           Height,
+                      TEXTURE_FORMAT                   SrcFormat,
+                      const void*                      pSrcData,
+                      Uint32                           SrcStride,
+                      Uint32                           NumMipLevels,
+                      const TextureCompressionAttribs& Attribs,
+                      std::vector<CompressedMipLevel>& MipLevels)
+{
+    MipLevels.clear();
+    if (!IsTextureCompressionSupported(Attribs.DstFormat))
+    {
+        LOG_ERROR_MESSAGE("Compression to format ", GetTextureFormatAttribs(Attribs.DstFormat).Name, " is not supported");
+        return;
+    }
+
+    const auto MaxMipLevels = ComputeMipLevelsCount(Width, Height);
+    NumMipLevels            = NumMipLevels == 0 ? MaxMipLevels : std::min(NumMipLevels, MaxMipLevels);
+
+    TextureDesc TexDesc;
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width     = Width;
+    TexDesc.Height    = Height;
+    TexDesc.Format    = Attribs.DstFormat;
+    TexDesc.MipLevels = NumMipLevels;
+
+    const auto& SrcFmtAttribs = GetTextureFormatAttribs(SrcFormat);
+    const auto  TexelSize     = Uint32{SrcFmtAttribs.ComponentSize} * Uint32{SrcFmtAttribs.NumComponents};
+
+    std::vector<Uint8> FineLevel, CoarseLevel;
+
+    const void* pLevelData  = pSrcData;
+    Uint32      LevelStride = SrcStride;
+    MipLevels.resize(NumMipLevels);
+    for (Uint32 Mip = 0; Mip < NumMipLevels; ++Mip)
+    {
+        const auto MipProps = GetMipLevelProperties(TexDesc, Mip);
+
+        auto& Level  = MipLevels[Mip];
+        Level.Width  = MipProps.LogicalWidth;
+        Level.Height = MipProps.LogicalHeight;
+        Level.Stride = MipProps.RowSize;
+        Level.Data.resize(MipProps.MipSize);
+        CompressTextureData(Level.Width, Level.Height, SrcFormat, pLevelData, LevelStride, Level.Data.data(), Level.Stride, Attribs);
+
+        if (Mip + 1 < NumMipLevels)
+        {
+            const auto CoarseWidth  = std::max(Level.Width / 2u, 1u);
+            const auto CoarseHeight = std::max(Level.Height / 2u, 1u);
+            const auto CoarseStride = CoarseWidth * TexelSize;
+            CoarseLevel.resize(size_t{CoarseStride} * CoarseHeight);
+            ComputeMipLevel(Level.Width, Level.Height, SrcFormat, pLevelData, LevelStride, CoarseLevel.data(), CoarseStride);
+
+            std::swap(FineLevel, CoarseLevel);
+            pLevelData  = FineLevel.data();
+            LevelStride = CoarseStride;
+        }
+    }
+}
+
+} // namespace Diligent
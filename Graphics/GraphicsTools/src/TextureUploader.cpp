@@ -26,6 +26,13 @@
  */
 
 #include "pch.h"
+#include "TextureUploader.hpp"
+
+#include <algorithm>
+
+#include "TextureFormatConversion.hpp"
+#include "DebugUtilities.hpp"
+
 #if D3D11_SUPPORTED
 #    include "TextureUploaderD3D11.hpp"
 #endif
@@ -73,4 +80,42 @@ void CreateTextureUploader(IRenderDevice* pDevice, const TextureUploaderDesc& De
         (*ppUploader)->AddRef();
 }
 
+bool WriteUploadBufferData(IUploadBuffer* pUploadBuffer,
+                           Uint32         Mip,
+                           Uint32         Slice,
+                           TEXTURE_FORMAT SrcFormat,
+                           const void*    pSrcData,
+                           Uint32         SrcStride,
+                           Uint32         SrcDepthStride,
+                           ThreadPool*    pThreadPool)
+{
+    DEV_CHECK_ERR(pUploadBuffer != nullptr, "Upload buffer must not be null");
+
+    const auto& Desc = pUploadBuffer->GetDesc();
+    DEV_CHECK_ERR(Mip < Desc.MipLevels, "Mip level ", Mip, " is out of range");
+    DEV_CHECK_ERR(Slice < Desc.ArraySize, "Array slice ", Slice, " is out of range");
+
+    const auto MappedData = pUploadBuffer->GetMappedData(Mip, Slice);
+    if (MappedData.pData == nullptr)
+    {
+        LOG_ERROR_MESSAGE("Upload buffer subresource is not mapped");
+        return false;
+    }
+
+    const auto Width  = std::max(Desc.Width >> Mip, 1u);
+    const auto Height = std::max(Desc.Height >> Mip, 1u);
+    const auto Depth  = std::max(Desc.Depth >> Mip, 1u);
+    DEV_CHECK_ERR(Depth == 1 || SrcDepthStride != 0, "Source depth stride must not be zero for 3D upload buffers");
+
+    for (Uint32 z = 0; z < Depth; ++z)
+    {
+        const auto* pSrc = static_cast<const Uint8*>(pSrcData) + size_t{z} * SrcDepthStride;
+        auto*       pDst = static_cast<Uint8*>(MappedData.pData) + size_t{z} * MappedData.DepthStride;
+        if (!ConvertTextureData(Width, Height, SrcFormat, pSrc, SrcStride, Desc.Format, pDst, MappedData.Stride, pThreadPool))
+            return false;
+    }
+
+    return true;
+}
+
 } // namespace Diligent
@@ -34,6 +34,10 @@
 #include "ThreadSignal.hpp"
 #include "GraphicsAccessories.hpp"
 
+#if VULKAN_SUPPORTED
+#    include "../../GraphicsEngineVulkan/interface/RenderDeviceVk.h"
+#endif
+
 namespace Diligent
 {
 
@@ -259,7 +263,8 @@ struct TextureUploaderD3D12_Vk::InternalData
         return static_cast<Uint32>(m_PendingOperations.size());
     }
 
-    void Execute(IDeviceContext* pContext, PendingBufferOperation& OperationInfo);
+    // If pCopies is not null, copy commands are added to the array instead of being executed through the context
+    void Execute(IDeviceContext* pContext, PendingBufferOperation& OperationInfo, std::vector<CopyTextureAttribs>* pCopies);
 
 private:
     std::mutex                          m_PendingOperationsMtx;
@@ -297,14 +302,34 @@ void TextureUploaderD3D12_Vk::RenderThreadUpdate(IDeviceContext* pContext)
     auto& InWorkOperations = m_pInternalData->SwapMapQueues();
     if (!InWorkOperations.empty())
     {
+#if VULKAN_SUPPORTED
+        // In Vulkan, copies are executed on the dedicated transfer queue when the device has one
+        RefCntAutoPtr<IRenderDeviceVk>  pDeviceVk{m_pDevice, IID_RenderDeviceVk};
+        std::vector<CopyTextureAttribs> TransferQueueCopies;
+        auto*                           pCopies = pDeviceVk ? &TransferQueueCopies : nullptr;
+#else
+        std::vector<CopyTextureAttribs>* pCopies = nullptr;
+#endif
+
         Uint32 NumCopyOperations = 0;
         for (auto& OperationInfo : InWorkOperations)
         {
-            m_pInternalData->Execute(pContext, OperationInfo);
+            m_pInternalData->Execute(pContext, OperationInfo, pCopies);
             if (OperationInfo.operation == InternalData::PendingBufferOperation::Copy)
                 ++NumCopyOperations;
         }
 
+#if VULKAN_SUPPORTED
+        if (!TransferQueueCopies.empty())
+        {
+            if (!pDeviceVk->CopyTexturesOnTransferQueue(pContext, TransferQueueCopies.data(), static_cast<Uint32>(TransferQueueCopies.size())))
+            {
+                for (const auto& CopyInfo : TransferQueueCopies)
+                    pContext->CopyTexture(CopyInfo);
+            }
+        }
+#endif
+
         if (NumCopyOperations > 0)
         {
             // The buffer may be recycled immediately after the copy scheduled is signaled,
@@ -326,8 +351,9 @@ void TextureUploaderD3D12_Vk::RenderThreadUpdate(IDeviceContext* pContext)
 }
 
 
-void TextureUploaderD3D12_Vk::InternalData::Execute(IDeviceContext*         pContext,
-                                                    PendingBufferOperation& OperationInfo)
+void TextureUploaderD3D12_Vk::InternalData::Execute(IDeviceContext*                  pContext,
+                                                    PendingBufferOperation&          OperationInfo,
+                                                    std::vector<CopyTextureAttribs>* pCopies)
 {
     auto&       pUploadTex     = OperationInfo.pUploadTexture;
     const auto& StagingTexDesc = pUploadTex->GetDesc();
@@ -367,7 +393,10 @@ void TextureUploaderD3D12_Vk::InternalData::Execute(IDeviceContext*         pCon
                     CopyInfo.SrcSlice    = Slice;
                     CopyInfo.DstMipLevel = OperationInfo.DstMip + Mip;
                     CopyInfo.DstSlice    = OperationInfo.DstSlice + Slice;
-                    pContext->CopyTexture(CopyInfo);
+                    if (pCopies != nullptr)
+                        pCopies->push_back(CopyInfo);
+                    else
+                        pContext->CopyTexture(CopyInfo);
                 }
             }
         }
@@ -0,0 +1,854 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+// Command-line tool that compiles shader permutations listed in a manifest file
+// and packs them into a shader archive (see ShaderArchive.hpp).
+//
+// Usage:
+//   DiligentShaderArchiver -t <spirv|glsl|gles|dxil> -o <archive> [-I <dir>]... [-c <glslang|dxc>] [-j <threads>] [-v] <manifest>
+//
+// Shaders are compiled in parallel by the shader compilation service; -j sets the number
+// of compiler threads (all hardware threads by default). Identical permutations are compiled once.
+//
+// Manifest is a text file with one entry per line. Empty lines and lines that start with '#' are ignored.
+//
+//   shader <name> <vs|ps|gs|hs|ds|cs|as|ms> <file> [entry=<entry>] [lang=<hlsl|glsl>] [combined_samplers=<suffix>] [-D<macro>=<value>]...
+//
+//     Adds one shader permutation. Permutations of the same shader are added by
+//     repeating the line with a different set of macros.
+//
+//   compute <name> cs=<ref> [default_var=<static|mutable|dynamic>] [var=<name>:<type>]... [sampler=<name>:<preset>]...
+//   graphics <name> vs=<ref> [ps=<ref>] [gs=<ref>] [hs=<ref>] [ds=<ref>] [as=<ref>] [ms=<ref>]
+//            [rtv=<format>[,<format>]...] [dsv=<format>] [topology=<triangle_list|triangle_strip|line_list|line_strip|point_list>]
+//            [cull=<none|front|back>] [depth=<0|1>] [depth_write=<0|1>] [attrib=<slot>,<components>,<value type>[,norm]]...
+//            [default_var=...] [var=...]... [sampler=...]...
+//
+//     Adds the pipeline. Shader reference <ref> has the form <name>[:<macro>=<value>[,<macro>=<value>]...].
+//     Texture formats use engine names, e.g. TEX_FORMAT_RGBA8_UNORM_SRGB. Value types are
+//     float32, float16, int8, int16, int32, uint8, uint16, uint32. Immutable sampler presets
+//     are linear_clamp, linear_wrap, point_clamp, point_wrap and aniso4x_wrap.
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ShaderArchive.hpp"
+#include "CommonlyUsedStates.h"
+#include "DefaultShaderSourceStreamFactory.h"
+#include "DefaultRawMemoryAllocator.hpp"
+#include "GraphicsAccessories.hpp"
+#include "RefCntAutoPtr.hpp"
+#include "DataBlobImpl.hpp"
+#include "DebugUtilities.hpp"
+#include "ShaderCompilationService.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+struct ArchiverOptions
+{
+    SHADER_ARCHIVE_TARGET Target = SHADER_ARCHIVE_TARGET_UNKNOWN;
+
+    bool   IsGLES     = false;
+    bool   UseDXC     = false;
+    bool   Verbose    = false;
+    Uint32 NumThreads = 0;
+
+    std::string OutputPath;
+    std::string ManifestPath;
+    std::string SearchDirectories;
+};
+
+void PrintUsage()
+{
+    std::cout << "Usage: DiligentShaderArchiver -t <spirv|glsl|gles|dxil> -o <archive> [-I <dir>]... [-c <glslang|dxc>] [-j <threads>] [-v] <manifest>\n"
+                 "See the header of ShaderArchiver.cpp for the manifest format.\n";
+}
+
+std::vector<std::string> SplitString(const std::string& Str, char Separator)
+{
+    std::vector<std::string> Parts;
+    std::stringstream        ss{Str};
+    std::string              Part;
+    while (std::getline(ss, Part, Separator))
+    {
+        if (!Part.empty())
+            Parts.push_back(Part);
+    }
+    return Parts;
+}
+
+// Parses "<key>=<value>" token
+bool ParseKeyValue(const std::string& Token, std::string& Key, std::string& Value)
+{
+    auto EqPos = Token.find('=');
+    if (EqPos == std::string::npos)
+        return false;
+    Key   = Token.substr(0, EqPos);
+    Value = Token.substr(EqPos + 1);
+    return true;
+}
+
+// Owns the macro strings and keeps the null-terminated macro array
+class MacroList
+{
+public:
+    void Add(const std::string& Name, const std::string& Definition)
+    {
+        m_Names.push_back(Name);
+        m_Definitions.push_back(Definition);
+    }
+
+    const ShaderMacro* Get()
+    {
+        m_Macros.clear();
+        for (size_t i = 0; i < m_Names.size(); ++i)
+            m_Macros.emplace_back(m_Names[i].c_str(), m_Definitions[i].c_str());
+        m_Macros.emplace_back(nullptr, nullptr);
+        return m_Macros.data();
+    }
+
+private:
+    std::vector<std::string> m_Names;
+    std::vector<std::string> m_Definitions;
+    std::vector<ShaderMacro> m_Macros;
+};
+
+SHADER_TYPE ParseShaderType(const std::string& Str)
+{
+    // clang-format off
+    if (Str == "vs") return SHADER_TYPE_VERTEX;
+    if (Str == "ps") return SHADER_TYPE_PIXEL;
+    if (Str == "gs") return SHADER_TYPE_GEOMETRY;
+    if (Str == "hs") return SHADER_TYPE_HULL;
+    if (Str == "ds") return SHADER_TYPE_DOMAIN;
+    if (Str == "cs") return SHADER_TYPE_COMPUTE;
+    if (Str == "as") return SHADER_TYPE_AMPLIFICATION;
+    if (Str == "ms") return SHADER_TYPE_MESH;
+    // clang-format on
+    return SHADER_TYPE_UNKNOWN;
+}
+
+bool ParseTextureFormat(const std::string& Str, TEXTURE_FORMAT& Format)
+{
+    for (Uint32 fmt = TEX_FORMAT_UNKNOWN + 1; fmt < TEX_FORMAT_NUM_FORMATS; ++fmt)
+    {
+        const auto& FmtAttribs = GetTextureFormatAttribs(static_cast<TEXTURE_FORMAT>(fmt));
+        if (Str == FmtAttribs.Name)
+        {
+            Format = static_cast<TEXTURE_FORMAT>(fmt);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ParseValueType(const std::string& Str, VALUE_TYPE& Type)
+{
+    // clang-format off
+    if      (Str == "float32") Type = VT_FLOAT32;
+    else if (Str == "float16") Type = VT_FLOAT16;
+    else if (Str == "int8")    Type = VT_INT8;
+    else if (Str == "int16")   Type = VT_INT16;
+    else if (Str == "int32")   Type = VT_INT32;
+    else if (Str == "uint8")   Type = VT_UINT8;
+    else if (Str == "uint16")  Type = VT_UINT16;
+    else if (Str == "uint32")  Type = VT_UINT32;
+    else return false;
+    // clang-format on
+    return true;
+}
+
+bool ParseVariableType(const std::string& Str, SHADER_RESOURCE_VARIABLE_TYPE& Type)
+{
+    // clang-format off
+    if      (Str == "static")  Type = SHADER_RESOURCE_VARIABLE_TYPE_STATIC;
+    else if (Str == "mutable") Type = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE;
+    else if (Str == "dynamic") Type = SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC;
+    else return false;
+    // clang-format on
+    return true;
+}
+
+bool ParseSamplerPreset(const std::string& Str, SamplerDesc& Desc)
+{
+    // clang-format off
+    if      (Str == "linear_clamp") Desc = Sam_LinearClamp;
+    else if (Str == "linear_wrap")  Desc = Sam_LinearWrap;
+    else if (Str == "point_clamp")  Desc = Sam_PointClamp;
+    else if (Str == "point_wrap")   Desc = Sam_PointWrap;
+    else if (Str == "aniso4x_wrap") Desc = Sam_Aniso4xWrap;
+    else return false;
+    // clang-format on
+    return true;
+}
+
+class ShaderArchiver
+{
+public:
+    explicit ShaderArchiver(const ArchiverOptions& Options) :
+        m_Options{Options},
+        m_Writer{Options.Target}
+    {
+        CreateDefaultShaderSourceStreamFactory(m_Options.SearchDirectories.c_str(), &m_pStreamFactory);
+
+        ShaderCompilationServiceCreateInfo ServiceCI;
+        ServiceCI.NumThreads              = m_Options.NumThreads;
+        ServiceCI.SerializeSPIRVResources = true;
+        if (m_Options.IsGLES)
+        {
+            // The source is built for the device with the typical set of features;
+            // platform definitions match the host platform.
+            ServiceCI.GLSLDeviceCaps.DevType      = RENDER_DEVICE_TYPE_GLES;
+            ServiceCI.GLSLDeviceCaps.MajorVersion = 3;
+            ServiceCI.GLSLDeviceCaps.MinorVersion = 2;
+        }
+        ServiceCI.ResultCallback = [this](const ShaderCompilationResult& Result) {
+            // Callbacks are never called concurrently
+            if (Result.JobId >= m_Results.size())
+                m_Results.resize(Result.JobId + 1);
+            m_Results[Result.JobId] = Result;
+
+            if (m_Options.Verbose)
+            {
+                std::lock_guard<std::mutex> Lock{m_PendingShadersMtx};
+
+                const auto& Shader = m_PendingShaders[Result.JobId];
+                std::cout << (Result.Succeeded ? "Compiled " : "Failed to compile ") << GetShaderTypeLiteralName(Shader.Type) << " '" << Shader.Name << "'"
+                          << (Result.IsDuplicate ? " (duplicate)" : "") << '\n';
+            }
+        };
+        m_pService.reset(new ShaderCompilationService{ServiceCI});
+    }
+
+    bool ProcessManifest(std::istream& Manifest)
+    {
+        std::string Line;
+        Uint32      LineNumber = 0;
+        bool        Success    = true;
+        while (std::getline(Manifest, Line))
+        {
+            ++LineNumber;
+            std::replace(Line.begin(), Line.end(), '\t', ' ');
+            std::replace(Line.begin(), Line.end(), '\r', ' ');
+            auto Tokens = SplitString(Line, ' ');
+            if (Tokens.empty() || Tokens[0][0] == '#')
+                continue;
+
+            bool LineProcessed = false;
+            if (Tokens[0] == "shader")
+                LineProcessed = ProcessShader(Tokens);
+            else if (Tokens[0] == "compute" || Tokens[0] == "graphics")
+                LineProcessed = ProcessPipeline(Tokens);
+            else
+                LOG_ERROR_MESSAGE("Unknown manifest entry '", Tokens[0], "'");
+
+            if (!LineProcessed)
+            {
+                LOG_ERROR_MESSAGE(m_Options.ManifestPath, '(', LineNumber, "): failed to process the manifest entry");
+                Success = false;
+            }
+        }
+        return Success;
+    }
+
+    // Waits for all shaders to compile and adds them to the archive
+    bool FinishShaders()
+    {
+        m_pService->WaitForCompletion();
+
+        bool Success = true;
+        for (size_t i = 0; i < m_PendingShaders.size(); ++i)
+        {
+            auto&       Shader = m_PendingShaders[i];
+            const auto& Result = m_Results[i];
+            if (!Result.Succeeded)
+            {
+                if (Result.pCompilerOutput)
+                    std::cerr << static_cast<const char*>(Result.pCompilerOutput->GetConstDataPtr()) << '\n';
+                LOG_ERROR_MESSAGE("Failed to compile shader '", Shader.Name, "'");
+                Success = false;
+                continue;
+            }
+
+            ShaderArchiveWriter::ShaderData Data;
+            Data.Name                       = Shader.Name.c_str();
+            Data.Macros                     = Shader.Macros.Get();
+            Data.ShaderType                 = Shader.Type;
+            Data.EntryPoint                 = Shader.EntryPoint.c_str();
+            Data.UseCombinedTextureSamplers = !Shader.CombinedSamplerSuffix.empty();
+            Data.CombinedSamplerSuffix      = Data.UseCombinedTextureSamplers ? Shader.CombinedSamplerSuffix.c_str() : nullptr;
+            Data.pByteCode                  = Result.pByteCode->GetConstDataPtr();
+            Data.ByteCodeSize               = Result.pByteCode->GetSize();
+            if (m_Options.Target == SHADER_ARCHIVE_TARGET_GLSL)
+            {
+                // Null terminator is added by the writer
+                --Data.ByteCodeSize;
+            }
+            if (Result.pResources)
+            {
+                Data.pResources    = Result.pResources->GetConstDataPtr();
+                Data.ResourcesSize = Result.pResources->GetSize();
+            }
+            if (!m_Writer.AddShader(Data))
+                Success = false;
+        }
+
+        const auto Stats = m_pService->GetStats();
+        std::cout << "Compiled " << Stats.NumUniqueJobs << " unique shader permutation(s) out of " << Stats.NumJobs << " in " << Stats.ElapsedTime
+                  << " s (" << Stats.TotalCompileTime << " s of compilation time), " << Stats.NumFailedJobs << " failed\n";
+
+        return Success;
+    }
+
+    bool Save() const
+    {
+        RefCntAutoPtr<IDataBlob> pArchive;
+        if (!m_Writer.Serialize(&pArchive))
+            return false;
+
+        std::ofstream Output{m_Options.OutputPath, std::ios::binary};
+        if (!Output)
+        {
+            LOG_ERROR_MESSAGE("Failed to open output file '", m_Options.OutputPath, "'");
+            return false;
+        }
+        Output.write(static_cast<const char*>(pArchive->GetDataPtr()), static_cast<std::streamsize>(pArchive->GetSize()));
+        if (!Output)
+        {
+            LOG_ERROR_MESSAGE("Failed to write output file '", m_Options.OutputPath, "'");
+            return false;
+        }
+
+        std::cout << "Archived " << m_Writer.GetShaderCount() << " shader permutation(s) and " << m_Writer.GetPipelineCount()
+                  << " pipeline(s) to " << m_Options.OutputPath << " (" << pArchive->GetSize() << " bytes)\n";
+        return true;
+    }
+
+private:
+    bool ProcessShader(const std::vector<std::string>& Tokens)
+    {
+        if (Tokens.size() < 4)
+        {
+            LOG_ERROR_MESSAGE("Shader entry must specify name, type and file");
+            return false;
+        }
+
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.Desc.Name                  = Tokens[1].c_str();
+        ShaderCI.Desc.ShaderType            = ParseShaderType(Tokens[2]);
+        ShaderCI.FilePath                   = Tokens[3].c_str();
+        ShaderCI.pShaderSourceStreamFactory = m_pStreamFactory;
+        ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+        if (ShaderCI.Desc.ShaderType == SHADER_TYPE_UNKNOWN)
+        {
+            LOG_ERROR_MESSAGE("Unknown shader type '", Tokens[2], "'");
+            return false;
+        }
+
+        std::string EntryPoint = "main";
+        std::string CombinedSamplerSuffix;
+        MacroList   Macros;
+        for (size_t i = 4; i < Tokens.size(); ++i)
+        {
+            std::string Key, Value;
+            if (!ParseKeyValue(Tokens[i], Key, Value))
+            {
+                LOG_ERROR_MESSAGE("Invalid shader attribute '", Tokens[i], "'");
+                return false;
+            }
+
+            if (Key.compare(0, 2, "-D") == 0)
+            {
+                Macros.Add(Key.substr(2), Value);
+            }
+            else if (Key == "entry")
+            {
+                EntryPoint = Value;
+            }
+            else if (Key == "combined_samplers")
+            {
+                CombinedSamplerSuffix = Value;
+            }
+            else if (Key == "lang")
+            {
+                if (Value == "hlsl")
+                    ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+                else if (Value == "glsl")
+                    ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_GLSL;
+                else
+                {
+                    LOG_ERROR_MESSAGE("Unsupported shader language '", Value, "'");
+                    return false;
+                }
+            }
+            else
+            {
+                LOG_ERROR_MESSAGE("Unknown shader attribute '", Key, "'");
+                return false;
+            }
+        }
+
+        ShaderCI.EntryPoint                 = EntryPoint.c_str();
+        ShaderCI.Macros                     = Macros.Get();
+        ShaderCI.UseCombinedTextureSamplers = !CombinedSamplerSuffix.empty();
+        if (ShaderCI.UseCombinedTextureSamplers)
+            ShaderCI.CombinedSamplerSuffix = CombinedSamplerSuffix.c_str();
+
+        if (m_Options.UseDXC)
+            ShaderCI.ShaderCompiler = SHADER_COMPILER_DXC;
+
+        ShaderCompilationJob Job;
+        Job.ShaderCI = ShaderCI;
+        switch (m_Options.Target)
+        {
+            // clang-format off
+            case SHADER_ARCHIVE_TARGET_SPIRV: Job.Target = ShaderCompilationTarget::SPIRV; break;
+            case SHADER_ARCHIVE_TARGET_GLSL:  Job.Target = ShaderCompilationTarget::GLSL;  break;
+            case SHADER_ARCHIVE_TARGET_DXIL:  Job.Target = ShaderCompilationTarget::DXIL;  break;
+            // clang-format on
+            default:
+                LOG_ERROR_MESSAGE("Shader archive target ", GetShaderArchiveTargetString(m_Options.Target), " is not supported by the archiver");
+                return false;
+        }
+
+        if (!ShaderCompilationService::IsTargetSupported(Job.Target, ShaderCI.ShaderCompiler))
+        {
+            LOG_ERROR_MESSAGE("Target ", GetShaderArchiveTargetString(m_Options.Target), (m_Options.UseDXC ? " with DX compiler" : ""), " is not supported in this build");
+            return false;
+        }
+
+        // Shader data must be recorded before the job is submitted as the result may be delivered immediately
+        {
+            PendingShader Shader;
+            Shader.Name                  = Tokens[1];
+            Shader.Type                  = ShaderCI.Desc.ShaderType;
+            Shader.EntryPoint            = EntryPoint;
+            Shader.CombinedSamplerSuffix = CombinedSamplerSuffix;
+            Shader.Macros                = Macros;
+            std::lock_guard<std::mutex> Lock{m_PendingShadersMtx};
+            m_PendingShaders.emplace_back(std::move(Shader));
+        }
+
+        const auto JobId = m_pService->SubmitJob(Job);
+        VERIFY_EXPR(JobId + 1 == m_PendingShaders.size());
+        (void)JobId;
+
+        return true;
+    }
+
+    bool ParseShaderRef(const std::string& Str, std::string& Name, MacroList& Macros)
+    {
+        auto ColonPos = Str.find(':');
+        Name          = Str.substr(0, ColonPos);
+        if (ColonPos == std::string::npos)
+            return !Name.empty();
+
+        for (const auto& MacroStr : SplitString(Str.substr(ColonPos + 1), ','))
+        {
+            std::string MacroName, Definition;
+            if (!ParseKeyValue(MacroStr, MacroName, Definition))
+            {
+                LOG_ERROR_MESSAGE("Invalid macro '", MacroStr, "' in shader reference '", Str, "'");
+                return false;
+            }
+            Macros.Add(MacroName, Definition);
+        }
+        return !Name.empty();
+    }
+
+    bool ProcessPipeline(const std::vector<std::string>& Tokens)
+    {
+        if (Tokens.size() < 3)
+        {
+            LOG_ERROR_MESSAGE("Pipeline entry must specify the name and shaders");
+            return false;
+        }
+
+        const bool IsCompute = Tokens[0] == "compute";
+
+        GraphicsPipelineStateCreateInfo PSOCreateInfo;
+        PipelineStateDesc&              PSODesc  = PSOCreateInfo.PSODesc;
+        GraphicsPipelineDesc&           Graphics = PSOCreateInfo.GraphicsPipeline;
+
+        PSODesc.Name         = Tokens[1].c_str();
+        PSODesc.PipelineType = IsCompute ? PIPELINE_TYPE_COMPUTE : PIPELINE_TYPE_GRAPHICS;
+
+        // Default state matches the engine defaults, except that render targets must be specified explicitly
+        Graphics.NumRenderTargets = 0;
+
+        static constexpr const char* StageKeys[] = {"vs", "ps", "ds", "hs", "gs", "as", "ms", "cs"};
+
+        std::string ShaderNames[_countof(StageKeys)];
+        MacroList   ShaderMacros[_countof(StageKeys)];
+        SHADER_TYPE ActiveStages = SHADER_TYPE_UNKNOWN;
+
+        std::vector<std::string>                VarNames;
+        std::vector<ShaderResourceVariableDesc> Vars;
+        std::vector<std::string>                SamplerNames;
+        std::vector<ImmutableSamplerDesc>       Samplers;
+        std::vector<LayoutElement>              LayoutElems;
+
+        for (size_t i = 2; i < Tokens.size(); ++i)
+        {
+            std::string Key, Value;
+            if (!ParseKeyValue(Tokens[i], Key, Value))
+            {
+                LOG_ERROR_MESSAGE("Invalid pipeline attribute '", Tokens[i], "'");
+                return false;
+            }
+
+            bool IsStage = false;
+            for (size_t s = 0; s < _countof(StageKeys); ++s)
+            {
+                if (Key == StageKeys[s])
+                {
+                    if (!ParseShaderRef(Value, ShaderNames[s], ShaderMacros[s]))
+                        return false;
+                    ActiveStages |= ParseShaderType(Key);
+                    IsStage = true;
+                }
+            }
+            if (IsStage)
+                continue;
+
+            if (Key == "default_var")
+            {
+                if (!ParseVariableType(Value, PSODesc.ResourceLayout.DefaultVariableType))
+                {
+                    LOG_ERROR_MESSAGE("Unknown variable type '", Value, "'");
+                    return false;
+                }
+            }
+            else if (Key == "var" || Key == "sampler")
+            {
+                auto Parts = SplitString(Value, ':');
+                if (Parts.size() != 2)
+                {
+                    LOG_ERROR_MESSAGE("Attribute '", Key, "' must have the form <name>:<value>");
+                    return false;
+                }
+                if (Key == "var")
+                {
+                    ShaderResourceVariableDesc Var;
+                    if (!ParseVariableType(Parts[1], Var.Type))
+                    {
+                        LOG_ERROR_MESSAGE("Unknown variable type '", Parts[1], "'");
+                        return false;
+                    }
+                    VarNames.push_back(Parts[0]);
+                    Vars.push_back(Var);
+                }
+                else
+                {
+                    ImmutableSamplerDesc Sampler;
+                    if (!ParseSamplerPreset(Parts[1], Sampler.Desc))
+                    {
+                        LOG_ERROR_MESSAGE("Unknown sampler preset '", Parts[1], "'");
+                        return false;
+                    }
+                    SamplerNames.push_back(Parts[0]);
+                    Samplers.push_back(Sampler);
+                }
+            }
+            else if (!IsCompute && Key == "rtv")
+            {
+                for (const auto& FmtStr : SplitString(Value, ','))
+                {
+                    if (Graphics.NumRenderTargets >= MAX_RENDER_TARGETS)
+                    {
+                        LOG_ERROR_MESSAGE("Too many render targets");
+                        return false;
+                    }
+                    if (!ParseTextureFormat(FmtStr, Graphics.RTVFormats[Graphics.NumRenderTargets]))
+                    {
+                        LOG_ERROR_MESSAGE("Unknown texture format '", FmtStr, "'");
+                        return false;
+                    }
+                    ++Graphics.NumRenderTargets;
+                }
+            }
+            else if (!IsCompute && Key == "dsv")
+            {
+                if (!ParseTextureFormat(Value, Graphics.DSVFormat))
+                {
+                    LOG_ERROR_MESSAGE("Unknown texture format '", Value, "'");
+                    return false;
+                }
+            }
+            else if (!IsCompute && Key == "topology")
+            {
+                // clang-format off
+                if      (Value == "triangle_list")  Graphics.PrimitiveTopology = PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+                else if (Value == "triangle_strip") Graphics.PrimitiveTopology = PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
+                else if (Value == "line_list")      Graphics.PrimitiveTopology = PRIMITIVE_TOPOLOGY_LINE_LIST;
+                else if (Value == "line_strip")     Graphics.PrimitiveTopology = PRIMITIVE_TOPOLOGY_LINE_STRIP;
+                else if (Value == "point_list")     Graphics.PrimitiveTopology = PRIMITIVE_TOPOLOGY_POINT_LIST;
+                // clang-format on
+                else
+                {
+                    LOG_ERROR_MESSAGE("Unknown primitive topology '", Value, "'");
+                    return false;
+                }
+            }
+            else if (!IsCompute && Key == "cull")
+            {
+                // clang-format off
+                if      (Value == "none")  Graphics.RasterizerDesc.CullMode = CULL_MODE_NONE;
+                else if (Value == "front") Graphics.RasterizerDesc.CullMode = CULL_MODE_FRONT;
+                else if (Value == "back")  Graphics.RasterizerDesc.CullMode = CULL_MODE_BACK;
+                // clang-format on
+                else
+                {
+                    LOG_ERROR_MESSAGE("Unknown cull mode '", Value, "'");
+                    return false;
+                }
+            }
+            else if (!IsCompute && Key == "depth")
+            {
+                Graphics.DepthStencilDesc.DepthEnable = Value != "0";
+            }
+            else if (!IsCompute && Key == "depth_write")
+            {
+                Graphics.DepthStencilDesc.DepthWriteEnable = Value != "0";
+            }
+            else if (!IsCompute && Key == "attrib")
+            {
+                auto Parts = SplitString(Value, ',');
+
+                LayoutElement Elem;
+                Elem.InputIndex = static_cast<Uint32>(LayoutElems.size());
+                if (Parts.size() < 3 || !ParseValueType(Parts[2], Elem.ValueType))
+                {
+                    LOG_ERROR_MESSAGE("Attribute must have the form <slot>,<components>,<value type>[,norm]");
+                    return false;
+                }
+                Elem.BufferSlot    = static_cast<Uint32>(std::stoul(Parts[0]));
+                Elem.NumComponents = static_cast<Uint32>(std::stoul(Parts[1]));
+                Elem.IsNormalized  = Parts.size() > 3 && Parts[3] == "norm";
+                LayoutElems.push_back(Elem);
+            }
+            else
+            {
+                LOG_ERROR_MESSAGE("Unknown pipeline attribute '", Key, "'");
+                return false;
+            }
+        }
+
+        // Variables and samplers apply to all active stages
+        for (size_t i = 0; i < Vars.size(); ++i)
+        {
+            Vars[i].Name         = VarNames[i].c_str();
+            Vars[i].ShaderStages = ActiveStages;
+        }
+        for (size_t i = 0; i < Samplers.size(); ++i)
+        {
+            Samplers[i].SamplerOrTextureName = SamplerNames[i].c_str();
+            Samplers[i].ShaderStages         = ActiveStages;
+        }
+        PSODesc.ResourceLayout.Variables            = Vars.data();
+        PSODesc.ResourceLayout.NumVariables         = static_cast<Uint32>(Vars.size());
+        PSODesc.ResourceLayout.ImmutableSamplers    = Samplers.data();
+        PSODesc.ResourceLayout.NumImmutableSamplers = static_cast<Uint32>(Samplers.size());
+
+        Graphics.InputLayout.LayoutElements = LayoutElems.data();
+        Graphics.InputLayout.NumElements    = static_cast<Uint32>(LayoutElems.size());
+
+        auto GetRef = [&](size_t Stage) {
+            return ShaderNames[Stage].empty() ?
+                ShaderArchiveShaderRef{} :
+                ShaderArchiveShaderRef{ShaderNames[Stage].c_str(), ShaderMacros[Stage].Get()};
+        };
+
+        if (IsCompute)
+        {
+            ComputePipelineStateCreateInfo ComputeCreateInfo;
+            static_cast<PipelineStateCreateInfo&>(ComputeCreateInfo) = PSOCreateInfo;
+            return m_Writer.AddComputePipeline(ComputeCreateInfo, GetRef(7));
+        }
+        else
+        {
+            if (Graphics.NumRenderTargets == 0 && Graphics.DSVFormat == TEX_FORMAT_UNKNOWN)
+                LOG_WARNING_MESSAGE("Pipeline '", PSODesc.Name, "' has no render targets and no depth buffer");
+
+            ShaderArchiveGraphicsShaders Shaders;
+            Shaders.VS = GetRef(0);
+            Shaders.PS = GetRef(1);
+            Shaders.DS = GetRef(2);
+            Shaders.HS = GetRef(3);
+            Shaders.GS = GetRef(4);
+            Shaders.AS = GetRef(5);
+            Shaders.MS = GetRef(6);
+            if (Shaders.MS.Name != nullptr)
+                PSODesc.PipelineType = PIPELINE_TYPE_MESH;
+            return m_Writer.AddGraphicsPipeline(PSOCreateInfo, Shaders);
+        }
+    }
+
+    const ArchiverOptions& m_Options;
+    ShaderArchiveWriter    m_Writer;
+
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> m_pStreamFactory;
+
+    struct PendingShader
+    {
+        std::string Name;
+        SHADER_TYPE Type = SHADER_TYPE_UNKNOWN;
+        std::string EntryPoint;
+        std::string CombinedSamplerSuffix;
+        MacroList   Macros;
+    };
+    std::mutex                 m_PendingShadersMtx;
+    std::vector<PendingShader> m_PendingShaders;
+
+    // Indexed by the job id, which matches the index in m_PendingShaders
+    std::vector<ShaderCompilationResult> m_Results;
+
+    // Must be destroyed before the data accessed by the callback
+    std::unique_ptr<ShaderCompilationService> m_pService;
+};
+
+bool ParseCommandLine(int argc, char** argv, ArchiverOptions& Options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string Arg = argv[i];
+
+        auto GetValue = [&]() -> const char* {
+            if (i + 1 >= argc)
+            {
+                std::cerr << "Missing value for option " << Arg << '\n';
+                return nullptr;
+            }
+            return argv[++i];
+        };
+
+        if (Arg == "-t")
+        {
+            const char* Value = GetValue();
+            if (Value == nullptr)
+                return false;
+
+            const std::string Target = Value;
+            if (Target == "spirv")
+                Options.Target = SHADER_ARCHIVE_TARGET_SPIRV;
+            else if (Target == "glsl" || Target == "gles")
+            {
+                Options.Target = SHADER_ARCHIVE_TARGET_GLSL;
+                Options.IsGLES = Target == "gles";
+            }
+            else if (Target == "dxil")
+                Options.Target = SHADER_ARCHIVE_TARGET_DXIL;
+            else
+            {
+                std::cerr << "Unknown target '" << Target << "'\n";
+                return false;
+            }
+        }
+        else if (Arg == "-o")
+        {
+            const char* Value = GetValue();
+            if (Value == nullptr)
+                return false;
+            Options.OutputPath = Value;
+        }
+        else if (Arg == "-I")
+        {
+            const char* Value = GetValue();
+            if (Value == nullptr)
+                return false;
+            if (!Options.SearchDirectories.empty())
+                Options.SearchDirectories += ';';
+            Options.SearchDirectories += Value;
+        }
+        else if (Arg == "-c")
+        {
+            const char* Value = GetValue();
+            if (Value == nullptr)
+                return false;
+            Options.UseDXC = strcmp(Value, "dxc") == 0;
+        }
+        else if (Arg == "-j")
+        {
+            const char* Value = GetValue();
+            if (Value == nullptr)
+                return false;
+            Options.NumThreads = static_cast<Uint32>(std::max(atoi(Value), 0));
+        }
+        else if (Arg == "-v")
+        {
+            Options.Verbose = true;
+        }
+        else if (!Arg.empty() && Arg[0] != '-' && Options.ManifestPath.empty())
+        {
+            Options.ManifestPath = Arg;
+        }
+        else
+        {
+            std::cerr << "Unexpected argument '" << Arg << "'\n";
+            return false;
+        }
+    }
+
+    return Options.Target != SHADER_ARCHIVE_TARGET_UNKNOWN && !Options.OutputPath.empty() && !Options.ManifestPath.empty();
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    ArchiverOptions Options;
+    if (!ParseCommandLine(argc, argv, Options))
+    {
+        PrintUsage();
+        return -1;
+    }
+
+    std::ifstream Manifest{Options.ManifestPath};
+    if (!Manifest)
+    {
+        std::cerr << "Failed to open manifest file '" << Options.ManifestPath << "'\n";
+        return -1;
+    }
+
+    ShaderArchiver Archiver{Options};
+    if (!Archiver.ProcessManifest(Manifest))
+        return -1;
+
+    if (!Archiver.FinishShaders())
+        return -1;
+
+    return Archiver.Save() ? 0 : -1;
+}
@@ -40,6 +40,14 @@ enum class TargetGLSLCompiler
     driver
 };
 
+/// Builds the part of the GLSL source string that precedes the shader macros: version directive,
+/// extensions, platform and shader type definitions, precision qualifiers and extra definitions.
+/// The prefix is the same for all permutations of the shader, see ShaderSourceAssembler.
+String BuildGLSLSourcePrefix(SHADER_TYPE        ShaderType,
+                             const DeviceCaps&  deviceCaps,
+                             TargetGLSLCompiler TargetCompiler,
+                             const char*        ExtraDefinitions = nullptr);
+
 String BuildGLSLSourceString(const ShaderCreateInfo& ShaderCI,
                              const DeviceCaps&       deviceCaps,
                              TargetGLSLCompiler      TargetCompiler,
@@ -39,6 +39,12 @@
 namespace Diligent
 {
 
+/// Builds the part of the HLSL source string that precedes the shader macros:
+/// HLSL definitions, shader type definitions and extra definitions.
+/// The prefix is the same for all permutations of the shader, see ShaderSourceAssembler.
+String BuildHLSLSourcePrefix(SHADER_TYPE ShaderType,
+                             const char* ExtraDefinitions = nullptr);
+
 String BuildHLSLSourceString(const ShaderCreateInfo& ShaderCI,
                              const char*             ExtraDefinitions = nullptr);
 
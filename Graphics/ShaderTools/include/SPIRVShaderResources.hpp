@@ -35,6 +35,11 @@
 //   m_MemoryBuffer                                                                                                              m_TotalResources
 //    |                                                                                                                             |                                       |
 //    | Uniform Buffers | Storage Buffers | Storage Images | Sampled Images | Atomic Counters | Separate Samplers | Separate Images |   Stage Inputs   |   Resource Names   |
+//
+// The resources can also be serialized into a compact position-independent binary blob (see SPIRVShaderResources::Serialize()).
+// The blob does not contain any pointers and can be stored next to the byte code and memory-mapped at run time:
+//
+//    | Header | Serialized Resource Attribs | Serialized Stage Inputs | Names Pool |
 
 #include <memory>
 #include <vector>
@@ -42,6 +47,7 @@
 
 #include "Shader.h"
 #include "RenderDevice.h"
+#include "DataBlob.h"
 #include "STDAllocator.hpp"
 #include "RefCntAutoPtr.hpp"
 #include "StringPool.hpp"
@@ -109,6 +115,18 @@ public:
                                Uint32                                _BufferStaticSize   = 0,
                                Uint32                                _BufferStride       = 0) noexcept;
 
+    // Initializes the attributes from the values previously loaded from a serialized blob
+    SPIRVShaderResourceAttribs(const char*        _Name,
+                               Uint16             _ArraySize,
+                               ResourceType       _Type,
+                               RESOURCE_DIMENSION _ResourceDim,
+                               bool               _IsMS,
+                               Uint32             _SepSmplrOrImgInd,
+                               Uint32             _BindingDecorationOffset,
+                               Uint32             _DescriptorSetDecorationOffset,
+                               Uint32             _BufferStaticSize,
+                               Uint32             _BufferStride) noexcept;
+
     bool IsValidSepSamplerAssigned() const
     {
         VERIFY_EXPR(Type == ResourceType::SeparateImage);
@@ -198,6 +216,14 @@ public:
                          bool                  LoadShaderStageInputs,
                          std::string&          EntryPoint);
 
+    /// Loads the resources from the blob previously created by Serialize().
+    /// SPIRV-Cross is not used and the byte code is not parsed.
+    /// The blob is only read and may point to a memory-mapped file.
+    SPIRVShaderResources(IMemoryAllocator& Allocator,
+                         const void*       pSerializedData,
+                         size_t            SerializedDataSize,
+                         std::string&      EntryPoint);
+
     // clang-format off
     SPIRVShaderResources             (const SPIRVShaderResources&)  = delete;
     SPIRVShaderResources             (      SPIRVShaderResources&&) = delete;
@@ -352,6 +378,12 @@ public:
 
     std::string DumpResources();
 
+    /// Serializes the resources, the entry point name and all strings into a single binary blob.
+    void Serialize(const char* EntryPoint, IDataBlob** ppBlob) const;
+
+    /// Version of the serialized blob format. Blobs with different version are rejected by the loader.
+    static constexpr Uint32 SerializationVersion = 1;
+
     bool IsCompatibleWith(const SPIRVShaderResources& Resources) const;
 
     // clang-format off
@@ -0,0 +1,248 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of the ShaderCompilationService class
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "GraphicsTypes.h"
+#include "Shader.h"
+#include "DataBlob.h"
+#include "RefCntAutoPtr.hpp"
+#include "Timer.hpp"
+#include "ShaderSourceAssembler.hpp"
+
+namespace Diligent
+{
+
+class ThreadPool;
+class IDXCompiler;
+
+/// Shader compilation target
+enum class ShaderCompilationTarget : Uint8
+{
+    /// SPIR-V byte code. HLSL and GLSL sources are compiled with glslang,
+    /// or with DXC if ShaderCreateInfo::ShaderCompiler is SHADER_COMPILER_DXC.
+    SPIRV,
+
+    /// GLSL source for the OpenGL/GLES driver. HLSL sources are converted to GLSL,
+    /// SHADER_SOURCE_LANGUAGE_GLSL_VERBATIM sources are returned as is.
+    GLSL,
+
+    /// DXIL byte code compiled with DXC.
+    DXIL
+};
+
+/// Shader compilation job
+struct ShaderCompilationJob
+{
+    /// Shader create info. The service copies all strings and macros, so they
+    /// do not need to remain valid after the job has been submitted.
+    /// The source stream factory, if used, must be thread-safe.
+    ShaderCreateInfo ShaderCI;
+
+    /// Compilation target.
+    ShaderCompilationTarget Target = ShaderCompilationTarget::SPIRV;
+};
+
+/// Shader compilation result
+struct ShaderCompilationResult
+{
+    /// Job id returned by ShaderCompilationService::SubmitJob().
+    Uint32 JobId = 0;
+
+    /// Indicates if the compilation succeeded.
+    bool Succeeded = false;
+
+    /// Indicates that the job was identical to a previously submitted one,
+    /// and the result of that job is returned.
+    bool IsDuplicate = false;
+
+    /// Compiled byte code (SPIR-V words or DXIL), or null-terminated GLSL source.
+    RefCntAutoPtr<IDataBlob> pByteCode;
+
+    /// Serialized SPIR-V shader resources, see ShaderCompilationServiceCreateInfo::SerializeSPIRVResources.
+    RefCntAutoPtr<IDataBlob> pResources;
+
+    /// Compiler output (errors and warnings), may be null.
+    RefCntAutoPtr<IDataBlob> pCompilerOutput;
+
+    /// Time it took to compile the shader, in seconds.
+    double CompileTime = 0;
+};
+
+/// Shader compilation statistics
+struct ShaderCompilationStats
+{
+    /// The number of submitted jobs.
+    Uint32 NumJobs = 0;
+
+    /// The number of unique jobs, i.e. the number of shaders that are actually compiled.
+    Uint32 NumUniqueJobs = 0;
+
+    /// The number of jobs whose results have been delivered, including duplicates.
+    Uint32 NumCompletedJobs = 0;
+
+    /// The number of completed jobs that have failed.
+    Uint32 NumFailedJobs = 0;
+
+    /// Total time spent compiling unique jobs by all threads, in seconds.
+    double TotalCompileTime = 0;
+
+    /// Wall-clock time since the first job was submitted, in seconds.
+    double ElapsedTime = 0;
+
+    /// Returns the fraction of completed jobs in the [0, 1] range.
+    float GetProgress() const
+    {
+        return NumJobs > 0 ? static_cast<float>(NumCompletedJobs) / static_cast<float>(NumJobs) : 1.f;
+    }
+};
+
+/// Shader compilation service create info
+struct ShaderCompilationServiceCreateInfo
+{
+    /// The number of worker threads. If 0, the number of hardware threads is used.
+    Uint32 NumThreads = 0;
+
+    /// Optional path to the DX compiler library.
+    const char* DXCompilerLibrary = nullptr;
+
+    /// Device capabilities used to build GLSL sources for ShaderCompilationTarget::GLSL.
+    DeviceCaps GLSLDeviceCaps = GetDefaultGLSLDeviceCaps();
+
+    /// Whether to reflect and serialize the resources of SPIR-V shaders (see SPIRVShaderResources::Serialize()).
+    bool SerializeSPIRVResources = false;
+
+    /// Callback that is called when a job is complete. Callbacks are called from the worker
+    /// threads, but never concurrently, so the callback does not need to be thread-safe.
+    std::function<void(const ShaderCompilationResult&)> ResultCallback;
+
+    /// Returns desktop OpenGL 4.3 device capabilities with the typical set of features.
+    static DeviceCaps GetDefaultGLSLDeviceCaps();
+};
+
+/// Compiles shaders on multiple threads.
+
+/// The service runs compilation jobs on a work-stealing thread pool. Every worker thread
+/// uses its own compiler instances. Identical jobs (same source, macros regardless of their
+/// order, entry point, shader type, language, versions, compiler and target) are compiled only once,
+/// and the result is delivered for every one of them. Results are delivered through
+/// the callback as soon as they are ready, in the order of completion.
+///
+/// Jobs are looked up by a hash of the source and the compile options, and are then compared
+/// field by field, including the full source. Completed jobs keep their source and result to
+/// serve identical jobs submitted later, until they are released with ReleaseCompletedJobs().
+class ShaderCompilationService
+{
+public:
+    explicit ShaderCompilationService(const ShaderCompilationServiceCreateInfo& CI);
+
+    /// Waits for all jobs to complete.
+    ~ShaderCompilationService();
+
+    // clang-format off
+    ShaderCompilationService           (const ShaderCompilationService&)  = delete;
+    ShaderCompilationService           (      ShaderCompilationService&&) = delete;
+    ShaderCompilationService& operator=(const ShaderCompilationService&)  = delete;
+    ShaderCompilationService& operator=(      ShaderCompilationService&&) = delete;
+    // clang-format on
+
+    /// Submits the job and returns its id. The method is thread-safe.
+    Uint32 SubmitJob(const ShaderCompilationJob& Job);
+
+    /// Waits until all submitted jobs are complete.
+    void WaitForCompletion();
+
+    /// Releases the results of all completed jobs. Jobs submitted after this call
+    /// are compiled again even if they are identical to previously completed ones.
+    /// The method is thread-safe.
+    void ReleaseCompletedJobs();
+
+    /// Returns the current statistics.
+    ShaderCompilationStats GetStats() const;
+
+    /// Indicates if the target is supported in this build.
+    static bool IsTargetSupported(ShaderCompilationTarget Target, SHADER_COMPILER Compiler = SHADER_COMPILER_DEFAULT);
+
+    /// Per-thread source assembler used to build GLSL sources
+    struct SourceAssemblerData
+    {
+        ShaderSourceAssembler Assembler;
+
+        // Shader type and target GLSL compiler the assembler prefix has been built for
+        SHADER_TYPE PrefixShaderType = SHADER_TYPE_UNKNOWN;
+        Uint32      PrefixCompiler   = ~0u;
+    };
+
+private:
+    struct UniqueJob;
+
+    void CompileJob(UniqueJob& Job, Uint32 ThreadId);
+    void DeliverResults(UniqueJob& Job);
+
+    IDXCompiler* GetDXCompiler(Uint32 ThreadId, ShaderCompilationTarget Target);
+
+    const ShaderCompilationServiceCreateInfo m_CI;
+
+    // Unique jobs keyed by the hash of the source and the compile options.
+    // Jobs are shared with the thread pool tasks and with the threads that deliver the results.
+    using UniqueJobMapType = std::unordered_multimap<size_t, std::shared_ptr<UniqueJob>>;
+
+    mutable std::mutex m_JobsMtx;
+    UniqueJobMapType   m_UniqueJobs;
+
+    Uint32 m_NumJobs          = 0;
+    Uint32 m_NumUniqueJobs    = 0;
+    Uint32 m_NumCompletedJobs = 0;
+    Uint32 m_NumFailedJobs    = 0;
+    double m_TotalCompileTime = 0;
+    Timer  m_Timer;
+
+    std::mutex m_CallbackMtx;
+
+    // Per-thread DX compilers for DXIL and SPIR-V targets
+    std::vector<std::unique_ptr<IDXCompiler>> m_DXCompilers;
+
+    // Per-thread source assemblers. GLSL sources of all jobs, except for HLSL
+    // sources that need to be converted, are assembled by the thread's assembler.
+    std::vector<SourceAssemblerData> m_SourceAssemblers;
+
+    // Must be destroyed first
+    std::unique_ptr<ThreadPool> m_pThreadPool;
+};
+
+} // namespace Diligent
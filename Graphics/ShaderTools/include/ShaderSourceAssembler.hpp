@@ -0,0 +1,116 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of the ShaderSourceAssembler class
+
+#include <vector>
+
+#include "Shader.h"
+
+namespace Diligent
+{
+
+/// Non-owning view of an assembled shader source string.
+struct ShaderSourceView
+{
+    /// Null-terminated source string.
+    const char* Data = nullptr;
+
+    /// String length, not including the terminating null character.
+    size_t Length = 0;
+};
+
+/// Assembles shader source strings for many permutations of the same shader.
+
+/// The source string of every permutation consists of three parts:
+///
+///     | Prefix | Permutation macros | Source code |
+///
+/// The prefix (version directive, platform and shader type definitions, macros shared by all
+/// permutations, etc.) and the source code are the same for all permutations and are set once.
+/// The prefix is written to the arena buffer only once, and for every permutation the assembler
+/// rewrites the macro block and the source code after it. Once the arena has grown to the size
+/// of the largest permutation, assembling a permutation performs no memory allocations.
+///
+/// The class is not thread-safe; use one assembler per thread.
+class ShaderSourceAssembler
+{
+public:
+    ShaderSourceAssembler() = default;
+
+    // clang-format off
+    ShaderSourceAssembler           (const ShaderSourceAssembler&) = delete;
+    ShaderSourceAssembler& operator=(const ShaderSourceAssembler&) = delete;
+    ShaderSourceAssembler           (ShaderSourceAssembler&&)      = default;
+    ShaderSourceAssembler& operator=(ShaderSourceAssembler&&)      = default;
+    // clang-format on
+
+    /// Sets the prefix that is shared by all permutations.
+    /// If Length is 0, the prefix is treated as a null-terminated string.
+    void SetPrefix(const char* Prefix, size_t Length = 0);
+
+    /// Appends text to the shared prefix.
+    void AppendPrefix(const char* Text, size_t Length = 0);
+
+    /// Appends macros shared by all permutations to the prefix.
+    void AppendPrefixMacros(const ShaderMacro* Macros);
+
+    /// Sets the shader source code. The source is copied by the assembler.
+    /// If Length is 0, the source is treated as a null-terminated string.
+    void SetSource(const char* Source, size_t Length = 0);
+
+    /// Assembles the source string of the permutation defined by the macros.
+
+    /// \param [in] Macros - Permutation macros, terminated by {nullptr, nullptr}. May be null.
+    ///
+    /// \return     View of the assembled source string. The view remains valid until the
+    ///             next call to any non-const method of the assembler.
+    ShaderSourceView Assemble(const ShaderMacro* Macros);
+
+    /// Same as Assemble(const ShaderMacro*), but combines several macro lists,
+    /// e.g. the permutation macros and the ones defined by the material.
+    ShaderSourceView Assemble(const ShaderMacro* const* MacroLists, size_t NumLists);
+
+    /// Returns the length of the shared prefix.
+    size_t GetPrefixLength() const { return m_PrefixLength; }
+
+    /// Returns the current size of the arena buffer.
+    size_t GetArenaSize() const { return m_Arena.size(); }
+
+private:
+    // Makes sure the arena can hold at least Size bytes. Keeps the contents.
+    void ReserveArena(size_t Size);
+
+    std::vector<char> m_Arena;
+    size_t            m_PrefixLength = 0;
+    std::vector<char> m_Source;
+};
+
+} // namespace Diligent
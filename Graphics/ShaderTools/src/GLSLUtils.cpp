@@ -40,22 +40,13 @@
 namespace Diligent
 {
 
-String BuildGLSLSourceString(const ShaderCreateInfo& ShaderCI,
-                             const DeviceCaps&       deviceCaps,
-                             TargetGLSLCompiler      TargetCompiler,
-                             const char*             ExtraDefinitions)
+String BuildGLSLSourcePrefix(SHADER_TYPE        ShaderType,
+                             const DeviceCaps&  deviceCaps,
+                             TargetGLSLCompiler TargetCompiler,
+                             const char*        ExtraDefinitions)
 {
-    // clang-format off
-    VERIFY(ShaderCI.SourceLanguage == SHADER_SOURCE_LANGUAGE_DEFAULT ||
-           ShaderCI.SourceLanguage == SHADER_SOURCE_LANGUAGE_GLSL    ||
-           ShaderCI.SourceLanguage == SHADER_SOURCE_LANGUAGE_HLSL,
-           "Unsupported shader source language");
-    // clang-format on
-
     String GLSLSource;
 
-    const auto ShaderType = ShaderCI.Desc.ShaderType;
-
 #if PLATFORM_WIN32 || PLATFORM_LINUX
     GLSLSource.append(
         "#version 430 core\n"
@@ -264,6 +255,23 @@ String BuildGLSLSourceString(const ShaderCreateInfo& ShaderCI,
         GLSLSource.append(ExtraDefinitions);
     }
 
+    return GLSLSource;
+}
+
+String BuildGLSLSourceString(const ShaderCreateInfo& ShaderCI,
+                             const DeviceCaps&       deviceCaps,
+                             TargetGLSLCompiler      TargetCompiler,
+                             const char*             ExtraDefinitions)
+{
+    // clang-format off
+    VERIFY(ShaderCI.SourceLanguage == SHADER_SOURCE_LANGUAGE_DEFAULT ||
+           ShaderCI.SourceLanguage == SHADER_SOURCE_LANGUAGE_GLSL    ||
+           ShaderCI.SourceLanguage == SHADER_SOURCE_LANGUAGE_HLSL,
+           "Unsupported shader source language");
+    // clang-format on
+
+    auto GLSLSource = BuildGLSLSourcePrefix(ShaderCI.Desc.ShaderType, deviceCaps, TargetCompiler, ExtraDefinitions);
+
     AppendShaderMacros(GLSLSource, ShaderCI.Macros);
 
     RefCntAutoPtr<IDataBlob> pFileData;
@@ -43,17 +43,25 @@ static const char g_HLSLDefinitions[] =
 // clang-format on
 
 
-String BuildHLSLSourceString(const ShaderCreateInfo& ShaderCI,
-                             const char*             ExtraDefinitions)
+String BuildHLSLSourcePrefix(SHADER_TYPE ShaderType,
+                             const char* ExtraDefinitions)
 {
     String HLSLSource;
 
     HLSLSource.append(g_HLSLDefinitions);
-    AppendShaderTypeDefinitions(HLSLSource, ShaderCI.Desc.ShaderType);
+    AppendShaderTypeDefinitions(HLSLSource, ShaderType);
 
     if (ExtraDefinitions != nullptr)
         HLSLSource += ExtraDefinitions;
 
+    return HLSLSource;
+}
+
+String BuildHLSLSourceString(const ShaderCreateInfo& ShaderCI,
+                             const char*             ExtraDefinitions)
+{
+    auto HLSLSource = BuildHLSLSourcePrefix(ShaderCI.Desc.ShaderType, ExtraDefinitions);
+
     if (ShaderCI.Macros != nullptr)
     {
         HLSLSource += '\n';
@@ -33,6 +33,8 @@
 #include "GraphicsAccessories.hpp"
 #include "StringTools.hpp"
 #include "Align.hpp"
+#include "DataBlobImpl.hpp"
+#include "RefCntAutoPtr.hpp"
 
 namespace Diligent
 {
@@ -47,6 +49,7 @@ Type GetResourceArraySize(const diligent_spirv_cross::Compiler& Compiler,
     {
         // https://github.com/KhronosGroup/SPIRV-Cross/wiki/Reflection-API-user-guide#querying-array-types
         VERIFY(type.array.size() == 1, "Only one-dimensional arrays are currently supported");
+        // Runtime-sized arrays (e.g. Texture2D g_Textures[]) have zero size
         arrSize = type.array[0];
     }
     VERIFY(arrSize <= std::numeric_limits<Type>::max(), "Array size exceeds maximum representable value ", std::numeric_limits<Type>::max());
@@ -130,6 +133,31 @@ SPIRVShaderResourceAttribs::SPIRVShaderResourceAttribs(const diligent_spirv_cros
            "Only separate images or separate samplers can be assinged valid SepSmplrOrImgInd value");
 }
 
+SPIRVShaderResourceAttribs::SPIRVShaderResourceAttribs(const char*        _Name,
+                                                       Uint16             _ArraySize,
+                                                       ResourceType       _Type,
+                                                       RESOURCE_DIMENSION _ResourceDim,
+                                                       bool               _IsMS,
+                                                       Uint32             _SepSmplrOrImgInd,
+                                                       Uint32             _BindingDecorationOffset,
+                                                       Uint32             _DescriptorSetDecorationOffset,
+                                                       Uint32             _BufferStaticSize,
+                                                       Uint32             _BufferStride) noexcept :
+    // clang-format off
+    Name                          {_Name},
+    ArraySize                     {_ArraySize},
+    Type                          {_Type},
+    ResourceDim                   {static_cast<Uint8>(_ResourceDim)},
+    IsMS                          {_IsMS ? Uint8{1} : Uint8{0}},
+    SepSmplrOrImgInd              {_SepSmplrOrImgInd},
+    BindingDecorationOffset       {_BindingDecorationOffset},
+    DescriptorSetDecorationOffset {_DescriptorSetDecorationOffset},
+    BufferStaticSize              {_BufferStaticSize},
+    BufferStride                  {_BufferStride}
+// clang-format on
+{
+}
+
 
 SHADER_RESOURCE_TYPE SPIRVShaderResourceAttribs::GetShaderResourceType(ResourceType Type)
 {
@@ -599,6 +627,317 @@ SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&     Allocator,
 #endif
 }
 
+namespace
+{
+
+// All serialized structures only use fixed-size types and contain no pointers, so that
+// the blob is position-independent and can be used directly from a memory-mapped file.
+// Strings are referenced by their offsets from the beginning of the names pool.
+
+// Only the number of resources in every group is stored in the header. The groups match the layout
+// of SPIRVShaderResources memory buffer.
+enum SERIALIZED_RES_GROUP : Uint32
+{
+    SERIALIZED_RES_GROUP_UB = 0,
+    SERIALIZED_RES_GROUP_SB,
+    SERIALIZED_RES_GROUP_IMG,
+    SERIALIZED_RES_GROUP_SMPL_IMG,
+    SERIALIZED_RES_GROUP_AC,
+    SERIALIZED_RES_GROUP_SEP_SMPLR,
+    SERIALIZED_RES_GROUP_SEP_IMG,
+    SERIALIZED_RES_GROUP_INPT_ATT,
+    SERIALIZED_RES_GROUP_ACCEL_STRUCT,
+    SERIALIZED_RES_GROUP_COUNT
+};
+
+struct SerializedResourcesHeader
+{
+    static constexpr Uint32 MagicNumber         = 0x52565053; // 'SPVR'
+    static constexpr Uint32 InvalidStringOffset = ~Uint32{0};
+
+    Uint32 Magic   = MagicNumber;
+    Uint32 Version = SPIRVShaderResources::SerializationVersion;
+
+    Uint32 ShaderType     = SHADER_TYPE_UNKNOWN;
+    Uint32 NamesPoolSize  = 0;
+    Uint32 ShaderName     = 0;
+    Uint32 EntryPoint     = 0;
+    Uint32 CombinedSuffix = InvalidStringOffset; // InvalidStringOffset if combined samplers are not used
+
+    Uint16 NumResources[SERIALIZED_RES_GROUP_COUNT] = {};
+    Uint16 NumStageInputs                           = 0;
+    Uint8  IsHLSLSource                             = 0;
+    Uint8  Padding[3]                               = {};
+};
+static_assert(sizeof(SerializedResourcesHeader) == 52, "Unexpected size of SerializedResourcesHeader. This will break the serialized data.");
+
+struct SerializedResourceAttribs
+{
+    Uint32 Name;
+    Uint16 ArraySize;
+    Uint8  Type;
+    Uint8  ResourceDim : 7;
+    Uint8  IsMS : 1;
+    Uint32 SepSmplrOrImgInd;
+    Uint32 BindingDecorationOffset;
+    Uint32 DescriptorSetDecorationOffset;
+    Uint32 BufferStaticSize;
+    Uint32 BufferStride;
+};
+static_assert(sizeof(SerializedResourceAttribs) == 28, "Unexpected size of SerializedResourceAttribs. This will break the serialized data.");
+
+struct SerializedStageInputAttribs
+{
+    Uint32 Semantic;
+    Uint32 LocationDecorationOffset;
+};
+static_assert(sizeof(SerializedStageInputAttribs) == 8, "Unexpected size of SerializedStageInputAttribs. This will break the serialized data.");
+
+// Returns true if a resource of the given type may be stored in the given serialized resource group
+bool IsValidSerializedResourceType(Uint32 Group, Uint8 Type)
+{
+    using ResourceType = SPIRVShaderResourceAttribs::ResourceType;
+    static_assert(Uint32{ResourceType::NumResourceTypes} == 12, "Please handle the new resource type below");
+    switch (Group)
+    {
+        // clang-format off
+        case SERIALIZED_RES_GROUP_UB:           return Type == ResourceType::UniformBuffer;
+        case SERIALIZED_RES_GROUP_SB:           return Type == ResourceType::ROStorageBuffer    || Type == ResourceType::RWStorageBuffer;
+        case SERIALIZED_RES_GROUP_IMG:          return Type == ResourceType::StorageImage       || Type == ResourceType::StorageTexelBuffer;
+        case SERIALIZED_RES_GROUP_SMPL_IMG:     return Type == ResourceType::SampledImage       || Type == ResourceType::UniformTexelBuffer;
+        case SERIALIZED_RES_GROUP_AC:           return Type == ResourceType::AtomicCounter;
+        case SERIALIZED_RES_GROUP_SEP_SMPLR:    return Type == ResourceType::SeparateSampler;
+        case SERIALIZED_RES_GROUP_SEP_IMG:      return Type == ResourceType::SeparateImage      || Type == ResourceType::UniformTexelBuffer;
+        case SERIALIZED_RES_GROUP_INPT_ATT:     return Type == ResourceType::InputAttachment;
+        case SERIALIZED_RES_GROUP_ACCEL_STRUCT: return Type == ResourceType::AccelerationStructure;
+        // clang-format on
+        default:
+            UNEXPECTED("Unexpected serialized resource group");
+            return false;
+    }
+}
+
+} // namespace
+
+SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator& Allocator,
+                                           const void*       pSerializedData,
+                                           size_t            SerializedDataSize,
+                                           std::string&      EntryPoint)
+{
+    if (pSerializedData == nullptr || SerializedDataSize < sizeof(SerializedResourcesHeader))
+        LOG_ERROR_AND_THROW("Serialized shader resources data is null or too small");
+
+    const auto* pData = reinterpret_cast<const Uint8*>(pSerializedData);
+
+    SerializedResourcesHeader Header;
+    memcpy(&Header, pData, sizeof(Header));
+    if (Header.Magic != SerializedResourcesHeader::MagicNumber)
+        LOG_ERROR_AND_THROW("Serialized shader resources data is invalid: magic number mismatch");
+    if (Header.Version != SerializationVersion)
+        LOG_ERROR_AND_THROW("Serialized shader resources version (", Header.Version, ") does not match the expected version (", Uint32{SerializationVersion}, ")");
+    if (Header.ShaderType == SHADER_TYPE_UNKNOWN || Header.ShaderType > SHADER_TYPE_LAST || !IsPowerOfTwo(Header.ShaderType))
+        LOG_ERROR_AND_THROW("Serialized shader type (", Header.ShaderType, ") is invalid");
+
+    ResourceCounters ResCounters;
+    ResCounters.NumUBs          = Header.NumResources[SERIALIZED_RES_GROUP_UB];
+    ResCounters.NumSBs          = Header.NumResources[SERIALIZED_RES_GROUP_SB];
+    ResCounters.NumImgs         = Header.NumResources[SERIALIZED_RES_GROUP_IMG];
+    ResCounters.NumSmpldImgs    = Header.NumResources[SERIALIZED_RES_GROUP_SMPL_IMG];
+    ResCounters.NumACs          = Header.NumResources[SERIALIZED_RES_GROUP_AC];
+    ResCounters.NumSepSmplrs    = Header.NumResources[SERIALIZED_RES_GROUP_SEP_SMPLR];
+    ResCounters.NumSepImgs      = Header.NumResources[SERIALIZED_RES_GROUP_SEP_IMG];
+    ResCounters.NumInptAtts     = Header.NumResources[SERIALIZED_RES_GROUP_INPT_ATT];
+    ResCounters.NumAccelStructs = Header.NumResources[SERIALIZED_RES_GROUP_ACCEL_STRUCT];
+    static_assert(Uint32{SPIRVShaderResourceAttribs::ResourceType::NumResourceTypes} == 12, "Please set the new resource type counter here");
+
+    size_t TotalResources = 0;
+    for (Uint32 i = 0; i < SERIALIZED_RES_GROUP_COUNT; ++i)
+        TotalResources += Header.NumResources[i];
+    if (TotalResources > std::numeric_limits<OffsetType>::max())
+        LOG_ERROR_AND_THROW("The total number of serialized resources (", TotalResources, ") exceeds the maximum allowed value (", std::numeric_limits<OffsetType>::max(), ")");
+
+    const size_t ResourcesOffset   = sizeof(SerializedResourcesHeader);
+    const size_t StageInputsOffset = ResourcesOffset + TotalResources * sizeof(SerializedResourceAttribs);
+    const size_t NamesPoolOffset   = StageInputsOffset + size_t{Header.NumStageInputs} * sizeof(SerializedStageInputAttribs);
+    if (NamesPoolOffset + Header.NamesPoolSize != SerializedDataSize)
+        LOG_ERROR_AND_THROW("Serialized shader resources data size (", SerializedDataSize, ") does not match the expected size (", NamesPoolOffset + Header.NamesPoolSize, ")");
+
+    const auto* pSrcNames = reinterpret_cast<const char*>(pData + NamesPoolOffset);
+    if (Header.NamesPoolSize == 0 || pSrcNames[Header.NamesPoolSize - 1] != '\0')
+        LOG_ERROR_AND_THROW("Serialized shader resources names pool is not null-terminated");
+
+    // Validate the resources before any memory is allocated. Resource groups are stored in the same
+    // order as in the resource memory buffer.
+    {
+        Uint32 n = 0;
+        for (Uint32 Group = 0; Group < SERIALIZED_RES_GROUP_COUNT; ++Group)
+        {
+            for (Uint32 i = 0; i < Header.NumResources[Group]; ++i, ++n)
+            {
+                SerializedResourceAttribs SrcAttribs;
+                memcpy(&SrcAttribs, pData + ResourcesOffset + n * sizeof(SerializedResourceAttribs), sizeof(SrcAttribs));
+                if (!IsValidSerializedResourceType(Group, SrcAttribs.Type))
+                    LOG_ERROR_AND_THROW("Type (", Uint32{SrcAttribs.Type}, ") of serialized resource ", n, " is invalid");
+                if (SrcAttribs.ResourceDim >= RESOURCE_DIM_NUM_DIMENSIONS)
+                    LOG_ERROR_AND_THROW("Dimension (", Uint32{SrcAttribs.ResourceDim}, ") of serialized resource ", n, " is invalid");
+                if (SrcAttribs.Name >= Header.NamesPoolSize)
+                    LOG_ERROR_AND_THROW("Name offset (", SrcAttribs.Name, ") of serialized resource ", n, " is out of range");
+
+                if (SrcAttribs.SepSmplrOrImgInd != SPIRVShaderResourceAttribs::InvalidSepSmplrOrImgInd)
+                {
+                    // Separate images reference separate samplers and vice versa
+                    Uint32 NumAssignableResources = 0;
+                    if (SrcAttribs.Type == SPIRVShaderResourceAttribs::ResourceType::SeparateImage)
+                        NumAssignableResources = ResCounters.NumSepSmplrs;
+                    else if (SrcAttribs.Type == SPIRVShaderResourceAttribs::ResourceType::SeparateSampler)
+                        NumAssignableResources = ResCounters.NumSepImgs;
+                    if (SrcAttribs.SepSmplrOrImgInd >= NumAssignableResources)
+                        LOG_ERROR_AND_THROW("Separate sampler or image index (", SrcAttribs.SepSmplrOrImgInd, ") of serialized resource ", n, " is out of range");
+                }
+            }
+        }
+        VERIFY_EXPR(n == TotalResources);
+    }
+
+    m_ShaderType   = static_cast<SHADER_TYPE>(Header.ShaderType);
+    m_IsHLSLSource = Header.IsHLSLSource != 0;
+
+    // The names pool is copied as is, so we only need to reserve the space for it.
+    StringPool ResourceNamesPool;
+    Initialize(Allocator, ResCounters, Header.NumStageInputs, Header.NamesPoolSize, ResourceNamesPool);
+    VERIFY_EXPR(m_TotalResources == TotalResources);
+
+    auto* pNames = ResourceNamesPool.Allocate(Header.NamesPoolSize);
+    memcpy(pNames, pSrcNames, Header.NamesPoolSize);
+
+    auto GetName = [&](Uint32 Offset) -> const char* {
+        if (Offset >= Header.NamesPoolSize)
+            LOG_ERROR_AND_THROW("Serialized string offset (", Offset, ") is out of range");
+        return pNames + Offset;
+    };
+
+    for (Uint32 n = 0; n < m_TotalResources; ++n)
+    {
+        SerializedResourceAttribs SrcAttribs;
+        memcpy(&SrcAttribs, pData + ResourcesOffset + n * sizeof(SerializedResourceAttribs), sizeof(SrcAttribs));
+        new (&GetResource(n)) SPIRVShaderResourceAttribs //
+            {
+                GetName(SrcAttribs.Name),
+                SrcAttribs.ArraySize,
+                static_cast<SPIRVShaderResourceAttribs::ResourceType>(SrcAttribs.Type),
+                static_cast<RESOURCE_DIMENSION>(SrcAttribs.ResourceDim),
+                SrcAttribs.IsMS != 0,
+                SrcAttribs.SepSmplrOrImgInd,
+                SrcAttribs.BindingDecorationOffset,
+                SrcAttribs.DescriptorSetDecorationOffset,
+                SrcAttribs.BufferStaticSize,
+                SrcAttribs.BufferStride //
+            };
+    }
+
+    for (Uint32 n = 0; n < m_NumShaderStageInputs; ++n)
+    {
+        SerializedStageInputAttribs SrcInput;
+        memcpy(&SrcInput, pData + StageInputsOffset + n * sizeof(SerializedStageInputAttribs), sizeof(SrcInput));
+        new (&GetShaderStageInputAttribs(n)) SPIRVShaderStageInputAttribs{GetName(SrcInput.Semantic), SrcInput.LocationDecorationOffset};
+    }
+
+    m_ShaderName = GetName(Header.ShaderName);
+    if (Header.CombinedSuffix != SerializedResourcesHeader::InvalidStringOffset)
+        m_CombinedSamplerSuffix = GetName(Header.CombinedSuffix);
+    EntryPoint = GetName(Header.EntryPoint);
+}
+
+void SPIRVShaderResources::Serialize(const char* EntryPoint, IDataBlob** ppBlob) const
+{
+    VERIFY_EXPR(EntryPoint != nullptr && ppBlob != nullptr);
+    DEV_CHECK_ERR(*ppBlob == nullptr, "Overwriting reference to existing blob may result in memory leaks");
+
+    // Names are stored in the same order they are written by the serialization loop below.
+    size_t NamesPoolSize = 0;
+    for (Uint32 n = 0; n < GetTotalResources(); ++n)
+        NamesPoolSize += StringPool::GetRequiredReserveSize(GetResource(n).Name);
+    for (Uint32 n = 0; n < GetNumShaderStageInputs(); ++n)
+        NamesPoolSize += StringPool::GetRequiredReserveSize(GetShaderStageInputAttribs(n).Semantic);
+    NamesPoolSize += StringPool::GetRequiredReserveSize(m_ShaderName);
+    NamesPoolSize += StringPool::GetRequiredReserveSize(EntryPoint);
+    NamesPoolSize += StringPool::GetRequiredReserveSize(m_CombinedSamplerSuffix);
+
+    const size_t ResourcesOffset   = sizeof(SerializedResourcesHeader);
+    const size_t StageInputsOffset = ResourcesOffset + GetTotalResources() * sizeof(SerializedResourceAttribs);
+    const size_t NamesPoolOffset   = StageInputsOffset + GetNumShaderStageInputs() * sizeof(SerializedStageInputAttribs);
+
+    RefCntAutoPtr<DataBlobImpl> pBlob{MakeNewRCObj<DataBlobImpl>()(NamesPoolOffset + NamesPoolSize)};
+
+    auto* pData  = reinterpret_cast<Uint8*>(pBlob->GetDataPtr());
+    auto* pNames = reinterpret_cast<char*>(pData + NamesPoolOffset);
+
+    StringPool NamesPool;
+    NamesPool.AssignMemory(pNames, NamesPoolSize);
+    auto WriteString = [&](const char* Str) {
+        return static_cast<Uint32>(NamesPool.CopyString(Str) - pNames);
+    };
+
+    for (Uint32 n = 0; n < GetTotalResources(); ++n)
+    {
+        const auto& Res = GetResource(n);
+
+        SerializedResourceAttribs DstAttribs{};
+        DstAttribs.Name             = WriteString(Res.Name);
+        DstAttribs.ArraySize        = Res.ArraySize;
+        DstAttribs.Type             = static_cast<Uint8>(Res.Type);
+        DstAttribs.ResourceDim      = Res.ResourceDim;
+        DstAttribs.IsMS             = Res.IsMS;
+        DstAttribs.SepSmplrOrImgInd = SPIRVShaderResourceAttribs::InvalidSepSmplrOrImgInd;
+        if (Res.Type == SPIRVShaderResourceAttribs::ResourceType::SeparateImage)
+            DstAttribs.SepSmplrOrImgInd = Res.GetAssignedSepSamplerInd();
+        else if (Res.Type == SPIRVShaderResourceAttribs::ResourceType::SeparateSampler)
+            DstAttribs.SepSmplrOrImgInd = Res.GetAssignedSepImageInd();
+        DstAttribs.BindingDecorationOffset       = Res.BindingDecorationOffset;
+        DstAttribs.DescriptorSetDecorationOffset = Res.DescriptorSetDecorationOffset;
+        DstAttribs.BufferStaticSize              = Res.BufferStaticSize;
+        DstAttribs.BufferStride                  = Res.BufferStride;
+        memcpy(pData + ResourcesOffset + n * sizeof(SerializedResourceAttribs), &DstAttribs, sizeof(DstAttribs));
+    }
+
+    for (Uint32 n = 0; n < GetNumShaderStageInputs(); ++n)
+    {
+        const auto& Input = GetShaderStageInputAttribs(n);
+
+        SerializedStageInputAttribs DstInput{};
+        DstInput.Semantic                 = WriteString(Input.Semantic);
+        DstInput.LocationDecorationOffset = Input.LocationDecorationOffset;
+        memcpy(pData + StageInputsOffset + n * sizeof(SerializedStageInputAttribs), &DstInput, sizeof(DstInput));
+    }
+
+    SerializedResourcesHeader Header;
+    Header.ShaderType = static_cast<Uint32>(m_ShaderType);
+    Header.ShaderName = WriteString(m_ShaderName);
+    Header.EntryPoint = WriteString(EntryPoint);
+    if (m_CombinedSamplerSuffix != nullptr)
+        Header.CombinedSuffix = WriteString(m_CombinedSamplerSuffix);
+    Header.NamesPoolSize = static_cast<Uint32>(NamesPoolSize);
+
+    Header.NumResources[SERIALIZED_RES_GROUP_UB]           = static_cast<Uint16>(GetNumUBs());
+    Header.NumResources[SERIALIZED_RES_GROUP_SB]           = static_cast<Uint16>(GetNumSBs());
+    Header.NumResources[SERIALIZED_RES_GROUP_IMG]          = static_cast<Uint16>(GetNumImgs());
+    Header.NumResources[SERIALIZED_RES_GROUP_SMPL_IMG]     = static_cast<Uint16>(GetNumSmpldImgs());
+    Header.NumResources[SERIALIZED_RES_GROUP_AC]           = static_cast<Uint16>(GetNumACs());
+    Header.NumResources[SERIALIZED_RES_GROUP_SEP_SMPLR]    = static_cast<Uint16>(GetNumSepSmplrs());
+    Header.NumResources[SERIALIZED_RES_GROUP_SEP_IMG]      = static_cast<Uint16>(GetNumSepImgs());
+    Header.NumResources[SERIALIZED_RES_GROUP_INPT_ATT]     = static_cast<Uint16>(GetNumInptAtts());
+    Header.NumResources[SERIALIZED_RES_GROUP_ACCEL_STRUCT] = static_cast<Uint16>(GetNumAccelStructs());
+    static_assert(Uint32{SPIRVShaderResourceAttribs::ResourceType::NumResourceTypes} == 12, "Please serialize the new resource type counter here");
+
+    Header.NumStageInputs = static_cast<Uint16>(GetNumShaderStageInputs());
+    Header.IsHLSLSource   = m_IsHLSLSource ? 1 : 0;
+    memcpy(pData, &Header, sizeof(Header));
+
+    VERIFY(NamesPool.GetRemainingSize() == 0, "Names pool must be empty");
+
+    *ppBlob = pBlob.Detach();
+}
+
 void SPIRVShaderResources::Initialize(IMemoryAllocator&       Allocator,
                                       const ResourceCounters& Counters,
                                       Uint32                  NumShaderStageInputs,
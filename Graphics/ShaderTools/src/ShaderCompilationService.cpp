@@ -0,0 +1,570 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#include "ShaderCompilationService.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "ThreadPool.hpp"
+#include "DataBlobImpl.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+#include "DebugUtilities.hpp"
+#include "DXCompiler.hpp"
+#include "HashUtils.hpp"
+#include "ShaderToolsCommon.hpp"
+
+#if SHADER_TOOLS_GLSL_SUPPORTED
+#    include "GLSLUtils.hpp"
+#endif
+
+#if SHADER_TOOLS_GLSLANG_SUPPORTED
+#    include "GLSLangUtils.hpp"
+#    include "SPIRVShaderResources.hpp"
+#endif
+
+namespace Diligent
+{
+
+namespace
+{
+
+constexpr char VulkanDefine[] =
+    "#ifndef VULKAN\n"
+    "#   define VULKAN 1\n"
+    "#endif\n";
+
+template <typename DataType>
+RefCntAutoPtr<IDataBlob> CreateDataBlob(const DataType* pData, size_t Size)
+{
+    RefCntAutoPtr<DataBlobImpl> pBlob{MakeNewRCObj<DataBlobImpl>()(Size)};
+    if (Size > 0)
+        memcpy(pBlob->GetDataPtr(), pData, Size);
+    return RefCntAutoPtr<IDataBlob>{pBlob};
+}
+
+} // namespace
+
+#if SHADER_TOOLS_GLSL_SUPPORTED
+// Assembles the GLSL source string of a GLSL shader. Same as BuildGLSLSourceString(), but reuses the
+// prefix and the memory of the thread's source assembler, as jobs are typically permutations of the same shaders.
+static ShaderSourceView AssembleGLSLSource(ShaderCompilationService::SourceAssemblerData& Data,
+                                           const ShaderCreateInfo&                         ShaderCI,
+                                           const DeviceCaps&                               Caps,
+                                           TargetGLSLCompiler                              TargetCompiler,
+                                           const char*                                     ExtraDefinitions = nullptr)
+{
+    VERIFY_EXPR(ShaderCI.SourceLanguage == SHADER_SOURCE_LANGUAGE_DEFAULT || ShaderCI.SourceLanguage == SHADER_SOURCE_LANGUAGE_GLSL);
+
+    // Device caps and extra definitions are fixed for every target compiler,
+    // so the prefix only depends on the shader type and the compiler.
+    const auto PrefixCompiler = static_cast<Uint32>(TargetCompiler);
+    if (Data.PrefixShaderType != ShaderCI.Desc.ShaderType || Data.PrefixCompiler != PrefixCompiler)
+    {
+        const auto Prefix = BuildGLSLSourcePrefix(ShaderCI.Desc.ShaderType, Caps, TargetCompiler, ExtraDefinitions);
+        Data.Assembler.SetPrefix(Prefix.c_str(), Prefix.length());
+        Data.PrefixShaderType = ShaderCI.Desc.ShaderType;
+        Data.PrefixCompiler   = PrefixCompiler;
+    }
+
+    RefCntAutoPtr<IDataBlob> pSourceFileData;
+    size_t                   SourceLength = 0;
+
+    const auto* ShaderSource = ReadShaderSourceFile(ShaderCI.Source, ShaderCI.pShaderSourceStreamFactory, ShaderCI.FilePath, pSourceFileData, SourceLength);
+    Data.Assembler.SetSource(ShaderSource, SourceLength);
+
+    return Data.Assembler.Assemble(ShaderCI.Macros);
+}
+#endif
+
+// All strings referenced by the job are owned by the service
+struct ShaderCompilationService::UniqueJob
+{
+    std::string Name;
+    std::string Source;
+    std::string FilePath;
+    std::string EntryPoint;
+    std::string CombinedSamplerSuffix;
+
+    std::vector<std::pair<std::string, std::string>> MacroStrings;
+    std::vector<ShaderMacro>                         Macros;
+
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pSourceFactory;
+
+    ShaderCreateInfo        ShaderCI;
+    ShaderCompilationTarget Target = ShaderCompilationTarget::SPIRV;
+
+    const bool HasSource;
+
+    // Hash of the source and all compile options, see IsIdenticalTo()
+    size_t Hash = 0;
+
+    // Ids of all jobs that wait for the result of this job.
+    // Protected by m_JobsMtx.
+    std::vector<Uint32> JobIds;
+    bool                IsComplete = false;
+
+    // Id of the job that caused the compilation
+    Uint32 FirstJobId = 0;
+
+    ShaderCompilationResult Result;
+
+    UniqueJob(const ShaderCompilationJob& Job) :
+        // clang-format off
+        Name                 {Job.ShaderCI.Desc.Name             != nullptr ? Job.ShaderCI.Desc.Name             : ""},
+        Source               {Job.ShaderCI.Source                != nullptr ? Job.ShaderCI.Source                : ""},
+        FilePath             {Job.ShaderCI.FilePath              != nullptr ? Job.ShaderCI.FilePath              : ""},
+        EntryPoint           {Job.ShaderCI.EntryPoint            != nullptr ? Job.ShaderCI.EntryPoint            : "main"},
+        CombinedSamplerSuffix{Job.ShaderCI.CombinedSamplerSuffix != nullptr ? Job.ShaderCI.CombinedSamplerSuffix : ""},
+        pSourceFactory       {Job.ShaderCI.pShaderSourceStreamFactory},
+        ShaderCI             {Job.ShaderCI},
+        Target               {Job.Target},
+        HasSource            {Job.ShaderCI.Source != nullptr}
+    // clang-format on
+    {
+        if (Job.ShaderCI.Macros != nullptr)
+        {
+            for (auto* pMacro = Job.ShaderCI.Macros; pMacro->Name != nullptr && pMacro->Definition != nullptr; ++pMacro)
+                MacroStrings.emplace_back(pMacro->Name, pMacro->Definition);
+        }
+        // Macro order does not affect the result, so sort the macros to make the key canonical
+        std::sort(MacroStrings.begin(), MacroStrings.end());
+
+        for (const auto& Macro : MacroStrings)
+            Macros.emplace_back(Macro.first.c_str(), Macro.second.c_str());
+        Macros.emplace_back(nullptr, nullptr);
+
+        if (!ShaderCI.UseCombinedTextureSamplers)
+            CombinedSamplerSuffix.clear();
+
+        ShaderCI.Desc.Name                  = Name.c_str();
+        ShaderCI.Source                     = HasSource ? Source.c_str() : nullptr;
+        ShaderCI.FilePath                   = Job.ShaderCI.FilePath != nullptr ? FilePath.c_str() : nullptr;
+        ShaderCI.EntryPoint                 = EntryPoint.c_str();
+        ShaderCI.CombinedSamplerSuffix      = CombinedSamplerSuffix.c_str();
+        ShaderCI.Macros                     = Macros.data();
+        ShaderCI.pShaderSourceStreamFactory = pSourceFactory;
+        ShaderCI.ppConversionStream         = nullptr;
+        ShaderCI.ppCompilerOutput           = nullptr;
+        ShaderCI.ByteCode                   = nullptr;
+        ShaderCI.ByteCodeSize               = 0;
+
+        // The shader name is not part of the key
+        HashCombine(Hash,
+                    static_cast<int>(Target),
+                    static_cast<int>(ShaderCI.ShaderCompiler),
+                    static_cast<int>(ShaderCI.SourceLanguage),
+                    static_cast<Uint32>(ShaderCI.Desc.ShaderType),
+                    ShaderCI.HLSLVersion.Major, ShaderCI.HLSLVersion.Minor,
+                    ShaderCI.GLSLVersion.Major, ShaderCI.GLSLVersion.Minor,
+                    ShaderCI.GLESSLVersion.Major, ShaderCI.GLESSLVersion.Minor,
+                    ShaderCI.UseCombinedTextureSamplers,
+                    EntryPoint,
+                    CombinedSamplerSuffix);
+        for (const auto& Macro : MacroStrings)
+            HashCombine(Hash, Macro.first, Macro.second);
+        if (HasSource)
+        {
+            HashCombine(Hash, Source);
+        }
+        else
+        {
+            // Files with the same path opened through different factories may differ
+            HashCombine(Hash, pSourceFactory.RawPtr(), FilePath);
+        }
+    }
+
+    bool IsIdenticalTo(const UniqueJob& Job) const
+    {
+        // clang-format off
+        return Hash                                == Job.Hash                                &&
+               Target                              == Job.Target                              &&
+               ShaderCI.ShaderCompiler             == Job.ShaderCI.ShaderCompiler             &&
+               ShaderCI.SourceLanguage             == Job.ShaderCI.SourceLanguage             &&
+               ShaderCI.Desc.ShaderType            == Job.ShaderCI.Desc.ShaderType            &&
+               ShaderCI.HLSLVersion                == Job.ShaderCI.HLSLVersion                &&
+               ShaderCI.GLSLVersion                == Job.ShaderCI.GLSLVersion                &&
+               ShaderCI.GLESSLVersion              == Job.ShaderCI.GLESSLVersion              &&
+               ShaderCI.UseCombinedTextureSamplers == Job.ShaderCI.UseCombinedTextureSamplers &&
+               EntryPoint                          == Job.EntryPoint                          &&
+               CombinedSamplerSuffix               == Job.CombinedSamplerSuffix               &&
+               MacroStrings                        == Job.MacroStrings                        &&
+               HasSource                           == Job.HasSource                           &&
+               Source                              == Job.Source                              &&
+               pSourceFactory.RawPtr()             == Job.pSourceFactory.RawPtr()             &&
+               FilePath                            == Job.FilePath;
+        // clang-format on
+    }
+};
+
+DeviceCaps ShaderCompilationServiceCreateInfo::GetDefaultGLSLDeviceCaps()
+{
+    DeviceCaps GLCaps;
+    GLCaps.DevType                        = RENDER_DEVICE_TYPE_GL;
+    GLCaps.MajorVersion                   = 4;
+    GLCaps.MinorVersion                   = 3;
+    GLCaps.Features.SeparablePrograms     = DEVICE_FEATURE_STATE_ENABLED;
+    GLCaps.Features.ComputeShaders        = DEVICE_FEATURE_STATE_ENABLED;
+    GLCaps.TexCaps.CubemapArraysSupported = True;
+    GLCaps.TexCaps.Texture2DMSSupported   = True;
+    return GLCaps;
+}
+
+bool ShaderCompilationService::IsTargetSupported(ShaderCompilationTarget Target, SHADER_COMPILER Compiler)
+{
+    switch (Target)
+    {
+        case ShaderCompilationTarget::SPIRV:
+            return Compiler == SHADER_COMPILER_DXC ? SHADER_TOOLS_DXC_SUPPORTED != 0 : SHADER_TOOLS_GLSLANG_SUPPORTED != 0;
+
+        case ShaderCompilationTarget::GLSL:
+            return SHADER_TOOLS_GLSL_SUPPORTED != 0;
+
+        case ShaderCompilationTarget::DXIL:
+            return SHADER_TOOLS_DXC_SUPPORTED != 0;
+
+        default:
+            UNEXPECTED("Unexpected shader compilation target");
+            return false;
+    }
+}
+
+ShaderCompilationService::ShaderCompilationService(const ShaderCompilationServiceCreateInfo& CI) :
+    m_CI{CI},
+    m_pThreadPool{new ThreadPool{CI.NumThreads}}
+{
+    // Two compilers per thread: one for DXIL and one for SPIR-V
+    m_DXCompilers.resize(m_pThreadPool->GetNumThreads() * 2);
+    m_SourceAssemblers.resize(m_pThreadPool->GetNumThreads());
+
+#if SHADER_TOOLS_GLSLANG_SUPPORTED
+    // Process-wide initialization is reference-counted by glslang.
+    // Compilation itself is thread-safe as long as every thread uses its own objects.
+    GLSLangUtils::InitializeGlslang();
+#endif
+}
+
+ShaderCompilationService::~ShaderCompilationService()
+{
+    m_pThreadPool->WaitForAllTasks();
+    m_pThreadPool.reset();
+    m_DXCompilers.clear();
+
+#if SHADER_TOOLS_GLSLANG_SUPPORTED
+    GLSLangUtils::FinalizeGlslang();
+#endif
+}
+
+Uint32 ShaderCompilationService::SubmitJob(const ShaderCompilationJob& Job)
+{
+    std::shared_ptr<UniqueJob> pNewJob{new UniqueJob{Job}};
+
+    std::shared_ptr<UniqueJob> pCompletedJob;
+    Uint32                     JobId = 0;
+    {
+        std::lock_guard<std::mutex> Lock{m_JobsMtx};
+
+        if (m_NumJobs == 0)
+            m_Timer.Restart();
+        JobId = m_NumJobs++;
+
+        auto range = m_UniqueJobs.equal_range(pNewJob->Hash);
+        auto it    = std::find_if(range.first, range.second, [&pNewJob](const UniqueJobMapType::value_type& Elem) {
+            return Elem.second->IsIdenticalTo(*pNewJob);
+        });
+        if (it != range.second)
+        {
+            auto& pExistingJob = it->second;
+            pExistingJob->JobIds.push_back(JobId);
+            if (!pExistingJob->IsComplete)
+            {
+                // The result will be delivered when the job completes
+                return JobId;
+            }
+            pCompletedJob = pExistingJob;
+        }
+        else
+        {
+            pNewJob->JobIds.push_back(JobId);
+            pNewJob->FirstJobId = JobId;
+            ++m_NumUniqueJobs;
+
+            const auto Hash = pNewJob->Hash;
+            m_UniqueJobs.emplace(Hash, pNewJob);
+            m_pThreadPool->EnqueueTask([this, pNewJob](Uint32 ThreadId) {
+                CompileJob(*pNewJob, ThreadId);
+            });
+            return JobId;
+        }
+    }
+
+    // Duplicate of a job that has already been completed
+    DeliverResults(*pCompletedJob);
+    return JobId;
+}
+
+void ShaderCompilationService::ReleaseCompletedJobs()
+{
+    std::lock_guard<std::mutex> Lock{m_JobsMtx};
+    for (auto it = m_UniqueJobs.begin(); it != m_UniqueJobs.end();)
+    {
+        // Results that are being delivered are kept alive by the delivering thread
+        if (it->second->IsComplete)
+            it = m_UniqueJobs.erase(it);
+        else
+            ++it;
+    }
+}
+
+IDXCompiler* ShaderCompilationService::GetDXCompiler(Uint32 ThreadId, ShaderCompilationTarget Target)
+{
+#if SHADER_TOOLS_DXC_SUPPORTED
+    // Every thread only accesses its own compilers, so no synchronization is needed
+    const auto Idx       = ThreadId * 2 + (Target == ShaderCompilationTarget::DXIL ? 0 : 1);
+    auto&      pCompiler = m_DXCompilers[Idx];
+    if (!pCompiler)
+    {
+        pCompiler = CreateDXCompiler(Target == ShaderCompilationTarget::DXIL ? DXCompilerTarget::Direct3D12 : DXCompilerTarget::Vulkan,
+                                     m_CI.DXCompilerLibrary);
+    }
+    if (!pCompiler || !pCompiler->IsLoaded())
+    {
+        LOG_ERROR_MESSAGE("Failed to load DX Compiler");
+        return nullptr;
+    }
+    return pCompiler.get();
+#else
+    return nullptr;
+#endif
+}
+
+void ShaderCompilationService::CompileJob(UniqueJob& Job, Uint32 ThreadId)
+{
+    Timer CompileTimer;
+
+    auto& ShaderCI = Job.ShaderCI;
+    auto& Result   = Job.Result;
+
+    IDataBlob* pCompilerOutput = nullptr;
+    ShaderCI.ppCompilerOutput  = &pCompilerOutput;
+
+    try
+    {
+        switch (Job.Target)
+        {
+            case ShaderCompilationTarget::SPIRV:
+            {
+                std::vector<Uint32> SPIRV;
+                if (ShaderCI.ShaderCompiler == SHADER_COMPILER_DXC)
+                {
+                    if (auto* pDXCompiler = GetDXCompiler(ThreadId, Job.Target))
+                        pDXCompiler->Compile(ShaderCI, ShaderVersion{}, VulkanDefine, nullptr, &SPIRV, ShaderCI.ppCompilerOutput);
+                }
+                else
+                {
+#if SHADER_TOOLS_GLSLANG_SUPPORTED
+                    if (ShaderCI.SourceLanguage == SHADER_SOURCE_LANGUAGE_HLSL)
+                    {
+                        SPIRV = GLSLangUtils::HLSLtoSPIRV(ShaderCI, VulkanDefine, ShaderCI.ppCompilerOutput);
+                    }
+                    else if (ShaderCI.SourceLanguage == SHADER_SOURCE_LANGUAGE_GLSL_VERBATIM)
+                    {
+                        // Use the source as is, only add user macros
+                        RefCntAutoPtr<IDataBlob> pSourceFileData;
+                        size_t                   SourceLength = 0;
+
+                        const auto* ShaderSource = ReadShaderSourceFile(ShaderCI.Source, ShaderCI.pShaderSourceStreamFactory, ShaderCI.FilePath, pSourceFileData, SourceLength);
+                        SPIRV                    = GLSLangUtils::GLSLtoSPIRV(ShaderCI.Desc.ShaderType, ShaderSource, static_cast<int>(SourceLength),
+                                                          ShaderCI.Macros, ShaderCI.pShaderSourceStreamFactory, GLSLangUtils::SpirvVersion::Vk100,
+                                                          ShaderCI.ppCompilerOutput);
+                    }
+                    else
+                    {
+                        DeviceCaps VkCaps;
+                        VkCaps.DevType = RENDER_DEVICE_TYPE_VULKAN;
+
+                        const auto GLSLSource = AssembleGLSLSource(m_SourceAssemblers[ThreadId], ShaderCI, VkCaps, TargetGLSLCompiler::glslang, VulkanDefine);
+                        SPIRV                 = GLSLangUtils::GLSLtoSPIRV(ShaderCI.Desc.ShaderType, GLSLSource.Data, static_cast<int>(GLSLSource.Length),
+                                                          nullptr, ShaderCI.pShaderSourceStreamFactory, GLSLangUtils::SpirvVersion::Vk100,
+                                                          ShaderCI.ppCompilerOutput);
+                    }
+#else
+                    LOG_ERROR_MESSAGE("SPIRV target with glslang compiler is not supported in this build");
+#endif
+                }
+
+                if (!SPIRV.empty())
+                {
+                    Result.pByteCode = CreateDataBlob(SPIRV.data(), SPIRV.size() * sizeof(SPIRV[0]));
+
+#if SHADER_TOOLS_GLSLANG_SUPPORTED
+                    if (m_CI.SerializeSPIRVResources)
+                    {
+                        std::string EntryPoint;
+
+                        SPIRVShaderResources Resources //
+                            {
+                                DefaultRawMemoryAllocator::GetAllocator(),
+                                nullptr,
+                                SPIRV,
+                                ShaderCI.Desc,
+                                ShaderCI.UseCombinedTextureSamplers ? ShaderCI.CombinedSamplerSuffix : nullptr,
+                                ShaderCI.Desc.ShaderType == SHADER_TYPE_VERTEX,
+                                EntryPoint //
+                            };
+                        Resources.Serialize(EntryPoint.c_str(), &Result.pResources);
+                    }
+#endif
+                }
+                break;
+            }
+
+            case ShaderCompilationTarget::GLSL:
+            {
+#if SHADER_TOOLS_GLSL_SUPPORTED
+                if (ShaderCI.SourceLanguage == SHADER_SOURCE_LANGUAGE_GLSL_VERBATIM)
+                {
+                    if (Job.MacroStrings.size() > 0)
+                        LOG_WARNING_MESSAGE("Shader macros are ignored when compiling GLSL verbatim for the GLSL target");
+
+                    // Use the source as is
+                    RefCntAutoPtr<IDataBlob> pSourceFileData;
+                    size_t                   SourceLength = 0;
+
+                    const auto* ShaderSource = ReadShaderSourceFile(ShaderCI.Source, ShaderCI.pShaderSourceStreamFactory, ShaderCI.FilePath, pSourceFileData, SourceLength);
+                    Result.pByteCode         = CreateDataBlob(ShaderSource, SourceLength + 1);
+                    // The source read from the file may not be null-terminated
+                    static_cast<char*>(Result.pByteCode->GetDataPtr())[SourceLength] = '\0';
+                }
+                else if (ShaderCI.SourceLanguage == SHADER_SOURCE_LANGUAGE_HLSL)
+                {
+                    const auto GLSLSource = BuildGLSLSourceString(ShaderCI, m_CI.GLSLDeviceCaps, TargetGLSLCompiler::driver);
+                    if (!GLSLSource.empty())
+                        Result.pByteCode = CreateDataBlob(GLSLSource.c_str(), GLSLSource.length() + 1);
+                }
+                else
+                {
+                    const auto GLSLSource = AssembleGLSLSource(m_SourceAssemblers[ThreadId], ShaderCI, m_CI.GLSLDeviceCaps, TargetGLSLCompiler::driver);
+                    Result.pByteCode      = CreateDataBlob(GLSLSource.Data, GLSLSource.Length + 1);
+                }
+#else
+                LOG_ERROR_MESSAGE("GLSL target is not supported in this build");
+#endif
+                break;
+            }
+
+            case ShaderCompilationTarget::DXIL:
+            {
+                if (auto* pDXCompiler = GetDXCompiler(ThreadId, Job.Target))
+                {
+                    std::vector<Uint32> DXIL;
+                    pDXCompiler->Compile(ShaderCI, ShaderVersion{}, nullptr, nullptr, &DXIL, ShaderCI.ppCompilerOutput);
+                    if (!DXIL.empty())
+                        Result.pByteCode = CreateDataBlob(DXIL.data(), DXIL.size() * sizeof(DXIL[0]));
+                }
+                break;
+            }
+
+            default:
+                UNEXPECTED("Unexpected shader compilation target");
+        }
+    }
+    catch (const std::exception& e)
+    {
+        Result.pByteCode.Release();
+        Result.pResources.Release();
+        // Forward the error to the result unless the compiler has provided the output
+        if (pCompilerOutput == nullptr)
+            pCompilerOutput = CreateDataBlob(e.what(), strlen(e.what()) + 1).Detach();
+    }
+    catch (...)
+    {
+        Result.pByteCode.Release();
+        Result.pResources.Release();
+    }
+
+    ShaderCI.ppCompilerOutput = nullptr;
+    Result.pCompilerOutput.Attach(pCompilerOutput);
+    Result.Succeeded   = Result.pByteCode != nullptr;
+    Result.CompileTime = CompileTimer.GetElapsedTime();
+
+    {
+        std::lock_guard<std::mutex> Lock{m_JobsMtx};
+        Job.IsComplete = true;
+        m_TotalCompileTime += Result.CompileTime;
+    }
+
+    DeliverResults(Job);
+}
+
+void ShaderCompilationService::DeliverResults(UniqueJob& Job)
+{
+    // Callbacks are serialized by m_CallbackMtx. The job ids are taken under the same mutex
+    // so that results of one job are delivered in the order of submission.
+    std::lock_guard<std::mutex> CallbackLock{m_CallbackMtx};
+
+    std::vector<Uint32> JobIds;
+    {
+        std::lock_guard<std::mutex> Lock{m_JobsMtx};
+        std::swap(JobIds, Job.JobIds);
+    }
+
+    auto Result = Job.Result;
+    for (size_t i = 0; i < JobIds.size(); ++i)
+    {
+        Result.JobId       = JobIds[i];
+        Result.IsDuplicate = JobIds[i] != Job.FirstJobId;
+        if (m_CI.ResultCallback)
+            m_CI.ResultCallback(Result);
+    }
+
+    std::lock_guard<std::mutex> Lock{m_JobsMtx};
+    m_NumCompletedJobs += static_cast<Uint32>(JobIds.size());
+    if (!Result.Succeeded)
+        m_NumFailedJobs += static_cast<Uint32>(JobIds.size());
+}
+
+void ShaderCompilationService::WaitForCompletion()
+{
+    m_pThreadPool->WaitForAllTasks();
+}
+
+ShaderCompilationStats ShaderCompilationService::GetStats() const
+{
+    std::lock_guard<std::mutex> Lock{m_JobsMtx};
+
+    ShaderCompilationStats Stats;
+    Stats.NumJobs          = m_NumJobs;
+    Stats.NumUniqueJobs    = m_NumUniqueJobs;
+    Stats.NumCompletedJobs = m_NumCompletedJobs;
+    Stats.NumFailedJobs    = m_NumFailedJobs;
+    Stats.TotalCompileTime = m_TotalCompileTime;
+    Stats.ElapsedTime      = m_NumJobs > 0 ? m_Timer.GetElapsedTime() : 0;
+    return Stats;
+}
+
+} // namespace Diligent
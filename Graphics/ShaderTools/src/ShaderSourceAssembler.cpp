@@ -0,0 +1,165 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#include "ShaderSourceAssembler.hpp"
+
+#include <cstring>
+#include <algorithm>
+
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+const char   DefineDirective[]  = "#define ";
+const size_t DefineDirectiveLen = sizeof(DefineDirective) - 1;
+
+size_t GetMacrosLength(const ShaderMacro* Macros)
+{
+    size_t Length = 0;
+    if (Macros != nullptr)
+    {
+        // Same format as AppendShaderMacros(): "#define Name Definition\n"
+        for (auto* pMacro = Macros; pMacro->Name != nullptr && pMacro->Definition != nullptr; ++pMacro)
+            Length += DefineDirectiveLen + strlen(pMacro->Name) + 1 + strlen(pMacro->Definition) + 1;
+    }
+    return Length;
+}
+
+char* WriteMacros(char* pDst, const ShaderMacro* Macros)
+{
+    if (Macros == nullptr)
+        return pDst;
+
+    for (auto* pMacro = Macros; pMacro->Name != nullptr && pMacro->Definition != nullptr; ++pMacro)
+    {
+        memcpy(pDst, DefineDirective, DefineDirectiveLen);
+        pDst += DefineDirectiveLen;
+
+        const auto NameLen = strlen(pMacro->Name);
+        memcpy(pDst, pMacro->Name, NameLen);
+        pDst += NameLen;
+        *(pDst++) = ' ';
+
+        const auto DefLen = strlen(pMacro->Definition);
+        memcpy(pDst, pMacro->Definition, DefLen);
+        pDst += DefLen;
+        *(pDst++) = '\n';
+    }
+    return pDst;
+}
+
+} // namespace
+
+void ShaderSourceAssembler::ReserveArena(size_t Size)
+{
+    if (m_Arena.size() < Size)
+    {
+        // Grow geometrically so that permutations with slightly different
+        // macro blocks do not cause a reallocation every time.
+        m_Arena.resize(std::max(Size, m_Arena.size() + m_Arena.size() / 2));
+    }
+}
+
+void ShaderSourceAssembler::SetPrefix(const char* Prefix, size_t Length)
+{
+    m_PrefixLength = 0;
+    AppendPrefix(Prefix, Length);
+}
+
+void ShaderSourceAssembler::AppendPrefix(const char* Text, size_t Length)
+{
+    if (Text == nullptr)
+        return;
+
+    if (Length == 0)
+        Length = strlen(Text);
+
+    ReserveArena(m_PrefixLength + Length + 1);
+    memcpy(m_Arena.data() + m_PrefixLength, Text, Length);
+    m_PrefixLength += Length;
+}
+
+void ShaderSourceAssembler::AppendPrefixMacros(const ShaderMacro* Macros)
+{
+    const auto MacrosLength = GetMacrosLength(Macros);
+    ReserveArena(m_PrefixLength + MacrosLength + 1);
+
+    auto* pEnd = WriteMacros(m_Arena.data() + m_PrefixLength, Macros);
+    VERIFY_EXPR(pEnd == m_Arena.data() + m_PrefixLength + MacrosLength);
+    m_PrefixLength += MacrosLength;
+    (void)pEnd;
+}
+
+void ShaderSourceAssembler::SetSource(const char* Source, size_t Length)
+{
+    if (Source != nullptr && Length == 0)
+        Length = strlen(Source);
+
+    if (Source != nullptr)
+        m_Source.assign(Source, Source + Length);
+    else
+        m_Source.clear();
+}
+
+ShaderSourceView ShaderSourceAssembler::Assemble(const ShaderMacro* Macros)
+{
+    return Assemble(&Macros, 1);
+}
+
+ShaderSourceView ShaderSourceAssembler::Assemble(const ShaderMacro* const* MacroLists, size_t NumLists)
+{
+    size_t MacrosLength = 0;
+    for (size_t i = 0; i < NumLists; ++i)
+        MacrosLength += GetMacrosLength(MacroLists[i]);
+
+    const auto Length = m_PrefixLength + MacrosLength + m_Source.size();
+    ReserveArena(Length + 1);
+
+    // The prefix is already in place
+    auto* pDst = m_Arena.data() + m_PrefixLength;
+    for (size_t i = 0; i < NumLists; ++i)
+        pDst = WriteMacros(pDst, MacroLists[i]);
+
+    if (!m_Source.empty())
+    {
+        memcpy(pDst, m_Source.data(), m_Source.size());
+        pDst += m_Source.size();
+    }
+    *pDst = '\0';
+    VERIFY_EXPR(pDst == m_Arena.data() + Length);
+
+    ShaderSourceView View;
+    View.Data   = m_Arena.data();
+    View.Length = Length;
+    return View;
+}
+
+} // namespace Diligent
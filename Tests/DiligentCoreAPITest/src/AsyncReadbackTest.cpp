@@ -0,0 +1,260 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#include "AsyncReadback.h"
+
+#include <vector>
+#include <cstring>
+#include <chrono>
+
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+RefCntAutoPtr<IBuffer> CreateTestBuffer(IRenderDevice* pDevice, const std::vector<Uint8>& Data)
+{
+    BufferDesc Desc;
+    Desc.Name          = "Async readback test buffer";
+    Desc.BindFlags     = BIND_VERTEX_BUFFER;
+    Desc.uiSizeInBytes = static_cast<Uint32>(Data.size());
+
+    BufferData InitData{Data.data(), static_cast<Uint32>(Data.size())};
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    pDevice->CreateBuffer(Desc, &InitData, &pBuffer);
+    return pBuffer;
+}
+
+std::vector<Uint8> MakeTestData(size_t Size, Uint32 Seed)
+{
+    std::vector<Uint8> Data(Size);
+    for (size_t i = 0; i < Size; ++i)
+        Data[i] = static_cast<Uint8>((i * 7 + Seed) & 0xFF);
+    return Data;
+}
+
+TEST(AsyncReadbackTest, ReadBuffer)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    const auto Data    = MakeTestData(4096, 3);
+    auto       pBuffer = CreateTestBuffer(pDevice, Data);
+    ASSERT_TRUE(pBuffer);
+
+    AsyncReadbackCreateInfo CI;
+    CI.StagingPageSize = 1024;
+
+    RefCntAutoPtr<IAsyncReadback> pReadback;
+    CreateAsyncReadback(pDevice, CI, &pReadback);
+    ASSERT_TRUE(pReadback);
+
+    struct Region
+    {
+        Uint32 Offset;
+        Uint32 Size;
+    };
+    // The last region does not fit into a staging page and uses a dedicated buffer
+    const Region Regions[] = {{0, 16}, {100, 200}, {1000, 1000}, {17, 3}, {0, 4096}};
+
+    std::vector<Uint64> CompletedIds;
+    for (const auto& R : Regions)
+    {
+        auto Id = pReadback->ReadBuffer(
+            pContext, pBuffer, R.Offset, R.Size, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+            [&, R](const AsyncReadbackData& ReadbackData) //
+            {
+                CompletedIds.push_back(ReadbackData.RequestId);
+                ASSERT_NE(ReadbackData.pData, nullptr);
+                ASSERT_EQ(ReadbackData.DataSize, R.Size);
+                EXPECT_EQ(memcmp(ReadbackData.pData, &Data[R.Offset], R.Size), 0);
+            });
+        EXPECT_NE(Id, Uint64{0});
+    }
+    EXPECT_EQ(pReadback->GetNumPendingReadbacks(), _countof(Regions));
+
+    // Out of range requests are rejected
+    TestingEnvironment::SetErrorAllowance(2);
+    EXPECT_EQ(pReadback->ReadBuffer(pContext, pBuffer, 4000, 100, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, nullptr), Uint64{0});
+    EXPECT_EQ(pReadback->ReadBuffer(pContext, pBuffer, 0, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, nullptr), Uint64{0});
+
+    pReadback->WaitForAllReadbacks(pContext);
+    EXPECT_EQ(pReadback->GetNumPendingReadbacks(), Uint32{0});
+    ASSERT_EQ(CompletedIds.size(), _countof(Regions));
+    for (size_t i = 1; i < CompletedIds.size(); ++i)
+        EXPECT_LT(CompletedIds[i - 1], CompletedIds[i]);
+}
+
+TEST(AsyncReadbackTest, FramesInFlight)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    const auto Data    = MakeTestData(1024, 11);
+    auto       pBuffer = CreateTestBuffer(pDevice, Data);
+    ASSERT_TRUE(pBuffer);
+
+    AsyncReadbackCreateInfo CI;
+    CI.StagingPageSize   = 512;
+    CI.MaxFramesInFlight = 2;
+
+    RefCntAutoPtr<IAsyncReadback> pReadback;
+    CreateAsyncReadback(pDevice, CI, &pReadback);
+    ASSERT_TRUE(pReadback);
+
+    constexpr Uint32 NumFrames        = 16;
+    constexpr Uint32 RequestsPerFrame = 4;
+
+    Uint32 NumCompleted = 0;
+    for (Uint32 frame = 0; frame < NumFrames; ++frame)
+    {
+        for (Uint32 r = 0; r < RequestsPerFrame; ++r)
+        {
+            const Uint32 Offset = (frame * 64 + r * 128) % 768;
+            pReadback->ReadBuffer(pContext, pBuffer, Offset, 256, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                                  [&, Offset](const AsyncReadbackData& ReadbackData) //
+                                  {
+                                      ++NumCompleted;
+                                      ASSERT_NE(ReadbackData.pData, nullptr);
+                                      EXPECT_EQ(memcmp(ReadbackData.pData, &Data[Offset], 256), 0);
+                                  });
+        }
+        auto FenceValue = pReadback->FinishFrame(pContext);
+        EXPECT_EQ(FenceValue, Uint64{frame + 1});
+        EXPECT_LE(pReadback->GetNumPendingReadbacks(), CI.MaxFramesInFlight * RequestsPerFrame);
+        pContext->Flush();
+    }
+
+    pReadback->WaitForAllReadbacks(pContext);
+    EXPECT_EQ(NumCompleted, NumFrames * RequestsPerFrame);
+    EXPECT_EQ(pReadback->GetFence()->GetCompletedValue(), Uint64{NumFrames});
+}
+
+TEST(AsyncReadbackTest, ReadTexture)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    constexpr Uint32 Width  = 128;
+    constexpr Uint32 Height = 64;
+
+    const auto Data = MakeTestData(Width * Height * 4, 5);
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "Async readback test texture";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width     = Width;
+    TexDesc.Height    = Height;
+    TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+
+    TextureSubResData SubresData{Data.data(), Width * 4};
+    TextureData       InitData{&SubresData, 1};
+
+    RefCntAutoPtr<ITexture> pTexture;
+    pDevice->CreateTexture(TexDesc, &InitData, &pTexture);
+    ASSERT_TRUE(pTexture);
+
+    RefCntAutoPtr<IAsyncReadback> pReadback;
+    CreateAsyncReadback(pDevice, AsyncReadbackCreateInfo{}, &pReadback);
+    ASSERT_TRUE(pReadback);
+
+    AsyncReadbackTextureAttribs Attribs;
+    Attribs.pTexture = pTexture;
+
+    auto FullImage = ReadTextureAsync(pReadback, pContext, Attribs);
+
+    const Box Region{16, 48, 8, 40, 0, 1};
+    Attribs.pRegion = &Region;
+    auto SubImage   = ReadTextureAsync(pReadback, pContext, Attribs);
+
+    pReadback->WaitForAllReadbacks(pContext);
+
+    auto VerifyImage = [&](const AsyncReadbackResult& Res, const Box& R) //
+    {
+        ASSERT_FALSE(Res.Data.empty());
+        ASSERT_EQ(Res.Width, R.MaxX - R.MinX);
+        ASSERT_EQ(Res.Height, R.MaxY - R.MinY);
+        EXPECT_EQ(Res.Format, TEX_FORMAT_RGBA8_UNORM);
+        ASSERT_GE(Res.RowStride, Res.Width * 4);
+        ASSERT_GE(Res.Data.size(), (Res.Height - 1) * Res.RowStride + Res.Width * 4);
+        for (Uint32 y = 0; y < Res.Height; ++y)
+        {
+            const auto* pRow    = &Res.Data[y * Res.RowStride];
+            const auto* pRefRow = &Data[((R.MinY + y) * Width + R.MinX) * 4];
+            EXPECT_EQ(memcmp(pRow, pRefRow, Res.Width * 4), 0) << "Row " << y;
+        }
+    };
+
+    ASSERT_EQ(FullImage.wait_for(std::chrono::seconds{0}), std::future_status::ready);
+    ASSERT_EQ(SubImage.wait_for(std::chrono::seconds{0}), std::future_status::ready);
+    VerifyImage(FullImage.get(), Box{0, Width, 0, Height, 0, 1});
+    VerifyImage(SubImage.get(), Region);
+}
+
+TEST(AsyncReadbackTest, Cancel)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    const auto Data    = MakeTestData(256, 1);
+    auto       pBuffer = CreateTestBuffer(pDevice, Data);
+    ASSERT_TRUE(pBuffer);
+
+    RefCntAutoPtr<IAsyncReadback> pReadback;
+    CreateAsyncReadback(pDevice, AsyncReadbackCreateInfo{}, &pReadback);
+    ASSERT_TRUE(pReadback);
+
+    auto Future = ReadBufferAsync(pReadback, pContext, pBuffer, 0, 256);
+
+    // Requests that are pending when the object is destroyed are cancelled
+    pReadback.Release();
+    ASSERT_EQ(Future.wait_for(std::chrono::seconds{0}), std::future_status::ready);
+    EXPECT_TRUE(Future.get().Data.empty());
+
+    pContext->WaitForIdle();
+}
+
+} // namespace
@@ -0,0 +1,163 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#include "BindlessResourceTable.h"
+
+#include <vector>
+#include <algorithm>
+#include <thread>
+
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+RefCntAutoPtr<ISampler> CreateTestSampler(IRenderDevice* pDevice, FILTER_TYPE Filter)
+{
+    SamplerDesc SamDesc;
+    SamDesc.Name      = "Bindless resource table test sampler";
+    SamDesc.MinFilter = Filter;
+    SamDesc.MagFilter = Filter;
+    SamDesc.MipFilter = Filter;
+
+    RefCntAutoPtr<ISampler> pSampler;
+    pDevice->CreateSampler(SamDesc, &pSampler);
+    return pSampler;
+}
+
+TEST(BindlessResourceTableTest, AllocateAndFree)
+{
+    auto* const pEnv    = TestingEnvironment::GetInstance();
+    auto* const pDevice = pEnv->GetDevice();
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    auto pDefaultSampler = CreateTestSampler(pDevice, FILTER_TYPE_POINT);
+    auto pSampler        = CreateTestSampler(pDevice, FILTER_TYPE_LINEAR);
+    ASSERT_NE(pDefaultSampler, nullptr);
+    ASSERT_NE(pSampler, nullptr);
+
+    BindlessResourceTableCreateInfo CI;
+    CI.Name           = "Bindless resource table test";
+    CI.Capacity       = 4;
+    CI.pDefaultObject = pDefaultSampler;
+
+    RefCntAutoPtr<IBindlessResourceTable> pTable;
+    CreateBindlessResourceTable(CI, &pTable);
+    ASSERT_NE(pTable, nullptr);
+    EXPECT_EQ(pTable->GetCapacity(), 4u);
+    EXPECT_EQ(pTable->GetAllocatedSlotCount(), 0u);
+
+    // Slots are handed out starting from zero
+    for (Uint32 i = 0; i < CI.Capacity; ++i)
+        EXPECT_EQ(pTable->Allocate(pSampler), i);
+    EXPECT_EQ(pTable->GetAllocatedSlotCount(), 4u);
+
+    EXPECT_EQ(pTable->Allocate(pSampler), InvalidBindlessSlot);
+
+    const auto Version = pTable->GetVersion();
+    pTable->Free(2);
+    EXPECT_GT(pTable->GetVersion(), Version);
+    EXPECT_EQ(pTable->GetAllocatedSlotCount(), 3u);
+
+    // The freed slot is reused
+    EXPECT_EQ(pTable->Allocate(nullptr), 2u);
+    pTable->Update(2, pSampler);
+    EXPECT_EQ(pTable->GetAllocatedSlotCount(), 4u);
+
+    // The table keeps the objects alive
+    pSampler.Release();
+    pTable.Release();
+}
+
+TEST(BindlessResourceTableTest, AllocateMultithreaded)
+{
+    auto* const pEnv    = TestingEnvironment::GetInstance();
+    auto* const pDevice = pEnv->GetDevice();
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    auto pDefaultSampler = CreateTestSampler(pDevice, FILTER_TYPE_POINT);
+    auto pSampler        = CreateTestSampler(pDevice, FILTER_TYPE_LINEAR);
+    ASSERT_NE(pDefaultSampler, nullptr);
+    ASSERT_NE(pSampler, nullptr);
+
+    const size_t NumThreads     = std::max(std::thread::hardware_concurrency(), 2u);
+    const Uint32 SlotsPerThread = 64;
+    const Uint32 NumIterations  = 8;
+
+    BindlessResourceTableCreateInfo CI;
+    CI.Name           = "Bindless resource table MT test";
+    CI.Capacity       = static_cast<Uint32>(NumThreads) * SlotsPerThread;
+    CI.pDefaultObject = pDefaultSampler;
+
+    RefCntAutoPtr<IBindlessResourceTable> pTable;
+    CreateBindlessResourceTable(CI, &pTable);
+    ASSERT_NE(pTable, nullptr);
+
+    std::vector<std::vector<Uint32>> ThreadSlots(NumThreads);
+    std::vector<std::thread>         Threads(NumThreads);
+    for (size_t t = 0; t < NumThreads; ++t)
+    {
+        Threads[t] = std::thread{
+            [&](size_t ThreadId) //
+            {
+                auto& Slots = ThreadSlots[ThreadId];
+                for (Uint32 i = 0; i < NumIterations; ++i)
+                {
+                    // Free the slots allocated in the previous iteration
+                    for (auto Slot : Slots)
+                        pTable->Free(Slot);
+                    Slots.clear();
+
+                    for (Uint32 s = 0; s < SlotsPerThread; ++s)
+                        Slots.push_back(pTable->Allocate(pSampler));
+                }
+            },
+            t //
+        };
+    }
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    EXPECT_EQ(pTable->GetAllocatedSlotCount(), CI.Capacity);
+
+    std::vector<Uint32> AllSlots;
+    for (const auto& Slots : ThreadSlots)
+        AllSlots.insert(AllSlots.end(), Slots.begin(), Slots.end());
+    std::sort(AllSlots.begin(), AllSlots.end());
+    ASSERT_EQ(AllSlots.size(), size_t{CI.Capacity});
+    for (Uint32 i = 0; i < CI.Capacity; ++i)
+        EXPECT_EQ(AllSlots[i], i);
+}
+
+} // namespace
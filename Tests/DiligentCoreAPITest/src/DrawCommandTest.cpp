@@ -1482,4 +1482,95 @@ TEST_F(DrawCommandTest, DrawIndexedInstancedIndirect_FirstInstance_BaseVertex_Fi
     Present();
 }
 
+TEST_F(DrawCommandTest, DrawIndirect_MultiDraw_Stride)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceCaps().Features.IndirectRendering)
+        GTEST_SKIP() << "Indirect rendering is not supported on this device";
+
+    auto* pContext = pEnv->GetDeviceContext();
+
+    SetRenderTargets(sm_pDrawPSO);
+
+    // clang-format off
+    const Vertex Triangles[] =
+    {
+        Vert[0], Vert[1], Vert[2],
+        Vert[3], Vert[4], Vert[5]
+    };
+    // clang-format on
+
+    auto     pVB       = CreateVertexBuffer(Triangles, sizeof(Triangles));
+    IBuffer* pVBs[]    = {pVB};
+    Uint32   Offsets[] = {0};
+    pContext->SetVertexBuffers(0, 1, pVBs, Offsets, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
+
+    Uint32 IndirectDrawData[] =
+        {
+            0, 0, 0, 0, // Offset
+
+            3, 1, 0, 0, // NumVertices, NumInstances, StartVertexLocation, FirstInstanceLocation
+            0, 0,       // Padding
+
+            3, 1, 3, 0, // NumVertices, NumInstances, StartVertexLocation, FirstInstanceLocation
+            0, 0        // Padding
+        };
+    auto pIndirectArgsBuff = CreateIndirectDrawArgsBuffer(IndirectDrawData, sizeof(IndirectDrawData));
+
+    DrawIndirectAttribs drawAttrs{DRAW_FLAG_VERIFY_ALL, RESOURCE_STATE_TRANSITION_MODE_TRANSITION};
+    drawAttrs.IndirectDrawArgsOffset = 4 * sizeof(Uint32);
+    drawAttrs.DrawCount              = 2;
+    drawAttrs.DrawArgsStride         = 6 * sizeof(Uint32);
+    pContext->DrawIndirect(drawAttrs, pIndirectArgsBuff);
+
+    Present();
+}
+
+TEST_F(DrawCommandTest, DrawIndirect_CounterBuffer)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceCaps().Features.DrawIndirectCounterBuffer)
+        GTEST_SKIP() << "Indirect draw counter buffer is not supported on this device";
+
+    auto* pContext = pEnv->GetDeviceContext();
+
+    SetRenderTargets(sm_pDrawPSO);
+
+    // clang-format off
+    const Vertex Triangles[] =
+    {
+        Vert[0], Vert[1], Vert[2],
+        Vert[3], Vert[4], Vert[5],
+        VertInst[0], VertInst[1], VertInst[2] // Must not be drawn
+    };
+    // clang-format on
+
+    auto     pVB       = CreateVertexBuffer(Triangles, sizeof(Triangles));
+    IBuffer* pVBs[]    = {pVB};
+    Uint32   Offsets[] = {0};
+    pContext->SetVertexBuffers(0, 1, pVBs, Offsets, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
+
+    Uint32 IndirectDrawData[] =
+        {
+            3, 1, 0, 0, // NumVertices, NumInstances, StartVertexLocation, FirstInstanceLocation
+            3, 1, 3, 0,
+            3, 1, 6, 0  // Skipped by the counter
+        };
+    auto pIndirectArgsBuff = CreateIndirectDrawArgsBuffer(IndirectDrawData, sizeof(IndirectDrawData));
+
+    Uint32 CounterData[] = {0, 2};
+    auto   pCounterBuff  = CreateIndirectDrawArgsBuffer(CounterData, sizeof(CounterData));
+
+    DrawIndirectAttribs drawAttrs{DRAW_FLAG_VERIFY_ALL, RESOURCE_STATE_TRANSITION_MODE_TRANSITION};
+    drawAttrs.DrawCount                        = 3;
+    drawAttrs.pCounterBuffer                   = pCounterBuff;
+    drawAttrs.CounterOffset                    = sizeof(Uint32);
+    drawAttrs.CounterBufferStateTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+    pContext->DrawIndirect(drawAttrs, pIndirectArgsBuff);
+
+    Present();
+}
+
 } // namespace
@@ -0,0 +1,103 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TEST(FenceTest, DeviceWaitForFence)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    FenceDesc Desc;
+    Desc.Name = "Device wait test fence";
+    RefCntAutoPtr<IFence> pFence;
+    pDevice->CreateFence(Desc, &pFence);
+    ASSERT_TRUE(pFence);
+
+    for (Uint64 Value = 1; Value <= 3; ++Value)
+    {
+        pContext->SignalFence(pFence, Value);
+        pContext->Flush();
+
+        // Waiting on the same queue must not deadlock, and the fence must be complete
+        // once the commands submitted after the wait have finished.
+        pContext->DeviceWaitForFence(pFence, Value);
+        pContext->Flush();
+    }
+
+    pContext->WaitForIdle();
+    EXPECT_GE(pFence->GetCompletedValue(), Uint64{3});
+}
+
+TEST(FenceTest, ResetAndDeviceWaitForFence)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    FenceDesc Desc;
+    Desc.Name = "Reset and device wait test fence";
+    RefCntAutoPtr<IFence> pFence;
+    pDevice->CreateFence(Desc, &pFence);
+    ASSERT_TRUE(pFence);
+
+    pContext->SignalFence(pFence, 1);
+    pContext->Flush();
+    pContext->DeviceWaitForFence(pFence, 1);
+    pContext->Flush();
+    pContext->WaitForIdle();
+
+    // The value set on the CPU must be visible to the GPU wait, which otherwise never completes
+    pFence->Reset(5);
+    EXPECT_EQ(pFence->GetCompletedValue(), Uint64{5});
+    pContext->DeviceWaitForFence(pFence, 5);
+    pContext->Flush();
+    pContext->WaitForIdle();
+
+    // Values signaled after the reset must still be waited for
+    pContext->SignalFence(pFence, 6);
+    pContext->Flush();
+    pContext->DeviceWaitForFence(pFence, 6);
+    pContext->Flush();
+    pContext->WaitForIdle();
+    EXPECT_GE(pFence->GetCompletedValue(), Uint64{6});
+}
+
+} // namespace
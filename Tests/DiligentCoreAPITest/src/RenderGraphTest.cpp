@@ -0,0 +1,140 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#include "RenderGraph.hpp"
+
+#include <vector>
+#include <cstring>
+
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TEST(RenderGraphTest, CopyChain)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    constexpr Uint32 BufferSize = 1024;
+
+    std::vector<Uint8> RefData(BufferSize);
+    for (size_t i = 0; i < RefData.size(); ++i)
+        RefData[i] = static_cast<Uint8>((i * 13 + 5) & 0xFF);
+
+    BufferDesc SrcDesc;
+    SrcDesc.Name          = "Render graph test source buffer";
+    SrcDesc.BindFlags     = BIND_VERTEX_BUFFER;
+    SrcDesc.uiSizeInBytes = BufferSize;
+
+    BufferData InitData{RefData.data(), BufferSize};
+
+    RefCntAutoPtr<IBuffer> pSrcBuffer;
+    pDevice->CreateBuffer(SrcDesc, &InitData, &pSrcBuffer);
+    ASSERT_TRUE(pSrcBuffer);
+
+    BufferDesc StagingDesc;
+    StagingDesc.Name           = "Render graph test staging buffer";
+    StagingDesc.Usage          = USAGE_STAGING;
+    StagingDesc.CPUAccessFlags = CPU_ACCESS_READ;
+    StagingDesc.uiSizeInBytes  = BufferSize;
+
+    RefCntAutoPtr<IBuffer> pStagingBuffer;
+    pDevice->CreateBuffer(StagingDesc, nullptr, &pStagingBuffer);
+    ASSERT_TRUE(pStagingBuffer);
+
+    BufferDesc TransientDesc;
+    TransientDesc.BindFlags     = BIND_VERTEX_BUFFER;
+    TransientDesc.uiSizeInBytes = BufferSize;
+
+    RenderGraph Graph;
+
+    bool CulledPassExecuted = false;
+    for (Uint32 Frame = 0; Frame < 2; ++Frame)
+    {
+        Graph.Reset();
+
+        auto Src     = Graph.ImportBuffer(pSrcBuffer);
+        auto Staging = Graph.ImportBuffer(pStagingBuffer);
+
+        TransientDesc.Name = "Render graph test buffer A";
+        auto A             = Graph.CreateBuffer(TransientDesc);
+        TransientDesc.Name = "Render graph test buffer B";
+        auto B             = Graph.CreateBuffer(TransientDesc);
+        TransientDesc.Name = "Render graph test buffer C";
+        auto C             = Graph.CreateBuffer(TransientDesc);
+
+        auto CopyBuffer = [](const RenderGraph::PassContext& Ctx, RenderGraphResourceId Src, RenderGraphResourceId Dst) {
+            Ctx.pContext->CopyBuffer(Ctx.GetBuffer(Src), 0, RESOURCE_STATE_TRANSITION_MODE_VERIFY,
+                                     Ctx.GetBuffer(Dst), 0, BufferSize, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+        };
+
+        auto Pass0 = Graph.AddPass("Src -> A", [&](const RenderGraph::PassContext& Ctx) { CopyBuffer(Ctx, Src, A); });
+        Graph.Read(Pass0, Src, RESOURCE_STATE_COPY_SOURCE);
+        Graph.Write(Pass0, A, RESOURCE_STATE_COPY_DEST);
+
+        auto Pass1 = Graph.AddPass("A -> B", [&](const RenderGraph::PassContext& Ctx) { CopyBuffer(Ctx, A, B); });
+        Graph.Read(Pass1, A, RESOURCE_STATE_COPY_SOURCE);
+        Graph.Write(Pass1, B, RESOURCE_STATE_COPY_DEST);
+
+        // The result of this pass is never used
+        auto Pass2 = Graph.AddPass("A -> C", [&](const RenderGraph::PassContext&) { CulledPassExecuted = true; });
+        Graph.Read(Pass2, A, RESOURCE_STATE_COPY_SOURCE);
+        Graph.Write(Pass2, C, RESOURCE_STATE_COPY_DEST);
+
+        auto Pass3 = Graph.AddPass("B -> Staging", [&](const RenderGraph::PassContext& Ctx) { CopyBuffer(Ctx, B, Staging); });
+        Graph.Read(Pass3, B, RESOURCE_STATE_COPY_SOURCE);
+        Graph.Write(Pass3, Staging, RESOURCE_STATE_COPY_DEST);
+
+        ASSERT_TRUE(Graph.Execute(pDevice, pContext));
+        EXPECT_TRUE(Graph.IsPassCulled(Pass2));
+        EXPECT_EQ(Graph.GetBuffer(C), nullptr);
+        EXPECT_NE(Graph.GetBuffer(A), Graph.GetBuffer(B));
+
+        pContext->WaitForIdle();
+
+        void* pData = nullptr;
+        pContext->MapBuffer(pStagingBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pData);
+        ASSERT_NE(pData, nullptr);
+        EXPECT_EQ(memcmp(pData, RefData.data(), BufferSize), 0) << "Frame " << Frame;
+        pContext->UnmapBuffer(pStagingBuffer, MAP_READ);
+
+        // Transient buffers are reused between frames
+        EXPECT_EQ(Graph.GetPooledResourceCount(), 2u);
+    }
+    EXPECT_FALSE(CulledPassExecuted);
+}
+
+} // namespace
@@ -0,0 +1,369 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#include "BoundingVolumeHierarchy.hpp"
+#include "FastRand.hpp"
+#include "Timer.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+using BVH = BoundingVolumeHierarchy;
+
+// Triangle mesh that also serves as the ray intersector
+struct TestMesh
+{
+    std::vector<float3> Vertices;
+    std::vector<Uint32> Indices;
+
+    Uint32 GetNumTriangles() const { return static_cast<Uint32>(Indices.size() / 3); }
+
+    float operator()(const BVH::Ray& R, Uint32 TriId) const
+    {
+        return IntersectRayTriangle(Vertices[Indices[TriId * 3 + 0]], Vertices[Indices[TriId * 3 + 1]], Vertices[Indices[TriId * 3 + 2]],
+                                    R.Origin, R.Direction);
+    }
+
+    std::vector<BoundBox> ComputeBounds() const
+    {
+        std::vector<BoundBox> Boxes(GetNumTriangles());
+        BVH::ComputeTriangleBounds(Vertices.data(), Indices.data(), GetNumTriangles(), Boxes.data());
+        return Boxes;
+    }
+
+    // Closest hit distance computed by testing every triangle
+    float CastRayBruteForce(const BVH::Ray& R) const
+    {
+        float ClosestDist = R.MaxDist;
+        for (Uint32 t = 0; t < GetNumTriangles(); ++t)
+        {
+            const auto Dist = (*this)(R, t);
+            if (Dist >= 0 && Dist < ClosestDist)
+                ClosestDist = Dist;
+        }
+        return ClosestDist < R.MaxDist ? ClosestDist : FLT_MAX;
+    }
+};
+
+// Generates a height field of GridSize x GridSize vertices spanning [0, GridSize - 1] in X and Z
+TestMesh CreateTerrain(Uint32 GridSize, float Phase = 0)
+{
+    TestMesh Mesh;
+    Mesh.Vertices.reserve(GridSize * GridSize);
+    for (Uint32 z = 0; z < GridSize; ++z)
+    {
+        for (Uint32 x = 0; x < GridSize; ++x)
+        {
+            const float fx = static_cast<float>(x);
+            const float fz = static_cast<float>(z);
+            Mesh.Vertices.emplace_back(fx, std::sin(fx * 0.3f + Phase) * std::cos(fz * 0.2f) * 4.f, fz);
+        }
+    }
+
+    for (Uint32 z = 0; z + 1 < GridSize; ++z)
+    {
+        for (Uint32 x = 0; x + 1 < GridSize; ++x)
+        {
+            const Uint32 i00 = z * GridSize + x;
+            const Uint32 i10 = i00 + 1;
+            const Uint32 i01 = i00 + GridSize;
+            const Uint32 i11 = i01 + 1;
+
+            const Uint32 Quad[] = {i00, i01, i10, i10, i01, i11};
+            Mesh.Indices.insert(Mesh.Indices.end(), std::begin(Quad), std::end(Quad));
+        }
+    }
+    return Mesh;
+}
+
+std::vector<BVH::Ray> CreateRays(Uint32 NumRays, float GridSize, Uint32 Seed)
+{
+    FastRandFloat Rnd{Seed, 0, 1};
+
+    std::vector<BVH::Ray> Rays(NumRays);
+    for (auto& R : Rays)
+    {
+        R.Origin    = float3{Rnd() * GridSize, 10.f + Rnd() * 10.f, Rnd() * GridSize};
+        R.Direction = float3{Rnd() - 0.5f, -Rnd() - 0.1f, Rnd() - 0.5f};
+    }
+    return Rays;
+}
+
+void VerifyRays(const BVH& Tree, const TestMesh& Mesh, const std::vector<BVH::Ray>& Rays)
+{
+    Uint32 NumHits = 0;
+    for (size_t i = 0; i < Rays.size(); ++i)
+    {
+        const auto& R = Rays[i];
+
+        const auto RefDist = Mesh.CastRayBruteForce(R);
+        const auto Hit     = Tree.CastRay(R, Mesh);
+        ASSERT_EQ(Hit.Distance, RefDist) << "Ray " << i;
+        ASSERT_EQ(static_cast<bool>(Hit), RefDist != FLT_MAX) << "Ray " << i;
+        if (Hit)
+        {
+            ASSERT_EQ(Mesh(R, Hit.PrimitiveId), RefDist) << "Ray " << i;
+            ++NumHits;
+        }
+
+        const auto AnyHit = Tree.TestRay(R, Mesh);
+        ASSERT_EQ(AnyHit, RefDist != FLT_MAX) << "Ray " << i;
+    }
+    // Make sure that the test covers both outcomes
+    EXPECT_GT(NumHits, 0u);
+    EXPECT_LT(NumHits, Rays.size());
+}
+
+TEST(Common_BoundingVolumeHierarchy, Empty)
+{
+    BVH Tree;
+    Tree.Build(nullptr, 0);
+    EXPECT_EQ(Tree.GetNumNodes(), 0u);
+
+    BVH::Ray R;
+    R.Direction = float3{0, 0, 1};
+    EXPECT_FALSE(Tree.CastRay(R, [](const BVH::Ray&, Uint32) { return 0.f; }));
+
+    Tree.QueryBox(BoundBox{float3{-1, -1, -1}, float3{1, 1, 1}}, [](Uint32) {
+        ADD_FAILURE() << "Empty tree must not report primitives";
+        return true;
+    });
+}
+
+TEST(Common_BoundingVolumeHierarchy, CoincidentPrimitives)
+{
+    const std::vector<BoundBox> Boxes(37, BoundBox{float3{0, 0, 0}, float3{1, 1, 1}});
+
+    BVH Tree;
+    Tree.Build(Boxes.data(), static_cast<Uint32>(Boxes.size()));
+    EXPECT_EQ(Tree.GetNumPrimitives(), 37u);
+
+    std::vector<Uint32> Found;
+    Tree.QueryBox(BoundBox{float3{0.5f, 0.5f, 0.5f}, float3{2, 2, 2}}, [&](Uint32 PrimId) {
+        Found.push_back(PrimId);
+        return true;
+    });
+    std::sort(Found.begin(), Found.end());
+    ASSERT_EQ(Found.size(), Boxes.size());
+    for (Uint32 i = 0; i < Found.size(); ++i)
+        EXPECT_EQ(Found[i], i);
+
+    // The query stops when the callback returns false
+    Uint32 NumCalls = 0;
+    Tree.QueryBox(BoundBox{float3{0, 0, 0}, float3{1, 1, 1}}, [&](Uint32) { return ++NumCalls < 5; });
+    EXPECT_EQ(NumCalls, 5u);
+}
+
+TEST(Common_BoundingVolumeHierarchy, RayQueries)
+{
+    const auto Mesh  = CreateTerrain(64);
+    const auto Boxes = Mesh.ComputeBounds();
+
+    BVH Tree;
+    Tree.Build(Boxes.data(), Mesh.GetNumTriangles());
+    EXPECT_EQ(Tree.GetNumPrimitives(), Mesh.GetNumTriangles());
+
+    const auto Bounds = Tree.GetBounds();
+    EXPECT_EQ(Bounds.Min.x, 0.f);
+    EXPECT_EQ(Bounds.Max.x, 63.f);
+    EXPECT_EQ(Bounds.Min.z, 0.f);
+    EXPECT_EQ(Bounds.Max.z, 63.f);
+
+    auto Rays = CreateRays(2000, 64, 0);
+    // Limit the distance of some rays
+    for (size_t i = 0; i < Rays.size(); i += 3)
+        Rays[i].MaxDist = 5;
+    VerifyRays(Tree, Mesh, Rays);
+}
+
+TEST(Common_BoundingVolumeHierarchy, ParallelBuild)
+{
+    const auto Mesh  = CreateTerrain(200);
+    const auto Boxes = Mesh.ComputeBounds();
+
+    ThreadPool Pool{4};
+
+    BVH RefTree;
+    RefTree.Build(Boxes.data(), Mesh.GetNumTriangles());
+    BVH Tree;
+    Tree.Build(Boxes.data(), Mesh.GetNumTriangles(), &Pool);
+    EXPECT_EQ(Tree.GetNumNodes(), RefTree.GetNumNodes());
+
+    const auto Rays = CreateRays(10000, 200, 1);
+
+    std::vector<BVH::RayHit> RefHits(Rays.size());
+    RefTree.CastRays(Rays.data(), static_cast<Uint32>(Rays.size()), RefHits.data(), Mesh);
+    std::vector<BVH::RayHit> Hits(Rays.size());
+    Tree.CastRays(Rays.data(), static_cast<Uint32>(Rays.size()), Hits.data(), Mesh, &Pool);
+
+    for (size_t i = 0; i < Rays.size(); ++i)
+    {
+        ASSERT_EQ(Hits[i].PrimitiveId, RefHits[i].PrimitiveId) << "Ray " << i;
+        ASSERT_EQ(Hits[i].Distance, RefHits[i].Distance) << "Ray " << i;
+    }
+}
+
+TEST(Common_BoundingVolumeHierarchy, Refit)
+{
+    auto       Mesh  = CreateTerrain(64);
+    const auto Boxes = Mesh.ComputeBounds();
+
+    BVH Tree;
+    Tree.Build(Boxes.data(), Mesh.GetNumTriangles());
+
+    const auto Rays = CreateRays(1000, 64, 2);
+    for (Uint32 Frame = 1; Frame <= 3; ++Frame)
+    {
+        // Animate the terrain and lift it up
+        Mesh = CreateTerrain(64, static_cast<float>(Frame));
+        for (auto& V : Mesh.Vertices)
+            V.y += static_cast<float>(Frame);
+
+        const auto NewBoxes = Mesh.ComputeBounds();
+        Tree.Refit(NewBoxes.data());
+        EXPECT_EQ(Tree.GetBounds().Min.y, std::min_element(Mesh.Vertices.begin(), Mesh.Vertices.end(), [](const float3& V0, const float3& V1) { return V0.y < V1.y; })->y);
+        VerifyRays(Tree, Mesh, Rays);
+    }
+}
+
+TEST(Common_BoundingVolumeHierarchy, BoxQueries)
+{
+    const auto Mesh  = CreateTerrain(64);
+    const auto Boxes = Mesh.ComputeBounds();
+
+    BVH Tree;
+    Tree.Build(Boxes.data(), Mesh.GetNumTriangles());
+
+    FastRandFloat         Rnd{3, 0, 1};
+    std::vector<BoundBox> QueryBoxes(500);
+    for (auto& Box : QueryBoxes)
+    {
+        const float3 Center{Rnd() * 70 - 3, Rnd() * 10 - 5, Rnd() * 70 - 3};
+        const float3 Extent{Rnd() * 3, Rnd() * 3, Rnd() * 3};
+        Box = BoundBox{Center - Extent, Center + Extent};
+    }
+
+    ThreadPool                       Pool{4};
+    std::vector<std::vector<Uint32>> Results(QueryBoxes.size());
+    Tree.QueryBoxes(
+        QueryBoxes.data(), static_cast<Uint32>(QueryBoxes.size()), [&](Uint32 BoxIdx, Uint32 PrimId) {
+            Results[BoxIdx].push_back(PrimId);
+            return true;
+        },
+        &Pool);
+
+    size_t NumFound = 0;
+    for (size_t i = 0; i < QueryBoxes.size(); ++i)
+    {
+        const auto& Query = QueryBoxes[i];
+
+        std::vector<Uint32> RefResult;
+        for (Uint32 t = 0; t < Mesh.GetNumTriangles(); ++t)
+        {
+            const auto& Box = Boxes[t];
+            // clang-format off
+            if (Box.Min.x <= Query.Max.x && Box.Max.x >= Query.Min.x &&
+                Box.Min.y <= Query.Max.y && Box.Max.y >= Query.Min.y &&
+                Box.Min.z <= Query.Max.z && Box.Max.z >= Query.Min.z)
+                RefResult.push_back(t);
+            // clang-format on
+        }
+
+        auto& Result = Results[i];
+        std::sort(Result.begin(), Result.end());
+        ASSERT_EQ(Result, RefResult) << "Box " << i;
+        NumFound += Result.size();
+    }
+    EXPECT_GT(NumFound, size_t{0});
+}
+
+// Reports ray casting throughput on a generated mesh
+TEST(Common_BoundingVolumeHierarchy, DISABLED_Performance)
+{
+    constexpr Uint32 GridSize = 256;
+    constexpr Uint32 NumRays  = 200000;
+
+    const auto Mesh  = CreateTerrain(GridSize);
+    const auto Boxes = Mesh.ComputeBounds();
+    const auto Rays  = CreateRays(NumRays, static_cast<float>(GridSize), 4);
+
+    ThreadPool Pool;
+
+    BVH    Tree;
+    double BuildTime   = 0;
+    double MTBuildTime = 0;
+    {
+        Timer T;
+        Tree.Build(Boxes.data(), Mesh.GetNumTriangles());
+        BuildTime = T.GetElapsedTime();
+    }
+    {
+        Timer T;
+        Tree.Build(Boxes.data(), Mesh.GetNumTriangles(), &Pool);
+        MTBuildTime = T.GetElapsedTime();
+    }
+
+    std::vector<BVH::RayHit> Hits(NumRays);
+    double                   CastTime = 0;
+    {
+        Timer T;
+        Tree.CastRays(Rays.data(), NumRays, Hits.data(), Mesh);
+        CastTime = T.GetElapsedTime();
+    }
+    double MTCastTime = 0;
+    {
+        Timer T;
+        Tree.CastRays(Rays.data(), NumRays, Hits.data(), Mesh, &Pool);
+        MTCastTime = T.GetElapsedTime();
+    }
+
+    // Brute force is only run on a few rays, which are also used to validate the results
+    constexpr Uint32 NumBruteForceRays = 100;
+    double           BruteForceTime    = 0;
+    {
+        Timer T;
+        for (Uint32 i = 0; i < NumBruteForceRays; ++i)
+            EXPECT_EQ(Mesh.CastRayBruteForce(Rays[i]), Hits[i].Distance) << "Ray " << i;
+        BruteForceTime = T.GetElapsedTime();
+    }
+
+    LOG_INFO_MESSAGE("BVH over ", Mesh.GetNumTriangles(), " triangles (", Tree.GetNumNodes(), " nodes):\n",
+                     "    Build:              ", BuildTime * 1000.0, " ms\n",
+                     "    Build (", Pool.GetNumThreads(), " threads):  ", MTBuildTime * 1000.0, " ms\n",
+                     "    Rays/sec:           ", static_cast<double>(NumRays) / CastTime, "\n",
+                     "    Rays/sec (", Pool.GetNumThreads(), " threads): ", static_cast<double>(NumRays) / MTCastTime, "\n",
+                     "    Brute force rays/sec: ", static_cast<double>(NumBruteForceRays) / BruteForceTime);
+}
+
+} // namespace
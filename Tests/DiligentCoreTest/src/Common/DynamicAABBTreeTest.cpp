@@ -0,0 +1,342 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#include "DynamicAABBTree.hpp"
+#include "FastRand.hpp"
+#include "Timer.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+struct TestObject
+{
+    DynamicAABBTree::ObjectId Id = DynamicAABBTree::InvalidObject;
+    BoundBox                  Box;
+};
+
+BoundBox CreateRandomBox(FastRandFloat& Rnd, float SceneSize)
+{
+    const float3 Center{Rnd() * SceneSize, Rnd() * SceneSize * 0.1f, Rnd() * SceneSize};
+    const float3 Extent{0.1f + Rnd(), 0.1f + Rnd(), 0.1f + Rnd()};
+    return BoundBox{Center - Extent, Center + Extent};
+}
+
+ViewFrustum CreateFrustum(const float3& Pos, float Yaw, float FarPlane)
+{
+    const auto View     = float4x4::Translation(-Pos) * float4x4::RotationY(Yaw);
+    const auto ViewProj = View * float4x4::Projection(PI_F / 3.f, 1.5f, 0.5f, FarPlane, false);
+
+    ViewFrustum Frustum;
+    ExtractViewFrustumPlanesFromMatrix(ViewProj, Frustum, false);
+    return Frustum;
+}
+
+// Verifies multi-view frustum queries against testing every object
+void VerifyFrustumQueries(const DynamicAABBTree& Tree, const std::vector<TestObject>& Objects, const std::vector<ViewFrustum>& Frustums)
+{
+    const FRUSTUM_PLANE_FLAGS PlaneFlags[] = {FRUSTUM_PLANE_FLAG_FULL_FRUSTUM, FRUSTUM_PLANE_FLAG_OPEN_NEAR, FRUSTUM_PLANE_FLAG_FULL_FRUSTUM, FRUSTUM_PLANE_FLAG_OPEN_NEAR};
+    ASSERT_LE(Frustums.size(), _countof(PlaneFlags));
+
+    std::vector<Uint32> ViewMasks;
+    Tree.QueryFrustums(
+        Frustums.data(), static_cast<Uint32>(Frustums.size()), [&](DynamicAABBTree::ObjectId Id, Uint32 ViewMask) {
+            if (Id >= ViewMasks.size())
+                ViewMasks.resize(Id + 1);
+            EXPECT_EQ(ViewMasks[Id], 0u) << "Object " << Id << " is reported more than once";
+            ViewMasks[Id] = ViewMask;
+        },
+        PlaneFlags);
+    ViewMasks.resize(std::max(ViewMasks.size(), Objects.size() * 2));
+
+    size_t NumVisible = 0;
+    for (const auto& Obj : Objects)
+    {
+        if (Obj.Id == DynamicAABBTree::InvalidObject)
+            continue;
+
+        Uint32 RefViewMask = 0;
+        for (Uint32 v = 0; v < Frustums.size(); ++v)
+        {
+            if (GetBoxVisibility(Frustums[v], Obj.Box, PlaneFlags[v]) != BoxVisibility::Invisible)
+                RefViewMask |= 1u << v;
+        }
+        ASSERT_EQ(ViewMasks[Obj.Id], RefViewMask) << "Object " << Obj.Id;
+        if (RefViewMask != 0)
+            ++NumVisible;
+    }
+    EXPECT_GT(NumVisible, size_t{0});
+    EXPECT_LT(NumVisible, Objects.size());
+
+    // Single view queries
+    std::vector<bool> IsVisible(ViewMasks.size());
+    Tree.QueryFrustum(Frustums[0], [&](DynamicAABBTree::ObjectId Id) { IsVisible[Id] = true; });
+    for (size_t i = 0; i < ViewMasks.size(); ++i)
+        ASSERT_EQ(IsVisible[i], (ViewMasks[i] & 0x01) != 0) << "Object " << i;
+}
+
+TEST(Common_DynamicAABBTree, InsertRemoveMove)
+{
+    DynamicAABBTree Tree{0.5f};
+    EXPECT_EQ(Tree.GetNumObjects(), 0u);
+    EXPECT_EQ(Tree.GetHeight(), 0u);
+
+    int        Data[3] = {};
+    const auto Id0     = Tree.Insert(BoundBox{float3{0, 0, 0}, float3{1, 1, 1}}, &Data[0]);
+    EXPECT_EQ(Tree.GetHeight(), 1u);
+    const auto Id1 = Tree.Insert(BoundBox{float3{5, 0, 0}, float3{6, 1, 1}}, &Data[1]);
+    const auto Id2 = Tree.Insert(BoundBox{float3{10, 0, 0}, float3{11, 1, 1}}, &Data[2]);
+    EXPECT_EQ(Tree.GetNumObjects(), 3u);
+    EXPECT_EQ(Tree.GetHeight(), 3u);
+    EXPECT_EQ(Tree.GetUserData(Id1), &Data[1]);
+    EXPECT_EQ(Tree.GetFatBox(Id0).Min, float3(-0.5f, -0.5f, -0.5f));
+    EXPECT_EQ(Tree.GetFatBox(Id0).Max, float3(1.5f, 1.5f, 1.5f));
+
+    // Small motion stays within the fat box
+    EXPECT_FALSE(Tree.Move(Id0, BoundBox{float3{0.25f, 0, 0}, float3{1.25f, 1, 1}}));
+    EXPECT_EQ(Tree.GetBox(Id0).Min, float3(0.25f, 0, 0));
+    EXPECT_EQ(Tree.GetFatBox(Id0).Min, float3(-0.5f, -0.5f, -0.5f));
+
+    // Large motion reinserts the object, extending the fat box in the direction of motion
+    EXPECT_TRUE(Tree.Move(Id0, BoundBox{float3{20, 0, 0}, float3{21, 1, 1}}, float3{2, 0, 0}));
+    EXPECT_EQ(Tree.GetFatBox(Id0).Min, float3(19.5f, -0.5f, -0.5f));
+    EXPECT_EQ(Tree.GetFatBox(Id0).Max, float3(23.5f, 1.5f, 1.5f));
+    EXPECT_EQ(Tree.GetUserData(Id0), &Data[0]);
+
+    std::vector<DynamicAABBTree::ObjectId> Found;
+    Tree.QueryBox(BoundBox{float3{19, 0, 0}, float3{20.5f, 1, 1}}, [&](DynamicAABBTree::ObjectId Id) {
+        Found.push_back(Id);
+        return true;
+    });
+    ASSERT_EQ(Found.size(), 1u);
+    EXPECT_EQ(Found[0], Id0);
+
+    Tree.Remove(Id1);
+    EXPECT_EQ(Tree.GetNumObjects(), 2u);
+    EXPECT_EQ(Tree.GetHeight(), 2u);
+
+    // Ids of removed objects are reused
+    const auto Id3 = Tree.Insert(BoundBox{float3{0, 0, 0}, float3{1, 1, 1}});
+    EXPECT_EQ(Tree.GetNumObjects(), 3u);
+    EXPECT_EQ(Tree.GetUserData(Id3), nullptr);
+
+    Tree.Remove(Id0);
+    Tree.Remove(Id2);
+    Tree.Remove(Id3);
+    EXPECT_EQ(Tree.GetNumObjects(), 0u);
+    EXPECT_EQ(Tree.GetHeight(), 0u);
+}
+
+TEST(Common_DynamicAABBTree, Balance)
+{
+    // Inserting objects in sorted order degenerates an unbalanced tree into a list
+    DynamicAABBTree  Tree{0};
+    constexpr Uint32 NumObjects = 10000;
+    for (Uint32 i = 0; i < NumObjects; ++i)
+    {
+        const auto x = static_cast<float>(i);
+        Tree.Insert(BoundBox{float3{x, 0, 0}, float3{x + 0.5f, 1, 1}});
+    }
+    // A perfectly balanced tree has the height of 15
+    EXPECT_LE(Tree.GetHeight(), 30u);
+}
+
+TEST(Common_DynamicAABBTree, Queries)
+{
+    constexpr float SceneSize = 200;
+
+    FastRandFloat           Rnd{0, 0, 1};
+    DynamicAABBTree         Tree{0.2f};
+    std::vector<TestObject> Objects(5000);
+    for (auto& Obj : Objects)
+    {
+        Obj.Box = CreateRandomBox(Rnd, SceneSize);
+        Obj.Id  = Tree.Insert(Obj.Box);
+    }
+
+    const std::vector<ViewFrustum> Frustums =
+        {
+            CreateFrustum(float3{100, 5, 100}, 0.f, 60.f),
+            CreateFrustum(float3{100, 5, 100}, 0.f, 120.f),
+            CreateFrustum(float3{50, 5, 150}, PI_F / 2.f, 200.f),
+            CreateFrustum(float3{150, 50, 20}, PI_F, 100.f),
+        };
+
+    for (Uint32 Frame = 0; Frame < 5; ++Frame)
+    {
+        VerifyFrustumQueries(Tree, Objects, Frustums);
+
+        for (Uint32 q = 0; q < 50; ++q)
+        {
+            const auto Query = CreateRandomBox(Rnd, SceneSize);
+
+            std::vector<DynamicAABBTree::ObjectId> Found;
+            Tree.QueryBox(Query, [&](DynamicAABBTree::ObjectId Id) {
+                Found.push_back(Id);
+                return true;
+            });
+            std::sort(Found.begin(), Found.end());
+
+            std::vector<DynamicAABBTree::ObjectId> RefFound;
+            for (const auto& Obj : Objects)
+            {
+                // clang-format off
+                if (Obj.Id != DynamicAABBTree::InvalidObject &&
+                    Obj.Box.Min.x <= Query.Max.x && Obj.Box.Max.x >= Query.Min.x &&
+                    Obj.Box.Min.y <= Query.Max.y && Obj.Box.Max.y >= Query.Min.y &&
+                    Obj.Box.Min.z <= Query.Max.z && Obj.Box.Max.z >= Query.Min.z)
+                    RefFound.push_back(Obj.Id);
+                // clang-format on
+            }
+            std::sort(RefFound.begin(), RefFound.end());
+            ASSERT_EQ(Found, RefFound);
+        }
+
+        // Move, remove and insert objects
+        for (auto& Obj : Objects)
+        {
+            const auto Action = Rnd();
+            if (Obj.Id == DynamicAABBTree::InvalidObject)
+            {
+                if (Action < 0.5f)
+                {
+                    Obj.Box = CreateRandomBox(Rnd, SceneSize);
+                    Obj.Id  = Tree.Insert(Obj.Box);
+                }
+            }
+            else if (Action < 0.05f)
+            {
+                Tree.Remove(Obj.Id);
+                Obj.Id = DynamicAABBTree::InvalidObject;
+            }
+            else if (Action < 0.5f)
+            {
+                const float3 Offset{Rnd() - 0.5f, Rnd() - 0.5f, Rnd() - 0.5f};
+                Obj.Box.Min += Offset;
+                Obj.Box.Max += Offset;
+                Tree.Move(Obj.Id, Obj.Box, Offset);
+            }
+            else if (Action < 0.55f)
+            {
+                Obj.Box = CreateRandomBox(Rnd, SceneSize);
+                Tree.Move(Obj.Id, Obj.Box);
+            }
+        }
+    }
+}
+
+// Compares the tree with testing every object against every view.
+// The test is disabled by default; run it with --gtest_also_run_disabled_tests.
+TEST(Common_DynamicAABBTree, DISABLED_Performance)
+{
+    constexpr float  SceneSize  = 2000;
+    constexpr Uint32 NumObjects = 200000;
+    constexpr Uint32 NumFrames  = 4;
+
+    FastRandFloat           Rnd{0, 0, 1};
+    DynamicAABBTree         Tree{0.5f};
+    std::vector<TestObject> Objects(NumObjects);
+
+    double InsertTime = 0;
+    {
+        Timer T;
+        for (auto& Obj : Objects)
+        {
+            Obj.Box = CreateRandomBox(Rnd, SceneSize);
+            Obj.Id  = Tree.Insert(Obj.Box);
+        }
+        InsertTime = T.GetElapsedTime();
+    }
+
+    // Main camera and three shadow cascades of growing size
+    const std::vector<ViewFrustum> Frustums =
+        {
+            CreateFrustum(float3{1000, 20, 1000}, 0.3f, 500.f),
+            CreateFrustum(float3{1000, 20, 1000}, 0.3f, 50.f),
+            CreateFrustum(float3{1000, 20, 1000}, 0.3f, 150.f),
+            CreateFrustum(float3{1000, 20, 1000}, 0.3f, 500.f),
+        };
+
+    double MoveTime   = 0;
+    double QueryTime  = 0;
+    double LinearTime = 0;
+    size_t NumVisible = 0;
+    size_t RefVisible = 0;
+    for (Uint32 Frame = 0; Frame < NumFrames; ++Frame)
+    {
+        {
+            Timer T;
+            // Move 10% of objects every frame
+            for (Uint32 i = Frame; i < NumObjects; i += 10)
+            {
+                auto&        Obj = Objects[i];
+                const float3 Offset{Rnd() - 0.5f, 0, Rnd() - 0.5f};
+                Obj.Box.Min += Offset;
+                Obj.Box.Max += Offset;
+                Tree.Move(Obj.Id, Obj.Box, Offset);
+            }
+            MoveTime += T.GetElapsedTime();
+        }
+
+        {
+            Timer T;
+            Tree.QueryFrustums(Frustums.data(), static_cast<Uint32>(Frustums.size()), [&](DynamicAABBTree::ObjectId, Uint32) { ++NumVisible; });
+            QueryTime += T.GetElapsedTime();
+        }
+
+        {
+            Timer T;
+            for (const auto& Obj : Objects)
+            {
+                for (const auto& Frustum : Frustums)
+                {
+                    if (GetBoxVisibility(Frustum, Obj.Box) != BoxVisibility::Invisible)
+                    {
+                        ++RefVisible;
+                        break;
+                    }
+                }
+            }
+            LinearTime += T.GetElapsedTime();
+        }
+    }
+    EXPECT_EQ(NumVisible, RefVisible);
+
+    LOG_INFO_MESSAGE("Dynamic AABB tree with ", NumObjects, " objects (height ", Tree.GetHeight(), "):\n",
+                     "    Insert:                            ", InsertTime * 1000.0, " ms\n",
+                     "    Move 10% of objects:               ", MoveTime * 1000.0 / NumFrames, " ms/frame\n",
+                     "    Cull ", Frustums.size(), " views (", NumVisible / NumFrames, " visible): ", QueryTime * 1000.0 / NumFrames, " ms/frame\n",
+                     "    Linear culling:                    ", LinearTime * 1000.0 / NumFrames, " ms/frame");
+}
+
+} // namespace
@@ -0,0 +1,268 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#include "SoftwareOcclusionCuller.hpp"
+#include "ThreadPool.hpp"
+#include "FastRand.hpp"
+
+#include <set>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+// Unit quad in XY plane facing -Z
+const float3 QuadVerts[] = {float3{-1, -1, 0}, float3{+1, -1, 0}, float3{+1, +1, 0}, float3{-1, +1, 0}};
+const Uint32 QuadInds[]  = {0, 1, 2, 0, 2, 3};
+
+void TestQuadOccluder(bool bIsGL)
+{
+    SoftwareOcclusionCuller Culler{128, 96, bIsGL};
+
+    // Camera at the origin looking along +Z
+    Culler.BeginFrame(float4x4::Projection(PI_F / 2.f, 128.f / 96.f, 0.5f, 100.f, bIsGL));
+    // 4x4 quad at Z = 5
+    Culler.AddOccluder(QuadVerts, 4, QuadInds, 6, float4x4::Scale(2, 2, 1) * float4x4::Translation(0, 0, 5));
+    EXPECT_EQ(Culler.GetNumOccluderTriangles(), 2u);
+    Culler.RasterizeOccluders();
+
+    // clang-format off
+    EXPECT_TRUE (Culler.IsBoxOccluded(BoundBox{float3{-1, -1, 10}, float3{1, 1, 12}}));  // Behind the quad
+    EXPECT_FALSE(Culler.IsBoxOccluded(BoundBox{float3{-1, -1,  2}, float3{1, 1,  3}}));  // In front of the quad
+    EXPECT_FALSE(Culler.IsBoxOccluded(BoundBox{float3{-1, -1,  4}, float3{1, 1,  6}}));  // Intersects the quad
+    EXPECT_FALSE(Culler.IsBoxOccluded(BoundBox{float3{ 5, -1, 10}, float3{7, 1, 12}}));  // Behind, but to the side
+    EXPECT_FALSE(Culler.IsBoxOccluded(BoundBox{float3{ 3, -1, 10}, float3{5, 1, 12}}));  // Partially hidden
+    EXPECT_FALSE(Culler.IsBoxOccluded(BoundBox{float3{-1, -1, -1}, float3{1, 1,  1}}));  // Intersects the near plane
+    EXPECT_FALSE(Culler.IsBoxOccluded(BoundBox{float3{-1, -1,-12}, float3{1, 1,-10}}));  // Behind the camera
+    // clang-format on
+
+    const BoundBox Boxes[] =
+        {
+            BoundBox{float3{-1, -1, 10}, float3{1, 1, 12}},
+            BoundBox{float3{5, -1, 10}, float3{7, 1, 12}},
+        };
+    bool IsOccluded[2] = {};
+    Culler.TestBoxes(Boxes, 2, IsOccluded);
+    EXPECT_TRUE(IsOccluded[0]);
+    EXPECT_FALSE(IsOccluded[1]);
+
+    // The frame is reset by BeginFrame
+    Culler.BeginFrame(float4x4::Projection(PI_F / 2.f, 128.f / 96.f, 0.5f, 100.f, bIsGL));
+    Culler.RasterizeOccluders();
+    EXPECT_FALSE(Culler.IsBoxOccluded(Boxes[0]));
+}
+
+TEST(Common_SoftwareOcclusionCuller, QuadOccluder)
+{
+    TestQuadOccluder(false);
+}
+
+TEST(Common_SoftwareOcclusionCuller, QuadOccluderGL)
+{
+    TestQuadOccluder(true);
+}
+
+TEST(Common_SoftwareOcclusionCuller, NearPlaneClipping)
+{
+    SoftwareOcclusionCuller Culler{64, 64, false};
+    Culler.BeginFrame(float4x4::Projection(PI_F / 2.f, 1.f, 1.f, 100.f, false));
+
+    // Large quad tilted so that it crosses the near plane: its near part is clipped away,
+    // while the far part must still occlude the box behind it.
+    const auto World = float4x4::Scale(50, 50, 1) * float4x4::RotationX(PI_F / 4.f) * float4x4::Translation(0, 0, 10);
+    Culler.AddOccluder(QuadVerts, 4, QuadInds, 6, World);
+    Culler.RasterizeOccluders();
+
+    EXPECT_GT(Culler.GetNumOccluderTriangles(), 0u);
+    EXPECT_TRUE(Culler.IsBoxOccluded(BoundBox{float3{-1, -1, 60}, float3{1, 1, 62}}));
+    EXPECT_FALSE(Culler.IsBoxOccluded(BoundBox{float3{-1, -1, 2}, float3{1, 1, 3}}));
+}
+
+// Checks that covered pixels match the samples enumerated by RasterizeTriangle()
+TEST(Common_SoftwareOcclusionCuller, Coverage)
+{
+    constexpr Uint32 Width  = 100;
+    constexpr Uint32 Height = 70;
+
+    SoftwareOcclusionCuller Culler{Width, Height, false};
+
+    FastRandFloat Rnd{0, -20, 120};
+    size_t        NumMismatches = 0;
+    for (Uint32 i = 0; i < 100; ++i)
+    {
+        // Orthographic projection that maps world XY to pixel coordinates
+        Culler.BeginFrame(float4x4::OrthoOffCenter(0, Width, Height, 0, 0, 10, false));
+
+        const float3 Verts[] = {float3{Rnd(), Rnd(), 1}, float3{Rnd(), Rnd(), 1}, float3{Rnd(), Rnd(), 1}};
+        const Uint32 Inds[]  = {0, 1, 2};
+        Culler.AddOccluder(Verts, 3, Inds, 3, float4x4::Identity());
+        Culler.RasterizeOccluders();
+
+        // Pixel centers are at half-integer coordinates, while RasterizeTriangle samples integer ones
+        std::set<std::pair<Uint32, Uint32>> RefCoverage;
+        RasterizeTriangle(float2{Verts[0].x - 0.5f, Verts[0].y - 0.5f},
+                          float2{Verts[1].x - 0.5f, Verts[1].y - 0.5f},
+                          float2{Verts[2].x - 0.5f, Verts[2].y - 0.5f},
+                          [&](const int2& Pos) //
+                          {
+                              if (Pos.x >= 0 && Pos.y >= 0 && Pos.x < static_cast<int>(Width) && Pos.y < static_cast<int>(Height))
+                                  RefCoverage.emplace(static_cast<Uint32>(Pos.x), static_cast<Uint32>(Pos.y));
+                          });
+
+        for (Uint32 y = 0; y < Height; ++y)
+        {
+            for (Uint32 x = 0; x < Width; ++x)
+            {
+                const auto Depth     = Culler.GetDepth(x, y);
+                const bool IsCovered = Depth < 1.f;
+                if (IsCovered)
+                {
+                    EXPECT_NEAR(Depth, 0.1f, 1e-5f);
+                }
+                if (IsCovered != (RefCoverage.count(std::make_pair(x, y)) != 0))
+                    ++NumMismatches;
+            }
+        }
+    }
+    // Samples that lie exactly on the edges may be classified differently due to rounding
+    EXPECT_LE(NumMismatches, size_t{4});
+}
+
+void AddRandomOccluders(SoftwareOcclusionCuller& Culler, FastRandFloat& Rnd)
+{
+    for (Uint32 i = 0; i < 200; ++i)
+    {
+        const auto World = float4x4::Scale(0.5f + Rnd() * 0.05f, 0.5f + Rnd() * 0.05f, 1) *
+            float4x4::RotationY(Rnd() * 0.1f) *
+            float4x4::Translation(Rnd() * 0.5f, Rnd() * 0.5f, 10 + Rnd());
+        Culler.AddOccluder(QuadVerts, 4, QuadInds, 6, World);
+    }
+}
+
+TEST(Common_SoftwareOcclusionCuller, Multithreading)
+{
+    const auto ViewProj = float4x4::Projection(PI_F / 3.f, 2.f, 1.f, 100.f, false);
+
+    SoftwareOcclusionCuller RefCuller{300, 150, false};
+    SoftwareOcclusionCuller MTCuller{300, 150, false};
+    RefCuller.BeginFrame(ViewProj);
+    MTCuller.BeginFrame(ViewProj);
+    {
+        FastRandFloat Rnd{0, -10, 10};
+        AddRandomOccluders(RefCuller, Rnd);
+    }
+    {
+        FastRandFloat Rnd{0, -10, 10};
+        AddRandomOccluders(MTCuller, Rnd);
+    }
+
+    ThreadPool Pool{4};
+    RefCuller.RasterizeOccluders();
+    MTCuller.RasterizeOccluders(&Pool);
+
+    size_t NumCovered = 0;
+    for (Uint32 y = 0; y < RefCuller.GetHeight(); ++y)
+    {
+        for (Uint32 x = 0; x < RefCuller.GetWidth(); ++x)
+        {
+            ASSERT_EQ(RefCuller.GetDepth(x, y), MTCuller.GetDepth(x, y)) << "x=" << x << " y=" << y;
+            if (RefCuller.GetDepth(x, y) < 1.f)
+                ++NumCovered;
+        }
+    }
+    EXPECT_GT(NumCovered, size_t{0});
+}
+
+// Checks the hierarchical-Z test against testing every pixel of the depth buffer
+TEST(Common_SoftwareOcclusionCuller, HierarchicalZ)
+{
+    constexpr Uint32 Width  = 250;
+    constexpr Uint32 Height = 130;
+
+    const auto ViewProj = float4x4::Projection(PI_F / 3.f, static_cast<float>(Width) / static_cast<float>(Height), 1.f, 100.f, false);
+
+    SoftwareOcclusionCuller Culler{Width, Height, false};
+    Culler.BeginFrame(ViewProj);
+    FastRandFloat Rnd{1, -10, 10};
+    AddRandomOccluders(Culler, Rnd);
+    Culler.RasterizeOccluders();
+
+    std::vector<BoundBox> Boxes(1000);
+    for (auto& Box : Boxes)
+    {
+        const float3 Center{Rnd() * 2, Rnd(), 20 + Rnd()};
+        const float3 Extent{0.05f + std::abs(Rnd()) * 0.2f, 0.05f + std::abs(Rnd()) * 0.2f, 0.5f};
+        Box = BoundBox{Center - Extent, Center + Extent};
+    }
+    std::vector<char> IsOccluded(Boxes.size());
+    static_assert(sizeof(bool) == sizeof(char), "Unexpected bool size");
+    Culler.TestBoxes(Boxes.data(), static_cast<Uint32>(Boxes.size()), reinterpret_cast<bool*>(IsOccluded.data()));
+
+    size_t NumOccluded = 0;
+    for (size_t i = 0; i < Boxes.size(); ++i)
+    {
+        const auto& Box = Boxes[i];
+
+        float2 ScreenMin{+FLT_MAX, +FLT_MAX};
+        float2 ScreenMax{-FLT_MAX, -FLT_MAX};
+        float  MinDepth = FLT_MAX;
+        for (Uint32 c = 0; c < 8; ++c)
+        {
+            const float3 Corner{(c & 1) ? Box.Max.x : Box.Min.x, (c & 2) ? Box.Max.y : Box.Min.y, (c & 4) ? Box.Max.z : Box.Min.z};
+            const auto   ClipPos = float4{Corner, 1} * ViewProj;
+            ScreenMin            = std::min(ScreenMin, float2{(ClipPos.x / ClipPos.w * 0.5f + 0.5f) * Width, (0.5f - ClipPos.y / ClipPos.w * 0.5f) * Height});
+            ScreenMax            = std::max(ScreenMax, float2{(ClipPos.x / ClipPos.w * 0.5f + 0.5f) * Width, (0.5f - ClipPos.y / ClipPos.w * 0.5f) * Height});
+            MinDepth             = std::min(MinDepth, ClipPos.z / ClipPos.w);
+        }
+
+        bool RefIsOccluded = ScreenMax.x >= 0 && ScreenMax.y >= 0 && ScreenMin.x < Width && ScreenMin.y < Height;
+        for (int y = std::max(static_cast<int>(ScreenMin.y), 0); y <= std::min(static_cast<int>(ScreenMax.y), static_cast<int>(Height) - 1) && RefIsOccluded; ++y)
+        {
+            for (int x = std::max(static_cast<int>(ScreenMin.x), 0); x <= std::min(static_cast<int>(ScreenMax.x), static_cast<int>(Width) - 1); ++x)
+            {
+                if (Culler.GetDepth(x, y) >= MinDepth)
+                {
+                    RefIsOccluded = false;
+                    break;
+                }
+            }
+        }
+
+        EXPECT_EQ(IsOccluded[i] != 0, RefIsOccluded) << "Box " << i;
+        if (RefIsOccluded)
+            ++NumOccluded;
+    }
+    // Make sure that the test covers both outcomes
+    EXPECT_GT(NumOccluded, size_t{0});
+    EXPECT_LT(NumOccluded, Boxes.size());
+}
+
+} // namespace
@@ -0,0 +1,125 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#include "ThreadPool.hpp"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(Common_ThreadPool, EnqueueTasks)
+{
+    ThreadPool Pool{4};
+    EXPECT_EQ(Pool.GetNumThreads(), 4u);
+    EXPECT_EQ(Pool.GetCurrentThreadId(), ~0u);
+
+    constexpr Uint32 NumTasks = 1000;
+
+    std::vector<int>    Results(NumTasks);
+    std::atomic<Uint32> NumBadThreadIds{0};
+    for (Uint32 i = 0; i < NumTasks; ++i)
+    {
+        Pool.EnqueueTask([&, i](Uint32 ThreadId) {
+            if (ThreadId >= Pool.GetNumThreads() || Pool.GetCurrentThreadId() != ThreadId)
+                NumBadThreadIds.fetch_add(1);
+            Results[i] = static_cast<int>(i) * 2;
+        });
+    }
+    Pool.WaitForAllTasks();
+    EXPECT_EQ(Pool.GetNumPendingTasks(), 0u);
+    EXPECT_EQ(NumBadThreadIds.load(), 0u);
+
+    for (Uint32 i = 0; i < NumTasks; ++i)
+        EXPECT_EQ(Results[i], static_cast<int>(i) * 2);
+
+    // The pool can be reused after waiting
+    std::atomic<Uint32> Counter{0};
+    for (Uint32 i = 0; i < NumTasks; ++i)
+        Pool.EnqueueTask([&](Uint32) { Counter.fetch_add(1); });
+    Pool.WaitForAllTasks();
+    EXPECT_EQ(Counter.load(), NumTasks);
+}
+
+TEST(Common_ThreadPool, NestedTasks)
+{
+    ThreadPool Pool{3};
+
+    std::atomic<Uint32> Counter{0};
+
+    std::function<void(Uint32, Uint32)> Spawn = [&](Uint32, Uint32 Depth) {
+        Counter.fetch_add(1);
+        if (Depth == 0)
+            return;
+        for (int i = 0; i < 2; ++i)
+            Pool.EnqueueTask([&, Depth](Uint32 ThreadId) { Spawn(ThreadId, Depth - 1); });
+    };
+    Pool.EnqueueTask([&](Uint32 ThreadId) { Spawn(ThreadId, 10); });
+    Pool.WaitForAllTasks();
+
+    // Full binary tree of depth 10
+    EXPECT_EQ(Counter.load(), (1u << 11) - 1u);
+}
+
+TEST(Common_ThreadPool, DestroyWithPendingTasks)
+{
+    std::atomic<Uint32> Counter{0};
+    {
+        ThreadPool Pool{2};
+        for (int i = 0; i < 100; ++i)
+            Pool.EnqueueTask([&](Uint32) { Counter.fetch_add(1); });
+    }
+    // Destructor completes all tasks
+    EXPECT_EQ(Counter.load(), 100u);
+}
+
+TEST(Common_ThreadPool, ThrowingTasks)
+{
+    ThreadPool Pool{2};
+
+    std::atomic<Uint32> Counter{0};
+    for (int i = 0; i < 100; ++i)
+    {
+        Pool.EnqueueTask([&, i](Uint32) {
+            if (i % 2 == 0)
+                throw std::runtime_error{"Test exception"};
+            Counter.fetch_add(1);
+        });
+    }
+    // Exceptions must not stop the worker threads
+    Pool.WaitForAllTasks();
+    EXPECT_EQ(Counter.load(), 50u);
+    EXPECT_EQ(Pool.GetNumPendingTasks(), 0u);
+}
+
+} // namespace
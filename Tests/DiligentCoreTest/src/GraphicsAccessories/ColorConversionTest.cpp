@@ -0,0 +1,235 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#include "ColorConversion.h"
+
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "FastRand.hpp"
+#include "PlatformDefinitions.h"
+#include "Timer.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+double RefLinearToSRGB(double x)
+{
+    return x <= 0.0031308 ? x * 12.92 : 1.055 * std::pow(x, 1.0 / 2.4) - 0.055;
+}
+
+double RefSRGBToLinear(double x)
+{
+    return x <= 0.04045 ? x / 12.92 : std::pow((x + 0.055) / 1.055, 2.4);
+}
+
+std::vector<float> MakeTestValues()
+{
+    std::vector<float> Values;
+    for (Uint32 i = 0; i <= 65536; ++i)
+        Values.push_back(static_cast<float>(i) / 65536.f);
+
+    // HDR values
+    for (Uint32 i = 1; i <= 4096; ++i)
+        Values.push_back(1.f + static_cast<float>(i) / 64.f);
+
+    FastRandFloat rnd{0, 0.f, 1.f};
+    for (Uint32 i = 0; i < 1024; ++i)
+        Values.push_back(rnd());
+
+    Values.push_back(-0.5f);
+    Values.push_back(-0.f);
+    Values.push_back(0.0031308f);
+    Values.push_back(0.04045f);
+    return Values;
+}
+
+TEST(GraphicsAccessories_ColorConversion, LinearToSRGBFloat)
+{
+    const auto Values = MakeTestValues();
+
+    std::vector<float> SRGB(Values.size());
+    LinearToSRGB(Values.data(), SRGB.data(), Values.size());
+
+    for (size_t i = 0; i < Values.size(); ++i)
+    {
+        const auto x   = Values[i];
+        const auto Ref = RefLinearToSRGB(x);
+        // Absolute error for [0, 1], relative error for HDR values
+        const auto Tolerance = x <= 1 ? 5e-7 : Ref * 5e-6;
+        ASSERT_NEAR(SRGB[i], Ref, Tolerance) << "x = " << x;
+        ASSERT_NEAR(SRGB[i], LinearToSRGB(x), Tolerance + 5e-7) << "x = " << x;
+    }
+}
+
+TEST(GraphicsAccessories_ColorConversion, SRGBToLinearFloat)
+{
+    const auto Values = MakeTestValues();
+
+    std::vector<float> Linear(Values.size());
+    SRGBToLinear(Values.data(), Linear.data(), Values.size());
+
+    for (size_t i = 0; i < Values.size(); ++i)
+    {
+        const auto x         = Values[i];
+        const auto Ref       = RefSRGBToLinear(x);
+        const auto Tolerance = x <= 1 ? 5e-7 : Ref * 5e-6;
+        ASSERT_NEAR(Linear[i], Ref, Tolerance) << "x = " << x;
+        ASSERT_NEAR(Linear[i], SRGBToLinear(x), Tolerance + 5e-7) << "x = " << x;
+    }
+}
+
+TEST(GraphicsAccessories_ColorConversion, SpanTails)
+{
+    constexpr size_t MaxCount = 37;
+
+    std::vector<float> Src(MaxCount);
+    for (size_t i = 0; i < MaxCount; ++i)
+        Src[i] = static_cast<float>(i) / static_cast<float>(MaxCount - 1);
+
+    std::vector<float> RefSRGB(MaxCount), RefLinear(MaxCount);
+    std::vector<Uint8> RefSRGB8(MaxCount);
+    LinearToSRGB(Src.data(), RefSRGB.data(), MaxCount);
+    SRGBToLinear(Src.data(), RefLinear.data(), MaxCount);
+    LinearToSRGB(Src.data(), RefSRGB8.data(), MaxCount);
+
+    // Every element must be converted the same way regardless of its position in the span
+    for (size_t Start = 0; Start < 8; ++Start)
+    {
+        for (size_t Count = 0; Start + Count <= MaxCount; ++Count)
+        {
+            std::vector<float> Dst(MaxCount + 1, -1.f);
+            std::vector<Uint8> Dst8(MaxCount + 1, 0xCD);
+
+            LinearToSRGB(&Src[Start], &Dst[Start], Count);
+            for (size_t i = Start; i < Start + Count; ++i)
+                ASSERT_EQ(Dst[i], RefSRGB[i]);
+            EXPECT_EQ(Dst[Start + Count], -1.f) << "Memory past the end of the span was overwritten";
+
+            SRGBToLinear(&Src[Start], &Dst[Start], Count);
+            for (size_t i = Start; i < Start + Count; ++i)
+                ASSERT_EQ(Dst[i], RefLinear[i]);
+
+            LinearToSRGB(&Src[Start], &Dst8[Start], Count);
+            for (size_t i = Start; i < Start + Count; ++i)
+                ASSERT_EQ(Dst8[i], RefSRGB8[i]);
+            EXPECT_EQ(Dst8[Start + Count], 0xCD) << "Memory past the end of the span was overwritten";
+        }
+    }
+
+    // In-place conversion
+    auto InPlace = Src;
+    LinearToSRGB(InPlace.data(), InPlace.data(), InPlace.size());
+    EXPECT_EQ(InPlace, RefSRGB);
+}
+
+TEST(GraphicsAccessories_ColorConversion, SRGB8)
+{
+    std::vector<Uint8> SRGB8(256);
+    for (Uint32 i = 0; i < 256; ++i)
+        SRGB8[i] = static_cast<Uint8>(i);
+
+    std::vector<float> Linear(256);
+    SRGBToLinear(SRGB8.data(), Linear.data(), SRGB8.size());
+    for (Uint32 i = 0; i < 256; ++i)
+        ASSERT_EQ(Linear[i], SRGBToLinear(static_cast<Uint8>(i)));
+
+    // 8-bit values must survive the round trip
+    std::vector<Uint8> RoundTrip(256);
+    LinearToSRGB(Linear.data(), RoundTrip.data(), Linear.size());
+    EXPECT_EQ(RoundTrip, SRGB8);
+
+    // Compare with the correctly rounded result
+    constexpr Uint32   NumValues = 1 << 20;
+    std::vector<float> Values(NumValues);
+    for (Uint32 i = 0; i < NumValues; ++i)
+        Values[i] = static_cast<float>(i) / static_cast<float>(NumValues - 1);
+
+    std::vector<Uint8> Quantized(NumValues);
+    LinearToSRGB(Values.data(), Quantized.data(), Values.size());
+    Uint32 NumMismatches = 0;
+    for (Uint32 i = 0; i < NumValues; ++i)
+    {
+        const auto Ref = static_cast<int>(RefLinearToSRGB(Values[i]) * 255.0 + 0.5);
+        ASSERT_LE(std::abs(Quantized[i] - Ref), 1) << "x = " << Values[i];
+        if (Quantized[i] != Ref)
+            ++NumMismatches;
+    }
+    EXPECT_LE(NumMismatches, NumValues / 10000);
+
+    // Clamping
+    const float OutOfRange[] = {-1.f, -0.f, 1.5f, 1e30f, -std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity(), std::numeric_limits<float>::quiet_NaN()};
+    const Uint8 RefClamped[] = {0, 0, 255, 255, 0, 255, 0};
+
+    Uint8 Clamped[_countof(OutOfRange)] = {};
+    LinearToSRGB(OutOfRange, Clamped, _countof(OutOfRange));
+    for (size_t i = 0; i < _countof(OutOfRange); ++i)
+        EXPECT_EQ(Clamped[i], RefClamped[i]) << "x = " << OutOfRange[i];
+}
+
+TEST(GraphicsAccessories_ColorConversion, DISABLED_Performance)
+{
+    constexpr size_t NumValues = 1 << 22;
+
+    std::vector<float> Values(NumValues);
+    std::vector<Uint8> Values8(NumValues);
+    FastRandFloat      rnd{0, 0.f, 1.f};
+    for (size_t i = 0; i < NumValues; ++i)
+    {
+        Values[i]  = rnd();
+        Values8[i] = static_cast<Uint8>(i * 31);
+    }
+
+    std::vector<float> Dst(NumValues);
+    std::vector<Uint8> Dst8(NumValues);
+
+    auto Measure = [&](const char* Name, const std::function<void()>& Func) {
+        Timer T;
+        Func();
+        const auto Time = T.GetElapsedTime();
+        LOG_INFO_MESSAGE(Name, ": ", Time * 1000.0, " ms (", static_cast<double>(NumValues) / Time * 1e-6, " MValues/s)");
+    };
+
+    // clang-format off
+    Measure("LinearToSRGB (scalar)",     [&]() { for (size_t i = 0; i < NumValues; ++i) Dst[i] = LinearToSRGB(Values[i]); });
+    Measure("LinearToSRGB (bulk)",       [&]() { LinearToSRGB(Values.data(), Dst.data(), NumValues); });
+    Measure("SRGBToLinear (scalar)",     [&]() { for (size_t i = 0; i < NumValues; ++i) Dst[i] = SRGBToLinear(Values[i]); });
+    Measure("SRGBToLinear (bulk)",       [&]() { SRGBToLinear(Values.data(), Dst.data(), NumValues); });
+    Measure("LinearToSRGB8 (scalar)",    [&]() { for (size_t i = 0; i < NumValues; ++i) Dst8[i] = static_cast<Uint8>(LinearToSRGB(Values[i]) * 255.f + 0.5f); });
+    Measure("LinearToSRGB8 (bulk)",      [&]() { LinearToSRGB(Values.data(), Dst8.data(), NumValues); });
+    Measure("SRGB8ToLinear (scalar)",    [&]() { for (size_t i = 0; i < NumValues; ++i) Dst[i] = SRGBToLinear(Values8[i]); });
+    Measure("SRGB8ToLinear (bulk)",      [&]() { SRGBToLinear(Values8.data(), Dst.data(), NumValues); });
+    // clang-format on
+}
+
+} // namespace
@@ -29,10 +29,12 @@
 
 #include <array>
 #include <algorithm>
+#include <vector>
 
 #include "gtest/gtest.h"
 
 #include "FastRand.hpp"
+#include "Timer.hpp"
 
 using namespace Diligent;
 
@@ -49,7 +51,40 @@ static std::ostream& operator<<(std::ostream& os, const DynamicAtlasManager::Reg
 namespace
 {
 
-using Region = DynamicAtlasManager::Region;
+using Region           = DynamicAtlasManager::Region;
+using PackingAlgorithm = DynamicAtlasManager::PackingAlgorithm;
+
+// Returns the number of texels covered by more than one region or lying outside of the atlas
+Uint32 CountOverlappingTexels(Uint32 AtlasWidth, Uint32 AtlasHeight, const std::vector<Region>& Regions)
+{
+    std::vector<Uint8> Coverage(size_t{AtlasWidth} * size_t{AtlasHeight});
+
+    Uint32 NumOverlapping = 0;
+    for (const auto& R : Regions)
+    {
+        if (R.IsEmpty())
+            continue;
+
+        if (R.x + R.width > AtlasWidth || R.y + R.height > AtlasHeight)
+        {
+            NumOverlapping += R.width * R.height;
+            continue;
+        }
+
+        for (Uint32 y = R.y; y < R.y + R.height; ++y)
+        {
+            for (Uint32 x = R.x; x < R.x + R.width; ++x)
+            {
+                auto& Texel = Coverage[size_t{y} * AtlasWidth + x];
+                if (Texel != 0)
+                    ++NumOverlapping;
+                Texel = 1;
+            }
+        }
+    }
+
+    return NumOverlapping;
+}
 
 TEST(GraphicsAccessories_DynamicAtlasManager, Region_Ctor)
 {
@@ -461,4 +496,315 @@ TEST(GraphicsAccessories_DynamicAtlasManager, AllocateRandom)
     }
 }
 
+TEST(GraphicsAccessories_DynamicAtlasManager, MaxRects_Allocate)
+{
+    {
+        DynamicAtlasManager Mgr{16, 8, PackingAlgorithm::MaxRects};
+        EXPECT_EQ(Mgr.GetAlgorithm(), PackingAlgorithm::MaxRects);
+
+        auto R = Mgr.Allocate(16, 8);
+        EXPECT_EQ(R, Region(0, 0, 16, 8));
+        EXPECT_EQ(Mgr.GetFreeRegionCount(), 0u);
+        EXPECT_TRUE(Mgr.Allocate(1, 1).IsEmpty());
+        Mgr.Free(std::move(R));
+        EXPECT_EQ(Mgr.GetFreeRegionCount(), 1u);
+    }
+
+    {
+        DynamicAtlasManager Mgr{32, 32, PackingAlgorithm::MaxRects};
+
+        // Free space is described by overlapping maximal rectangles
+        auto R0 = Mgr.Allocate(16, 16);
+        EXPECT_EQ(R0, Region(0, 0, 16, 16));
+        EXPECT_EQ(Mgr.GetFreeRegionCount(), 2u);
+
+        auto R1 = Mgr.Allocate(16, 16);
+        auto R2 = Mgr.Allocate(16, 16);
+        auto R3 = Mgr.Allocate(16, 16);
+        EXPECT_FALSE(R1.IsEmpty());
+        EXPECT_FALSE(R2.IsEmpty());
+        EXPECT_FALSE(R3.IsEmpty());
+        EXPECT_EQ(Mgr.GetFreeRegionCount(), 0u);
+        EXPECT_EQ(CountOverlappingTexels(32, 32, {R0, R1, R2, R3}), 0u);
+
+        EXPECT_EQ(R1, Region(16, 0, 16, 16));
+        EXPECT_EQ(R2, Region(0, 16, 16, 16));
+        EXPECT_EQ(R3, Region(16, 16, 16, 16));
+
+        // Adjacent released regions must be merged
+        Mgr.Free(std::move(R0));
+        Mgr.Free(std::move(R1));
+        EXPECT_EQ(Mgr.GetFreeRegionCount(), 1u);
+
+        auto R4 = Mgr.Allocate(32, 16);
+        EXPECT_EQ(R4, Region(0, 0, 32, 16));
+
+        Mgr.Free(std::move(R2));
+        Mgr.Free(std::move(R3));
+        Mgr.Free(std::move(R4));
+        EXPECT_EQ(Mgr.GetFreeRegionCount(), 1u);
+    }
+}
+
+TEST(GraphicsAccessories_DynamicAtlasManager, MaxRects_Move)
+{
+    DynamicAtlasManager Mgr0{16, 8, PackingAlgorithm::MaxRects};
+
+    auto R = Mgr0.Allocate(8, 8);
+
+    DynamicAtlasManager Mgr1{std::move(Mgr0)};
+    Mgr1.Free(std::move(R));
+}
+
+TEST(GraphicsAccessories_DynamicAtlasManager, MaxRects_AllocateRandom)
+{
+    DynamicAtlasManager Mgr{256, 256, PackingAlgorithm::MaxRects};
+
+    std::vector<Region> Regions;
+    for (Uint32 i = 0; i < 10; ++i)
+    {
+        FastRandInt rnd{static_cast<unsigned int>(i), 1, 16};
+        for (Uint32 r = 0; r < 64; ++r)
+            Regions.push_back(Mgr.Allocate(rnd(), rnd()));
+
+        EXPECT_EQ(CountOverlappingTexels(256, 256, Regions), 0u);
+
+        // Release every other region to interleave allocations with the free space
+        for (size_t r = i % 2; r < Regions.size(); r += 2)
+        {
+            if (!Regions[r].IsEmpty())
+                Mgr.Free(std::move(Regions[r]));
+            Regions[r] = Region{};
+        }
+        Regions.erase(std::remove_if(Regions.begin(), Regions.end(), [](const Region& R) { return R.IsEmpty(); }), Regions.end());
+    }
+
+    for (auto& R : Regions)
+        Mgr.Free(std::move(R));
+
+    EXPECT_EQ(Mgr.GetFreeRegionCount(), 1u);
+}
+
+TEST(GraphicsAccessories_DynamicAtlasManager, MaxRects_Free)
+{
+    {
+        DynamicAtlasManager Mgr{2, 2, PackingAlgorithm::MaxRects};
+
+        auto R0 = Mgr.Allocate(1, 1);
+        auto R1 = Mgr.Allocate(1, 1);
+        EXPECT_EQ(R0, Region(0, 0, 1, 1));
+        EXPECT_EQ(R1, Region(1, 0, 1, 1));
+
+        // Column 0 is free again and must be available for a 1x2 region
+        Mgr.Free(std::move(R0));
+        auto R2 = Mgr.Allocate(1, 2);
+        EXPECT_EQ(R2, Region(0, 0, 1, 2));
+
+        Mgr.Free(std::move(R1));
+        Mgr.Free(std::move(R2));
+        EXPECT_EQ(Mgr.GetFreeRegionCount(), 1u);
+    }
+
+    {
+        // After releasing any region, a request must succeed whenever the atlas has enough free space for it
+        constexpr Uint32 AtlasSize = 32;
+
+        DynamicAtlasManager Mgr{AtlasSize, AtlasSize, PackingAlgorithm::MaxRects};
+
+        auto HasFreeSpace = [&](const std::vector<Region>& Regions, Uint32 Width, Uint32 Height) {
+            std::vector<Region> Test = Regions;
+            Test.emplace_back(0, 0, Width, Height);
+            for (Uint32 y = 0; y + Height <= AtlasSize; ++y)
+            {
+                for (Uint32 x = 0; x + Width <= AtlasSize; ++x)
+                {
+                    Test.back() = Region{x, y, Width, Height};
+                    if (CountOverlappingTexels(AtlasSize, AtlasSize, Test) == 0)
+                        return true;
+                }
+            }
+            return false;
+        };
+
+        FastRandInt rnd{0, 1, 8};
+
+        std::vector<Region> Regions;
+        for (Uint32 r = 0; r < 64; ++r)
+        {
+            auto R = Mgr.Allocate(rnd(), rnd());
+            if (!R.IsEmpty())
+                Regions.push_back(R);
+        }
+
+        while (!Regions.empty())
+        {
+            const auto r = static_cast<size_t>(rnd()) % Regions.size();
+            Mgr.Free(std::move(Regions[r]));
+            Regions.erase(Regions.begin() + r);
+
+            const auto Width  = static_cast<Uint32>(rnd() * 2);
+            const auto Height = static_cast<Uint32>(rnd() * 2);
+            auto       R      = Mgr.Allocate(Width, Height);
+            EXPECT_EQ(!R.IsEmpty(), HasFreeSpace(Regions, Width, Height)) << Width << " x " << Height;
+            if (!R.IsEmpty())
+                Mgr.Free(std::move(R));
+        }
+        EXPECT_EQ(Mgr.GetFreeRegionCount(), 1u);
+    }
+}
+
+TEST(GraphicsAccessories_DynamicAtlasManager, AllocateBatch)
+{
+    for (auto Algorithm : {PackingAlgorithm::Tree, PackingAlgorithm::MaxRects})
+    {
+        DynamicAtlasManager Mgr{128, 128, Algorithm};
+
+        FastRandInt rnd{0, 1, 24};
+
+        std::vector<Region> Regions(256);
+        for (auto& R : Regions)
+            R = Region{0, 0, static_cast<Uint32>(rnd()), static_cast<Uint32>(rnd())};
+        // Empty requests must be skipped
+        Regions[10].width = 0;
+
+        const auto NumAllocated = Mgr.Allocate(static_cast<Uint32>(Regions.size()), Regions.data());
+        EXPECT_GT(NumAllocated, 0u);
+        EXPECT_LT(NumAllocated, Regions.size());
+        EXPECT_TRUE(Regions[10].IsEmpty());
+
+        Uint32 NumNonEmpty = 0;
+        for (const auto& R : Regions)
+            NumNonEmpty += R.IsEmpty() ? 0 : 1;
+        EXPECT_EQ(NumNonEmpty, NumAllocated);
+        EXPECT_EQ(CountOverlappingTexels(128, 128, Regions), 0u);
+
+        const auto Stats = Mgr.GetStatistics();
+        EXPECT_EQ(Stats.NumAllocations, NumAllocated);
+
+        for (auto& R : Regions)
+        {
+            if (!R.IsEmpty())
+                Mgr.Free(std::move(R));
+        }
+    }
+}
+
+TEST(GraphicsAccessories_DynamicAtlasManager, Statistics)
+{
+    for (auto Algorithm : {PackingAlgorithm::Tree, PackingAlgorithm::MaxRects})
+    {
+        DynamicAtlasManager Mgr{64, 64, Algorithm};
+
+        auto Stats = Mgr.GetStatistics();
+        EXPECT_EQ(Stats.NumAllocations, 0u);
+        EXPECT_EQ(Stats.NumFreeRegions, 1u);
+        EXPECT_EQ(Stats.AllocatedArea, 0u);
+        EXPECT_EQ(Stats.FreeArea, 64u * 64u);
+        EXPECT_EQ(Stats.LargestFreeRegionArea, 64u * 64u);
+        EXPECT_EQ(Stats.Occupancy, 0.f);
+        EXPECT_EQ(Stats.Fragmentation, 0.f);
+
+        auto R0 = Mgr.Allocate(32, 64);
+        auto R1 = Mgr.Allocate(16, 16);
+
+        Stats = Mgr.GetStatistics();
+        EXPECT_EQ(Stats.NumAllocations, 2u);
+        EXPECT_EQ(Stats.AllocatedArea, 32u * 64u + 16u * 16u);
+        EXPECT_EQ(Stats.FreeArea, 64u * 64u - Stats.AllocatedArea);
+        EXPECT_FLOAT_EQ(Stats.Occupancy, static_cast<float>(32 * 64 + 16 * 16) / static_cast<float>(64 * 64));
+        EXPECT_GT(Stats.Fragmentation, 0.f);
+        EXPECT_LT(Stats.Fragmentation, 1.f);
+
+        Mgr.Free(std::move(R0));
+        Mgr.Free(std::move(R1));
+
+        Stats = Mgr.GetStatistics();
+        EXPECT_EQ(Stats.AllocatedArea, 0u);
+        EXPECT_EQ(Stats.Fragmentation, 0.f);
+    }
+}
+
+TEST(GraphicsAccessories_DynamicAtlasManager, DISABLED_Performance)
+{
+    // Glyph-like workload: fill the atlas with many small regions, release a half of them
+    // and refill the atlas again.
+    constexpr Uint32 AtlasSize   = 512;
+    constexpr Uint32 NumRequests = 2048;
+
+    std::vector<Region> Requests(NumRequests);
+    {
+        FastRandInt rnd{0, 4, 24};
+        for (auto& R : Requests)
+            R = Region{0, 0, static_cast<Uint32>(rnd()), static_cast<Uint32>(rnd())};
+    }
+
+    for (auto Algorithm : {PackingAlgorithm::Tree, PackingAlgorithm::MaxRects})
+    {
+        const char* AlgorithmName = Algorithm == PackingAlgorithm::Tree ? "Tree" : "MaxRects";
+
+        // Allocate regions one by one in request order
+        {
+            DynamicAtlasManager Mgr{AtlasSize, AtlasSize, Algorithm};
+
+            std::vector<Region> Regions(Requests.size());
+
+            Timer T;
+            for (size_t i = 0; i < Requests.size(); ++i)
+                Regions[i] = Mgr.Allocate(Requests[i].width, Requests[i].height);
+            const auto FillTime = T.GetElapsedTime();
+
+            const auto FillStats = Mgr.GetStatistics();
+            EXPECT_EQ(CountOverlappingTexels(AtlasSize, AtlasSize, Regions), 0u);
+
+            T.Restart();
+            for (size_t i = 0; i < Regions.size(); i += 2)
+            {
+                if (!Regions[i].IsEmpty())
+                    Mgr.Free(std::move(Regions[i]));
+                Regions[i] = Mgr.Allocate(Requests[i].height, Requests[i].width);
+            }
+            const auto ChurnTime = T.GetElapsedTime();
+
+            const auto ChurnStats = Mgr.GetStatistics();
+            EXPECT_EQ(CountOverlappingTexels(AtlasSize, AtlasSize, Regions), 0u);
+
+            LOG_INFO_MESSAGE(AlgorithmName, " packer:\n",
+                             "    fill:  ", FillStats.NumAllocations, " regions in ", FillTime * 1000.0, " ms; occupancy: ",
+                             FillStats.Occupancy * 100.f, "%; fragmentation: ", FillStats.Fragmentation * 100.f, "%\n",
+                             "    churn: ", ChurnStats.NumAllocations, " regions in ", ChurnTime * 1000.0, " ms; occupancy: ",
+                             ChurnStats.Occupancy * 100.f, "%; fragmentation: ", ChurnStats.Fragmentation * 100.f, "%");
+
+            for (auto& R : Regions)
+            {
+                if (!R.IsEmpty())
+                    Mgr.Free(std::move(R));
+            }
+        }
+
+        // Allocate the same regions as a single batch
+        {
+            DynamicAtlasManager Mgr{AtlasSize, AtlasSize, Algorithm};
+
+            auto Regions = Requests;
+
+            Timer      T;
+            const auto NumAllocated = Mgr.Allocate(static_cast<Uint32>(Regions.size()), Regions.data());
+            const auto BatchTime    = T.GetElapsedTime();
+
+            const auto Stats = Mgr.GetStatistics();
+            EXPECT_EQ(Stats.NumAllocations, NumAllocated);
+            EXPECT_EQ(CountOverlappingTexels(AtlasSize, AtlasSize, Regions), 0u);
+
+            LOG_INFO_MESSAGE(AlgorithmName, " packer, batch: ", NumAllocated, " regions in ", BatchTime * 1000.0,
+                             " ms; occupancy: ", Stats.Occupancy * 100.f, "%; fragmentation: ", Stats.Fragmentation * 100.f, "%");
+
+            for (auto& R : Regions)
+            {
+                if (!R.IsEmpty())
+                    Mgr.Free(std::move(R));
+            }
+        }
+    }
+}
+
 } // namespace
@@ -0,0 +1,723 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#include "TextureFormatConversion.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "GraphicsAccessories.hpp"
+#include "FastRand.hpp"
+#include "ThreadPool.hpp"
+#include "Timer.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+Uint32 FloatBits(float f)
+{
+    Uint32 u;
+    memcpy(&u, &f, sizeof(u));
+    return u;
+}
+
+float FloatFromBits(Uint32 u)
+{
+    float f;
+    memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+// Writes bit fields of a 128-bit block starting from the least significant bit
+class BlockBitWriter
+{
+public:
+    BlockBitWriter& Write(Uint32 Value, Uint32 NumBits)
+    {
+        for (Uint32 i = 0; i < NumBits; ++i, ++m_Pos)
+        {
+            if ((Value >> i) & 0x01)
+                m_Block[m_Pos / 8] |= static_cast<Uint8>(1u << (m_Pos % 8));
+        }
+        return *this;
+    }
+
+    const Uint8* GetData() const
+    {
+        EXPECT_EQ(m_Pos, 128u);
+        return m_Block;
+    }
+
+private:
+    Uint8  m_Block[16] = {};
+    Uint32 m_Pos       = 0;
+};
+
+TEST(GraphicsAccessories_TextureFormatConversion, HalfFloat)
+{
+    EXPECT_EQ(FloatToHalf(0.f), 0x0000);
+    EXPECT_EQ(FloatToHalf(-0.f), 0x8000);
+    EXPECT_EQ(FloatToHalf(1.f), 0x3C00);
+    EXPECT_EQ(FloatToHalf(-2.f), 0xC000);
+    EXPECT_EQ(FloatToHalf(0.1f), 0x2E66);
+    EXPECT_EQ(FloatToHalf(65504.f), 0x7BFF);
+    EXPECT_EQ(FloatToHalf(65519.f), 0x7BFF);
+    EXPECT_EQ(FloatToHalf(65520.f), 0x7C00);
+    EXPECT_EQ(FloatToHalf(std::ldexp(1.f, -24)), 0x0001);
+    EXPECT_EQ(FloatToHalf(std::ldexp(1.f, -26)), 0x0000);
+    // Ties are rounded to even
+    EXPECT_EQ(FloatToHalf(1.f + std::ldexp(1.f, -11)), 0x3C00);
+    EXPECT_EQ(FloatToHalf(1.f + 3.f * std::ldexp(1.f, -11)), 0x3C02);
+    EXPECT_EQ(FloatToHalf(std::numeric_limits<float>::infinity()), 0x7C00);
+    EXPECT_EQ(FloatToHalf(std::numeric_limits<float>::quiet_NaN()) & 0x7E00, 0x7E00);
+
+    EXPECT_EQ(HalfToFloat(Uint16{0x3C00}), 1.f);
+    EXPECT_EQ(HalfToFloat(Uint16{0xC000}), -2.f);
+    EXPECT_EQ(HalfToFloat(Uint16{0x7BFF}), 65504.f);
+    EXPECT_EQ(HalfToFloat(Uint16{0x0001}), std::ldexp(1.f, -24));
+    EXPECT_TRUE(std::isinf(HalfToFloat(Uint16{0xFC00})));
+    EXPECT_TRUE(std::isnan(HalfToFloat(Uint16{0x7E00})));
+
+    // All half values must survive the round trip, and the bulk conversion must match the scalar one
+    std::vector<Uint16> Halves(65536);
+    for (Uint32 i = 0; i < 65536; ++i)
+        Halves[i] = static_cast<Uint16>(i);
+
+    std::vector<float> Floats(Halves.size());
+    HalfToFloat(Halves.data(), Floats.data(), Halves.size());
+
+    std::vector<Uint16> RoundTrip(Halves.size());
+    FloatToHalf(Floats.data(), RoundTrip.data(), Floats.size());
+    for (Uint32 i = 0; i < 65536; ++i)
+    {
+        const auto Half  = static_cast<Uint16>(i);
+        const bool IsNaN = (i & 0x7C00) == 0x7C00 && (i & 0x03FF) != 0;
+        ASSERT_EQ(FloatBits(Floats[i]), FloatBits(HalfToFloat(Half))) << i;
+        if (IsNaN)
+        {
+            EXPECT_TRUE(std::isnan(Floats[i])) << i;
+            EXPECT_EQ(RoundTrip[i] & 0x7E00, 0x7E00) << i;
+        }
+        else
+        {
+            ASSERT_EQ(RoundTrip[i], Half) << i;
+            ASSERT_EQ(FloatToHalf(Floats[i]), Half) << i;
+        }
+    }
+
+    // Bulk float-to-half conversion must match the scalar one for arbitrary bit patterns
+    FastRandInt        Rnd{0, 0, 0x7FFFFFFF};
+    std::vector<float> Values(10000 + 3);
+    for (size_t i = 0; i < Values.size(); ++i)
+        Values[i] = FloatFromBits(static_cast<Uint32>(Rnd()) ^ (i & 0x01 ? 0x80000000u : 0u));
+    std::vector<Uint16> BulkHalves(Values.size());
+    FloatToHalf(Values.data(), BulkHalves.data(), Values.size());
+    for (size_t i = 0; i < Values.size(); ++i)
+        ASSERT_EQ(BulkHalves[i], FloatToHalf(Values[i])) << Values[i];
+}
+
+TEST(GraphicsAccessories_TextureFormatConversion, IsSupported)
+{
+    EXPECT_TRUE(IsTexelUnpackSupported(TEX_FORMAT_RGBA8_UNORM));
+    EXPECT_TRUE(IsTexelUnpackSupported(TEX_FORMAT_BGRX8_UNORM_SRGB));
+    EXPECT_TRUE(IsTexelUnpackSupported(TEX_FORMAT_R11G11B10_FLOAT));
+    EXPECT_TRUE(IsTexelUnpackSupported(TEX_FORMAT_D24_UNORM_S8_UINT));
+    EXPECT_TRUE(IsTexelPackSupported(TEX_FORMAT_RGBA16_FLOAT));
+    EXPECT_FALSE(IsTexelUnpackSupported(TEX_FORMAT_RGBA8_TYPELESS));
+    EXPECT_FALSE(IsTexelUnpackSupported(TEX_FORMAT_R1_UNORM));
+    EXPECT_FALSE(IsTexelUnpackSupported(TEX_FORMAT_BC1_UNORM));
+    EXPECT_FALSE(IsTexelPackSupported(TEX_FORMAT_BC7_UNORM));
+}
+
+TEST(GraphicsAccessories_TextureFormatConversion, RoundTrip)
+{
+    const TEXTURE_FORMAT Formats[] = {
+        TEX_FORMAT_RGBA32_FLOAT,
+        TEX_FORMAT_RGB32_UINT,
+        TEX_FORMAT_RGBA16_FLOAT,
+        TEX_FORMAT_RGBA16_UNORM,
+        TEX_FORMAT_RGBA16_SNORM,
+        TEX_FORMAT_RG16_SINT,
+        TEX_FORMAT_RGBA8_UNORM,
+        TEX_FORMAT_RGBA8_UNORM_SRGB,
+        TEX_FORMAT_RGBA8_SNORM,
+        TEX_FORMAT_RG8_UNORM,
+        TEX_FORMAT_R8_UINT,
+        TEX_FORMAT_R16_FLOAT,
+        TEX_FORMAT_A8_UNORM,
+        TEX_FORMAT_BGRA8_UNORM,
+        TEX_FORMAT_BGRA8_UNORM_SRGB,
+        TEX_FORMAT_BGRX8_UNORM,
+        TEX_FORMAT_RGB10A2_UNORM,
+        TEX_FORMAT_RGB10A2_UINT,
+        TEX_FORMAT_R11G11B10_FLOAT,
+        TEX_FORMAT_RGB9E5_SHAREDEXP,
+        TEX_FORMAT_B5G6R5_UNORM,
+        TEX_FORMAT_B5G5R5A1_UNORM,
+        TEX_FORMAT_D32_FLOAT,
+        TEX_FORMAT_D16_UNORM,
+        TEX_FORMAT_D24_UNORM_S8_UINT,
+        TEX_FORMAT_D32_FLOAT_S8X24_UINT //
+    };
+
+    // Odd number of texels to exercise both vectorized loops and their tails
+    constexpr size_t NumTexels = 37;
+
+    FastRandFloat      Rnd{0, 0.f, 1.f};
+    std::vector<float> RGBA(NumTexels * 4);
+    for (auto& Val : RGBA)
+        Val = Rnd();
+
+    for (auto Fmt : Formats)
+    {
+        const auto& FmtAttribs = GetTextureFormatAttribs(Fmt);
+        const auto  TexelSize  = FmtAttribs.ComponentSize * (FmtAttribs.ComponentType != COMPONENT_TYPE_COMPOUND ? FmtAttribs.NumComponents : 1);
+
+        // Integer components and stencil must hold integer values
+        std::vector<float> Src = RGBA;
+        if (FmtAttribs.ComponentType == COMPONENT_TYPE_UINT || FmtAttribs.ComponentType == COMPONENT_TYPE_SINT || Fmt == TEX_FORMAT_RGB10A2_UINT)
+        {
+            for (auto& Val : Src)
+                Val = std::floor(Val * 3.f);
+        }
+        else if (FmtAttribs.ComponentType == COMPONENT_TYPE_DEPTH_STENCIL)
+        {
+            for (size_t t = 0; t < NumTexels; ++t)
+                Src[t * 4 + 1] = std::floor(Src[t * 4 + 1] * 255.f);
+        }
+
+        std::vector<Uint8> Packed(NumTexels * TexelSize);
+        PackTexelRow(Fmt, Src.data(), NumTexels, Packed.data());
+
+        std::vector<float> Unpacked(NumTexels * 4);
+        UnpackTexelRow(Fmt, Packed.data(), NumTexels, Unpacked.data());
+
+        // Packing the unpacked values again must produce identical bits
+        std::vector<Uint8> Repacked(Packed.size());
+        PackTexelRow(Fmt, Unpacked.data(), NumTexels, Repacked.data());
+        EXPECT_EQ(Packed, Repacked) << FmtAttribs.Name;
+
+        for (size_t t = 0; t < NumTexels; ++t)
+        {
+            const auto* pRef = &Src[t * 4];
+            const auto* pVal = &Unpacked[t * 4];
+            switch (Fmt)
+            {
+                case TEX_FORMAT_RGB10A2_UNORM:
+                    EXPECT_NEAR(pVal[0], pRef[0], 0.5 / 1023) << FmtAttribs.Name;
+                    EXPECT_NEAR(pVal[3], pRef[3], 0.5 / 3) << FmtAttribs.Name;
+                    break;
+
+                case TEX_FORMAT_RGB10A2_UINT:
+                    for (Uint32 c = 0; c < 4; ++c)
+                        EXPECT_EQ(pVal[c], pRef[c]) << FmtAttribs.Name;
+                    break;
+
+                case TEX_FORMAT_B5G6R5_UNORM:
+                case TEX_FORMAT_B5G5R5A1_UNORM:
+                    EXPECT_NEAR(pVal[0], pRef[0], 0.5 / 31) << FmtAttribs.Name;
+                    EXPECT_NEAR(pVal[1], pRef[1], 0.5 / 31) << FmtAttribs.Name;
+                    EXPECT_NEAR(pVal[2], pRef[2], 0.5 / 31) << FmtAttribs.Name;
+                    break;
+
+                case TEX_FORMAT_R11G11B10_FLOAT:
+                case TEX_FORMAT_RGB9E5_SHAREDEXP:
+                    EXPECT_NEAR(pVal[0], pRef[0], 1.f / 32) << FmtAttribs.Name;
+                    EXPECT_NEAR(pVal[2], pRef[2], 1.f / 32) << FmtAttribs.Name;
+                    EXPECT_EQ(pVal[3], 1.f) << FmtAttribs.Name;
+                    break;
+
+                case TEX_FORMAT_A8_UNORM:
+                    EXPECT_EQ(pVal[0], 0.f) << FmtAttribs.Name;
+                    EXPECT_NEAR(pVal[3], pRef[3], 0.5 / 255) << FmtAttribs.Name;
+                    break;
+
+                case TEX_FORMAT_BGRX8_UNORM:
+                    EXPECT_NEAR(pVal[0], pRef[0], 0.5 / 255) << FmtAttribs.Name;
+                    EXPECT_NEAR(pVal[2], pRef[2], 0.5 / 255) << FmtAttribs.Name;
+                    EXPECT_EQ(pVal[3], 1.f) << FmtAttribs.Name;
+                    break;
+
+                case TEX_FORMAT_D24_UNORM_S8_UINT:
+                case TEX_FORMAT_D32_FLOAT_S8X24_UINT:
+                    EXPECT_NEAR(pVal[0], pRef[0], 1e-6) << FmtAttribs.Name;
+                    EXPECT_EQ(pVal[1], pRef[1]) << FmtAttribs.Name;
+                    break;
+
+                default:
+                {
+                    double Tolerance = 0;
+                    switch (FmtAttribs.ComponentType)
+                    {
+                        case COMPONENT_TYPE_UNORM_SRGB: Tolerance = 0.01; break;
+                        case COMPONENT_TYPE_DEPTH:
+                        case COMPONENT_TYPE_UNORM: Tolerance = 0.5 / (FmtAttribs.ComponentSize == 1 ? 255 : 65535); break;
+                        case COMPONENT_TYPE_SNORM: Tolerance = 0.5 / (FmtAttribs.ComponentSize == 1 ? 127 : 32767); break;
+                        case COMPONENT_TYPE_FLOAT: Tolerance = FmtAttribs.ComponentSize == 2 ? 1.0 / 2048 : 0; break;
+                        default: Tolerance = 0;
+                    }
+                    const Uint32 NumComps = FmtAttribs.ComponentType == COMPONENT_TYPE_DEPTH ? 1 : FmtAttribs.NumComponents;
+                    for (Uint32 c = 0; c < 4; ++c)
+                    {
+                        if (c < NumComps)
+                            EXPECT_NEAR(pVal[c], pRef[c], Tolerance) << FmtAttribs.Name << " component " << c;
+                        else
+                            EXPECT_EQ(pVal[c], c == 3 ? 1.f : 0.f) << FmtAttribs.Name << " component " << c;
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(GraphicsAccessories_TextureFormatConversion, SpecialValues)
+{
+    // Normalized values are clamped, NaN is converted to zero
+    {
+        const float RGBA[]  = {-1.f, 2.f, std::numeric_limits<float>::quiet_NaN(), 0.5f};
+        Uint8       Texel[] = {1, 1, 1, 1};
+        PackTexelRow(TEX_FORMAT_RGBA8_UNORM, RGBA, 1, Texel);
+        EXPECT_EQ(Texel[0], 0);
+        EXPECT_EQ(Texel[1], 255);
+        EXPECT_EQ(Texel[2], 0);
+        EXPECT_EQ(Texel[3], 128);
+    }
+
+    // -128 and -127 both map to -1
+    {
+        const Int8 Texel[] = {-128, -127};
+        float      RGBA[8];
+        UnpackTexelRow(TEX_FORMAT_R8_SNORM, Texel, 2, RGBA);
+        EXPECT_EQ(RGBA[0], -1.f);
+        EXPECT_EQ(RGBA[4], -1.f);
+    }
+
+    // R11G11B10
+    {
+        const float RGBA[] = {1.f, 65024.f, 0.5f, 1.f};
+        Uint32      Texel  = 0;
+        PackTexelRow(TEX_FORMAT_R11G11B10_FLOAT, RGBA, 1, &Texel);
+        EXPECT_EQ(Texel & 0x7FF, 15u << 6);
+        EXPECT_EQ((Texel >> 11) & 0x7FF, 0x7BFu); // largest finite 11-bit float
+        EXPECT_EQ(Texel >> 22, 14u << 5);
+
+        float Unpacked[4];
+        UnpackTexelRow(TEX_FORMAT_R11G11B10_FLOAT, &Texel, 1, Unpacked);
+        EXPECT_EQ(Unpacked[0], 1.f);
+        EXPECT_EQ(Unpacked[1], 65024.f);
+        EXPECT_EQ(Unpacked[2], 0.5f);
+    }
+
+    // RGB9E5
+    {
+        const float RGBA[] = {1.f, 0.5f, 0.f, 1.f};
+        Uint32      Texel  = 0;
+        PackTexelRow(TEX_FORMAT_RGB9E5_SHAREDEXP, RGBA, 1, &Texel);
+        // 1.0 = 256 * 2^(16 - 15 - 9)
+        EXPECT_EQ(Texel >> 27, 16u);
+        EXPECT_EQ(Texel & 0x1FF, 256u);
+        EXPECT_EQ((Texel >> 9) & 0x1FF, 128u);
+        EXPECT_EQ((Texel >> 18) & 0x1FF, 0u);
+
+        const float Large[] = {1e10f, 0.f, 0.f, 1.f};
+        PackTexelRow(TEX_FORMAT_RGB9E5_SHAREDEXP, Large, 1, &Texel);
+        float Unpacked[4];
+        UnpackTexelRow(TEX_FORMAT_RGB9E5_SHAREDEXP, &Texel, 1, Unpacked);
+        EXPECT_EQ(Unpacked[0], 65408.f);
+    }
+
+    // D24S8
+    {
+        const float RGBA[] = {1.f, 200.f, 0.f, 1.f};
+        Uint32      Texel  = 0;
+        PackTexelRow(TEX_FORMAT_D24_UNORM_S8_UINT, RGBA, 1, &Texel);
+        EXPECT_EQ(Texel, 0xC8FFFFFFu);
+    }
+}
+
+TEST(GraphicsAccessories_TextureFormatConversion, BC1)
+{
+    // Red and blue endpoints, every row uses a different index
+    const Uint8 Block[8] = {0x00, 0xF8, 0x1F, 0x00, 0x00, 0x55, 0xAA, 0xFF};
+
+    float RGBA[16 * 4];
+    DecompressBlock(TEX_FORMAT_BC1_UNORM, Block, RGBA);
+    const float Expected[4][3] = {
+        {1.f, 0.f, 0.f},
+        {0.f, 0.f, 1.f},
+        {2.f / 3.f, 0.f, 1.f / 3.f},
+        {1.f / 3.f, 0.f, 2.f / 3.f},
+    };
+    for (Uint32 i = 0; i < 16; ++i)
+    {
+        for (Uint32 c = 0; c < 3; ++c)
+            EXPECT_NEAR(RGBA[i * 4 + c], Expected[i / 4][c], 1e-6f) << "Texel " << i;
+        EXPECT_EQ(RGBA[i * 4 + 3], 1.f);
+    }
+
+    // Three-color mode: c0 <= c1, index 3 is transparent black
+    const Uint8 Block3[8] = {0x1F, 0x00, 0x00, 0xF8, 0xFF, 0xFF, 0xAA, 0xAA};
+    DecompressBlock(TEX_FORMAT_BC1_UNORM, Block3, RGBA);
+    for (Uint32 i = 0; i < 8; ++i)
+    {
+        EXPECT_EQ(RGBA[i * 4 + 0], 0.f);
+        EXPECT_EQ(RGBA[i * 4 + 3], 0.f);
+    }
+    for (Uint32 i = 8; i < 16; ++i)
+    {
+        EXPECT_NEAR(RGBA[i * 4 + 0], 0.5f, 1e-6f);
+        EXPECT_NEAR(RGBA[i * 4 + 2], 0.5f, 1e-6f);
+        EXPECT_EQ(RGBA[i * 4 + 3], 1.f);
+    }
+
+    // sRGB endpoints are converted to linear space
+    const Uint8 White[8] = {0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00};
+    DecompressBlock(TEX_FORMAT_BC1_UNORM_SRGB, White, RGBA);
+    EXPECT_NEAR(RGBA[0], 1.f, 1e-6f);
+}
+
+TEST(GraphicsAccessories_TextureFormatConversion, BC2_BC3_BC4_BC5)
+{
+    float RGBA[16 * 4];
+
+    // BC2 explicit alpha: texel i has alpha i
+    {
+        Uint8 Block[16] = {0x10, 0x32, 0x54, 0x76, 0x98, 0xBA, 0xDC, 0xFE, 0xFF, 0xFF, 0x00, 0x00};
+        DecompressBlock(TEX_FORMAT_BC2_UNORM, Block, RGBA);
+        for (Uint32 i = 0; i < 16; ++i)
+        {
+            EXPECT_NEAR(RGBA[i * 4 + 3], static_cast<float>(i) / 15.f, 1e-6f);
+            EXPECT_EQ(RGBA[i * 4 + 0], 1.f);
+        }
+    }
+
+    // BC4 eight-value mode: a0 = 255, a1 = 0, index 2 interpolates 6/7 of a0
+    {
+        // Index 1 for texel 0, index 2 for texel 1, index 0 for the rest
+        const Uint8 Block[8] = {0xFF, 0x00, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00};
+        DecompressBlock(TEX_FORMAT_BC4_UNORM, Block, RGBA);
+        EXPECT_EQ(RGBA[0], 0.f);
+        EXPECT_NEAR(RGBA[4], 6.f / 7.f, 1e-6f);
+        EXPECT_EQ(RGBA[8], 1.f);
+        EXPECT_EQ(RGBA[1], 0.f);
+        EXPECT_EQ(RGBA[3], 1.f);
+    }
+
+    // BC4 six-value mode: indices 6 and 7 are 0 and 1
+    {
+        // Index 6 for texel 0, index 7 for texel 1
+        const Uint8 Block[8] = {0x40, 0x80, 0x3E, 0x00, 0x00, 0x00, 0x00, 0x00};
+        DecompressBlock(TEX_FORMAT_BC4_UNORM, Block, RGBA);
+        EXPECT_EQ(RGBA[0], 0.f);
+        EXPECT_EQ(RGBA[4], 1.f);
+        EXPECT_NEAR(RGBA[8], 64.f / 255.f, 1e-6f);
+    }
+
+    // BC4 SNORM: -128 is treated as -127, six-value mode has -1 and 1
+    {
+        const Uint8 Block[8] = {0x80, 0x7F, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00};
+        DecompressBlock(TEX_FORMAT_BC4_SNORM, Block, RGBA);
+        EXPECT_EQ(RGBA[0], -1.f);
+        EXPECT_EQ(RGBA[4], 1.f);
+    }
+
+    // BC5: two independent channels
+    {
+        const Uint8 Block[16] = {0xFF, 0xFF, 0, 0, 0, 0, 0, 0, 0x00, 0x00, 0, 0, 0, 0, 0, 0};
+        DecompressBlock(TEX_FORMAT_BC5_UNORM, Block, RGBA);
+        for (Uint32 i = 0; i < 16; ++i)
+        {
+            EXPECT_EQ(RGBA[i * 4 + 0], 1.f);
+            EXPECT_EQ(RGBA[i * 4 + 1], 0.f);
+            EXPECT_EQ(RGBA[i * 4 + 2], 0.f);
+            EXPECT_EQ(RGBA[i * 4 + 3], 1.f);
+        }
+    }
+
+    // BC3 combines BC4 alpha and four-color BC1 block
+    {
+        const Uint8 Block[16] = {0x80, 0x80, 0, 0, 0, 0, 0, 0, 0x1F, 0x00, 0x00, 0xF8, 0xFF, 0xFF, 0xFF, 0xFF};
+        DecompressBlock(TEX_FORMAT_BC3_UNORM, Block, RGBA);
+        // c0 <= c1, but BC3 always uses four-color mode: index 3 is 2/3 c1 + 1/3 c0
+        EXPECT_NEAR(RGBA[0], 2.f / 3.f, 1e-6f);
+        EXPECT_NEAR(RGBA[2], 1.f / 3.f, 1e-6f);
+        EXPECT_NEAR(RGBA[3], 128.f / 255.f, 1e-6f);
+    }
+}
+
+TEST(GraphicsAccessories_TextureFormatConversion, BC7)
+{
+    float RGBA[16 * 4];
+
+    // Mode 6: single subset, 7-bit endpoints with per-endpoint p-bits and 4-bit indices
+    {
+        BlockBitWriter Block;
+        Block.Write(1 << 6, 7);
+        Block.Write(0, 7).Write(127, 7); // R
+        Block.Write(64, 7).Write(64, 7); // G
+        Block.Write(127, 7).Write(0, 7); // B
+        Block.Write(127, 7).Write(0, 7); // A
+        Block.Write(1, 1).Write(1, 1);   // P-bits
+        Block.Write(0, 3);               // Anchor index
+        for (Uint32 i = 1; i < 16; ++i)
+            Block.Write(i, 4);
+
+        DecompressBlock(TEX_FORMAT_BC7_UNORM, Block.GetData(), RGBA);
+        const Uint32 Weights[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+        for (Uint32 i = 0; i < 16; ++i)
+        {
+            const Uint32 W = Weights[i];
+            EXPECT_EQ(RGBA[i * 4 + 0], static_cast<float>((1 * (64 - W) + 255 * W + 32) >> 6) / 255.f) << i;
+            EXPECT_EQ(RGBA[i * 4 + 1], 129.f / 255.f) << i;
+            EXPECT_EQ(RGBA[i * 4 + 2], static_cast<float>((255 * (64 - W) + 1 * W + 32) >> 6) / 255.f) << i;
+            EXPECT_EQ(RGBA[i * 4 + 3], static_cast<float>((255 * (64 - W) + 1 * W + 32) >> 6) / 255.f) << i;
+        }
+    }
+
+    // Mode 5 with rotation: alpha and red are swapped after interpolation
+    {
+        BlockBitWriter Block;
+        Block.Write(1 << 5, 6);
+        Block.Write(1, 2);                 // Rotation: swap R and A
+        Block.Write(0, 7).Write(0, 7);     // R
+        Block.Write(127, 7).Write(127, 7); // G
+        Block.Write(0, 7).Write(0, 7);     // B
+        Block.Write(255, 8).Write(255, 8); // A
+        Block.Write(0, 31);                // Color indices
+        Block.Write(0, 31);                // Alpha indices
+
+        DecompressBlock(TEX_FORMAT_BC7_UNORM, Block.GetData(), RGBA);
+        EXPECT_EQ(RGBA[0], 1.f);
+        EXPECT_EQ(RGBA[1], 1.f);
+        EXPECT_EQ(RGBA[2], 0.f);
+        EXPECT_EQ(RGBA[3], 0.f);
+    }
+
+    // Mode 1: two subsets selected by the partition
+    for (Uint32 Partition : {0u, 13u, 34u, 63u})
+    {
+        BlockBitWriter Block;
+        Block.Write(1 << 1, 2);
+        Block.Write(Partition, 6);
+        for (Uint32 c = 0; c < 3; ++c)
+            Block.Write(0, 6).Write(0, 6).Write(63, 6).Write(63, 6);
+        Block.Write(0, 1).Write(1, 1); // Shared p-bits
+        Block.Write(0, 46);            // Indices
+
+        DecompressBlock(TEX_FORMAT_BC7_UNORM, Block.GetData(), RGBA);
+        // Texel 0 always belongs to the first subset
+        EXPECT_EQ(RGBA[0], 0.f);
+        Uint32 NumWhite = 0;
+        for (Uint32 i = 0; i < 16; ++i)
+        {
+            EXPECT_TRUE(RGBA[i * 4] == 0.f || RGBA[i * 4] == 1.f);
+            NumWhite += RGBA[i * 4] == 1.f ? 1 : 0;
+            EXPECT_EQ(RGBA[i * 4 + 3], 1.f);
+
+            // Partition 0 assigns the two right columns to the second subset
+            if (Partition == 0)
+            {
+                EXPECT_EQ(RGBA[i * 4], (i % 4) >= 2 ? 1.f : 0.f) << i;
+            }
+        }
+        EXPECT_GT(NumWhite, 0u);
+        EXPECT_LT(NumWhite, 16u);
+    }
+
+    // Reserved mode decodes to zero
+    {
+        const Uint8 Block[16] = {};
+        DecompressBlock(TEX_FORMAT_BC7_UNORM, Block, RGBA);
+        for (auto Val : RGBA)
+            EXPECT_EQ(Val, 0.f);
+    }
+}
+
+TEST(GraphicsAccessories_TextureFormatConversion, BC6H)
+{
+    float RGBA[16 * 4];
+
+    // Mode 11: single subset, 10-bit endpoints without delta compression
+    {
+        BlockBitWriter Block;
+        Block.Write(0x03, 5);
+        Block.Write(0, 10).Write(0, 10).Write(1023, 10);    // Endpoint 0
+        Block.Write(1023, 10).Write(0, 10).Write(1023, 10); // Endpoint 1
+        Block.Write(0, 3);                                  // Anchor index
+        for (Uint32 i = 1; i < 16; ++i)
+            Block.Write(15, 4);
+
+        DecompressBlock(TEX_FORMAT_BC6H_UF16, Block.GetData(), RGBA);
+        EXPECT_EQ(RGBA[0], 0.f);
+        EXPECT_EQ(RGBA[2], 65504.f);
+        EXPECT_EQ(RGBA[3], 1.f);
+        for (Uint32 i = 1; i < 16; ++i)
+        {
+            EXPECT_EQ(RGBA[i * 4 + 0], 65504.f);
+            EXPECT_EQ(RGBA[i * 4 + 1], 0.f);
+            EXPECT_EQ(RGBA[i * 4 + 2], 65504.f);
+        }
+    }
+
+    // Mode 14: 16-bit base endpoint with 4-bit deltas; the high base bits are stored reversed
+    {
+        // The smallest unquantized value that maps to half 1.0
+        constexpr Uint32 Base = (0x3C00 * 64 + 30) / 31;
+
+        auto Reverse = [](Uint32 Bits, Uint32 NumBits) {
+            Uint32 Res = 0;
+            for (Uint32 i = 0; i < NumBits; ++i)
+                Res |= ((Bits >> i) & 0x01) << (NumBits - 1 - i);
+            return Res;
+        };
+
+        BlockBitWriter Block;
+        Block.Write(0x0F, 5);
+        Block.Write(Base & 0x3FF, 10).Write(Base & 0x3FF, 10).Write(Base & 0x3FF, 10);
+        for (Uint32 c = 0; c < 3; ++c)
+            Block.Write(0, 4).Write(Reverse(Base >> 10, 6), 6);
+        Block.Write(0, 63);
+
+        DecompressBlock(TEX_FORMAT_BC6H_UF16, Block.GetData(), RGBA);
+        for (Uint32 i = 0; i < 16; ++i)
+        {
+            EXPECT_EQ(RGBA[i * 4 + 0], 1.f) << i;
+            EXPECT_EQ(RGBA[i * 4 + 1], 1.f) << i;
+            EXPECT_EQ(RGBA[i * 4 + 2], 1.f) << i;
+        }
+    }
+
+    // Mode 11, signed: negative endpoints
+    {
+        BlockBitWriter Block;
+        Block.Write(0x03, 5);
+        Block.Write(0x200 + 1, 10).Write(0x200 + 1, 10).Write(0x200 + 1, 10); // -511: clamped to the largest magnitude
+        Block.Write(0, 10).Write(0, 10).Write(0, 10);
+        Block.Write(0, 63);
+
+        DecompressBlock(TEX_FORMAT_BC6H_SF16, Block.GetData(), RGBA);
+        EXPECT_EQ(RGBA[0], -65504.f);
+        EXPECT_EQ(RGBA[3], 1.f);
+    }
+
+    // Reserved mode decodes to zero
+    {
+        BlockBitWriter Block;
+        Block.Write(0x13, 5);
+        Block.Write(0, 123);
+        DecompressBlock(TEX_FORMAT_BC6H_UF16, Block.GetData(), RGBA);
+        for (auto Val : RGBA)
+            EXPECT_EQ(Val, 0.f);
+    }
+}
+
+TEST(GraphicsAccessories_TextureFormatConversion, ConvertTextureData)
+{
+    constexpr Uint32 Width  = 29;
+    constexpr Uint32 Height = 21;
+
+    FastRandInt        Rnd{0, 0, 255};
+    std::vector<Uint8> RGBA8(Width * Height * 4);
+    for (auto& Val : RGBA8)
+        Val = static_cast<Uint8>(Rnd());
+
+    ThreadPool Pool{4};
+
+    // RGBA8 -> BGRA8 swizzle, RGBA8 -> RGBA16F -> RGBA8 round trip
+    {
+        std::vector<Uint8> BGRA8(RGBA8.size());
+        EXPECT_TRUE(ConvertTextureData(Width, Height, TEX_FORMAT_RGBA8_UNORM, RGBA8.data(), Width * 4, TEX_FORMAT_BGRA8_UNORM, BGRA8.data(), Width * 4));
+        for (size_t i = 0; i < RGBA8.size(); i += 4)
+        {
+            EXPECT_EQ(BGRA8[i + 0], RGBA8[i + 2]);
+            EXPECT_EQ(BGRA8[i + 2], RGBA8[i + 0]);
+        }
+
+        // Padded destination rows
+        const Uint32       HalfStride = Width * 8 + 16;
+        std::vector<Uint8> RGBA16F(HalfStride * Height);
+        EXPECT_TRUE(ConvertTextureData(Width, Height, TEX_FORMAT_BGRA8_UNORM, BGRA8.data(), Width * 4, TEX_FORMAT_RGBA16_FLOAT, RGBA16F.data(), HalfStride, &Pool));
+
+        std::vector<Uint8> RoundTrip(RGBA8.size());
+        EXPECT_TRUE(ConvertTextureData(Width, Height, TEX_FORMAT_RGBA16_FLOAT, RGBA16F.data(), HalfStride, TEX_FORMAT_RGBA8_UNORM, RoundTrip.data(), Width * 4));
+        EXPECT_EQ(RoundTrip, RGBA8);
+    }
+
+    // BC1 -> RGBA8 with and without the thread pool
+    {
+        const Uint32       Stride = (Width + 3) / 4 * 8;
+        std::vector<Uint8> BC1(Stride * ((Height + 3) / 4));
+        for (auto& Val : BC1)
+            Val = static_cast<Uint8>(Rnd());
+
+        std::vector<Uint8> Ref(RGBA8.size());
+        std::vector<Uint8> Decoded(RGBA8.size());
+        EXPECT_TRUE(ConvertTextureData(Width, Height, TEX_FORMAT_BC1_UNORM, BC1.data(), Stride, TEX_FORMAT_RGBA8_UNORM, Ref.data(), Width * 4));
+        EXPECT_TRUE(ConvertTextureData(Width, Height, TEX_FORMAT_BC1_UNORM, BC1.data(), Stride, TEX_FORMAT_RGBA8_UNORM, Decoded.data(), Width * 4, &Pool));
+        EXPECT_EQ(Ref, Decoded);
+
+        // Texel (5, 6) is texel (1, 2) of block (1, 1)
+        float Block[16 * 4];
+        DecompressBlock(TEX_FORMAT_BC1_UNORM, &BC1[Stride + 8], Block);
+        for (Uint32 c = 0; c < 4; ++c)
+            EXPECT_EQ(Ref[(6 * Width + 5) * 4 + c], static_cast<Uint8>(Block[(2 * 4 + 1) * 4 + c] * 255.f + 0.5f));
+    }
+
+    // Unsupported formats
+    std::vector<Uint8> Dst(Width * Height * 16);
+    EXPECT_FALSE(ConvertTextureData(Width, Height, TEX_FORMAT_RGBA8_UNORM, RGBA8.data(), Width * 4, TEX_FORMAT_BC1_UNORM, Dst.data(), Width * 4));
+    EXPECT_FALSE(ConvertTextureData(Width, Height, TEX_FORMAT_RGBA8_TYPELESS, RGBA8.data(), Width * 4, TEX_FORMAT_RGBA8_UNORM, Dst.data(), Width * 4));
+}
+
+TEST(GraphicsAccessories_TextureFormatConversion, DISABLED_Performance)
+{
+    constexpr Uint32 Width  = 1024;
+    constexpr Uint32 Height = 1024;
+
+    std::vector<Uint8>  RGBA8(Width * Height * 4, 128);
+    std::vector<Uint16> RGBA16F(Width * Height * 4);
+    std::vector<Uint8>  BGRA8(Width * Height * 4);
+
+    auto Measure = [&](const char* Name, TEXTURE_FORMAT SrcFmt, const void* pSrc, Uint32 SrcStride, TEXTURE_FORMAT DstFmt, void* pDst, Uint32 DstStride) {
+        Timer T;
+        EXPECT_TRUE(ConvertTextureData(Width, Height, SrcFmt, pSrc, SrcStride, DstFmt, pDst, DstStride));
+        const auto Time = T.GetElapsedTime();
+        LOG_INFO_MESSAGE(Name, ": ", Time * 1000.0, " ms (", static_cast<double>(Width * Height) / Time * 1e-6, " MTexels/s)");
+    };
+    Measure("RGBA8 -> RGBA16F", TEX_FORMAT_RGBA8_UNORM, RGBA8.data(), Width * 4, TEX_FORMAT_RGBA16_FLOAT, RGBA16F.data(), Width * 8);
+    Measure("RGBA16F -> BGRA8", TEX_FORMAT_RGBA16_FLOAT, RGBA16F.data(), Width * 8, TEX_FORMAT_BGRA8_UNORM, BGRA8.data(), Width * 4);
+    Measure("BGRA8 -> RGBA8", TEX_FORMAT_BGRA8_UNORM, BGRA8.data(), Width * 4, TEX_FORMAT_RGBA8_UNORM, RGBA8.data(), Width * 4);
+    Measure("BC1 -> RGBA8", TEX_FORMAT_BC1_UNORM, BGRA8.data(), Width * 2, TEX_FORMAT_RGBA8_UNORM, RGBA8.data(), Width * 4);
+}
+
+} // namespace
@@ -0,0 +1,176 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#include "StateObjectsRegistry.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "RenderDeviceBase.hpp"
+#include "ObjectBase.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+class DummySampler final : public ObjectBase<IDeviceObject>
+{
+public:
+    using TBase = ObjectBase<IDeviceObject>;
+
+    DummySampler(IReferenceCounters* pRefCounters, const SamplerDesc& Desc, StateObjectsRegistry<SamplerDesc>& Registry) :
+        TBase{pRefCounters},
+        m_Desc{Desc},
+        m_Registry{Registry}
+    {}
+
+    ~DummySampler()
+    {
+        m_Registry.ReportDeletedObject(m_Desc);
+    }
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_DeviceObject, TBase)
+
+    virtual const SamplerDesc& DILIGENT_CALL_TYPE GetDesc() const override final { return m_Desc; }
+    virtual Int32 DILIGENT_CALL_TYPE              GetUniqueID() const override final { return 0; }
+    virtual void DILIGENT_CALL_TYPE               SetUserData(IObject* /*pUserData*/) override final {}
+    virtual IObject* DILIGENT_CALL_TYPE           GetUserData() const override final { return nullptr; }
+
+private:
+    const SamplerDesc                  m_Desc;
+    StateObjectsRegistry<SamplerDesc>& m_Registry;
+};
+
+RefCntAutoPtr<IDeviceObject> FindOrCreate(StateObjectsRegistry<SamplerDesc>& Registry, const SamplerDesc& Desc)
+{
+    const auto                   Hash = Registry.ComputeHash(Desc);
+    RefCntAutoPtr<IDeviceObject> pObject;
+    Registry.Find(Desc, Hash, &pObject);
+    if (!pObject)
+    {
+        pObject = MakeNewRCObj<DummySampler>()(Desc, Registry);
+        Registry.Add(Desc, Hash, pObject);
+    }
+    return pObject;
+}
+
+TEST(GraphicsEngine_StateObjectsRegistry, FindAndAdd)
+{
+    StateObjectsRegistry<SamplerDesc> Registry{DefaultRawMemoryAllocator::GetAllocator(), "test"};
+
+    SamplerDesc LinearDesc;
+    LinearDesc.Name = "Linear";
+
+    SamplerDesc PointDesc;
+    PointDesc.MinFilter = FILTER_TYPE_POINT;
+    PointDesc.MagFilter = FILTER_TYPE_POINT;
+
+    auto pLinear = FindOrCreate(Registry, LinearDesc);
+    auto pPoint  = FindOrCreate(Registry, PointDesc);
+    EXPECT_NE(pLinear, pPoint);
+
+    // The name does not participate in the comparison
+    SamplerDesc LinearDesc2 = LinearDesc;
+    LinearDesc2.Name        = "Linear 2";
+    EXPECT_EQ(FindOrCreate(Registry, LinearDesc2), pLinear);
+    EXPECT_EQ(Registry.GetNumEntries(), 2u);
+
+    // Expired entries are removed on lookup
+    pPoint.Release();
+    {
+        RefCntAutoPtr<IDeviceObject> pObject;
+        Registry.Find(PointDesc, &pObject);
+        EXPECT_FALSE(pObject);
+    }
+    EXPECT_EQ(Registry.GetNumEntries(), 1u);
+
+    pLinear.Release();
+    Registry.Purge();
+    EXPECT_EQ(Registry.GetNumEntries(), 0u);
+}
+
+TEST(GraphicsEngine_StateObjectsRegistry, IncrementalPurge)
+{
+    StateObjectsRegistry<SamplerDesc> Registry{DefaultRawMemoryAllocator::GetAllocator(), "test"};
+
+    constexpr Uint32 NumObjects = 512;
+    for (Uint32 i = 0; i < NumObjects; ++i)
+    {
+        SamplerDesc Desc;
+        Desc.MipLODBias = static_cast<float>(i);
+        // The object is released immediately
+        FindOrCreate(Registry, Desc);
+    }
+
+    // Every shard is purged once it accumulates enough deleted objects,
+    // so the registry never holds more than a bounded number of expired entries.
+    EXPECT_LE(Registry.GetNumEntries(), size_t{StateObjectsRegistry<SamplerDesc>::NumShards * StateObjectsRegistry<SamplerDesc>::DeletedObjectsToPurge});
+}
+
+TEST(GraphicsEngine_StateObjectsRegistry, Concurrency)
+{
+    StateObjectsRegistry<SamplerDesc> Registry{DefaultRawMemoryAllocator::GetAllocator(), "test"};
+
+    constexpr Uint32 NumDescs   = 64;
+    constexpr Uint32 NumThreads = 8;
+
+    // Keep half of the objects alive so that both hits and re-creations are exercised
+    std::vector<RefCntAutoPtr<IDeviceObject>> KeepAlive(NumDescs / 2);
+
+    std::vector<std::vector<RefCntAutoPtr<IDeviceObject>>> Results(NumThreads);
+    std::vector<std::thread>                               Threads;
+    for (Uint32 t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back([&, t]() {
+            for (Uint32 iter = 0; iter < 16; ++iter)
+            {
+                for (Uint32 i = 0; i < NumDescs; ++i)
+                {
+                    SamplerDesc Desc;
+                    Desc.MaxAnisotropy = i;
+                    auto pObject       = FindOrCreate(Registry, Desc);
+                    EXPECT_EQ(static_cast<const SamplerDesc&>(pObject->GetDesc()).MaxAnisotropy, i);
+                    if (iter == 0 && i < NumDescs / 2)
+                        Results[t].push_back(pObject);
+                }
+            }
+        });
+    }
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    Results.clear();
+    Registry.Purge();
+    EXPECT_EQ(Registry.GetNumEntries(), 0u);
+}
+
+} // namespace
@@ -0,0 +1,290 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#include "RenderGraph.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TextureDesc MakeTexDesc(Uint32 Width, Uint32 Height, TEXTURE_FORMAT Format = TEX_FORMAT_RGBA8_UNORM)
+{
+    TextureDesc Desc;
+    Desc.Type      = RESOURCE_DIM_TEX_2D;
+    Desc.Width     = Width;
+    Desc.Height    = Height;
+    Desc.Format    = Format;
+    Desc.BindFlags = BIND_RENDER_TARGET | BIND_SHADER_RESOURCE | BIND_UNORDERED_ACCESS;
+    return Desc;
+}
+
+BufferDesc MakeBuffDesc(Uint32 Size)
+{
+    BufferDesc Desc;
+    Desc.uiSizeInBytes = Size;
+    Desc.BindFlags     = BIND_VERTEX_BUFFER | BIND_UNIFORM_BUFFER | BIND_UNORDERED_ACCESS;
+    return Desc;
+}
+
+TEST(RenderGraphTest, CullUnusedPasses)
+{
+    RenderGraph Graph;
+
+    auto A = Graph.CreateTexture(MakeTexDesc(64, 64));
+    auto B = Graph.CreateTexture(MakeTexDesc(64, 64));
+    auto C = Graph.CreateTexture(MakeTexDesc(64, 64));
+    auto D = Graph.CreateTexture(MakeTexDesc(64, 64));
+
+    auto Pass0 = Graph.AddPass("Pass0", nullptr);
+    Graph.Write(Pass0, A, RESOURCE_STATE_RENDER_TARGET);
+
+    auto Pass1 = Graph.AddPass("Pass1", nullptr, RENDER_GRAPH_PASS_FLAG_NEVER_CULL);
+    Graph.Read(Pass1, A, RESOURCE_STATE_SHADER_RESOURCE);
+    Graph.Write(Pass1, B, RESOURCE_STATE_RENDER_TARGET);
+
+    // Pass2 and Pass3 do not contribute to any live pass
+    auto Pass2 = Graph.AddPass("Pass2", nullptr);
+    Graph.Write(Pass2, C, RESOURCE_STATE_RENDER_TARGET);
+
+    auto Pass3 = Graph.AddPass("Pass3", nullptr);
+    Graph.Read(Pass3, C, RESOURCE_STATE_SHADER_RESOURCE);
+    Graph.Write(Pass3, D, RESOURCE_STATE_RENDER_TARGET);
+
+    ASSERT_TRUE(Graph.Compile());
+
+    EXPECT_FALSE(Graph.IsPassCulled(Pass0));
+    EXPECT_FALSE(Graph.IsPassCulled(Pass1));
+    EXPECT_TRUE(Graph.IsPassCulled(Pass2));
+    EXPECT_TRUE(Graph.IsPassCulled(Pass3));
+
+    const std::vector<Uint32> RefOrder = {Pass0, Pass1};
+    EXPECT_EQ(Graph.GetExecutionOrder(), RefOrder);
+
+    EXPECT_NE(Graph.GetPhysicalResourceIndex(A), ~0u);
+    EXPECT_NE(Graph.GetPhysicalResourceIndex(B), ~0u);
+    EXPECT_EQ(Graph.GetPhysicalResourceIndex(C), ~0u);
+    EXPECT_EQ(Graph.GetPhysicalResourceIndex(D), ~0u);
+}
+
+TEST(RenderGraphTest, KeepPreviousWriters)
+{
+    RenderGraph Graph;
+
+    auto A = Graph.CreateTexture(MakeTexDesc(64, 64));
+
+    auto Pass0 = Graph.AddPass("Clear", nullptr);
+    Graph.Write(Pass0, A, RESOURCE_STATE_RENDER_TARGET);
+
+    // The second pass may only update a part of the texture
+    auto Pass1 = Graph.AddPass("Draw", nullptr, RENDER_GRAPH_PASS_FLAG_NEVER_CULL);
+    Graph.Write(Pass1, A, RESOURCE_STATE_RENDER_TARGET);
+
+    ASSERT_TRUE(Graph.Compile());
+    EXPECT_FALSE(Graph.IsPassCulled(Pass0));
+    EXPECT_FALSE(Graph.IsPassCulled(Pass1));
+}
+
+TEST(RenderGraphTest, ReadUnwrittenResource)
+{
+    RenderGraph Graph;
+
+    auto A = Graph.CreateBuffer(MakeBuffDesc(256));
+
+    auto Pass = Graph.AddPass("Pass", nullptr, RENDER_GRAPH_PASS_FLAG_NEVER_CULL);
+    Graph.Read(Pass, A, RESOURCE_STATE_CONSTANT_BUFFER);
+
+    EXPECT_FALSE(Graph.Compile());
+}
+
+TEST(RenderGraphTest, Barriers)
+{
+    RenderGraph Graph;
+
+    auto Tex  = Graph.CreateTexture(MakeTexDesc(64, 64));
+    auto Buff = Graph.CreateBuffer(MakeBuffDesc(256));
+
+    auto Pass0 = Graph.AddPass("Pass0", nullptr);
+    Graph.Write(Pass0, Tex, RESOURCE_STATE_RENDER_TARGET);
+    Graph.Write(Pass0, Buff, RESOURCE_STATE_UNORDERED_ACCESS);
+
+    auto Pass1 = Graph.AddPass("Pass1", nullptr);
+    Graph.Read(Pass1, Tex, RESOURCE_STATE_SHADER_RESOURCE);
+    Graph.Write(Pass1, Buff, RESOURCE_STATE_UNORDERED_ACCESS);
+
+    auto Pass2 = Graph.AddPass("Pass2", nullptr, RENDER_GRAPH_PASS_FLAG_NEVER_CULL);
+    Graph.Read(Pass2, Tex, RESOURCE_STATE_SHADER_RESOURCE);
+    Graph.Read(Pass2, Buff, RESOURCE_STATE_VERTEX_BUFFER);
+    Graph.Read(Pass2, Buff, RESOURCE_STATE_CONSTANT_BUFFER);
+
+    auto Pass3 = Graph.AddPass("Pass3", nullptr, RENDER_GRAPH_PASS_FLAG_NEVER_CULL);
+    Graph.Read(Pass3, Buff, RESOURCE_STATE_CONSTANT_BUFFER);
+
+    ASSERT_TRUE(Graph.Compile());
+
+    {
+        const auto& Barriers = Graph.GetPassBarriers(Pass0);
+        ASSERT_EQ(Barriers.size(), 2u);
+        EXPECT_EQ(Barriers[0].ResourceId, Tex);
+        EXPECT_EQ(Barriers[0].OldState, RESOURCE_STATE_UNKNOWN);
+        EXPECT_EQ(Barriers[0].NewState, RESOURCE_STATE_RENDER_TARGET);
+        EXPECT_EQ(Barriers[1].ResourceId, Buff);
+        EXPECT_EQ(Barriers[1].OldState, RESOURCE_STATE_UNKNOWN);
+        EXPECT_EQ(Barriers[1].NewState, RESOURCE_STATE_UNORDERED_ACCESS);
+    }
+
+    {
+        // Consecutive unordered accesses require a UAV barrier
+        const auto& Barriers = Graph.GetPassBarriers(Pass1);
+        ASSERT_EQ(Barriers.size(), 2u);
+        EXPECT_EQ(Barriers[0].ResourceId, Tex);
+        EXPECT_EQ(Barriers[0].OldState, RESOURCE_STATE_RENDER_TARGET);
+        EXPECT_EQ(Barriers[0].NewState, RESOURCE_STATE_SHADER_RESOURCE);
+        EXPECT_EQ(Barriers[1].ResourceId, Buff);
+        EXPECT_EQ(Barriers[1].OldState, RESOURCE_STATE_UNORDERED_ACCESS);
+        EXPECT_EQ(Barriers[1].NewState, RESOURCE_STATE_UNORDERED_ACCESS);
+    }
+
+    {
+        // The texture is already in the shader resource state; buffer read states are combined
+        const auto& Barriers = Graph.GetPassBarriers(Pass2);
+        ASSERT_EQ(Barriers.size(), 1u);
+        EXPECT_EQ(Barriers[0].ResourceId, Buff);
+        EXPECT_EQ(Barriers[0].OldState, RESOURCE_STATE_UNORDERED_ACCESS);
+        EXPECT_EQ(Barriers[0].NewState, RESOURCE_STATE_VERTEX_BUFFER | RESOURCE_STATE_CONSTANT_BUFFER);
+    }
+
+    // Constant buffer state is included in the current read-only state
+    EXPECT_TRUE(Graph.GetPassBarriers(Pass3).empty());
+    EXPECT_TRUE(Graph.GetFinalBarriers().empty());
+}
+
+TEST(RenderGraphTest, InvalidStates)
+{
+    RenderGraph Graph;
+
+    auto Tex = Graph.CreateTexture(MakeTexDesc(64, 64));
+
+    // Render target state can't be combined with other states
+    auto Pass = Graph.AddPass("Pass", nullptr, RENDER_GRAPH_PASS_FLAG_NEVER_CULL);
+    Graph.Write(Pass, Tex, RESOURCE_STATE_RENDER_TARGET);
+    Graph.Read(Pass, Tex, RESOURCE_STATE_SHADER_RESOURCE);
+
+    EXPECT_FALSE(Graph.Compile());
+}
+
+TEST(RenderGraphTest, Aliasing)
+{
+    RenderGraph Graph;
+
+    auto A     = Graph.CreateTexture(MakeTexDesc(256, 256));
+    auto B     = Graph.CreateTexture(MakeTexDesc(256, 256));
+    auto C     = Graph.CreateTexture(MakeTexDesc(256, 256));
+    auto D     = Graph.CreateTexture(MakeTexDesc(128, 128));
+    auto E     = Graph.CreateTexture(MakeTexDesc(256, 256));
+    auto Buff0 = Graph.CreateBuffer(MakeBuffDesc(1024));
+    auto Buff1 = Graph.CreateBuffer(MakeBuffDesc(1024));
+
+    // A: [0, 1], B: [1, 2], C: [2, 3], D: [3, 4], E: [4, 4]
+    auto Pass0 = Graph.AddPass("Pass0", nullptr);
+    Graph.Write(Pass0, A, RESOURCE_STATE_RENDER_TARGET);
+    Graph.Write(Pass0, Buff0, RESOURCE_STATE_UNORDERED_ACCESS);
+
+    auto Pass1 = Graph.AddPass("Pass1", nullptr);
+    Graph.Read(Pass1, A, RESOURCE_STATE_SHADER_RESOURCE);
+    Graph.Read(Pass1, Buff0, RESOURCE_STATE_SHADER_RESOURCE);
+    Graph.Write(Pass1, B, RESOURCE_STATE_RENDER_TARGET);
+
+    auto Pass2 = Graph.AddPass("Pass2", nullptr);
+    Graph.Read(Pass2, B, RESOURCE_STATE_SHADER_RESOURCE);
+    Graph.Write(Pass2, C, RESOURCE_STATE_RENDER_TARGET);
+    Graph.Write(Pass2, Buff1, RESOURCE_STATE_UNORDERED_ACCESS);
+
+    auto Pass3 = Graph.AddPass("Pass3", nullptr);
+    Graph.Read(Pass3, C, RESOURCE_STATE_SHADER_RESOURCE);
+    Graph.Read(Pass3, Buff1, RESOURCE_STATE_SHADER_RESOURCE);
+    Graph.Write(Pass3, D, RESOURCE_STATE_RENDER_TARGET);
+
+    auto Pass4 = Graph.AddPass("Pass4", nullptr, RENDER_GRAPH_PASS_FLAG_NEVER_CULL);
+    Graph.Read(Pass4, D, RESOURCE_STATE_SHADER_RESOURCE);
+    Graph.Write(Pass4, E, RESOURCE_STATE_RENDER_TARGET);
+
+    ASSERT_TRUE(Graph.Compile());
+
+    const auto PhysA = Graph.GetPhysicalResourceIndex(A);
+    const auto PhysB = Graph.GetPhysicalResourceIndex(B);
+    const auto PhysC = Graph.GetPhysicalResourceIndex(C);
+    const auto PhysD = Graph.GetPhysicalResourceIndex(D);
+    const auto PhysE = Graph.GetPhysicalResourceIndex(E);
+
+    // A, C and E have identical descriptions and non-overlapping lifetimes
+    EXPECT_EQ(PhysA, PhysC);
+    EXPECT_EQ(PhysA, PhysE);
+    // B overlaps with both A and C
+    EXPECT_NE(PhysA, PhysB);
+    // D has a different description
+    EXPECT_NE(PhysD, PhysA);
+    EXPECT_NE(PhysD, PhysB);
+    // Buffer lifetimes do not overlap either
+    EXPECT_EQ(Graph.GetPhysicalResourceIndex(Buff0), Graph.GetPhysicalResourceIndex(Buff1));
+
+    EXPECT_EQ(Graph.GetPhysicalResourceCount(), 4u);
+
+    // The first use of an aliased resource starts from the state left by the previous resource,
+    // which is only known when the graph is executed.
+    const auto& Barriers = Graph.GetPassBarriers(Pass2);
+    ASSERT_EQ(Barriers.size(), 3u);
+    EXPECT_EQ(Barriers[1].ResourceId, C);
+    EXPECT_EQ(Barriers[1].OldState, RESOURCE_STATE_UNKNOWN);
+}
+
+TEST(RenderGraphTest, Reset)
+{
+    RenderGraph Graph;
+
+    for (Uint32 Frame = 0; Frame < 3; ++Frame)
+    {
+        Graph.Reset();
+        EXPECT_EQ(Graph.GetPassCount(), 0u);
+
+        auto A = Graph.CreateBuffer(MakeBuffDesc(128 * (Frame + 1)));
+
+        auto Pass0 = Graph.AddPass("Pass0", nullptr);
+        Graph.Write(Pass0, A, RESOURCE_STATE_UNORDERED_ACCESS);
+
+        auto Pass1 = Graph.AddPass("Pass1", nullptr, RENDER_GRAPH_PASS_FLAG_NEVER_CULL);
+        Graph.Read(Pass1, A, RESOURCE_STATE_VERTEX_BUFFER);
+
+        ASSERT_TRUE(Graph.Compile());
+        EXPECT_EQ(Graph.GetExecutionOrder().size(), 2u);
+        EXPECT_EQ(Graph.GetPhysicalResourceCount(), 1u);
+    }
+}
+
+} // namespace
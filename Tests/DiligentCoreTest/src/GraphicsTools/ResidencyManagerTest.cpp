@@ -0,0 +1,153 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#include "ResidencyManager.hpp"
+
+#include <vector>
+#include <algorithm>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(ResidencyManagerTest, LRUEviction)
+{
+    ResidencyManager Mgr;
+
+    std::vector<EvictableResourceId> Evicted;
+    auto OnEvict = [&Evicted](EvictableResourceId Id) { Evicted.push_back(Id); };
+
+    auto A = Mgr.RegisterResource(100, OnEvict);
+    auto B = Mgr.RegisterResource(200, OnEvict);
+    auto C = Mgr.RegisterResource(300, OnEvict);
+    EXPECT_EQ(Mgr.GetResidentSize(), 600u);
+    EXPECT_EQ(Mgr.GetResidentCount(), 3u);
+
+    Mgr.MarkUsed(A, 3);
+    Mgr.MarkUsed(B, 1);
+    Mgr.MarkUsed(C, 2);
+
+    // B is the least recently used resource
+    EXPECT_EQ(Mgr.Evict(150, 10), 200u);
+    ASSERT_EQ(Evicted.size(), 1u);
+    EXPECT_EQ(Evicted[0], B);
+    EXPECT_FALSE(Mgr.IsResident(B));
+    EXPECT_TRUE(Mgr.IsResident(A));
+    EXPECT_EQ(Mgr.GetResidentSize(), 400u);
+
+    // C, then A
+    Evicted.clear();
+    EXPECT_EQ(Mgr.Evict(350, 10), 400u);
+    ASSERT_EQ(Evicted.size(), 2u);
+    EXPECT_EQ(Evicted[0], C);
+    EXPECT_EQ(Evicted[1], A);
+    EXPECT_EQ(Mgr.GetResidentSize(), 0u);
+    EXPECT_EQ(Mgr.GetResidentCount(), 0u);
+}
+
+TEST(ResidencyManagerTest, InFlightResources)
+{
+    ResidencyManager Mgr;
+
+    std::vector<EvictableResourceId> Evicted;
+    auto OnEvict = [&Evicted](EvictableResourceId Id) { Evicted.push_back(Id); };
+
+    auto A = Mgr.RegisterResource(100, OnEvict, 5);
+    auto B = Mgr.RegisterResource(100, OnEvict, 2);
+
+    // A was used by the work that has not completed yet
+    EXPECT_EQ(Mgr.Evict(1000, 4), 100u);
+    ASSERT_EQ(Evicted.size(), 1u);
+    EXPECT_EQ(Evicted[0], B);
+    EXPECT_TRUE(Mgr.IsResident(A));
+
+    // Fence values never go back
+    Mgr.MarkUsed(A, 3);
+    Evicted.clear();
+    EXPECT_EQ(Mgr.Evict(1000, 4), 0u);
+    EXPECT_TRUE(Evicted.empty());
+
+    EXPECT_EQ(Mgr.Evict(1000, 5), 100u);
+    ASSERT_EQ(Evicted.size(), 1u);
+    EXPECT_EQ(Evicted[0], A);
+}
+
+TEST(ResidencyManagerTest, Unregister)
+{
+    ResidencyManager Mgr;
+
+    bool Called = false;
+    auto A      = Mgr.RegisterResource(100, [&Called](EvictableResourceId) { Called = true; });
+    Mgr.UnregisterResource(A);
+    EXPECT_FALSE(Mgr.IsResident(A));
+    EXPECT_EQ(Mgr.GetResidentSize(), 0u);
+    EXPECT_EQ(Mgr.Evict(100, 10), 0u);
+    EXPECT_FALSE(Called);
+}
+
+TEST(ResidencyManagerTest, CustomPolicy)
+{
+    // Evicts the largest resources first
+    class LargestFirstPolicy final : public EvictionPolicy
+    {
+    public:
+        virtual void SelectVictims(const std::vector<EvictableResourceInfo>& Candidates,
+                                   Uint64                                    BytesToFree,
+                                   std::vector<EvictableResourceId>&         Victims) override final
+        {
+            auto SortedCandidates = Candidates;
+            std::sort(SortedCandidates.begin(), SortedCandidates.end(),
+                      [](const EvictableResourceInfo& lhs, const EvictableResourceInfo& rhs) { return lhs.Size > rhs.Size; });
+            Uint64 Freed = 0;
+            for (const auto& Candidate : SortedCandidates)
+            {
+                if (Freed >= BytesToFree)
+                    break;
+                Victims.push_back(Candidate.Id);
+                Freed += Candidate.Size;
+            }
+        }
+    };
+
+    ResidencyManager Mgr{std::unique_ptr<EvictionPolicy>{new LargestFirstPolicy}};
+
+    std::vector<EvictableResourceId> Evicted;
+    auto OnEvict = [&Evicted](EvictableResourceId Id) { Evicted.push_back(Id); };
+
+    Mgr.RegisterResource(100, OnEvict, 1);
+    auto B = Mgr.RegisterResource(300, OnEvict, 2);
+    Mgr.RegisterResource(200, OnEvict, 3);
+
+    EXPECT_EQ(Mgr.Evict(50, 10), 300u);
+    ASSERT_EQ(Evicted.size(), 1u);
+    EXPECT_EQ(Evicted[0], B);
+}
+
+} // namespace
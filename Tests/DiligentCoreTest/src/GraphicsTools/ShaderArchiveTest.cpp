@@ -0,0 +1,253 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "ShaderArchive.hpp"
+
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+const Uint32 TestByteCode0[] = {0x07230203, 0x00010000, 0x00080001, 0x00000010};
+const Uint32 TestByteCode1[] = {0x07230203, 0x00010000, 0x00080001, 0x00000020, 0x00000030};
+const Uint8  TestResources[] = {1, 2, 3, 4, 5, 6, 7};
+
+ShaderArchiveWriter::ShaderData GetTestShaderData(const char* Name, const ShaderMacro* Macros, const Uint32* pByteCode, size_t ByteCodeSize)
+{
+    ShaderArchiveWriter::ShaderData Data;
+    Data.Name         = Name;
+    Data.Macros       = Macros;
+    Data.ShaderType   = SHADER_TYPE_VERTEX;
+    Data.EntryPoint   = "VSMain";
+    Data.pByteCode    = pByteCode;
+    Data.ByteCodeSize = ByteCodeSize;
+    return Data;
+}
+
+TEST(GraphicsTools_ShaderArchive, PermutationKey)
+{
+    const ShaderMacro Macros0[] = {{"B", "1"}, {"A", "0"}, {nullptr, nullptr}};
+    const ShaderMacro Macros1[] = {{"A", "0"}, {"B", "1"}, {nullptr, nullptr}};
+    const ShaderMacro Macros2[] = {{"A", "1"}, {"B", "1"}, {nullptr, nullptr}};
+
+    EXPECT_EQ(BuildShaderPermutationKey(Macros0), BuildShaderPermutationKey(Macros1));
+    EXPECT_NE(BuildShaderPermutationKey(Macros0), BuildShaderPermutationKey(Macros2));
+    EXPECT_EQ(BuildShaderPermutationKey(nullptr), "");
+}
+
+TEST(GraphicsTools_ShaderArchive, ShaderRoundtrip)
+{
+    const ShaderMacro Macros0[] = {{"FLIP", "0"}, {nullptr, nullptr}};
+    const ShaderMacro Macros1[] = {{"USE_FOG", "1"}, {"FLIP", "1"}, {nullptr, nullptr}};
+
+    ShaderArchiveWriter Writer{SHADER_ARCHIVE_TARGET_SPIRV};
+
+    auto Data0 = GetTestShaderData("VS", Macros0, TestByteCode0, sizeof(TestByteCode0));
+    EXPECT_TRUE(Writer.AddShader(Data0));
+
+    auto Data1          = GetTestShaderData("VS", Macros1, TestByteCode1, sizeof(TestByteCode1));
+    Data1.pResources    = TestResources;
+    Data1.ResourcesSize = sizeof(TestResources);
+    EXPECT_TRUE(Writer.AddShader(Data1));
+
+    auto Data2       = GetTestShaderData("PS", nullptr, TestByteCode0, sizeof(TestByteCode0));
+    Data2.ShaderType = SHADER_TYPE_PIXEL;
+    EXPECT_TRUE(Writer.AddShader(Data2));
+
+    // Same permutation cannot be added twice
+    EXPECT_FALSE(Writer.AddShader(Data0));
+    EXPECT_EQ(Writer.GetShaderCount(), 3u);
+
+    RefCntAutoPtr<IDataBlob> pData;
+    ASSERT_TRUE(Writer.Serialize(&pData));
+    ASSERT_TRUE(pData);
+
+    ShaderArchive Archive{pData};
+    ASSERT_TRUE(Archive.IsValid());
+    EXPECT_EQ(Archive.GetTarget(), SHADER_ARCHIVE_TARGET_SPIRV);
+    EXPECT_EQ(Archive.GetShaderCount(), 3u);
+    EXPECT_EQ(Archive.GetPipelineCount(), 0u);
+
+    // Macro order does not matter
+    const ShaderMacro Macros1Reordered[] = {{"FLIP", "1"}, {"USE_FOG", "1"}, {nullptr, nullptr}};
+
+    ShaderArchive::ShaderInfo Info;
+    ASSERT_TRUE(Archive.FindShader("VS", Macros1Reordered, Info));
+    EXPECT_STREQ(Info.Name, "VS");
+    EXPECT_STREQ(Info.EntryPoint, "VSMain");
+    EXPECT_EQ(Info.ShaderType, SHADER_TYPE_VERTEX);
+    ASSERT_EQ(Info.ByteCodeSize, sizeof(TestByteCode1));
+    EXPECT_EQ(memcmp(Info.pByteCode, TestByteCode1, sizeof(TestByteCode1)), 0);
+    ASSERT_EQ(Info.ResourcesSize, sizeof(TestResources));
+    EXPECT_EQ(memcmp(Info.pResources, TestResources, sizeof(TestResources)), 0);
+
+    ASSERT_TRUE(Archive.FindShader("VS", Macros0, Info));
+    ASSERT_EQ(Info.ByteCodeSize, sizeof(TestByteCode0));
+    EXPECT_EQ(memcmp(Info.pByteCode, TestByteCode0, sizeof(TestByteCode0)), 0);
+    EXPECT_EQ(Info.pResources, nullptr);
+
+    ASSERT_TRUE(Archive.FindShader("PS", nullptr, Info));
+    EXPECT_EQ(Info.ShaderType, SHADER_TYPE_PIXEL);
+
+    EXPECT_FALSE(Archive.FindShader("VS", nullptr, Info));
+    EXPECT_FALSE(Archive.FindShader("GS", nullptr, Info));
+
+    // The archive can also be used in place without the data blob
+    ShaderArchive RawArchive{pData->GetDataPtr(), pData->GetSize()};
+    EXPECT_TRUE(RawArchive.IsValid());
+    EXPECT_TRUE(RawArchive.FindShader("VS", Macros0, Info));
+}
+
+TEST(GraphicsTools_ShaderArchive, GLSLSource)
+{
+    static constexpr char Source[] = "void main(){}";
+
+    ShaderArchiveWriter::ShaderData Data;
+    Data.Name         = "CS";
+    Data.ShaderType   = SHADER_TYPE_COMPUTE;
+    Data.pByteCode    = Source;
+    Data.ByteCodeSize = sizeof(Source) - 1;
+
+    ShaderArchiveWriter Writer{SHADER_ARCHIVE_TARGET_GLSL};
+    EXPECT_TRUE(Writer.AddShader(Data));
+
+    RefCntAutoPtr<IDataBlob> pData;
+    ASSERT_TRUE(Writer.Serialize(&pData));
+
+    ShaderArchive Archive{pData};
+    ASSERT_TRUE(Archive.IsValid());
+
+    ShaderArchive::ShaderInfo Info;
+    ASSERT_TRUE(Archive.FindShader("CS", nullptr, Info));
+    EXPECT_EQ(Info.ByteCodeSize, sizeof(Source) - 1);
+    // GLSL source is null-terminated in the archive
+    EXPECT_STREQ(static_cast<const char*>(Info.pByteCode), Source);
+}
+
+TEST(GraphicsTools_ShaderArchive, Pipelines)
+{
+    ShaderArchiveWriter Writer{SHADER_ARCHIVE_TARGET_SPIRV};
+
+    const ShaderMacro Macros[] = {{"FLIP", "1"}, {nullptr, nullptr}};
+    EXPECT_TRUE(Writer.AddShader(GetTestShaderData("VS", Macros, TestByteCode0, sizeof(TestByteCode0))));
+
+    auto CSData       = GetTestShaderData("CS", nullptr, TestByteCode1, sizeof(TestByteCode1));
+    CSData.ShaderType = SHADER_TYPE_COMPUTE;
+    EXPECT_TRUE(Writer.AddShader(CSData));
+
+    {
+        GraphicsPipelineStateCreateInfo PSOCreateInfo;
+        PSOCreateInfo.PSODesc.Name = "Graphics PSO";
+
+        LayoutElement Elems[] = {LayoutElement{0, 0, 3, VT_FLOAT32}};
+
+        PSOCreateInfo.GraphicsPipeline.InputLayout.LayoutElements = Elems;
+        PSOCreateInfo.GraphicsPipeline.InputLayout.NumElements    = 1;
+
+        ShaderArchiveGraphicsShaders Shaders;
+        Shaders.VS = ShaderArchiveShaderRef{"VS", Macros};
+        EXPECT_TRUE(Writer.AddGraphicsPipeline(PSOCreateInfo, Shaders));
+        // Pipeline names must be unique
+        EXPECT_FALSE(Writer.AddGraphicsPipeline(PSOCreateInfo, Shaders));
+    }
+
+    {
+        ComputePipelineStateCreateInfo PSOCreateInfo;
+        PSOCreateInfo.PSODesc.Name         = "Compute PSO";
+        PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE_COMPUTE;
+        EXPECT_TRUE(Writer.AddComputePipeline(PSOCreateInfo, ShaderArchiveShaderRef{"CS"}));
+    }
+
+    {
+        RefCntAutoPtr<IDataBlob> pData;
+        ASSERT_TRUE(Writer.Serialize(&pData));
+
+        ShaderArchive Archive{pData};
+        ASSERT_TRUE(Archive.IsValid());
+        ASSERT_EQ(Archive.GetPipelineCount(), 2u);
+        // Pipelines are sorted by name
+        EXPECT_STREQ(Archive.GetPipelineName(0), "Compute PSO");
+        EXPECT_STREQ(Archive.GetPipelineName(1), "Graphics PSO");
+    }
+
+    {
+        // Pipeline references the permutation that is not in the archive
+        ComputePipelineStateCreateInfo PSOCreateInfo;
+        PSOCreateInfo.PSODesc.Name         = "Invalid PSO";
+        PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE_COMPUTE;
+        EXPECT_TRUE(Writer.AddComputePipeline(PSOCreateInfo, ShaderArchiveShaderRef{"CS", Macros}));
+
+        RefCntAutoPtr<IDataBlob> pData;
+        EXPECT_FALSE(Writer.Serialize(&pData));
+    }
+}
+
+TEST(GraphicsTools_ShaderArchive, InvalidData)
+{
+    ShaderArchiveWriter Writer{SHADER_ARCHIVE_TARGET_SPIRV};
+    EXPECT_TRUE(Writer.AddShader(GetTestShaderData("VS", nullptr, TestByteCode0, sizeof(TestByteCode0))));
+
+    RefCntAutoPtr<IDataBlob> pData;
+    ASSERT_TRUE(Writer.Serialize(&pData));
+
+    // Copy to 8-byte aligned storage
+    std::vector<Uint64> Data((pData->GetSize() + 7) / 8);
+    memcpy(Data.data(), pData->GetDataPtr(), pData->GetSize());
+
+    {
+        ShaderArchive Archive{Data.data(), pData->GetSize()};
+        EXPECT_TRUE(Archive.IsValid());
+    }
+
+    {
+        // Truncated data
+        ShaderArchive Archive{Data.data(), pData->GetSize() - 8};
+        EXPECT_FALSE(Archive.IsValid());
+    }
+
+    {
+        // Invalid magic
+        auto InvalidData = Data;
+        reinterpret_cast<Uint8*>(InvalidData.data())[0] ^= 0xFF;
+
+        ShaderArchive Archive{InvalidData.data(), pData->GetSize()};
+        EXPECT_FALSE(Archive.IsValid());
+    }
+
+    {
+        ShaderArchive Archive{nullptr, 0};
+        EXPECT_FALSE(Archive.IsValid());
+        EXPECT_EQ(Archive.GetShaderCount(), 0u);
+    }
+}
+
+} // namespace
@@ -0,0 +1,76 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#include "ShaderMacroHelper.hpp"
+
+#include <cstring>
+#include <memory>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(ShaderMacroHelperTest, Copy)
+{
+    std::unique_ptr<ShaderMacroHelper> pSrc{new ShaderMacroHelper};
+    pSrc->AddShaderMacro("INT_MACRO", 1);
+    pSrc->AddShaderMacro("STR_MACRO", "Value");
+    pSrc->Finalize();
+
+    ShaderMacroHelper Copy{*pSrc};
+
+    ShaderMacroHelper Assigned;
+    Assigned.AddShaderMacro("OTHER_MACRO", 2.5f);
+    Assigned = *pSrc;
+
+    // The copies must not reference the definitions owned by the source helper
+    pSrc.reset();
+
+    for (auto* pHelper : {&Copy, &Assigned})
+    {
+        const ShaderMacro* Macros = *pHelper;
+        ASSERT_NE(Macros, nullptr);
+        EXPECT_STREQ(Macros[0].Name, "INT_MACRO");
+        EXPECT_STREQ(Macros[0].Definition, "1");
+        EXPECT_STREQ(Macros[1].Name, "STR_MACRO");
+        EXPECT_STREQ(Macros[1].Definition, "Value");
+        EXPECT_EQ(Macros[2].Name, nullptr);
+        EXPECT_EQ(Macros[2].Definition, nullptr);
+    }
+
+    // The copy can be extended independently
+    Copy.AddShaderMacro("NEW_MACRO", true);
+    const ShaderMacro* Macros = Copy;
+    EXPECT_STREQ(Macros[2].Name, "NEW_MACRO");
+    EXPECT_STREQ(Macros[2].Definition, "1");
+    EXPECT_EQ(Macros[3].Name, nullptr);
+}
+
+} // namespace
@@ -0,0 +1,180 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#include "ShaderSourceDependencyRecorder.hpp"
+
+#include <map>
+#include <string>
+
+#include "DataBlobImpl.hpp"
+#include "MemoryFileStream.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+class TestShaderSourceFactory final : public ObjectBase<IShaderSourceInputStreamFactory>
+{
+public:
+    using TBase = ObjectBase<IShaderSourceInputStreamFactory>;
+
+    TestShaderSourceFactory(IReferenceCounters* pRefCounters) :
+        TBase{pRefCounters}
+    {}
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_IShaderSourceInputStreamFactory, TBase);
+
+    virtual void DILIGENT_CALL_TYPE CreateInputStream(const Char* Name, IFileStream** ppStream) override final
+    {
+        CreateInputStream2(Name, CREATE_SHADER_SOURCE_INPUT_STREAM_FLAG_NONE, ppStream);
+    }
+
+    virtual void DILIGENT_CALL_TYPE CreateInputStream2(const Char*                             Name,
+                                                       CREATE_SHADER_SOURCE_INPUT_STREAM_FLAGS /*Flags*/,
+                                                       IFileStream**                           ppStream) override final
+    {
+        *ppStream = nullptr;
+
+        auto it = Files.find(Name);
+        if (it == Files.end())
+            return;
+
+        RefCntAutoPtr<DataBlobImpl> pData{MakeNewRCObj<DataBlobImpl>()(it->second.size())};
+        memcpy(pData->GetDataPtr(), it->second.data(), it->second.size());
+        RefCntAutoPtr<MemoryFileStream> pStream{MakeNewRCObj<MemoryFileStream>()(pData)};
+        pStream->QueryInterface(IID_FileStream, reinterpret_cast<IObject**>(ppStream));
+    }
+
+    std::map<std::string, std::string> Files;
+};
+
+std::string ReadFile(IShaderSourceInputStreamFactory* pFactory, const char* Name)
+{
+    RefCntAutoPtr<IFileStream> pStream;
+    pFactory->CreateInputStream2(Name, CREATE_SHADER_SOURCE_INPUT_STREAM_FLAG_SILENT, &pStream);
+    if (!pStream)
+        return "";
+
+    RefCntAutoPtr<IDataBlob> pData{MakeNewRCObj<DataBlobImpl>()(0)};
+    pStream->ReadBlob(pData);
+    return std::string{static_cast<const char*>(pData->GetConstDataPtr()), pData->GetSize()};
+}
+
+TEST(GraphicsTools_ShaderSourceDependencyRecorder, RecordDependencies)
+{
+    RefCntAutoPtr<TestShaderSourceFactory> pFactory{MakeNewRCObj<TestShaderSourceFactory>()()};
+    pFactory->Files["Main.hlsl"]   = "#include \"Common.fxh\"\n";
+    pFactory->Files["Common.fxh"]  = "float4 g_Color;\n";
+    pFactory->Files["Unused.fxh"]  = "float4 g_Unused;\n";
+    pFactory->Files["Another.fxh"] = "#include \"Common.fxh\"\n";
+
+    RefCntAutoPtr<ShaderSourceDependencyRecorder> pRecorder{MakeNewRCObj<ShaderSourceDependencyRecorder>()(pFactory)};
+
+    EXPECT_EQ(ReadFile(pRecorder, "Main.hlsl"), pFactory->Files["Main.hlsl"]);
+    EXPECT_EQ(ReadFile(pRecorder, "Common.fxh"), pFactory->Files["Common.fxh"]);
+    EXPECT_EQ(ReadFile(pRecorder, "Another.fxh"), pFactory->Files["Another.fxh"]);
+    EXPECT_EQ(ReadFile(pRecorder, "Common.fxh"), pFactory->Files["Common.fxh"]);
+    EXPECT_EQ(ReadFile(pRecorder, "Missing.fxh"), "");
+
+    const auto Deps = pRecorder->GetDependencies();
+    ASSERT_EQ(Deps.size(), size_t{4});
+    EXPECT_EQ(Deps[0].Name, "Another.fxh");
+    EXPECT_EQ(Deps[1].Name, "Common.fxh");
+    EXPECT_EQ(Deps[2].Name, "Main.hlsl");
+    EXPECT_EQ(Deps[3].Name, "Missing.fxh");
+    EXPECT_TRUE(Deps[1].Found);
+    EXPECT_FALSE(Deps[3].Found);
+    EXPECT_EQ(Deps[1].Size, pFactory->Files["Common.fxh"].size());
+    EXPECT_EQ(Deps[1].ContentHash, ShaderSourceDependencyRecorder::ComputeContentHash(pFactory->Files["Common.fxh"].data(), Deps[1].Size));
+
+    EXPECT_EQ(pRecorder->GetDependencyHash(), ShaderSourceDependencyRecorder::ComputeDependencyHash(Deps));
+
+    pRecorder->Reset();
+    EXPECT_TRUE(pRecorder->GetDependencies().empty());
+}
+
+TEST(GraphicsTools_ShaderSourceDependencyRecorder, StableHash)
+{
+    // The hashes may be stored persistently, so they must not change between builds and platforms
+    EXPECT_EQ(ShaderSourceDependencyRecorder::ComputeContentHash("abc", 3), static_cast<size_t>(0xe71fa2190541574bull));
+
+    const std::vector<ShaderSourceDependencyRecorder::Dependency> Deps = {
+        {"Common.fxh", 3, 4, true},
+        {"Missing.fxh", 0, 0, false},
+    };
+    EXPECT_EQ(ShaderSourceDependencyRecorder::ComputeDependencyHash(Deps), static_cast<size_t>(0x7cb100016fbae62cull));
+}
+
+TEST(GraphicsTools_ShaderSourceDependencyRecorder, UpToDateCheck)
+{
+    RefCntAutoPtr<TestShaderSourceFactory> pFactory{MakeNewRCObj<TestShaderSourceFactory>()()};
+    pFactory->Files["Main.hlsl"]  = "#include \"Common.fxh\"\n";
+    pFactory->Files["Common.fxh"] = "float4 g_Color;\n";
+
+    RefCntAutoPtr<ShaderSourceDependencyRecorder> pRecorder{MakeNewRCObj<ShaderSourceDependencyRecorder>()(pFactory)};
+    ReadFile(pRecorder, "Main.hlsl");
+    ReadFile(pRecorder, "Common.fxh");
+    ReadFile(pRecorder, "Missing.fxh");
+
+    const auto Deps = pRecorder->GetDependencies();
+    const auto Hash = pRecorder->GetDependencyHash();
+    EXPECT_TRUE(ShaderSourceDependencyRecorder::AreDependenciesUpToDate(pFactory, Deps));
+
+    // Same size, different contents
+    pFactory->Files["Common.fxh"] = "float4 g_Value;\n";
+    EXPECT_FALSE(ShaderSourceDependencyRecorder::AreDependenciesUpToDate(pFactory, Deps));
+
+    pFactory->Files["Common.fxh"] = "float4 g_Color;\n";
+    EXPECT_TRUE(ShaderSourceDependencyRecorder::AreDependenciesUpToDate(pFactory, Deps));
+
+    // A file that was missing has been added
+    pFactory->Files["Missing.fxh"] = "";
+    EXPECT_FALSE(ShaderSourceDependencyRecorder::AreDependenciesUpToDate(pFactory, Deps));
+    pFactory->Files.erase("Missing.fxh");
+
+    pFactory->Files.erase("Common.fxh");
+    EXPECT_FALSE(ShaderSourceDependencyRecorder::AreDependenciesUpToDate(pFactory, Deps));
+    pFactory->Files["Common.fxh"] = "float4 g_Color;\n";
+
+    pRecorder->Reset();
+    ReadFile(pRecorder, "Main.hlsl");
+    ReadFile(pRecorder, "Common.fxh");
+    ReadFile(pRecorder, "Missing.fxh");
+    EXPECT_EQ(pRecorder->GetDependencyHash(), Hash);
+
+    pFactory->Files["Common.fxh"] = "float3 g_Color;\n";
+    pRecorder->Reset();
+    ReadFile(pRecorder, "Main.hlsl");
+    ReadFile(pRecorder, "Common.fxh");
+    ReadFile(pRecorder, "Missing.fxh");
+    EXPECT_NE(pRecorder->GetDependencyHash(), Hash);
+}
+
+} // namespace
@@ -0,0 +1,537 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#include "TextureCompression.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "GraphicsAccessories.hpp"
+#include "TextureFormatConversion.hpp"
+#include "FastRand.hpp"
+#include "ThreadPool.hpp"
+#include "Timer.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+// Generates an RGBA8 image that combines smooth gradients, hard edges and noise
+std::vector<Uint8> GenerateTestImage(Uint32 Width, Uint32 Height)
+{
+    std::vector<Uint8> Image(size_t{Width} * Height * 4);
+
+    FastRandInt Noise{0, -6, 6};
+    for (Uint32 y = 0; y < Height; ++y)
+    {
+        for (Uint32 x = 0; x < Width; ++x)
+        {
+            const float fx = static_cast<float>(x);
+            const float fy = static_cast<float>(y);
+
+            float Color[4] = {
+                128.f + 127.f * std::sin(fx * 0.05f) * std::cos(fy * 0.03f),
+                fx * 255.f / static_cast<float>(Width),
+                128.f + 100.f * std::sin((fx + fy) * 0.02f),
+                255.f - std::min(std::sqrt(fx * fx + fy * fy) * 255.f / static_cast<float>(Width), 255.f) //
+            };
+
+            // Hard-edged rectangles
+            if (((x / 48) + (y / 40)) % 5 == 0)
+            {
+                Color[0] = 240;
+                Color[1] = 32;
+                Color[2] = 16;
+            }
+
+            auto* pTexel = &Image[(size_t{y} * Width + x) * 4];
+            for (Uint32 c = 0; c < 4; ++c)
+                pTexel[c] = static_cast<Uint8>(std::min(std::max(Color[c] + static_cast<float>(Noise()), 0.f), 255.f));
+        }
+    }
+
+    return Image;
+}
+
+// Reference decoders for the block modes produced by the encoder
+
+inline Uint32 Expand5(Uint32 v) { return (v << 3) | (v >> 2); }
+inline Uint32 Expand6(Uint32 v) { return (v << 2) | (v >> 4); }
+
+void DecodeBC1ColorBlock(const Uint8* pBlock, Uint8 Texels[16][4])
+{
+    const Uint32 C0 = pBlock[0] | (pBlock[1] << 8u);
+    const Uint32 C1 = pBlock[2] | (pBlock[3] << 8u);
+
+    const Uint32 E[2][3] = {
+        {Expand5(C0 >> 11u), Expand6((C0 >> 5u) & 0x3Fu), Expand5(C0 & 0x1Fu)},
+        {Expand5(C1 >> 11u), Expand6((C1 >> 5u) & 0x3Fu), Expand5(C1 & 0x1Fu)} //
+    };
+
+    Uint32 Palette[4][3];
+    for (Uint32 c = 0; c < 3; ++c)
+    {
+        Palette[0][c] = E[0][c];
+        Palette[1][c] = E[1][c];
+        if (C0 > C1)
+        {
+            Palette[2][c] = (2 * E[0][c] + E[1][c] + 1) / 3;
+            Palette[3][c] = (E[0][c] + 2 * E[1][c] + 1) / 3;
+        }
+        else
+        {
+            Palette[2][c] = (E[0][c] + E[1][c]) / 2;
+            Palette[3][c] = 0;
+        }
+    }
+
+    const Uint32 Bits = pBlock[4] | (pBlock[5] << 8u) | (pBlock[6] << 16u) | (Uint32{pBlock[7]} << 24u);
+    for (Uint32 i = 0; i < 16; ++i)
+    {
+        const auto Idx = (Bits >> (i * 2)) & 0x03u;
+        for (Uint32 c = 0; c < 3; ++c)
+            Texels[i][c] = static_cast<Uint8>(Palette[Idx][c]);
+    }
+}
+
+void DecodeBC4Block(const Uint8* pBlock, Uint8 Texels[16][4], Uint32 Channel)
+{
+    const Uint32 A0 = pBlock[0];
+    const Uint32 A1 = pBlock[1];
+
+    Uint32 Palette[8] = {A0, A1};
+    if (A0 > A1)
+    {
+        for (Uint32 i = 2; i < 8; ++i)
+            Palette[i] = ((8 - i) * A0 + (i - 1) * A1 + 3) / 7;
+    }
+    else
+    {
+        for (Uint32 i = 2; i < 6; ++i)
+            Palette[i] = ((6 - i) * A0 + (i - 1) * A1 + 2) / 5;
+        Palette[6] = 0;
+        Palette[7] = 255;
+    }
+
+    Uint64 Bits = 0;
+    for (Uint32 b = 0; b < 6; ++b)
+        Bits |= Uint64{pBlock[2 + b]} << (b * 8);
+    for (Uint32 i = 0; i < 16; ++i)
+        Texels[i][Channel] = static_cast<Uint8>(Palette[(Bits >> (i * 3)) & 0x07u]);
+}
+
+void DecodeBC7Mode6Block(const Uint8* pBlock, Uint8 Texels[16][4])
+{
+    Uint32 Pos      = 0;
+    auto   ReadBits = [&](Uint32 NumBits) {
+        Uint32 Value = 0;
+        for (Uint32 b = 0; b < NumBits; ++b, ++Pos)
+            Value |= ((pBlock[Pos >> 3] >> (Pos & 0x07u)) & 0x01u) << b;
+        return Value;
+    };
+
+    ASSERT_EQ(ReadBits(7), 1u << 6u) << "Only mode 6 is expected";
+
+    Uint32 E[2][4];
+    for (Uint32 c = 0; c < 4; ++c)
+    {
+        E[0][c] = ReadBits(7);
+        E[1][c] = ReadBits(7);
+    }
+    const auto P0 = ReadBits(1);
+    const auto P1 = ReadBits(1);
+    for (Uint32 c = 0; c < 4; ++c)
+    {
+        E[0][c] = (E[0][c] << 1u) | P0;
+        E[1][c] = (E[1][c] << 1u) | P1;
+    }
+
+    static constexpr Uint32 Weights[] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+    for (Uint32 i = 0; i < 16; ++i)
+    {
+        const auto w = Weights[ReadBits(i == 0 ? 3 : 4)];
+        for (Uint32 c = 0; c < 4; ++c)
+            Texels[i][c] = static_cast<Uint8>(((64 - w) * E[0][c] + w * E[1][c] + 32) >> 6u);
+    }
+}
+
+std::vector<Uint8> DecodeImage(TEXTURE_FORMAT Format, Uint32 Width, Uint32 Height, const Uint8* pData, Uint32 Stride)
+{
+    const auto BlockSize = GetTextureFormatAttribs(Format).ComponentSize;
+
+    std::vector<Uint8> Image(size_t{Width} * Height * 4);
+    for (Uint32 by = 0; by < (Height + 3) / 4; ++by)
+    {
+        for (Uint32 bx = 0; bx < (Width + 3) / 4; ++bx)
+        {
+            const auto* pBlock = pData + size_t{by} * Stride + size_t{bx} * BlockSize;
+
+            Uint8 Texels[16][4] = {};
+            for (auto& Texel : Texels)
+                Texel[3] = 255;
+
+            switch (Format)
+            {
+                case TEX_FORMAT_BC1_UNORM:
+                    DecodeBC1ColorBlock(pBlock, Texels);
+                    break;
+
+                case TEX_FORMAT_BC3_UNORM:
+                    DecodeBC4Block(pBlock, Texels, 3);
+                    DecodeBC1ColorBlock(pBlock + 8, Texels);
+                    break;
+
+                case TEX_FORMAT_BC4_UNORM:
+                    DecodeBC4Block(pBlock, Texels, 0);
+                    break;
+
+                case TEX_FORMAT_BC5_UNORM:
+                    DecodeBC4Block(pBlock, Texels, 0);
+                    DecodeBC4Block(pBlock + 8, Texels, 1);
+                    break;
+
+                case TEX_FORMAT_BC7_UNORM:
+                    DecodeBC7Mode6Block(pBlock, Texels);
+                    break;
+
+                default:
+                    ADD_FAILURE() << "Unexpected format";
+            }
+
+            for (Uint32 i = 0; i < 16; ++i)
+            {
+                const auto x = bx * 4 + i % 4;
+                const auto y = by * 4 + i / 4;
+                if (x < Width && y < Height)
+                    std::copy(Texels[i], Texels[i] + 4, &Image[(size_t{y} * Width + x) * 4]);
+            }
+        }
+    }
+    return Image;
+}
+
+// Number of channels of the source image that the format encodes
+Uint32 GetNumEncodedChannels(TEXTURE_FORMAT Format)
+{
+    switch (Format)
+    {
+        case TEX_FORMAT_BC1_UNORM: return 3;
+        case TEX_FORMAT_BC4_UNORM: return 1;
+        case TEX_FORMAT_BC5_UNORM: return 2;
+        default: return 4;
+    }
+}
+
+double ComputePSNR(const std::vector<Uint8>& Ref, const std::vector<Uint8>& Img, Uint32 NumChannels)
+{
+    double SumSq   = 0;
+    size_t NumVals = 0;
+    for (size_t i = 0; i < Ref.size(); i += 4)
+    {
+        for (Uint32 c = 0; c < NumChannels; ++c)
+        {
+            const double Diff = static_cast<double>(Ref[i + c]) - static_cast<double>(Img[i + c]);
+            SumSq += Diff * Diff;
+            ++NumVals;
+        }
+    }
+    const double MSE = SumSq / static_cast<double>(NumVals);
+    return MSE > 0 ? 10.0 * std::log10(255.0 * 255.0 / MSE) : 100.0;
+}
+
+std::vector<Uint8> Compress(Uint32 Width, Uint32 Height, const std::vector<Uint8>& Image, const TextureCompressionAttribs& Attribs, Uint32& Stride)
+{
+    const auto& FmtAttribs = GetTextureFormatAttribs(Attribs.DstFormat);
+
+    Stride = (Width + 3) / 4 * FmtAttribs.ComponentSize;
+    std::vector<Uint8> Data(size_t{Stride} * ((Height + 3) / 4));
+    CompressTextureData(Width, Height, TEX_FORMAT_RGBA8_UNORM, Image.data(), Width * 4, Data.data(), Stride, Attribs);
+    return Data;
+}
+
+const TEXTURE_FORMAT TestFormats[] = {
+    TEX_FORMAT_BC1_UNORM,
+    TEX_FORMAT_BC3_UNORM,
+    TEX_FORMAT_BC4_UNORM,
+    TEX_FORMAT_BC5_UNORM,
+    TEX_FORMAT_BC7_UNORM //
+};
+
+const TEXTURE_COMPRESSION_QUALITY TestQualities[] = {
+    TEXTURE_COMPRESSION_QUALITY_FAST,
+    TEXTURE_COMPRESSION_QUALITY_NORMAL,
+    TEXTURE_COMPRESSION_QUALITY_HIGH //
+};
+
+const char* GetQualityName(TEXTURE_COMPRESSION_QUALITY Quality)
+{
+    switch (Quality)
+    {
+        case TEXTURE_COMPRESSION_QUALITY_FAST: return "fast";
+        case TEXTURE_COMPRESSION_QUALITY_NORMAL: return "normal";
+        case TEXTURE_COMPRESSION_QUALITY_HIGH: return "high";
+        default: return "unknown";
+    }
+}
+
+TEST(GraphicsTools_TextureCompression, IsSupported)
+{
+    for (auto Fmt : TestFormats)
+        EXPECT_TRUE(IsTextureCompressionSupported(Fmt));
+    EXPECT_TRUE(IsTextureCompressionSupported(TEX_FORMAT_BC7_UNORM_SRGB));
+    EXPECT_FALSE(IsTextureCompressionSupported(TEX_FORMAT_RGBA8_UNORM));
+    EXPECT_FALSE(IsTextureCompressionSupported(TEX_FORMAT_BC6H_UF16));
+}
+
+TEST(GraphicsTools_TextureCompression, SolidColor)
+{
+    constexpr Uint32 Width  = 8;
+    constexpr Uint32 Height = 8;
+
+    FastRandInt rnd{0, 0, 255};
+    for (Uint32 i = 0; i < 64; ++i)
+    {
+        const Uint8 Color[4] = {
+            static_cast<Uint8>(rnd()),
+            static_cast<Uint8>(rnd()),
+            static_cast<Uint8>(rnd()),
+            static_cast<Uint8>(rnd()) //
+        };
+
+        std::vector<Uint8> Image(Width * Height * 4);
+        for (size_t t = 0; t < Image.size(); ++t)
+            Image[t] = Color[t % 4];
+
+        for (auto Fmt : TestFormats)
+        {
+            TextureCompressionAttribs Attribs;
+            Attribs.DstFormat = Fmt;
+
+            Uint32     Stride  = 0;
+            const auto Data    = Compress(Width, Height, Image, Attribs, Stride);
+            const auto Decoded = DecodeImage(Fmt, Width, Height, Data.data(), Stride);
+
+            // BC1 reproduces solid colors through interpolation, BC7 endpoints have 7 bits plus a shared p-bit
+            const int MaxError = (Fmt == TEX_FORMAT_BC4_UNORM || Fmt == TEX_FORMAT_BC5_UNORM) ? 0 : (Fmt == TEX_FORMAT_BC7_UNORM ? 1 : 2);
+            for (size_t t = 0; t < Image.size(); ++t)
+            {
+                if (t % 4 < GetNumEncodedChannels(Fmt))
+                {
+                    ASSERT_LE(std::abs(int{Decoded[t]} - int{Image[t]}), MaxError)
+                        << GetTextureFormatAttribs(Fmt).Name << ": color " << int{Color[0]} << ", " << int{Color[1]} << ", " << int{Color[2]} << ", " << int{Color[3]};
+                }
+            }
+        }
+    }
+}
+
+TEST(GraphicsTools_TextureCompression, Quality)
+{
+    constexpr Uint32 Width  = 256;
+    constexpr Uint32 Height = 256;
+
+    const auto Image = GenerateTestImage(Width, Height);
+
+    for (auto Fmt : TestFormats)
+    {
+        double FastPSNR = 0;
+        for (auto Quality : TestQualities)
+        {
+            TextureCompressionAttribs Attribs;
+            Attribs.DstFormat = Fmt;
+            Attribs.Quality   = Quality;
+
+            Uint32     Stride  = 0;
+            const auto Data    = Compress(Width, Height, Image, Attribs, Stride);
+            const auto Decoded = DecodeImage(Fmt, Width, Height, Data.data(), Stride);
+            const auto PSNR    = ComputePSNR(Image, Decoded, GetNumEncodedChannels(Fmt));
+
+            LOG_INFO_MESSAGE(GetTextureFormatAttribs(Fmt).Name, " (", GetQualityName(Quality), "): PSNR = ", PSNR, " dB");
+
+            // clang-format off
+            const double MinPSNR =
+                Fmt == TEX_FORMAT_BC1_UNORM ? 32.0 :
+                Fmt == TEX_FORMAT_BC3_UNORM ? 33.0 :
+                Fmt == TEX_FORMAT_BC7_UNORM ? 37.0 :
+                                              40.0;
+            // clang-format on
+            EXPECT_GT(PSNR, MinPSNR) << GetTextureFormatAttribs(Fmt).Name << " (" << GetQualityName(Quality) << ")";
+
+            if (Quality == TEXTURE_COMPRESSION_QUALITY_FAST)
+                FastPSNR = PSNR;
+            else
+                EXPECT_GE(PSNR, FastPSNR - 0.01);
+        }
+    }
+}
+
+TEST(GraphicsTools_TextureCompression, PartialBlocks)
+{
+    constexpr Uint32 Width  = 13;
+    constexpr Uint32 Height = 7;
+
+    const auto Image = GenerateTestImage(Width, Height);
+    for (auto Fmt : TestFormats)
+    {
+        TextureCompressionAttribs Attribs;
+        Attribs.DstFormat = Fmt;
+
+        Uint32     Stride  = 0;
+        const auto Data    = Compress(Width, Height, Image, Attribs, Stride);
+        const auto Decoded = DecodeImage(Fmt, Width, Height, Data.data(), Stride);
+        EXPECT_GT(ComputePSNR(Image, Decoded, GetNumEncodedChannels(Fmt)), 30.0) << GetTextureFormatAttribs(Fmt).Name;
+    }
+}
+
+TEST(GraphicsTools_TextureCompression, Decompression)
+{
+    constexpr Uint32 Width  = 64;
+    constexpr Uint32 Height = 40;
+
+    // The library decoder must match the reference decoders up to rounding
+    const auto Image = GenerateTestImage(Width, Height);
+    for (auto Fmt : TestFormats)
+    {
+        TextureCompressionAttribs Attribs;
+        Attribs.DstFormat = Fmt;
+        Attribs.Quality   = TEXTURE_COMPRESSION_QUALITY_HIGH;
+
+        Uint32     Stride = 0;
+        const auto Data   = Compress(Width, Height, Image, Attribs, Stride);
+        const auto Ref    = DecodeImage(Fmt, Width, Height, Data.data(), Stride);
+
+        std::vector<Uint8> Decoded(Ref.size());
+        EXPECT_TRUE(ConvertTextureData(Width, Height, Fmt, Data.data(), Stride, TEX_FORMAT_RGBA8_UNORM, Decoded.data(), Width * 4));
+
+        int MaxDiff = 0;
+        for (size_t i = 0; i < Ref.size(); ++i)
+            MaxDiff = std::max(MaxDiff, std::abs(static_cast<int>(Ref[i]) - static_cast<int>(Decoded[i])));
+        EXPECT_LE(MaxDiff, 1) << GetTextureFormatAttribs(Fmt).Name;
+    }
+}
+
+TEST(GraphicsTools_TextureCompression, ThreadPool)
+{
+    constexpr Uint32 Width  = 128;
+    constexpr Uint32 Height = 96;
+
+    const auto Image = GenerateTestImage(Width, Height);
+
+    ThreadPool Pool{4};
+    for (auto Fmt : TestFormats)
+    {
+        TextureCompressionAttribs Attribs;
+        Attribs.DstFormat = Fmt;
+
+        Uint32     Stride = 0;
+        const auto Ref    = Compress(Width, Height, Image, Attribs, Stride);
+
+        Attribs.pThreadPool = &Pool;
+        const auto Data     = Compress(Width, Height, Image, Attribs, Stride);
+        EXPECT_EQ(Ref, Data) << GetTextureFormatAttribs(Fmt).Name;
+    }
+}
+
+TEST(GraphicsTools_TextureCompression, MipChain)
+{
+    constexpr Uint32 Width  = 100;
+    constexpr Uint32 Height = 36;
+
+    const auto Image = GenerateTestImage(Width, Height);
+
+    TextureCompressionAttribs Attribs;
+    Attribs.DstFormat = TEX_FORMAT_BC7_UNORM;
+
+    std::vector<CompressedMipLevel> MipLevels;
+    CompressMipChain(Width, Height, TEX_FORMAT_RGBA8_UNORM, Image.data(), Width * 4, 0, Attribs, MipLevels);
+    ASSERT_EQ(MipLevels.size(), ComputeMipLevelsCount(Width, Height));
+
+    TextureDesc TexDesc;
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width     = Width;
+    TexDesc.Height    = Height;
+    TexDesc.Format    = Attribs.DstFormat;
+    TexDesc.MipLevels = static_cast<Uint32>(MipLevels.size());
+    for (Uint32 Mip = 0; Mip < MipLevels.size(); ++Mip)
+    {
+        const auto  MipProps = GetMipLevelProperties(TexDesc, Mip);
+        const auto& Level    = MipLevels[Mip];
+        EXPECT_EQ(Level.Width, MipProps.LogicalWidth);
+        EXPECT_EQ(Level.Height, MipProps.LogicalHeight);
+        EXPECT_EQ(Level.Stride, MipProps.RowSize);
+        EXPECT_EQ(Level.Data.size(), MipProps.MipSize);
+    }
+
+    // The top level must match direct compression
+    Uint32 Stride = 0;
+    EXPECT_EQ(Compress(Width, Height, Image, Attribs, Stride), MipLevels[0].Data);
+
+    CompressMipChain(Width, Height, TEX_FORMAT_RGBA8_UNORM, Image.data(), Width * 4, 3, Attribs, MipLevels);
+    EXPECT_EQ(MipLevels.size(), 3u);
+}
+
+TEST(GraphicsTools_TextureCompression, DISABLED_Performance)
+{
+    constexpr Uint32 Width  = 512;
+    constexpr Uint32 Height = 512;
+
+    const auto Image = GenerateTestImage(Width, Height);
+
+    ThreadPool Pool;
+    for (auto Fmt : TestFormats)
+    {
+        for (auto Quality : TestQualities)
+        {
+            TextureCompressionAttribs Attribs;
+            Attribs.DstFormat = Fmt;
+            Attribs.Quality   = Quality;
+
+            Uint32 Stride = 0;
+
+            Timer      T;
+            const auto Data       = Compress(Width, Height, Image, Attribs, Stride);
+            const auto SingleTime = T.GetElapsedTime();
+
+            Attribs.pThreadPool = &Pool;
+            T.Restart();
+            Compress(Width, Height, Image, Attribs, Stride);
+            const auto PoolTime = T.GetElapsedTime();
+
+            const auto Decoded = DecodeImage(Fmt, Width, Height, Data.data(), Stride);
+            const auto MPix    = static_cast<double>(Width * Height) / 1e6;
+            LOG_INFO_MESSAGE(GetTextureFormatAttribs(Fmt).Name, " (", GetQualityName(Quality), "): ",
+                             MPix / SingleTime, " MPix/s, ", MPix / PoolTime, " MPix/s with ", Pool.GetNumThreads(), " threads; PSNR = ",
+                             ComputePSNR(Image, Decoded, GetNumEncodedChannels(Fmt)), " dB");
+        }
+    }
+}
+
+} // namespace
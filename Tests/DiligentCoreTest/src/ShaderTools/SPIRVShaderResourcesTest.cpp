@@ -0,0 +1,313 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#include "SPIRVShaderResources.hpp"
+#include "GLSLangUtils.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+class SPIRVShaderResourcesTest : public ::testing::Test
+{
+protected:
+    static void SetUpTestCase()
+    {
+        GLSLangUtils::InitializeGlslang();
+    }
+
+    static void TearDownTestCase()
+    {
+        GLSLangUtils::FinalizeGlslang();
+    }
+};
+
+// Layout of the serialized blob (see SPIRVShaderResources.cpp)
+constexpr size_t SerializedHeaderSize         = 52;
+constexpr size_t SerializedResourceAttribSize = 28;
+constexpr size_t SerializedResourceTypeOffset = 6;
+constexpr size_t SerializedSepSmplrOrImgInd   = 8;
+
+const char* TestGLSL = R"(
+#version 450
+
+layout(std140, binding = 0) uniform CBuffer
+{
+    vec4 g_Color;
+};
+
+layout(std430, binding = 1) readonly buffer ROBuffer
+{
+    vec4 g_RO[];
+};
+
+layout(std430, binding = 2) buffer RWBuffer
+{
+    vec4 g_RW[];
+};
+
+layout(rgba8, binding = 3) uniform image2D g_RWTex;
+layout(binding = 4) uniform sampler2D       g_SampledTex[2];
+layout(binding = 5) uniform texture2D       g_Tex;
+layout(binding = 6) uniform sampler         g_Tex_sampler;
+layout(binding = 7) uniform texture2DMS     g_TexMS;
+layout(binding = 8) uniform textureBuffer   g_TexelBuff;
+
+layout(location = 0) in vec4  in_Color;
+layout(location = 0) out vec4 out_Color;
+
+void main()
+{
+    out_Color = g_Color + g_RO[0] + imageLoad(g_RWTex, ivec2(0, 0));
+    out_Color += texture(g_SampledTex[0], in_Color.xy) + texture(g_SampledTex[1], in_Color.xy);
+    out_Color += texture(sampler2D(g_Tex, g_Tex_sampler), in_Color.xy);
+    out_Color += texelFetch(g_TexMS, ivec2(0, 0), 0) + texelFetch(g_TexelBuff, 0);
+    g_RW[0] = out_Color;
+}
+)";
+
+const char* TestHLSL = R"(
+struct VSInput
+{
+    float4 Pos   : ATTRIB0;
+    float2 UV    : ATTRIB1;
+    float4 Color : ATTRIB3;
+};
+
+cbuffer Constants
+{
+    float4x4 g_WorldViewProj;
+};
+
+float4 main(in VSInput VSIn) : SV_Position
+{
+    return mul(VSIn.Pos, g_WorldViewProj) + float4(VSIn.UV, 0.0, 0.0) + VSIn.Color;
+}
+)";
+
+void CompareResources(const SPIRVShaderResources& Ref, const SPIRVShaderResources& Res)
+{
+    EXPECT_EQ(Ref.GetShaderType(), Res.GetShaderType());
+    EXPECT_STREQ(Ref.GetShaderName(), Res.GetShaderName());
+    EXPECT_EQ(Ref.IsHLSLSource(), Res.IsHLSLSource());
+    if (Ref.GetCombinedSamplerSuffix() != nullptr)
+    {
+        ASSERT_NE(Res.GetCombinedSamplerSuffix(), nullptr);
+        EXPECT_STREQ(Ref.GetCombinedSamplerSuffix(), Res.GetCombinedSamplerSuffix());
+    }
+    else
+    {
+        EXPECT_EQ(Res.GetCombinedSamplerSuffix(), nullptr);
+    }
+
+    EXPECT_EQ(Ref.GetNumUBs(), Res.GetNumUBs());
+    EXPECT_EQ(Ref.GetNumSBs(), Res.GetNumSBs());
+    EXPECT_EQ(Ref.GetNumImgs(), Res.GetNumImgs());
+    EXPECT_EQ(Ref.GetNumSmpldImgs(), Res.GetNumSmpldImgs());
+    EXPECT_EQ(Ref.GetNumACs(), Res.GetNumACs());
+    EXPECT_EQ(Ref.GetNumSepSmplrs(), Res.GetNumSepSmplrs());
+    EXPECT_EQ(Ref.GetNumSepImgs(), Res.GetNumSepImgs());
+    EXPECT_EQ(Ref.GetNumInptAtts(), Res.GetNumInptAtts());
+    EXPECT_EQ(Ref.GetNumAccelStructs(), Res.GetNumAccelStructs());
+    ASSERT_EQ(Ref.GetTotalResources(), Res.GetTotalResources());
+
+    for (Uint32 n = 0; n < Ref.GetTotalResources(); ++n)
+    {
+        const auto& RefAttribs = Ref.GetResource(n);
+        const auto& Attribs    = Res.GetResource(n);
+        EXPECT_STREQ(RefAttribs.Name, Attribs.Name) << n;
+        EXPECT_EQ(RefAttribs.ArraySize, Attribs.ArraySize) << RefAttribs.Name;
+        EXPECT_EQ(RefAttribs.Type, Attribs.Type) << RefAttribs.Name;
+        EXPECT_EQ(RefAttribs.GetResourceDimension(), Attribs.GetResourceDimension()) << RefAttribs.Name;
+        EXPECT_EQ(RefAttribs.IsMultisample(), Attribs.IsMultisample()) << RefAttribs.Name;
+        EXPECT_EQ(RefAttribs.BindingDecorationOffset, Attribs.BindingDecorationOffset) << RefAttribs.Name;
+        EXPECT_EQ(RefAttribs.DescriptorSetDecorationOffset, Attribs.DescriptorSetDecorationOffset) << RefAttribs.Name;
+        EXPECT_EQ(RefAttribs.BufferStaticSize, Attribs.BufferStaticSize) << RefAttribs.Name;
+        EXPECT_EQ(RefAttribs.BufferStride, Attribs.BufferStride) << RefAttribs.Name;
+        if (RefAttribs.Type == SPIRVShaderResourceAttribs::ResourceType::SeparateImage)
+        {
+            EXPECT_EQ(RefAttribs.GetAssignedSepSamplerInd(), Attribs.GetAssignedSepSamplerInd()) << RefAttribs.Name;
+        }
+        else if (RefAttribs.Type == SPIRVShaderResourceAttribs::ResourceType::SeparateSampler)
+        {
+            EXPECT_EQ(RefAttribs.GetAssignedSepImageInd(), Attribs.GetAssignedSepImageInd()) << RefAttribs.Name;
+        }
+        EXPECT_TRUE(RefAttribs.IsCompatibleWith(Attribs)) << RefAttribs.Name;
+    }
+
+    ASSERT_EQ(Ref.GetNumShaderStageInputs(), Res.GetNumShaderStageInputs());
+    for (Uint32 n = 0; n < Ref.GetNumShaderStageInputs(); ++n)
+    {
+        const auto& RefInput = Ref.GetShaderStageInputAttribs(n);
+        const auto& Input    = Res.GetShaderStageInputAttribs(n);
+        EXPECT_STREQ(RefInput.Semantic, Input.Semantic) << n;
+        EXPECT_EQ(RefInput.LocationDecorationOffset, Input.LocationDecorationOffset) << RefInput.Semantic;
+    }
+
+    EXPECT_TRUE(Ref.IsCompatibleWith(Res));
+}
+
+std::unique_ptr<SPIRVShaderResources> LoadResources(const std::vector<Uint8>& Data, std::string& EntryPoint)
+{
+    return std::unique_ptr<SPIRVShaderResources>{
+        new SPIRVShaderResources{DefaultRawMemoryAllocator::GetAllocator(), Data.data(), Data.size(), EntryPoint}};
+}
+
+TEST_F(SPIRVShaderResourcesTest, SerializeGLSL)
+{
+    auto SPIRV = GLSLangUtils::GLSLtoSPIRV(SHADER_TYPE_PIXEL, TestGLSL, static_cast<int>(strlen(TestGLSL)), nullptr, nullptr, GLSLangUtils::SpirvVersion::Vk100, nullptr);
+    ASSERT_FALSE(SPIRV.empty());
+
+    ShaderDesc Desc;
+    Desc.Name       = "SPIRVShaderResourcesTest.SerializeGLSL";
+    Desc.ShaderType = SHADER_TYPE_PIXEL;
+
+    std::string                EntryPoint;
+    const SPIRVShaderResources Ref{DefaultRawMemoryAllocator::GetAllocator(), nullptr, SPIRV, Desc, "_sampler", false, EntryPoint};
+    EXPECT_EQ(Ref.GetNumUBs(), 1u);
+    EXPECT_EQ(Ref.GetNumSBs(), 2u);
+    EXPECT_EQ(Ref.GetNumImgs(), 1u);
+    EXPECT_EQ(Ref.GetNumSmpldImgs(), 1u);
+    EXPECT_EQ(Ref.GetNumSepSmplrs(), 1u);
+    EXPECT_EQ(Ref.GetNumSepImgs(), 3u);
+
+    RefCntAutoPtr<IDataBlob> pBlob;
+    Ref.Serialize(EntryPoint.c_str(), &pBlob);
+    ASSERT_TRUE(pBlob);
+
+    const auto*              pBlobData = static_cast<const Uint8*>(pBlob->GetConstDataPtr());
+    const std::vector<Uint8> Data{pBlobData, pBlobData + pBlob->GetSize()};
+
+    std::string LoadedEntryPoint;
+    auto        pLoaded = LoadResources(Data, LoadedEntryPoint);
+    EXPECT_EQ(EntryPoint, LoadedEntryPoint);
+    CompareResources(Ref, *pLoaded);
+
+    // Serializing the loaded resources must produce the same blob
+    RefCntAutoPtr<IDataBlob> pBlob2;
+    pLoaded->Serialize(LoadedEntryPoint.c_str(), &pBlob2);
+    ASSERT_TRUE(pBlob2);
+    ASSERT_EQ(pBlob2->GetSize(), pBlob->GetSize());
+    EXPECT_EQ(memcmp(pBlob2->GetConstDataPtr(), pBlob->GetConstDataPtr(), pBlob->GetSize()), 0);
+}
+
+TEST_F(SPIRVShaderResourcesTest, SerializeHLSLStageInputs)
+{
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.Source          = TestHLSL;
+    ShaderCI.EntryPoint      = "main";
+    ShaderCI.SourceLanguage  = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.Desc.Name       = "SPIRVShaderResourcesTest.SerializeHLSLStageInputs";
+    ShaderCI.Desc.ShaderType = SHADER_TYPE_VERTEX;
+
+    auto SPIRV = GLSLangUtils::HLSLtoSPIRV(ShaderCI, nullptr, nullptr);
+    ASSERT_FALSE(SPIRV.empty());
+
+    std::string                EntryPoint;
+    const SPIRVShaderResources Ref{DefaultRawMemoryAllocator::GetAllocator(), nullptr, SPIRV, ShaderCI.Desc, nullptr, true, EntryPoint};
+    EXPECT_TRUE(Ref.IsHLSLSource());
+    EXPECT_EQ(Ref.GetNumShaderStageInputs(), 3u);
+
+    RefCntAutoPtr<IDataBlob> pBlob;
+    Ref.Serialize(EntryPoint.c_str(), &pBlob);
+    ASSERT_TRUE(pBlob);
+
+    const auto*              pBlobData = static_cast<const Uint8*>(pBlob->GetConstDataPtr());
+    const std::vector<Uint8> Data{pBlobData, pBlobData + pBlob->GetSize()};
+
+    std::string LoadedEntryPoint;
+    auto        pLoaded = LoadResources(Data, LoadedEntryPoint);
+    EXPECT_EQ(EntryPoint, LoadedEntryPoint);
+    CompareResources(Ref, *pLoaded);
+}
+
+TEST_F(SPIRVShaderResourcesTest, InvalidData)
+{
+    auto SPIRV = GLSLangUtils::GLSLtoSPIRV(SHADER_TYPE_PIXEL, TestGLSL, static_cast<int>(strlen(TestGLSL)), nullptr, nullptr, GLSLangUtils::SpirvVersion::Vk100, nullptr);
+    ASSERT_FALSE(SPIRV.empty());
+
+    ShaderDesc Desc;
+    Desc.Name       = "SPIRVShaderResourcesTest.InvalidData";
+    Desc.ShaderType = SHADER_TYPE_PIXEL;
+
+    std::string                EntryPoint;
+    const SPIRVShaderResources Ref{DefaultRawMemoryAllocator::GetAllocator(), nullptr, SPIRV, Desc, "_sampler", false, EntryPoint};
+
+    RefCntAutoPtr<IDataBlob> pBlob;
+    Ref.Serialize(EntryPoint.c_str(), &pBlob);
+    ASSERT_TRUE(pBlob);
+
+    const auto*              pBlobData = static_cast<const Uint8*>(pBlob->GetConstDataPtr());
+    const std::vector<Uint8> Data{pBlobData, pBlobData + pBlob->GetSize()};
+
+    // Separate image that has a sampler assigned
+    Uint32 SepImgInd = ~0u;
+    for (Uint32 n = 0; n < Ref.GetTotalResources(); ++n)
+    {
+        const auto& Res = Ref.GetResource(n);
+        if (Res.Type == SPIRVShaderResourceAttribs::ResourceType::SeparateImage && Res.IsValidSepSamplerAssigned())
+            SepImgInd = n;
+    }
+    ASSERT_NE(SepImgInd, ~0u);
+    const size_t SepImgOffset = SerializedHeaderSize + SepImgInd * SerializedResourceAttribSize;
+
+    std::string LoadedEntryPoint;
+    {
+        auto Truncated = Data;
+        Truncated.pop_back();
+        EXPECT_THROW(LoadResources(Truncated, LoadedEntryPoint), std::runtime_error);
+    }
+    {
+        auto         BadSamplerInd = Data;
+        const Uint32 SamplerInd    = Ref.GetNumSepSmplrs();
+        memcpy(&BadSamplerInd[SepImgOffset + SerializedSepSmplrOrImgInd], &SamplerInd, sizeof(SamplerInd));
+        EXPECT_THROW(LoadResources(BadSamplerInd, LoadedEntryPoint), std::runtime_error);
+    }
+    {
+        // Uniform buffer in the separate image group
+        auto BadType = Data;
+        BadType[SepImgOffset + SerializedResourceTypeOffset] = SPIRVShaderResourceAttribs::ResourceType::UniformBuffer;
+        EXPECT_THROW(LoadResources(BadType, LoadedEntryPoint), std::runtime_error);
+    }
+    {
+        auto         BadName    = Data;
+        const Uint32 NameOffset = static_cast<Uint32>(Data.size());
+        memcpy(&BadName[SepImgOffset], &NameOffset, sizeof(NameOffset));
+        EXPECT_THROW(LoadResources(BadName, LoadedEntryPoint), std::runtime_error);
+    }
+}
+
+} // namespace
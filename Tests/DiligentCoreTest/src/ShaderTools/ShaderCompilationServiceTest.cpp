@@ -0,0 +1,299 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#include "ShaderCompilationService.hpp"
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include <mutex>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+const char* const TestGLSLSource = R"(
+void main()
+{
+    gl_Position = vec4(float(A), float(B), 0.0, 1.0);
+}
+)";
+
+TEST(ShaderTools_ShaderCompilationService, GLSLTarget)
+{
+    if (!ShaderCompilationService::IsTargetSupported(ShaderCompilationTarget::GLSL))
+        GTEST_SKIP() << "GLSL target is not supported in this build";
+
+    std::mutex                           ResultsMtx;
+    std::vector<ShaderCompilationResult> Results;
+
+    ShaderCompilationServiceCreateInfo ServiceCI;
+    ServiceCI.NumThreads     = 4;
+    ServiceCI.ResultCallback = [&](const ShaderCompilationResult& Result) {
+        std::lock_guard<std::mutex> Lock{ResultsMtx};
+        if (Result.JobId >= Results.size())
+            Results.resize(Result.JobId + 1);
+        Results[Result.JobId] = Result;
+    };
+
+    constexpr Uint32 NumPermutations = 8;
+    constexpr Uint32 NumRepetitions  = 25;
+
+    ShaderCompilationService Service{ServiceCI};
+
+    std::vector<std::string> ExpectedDefines;
+    for (Uint32 r = 0; r < NumRepetitions; ++r)
+    {
+        for (Uint32 p = 0; p < NumPermutations; ++p)
+        {
+            const auto A = std::to_string(p % 4);
+            const auto B = std::to_string(p / 4);
+
+            // Macro order must not affect deduplication
+            const ShaderMacro Macros[]         = {{"A", A.c_str()}, {"B", B.c_str()}, {nullptr, nullptr}};
+            const ShaderMacro ReversedMacros[] = {{"B", B.c_str()}, {"A", A.c_str()}, {nullptr, nullptr}};
+
+            ShaderCompilationJob Job;
+            Job.Target                   = ShaderCompilationTarget::GLSL;
+            Job.ShaderCI.Desc.Name       = "Test VS";
+            Job.ShaderCI.Desc.ShaderType = SHADER_TYPE_VERTEX;
+            Job.ShaderCI.SourceLanguage  = SHADER_SOURCE_LANGUAGE_GLSL;
+            Job.ShaderCI.Source          = TestGLSLSource;
+            Job.ShaderCI.Macros          = (r & 0x01) ? ReversedMacros : Macros;
+
+            const auto JobId = Service.SubmitJob(Job);
+            EXPECT_EQ(JobId, static_cast<Uint32>(ExpectedDefines.size()));
+            ExpectedDefines.emplace_back("#define A " + A + "\n#define B " + B + "\n");
+        }
+    }
+
+    Service.WaitForCompletion();
+
+    const auto Stats = Service.GetStats();
+    EXPECT_EQ(Stats.NumJobs, NumPermutations * NumRepetitions);
+    EXPECT_EQ(Stats.NumUniqueJobs, NumPermutations);
+    EXPECT_EQ(Stats.NumCompletedJobs, NumPermutations * NumRepetitions);
+    EXPECT_EQ(Stats.NumFailedJobs, 0u);
+    EXPECT_EQ(Stats.GetProgress(), 1.f);
+
+    ASSERT_EQ(Results.size(), ExpectedDefines.size());
+    Uint32 NumDuplicates = 0;
+    for (size_t i = 0; i < Results.size(); ++i)
+    {
+        const auto& Result = Results[i];
+        EXPECT_EQ(Result.JobId, i);
+        ASSERT_TRUE(Result.Succeeded);
+        ASSERT_TRUE(Result.pByteCode);
+
+        const std::string GLSL = static_cast<const char*>(Result.pByteCode->GetConstDataPtr());
+        EXPECT_NE(GLSL.find(ExpectedDefines[i]), std::string::npos);
+        EXPECT_NE(GLSL.find("gl_Position"), std::string::npos);
+
+        if (Result.IsDuplicate)
+        {
+            ++NumDuplicates;
+            // Duplicates share the result of the original job
+            EXPECT_EQ(Result.pByteCode, Results[i % NumPermutations].pByteCode);
+        }
+    }
+    EXPECT_EQ(NumDuplicates, NumPermutations * (NumRepetitions - 1));
+
+    // Job identical to a completed one is delivered immediately
+    {
+        const ShaderMacro Macros[] = {{"A", "0"}, {"B", "0"}, {nullptr, nullptr}};
+
+        ShaderCompilationJob Job;
+        Job.Target                   = ShaderCompilationTarget::GLSL;
+        Job.ShaderCI.Desc.ShaderType = SHADER_TYPE_VERTEX;
+        Job.ShaderCI.SourceLanguage  = SHADER_SOURCE_LANGUAGE_GLSL;
+        Job.ShaderCI.Source          = TestGLSLSource;
+        Job.ShaderCI.Macros          = Macros;
+
+        auto JobId = Service.SubmitJob(Job);
+        ASSERT_EQ(Results.size(), JobId + 1);
+        EXPECT_TRUE(Results[JobId].IsDuplicate);
+        EXPECT_EQ(Results[JobId].pByteCode, Results[0].pByteCode);
+
+        // Once the completed jobs are released, the job is compiled again
+        Service.ReleaseCompletedJobs();
+        JobId = Service.SubmitJob(Job);
+        Service.WaitForCompletion();
+        ASSERT_EQ(Results.size(), JobId + 1);
+        EXPECT_FALSE(Results[JobId].IsDuplicate);
+        ASSERT_TRUE(Results[JobId].Succeeded);
+        EXPECT_NE(Results[JobId].pByteCode, Results[0].pByteCode);
+        EXPECT_EQ(Service.GetStats().NumUniqueJobs, NumPermutations + 1);
+
+        // Completed job must not be matched with a job whose source only has the same length
+        std::string OtherSource{TestGLSLSource};
+        OtherSource.replace(OtherSource.find("0.0, 1.0"), 8, "1.0, 1.0");
+        Job.ShaderCI.Source = OtherSource.c_str();
+
+        JobId = Service.SubmitJob(Job);
+        Service.WaitForCompletion();
+        ASSERT_EQ(Results.size(), JobId + 1);
+        EXPECT_FALSE(Results[JobId].IsDuplicate);
+        ASSERT_TRUE(Results[JobId].Succeeded);
+        const std::string GLSL = static_cast<const char*>(Results[JobId].pByteCode->GetConstDataPtr());
+        EXPECT_NE(GLSL.find("1.0, 1.0"), std::string::npos);
+        EXPECT_EQ(Service.GetStats().NumUniqueJobs, NumPermutations + 2);
+    }
+}
+
+TEST(ShaderTools_ShaderCompilationService, AssembledGLSLSource)
+{
+    if (!ShaderCompilationService::IsTargetSupported(ShaderCompilationTarget::GLSL))
+        GTEST_SKIP() << "GLSL target is not supported in this build";
+
+    std::vector<ShaderCompilationResult> Results;
+
+    ShaderCompilationServiceCreateInfo ServiceCI;
+    // Use a single thread so that all jobs go through the same source assembler
+    ServiceCI.NumThreads     = 1;
+    ServiceCI.ResultCallback = [&](const ShaderCompilationResult& Result) {
+        if (Result.JobId >= Results.size())
+            Results.resize(Result.JobId + 1);
+        Results[Result.JobId] = Result;
+    };
+
+    ShaderCompilationService Service{ServiceCI};
+
+    const ShaderMacro Macros0[] = {{"A", "1"}, {"B", "2"}, {nullptr, nullptr}};
+    const ShaderMacro Macros1[] = {{"A", "3"}, {nullptr, nullptr}};
+
+    // Macros are sorted by the service
+    const ShaderMacro* MacroLists[]   = {nullptr, Macros0, Macros1};
+    const char*        MacroStrings[] = {"", "#define A 1\n#define B 2\n", "#define A 3\n"};
+
+    const SHADER_TYPE ShaderTypes[] = {SHADER_TYPE_VERTEX, SHADER_TYPE_PIXEL, SHADER_TYPE_VERTEX};
+    for (auto ShaderType : ShaderTypes)
+    {
+        for (auto* Macros : MacroLists)
+        {
+            ShaderCompilationJob Job;
+            Job.Target                   = ShaderCompilationTarget::GLSL;
+            Job.ShaderCI.Desc.ShaderType = ShaderType;
+            Job.ShaderCI.SourceLanguage  = SHADER_SOURCE_LANGUAGE_GLSL;
+            Job.ShaderCI.Source          = TestGLSLSource;
+            Job.ShaderCI.Macros          = Macros;
+            Service.SubmitJob(Job);
+        }
+    }
+    Service.WaitForCompletion();
+
+    // Every source must consist of the prefix of the shader type, the permutation macros and the source code
+    const size_t NumMacroLists = _countof(MacroLists);
+    ASSERT_EQ(Results.size(), _countof(ShaderTypes) * NumMacroLists);
+
+    std::string Prefixes[_countof(ShaderTypes)];
+    for (size_t t = 0; t < _countof(ShaderTypes); ++t)
+    {
+        for (size_t m = 0; m < NumMacroLists; ++m)
+        {
+            const auto& Result = Results[t * NumMacroLists + m];
+            ASSERT_TRUE(Result.Succeeded);
+            const std::string GLSL = static_cast<const char*>(Result.pByteCode->GetConstDataPtr());
+            if (m == 0)
+            {
+                ASSERT_GT(GLSL.length(), strlen(TestGLSLSource));
+                Prefixes[t] = GLSL.substr(0, GLSL.length() - strlen(TestGLSLSource));
+            }
+            EXPECT_EQ(GLSL, Prefixes[t] + MacroStrings[m] + TestGLSLSource) << t << ", " << m;
+        }
+    }
+    EXPECT_NE(Prefixes[0], Prefixes[1]);
+    EXPECT_EQ(Prefixes[0], Prefixes[2]);
+}
+
+TEST(ShaderTools_ShaderCompilationService, GLSLVerbatim)
+{
+    if (!ShaderCompilationService::IsTargetSupported(ShaderCompilationTarget::GLSL))
+        GTEST_SKIP() << "GLSL target is not supported in this build";
+
+    const char* const Source = "#version 430 core\nvoid main(){}\n";
+
+    ShaderCompilationResult Result;
+
+    ShaderCompilationServiceCreateInfo ServiceCI;
+    ServiceCI.NumThreads     = 1;
+    ServiceCI.ResultCallback = [&](const ShaderCompilationResult& Res) {
+        Result = Res;
+    };
+
+    ShaderCompilationService Service{ServiceCI};
+
+    ShaderCompilationJob Job;
+    Job.Target                   = ShaderCompilationTarget::GLSL;
+    Job.ShaderCI.Desc.ShaderType = SHADER_TYPE_VERTEX;
+    Job.ShaderCI.SourceLanguage  = SHADER_SOURCE_LANGUAGE_GLSL_VERBATIM;
+    Job.ShaderCI.Source          = Source;
+    Service.SubmitJob(Job);
+    Service.WaitForCompletion();
+
+    ASSERT_TRUE(Result.Succeeded);
+    ASSERT_TRUE(Result.pByteCode);
+    EXPECT_STREQ(static_cast<const char*>(Result.pByteCode->GetConstDataPtr()), Source);
+}
+
+TEST(ShaderTools_ShaderCompilationService, Failure)
+{
+    if (!ShaderCompilationService::IsTargetSupported(ShaderCompilationTarget::GLSL))
+        GTEST_SKIP() << "GLSL target is not supported in this build";
+
+    Uint32      NumFailed = 0;
+    std::string CompilerOutput;
+
+    ShaderCompilationServiceCreateInfo ServiceCI;
+    ServiceCI.NumThreads     = 2;
+    ServiceCI.ResultCallback = [&](const ShaderCompilationResult& Result) {
+        if (!Result.Succeeded)
+            ++NumFailed;
+        if (Result.pCompilerOutput)
+            CompilerOutput = static_cast<const char*>(Result.pCompilerOutput->GetConstDataPtr());
+    };
+
+    ShaderCompilationService Service{ServiceCI};
+
+    // HLSL to GLSL conversion requires combined texture samplers
+    ShaderCompilationJob Job;
+    Job.Target                   = ShaderCompilationTarget::GLSL;
+    Job.ShaderCI.Desc.ShaderType = SHADER_TYPE_PIXEL;
+    Job.ShaderCI.SourceLanguage  = SHADER_SOURCE_LANGUAGE_HLSL;
+    Job.ShaderCI.Source          = "float4 main() : SV_Target { return float4(0.0, 0.0, 0.0, 0.0); }";
+    Service.SubmitJob(Job);
+    Service.WaitForCompletion();
+
+    EXPECT_EQ(NumFailed, 1u);
+    EXPECT_EQ(Service.GetStats().NumFailedJobs, 1u);
+    // The error is forwarded to the result
+    EXPECT_NE(CompilerOutput.find("Combined texture samplers"), std::string::npos);
+}
+
+} // namespace
@@ -0,0 +1,211 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of or in connection with the use or inability to use the software 
+ *  (including but not limited to damages for loss of use, data, profit, or any other 
+ *  commercial damages or losses), even if such Contributor has been advised of the 
+ *  possibility of such damages.
+ */
+
+#include "ShaderSourceAssembler.hpp"
+
+#include <string>
+#include <vector>
+
+#include "ShaderToolsCommon.hpp"
+#include "Timer.hpp"
+#include "DebugUtilities.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+const char* const TestPrefix =
+    "#define PREFIX_DEFINITION 1\n"
+    "#define VERTEX_SHADER 1\n";
+
+const char* const TestSource =
+    "float4 main() : SV_Target\n"
+    "{\n"
+    "    return float4(0.0, 0.0, 0.0, 1.0);\n"
+    "}\n";
+
+std::string BuildReferenceSource(const char* Prefix, const ShaderMacro* Macros, const char* Source)
+{
+    std::string RefSource{Prefix};
+    AppendShaderMacros(RefSource, Macros);
+    RefSource += Source;
+    return RefSource;
+}
+
+TEST(ShaderTools_ShaderSourceAssembler, Assemble)
+{
+    ShaderSourceAssembler Assembler;
+    Assembler.SetPrefix(TestPrefix);
+    Assembler.SetSource(TestSource);
+
+    {
+        auto View = Assembler.Assemble(nullptr);
+        EXPECT_EQ(std::string(View.Data, View.Length), BuildReferenceSource(TestPrefix, nullptr, TestSource));
+        EXPECT_EQ(View.Data[View.Length], '\0');
+    }
+
+    const ShaderMacro Macros0[] = {{"A", "1"}, {"LONG_MACRO_NAME", "float4(1.0, 2.0, 3.0, 4.0)"}, {nullptr, nullptr}};
+    const ShaderMacro Macros1[] = {{"B", "0"}, {nullptr, nullptr}};
+
+    {
+        auto View = Assembler.Assemble(Macros0);
+        EXPECT_EQ(std::string(View.Data, View.Length), BuildReferenceSource(TestPrefix, Macros0, TestSource));
+        EXPECT_EQ(View.Data[View.Length], '\0');
+    }
+
+    // Shorter permutation after a longer one
+    {
+        auto View = Assembler.Assemble(Macros1);
+        EXPECT_EQ(std::string(View.Data, View.Length), BuildReferenceSource(TestPrefix, Macros1, TestSource));
+        EXPECT_EQ(View.Data[View.Length], '\0');
+    }
+
+    {
+        const ShaderMacro* MacroLists[] = {Macros0, nullptr, Macros1};
+
+        auto View = Assembler.Assemble(MacroLists, _countof(MacroLists));
+
+        auto RefSource = std::string{TestPrefix};
+        AppendShaderMacros(RefSource, Macros0);
+        AppendShaderMacros(RefSource, Macros1);
+        RefSource += TestSource;
+        EXPECT_EQ(std::string(View.Data, View.Length), RefSource);
+    }
+
+    // Shared macros
+    {
+        Assembler.AppendPrefixMacros(Macros1);
+        auto View = Assembler.Assemble(Macros0);
+
+        auto RefSource = std::string{TestPrefix};
+        AppendShaderMacros(RefSource, Macros1);
+        AppendShaderMacros(RefSource, Macros0);
+        RefSource += TestSource;
+        EXPECT_EQ(std::string(View.Data, View.Length), RefSource);
+    }
+
+    // Prefix and source changes
+    {
+        Assembler.SetPrefix("#version 450\n");
+        Assembler.SetSource("void main(){}");
+        auto View = Assembler.Assemble(Macros1);
+        EXPECT_EQ(std::string(View.Data, View.Length), BuildReferenceSource("#version 450\n", Macros1, "void main(){}"));
+    }
+}
+
+TEST(ShaderTools_ShaderSourceAssembler, NoAllocationsAfterWarmUp)
+{
+    ShaderSourceAssembler Assembler;
+    Assembler.SetPrefix(TestPrefix);
+    Assembler.SetSource(TestSource);
+
+    const ShaderMacro LongMacros[]  = {{"A", "1"}, {"B", "2"}, {"C", "3"}, {nullptr, nullptr}};
+    const ShaderMacro ShortMacros[] = {{"A", "1"}, {nullptr, nullptr}};
+
+    auto        View      = Assembler.Assemble(LongMacros);
+    const auto* pArena    = View.Data;
+    const auto  ArenaSize = Assembler.GetArenaSize();
+    for (int i = 0; i < 16; ++i)
+    {
+        View = Assembler.Assemble((i & 0x01) ? LongMacros : ShortMacros);
+        EXPECT_EQ(View.Data, pArena);
+        EXPECT_EQ(Assembler.GetArenaSize(), ArenaSize);
+    }
+}
+
+// Compares the assembler with the regular way of building source strings
+// on 10000 permutations of the same shader.
+TEST(ShaderTools_ShaderSourceAssembler, DISABLED_Benchmark10kPermutations)
+{
+    constexpr Uint32 NumPermutations = 10000;
+    constexpr Uint32 NumBoolMacros   = 14; // 2^14 > NumPermutations
+
+    std::string Prefix;
+    for (int i = 0; i < 200; ++i)
+        Prefix += "#define COMMON_DEFINITION_" + std::to_string(i) + " " + std::to_string(i * 7) + "\n";
+
+    std::string Source;
+    for (int i = 0; i < 500; ++i)
+        Source += "float4 Function" + std::to_string(i) + "(float4 Value) { return Value * " + std::to_string(i) + ".0; }\n";
+
+    std::vector<std::string> MacroNames;
+    for (Uint32 i = 0; i < NumBoolMacros; ++i)
+        MacroNames.emplace_back("PERMUTATION_FEATURE_" + std::to_string(i));
+    const char* Definitions[] = {"0", "1"};
+
+    std::vector<ShaderMacro> Macros(NumBoolMacros + 1);
+
+    auto SetPermutationMacros = [&](Uint32 Permutation) {
+        for (Uint32 i = 0; i < NumBoolMacros; ++i)
+            Macros[i] = ShaderMacro{MacroNames[i].c_str(), Definitions[(Permutation >> i) & 0x01]};
+        Macros[NumBoolMacros] = ShaderMacro{nullptr, nullptr};
+    };
+
+    size_t RefChecksum = 0;
+    double RefTime     = 0;
+    {
+        Timer T;
+        for (Uint32 p = 0; p < NumPermutations; ++p)
+        {
+            SetPermutationMacros(p);
+            // Same steps as BuildHLSLSourceString()
+            std::string FullSource;
+            FullSource.append(Prefix);
+            AppendShaderMacros(FullSource, Macros.data());
+            FullSource.append(Source);
+            RefChecksum += FullSource.length() + static_cast<size_t>(FullSource[FullSource.length() / 2]);
+        }
+        RefTime = T.GetElapsedTime();
+    }
+
+    size_t Checksum = 0;
+    double Time     = 0;
+    {
+        Timer T;
+
+        ShaderSourceAssembler Assembler;
+        Assembler.SetPrefix(Prefix.c_str(), Prefix.length());
+        Assembler.SetSource(Source.c_str(), Source.length());
+        for (Uint32 p = 0; p < NumPermutations; ++p)
+        {
+            SetPermutationMacros(p);
+            auto View = Assembler.Assemble(Macros.data());
+            Checksum += View.Length + static_cast<size_t>(View.Data[View.Length / 2]);
+        }
+        Time = T.GetElapsedTime();
+    }
+    EXPECT_EQ(Checksum, RefChecksum);
+
+    LOG_INFO_MESSAGE("Assembled ", NumPermutations, " shader permutations (", Prefix.length() + Source.length(), " bytes of shared text each):\n",
+                     "    std::string:           ", RefTime * 1000.0, " ms\n",
+                     "    ShaderSourceAssembler: ", Time * 1000.0, " ms");
+}
+
+} // namespace